@@ -30,15 +30,20 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 
@@ -61,14 +66,24 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
+	// Only the size of items that push tags or data offsets depends on the tag size,
+	// so the items are only visited once.
+	size_t sizeWithoutTags = 1;
+	size_t tagReferences = 0;
+	for (auto const& i: m_data)
+		sizeWithoutTags += i.second.size();
+	for (AssemblyItem const& i: m_items)
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+		{
+			sizeWithoutTags += 1;
+			tagReferences++;
+		}
+		else
+			sizeWithoutTags += i.bytesRequired(subTagSize, Precision::Approximate);
+
 	for (unsigned tagSize = subTagSize; true; ++tagSize)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
-
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize, Precision::Approximate);
+		size_t ret = sizeWithoutTags + tagReferences * tagSize;
 		if (numberEncodingSize(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -89,6 +104,65 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 	return CharStream::singleLineSnippet(it->second, _location);
 }
 
+/// @returns the tags that are only reached by a single jump to a tag pushed right before it and
+/// that cannot be entered by falling through from the preceding item.
+set<u256> singleEntryJumpTargets(AssemblyItems const& _items, set<size_t> const& _tagsReferencedFromOutside)
+{
+	map<u256, size_t> references;
+	set<u256> jumpTargets;
+	set<u256> noFallthrough;
+	for (auto&& [index, item]: _items | ranges::views::enumerate)
+		if (item.type() == PushTag)
+		{
+			references[item.data()]++;
+			if (index + 1 < _items.size() && SemanticInformation::isJumpInstruction(_items[index + 1]))
+				jumpTargets.insert(item.data());
+		}
+		else if (
+			item.type() == Tag &&
+			index > 0 &&
+			_items[index - 1].type() == Operation &&
+			(
+				_items[index - 1].instruction() == Instruction::JUMP ||
+				SemanticInformation::terminatesControlFlow(_items[index - 1].instruction())
+			)
+		)
+			noFallthrough.insert(item.data());
+
+	set<u256> result;
+	for (u256 const& tag: jumpTargets)
+		if (
+			references.at(tag) == 1 &&
+			noFallthrough.count(tag) &&
+			!_tagsReferencedFromOutside.count(static_cast<size_t>(tag))
+		)
+			result.insert(tag);
+	return result;
+}
+
+/// @returns the items optimised by @a _eliminator if they are shorter than the @a _originalSize
+/// items it was fed, nullopt otherwise.
+optional<AssemblyItems> optimisedCSEChunk(CommonSubexpressionEliminator& _eliminator, size_t _originalSize)
+{
+	try
+	{
+		AssemblyItems optimisedChunk = _eliminator.getOptimizedItems();
+		if (optimisedChunk.size() < _originalSize)
+			return optimisedChunk;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	return nullopt;
+}
+
 class Functionalizer
 {
 public:
@@ -339,6 +413,14 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+void Assembly::collectUnoptimisedAssemblies(set<Assembly const*>& _assemblies) const
+{
+	if (m_tagReplacements || !_assemblies.insert(this).second)
+		return;
+	for (auto const& sub: m_subs)
+		sub->collectUnoptimisedAssemblies(_assemblies);
+}
+
 map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
@@ -348,35 +430,68 @@ map<u256, u256> const& Assembly::optimiseInternal(
 		return *m_tagReplacements;
 
 	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		Assembly& sub = *m_subs[subId];
-		map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+	vector<map<u256, u256> const*> subTagReplacements(m_subs.size(), nullptr);
+	auto optimiseSub = [&](size_t _subId, OptimiserSettings const& _subSettings) {
+		subTagReplacements[_subId] = &m_subs[_subId]->optimiseInternal(
+			_subSettings,
+			JumpdestRemover::referencedTags(m_items, _subId)
 		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+	};
+	// Sub-assemblies that share an assembly that is not optimised yet have to be optimised one after
+	// another. Otherwise, the scheduling would decide which tags referenced from outside it is optimised with.
+	bool const optimiseSubsInParallel = _settings.threads > 1 && m_subs.size() > 1 && [&]() {
+		set<Assembly const*> seen;
+		for (auto const& sub: m_subs)
+		{
+			set<Assembly const*> subAssemblies;
+			sub->collectUnoptimisedAssemblies(subAssemblies);
+			for (Assembly const* assembly: subAssemblies)
+				if (!seen.insert(assembly).second)
+					return false;
+		}
+		return true;
+	}();
+	if (optimiseSubsInParallel)
+	{
+		OptimiserSettings subSettings = _settings;
+		subSettings.threads = max<size_t>(1, _settings.threads / m_subs.size());
+		util::Profiler* profiler = util::Profiler::active();
+		util::parallelFor(m_subs.size(), _settings.threads, [&](size_t _subId) {
+			util::ProfilerActivation profilerActivation(profiler, "");
+			optimiseSub(_subId, subSettings);
+		});
 	}
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			optimiseSub(subId, _settings);
+	// Apply the replacements (can be empty) in a fixed order.
+	// They only affect the tags of the respective sub-assembly.
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, *subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
+	// Kept across iterations to reuse its cost decisions for blocks that did not change.
+	Inliner inliner{
+		m_items,
+		_tagsReferencedFromOutside,
+		_settings.expectedExecutionsPerDeployment,
+		isCreation(),
+		_settings.evmVersion
+	};
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
 		count = 0;
 
 		if (_settings.runInliner)
-			Inliner{
-				m_items,
-				_tagsReferencedFromOutside,
-				_settings.expectedExecutionsPerDeployment,
-				isCreation(),
-				_settings.evmVersion
-			}.optimise();
+		{
+			util::ProfilerScope profilerScope("Assembly::optimise Inliner");
+			inliner.optimise();
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
+			util::ProfilerScope profilerScope("Assembly::optimise JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -384,17 +499,16 @@ map<u256, u256> const& Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			util::ProfilerScope profilerScope("Assembly::optimise PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			util::ProfilerScope profilerScope("Assembly::optimise BlockDeduplicator");
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -418,49 +532,91 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runCSE && _settings.experimentalOptimisations.count(frontend::ExperimentalOptimisation::ControlFlowGraph))
+		{
+			util::ProfilerScope profilerScope("Assembly::optimise ControlFlowGraph");
+			// Removes unreachable blocks and moves blocks that are only entered by a single jump
+			// behind that jump. Tags referenced from outside, e.g. function pointers stored in
+			// storage by the creation code, are entry points of the graph.
+			// The result is only used if it is smaller, so that this terminates.
+			try
+			{
+				AssemblyItems reorderedItems;
+				for (BasicBlock const& block: ControlFlowGraph{m_items, _tagsReferencedFromOutside}.optimisedBlocks())
+					copy(m_items.begin() + block.begin, m_items.begin() + block.end, back_inserter(reorderedItems));
+				if (reorderedItems.size() < m_items.size())
+				{
+					m_items = move(reorderedItems);
+					count++;
+				}
+			}
+			catch (OptimizerException const&)
+			{
+				// The analysis gives up on code it cannot follow, e.g. verbatim bytecode.
+			}
+		}
+
 		if (_settings.runCSE)
 		{
-			// Control flow graph optimization has been here before but is disabled because it
-			// assumes we only jump to tags that are pushed. This is not the case anymore with
-			// function types that can be stored in storage.
+			util::ProfilerScope profilerScope("Assembly::optimise CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = ranges::any_of(m_items, [](AssemblyItem const& _i) {
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			// If requested, the knowledge at the end of a block is kept for the blocks that can only be
+			// entered from there: the code after a conditional jump and tags that are the target of a
+			// single jump earlier in the code and cannot be reached by falling through into them.
+			bool const propagateKnowledge =
+				_settings.experimentalOptimisations.count(frontend::ExperimentalOptimisation::CSEPropagation);
+			set<u256> singleEntryTags;
+			if (propagateKnowledge)
+				singleEntryTags = singleEntryJumpTargets(m_items, _tagsReferencedFromOutside);
+			map<u256, KnownState> tagEntryStates;
+			optional<KnownState> fallthroughState;
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				optional<KnownState> entryState = move(fallthroughState);
+				fallthroughState.reset();
+				if (iter != m_items.begin() && prev(iter)->type() == Tag && tagEntryStates.count(prev(iter)->data()))
+					entryState = tagEntryStates.at(prev(iter)->data());
+
 				auto orig = iter;
+				CommonSubexpressionEliminator eliminator{entryState ? *entryState : KnownState{}};
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
+				optional<AssemblyItems> optimisedChunk = optimisedCSEChunk(eliminator, static_cast<size_t>(iter - orig));
+				// Knowledge from the predecessor can make the reconstruction fail, e.g. if a value that
+				// is known from there is not on the stack anymore. Then the block is optimised on its own.
+				if (entryState && !optimisedChunk)
 				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
-				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
+					CommonSubexpressionEliminator isolatedEliminator{KnownState{}};
+					isolatedEliminator.feedItems(orig, m_items.end(), usesMSize);
+					optimisedChunk = optimisedCSEChunk(isolatedEliminator, static_cast<size_t>(iter - orig));
 				}
 
-				if (shouldReplace)
+				if (optimisedChunk)
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += *optimisedChunk;
 				}
 				else
 					copy(orig, iter, back_inserter(optimisedItems));
+
+				// The original items tell which block follows, the optimised ones might differ.
+				AssemblyItem const* breakingItem = iter != orig ? &*prev(iter) : nullptr;
+				if (propagateKnowledge && breakingItem && *breakingItem == AssemblyItem(Instruction::JUMPI))
+					fallthroughState = eliminator.state();
+				if (
+					breakingItem &&
+					SemanticInformation::isJumpInstruction(*breakingItem) &&
+					prev(iter) != orig &&
+					prev(iter, 2)->type() == PushTag &&
+					singleEntryTags.count(prev(iter, 2)->data())
+				)
+					tagEntryStates.emplace(prev(iter, 2)->data(), eliminator.state());
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -471,12 +627,15 @@ map<u256, u256> const& Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		util::ProfilerScope profilerScope("Assembly::optimise ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			isCreation(),
 			isCreation() ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	m_tagReplacements = move(tagReplacements);
 	return *m_tagReplacements;
@@ -491,6 +650,7 @@ LinkerObject const& Assembly::assemble() const
 	// Otherwise ensure the object is actually clear.
 	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	util::ProfilerScope profilerScope("Assembly::assemble");
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
@@ -532,9 +692,10 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = codeSize(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
-	multimap<h256, unsigned> dataRef;
-	multimap<size_t, size_t> subRef;
+	// The references are recorded in the order of their positions in the bytecode.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
+	vector<pair<h256, size_t>> dataRef;
+	vector<pair<size_t, size_t>> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
 	unsigned bytesPerTag = numberEncodingSize(bytesRequiredForCode);
 	uint8_t tagPush = static_cast<uint8_t>(pushInstruction(bytesPerTag));
@@ -570,19 +731,19 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
 		case PushData:
 			ret.bytecode.push_back(dataRefPush);
-			dataRef.insert(make_pair(h256(i.data()), ret.bytecode.size()));
+			dataRef.emplace_back(h256(i.data()), ret.bytecode.size());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
 			break;
 		case PushSub:
 			assertThrow(i.data() <= numeric_limits<size_t>::max(), AssemblyException, "");
 			ret.bytecode.push_back(dataRefPush);
-			subRef.insert(make_pair(static_cast<size_t>(i.data()), ret.bytecode.size()));
+			subRef.emplace_back(static_cast<size_t>(i.data()), ret.bytecode.size());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerDataRef);
 			break;
 		case PushSubSize:
@@ -679,6 +840,12 @@ LinkerObject const& Assembly::assemble() const
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(static_cast<uint8_t>(Instruction::INVALID));
 
+	// Sub-assemblies are appended ordered by their ids and data is looked up by its hash.
+	// Sorting stably keeps the references to the same sub-assembly or data in bytecode order.
+	auto const byFirst = [](auto const& _a, auto const& _b) { return _a.first < _b.first; };
+	stable_sort(subRef.begin(), subRef.end(), byFirst);
+	stable_sort(dataRef.begin(), dataRef.end(), byFirst);
+
 	for (auto const& [subIdPath, bytecodeOffset]: subRef)
 	{
 		bytesRef r(ret.bytecode.data() + bytecodeOffset, bytesPerDataRef);
@@ -724,7 +891,12 @@ LinkerObject const& Assembly::assemble() const
 
 	for (auto const& dataItem: m_data)
 	{
-		auto references = dataRef.equal_range(dataItem.first);
+		auto references = equal_range(
+			dataRef.begin(),
+			dataRef.end(),
+			make_pair(dataItem.first, size_t(0)),
+			byFirst
+		);
 		if (references.first == references.second)
 			continue;
 		for (auto ref = references.first; ref != references.second; ++ref)
@@ -39,6 +39,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <set>
 #include <utility>
 
 namespace solidity::evmasm
@@ -60,6 +61,7 @@ public:
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
+	AssemblyPointer const& subPointer(size_t _sub) const { return m_subs.at(_sub); }
 	size_t numSubs() const { return m_subs.size(); }
 	AssemblyItem newPushSubSize(u256 const& _subId) { return AssemblyItem(PushSubSize, _subId); }
 	AssemblyItem newPushLibraryAddress(std::string const& _identifier);
@@ -128,6 +130,10 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Maximum number of threads used to optimise the sub-assemblies at the same time.
+		size_t threads = 1;
+		/// Only ExperimentalOptimisation::ControlFlowGraph concerns the assembly optimiser.
+		std::set<frontend::ExperimentalOptimisation> experimentalOptimisations;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -168,6 +174,9 @@ protected:
 
 	unsigned codeSize(unsigned subTagSize) const;
 
+	/// Adds this assembly and all its (transitive) sub-assemblies that have not been optimised yet to @a _assemblies.
+	void collectUnoptimisedAssemblies(std::set<Assembly const*>& _assemblies) const;
+
 private:
 	bool m_invalid = false;
 
@@ -27,6 +27,7 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <charconv>
 #include <fstream>
 #include <limits>
 
@@ -47,6 +48,14 @@ string toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
+/// Appends the decimal representation of @a _value to @a _out without creating a temporary string.
+void appendNumber(string& _out, int _value)
+{
+	char buffer[std::numeric_limits<int>::digits10 + 2];
+	auto const result = to_chars(buffer, buffer + sizeof(buffer), _value);
+	_out.append(buffer, result.ptr);
+}
+
 }
 
 AssemblyItem AssemblyItem::toSubAssemblyTag(size_t _subId) const
@@ -74,7 +83,7 @@ pair<string, string> AssemblyItem::nameAndData() const
 	switch (type())
 	{
 	case Operation:
-		return {instructionInfo(instruction()).name, m_data != nullptr ? toStringInHex(*m_data) : ""};
+		return {string(instructionInfo(instruction()).name), m_data != nullptr ? toStringInHex(*m_data) : ""};
 	case Push:
 		return {"PUSH", toStringInHex(data())};
 	case PushTag:
@@ -251,7 +260,7 @@ string AssemblyItem::toAssemblyText(Assembly const& _assembly) const
 	case Operation:
 	{
 		assertThrow(isValidInstruction(instruction()), AssemblyException, "Invalid instruction.");
-		text = util::toLower(instructionInfo(instruction()).name);
+		text = util::toLower(string(instructionInfo(instruction()).name));
 		break;
 	}
 	case Push:
@@ -412,12 +421,18 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	string ret;
+	// Most items repeat parts of the previous entry, which keeps entries short.
+	ret.reserve(_items.size() * 4);
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items mostly stem from the same source. Source names are interned,
+	// so the index of the previous one can be reused after comparing addresses.
+	string const* lookedUpSourceName = nullptr;
+	int sourceIndex = -1;
 
 	for (auto const& item: _items)
 	{
@@ -426,10 +441,12 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
+		if (location.sourceName != lookedUpSourceName)
+		{
+			lookedUpSourceName = location.sourceName;
+			auto index = lookedUpSourceName ? _sourceIndicesMap.find(*lookedUpSourceName) : _sourceIndicesMap.end();
+			sourceIndex = index != _sourceIndicesMap.end() ? static_cast<int>(index->second) : -1;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -460,17 +477,17 @@ std::string AssemblyItem::computeSourceMapping(
 		if (components-- > 0)
 		{
 			if (location.start != prevStart)
-				ret += to_string(location.start);
+				appendNumber(ret, location.start);
 			if (components-- > 0)
 			{
 				ret += ':';
 				if (length != prevLength)
-					ret += to_string(length);
+					appendNumber(ret, length);
 				if (components-- > 0)
 				{
 					ret += ':';
 					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+						appendNumber(ret, sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
@@ -480,7 +497,7 @@ std::string AssemblyItem::computeSourceMapping(
 						{
 							ret += ':';
 							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
+								appendNumber(ret, modifierDepth);
 						}
 					}
 				}
@@ -488,7 +505,7 @@ std::string AssemblyItem::computeSourceMapping(
 		}
 
 		if (item.opcodeCount() > 1)
-			ret += string(item.opcodeCount() - 1, ';');
+			ret.append(item.opcodeCount() - 1, ';');
 
 		prevStart = location.start;
 		prevLength = length;
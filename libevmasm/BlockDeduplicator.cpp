@@ -27,8 +27,11 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -37,8 +40,8 @@ using namespace solidity::evmasm;
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
+	// Compares the blocks that start at the tags, ignoring tags and stopping at
+	// opcodes that stop the control flow. Only blocks with equal hashes are compared.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
 	// We abort if this virtual tag actually exists.
@@ -49,46 +52,50 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	using diff_type = BlockIterator::difference_type;
+	BlockIterator const end{m_items.end(), m_items.end()};
+	// @returns an iterator to the first item of the block starting with the tag at @a _i.
+	// To compare recursive loops, we have to already unify PushTag opcodes of the
+	// block's own tag, which are given as @a _pushOwnTag.
+	auto blockBegin = [&](size_t _i, AssemblyItem const& _pushOwnTag)
+	{
+		BlockIterator it{m_items.begin() + diff_type(_i), m_items.end(), &_pushOwnTag, &pushSelf};
+		return ++it;
+	};
+	// Hash that is compatible with comparing blocks item by item using operator==.
+	auto blockHash = [&](BlockIterator _it)
 	{
-		if (_i == _j)
-			return false;
-
-		// To compare recursive loops, we have to already unify PushTag opcodes of the
-		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
-
-		using diff_type = BlockIterator::difference_type;
-		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
-		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
-		BlockIterator end{m_items.end(), m_items.end()};
-
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		size_t hash = 0;
+		for (; _it != end; ++_it)
+		{
+			AssemblyItem const& item = *_it;
+			boost::hash_combine(hash, static_cast<int>(item.type()));
+			if (item.type() == Operation)
+				boost::hash_combine(hash, static_cast<int>(item.instruction()));
+			else if (item.type() != VerbatimBytecode)
+				boost::hash_combine(hash, static_cast<size_t>(item.data() & numeric_limits<size_t>::max()));
+		}
+		return hash;
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Maps block hashes to the tag positions of the (pairwise different) blocks with that hash.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			AssemblyItem const pushTag = m_items.at(i).pushTag();
+			BlockIterator const begin = blockBegin(i, pushTag);
+			vector<size_t>& candidates = blocksSeen[blockHash(begin)];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) {
+				AssemblyItem const pushOtherTag = m_items.at(_j).pushTag();
+				return std::equal(begin, end, blockBegin(_j, pushOtherTag), end);
+			});
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
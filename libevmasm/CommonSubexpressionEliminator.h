@@ -77,6 +77,10 @@ public:
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
+	/// @returns the state after the items fed so far, including the item that broke the block.
+	/// Only valid after getOptimizedItems() was called, even if it threw.
+	KnownState const& state() const { return m_initialState; }
+
 private:
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
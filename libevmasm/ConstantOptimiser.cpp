@@ -24,6 +24,9 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -54,21 +57,16 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+		Choice const& choice = chooseMethod(params, item.data());
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		if (choice.method == Choice::Method::CodeCopy)
 		{
-			replacement = copy.execute(_assembly);
+			replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (choice.method == Choice::Method::Compute)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = choice.routine;
 			optimisations++;
 		}
 		if (!replacement.empty())
@@ -79,6 +77,42 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 	return optimisations;
 }
 
+ConstantOptimisationMethod::Choice const& ConstantOptimisationMethod::chooseMethod(
+	Params const& _params,
+	u256 const& _value
+)
+{
+	// The same constants, e.g. masks and selectors, occur in most contracts and
+	// searching for a way to compute them is expensive.
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	static mutex cacheMutex;
+	static map<Key, Choice> cache;
+
+	Key key{_value, _params.isCreation, _params.runs, _params.multiplicity, _params.evmVersion};
+	{
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(key); it != cache.end())
+			return it->second;
+	}
+
+	bigint literalGas = LiteralMethod(_params, _value).gasNeeded();
+	bigint copyGas = CodeCopyMethod(_params, _value).gasNeeded();
+	ComputeMethod compute(_params, _value);
+	bigint computeGas = compute.gasNeeded();
+	Choice choice;
+	if (copyGas < literalGas && copyGas < computeGas)
+		choice.method = Choice::Method::CodeCopy;
+	else if (computeGas < literalGas && computeGas <= copyGas)
+	{
+		choice.method = Choice::Method::Compute;
+		choice.routine = compute.routine();
+	}
+
+	// Elements of a map are not moved by insertions, so the reference stays valid.
+	lock_guard<mutex> lock(cacheMutex);
+	return cache.emplace(move(key), move(choice)).first->second;
+}
+
 bigint ConstantOptimisationMethod::simpleRunGas(AssemblyItems const& _items)
 {
 	bigint gas = 0;
@@ -94,6 +94,18 @@ protected:
 	/// Replaces all constants i by the code given in @a _replacement[i].
 	static void replaceConstants(AssemblyItems& _items, std::map<u256, AssemblyItems> const& _replacements);
 
+	/// The method chosen to represent a constant.
+	struct Choice
+	{
+		enum class Method { Literal, CodeCopy, Compute };
+		Method method = Method::Literal;
+		/// The routine that computes the constant if @a method is Compute.
+		AssemblyItems routine;
+	};
+	/// @returns the cheapest method to represent @a _value with @a _params.
+	/// The choice only depends on its arguments, so it is cached for the whole process.
+	static Choice const& chooseMethod(Params const& _params, u256 const& _value);
+
 	Params m_params;
 	u256 const& m_value;
 };
@@ -148,6 +160,7 @@ public:
 	{
 		return m_routine;
 	}
+	AssemblyItems const& routine() const { return m_routine; }
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
@@ -35,6 +35,19 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+/// Maximum number of times the knowledge about a block is recomputed on average
+/// before the analysis gives up.
+size_t constexpr c_maxVisitsPerBlock = 32;
+
+/// @returns true if @a _item pushes a tag of the assembly itself and not of a sub-assembly.
+bool isLocalPushTag(AssemblyItem const& _item)
+{
+	return _item.type() == PushTag && _item.splitForeignPushTag().first == numeric_limits<size_t>::max();
+}
+}
+
 BlockId::BlockId(u256 const& _id):
 	m_id(unsigned(_id))
 {
@@ -60,7 +73,7 @@ void ControlFlowGraph::findLargestTag()
 {
 	m_lastUsedId = 0;
 	for (auto const& item: m_items)
-		if (item.type() == Tag || item.type() == PushTag)
+		if (item.type() == Tag || isLocalPushTag(item))
 		{
 			// Assert that it can be converted.
 			BlockId(item.data());
@@ -76,6 +89,7 @@ void ControlFlowGraph::splitBlocks()
 	for (size_t index = 0; index < m_items.size(); ++index)
 	{
 		AssemblyItem const& item = m_items.at(index);
+		assertThrow(item.type() != VerbatimBytecode, OptimizerException, "Cannot analyse verbatim bytecode.");
 		if (item.type() == Tag)
 		{
 			if (id)
@@ -87,7 +101,7 @@ void ControlFlowGraph::splitBlocks()
 			id = item.type() == Tag ? BlockId(item.data()) : generateNewId();
 			m_blocks[id].begin = static_cast<unsigned>(index);
 		}
-		if (item.type() == PushTag)
+		if (isLocalPushTag(item))
 			m_blocks[id].pushedTags.emplace_back(item.data());
 		if (SemanticInformation::altersControlFlow(item))
 		{
@@ -140,6 +154,9 @@ void ControlFlowGraph::removeUnusedBlocks()
 {
 	vector<BlockId> blocksToProcess{BlockId::initial()};
 	set<BlockId> neededBlocks{BlockId::initial()};
+	for (BlockId entry: m_externalEntries)
+		if (m_blocks.count(entry) && neededBlocks.insert(entry).second)
+			blocksToProcess.push_back(entry);
 	while (!blocksToProcess.empty())
 	{
 		BasicBlock const& block = m_blocks.at(blocksToProcess.back());
@@ -191,7 +208,7 @@ void ControlFlowGraph::setPrevLinks()
 		if (block.endType != BasicBlock::EndType::JUMP || block.end - block.begin < 2)
 			continue;
 		AssemblyItem const& push = m_items.at(block.end - 2);
-		if (push.type() != PushTag)
+		if (!isLocalPushTag(push))
 			continue;
 		BlockId nextId(push.data());
 		if (m_blocks.count(nextId) && m_blocks.at(nextId).prev)
@@ -229,6 +246,8 @@ void ControlFlowGraph::gatherKnowledge()
 	};
 
 	vector<WorkQueueItem> workQueue{WorkQueueItem{BlockId::initial(), emptyState->copy(), set<BlockId>()}};
+	for (BlockId entry: m_externalEntries)
+		workQueue.push_back(WorkQueueItem{entry, emptyState->copy(), set<BlockId>()});
 	auto addWorkQueueItem = [&](WorkQueueItem const& _currentItem, BlockId _to, KnownStatePointer const& _state)
 	{
 		WorkQueueItem item;
@@ -239,8 +258,10 @@ void ControlFlowGraph::gatherKnowledge()
 		workQueue.push_back(move(item));
 	};
 
+	size_t visitsLeft = c_maxVisitsPerBlock * m_blocks.size();
 	while (!workQueue.empty())
 	{
+		assertThrow(visitsLeft-- > 0, OptimizerException, "Control flow too complex to analyse.");
 		WorkQueueItem item = move(workQueue.back());
 		workQueue.pop_back();
 		//@todo we might have to do something like incrementing the sequence number for each JUMPDEST
@@ -351,7 +372,12 @@ BasicBlocks ControlFlowGraph::rebuildCode()
 			if (block.begin == block.end)
 				continue;
 			// If block starts with unused tag, skip it.
-			if (previousHandedOver && !pushes[blockId] && m_items[block.begin].type() == Tag)
+			if (
+				previousHandedOver &&
+				!pushes[blockId] &&
+				!m_externalEntries.count(blockId) &&
+				m_items[block.begin].type() == Tag
+			)
 				++block.begin;
 			if (block.begin < block.end)
 			{
@@ -31,6 +31,7 @@
 #include <vector>
 #include <memory>
 #include <limits>
+#include <set>
 
 namespace solidity::evmasm
 {
@@ -92,19 +93,28 @@ using BasicBlocks = std::vector<BasicBlock>;
 
 /**
  * Control flow graph optimizer.
- * ASSUMES THAT WE ONLY JUMP TO TAGS THAT WERE PREVIOUSLY PUSHED. THIS IS NOT TRUE ANYMORE
- * NOW THAT FUNCTION TAGS CAN BE STORED IN STORAGE.
+ * Tags can only be jumped to if they are pushed in this assembly or referenced from outside,
+ * e.g. by the creation code that stores a function pointer of the runtime code in storage.
+ * The latter are entry points of the graph. A jump whose target is not known can reach all tags.
  */
 class ControlFlowGraph
 {
 public:
 	/// Initializes the control flow graph.
 	/// @a _items has to persist across the usage of this class.
+	/// @a _tagsReferencedFromOutside tags that can be jumped to without being pushed in @a _items.
 	/// @a _joinKnowledge if true, reduces state knowledge to common base at the join of two paths
-	explicit ControlFlowGraph(AssemblyItems const& _items, bool _joinKnowledge = true):
+	explicit ControlFlowGraph(
+		AssemblyItems const& _items,
+		std::set<size_t> const& _tagsReferencedFromOutside = {},
+		bool _joinKnowledge = true
+	):
 		m_items(_items),
 		m_joinKnowledge(_joinKnowledge)
-	{}
+	{
+		for (size_t tag: _tagsReferencedFromOutside)
+			m_externalEntries.insert(BlockId(u256(tag)));
+	}
 	/// @returns vector of basic blocks in the order they should be used in the final code.
 	/// Should be called only once.
 	BasicBlocks optimisedBlocks();
@@ -123,6 +133,8 @@ private:
 	unsigned m_lastUsedId = 0;
 	AssemblyItems const& m_items;
 	bool m_joinKnowledge = true;
+	/// Blocks that can be entered from outside of the assembly.
+	std::set<BlockId> m_externalEntries;
 	std::map<BlockId, BasicBlock> m_blocks;
 };
 
@@ -20,6 +20,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
+#include <array>
 #include <functional>
 
 using namespace std;
@@ -28,49 +29,81 @@ using namespace solidity::util;
 using namespace solidity::evmasm;
 
 
+namespace
+{
+
+/// @returns the names of all instructions indexed by their opcode, or empty strings for invalid opcodes.
+array<string, 256> const& instructionNames()
+{
+	static array<string, 256> const names = []
+	{
+		array<string, 256> result;
+		for (size_t opcode = 0; opcode < result.size(); ++opcode)
+			if (isValidInstruction(Instruction(opcode)))
+				result[opcode] = instructionInfo(Instruction(opcode)).name;
+		return result;
+	}();
+	return names;
+}
+
+/// Appends the bytes of @a _data, followed by @a _padding zero bytes, to @a _out as an uppercase
+/// hex number without leading zeros, i.e. in the same format as ``std::hex`` prints integers.
+void appendHexNumber(string& _out, bytesConstRef _data, size_t _padding)
+{
+	static char const digits[] = "0123456789ABCDEF";
+	size_t const sizeBefore = _out.size();
+	for (uint8_t byte: _data)
+		for (uint8_t nibble: {uint8_t(byte >> 4), uint8_t(byte & 0xf)})
+			if (nibble || _out.size() != sizeBefore)
+				_out.push_back(digits[nibble]);
+	if (_out.size() == sizeBefore)
+		_out.push_back('0');
+	else
+		_out.append(2 * _padding, '0');
+}
+
+}
+
 void solidity::evmasm::eachInstruction(
 	bytes const& _mem,
 	function<void(Instruction,u256 const&)> const& _onInstruction
 )
 {
-	for (auto it = _mem.begin(); it < _mem.end(); ++it)
-	{
-		Instruction const instr{*it};
-		int additional = 0;
-		if (isValidInstruction(instr))
-			additional = instructionInfo(instr).additional;
-
+	forEachInstruction(bytesConstRef(&_mem), [&](Instruction _instr, bytesConstRef _immediate) {
 		u256 data{};
-
-		// fill the data with the additional data bytes from the instruction stream
-		while (additional > 0 && std::next(it) < _mem.end())
-		{
-			data <<= 8;
-			data |= *++it;
-			--additional;
-		}
-
+		for (uint8_t byte: _immediate)
+			data = (data << 8) | byte;
 		// pad the remaining number of additional octets with zeros
-		data <<= 8 * additional;
-
-		_onInstruction(instr, data);
-	}
+		if (isPushInstruction(_instr))
+			data <<= 8 * (getPushNumber(_instr) - _immediate.size());
+		_onInstruction(_instr, data);
+	});
 }
 
 string solidity::evmasm::disassemble(bytes const& _mem, string const& _delimiter)
 {
-	stringstream ret;
-	eachInstruction(_mem, [&](Instruction _instr, u256 const& _data) {
-		if (!isValidInstruction(_instr))
-			ret << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << _delimiter;
+	array<string, 256> const& names = instructionNames();
+	string ret;
+	// Most instructions are short names without immediate data.
+	ret.reserve(_mem.size() * (6 + _delimiter.size()));
+	forEachInstruction(bytesConstRef(&_mem), [&](Instruction _instr, bytesConstRef _immediate) {
+		string const& name = names[static_cast<uint8_t>(_instr)];
+		if (name.empty())
+		{
+			uint8_t const opcode = static_cast<uint8_t>(_instr);
+			ret += "0x";
+			appendHexNumber(ret, bytesConstRef(&opcode, 1), 0);
+		}
 		else
 		{
-			InstructionInfo info = instructionInfo(_instr);
-			ret << info.name;
-			if (info.additional)
-				ret << " 0x" << std::uppercase << std::hex << _data;
-			ret << _delimiter;
+			ret += name;
+			if (isPushInstruction(_instr))
+			{
+				ret += " 0x";
+				appendHexNumber(ret, _immediate, getPushNumber(_instr) - _immediate.size());
+			}
 		}
+		ret += _delimiter;
 	});
-	return ret.str();
+	return ret;
 }
@@ -23,13 +23,32 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <algorithm>
 #include <functional>
 #include <string>
 
 namespace solidity::evmasm
 {
 
+/// Iterates through EVM code and calls @a _onInstruction(Instruction, bytesConstRef) on each instruction.
+/// The second argument refers to the immediate bytes of the instruction inside @a _mem, which are
+/// not decoded. It is shorter than the push size if the code ends in the middle of a push.
+/// In contrast to ``eachInstruction``, this does not allocate and the visitor can be inlined.
+template <typename Visitor>
+void forEachInstruction(bytesConstRef _mem, Visitor&& _onInstruction)
+{
+	for (size_t pos = 0; pos < _mem.size(); ++pos)
+	{
+		Instruction const instr{_mem[pos]};
+		size_t immediateSize = isPushInstruction(instr) ? getPushNumber(instr) : 0;
+		immediateSize = std::min(immediateSize, _mem.size() - pos - 1);
+		_onInstruction(instr, _mem.cropped(pos + 1, immediateSize));
+		pos += immediateSize;
+	}
+}
+
 /// Iterate through EVM code and call a function on each instruction.
+/// The immediate data is zero-padded on the right if the code ends in the middle of a push.
 void eachInstruction(bytes const& _mem, std::function<void(Instruction, u256 const&)> const& _onInstruction);
 
 /// Convert from EVM code to simple EVM assembly language.
@@ -27,6 +27,8 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <tuple>
 #include <limits>
@@ -55,6 +57,31 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
 }
 
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type() || arguments != _other.arguments || sequenceNumber != _other.sequenceNumber)
+		return false;
+	else if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+size_t ExpressionClasses::Expression::Hash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t hash = 0;
+	boost::hash_combine(hash, static_cast<int>(_expression.item->type()));
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(hash, static_cast<int>(_expression.item->instruction()));
+	else
+		boost::hash_combine(hash, static_cast<size_t>(_expression.item->data() & numeric_limits<size_t>::max()));
+	boost::hash_range(hash, _expression.arguments.begin(), _expression.arguments.end());
+	boost::hash_combine(hash, _expression.sequenceNumber);
+	return hash;
+}
+
 ExpressionClasses::Id ExpressionClasses::find(
 	AssemblyItem const& _item,
 	Ids const& _arguments,
@@ -183,7 +210,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the match groups of the last match, so they cannot be shared between threads.
+	static thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
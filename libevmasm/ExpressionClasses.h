@@ -31,6 +31,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
@@ -62,6 +63,14 @@ public:
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator<(Expression const& _other) const;
+		/// Compatible with operator<.
+		bool operator==(Expression const& _other) const;
+
+		/// Hash that is compatible with operator==.
+		struct Hash
+		{
+			size_t operator()(Expression const& _expression) const;
+		};
 	};
 
 	/// Retrieves the id of the expression equivalence class resulting from the given item applied to the
@@ -122,7 +131,7 @@ private:
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::set<Expression> m_expressions;
+	std::unordered_set<Expression, Expression::Hash> m_expressions;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
 };
 
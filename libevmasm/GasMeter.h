@@ -144,6 +144,17 @@ namespace GasCosts
 		else
 			return 40;
 	}
+	/// Cost of calling a precompiled contract, whose address is always warm since EIP-2929.
+	inline unsigned precompileCallGas(langutil::EVMVersion _evmVersion)
+	{
+		if (_evmVersion >= langutil::EVMVersion::berlin())
+			return warmStorageReadCost;
+		else
+			return callGas(_evmVersion);
+	}
+	/// Base and per word cost of the identity precompile at address 4.
+	static unsigned const identityGas = 15;
+	static unsigned const identityWordGas = 3;
 	static unsigned const callStipend = 2300;
 	static unsigned const callValueTransferGas = 9000;
 	static unsigned const callNewAccountGas = 25000;
@@ -76,6 +76,49 @@ optional<size_t> getLocalTag(AssemblyItem const& _item)
 		return nullopt;
 	return tag;
 }
+/// @returns the items executed for each call of a function that is not inlined at the call site.
+AssemblyItems const& uninlinedCallSitePattern()
+{
+	static AssemblyItems const pattern = {
+		AssemblyItem{PushTag},
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+		AssemblyItem{Tag}
+	};
+	return pattern;
+}
+/// @returns the items executed for each call of a function that is not inlined in the function itself.
+AssemblyItems const& uninlinedFunctionPattern()
+{
+	static AssemblyItems const pattern = {
+		AssemblyItem{Tag},
+		// Actual function body. Handled separately.
+		AssemblyItem{Instruction::JUMP}
+	};
+	return pattern;
+}
+}
+
+Inliner::Inliner(
+	AssemblyItems& _items,
+	set<size_t> const& _tagsReferencedFromOutside,
+	size_t _runs,
+	bool _isCreation,
+	langutil::EVMVersion _evmVersion
+):
+	m_items(_items),
+	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
+	m_runs(_runs),
+	m_isCreation(_isCreation),
+	m_evmVersion(_evmVersion),
+	// Both the call site and jump site pattern is executed for each call.
+	// Since the function body has to be executed equally often both with and without inlining,
+	// it can be ignored.
+	m_uninlinedCallCost(
+		executionCost(uninlinedCallSitePattern(), _evmVersion) +
+		executionCost(uninlinedFunctionPattern(), _evmVersion)
+	)
+{
 }
 
 bool Inliner::isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const
@@ -133,73 +176,56 @@ map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyI
 	map<size_t, InlinableBlock> result;
 	for (auto&& [tag, items]: inlinableBlockItems)
 		if (uint64_t const* numPushes = util::valueOrNullptr(numPushTags, tag))
-			result.emplace(tag, InlinableBlock{items, *numPushes});
+			result.emplace(tag, InlinableBlock{items, *numPushes, codeSize(ranges::views::drop_last(items, 1))});
 	return result;
 }
 
-bool Inliner::shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const
+bool Inliner::shouldInlineFullFunctionBody(size_t _tag, uint64_t _functionBodySize, uint64_t _pushTagCount)
 {
-	// Accumulate size of the inline candidate block in bytes (without the return jump).
-	uint64_t functionBodySize = codeSize(ranges::views::drop_last(_block, 1));
+	bool referencedFromOutside = m_tagsReferencedFromOutside.count(_tag);
+	auto decisionKey = make_tuple(_functionBodySize, _pushTagCount, referencedFromOutside);
+	if (bool const* decision = util::valueOrNullptr(m_fullFunctionBodyDecisions, decisionKey))
+		return *decision;
 
 	// Use the number of push tags as approximation of the average number of calls to the function per run.
 	uint64_t numberOfCalls = _pushTagCount;
 	// Also use the number of push tags as approximation of the number of call sites to the function.
 	uint64_t numberOfCallSites = _pushTagCount;
 
-	static AssemblyItems const uninlinedCallSitePattern = {
-		AssemblyItem{PushTag},
-		AssemblyItem{PushTag},
-		AssemblyItem{Instruction::JUMP},
-		AssemblyItem{Tag}
-	};
-	static AssemblyItems const uninlinedFunctionPattern = {
-		AssemblyItem{Tag},
-		// Actual function body of size functionBodySize. Handled separately below.
-		AssemblyItem{Instruction::JUMP}
-	};
-
-	// Both the call site and jump site pattern is executed for each call.
-	// Since the function body has to be executed equally often both with and without inlining,
-	// it can be ignored.
-	bigint uninlinedExecutionCost = numberOfCalls * (
-		executionCost(uninlinedCallSitePattern, m_evmVersion) +
-		executionCost(uninlinedFunctionPattern, m_evmVersion)
-	);
+	bigint uninlinedExecutionCost = numberOfCalls * bigint(m_uninlinedCallCost);
 	// Each call site deposits the call site pattern, whereas the jump site pattern and the function itself are deposited once.
 	bigint uninlinedDepositCost = GasMeter::dataGas(
-		numberOfCallSites * codeSize(uninlinedCallSitePattern) +
-		codeSize(uninlinedFunctionPattern) +
-		functionBodySize,
+		numberOfCallSites * codeSize(uninlinedCallSitePattern()) +
+		codeSize(uninlinedFunctionPattern()) +
+		_functionBodySize,
 		m_isCreation,
 		m_evmVersion
 	);
 	// When inlining the execution cost beyond the actual function execution is zero,
 	// but for each call site a copy of the function is deposited.
 	bigint inlinedDepositCost = GasMeter::dataGas(
-		numberOfCallSites * functionBodySize,
+		numberOfCallSites * _functionBodySize,
 		m_isCreation,
 		m_evmVersion
 	);
 	// If the block is referenced from outside the current subassembly, the original function cannot be removed.
 	// Note that the function also cannot always be removed, if it is not referenced from outside, but in that case
 	// the heuristics is optimistic.
-	if (m_tagsReferencedFromOutside.count(_tag))
+	if (referencedFromOutside)
 		inlinedDepositCost += GasMeter::dataGas(
-			codeSize(uninlinedFunctionPattern) + functionBodySize,
+			codeSize(uninlinedFunctionPattern()) + _functionBodySize,
 			m_isCreation,
 			m_evmVersion
 		);
 
 	// If the estimated runtime cost over the lifetime of the contract plus the deposit cost in the uninlined case
 	// exceed the inlined deposit costs, it is beneficial to inline.
-	if (bigint(m_runs) * uninlinedExecutionCost + uninlinedDepositCost > inlinedDepositCost)
-		return true;
-
-	return false;
+	bool decision = bigint(m_runs) * uninlinedExecutionCost + uninlinedDepositCost > inlinedDepositCost;
+	m_fullFunctionBodyDecisions[decisionKey] = decision;
+	return decision;
 }
 
-optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const
+optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block)
 {
 	assertThrow(_jump == Instruction::JUMP, OptimizerException, "");
 	AssemblyItem blockExit = _block.items.back();
@@ -208,7 +234,7 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 		_jump.getJumpType() == AssemblyItem::JumpType::IntoFunction &&
 		blockExit == Instruction::JUMP &&
 		blockExit.getJumpType() == AssemblyItem::JumpType::OutOfFunction &&
-		shouldInlineFullFunctionBody(_tag, _block.items, _block.pushTagCount)
+		shouldInlineFullFunctionBody(_tag, _block.bodySize, _block.pushTagCount)
 	)
 	{
 		blockExit.setJumpType(AssemblyItem::JumpType::Ordinary);
@@ -226,7 +252,7 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 			AssemblyItem{Instruction::JUMP},
 		};
 		if (
-			GasMeter::dataGas(codeSize(_block.items), m_isCreation, m_evmVersion) <=
+			GasMeter::dataGas(_block.bodySize + blockExit.bytesRequired(2, Precision::Approximate), m_isCreation, m_evmVersion) <=
 			GasMeter::dataGas(codeSize(jumpPattern), m_isCreation, m_evmVersion)
 		)
 			return blockExit;
@@ -236,12 +262,14 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 }
 
 
-void Inliner::optimise()
+bool Inliner::optimise()
 {
 	std::map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks(m_items);
 
 	if (inlinableBlocks.empty())
-		return;
+		return false;
+
+	bool inlined = false;
 
 	AssemblyItems newItems;
 	for (auto it = m_items.begin(); it != m_items.end(); ++it)
@@ -268,6 +296,7 @@ void Inliner::optimise()
 										if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
 											++block->pushTagCount;
 
+							inlined = true;
 							// Skip the original jump to the inlined tag and continue.
 							++it;
 							continue;
@@ -277,5 +306,7 @@ void Inliner::optimise()
 		newItems.emplace_back(item);
 	}
 
-	m_items = move(newItems);
+	if (inlined)
+		m_items = move(newItems);
+	return inlined;
 }
@@ -29,6 +29,7 @@
 #include <range/v3/view/span.hpp>
 #include <map>
 #include <set>
+#include <tuple>
 #include <vector>
 
 namespace solidity::evmasm
@@ -37,37 +38,35 @@ namespace solidity::evmasm
 class Inliner
 {
 public:
+	/// @a _items and @a _tagsReferencedFromOutside are referenced and can change between calls to optimise().
 	explicit Inliner(
 		AssemblyItems& _items,
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
 		langutil::EVMVersion _evmVersion
-	):
-	m_items(_items),
-	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
-	m_runs(_runs),
-	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
-	{
-	}
+	);
 	virtual ~Inliner() = default;
 
-	void optimise();
+	/// Inlines the blocks for which it is beneficial. Can be called again after other optimisation
+	/// steps changed the items, in which case the cost decisions for unchanged blocks are reused.
+	/// @returns true if anything was inlined.
+	bool optimise();
 
 private:
 	struct InlinableBlock
 	{
 		ranges::span<AssemblyItem const> items;
 		uint64_t pushTagCount = 0;
+		/// Size of the items in bytes, excluding the exit item.
+		uint64_t bodySize = 0;
 	};
 
 	/// @returns the exit item for the block to be inlined, if a particular jump to it should be inlined, otherwise nullopt.
-	std::optional<AssemblyItem> shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const;
-	/// @returns true, if the full function at tag @a _tag with body @a _block that is referenced @a _pushTagCount times
-	/// should be inlined, false otherwise. @a _block should start at the first instruction after the function entry tag
-	/// up to and including the return jump.
-	bool shouldInlineFullFunctionBody(size_t _tag, ranges::span<AssemblyItem const> _block, uint64_t _pushTagCount) const;
+	std::optional<AssemblyItem> shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block);
+	/// @returns true, if the full function at tag @a _tag with a body of @a _functionBodySize bytes (excluding the
+	/// return jump) that is referenced @a _pushTagCount times should be inlined, false otherwise.
+	bool shouldInlineFullFunctionBody(size_t _tag, uint64_t _functionBodySize, uint64_t _pushTagCount);
 	/// @returns true, if the @a _items at @a _tag are a potential candidate for inlining.
 	bool isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const;
 	/// @returns a map from tags that can potentially be inlined to the inlinable item range behind that tag and the
@@ -79,6 +78,11 @@ private:
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// Execution cost of the call site and the return jump of a function that is not inlined.
+	u256 m_uninlinedCallCost;
+	/// Results of shouldInlineFullFunctionBody by function body size, number of references and
+	/// whether the function is referenced from outside.
+	std::map<std::tuple<uint64_t, uint64_t, bool>, bool> m_fullFunctionBodyDecisions;
 };
 
 }
@@ -174,7 +174,10 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "SELFDESTRUCT", Instruction::SELFDESTRUCT }
 };
 
-static std::map<Instruction, InstructionInfo> const c_instructionInfo =
+namespace
+{
+
+constexpr pair<Instruction, InstructionInfo> c_validInstructionInfo[] =
 { //												Add, Args, Ret, SideEffects, GasPriceTier
 	{ Instruction::STOP,		{ "STOP",			0, 0, 0, true,  Tier::Zero } },
 	{ Instruction::ADD,			{ "ADD",			0, 2, 1, false, Tier::VeryLow } },
@@ -321,19 +324,16 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{ Instruction::SELFDESTRUCT,	{ "SELFDESTRUCT",		0, 1, 0, true, Tier::Special } }
 };
 
-InstructionInfo solidity::evmasm::instructionInfo(Instruction _inst)
+constexpr array<InstructionInfo, 256> makeInstructionInfo()
 {
-	try
-	{
-		return c_instructionInfo.at(_inst);
-	}
-	catch (...)
-	{
-		return InstructionInfo({"<INVALID_INSTRUCTION: " + to_string(static_cast<unsigned>(_inst)) + ">", 0, 0, 0, false, Tier::Invalid});
-	}
+	array<InstructionInfo, 256> result{};
+	for (InstructionInfo& info: result)
+		info = {"<INVALID_INSTRUCTION>", 0, 0, 0, false, Tier::Invalid};
+	for (auto const& entry: c_validInstructionInfo)
+		result[static_cast<uint8_t>(entry.first)] = entry.second;
+	return result;
 }
 
-bool solidity::evmasm::isValidInstruction(Instruction _inst)
-{
-	return !!c_instructionInfo.count(_inst);
 }
+
+constexpr array<InstructionInfo, 256> solidity::evmasm::c_instructionInfo = makeInstructionInfo();
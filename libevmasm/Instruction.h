@@ -26,6 +26,9 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 
+#include <array>
+#include <string_view>
+
 namespace solidity::evmasm
 {
 
@@ -282,7 +285,7 @@ enum class Tier
 /// Information structure for a particular instruction.
 struct InstructionInfo
 {
-	std::string name;	///< The name of the instruction.
+	std::string_view name;	///< The name of the instruction.
 	int additional;		///< Additional items required in memory for this instructions (only for PUSH).
 	int args;			///< Number of items required on the stack for this instruction (and, for the purposes of ret, the number taken from the stack).
 	int ret;			///< Number of items placed (back) on the stack by this instruction, assuming args items were removed.
@@ -290,11 +293,21 @@ struct InstructionInfo
 	Tier gasPriceTier;	///< Tier for gas pricing.
 };
 
-/// Information on all the instructions.
-InstructionInfo instructionInfo(Instruction _inst);
+/// Information on all the instructions, indexed by their opcode.
+/// Opcodes that are not valid instructions have the gas price tier Tier::Invalid.
+extern std::array<InstructionInfo, 256> const c_instructionInfo;
+
+/// Information on the instruction.
+inline InstructionInfo const& instructionInfo(Instruction _inst)
+{
+	return c_instructionInfo[static_cast<uint8_t>(_inst)];
+}
 
 /// check whether instructions exists.
-bool isValidInstruction(Instruction _inst);
+inline bool isValidInstruction(Instruction _inst)
+{
+	return instructionInfo(_inst).gasPriceTier != Tier::Invalid;
+}
 
 /// Convert from string mnemonic to Instruction type.
 extern const std::map<std::string, Instruction> c_instructions;
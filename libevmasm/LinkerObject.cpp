@@ -38,13 +38,24 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
-	std::map<size_t, std::string> remainingRefs;
-	for (auto const& linkRef: linkReferences)
-		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
-			copy(address->data(), address->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(linkRef.first));
+	// References to the same library are usually adjacent, so the last match is reused.
+	string const* lastName = nullptr;
+	h160 const* lastAddress = nullptr;
+	for (auto it = linkReferences.begin(); it != linkReferences.end();)
+	{
+		if (!lastName || *lastName != it->second)
+		{
+			lastName = &it->second;
+			lastAddress = matchLibrary(it->second, _libraryAddresses);
+		}
+		if (lastAddress)
+		{
+			copy(lastAddress->data(), lastAddress->data() + 20, bytecode.begin() + vector<uint8_t>::difference_type(it->first));
+			it = linkReferences.erase(it);
+		}
 		else
-			remainingRefs.insert(linkRef);
-	linkReferences.swap(remainingRefs);
+			++it;
+	}
 }
 
 string LinkerObject::toHex() const
@@ -41,14 +41,21 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	shared_ptr<KnownState> const& _state
 )
 {
+	m_queue.clear();
+	m_highestGasUsagePerJumpdest.clear();
+
 	auto path = make_unique<GasPath>();
 	path->index = _startIndex;
 	path->state = _state->copy();
 	queue(move(path));
 
 	GasMeter::GasConsumption gas;
-	while (!m_queue.empty() && !gas.isInfinite)
+	for (size_t exploredPaths = 0; !m_queue.empty() && !gas.isInfinite; ++exploredPaths)
+	{
+		if (exploredPaths >= maxExploredPaths)
+			return GasMeter::GasConsumption::infinite();
 		gas = max(gas, handleQueueItem());
+	}
 	return gas;
 }
 
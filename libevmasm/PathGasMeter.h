@@ -48,14 +48,19 @@ struct GasPath
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ * The same meter can be used for multiple estimations on the same items.
  */
 class PathGasMeter
 {
 public:
 	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
 
+	/// @returns infinite gas if more than @a maxExploredPaths paths would have to be explored.
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
+	/// Limit on the number of paths explored by a single estimation.
+	static size_t constexpr maxExploredPaths = 20000;
+
 	static GasMeter::GasConsumption estimateMax(
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
@@ -78,6 +83,7 @@ private:
 	/// item per jumpdest, because of the behaviour of `queue` above.
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
 	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
+	/// Only depends on the items, so it is kept between estimations.
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
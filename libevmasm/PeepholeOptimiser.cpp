@@ -24,6 +24,11 @@
 
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
+#include <libevmasm/Exceptions.h>
+
+#include <algorithm>
+#include <optional>
+#include <tuple>
 
 using namespace std;
 using namespace solidity;
@@ -34,11 +39,18 @@ using namespace solidity::evmasm;
 namespace
 {
 
+/// The optimiser keeps the items it has already examined in the output and the items it still has
+/// to examine in reverse order. This makes both sides behave like the two halves of a gap buffer:
+/// Items can be consumed from and moved back to the position of the current window in constant time.
 struct OptimiserState
 {
-	AssemblyItems const& items;
-	size_t i;
+	/// Items that still have to be examined, the next one at the back.
+	AssemblyItems const& pending;
+	/// Number of pending items replaced by the last successful method.
+	size_t consumed;
 	std::back_insert_iterator<AssemblyItems> out;
+
+	AssemblyItems::const_reverse_iterator window() const { return pending.rbegin(); }
 };
 
 template<typename FunctionType>
@@ -53,19 +65,23 @@ template <class Method>
 struct SimplePeepholeOptimizerMethod
 {
 	template <size_t... Indices>
-	static bool applyRule(AssemblyItems::const_iterator _in, back_insert_iterator<AssemblyItems> _out, index_sequence<Indices...>)
+	static bool applyRule(AssemblyItems::const_reverse_iterator _in, back_insert_iterator<AssemblyItems> _out, index_sequence<Indices...>)
 	{
 		return Method::applySimple(_in[Indices]..., _out);
 	}
+	static constexpr size_t windowSize()
+	{
+		return FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+	}
 	static bool apply(OptimiserState& _state)
 	{
-		static constexpr size_t WindowSize = FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+		static constexpr size_t WindowSize = windowSize();
 		if (
-			_state.i + WindowSize <= _state.items.size() &&
-			applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out, make_index_sequence<WindowSize>{})
+			WindowSize <= _state.pending.size() &&
+			applyRule(_state.window(), _state.out, make_index_sequence<WindowSize>{})
 		)
 		{
-			_state.i += WindowSize;
+			_state.consumed = WindowSize;
 			return true;
 		}
 		else
@@ -73,15 +89,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -431,10 +438,13 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// Only the first item decides whether the method applies, the rest of the window is
+	/// removed up to the next tag.
+	static constexpr size_t windowSize() { return 1; }
 	static bool apply(OptimiserState& _state)
 	{
-		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
-		auto end = _state.items.end();
+		auto it = _state.window();
+		auto end = _state.pending.rend();
 		if (it == end)
 			return false;
 		if (
@@ -453,7 +463,7 @@ struct UnreachableCode
 		if (i > 1)
 		{
 			*_state.out = it[0];
-			_state.i += static_cast<size_t>(i);
+			_state.consumed = static_cast<size_t>(i);
 			return true;
 		}
 		else
@@ -461,47 +471,123 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+template <typename... Methods>
+constexpr size_t maxWindowSize(Methods...)
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
+	return std::max({Methods::windowSize()...});
 }
 
+template <typename Iterator>
+size_t numberOfPops(Iterator _begin, Iterator _end)
+{
+	return static_cast<size_t>(std::count(_begin, _end, Instruction::POP));
 }
 
-bool PeepholeOptimiser::optimise()
+/// @returns true if replacing the items in [@a _begin, @a _end) by @a _replacement
+/// reduces the number of items or keeps it while reducing the code size
+/// or increasing the number of pops.
+template <typename Iterator>
+bool isImprovement(Iterator _begin, Iterator _end, AssemblyItems::const_iterator _replacementBegin, AssemblyItems::const_iterator _replacementEnd)
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
+	auto codeSize = [&](auto _itemsBegin, auto _itemsEnd) {
+		size_t size = 0;
+		for (auto it = _itemsBegin; it != _itemsEnd; ++it)
+			size += it->bytesRequired(3, approx);
+		return size;
+	};
+	auto itemCount = static_cast<size_t>(std::distance(_begin, _end));
+	auto replacementCount = static_cast<size_t>(std::distance(_replacementBegin, _replacementEnd));
+	return replacementCount < itemCount || (
+		replacementCount == itemCount && (
+			codeSize(_replacementBegin, _replacementEnd) < codeSize(_begin, _end) ||
+			numberOfPops(_replacementBegin, _replacementEnd) > numberOfPops(_begin, _end)
 		)
-	))
+	);
+}
+
+}
+
+bool PeepholeOptimiser::optimise()
+{
+	auto methods = make_tuple(
+		PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+		DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
+		TagConjunctions(), TruthyAnd()
+	);
+	// After a replacement, all windows that overlap the replacement have to be examined again.
+	size_t const maxLookBehind = std::apply([](auto... _methods) { return maxWindowSize(_methods...); }, methods) - 1;
+
+	AssemblyItems pending(m_items.rbegin(), m_items.rend());
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
+	OptimiserState state{pending, 0, std::back_inserter(m_optimisedItems)};
+	bool changed = false;
+	// Improvements are only judged locally, so replacements could cycle between variants of the same size.
+	size_t const maxReplacements = MaxReplacementsPerItem * std::max<size_t>(m_items.size(), 1000);
+	size_t replacements = 0;
+	while (!pending.empty())
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		size_t const outputSize = m_optimisedItems.size();
+		bool applied = std::apply([&](auto... _methods) { return applyMethods(state, _methods...); }, methods);
+		auto replacementBegin = m_optimisedItems.cbegin() + static_cast<ptrdiff_t>(outputSize);
+		auto windowBegin = state.window();
+		auto windowEnd = state.window() + static_cast<ptrdiff_t>(state.consumed);
+		// Start of the output that is replaced, which includes items before the window if the
+		// replacement is only an improvement together with them.
+		optional<size_t> replacedFrom;
+		if (applied && isImprovement(windowBegin, windowEnd, replacementBegin, m_optimisedItems.cend()))
+			replacedFrom = outputSize;
+		else if (applied && m_judgeWindows)
+		{
+			// Some replacements only enable improvements of the items before them, e.g. removing an unused
+			// ADDMOD leaves pops of its arguments, which then remove the pushes of the arguments.
+			size_t const lookBehind = std::min(outputSize, maxLookBehind + numberOfPops(replacementBegin, m_optimisedItems.cend()));
+			auto lookBehindBegin = m_optimisedItems.begin() + static_cast<ptrdiff_t>(outputSize - lookBehind);
+			AssemblyItems original(lookBehindBegin, lookBehindBegin + static_cast<ptrdiff_t>(lookBehind));
+			original.insert(original.end(), windowBegin, windowEnd);
+			AssemblyItems candidate(lookBehindBegin, m_optimisedItems.end());
+			PeepholeOptimiser{candidate, false}.optimise();
+			if (isImprovement(original.cbegin(), original.cend(), candidate.cbegin(), candidate.cend()))
+			{
+				replacedFrom = outputSize - lookBehind;
+				m_optimisedItems.erase(lookBehindBegin, m_optimisedItems.end());
+				std::move(candidate.begin(), candidate.end(), std::back_inserter(m_optimisedItems));
+			}
+		}
+
+		if (replacedFrom)
+		{
+			changed = true;
+			assertThrow(++replacements < maxReplacements, OptimizerException, "Peephole optimizer seems to be stuck.");
+			pending.erase(pending.end() - static_cast<ptrdiff_t>(state.consumed), pending.end());
+			size_t const revisitFrom = *replacedFrom - std::min(*replacedFrom, maxLookBehind);
+			while (m_optimisedItems.size() > revisitFrom)
+			{
+				pending.emplace_back(std::move(m_optimisedItems.back()));
+				m_optimisedItems.pop_back();
+			}
+		}
+		else
+		{
+			m_optimisedItems.erase(replacementBegin, m_optimisedItems.cend());
+			m_optimisedItems.emplace_back(std::move(pending.back()));
+			pending.pop_back();
+		}
 	}
-	else
-		return false;
+	if (changed)
+		m_items = std::move(m_optimisedItems);
+	return changed;
 }
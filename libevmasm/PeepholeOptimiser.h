@@ -44,11 +44,24 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Applies the peephole optimisation methods until none of them applies anymore.
+	/// After each replacement, only the windows overlapping the replaced items are examined again.
+	/// A replacement that is not an improvement by itself is still applied if the items before it
+	/// and the replacement together can be optimised into an improvement.
+	/// @returns true if the items changed.
 	bool optimise();
 
+	/// Maximal number of replacements per item before the optimiser is considered to be stuck.
+	static constexpr size_t MaxReplacementsPerItem = 64;
+
 private:
+	PeepholeOptimiser(AssemblyItems& _items, bool _judgeWindows): m_items(_items), m_judgeWindows(_judgeWindows) {}
+
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	/// Whether replacements that are not an improvement by themselves are judged together
+	/// with the items before them.
+	bool m_judgeWindows = true;
 };
 
 }
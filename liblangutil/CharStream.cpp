@@ -51,10 +51,20 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+CharStream::CharStream(string _source, string _name):
+	m_source(std::move(_source)),
+	m_name(std::move(_name))
+{
+	for (size_t linefeed = m_source.find('\n'); linefeed != string::npos; linefeed = m_source.find('\n', linefeed + 1))
+		m_lineStarts.push_back(linefeed + 1);
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -82,19 +92,11 @@ char CharStream::setPosition(size_t _location)
 string CharStream::lineAtPosition(int _position) const
 {
 	// if _position points to \n, it returns the line before the \n
-	using size_type = string::size_type;
-	size_type searchStart = min<size_type>(m_source.size(), size_type(_position));
-	if (searchStart > 0)
-		searchStart--;
-	size_type lineStart = m_source.rfind('\n', searchStart);
-	if (lineStart == string::npos)
-		lineStart = 0;
-	else
-		lineStart++;
-	string line = m_source.substr(
-		lineStart,
-		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	size_t const searchPosition = min(m_source.size(), static_cast<size_t>(_position));
+	auto lineStart = prev(upper_bound(m_lineStarts.begin(), m_lineStarts.end(), searchPosition));
+	// The end of the line is the linefeed in front of the next line.
+	size_t const lineEnd = next(lineStart) != m_lineStarts.end() ? *next(lineStart) - 1 : m_source.size();
+	string line = m_source.substr(*lineStart, lineEnd - *lineStart);
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -103,18 +105,13 @@ string CharStream::lineAtPosition(int _position) const
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
-	using diff_type = string::difference_type;
 	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	// The last line that starts at or before the position.
+	auto lineStart = prev(upper_bound(m_lineStarts.begin(), m_lineStarts.end(), searchPosition));
+	return LineColumn{
+		static_cast<int>(lineStart - m_lineStarts.begin()),
+		static_cast<int>(searchPosition - *lineStart)
+	};
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -147,7 +144,17 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= m_lineStarts.size())
+		return nullopt;
+
+	size_t const line = static_cast<size_t>(_lineColumn.line);
+	size_t const offset = m_lineStarts[line];
+	// The end of the line is the linefeed in front of the next line.
+	size_t const endOfLine = line + 1 < m_lineStarts.size() ? m_lineStarts[line + 1] - 1 : m_source.size();
+
+	if (offset + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return offset + static_cast<size_t>(_lineColumn.column);
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
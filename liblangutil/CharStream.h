@@ -55,6 +55,7 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -71,8 +72,7 @@ class CharStream
 {
 public:
 	CharStream() = default;
-	CharStream(std::string _source, std::string _name):
-		m_source(std::move(_source)), m_name(std::move(_name)) {}
+	CharStream(std::string _source, std::string _name);
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
@@ -99,10 +99,11 @@ public:
 	/// Functions that help pretty-printing parse errors
 	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const;
+	/// Looks up the line in the line start offsets, so it does not depend on the size of the source.
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
 
-	/// Translates a line:column to the absolute position.
+	/// Translates a line:column to the absolute position using the line start offsets.
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
@@ -139,6 +140,8 @@ private:
 	std::string m_source;
 	std::string m_name;
 	size_t m_position{0};
+	/// Offsets of the first characters of all lines, i.e. zero and the offsets after each linefeed.
+	std::vector<size_t> m_lineStarts{0};
 };
 
 }
@@ -136,6 +136,8 @@ public:
 
 	// @returns true if the maximum error count has been reached.
 	bool hasExcessiveErrors() const;
+	/// @returns true if further warnings are not stored because there were too many.
+	bool hasExcessiveWarnings() const { return m_warningCount + 1 >= c_maxWarningsAllowed; }
 
 	class ErrorWatcher
 	{
@@ -287,7 +287,13 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 
 	int directionOverrideDepth = 0;
 
-	for (size_t currentPos = _startPosition; currentPos < endPosition; ++currentPos)
+	// All of the sequences start with the same byte, so only look at its occurrences.
+	string const& source = _stream.source();
+	for (
+		size_t currentPos = source.find('\xE2', _startPosition);
+		currentPos < endPosition;
+		currentPos = source.find('\xE2', currentPos + 1)
+	)
 	{
 		_stream.setPosition(currentPos);
 
@@ -311,9 +317,17 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
+	// Jump between the characters a line terminator can start with instead of advancing one by one.
+	static string_view constexpr lineTerminatorStarts{"\n\v\f\r\xC2\xE2"};
+	string const& source = m_source.source();
+	size_t position = source.find_first_of(lineTerminatorStarts, startPosition);
+	while (true)
+	{
+		m_char = m_source.setPosition(min(position, source.size()));
+		if (isSourcePastEndOfInput() || isUnicodeLinebreak())
 			break;
+		position = source.find_first_of(lineTerminatorStarts, position + 1);
+	}
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -391,26 +405,24 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	size_t endPosition = m_source.source().find("*/", startPosition);
+	if (endPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source.setPosition(m_source.size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// We have reached the end of the multi-line comment, we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_source.setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -803,6 +815,23 @@ bool Scanner::scanEscape()
 	return true;
 }
 
+size_t Scanner::plainStringCharacters(char _quote, bool _isUnicode) const
+{
+	string const& source = m_source.source();
+	size_t const start = m_source.position();
+	size_t end = start;
+	for (; end < source.size(); ++end)
+	{
+		auto const c = static_cast<unsigned char>(source[end]);
+		// Stops at the first byte of NEL (C2 85) as well, which is a line break.
+		if (c == static_cast<unsigned char>(_quote) || c == '\\' || c == 0xc2 || (0x0a <= c && c <= 0x0d))
+			break;
+		if (!_isUnicode && (c <= 0x1f || c >= 0x7f))
+			break;
+	}
+	return end - start;
+}
+
 bool Scanner::isUnicodeLinebreak()
 {
 	if (0x0a <= m_char && m_char <= 0x0d)
@@ -828,6 +857,13 @@ Token Scanner::scanString(bool const _isUnicode)
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
 	{
+		// Copy runs of characters that need no further checks at once, which matters for long literals.
+		if (size_t const runLength = plainStringCharacters(quote, _isUnicode))
+		{
+			m_tokens[NextNext].literal.append(m_source.source(), m_source.position(), runLength);
+			m_char = m_source.advanceAndGet(runLength);
+			continue;
+		}
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -1010,10 +1046,18 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Scan the rest of the identifier characters directly in the source and
+	// add them to the literal at once.
+	string const& source = m_source.source();
+	size_t const startPosition = m_source.position();
+	size_t endPosition = startPosition + 1;
+	while (
+		endPosition < source.size() &&
+		(isIdentifierPart(source[endPosition]) || (source[endPosition] == '.' && m_kind == ScannerKind::Yul))
+	)
+		++endPosition;
+	m_tokens[NextNext].literal.append(source, startPosition, endPosition - startPosition);
+	m_char = m_source.setPosition(endPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
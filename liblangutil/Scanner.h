@@ -102,7 +102,7 @@ class Scanner
 public:
 	explicit Scanner(CharStream& _source):
 		m_source(_source),
-		m_sourceName{std::make_shared<std::string>(_source.name())}
+		m_sourceName{internSourceName(_source.name())}
 	{
 		reset();
 	}
@@ -247,6 +247,10 @@ private:
 
 	/// @returns true iff we are currently positioned at a unicode line break.
 	bool isUnicodeLinebreak();
+	/// @returns the number of characters from the current position on that can be added to a
+	/// string literal delimited by @a _quote as they are, i.e. that are neither the quote,
+	/// escapes, line breaks nor invalid characters.
+	size_t plainStringCharacters(char _quote, bool _isUnicode) const;
 
 	/// Return the current source position.
 	size_t sourcePos() const { return m_source.position(); }
@@ -258,7 +262,7 @@ private:
 	TokenDesc m_tokens[3] = {}; // desc for the current, next and nextnext token
 
 	CharStream& m_source;
-	std::shared_ptr<std::string const> m_sourceName;
+	std::string const* m_sourceName = nullptr;
 
 	ScannerKind m_kind = ScannerKind::Solidity;
 
@@ -22,12 +22,23 @@
 #include <boost/algorithm/string.hpp>
 
 #include <iostream>
+#include <mutex>
+#include <unordered_set>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
-SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+string const* solidity::langutil::internSourceName(string const& _name)
+{
+	// Elements of an unordered_set keep their address when the set grows.
+	static mutex namesMutex;
+	static unordered_set<string> names;
+	lock_guard<mutex> lock(namesMutex);
+	return &*names.insert(_name).first;
+}
+
+SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<string const*> const& _sourceNames)
 {
 	// Expected input: "start:length:sourceindex"
 	enum SrcElem: size_t { Start, Length, Index };
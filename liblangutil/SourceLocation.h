@@ -32,9 +32,16 @@
 namespace solidity::langutil
 {
 
+/// @returns a copy of @a _name that is shared by all callers asking for the same name and that is
+/// valid until the end of the program. Thread-safe.
+/// Source locations refer to their source by such a pointer, so that they can be copied and
+/// compared for equality without touching the name itself.
+std::string const* internSourceName(std::string const& _name);
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
+ * The source name has to be obtained from @a internSourceName.
  */
 struct SourceLocation
 {
@@ -73,14 +80,7 @@ struct SourceLocation
 		return _other.start < end && start < _other.end;
 	}
 
-	bool equalSources(SourceLocation const& _other) const
-	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
-			return false;
-		return true;
-	}
+	bool equalSources(SourceLocation const& _other) const { return sourceName == _other.sourceName; }
 
 	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
@@ -108,12 +108,12 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	std::string const* sourceName = nullptr;
 };
 
 SourceLocation parseSourceLocation(
 	std::string const& _input,
-	std::vector<std::shared_ptr<std::string const>> const& _sourceNames
+	std::vector<std::string const*> const& _sourceNames
 );
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -25,6 +25,7 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/UTF8.h>
 #include <iomanip>
+#include <map>
 #include <string_view>
 
 using namespace std;
@@ -199,10 +200,64 @@ void SourceReferenceFormatter::printExceptionInformation(util::Exception const&
 	printExceptionInformation(SourceReferenceExtractor::extract(m_charStreamProvider, _exception, _severity));
 }
 
-void SourceReferenceFormatter::printErrorInformation(ErrorList const& _errors)
+void SourceReferenceFormatter::printErrorInformation(
+	ErrorList const& _errors,
+	optional<size_t> _maxWarningsPerSource
+)
 {
+	// The stream is often unbuffered, so writing every fragment of the output to it
+	// takes longer than formatting for large numbers of errors.
+	size_t const flushThreshold = 1 << 16;
+	ostringstream buffer;
+	SourceReferenceFormatter bufferedFormatter(buffer, m_charStreamProvider, m_colored, m_withErrorIds);
+
+	map<string, size_t> printedWarnings;
+	map<string, map<ErrorId, size_t>> skippedWarnings;
 	for (auto const& error: _errors)
-		printErrorInformation(*error);
+	{
+		if (_maxWarningsPerSource && Error::errorSeverity(error->type()) == Error::Severity::Warning)
+		{
+			SourceLocation const* location = error->sourceLocation();
+			string sourceName = location && location->sourceName ? *location->sourceName : "";
+			size_t& printed = printedWarnings[sourceName];
+			if (printed >= *_maxWarningsPerSource)
+			{
+				++skippedWarnings[sourceName][error->errorId()];
+				continue;
+			}
+			++printed;
+		}
+		bufferedFormatter.printErrorInformation(*error);
+		if (static_cast<size_t>(buffer.tellp()) >= flushThreshold)
+		{
+			m_stream << buffer.str();
+			buffer.str({});
+		}
+	}
+
+	for (auto const& [sourceName, warningsById]: skippedWarnings)
+	{
+		size_t count = 0;
+		for (auto const& idAndCount: warningsById)
+			count += idAndCount.second;
+		bufferedFormatter.errorColored(Error::Severity::Warning) << "Warning";
+		bufferedFormatter.messageColored() <<
+			": " << count << " more warning" << (count == 1 ? "" : "s") <<
+			(sourceName.empty() ? "" : " in " + sourceName) << " not shown";
+		if (m_withErrorIds)
+		{
+			string separator = " (";
+			for (auto const& [errorId, countById]: warningsById)
+			{
+				bufferedFormatter.messageColored() << separator << errorId.error << ": " << countById;
+				separator = ", ";
+			}
+			bufferedFormatter.messageColored() << ")";
+		}
+		bufferedFormatter.messageColored() << ".";
+		buffer << "\n\n";
+	}
+	m_stream << buffer.str();
 }
 
 void SourceReferenceFormatter::printErrorInformation(Error const& _error)
@@ -27,6 +27,7 @@
 #include <libsolutil/AnsiColorized.h>
 
 #include <ostream>
+#include <optional>
 #include <sstream>
 #include <functional>
 
@@ -53,7 +54,13 @@ public:
 	void printSourceLocation(SourceReference const& _ref);
 	void printExceptionInformation(SourceReferenceExtractor::Message const& _msg);
 	void printExceptionInformation(util::Exception const& _exception, std::string const& _severity);
-	void printErrorInformation(langutil::ErrorList const& _errors);
+	/// Prints all of @a _errors, writing the output to the stream in large chunks.
+	/// If @a _maxWarningsPerSource is set, further warnings of a source are only counted, without
+	/// extracting their source references, and summarized per source at the end.
+	void printErrorInformation(
+		langutil::ErrorList const& _errors,
+		std::optional<size_t> _maxWarningsPerSource = std::nullopt
+	);
 	void printErrorInformation(Error const& _error);
 
 	static std::string formatExceptionInformation(
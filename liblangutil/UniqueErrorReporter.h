@@ -85,6 +85,15 @@ public:
 		return false;
 	}
 
+	/// @returns true if an error or warning with @a _error at @a _location was already reported.
+	bool reported(ErrorId _error, SourceLocation const& _location) const
+	{
+		return m_seenErrors.count({_error, _location});
+	}
+
+	/// @returns true if further warnings are dropped because there were too many.
+	bool hasExcessiveWarnings() const { return m_errorReporter.hasExcessiveWarnings(); }
+
 	void markAsSeen(ErrorId _error, SourceLocation const& _location, std::string const& _description)
 	{
 		if (_location != SourceLocation{})
@@ -25,6 +25,8 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace solidity::smtutil
@@ -59,6 +61,11 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// @returns a description of the solver, its options and the Horn system together with
+	/// the query @a _expr, which determines the result of `query(_expr)`, or nullopt if
+	/// no such description is available.
+	virtual std::optional<std::string> queryDescription(Expression const& /*_expr*/) { return std::nullopt; }
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
 };
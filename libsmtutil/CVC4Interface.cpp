@@ -37,6 +37,7 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -58,6 +59,9 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	// Every declaration creates a new variable, which invalidates the translations using the old one.
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -122,6 +126,21 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 }
 
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	// Subterms are shared between the expressions built from them,
+	// so every shared node is only translated once.
+	auto key = make_tuple(_expr.arguments.node(), _expr.sort.get(), _expr.name);
+	if (auto const* translation = valueOrNullptr(m_translations, key))
+		return translation->second;
+	CVC4::Expr result = translate(_expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, result));
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
@@ -20,6 +20,9 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <map>
+#include <tuple>
+
 #if defined(__GLIBC__)
 // The CVC4 headers includes the deprecated system headers <ext/hash_map>
 // and <ext/hash_set>. These headers cause a warning that will break the
@@ -54,15 +57,20 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override { m_solver.interrupt(); }
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// Translations of expressions with arguments, keyed by their shared argument list, sort and name.
+	/// The values keep a copy of the expression, so that the keys stay valid.
+	std::map<std::tuple<void const*, Sort const*, std::string>, std::pair<Expression, CVC4::Expr>> m_translations;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
@@ -20,7 +20,6 @@
 
 #include <libsolutil/Keccak256.h>
 
-#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <range/v3/algorithm/find_if.hpp>
@@ -57,6 +56,7 @@ void SMTLib2Interface::reset()
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
 	m_userSorts.clear();
+	m_translations.clear();
 	write("(set-option :produce-models true)");
 	if (m_queryTimeout)
 		write("(set-option :timeout " + to_string(*m_queryTimeout) + ")");
@@ -111,15 +111,25 @@ void SMTLib2Interface::declareFunction(string const& _name, SortPointer const& _
 
 void SMTLib2Interface::addAssertion(Expression const& _expr)
 {
-	write("(assert " + toSExpr(_expr) + ")");
+	// Translating the expression can declare sorts, which are written before the assertion.
+	m_buffer = "(assert ";
+	writeSExpr(m_buffer, _expr);
+	m_buffer += ")";
+	write(m_buffer);
 }
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string command = checkSatAndGetValuesCommand(_expressionsToEvaluate);
+	m_buffer.clear();
+	for (string const& scope: m_accumulatedOutput)
+	{
+		if (&scope != &m_accumulatedOutput.front())
+			m_buffer += "\n";
+		m_buffer += scope;
+	}
+	m_buffer += command;
+	string response = querySolver(m_buffer);
 
 	CheckResult result;
 	// TODO proper parsing
@@ -138,54 +148,120 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 	return make_pair(result, values);
 }
 
+pair<CheckResult, vector<string>> SMTLib2Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	if (_assumptions.empty())
+		return check(_expressionsToEvaluate);
+
+	push();
+	ScopeGuard popAssumptions([&]() { pop(); });
+	addAssertion(_assumptions.size() == 1 ? _assumptions.front() : Expression::mkAnd(_assumptions));
+	return check(_expressionsToEvaluate);
+}
+
 string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	string sexpr;
+	writeSExpr(sexpr, _expr);
+	return sexpr;
+}
+
+void SMTLib2Interface::writeSExpr(string& _out, Expression const& _expr)
+{
+	// Only subterms that are shared by several expressions are remembered,
+	// the translations of all other subterms are part of a single query string anyway.
+	if (!_expr.arguments.shared())
+	{
+		translate(_out, _expr);
+		return;
+	}
+
+	auto key = make_tuple(_expr.arguments.node(), _expr.sort.get(), _expr.name);
+	if (auto const* translation = valueOrNullptr(m_translations, key))
+	{
+		_out += translation->second;
+		return;
+	}
+	size_t start = _out.size();
+	translate(_out, _expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, _out.substr(start)));
+}
+
+void SMTLib2Interface::translate(string& _out, Expression const& _expr)
 {
 	if (_expr.arguments.empty())
-		return _expr.name;
+	{
+		_out += _expr.name;
+		return;
+	}
 
-	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
-		auto arg = toSExpr(_expr.arguments.front());
-		auto int2bv = "(_ int2bv " + to_string(size) + ")";
+		string arg = toSExpr(_expr.arguments.front());
+		string int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(>= " + arg + " 0) " +
-			"(" + int2bv + " " + arg + ") " +
-			"(bvneg (" + int2bv + " (- " + arg + ")))";
+		_out += "(ite (>= ";
+		_out += arg;
+		_out += " 0) (";
+		_out += int2bv;
+		_out += " ";
+		_out += arg;
+		_out += ") (bvneg (";
+		_out += int2bv;
+		_out += " (- ";
+		_out += arg;
+		_out += "))))";
+		return;
 	}
 	else if (_expr.name == "bv2int")
 	{
 		auto intSort = dynamic_pointer_cast<IntSort>(_expr.sort);
 		smtAssert(intSort, "");
 
-		auto arg = toSExpr(_expr.arguments.front());
-		auto nat = "(bv2nat " + arg + ")";
-
 		if (!intSort->isSigned)
-			return nat;
+		{
+			_out += "(bv2nat ";
+			writeSExpr(_out, _expr.arguments.front());
+			_out += ")";
+			return;
+		}
 
 		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
 		smtAssert(bvSort, "");
-		auto size = to_string(bvSort->size);
-		auto pos = to_string(bvSort->size - 1);
+		string arg = toSExpr(_expr.arguments.front());
+		string pos = to_string(bvSort->size - 1);
 
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
-			"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
-			nat + " " +
-			"(- (bv2nat (bvneg " + arg + ")))";
+		_out += "(ite (= ((_ extract ";
+		_out += pos;
+		_out += " ";
+		_out += pos;
+		_out += ")";
+		_out += arg;
+		_out += ") #b0) (bv2nat ";
+		_out += arg;
+		_out += ") (- (bv2nat (bvneg ";
+		_out += arg;
+		_out += "))))";
+		return;
 	}
-	else if (_expr.name == "const_array")
+
+	_out += "(";
+	if (_expr.name == "const_array")
 	{
 		smtAssert(_expr.arguments.size() == 2, "");
 		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments.at(0).sort);
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		_out += "(as const ";
+		_out += toSmtLibSort(*arraySort);
+		_out += ") ";
+		writeSExpr(_out, _expr.arguments.at(1));
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -193,24 +269,34 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
+		_out += "|";
+		_out += tupleSort->members.at(index);
+		_out += "| ";
+		writeSExpr(_out, _expr.arguments.at(0));
 	}
 	else if (_expr.name == "tuple_constructor")
 	{
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
 		smtAssert(tupleSort, "");
-		sexpr += "|" + tupleSort->name + "|";
+		_out += "|";
+		_out += tupleSort->name;
+		_out += "|";
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_out += " ";
+			writeSExpr(_out, arg);
+		}
 	}
 	else
 	{
-		sexpr += _expr.name;
+		_out += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_out += " ";
+			writeSExpr(_out, arg);
+		}
 	}
-	sexpr += ")";
-	return sexpr;
+	_out += ")";
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
@@ -261,10 +347,11 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 	return ssort;
 }
 
-void SMTLib2Interface::write(string _data)
+void SMTLib2Interface::write(string const& _data)
 {
 	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	m_accumulatedOutput.back() += _data;
+	m_accumulatedOutput.back() += "\n";
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -29,6 +29,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace solidity::smtutil
@@ -56,6 +57,12 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	/// Asserts the conjunction of the assumptions in a new scope, so that the query
+	/// and with it the key of its response do not depend on how the assumptions are split.
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
@@ -70,8 +77,11 @@ public:
 
 private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
+	/// Appends the s-expression of @a _expr to @a _out, reusing the translations of shared subterms.
+	void writeSExpr(std::string& _out, Expression const& _expr);
+	void translate(std::string& _out, Expression const& _expr);
 
-	void write(std::string _data);
+	void write(std::string const& _data);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
@@ -79,7 +89,10 @@ private:
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
 
+	/// The commands of every scope.
 	std::vector<std::string> m_accumulatedOutput;
+	/// Reused for assertions and queries, so that their memory is only allocated once.
+	std::string m_buffer;
 	std::map<std::string, SortPointer> m_variables;
 
 	/// Each pair in this vector represents an SMTChecker created
@@ -88,6 +101,11 @@ private:
 	/// otherwise solvers cannot parse the queries.
 	std::vector<std::pair<std::string, std::string>> m_userSorts;
 
+	/// Translations of expressions whose arguments are shared by several expressions,
+	/// keyed by the shared argument list, sort and name.
+	/// The values keep a copy of the expression, so that the keys stay valid.
+	std::map<std::tuple<void const*, Sort const*, std::string>, std::pair<Expression, std::string>> m_translations;
+
 	std::map<util::h256, std::string> m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
 
@@ -26,6 +26,11 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -112,16 +117,44 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * The SMT-LIB2 interface, whose queries go through a callback, is asked first.
+ * Then all other solvers check concurrently (see `race`). Since a solver that is
+ * interrupted returns UNKNOWN or ERROR, this can hide a conflict with a solver that
+ * would have given a different answer later, but never changes an answer otherwise.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	auto runSolver = [&](size_t _index) {
+		return _assumptions.empty() ?
+			m_solvers[_index]->check(_expressionsToEvaluate) :
+			m_solvers[_index]->checkAssuming(_assumptions, _expressionsToEvaluate);
+	};
+
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size());
+	vector<size_t> concurrent;
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		if (dynamic_cast<SMTLib2Interface*>(m_solvers[i].get()))
+			results[i] = runSolver(i);
+		else
+			concurrent.push_back(i);
+	if (concurrent.size() == 1)
+		results[concurrent.front()] = runSolver(concurrent.front());
+	else if (concurrent.size() > 1)
+		race(concurrent, _assumptions, _expressionsToEvaluate, results);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& [result, values]: results)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -141,6 +174,47 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+void SMTPortfolio::race(
+	vector<size_t> const& _indices,
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate,
+	vector<pair<CheckResult, vector<string>>>& _results
+)
+{
+	mutex resultMutex;
+	vector<bool> finished(_indices.size(), false);
+	auto decided = [&]() {
+		for (size_t i = 0; i < _indices.size(); ++i)
+			if (finished[i])
+			{
+				CheckResult result = _results[_indices[i]].first;
+				if (result == CheckResult::UNSATISFIABLE)
+					return true;
+				if (
+					result == CheckResult::SATISFIABLE &&
+					all_of(finished.begin(), finished.begin() + static_cast<ptrdiff_t>(i), [](bool _f) { return _f; })
+				)
+					return true;
+			}
+		return false;
+	};
+
+	util::parallelFor(_indices.size(), _indices.size(), [&](size_t _i) {
+		SolverInterface& solver = *m_solvers[_indices[_i]];
+		auto outcome = _assumptions.empty() ?
+			solver.check(_expressionsToEvaluate) :
+			solver.checkAssuming(_assumptions, _expressionsToEvaluate);
+
+		lock_guard<mutex> lock(resultMutex);
+		_results[_indices[_i]] = move(outcome);
+		finished[_i] = true;
+		if (decided())
+			for (size_t j = 0; j < _indices.size(); ++j)
+				if (!finished[j])
+					m_solvers[_indices[j]]->interrupt();
+	});
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
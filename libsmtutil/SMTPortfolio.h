@@ -34,6 +34,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Solvers with a native API check concurrently, and the ones still running are
+ * interrupted once the result cannot change anymore.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -59,12 +61,27 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Runs the check on the solvers with the given indices concurrently, storing the outcomes
+	/// in @a _results. Solvers are interrupted as soon as one of them answers UNSATISFIABLE,
+	/// or one of them answers SATISFIABLE and all solvers before it have finished.
+	/// The latter keeps the values of a model independent of which solver is faster.
+	void race(
+		std::vector<size_t> const& _indices,
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate,
+		std::vector<std::pair<CheckResult, std::vector<std::string>>>& _results
+	);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
 
 	std::vector<Expression> m_assertions;
@@ -115,6 +115,41 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+class Expression;
+
+/// Immutable list of the arguments of an expression.
+/// Copies share the list, so that copying an expression does not copy its subterms
+/// and expressions built from other expressions form a DAG of shared nodes.
+class ExpressionArguments
+{
+public:
+	using const_iterator = std::vector<Expression>::const_iterator;
+
+	ExpressionArguments() = default;
+	ExpressionArguments(std::vector<Expression> _arguments);
+
+	size_t size() const;
+	bool empty() const { return !m_arguments; }
+	Expression const& operator[](size_t _index) const;
+	Expression const& at(size_t _index) const;
+	Expression const& front() const;
+	Expression const& back() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	operator std::vector<Expression> const&() const { return list(); }
+
+	/// @returns the shared list, or nullptr if there are no arguments.
+	/// Two expressions with the same node, name and sort are equal.
+	void const* node() const { return m_arguments.get(); }
+	/// @returns true if the list is shared by more than one expression.
+	bool shared() const { return m_arguments.use_count() > 1; }
+
+private:
+	std::vector<Expression> const& list() const;
+
+	std::shared_ptr<std::vector<Expression> const> m_arguments;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -486,7 +521,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	ExpressionArguments arguments;
 	SortPointer sort;
 
 private:
@@ -502,6 +537,26 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
 };
 
+inline ExpressionArguments::ExpressionArguments(std::vector<Expression> _arguments)
+{
+	if (!_arguments.empty())
+		m_arguments = std::make_shared<std::vector<Expression> const>(std::move(_arguments));
+}
+
+inline std::vector<Expression> const& ExpressionArguments::list() const
+{
+	static std::vector<Expression> const noArguments;
+	return m_arguments ? *m_arguments : noArguments;
+}
+
+inline size_t ExpressionArguments::size() const { return list().size(); }
+inline Expression const& ExpressionArguments::operator[](size_t _index) const { return list()[_index]; }
+inline Expression const& ExpressionArguments::at(size_t _index) const { return list().at(_index); }
+inline Expression const& ExpressionArguments::front() const { return list().front(); }
+inline Expression const& ExpressionArguments::back() const { return list().back(); }
+inline ExpressionArguments::const_iterator ExpressionArguments::begin() const { return list().begin(); }
+inline ExpressionArguments::const_iterator ExpressionArguments::end() const { return list().end(); }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -531,6 +586,24 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Checks for satisfiability like `check`, with @a _assumptions holding only for this check.
+	/// Solvers that support it keep what they learned about the asserted formulas between
+	/// such checks, instead of discarding it together with a scope.
+	virtual std::pair<CheckResult, std::vector<std::string>>
+	checkAssuming(std::vector<Expression> const& _assumptions, std::vector<Expression> const& _expressionsToEvaluate)
+	{
+		push();
+		ScopeGuard popAssumptions([&]() { pop(); });
+		for (auto const& assumption: _assumptions)
+			addAssertion(assumption);
+		return check(_expressionsToEvaluate);
+	}
+
+	/// Makes a check that is running on another thread return as soon as possible,
+	/// without a definitive answer. Has no effect if no check is running.
+	/// This is the only function that may be called concurrently with another one.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
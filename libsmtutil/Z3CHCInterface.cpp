@@ -19,6 +19,7 @@
 #include <libsmtutil/Z3CHCInterface.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Visitor.h>
 
 #include <set>
 #include <stack>
@@ -27,6 +28,28 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
+namespace
+{
+
+/// Calls @a _visitor for @a _expr and all its subterms. Argument lists are shared between
+/// expressions, so the ones in @a _visited are skipped and visited ones are added to it.
+template <typename Visitor>
+void visitSubterms(Expression const& _expr, set<void const*>& _visited, Visitor&& _visitor)
+{
+	vector<Expression const*> toVisit{&_expr};
+	while (!toVisit.empty())
+	{
+		Expression const* expr = toVisit.back();
+		toVisit.pop_back();
+		_visitor(*expr);
+		if (!expr->arguments.empty() && _visited.insert(expr->arguments.node()).second)
+			for (Expression const& argument: expr->arguments)
+				toVisit.push_back(&argument);
+	}
+}
+
+}
+
 Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
 	CHCSolverInterface(_queryTimeout),
 	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
@@ -59,11 +82,35 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	if (m_record)
+	{
+		m_record->emplace_back(RecordedRelation{_expr});
+		m_relations.insert(_expr.name);
+	}
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	if (m_record)
+	{
+		// Rules are either facts or implications whose conclusion is their head.
+		bool implication = _expr.name == "=>" && _expr.arguments.size() == 2;
+		Expression const& head = implication ? _expr.arguments.at(1) : _expr;
+		auto entry = make_pair(m_record->size(), implication ? appliedRelations(_expr.arguments.at(0)) : set<string>{});
+		if (m_relations.count(head.name))
+			m_rulesByHead[head.name].emplace_back(move(entry));
+		else
+		{
+			entry.second += appliedRelations(head);
+			m_unslicedRules.emplace_back(move(entry));
+		}
+		m_record->emplace_back(RecordedRule{_expr, _name});
+		++m_recordedRules;
+		// All queries are answered by slices, which are built from the record.
+		if (m_slicing)
+			return;
+	}
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
@@ -77,8 +124,149 @@ void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 	}
 }
 
+optional<string> Z3CHCInterface::queryDescription(Expression const& _expr)
+{
+	// The slice does not depend on the parts of the system that cannot influence the result.
+	if (m_record)
+		return slice(_expr)->queryDescription(_expr);
+
+	z3::expr_vector queries(*m_context);
+	queries.push_back(m_z3Interface->toZ3Expr(_expr));
+	return
+		"z3 " +
+		to_string(get<0>(m_version)) + "." +
+		to_string(get<1>(m_version)) + "." +
+		to_string(get<2>(m_version)) + "." +
+		to_string(get<3>(m_version)) + " " +
+		(m_queryTimeout ? "timeout " + to_string(*m_queryTimeout) : "rlimit " + to_string(Z3Interface::resourceLimit)) + "\n" +
+		m_solver.to_string(queries);
+}
+
+void Z3CHCInterface::enableRecording()
+{
+	smtAssert(m_z3Interface->constants().empty() && m_z3Interface->functions().empty(), "");
+	m_record.emplace();
+	// Variables are also declared directly via the Z3Interface by the encoding context.
+	m_z3Interface->setDeclarationObserver([this](string const& _name, SortPointer const& _sort) {
+		m_record->emplace_back(RecordedDeclaration{_name, _sort});
+	});
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::clone() const
+{
+	smtAssert(m_record, "Recording has to be enabled to clone the Horn system.");
+	auto clone = make_unique<Z3CHCInterface>(m_queryTimeout);
+	clone->setSpacerOptions(m_preProcessing);
+	if (m_slicing)
+		clone->enableSlicing();
+	for (auto const& entry: *m_record)
+		std::visit(util::GenericVisitor{
+			[&](RecordedDeclaration const& _declaration) { clone->declareVariable(_declaration.name, _declaration.sort); },
+			[&](RecordedRelation const& _relation) { clone->registerRelation(_relation.relation); },
+			[&](RecordedRule const& _rule) { clone->addRule(_rule.rule, _rule.name); }
+		}, entry);
+	return clone;
+}
+
+void Z3CHCInterface::enableSlicing()
+{
+	if (!m_record)
+		enableRecording();
+	m_slicing = true;
+}
+
+unique_ptr<Z3CHCInterface> Z3CHCInterface::slice(Expression const& _query) const
+{
+	smtAssert(m_record, "Recording has to be enabled to slice the Horn system.");
+	set<size_t> rules = sliceRules(_query);
+
+	// Only what the rules and the query refer to is declared, so that rules do not quantify over
+	// unrelated variables and the slice is the same for all systems that agree on these rules.
+	set<string> names;
+	set<void const*> visited;
+	auto collectName = [&](Expression const& _expr) { names.insert(_expr.name); };
+	visitSubterms(_query, visited, collectName);
+	for (size_t rule: rules)
+		visitSubterms(get<RecordedRule>(m_record->at(rule)).rule, visited, collectName);
+
+	auto slice = make_unique<Z3CHCInterface>(m_queryTimeout);
+	slice->setSpacerOptions(m_preProcessing);
+	for (size_t i = 0; i < m_record->size(); ++i)
+		std::visit(util::GenericVisitor{
+			[&](RecordedDeclaration const& _declaration) {
+				if (names.count(_declaration.name))
+					slice->declareVariable(_declaration.name, _declaration.sort);
+			},
+			[&](RecordedRelation const& _relation) {
+				if (names.count(_relation.relation.name))
+					slice->registerRelation(_relation.relation);
+			},
+			[&](RecordedRule const& _rule) {
+				if (rules.count(i))
+					slice->addRule(_rule.rule, _rule.name);
+			}
+		}, m_record->at(i));
+	return slice;
+}
+
+pair<size_t, size_t> Z3CHCInterface::sliceSize(Expression const& _query) const
+{
+	smtAssert(m_record, "Recording has to be enabled to slice the Horn system.");
+	return {sliceRules(_query).size(), m_recordedRules};
+}
+
+set<size_t> Z3CHCInterface::sliceRules(Expression const& _query) const
+{
+	return get<0>(sliceContents(_query));
+}
+
+set<string> Z3CHCInterface::sliceRelations(Expression const& _query) const
+{
+	smtAssert(m_record, "Recording has to be enabled to slice the Horn system.");
+	return get<1>(sliceContents(_query));
+}
+
+pair<set<size_t>, set<string>> Z3CHCInterface::sliceContents(Expression const& _query) const
+{
+	set<size_t> rules;
+	set<string> relations = appliedRelations(_query);
+	vector<string> toVisit(relations.begin(), relations.end());
+	auto include = [&](pair<size_t, set<string>> const& _rule) {
+		rules.insert(_rule.first);
+		for (string const& relation: _rule.second)
+			if (relations.insert(relation).second)
+				toVisit.push_back(relation);
+	};
+
+	for (auto const& rule: m_unslicedRules)
+		include(rule);
+	while (!toVisit.empty())
+	{
+		string relation = move(toVisit.back());
+		toVisit.pop_back();
+		if (auto const* headRules = util::valueOrNullptr(m_rulesByHead, relation))
+			for (auto const& rule: *headRules)
+				include(rule);
+	}
+	return {move(rules), move(relations)};
+}
+
+set<string> Z3CHCInterface::appliedRelations(Expression const& _expr) const
+{
+	set<string> relations;
+	set<void const*> visited;
+	visitSubterms(_expr, visited, [&](Expression const& _subterm) {
+		if (m_relations.count(_subterm.name))
+			relations.insert(_subterm.name);
+	});
+	return relations;
+}
+
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
 {
+	if (m_slicing)
+		return slice(_expr)->query(_expr);
+
 	CheckResult result;
 	try
 	{
@@ -130,6 +318,8 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 {
+	m_preProcessing = _preProcessing;
+
 	// Spacer options.
 	// These needs to be set in the solver.
 	// https://github.com/Z3Prover/z3/blob/master/src/muz/base/fp_params.pyg
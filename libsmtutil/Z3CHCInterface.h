@@ -25,7 +25,12 @@
 #include <libsmtutil/CHCSolverInterface.h>
 #include <libsmtutil/Z3Interface.h>
 
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <tuple>
+#include <variant>
 #include <vector>
 
 namespace solidity::smtutil
@@ -45,11 +50,55 @@ public:
 
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	/// If recording is enabled, only the slice for @a _expr is described, see @a slice.
+	std::optional<std::string> queryDescription(Expression const& _expr) override;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	/// Records all declarations, relations and rules from now on, so that @a clone can rebuild
+	/// the Horn system. Has to be called before anything is added to the solver.
+	void enableRecording();
+	/// @returns a new interface with its own Z3 context that contains the recorded Horn system.
+	/// Queries to the new interface can run on another thread than queries to this one.
+	std::unique_ptr<Z3CHCInterface> clone() const;
+
+	/// Answers every query on its slice, see @a slice. Implies recording.
+	void enableSlicing();
+	/// @returns a new interface with its own Z3 context that contains the recorded Horn system,
+	/// restricted to the rules that can be part of a derivation of @a _query, i.e. the rules
+	/// whose head is a relation that the query depends on.
+	/// Does not modify this interface, so that slices can be created concurrently.
+	std::unique_ptr<Z3CHCInterface> slice(Expression const& _query) const;
+	/// @returns the number of rules in the slice for @a _query and in the whole Horn system.
+	std::pair<size_t, size_t> sliceSize(Expression const& _query) const;
+	/// @returns the names of the relations whose rules are all part of the slice for @a _query.
+	std::set<std::string> sliceRelations(Expression const& _query) const;
+
 private:
+	struct RecordedDeclaration
+	{
+		std::string name;
+		SortPointer sort;
+	};
+	struct RecordedRelation
+	{
+		Expression relation;
+	};
+	struct RecordedRule
+	{
+		Expression rule;
+		std::string name;
+	};
+
+	/// @returns the indices in the record of the rules in the slice for @a _query.
+	std::set<size_t> sliceRules(Expression const& _query) const;
+	/// @returns the indices of the rules in the slice for @a _query and the relations they define.
+	std::pair<std::set<size_t>, std::set<std::string>> sliceContents(Expression const& _query) const;
+	/// @returns the names of the registered relations that are applied in @a _expr.
+	std::set<std::string> appliedRelations(Expression const& _expr) const;
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -67,6 +116,21 @@ private:
 	z3::fixedpoint m_solver;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	/// Everything added to the solver in order, if recording is enabled. The order matters,
+	/// since rules quantify over the variables declared before them.
+	std::optional<std::vector<std::variant<RecordedDeclaration, RecordedRelation, RecordedRule>>> m_record;
+	/// Names of the recorded relations.
+	std::set<std::string> m_relations;
+	/// For the recorded rules whose head applies a relation, the name of that relation together
+	/// with the index of the rule in the record and the relations applied in its body.
+	std::map<std::string, std::vector<std::pair<size_t, std::set<std::string>>>> m_rulesByHead;
+	/// Recorded rules whose head is not a relation application, which are part of every slice.
+	std::vector<std::pair<size_t, std::set<std::string>>> m_unslicedRules;
+	size_t m_recordedRules = 0;
+
+	bool m_slicing = false;
+	bool m_preProcessing = true;
 };
 
 }
@@ -55,38 +55,60 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
+	m_assumptionLiterals.clear();
+	m_assumptionLiterals.emplace_back();
 	m_solver.reset();
 }
 
 void Z3Interface::push()
 {
 	m_solver.push();
+	m_assumptionLiterals.emplace_back();
 }
 
 void Z3Interface::pop()
 {
 	m_solver.pop();
+	smtAssert(m_assumptionLiterals.size() > 1, "");
+	m_assumptionLiterals.pop_back();
 }
 
 void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_declarationObserver)
+		m_declarationObserver(_name, _sort);
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
-	else if (m_constants.count(_name))
-		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
 	else
-		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
+	{
+		z3::expr constant = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		if (auto const* previous = valueOrNullptr(m_constants, _name))
+		{
+			// z3 terms are hash-consed, so the translations only change if the sort does.
+			if (!z3::eq(*previous, constant))
+				m_translations.clear();
+			m_constants.at(_name) = constant;
+		}
+		else
+			m_constants.emplace(_name, constant);
+	}
 }
 
 void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 {
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
-	if (m_functions.count(_name))
-		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	z3::func_decl function = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+	if (auto const* previous = valueOrNullptr(m_functions, _name))
+	{
+		if (!z3::eq(*previous, function))
+			m_translations.clear();
+		m_functions.at(_name) = function;
+	}
 	else
-		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
+		m_functions.emplace(_name, function);
 }
 
 void Z3Interface::addAssertion(Expression const& _expr)
@@ -95,12 +117,23 @@ void Z3Interface::addAssertion(Expression const& _expr)
 }
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> Z3Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
 {
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		z3::expr_vector literals(m_context);
+		for (Expression const& assumption: _assumptions)
+			literals.push_back(assumptionLiteral(toZ3Expr(assumption)));
+		switch (literals.empty() ? m_solver.check() : m_solver.check(literals))
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -139,7 +172,35 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+z3::expr Z3Interface::assumptionLiteral(z3::expr const& _assumption)
+{
+	for (auto const& literals: m_assumptionLiterals)
+		if (auto const* literal = valueOrNullptr(literals, _assumption.id()))
+			return literal->second;
+
+	z3::expr literal = m_context.bool_const(("assumption#" + to_string(m_assumptionLiteralCount++)).c_str());
+	m_solver.add(z3::implies(literal, _assumption));
+	// The assumption is kept alive together with the literal, so that its id is not reused.
+	m_assumptionLiterals.back().emplace(_assumption.id(), make_pair(_assumption, literal));
+	return literal;
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	// Subterms are shared between the expressions built from them,
+	// so every shared node is only translated once.
+	auto key = make_tuple(_expr.arguments.node(), _expr.sort.get(), _expr.name);
+	if (auto const* translation = valueOrNullptr(m_translations, key))
+		return translation->second;
+	z3::expr result = translate(_expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, result));
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
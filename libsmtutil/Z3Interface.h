@@ -21,6 +21,11 @@
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
 namespace solidity::smtutil
 {
 
@@ -44,6 +49,13 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	/// Asserts every assumption as implied by a fresh Boolean literal and checks
+	/// under the assumption of these literals, so that the solver keeps its state.
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
+	void interrupt() override { m_context.interrupt(); }
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -53,12 +65,21 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// Calls @a _observer for every variable declared from now on.
+	void setDeclarationObserver(std::function<void(std::string const&, SortPointer const&)> _observer)
+	{
+		m_declarationObserver = std::move(_observer);
+	}
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
 
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
+	z3::expr translate(Expression const& _expr);
+	/// @returns the literal that implies @a _assumption, asserting the implication if it is new.
+	z3::expr assumptionLiteral(z3::expr const& _assumption);
 
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
@@ -70,6 +91,17 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	/// Translations of expressions with arguments, keyed by their shared argument list, sort and name.
+	/// The values keep a copy of the expression, so that the keys stay valid.
+	std::map<std::tuple<void const*, Sort const*, std::string>, std::pair<Expression, z3::expr>> m_translations;
+
+	/// Literals of the assumptions, keyed by the id of the assumption, for every scope.
+	/// The implication of a literal is removed from the solver when its scope is popped.
+	std::vector<std::map<unsigned, std::pair<z3::expr, z3::expr>>> m_assumptionLiterals{1};
+	size_t m_assumptionLiteralCount = 0;
+
+	std::function<void(std::string const&, SortPointer const&)> m_declarationObserver;
 };
 
 }
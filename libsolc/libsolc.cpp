@@ -28,6 +28,8 @@
 
 #include <cstdlib>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "license.h"
@@ -45,6 +47,17 @@ namespace
 // The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static list<string> solidityAllocations;
+/// Guards solidityAllocations, which callbacks may extend from any thread.
+static mutex solidityAllocationsMutex;
+/// Serializes compilations, because the compiler relies on global state like the TypeProvider.
+static mutex compilationMutex;
+
+/// @returns a pointer to the data of a new allocation holding @p _data.
+char* addAllocation(string _data)
+{
+	lock_guard<mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -53,6 +66,7 @@ static list<string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -109,11 +123,21 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
+	lock_guard<mutex> lock(compilationMutex);
 	return compiler.compile(move(_input));
 }
 
 }
 
+struct SolidityContext
+{
+	explicit SolidityContext(CStyleReadFileCallback _readCallback, void* _readContext):
+		compiler(wrapReadCallback(_readCallback, _readContext))
+	{}
+
+	StandardCompiler compiler;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -129,14 +153,42 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return addAllocation(compile(_input, _readCallback, _readContext));
+}
+
+extern SolidityContext* solidity_context_create(CStyleReadFileCallback _readCallback, void* _readContext) noexcept
+{
+	try
+	{
+		return new SolidityContext(_readCallback, _readContext);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern char* solidity_context_compile(SolidityContext* _context, char const* _input) noexcept
+{
+	string output;
+	{
+		// Compilations of different contexts do not run in parallel, see libsolc.h.
+		lock_guard<mutex> lock(compilationMutex);
+		output = _context->compiler.compile(string(_input));
+	}
+	return addAllocation(move(output));
+}
+
+extern void solidity_context_destroy(SolidityContext* _context) noexcept
+{
+	delete _context;
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return addAllocation(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -153,8 +205,12 @@ extern void solidity_free(char* _data) noexcept
 extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
-	// can be freed here.
-	yul::YulStringRepository::reset();
+	// can be freed here. The allocations of all threads are released, see the warning in libsolc.h.
+	{
+		lock_guard<mutex> lock(compilationMutex);
+		yul::YulStringRepository::reset();
+	}
+	lock_guard<mutex> lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
 }
@@ -90,10 +90,41 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Opaque handle of a compilation context created by solidity_context_create().
+typedef struct SolidityContext SolidityContext;
+
+/// Creates a compilation context that keeps its read callback between compilations.
+/// The settings are taken from the input of each compilation.
+///
+/// @param _readCallback The optional callback pointer used by all compilations in this context. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns The new context, which must be released using solidity_context_destroy(), or NULL on failure.
+SolidityContext* solidity_context_create(CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
+
+/// Takes a "Standard Input JSON" and returns a "Standard Output JSON" like solidity_compile(),
+/// but uses the read callback of @p _context.
+///
+/// Contexts do not compile in parallel: the compiler uses global state, so all compilations
+/// of all contexts run one after the other, even if they are started from different threads.
+/// A single context must not be used from multiple threads at the same time. See solidity_reset()
+/// for the allocations, which are shared by all contexts.
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_context_compile(SolidityContext* _context, char const* _input) SOLC_NOEXCEPT;
+
+/// Releases a context created by solidity_context_create(). Results returned by
+/// solidity_context_compile() stay valid until they are freed.
+void solidity_context_destroy(SolidityContext* _context) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
-/// is invalid after calling this!
+/// is invalid after calling this! This includes the results of solidity_context_compile() of all contexts.
+///
+/// Not thread-safe: the allocations are shared by all threads and contexts, so this must not be called
+/// while any other thread still uses a pointer returned by the library or compiles. Multi-threaded
+/// users should release individual results with solidity_free() instead.
 void solidity_reset() SOLC_NOEXCEPT;
 
 #ifdef __cplusplus
@@ -89,14 +89,35 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			return nullopt;
 		else
 			return _left.numerator() & _right.numerator();
-	case Token::Add: return _left + _right;
-	case Token::Sub: return _left - _right;
-	case Token::Mul: return _left * _right;
+	// For integers, operate on the numerators directly to avoid the normalisation
+	// of the rational arithmetic.
+	case Token::Add:
+		if (fractional)
+			return _left + _right;
+		else
+			return rational(_left.numerator() + _right.numerator());
+	case Token::Sub:
+		if (fractional)
+			return _left - _right;
+		else
+			return rational(_left.numerator() - _right.numerator());
+	case Token::Mul:
+		if (fractional)
+			return _left * _right;
+		else
+			return rational(_left.numerator() * _right.numerator());
 	case Token::Div:
 		if (_right == rational(0))
 			return nullopt;
-		else
-			return _left / _right;
+		else if (!fractional)
+		{
+			bigint remainder;
+			bigint quotient;
+			boost::multiprecision::divide_qr(_left.numerator(), _right.numerator(), quotient, remainder);
+			if (remainder == 0)
+				return rational(quotient);
+		}
+		return _left / _right;
 	case Token::Mod:
 		if (_right == rational(0))
 			return nullopt;
@@ -113,6 +134,7 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 		if (_right.denominator() != 1)
 			return nullopt;
 		bigint const& exp = _right.numerator();
+		bool integralBase = _left.denominator() == 1;
 
 		// x ** 0 = 1
 		// for 0, 1 and -1 the size of the exponent doesn't have to be restricted
@@ -127,12 +149,17 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 		}
 		else
 		{
-			if (abs(exp) > numeric_limits<uint32_t>::max())
+			// Any base other than 0, 1 and -1 needs at least one bit per unit of the exponent,
+			// so reject exponents beyond the precision limit before doing any further work.
+			if (abs(exp) > 4096)
 				return nullopt; // This will need too much memory to represent.
 
 			uint32_t absExp = bigint(abs(exp)).convert_to<uint32_t>();
 
-			if (!fitsPrecisionExp(abs(_left.numerator()), absExp) || !fitsPrecisionExp(abs(_left.denominator()), absExp))
+			if (
+				!fitsPrecisionExp(abs(_left.numerator()), absExp) ||
+				(!integralBase && !fitsPrecisionExp(_left.denominator(), absExp))
+			)
 				return nullopt;
 
 			static auto const optimizedPow = [](bigint const& _base, uint32_t _exponent) -> bigint {
@@ -145,6 +172,8 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			};
 
 			bigint numerator = optimizedPow(_left.numerator(), absExp);
+			if (integralBase && exp >= 0)
+				return rational(numerator);
 			bigint denominator = optimizedPow(_left.denominator(), absExp);
 
 			if (exp >= 0)
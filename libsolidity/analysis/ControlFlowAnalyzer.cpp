@@ -23,7 +23,11 @@
 
 #include <range/v3/algorithm/sort.hpp>
 
+#include <boost/dynamic_bitset.hpp>
+
+#include <deque>
 #include <functional>
+#include <unordered_map>
 
 using namespace std;
 using namespace std::placeholders;
@@ -41,7 +45,7 @@ bool ControlFlowAnalyzer::run()
 
 void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractDefinition const* _contract, FunctionFlow const& _flow)
 {
-	if (!_function.isImplemented())
+	if (!_function.isImplemented() || _function.body().skipped())
 		return;
 
 	optional<string> mostDerivedContractName;
@@ -63,47 +67,82 @@ void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractD
 
 void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
 {
+	// Number the nodes reachable from the entry, the variables occurring in them and the
+	// occurrences that read variables, so that the sets of the dataflow analysis below
+	// can be bitsets and the per-node information can live in a vector.
+	vector<CFGNode const*> nodes;
+	unordered_map<CFGNode const*, size_t> nodeIndices;
+	unordered_map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	unordered_map<VariableOccurrence const*, size_t> accessIndices;
+	util::BreadthFirstSearch<CFGNode const*>{{_entry}}.run(
+		[&](CFGNode const* _node, auto&& _addChild) {
+			nodeIndices.emplace(_node, nodes.size());
+			nodes.push_back(_node);
+			for (VariableOccurrence const& variableOccurrence: _node->variableOccurrences)
+			{
+				variableIndices.emplace(&variableOccurrence.declaration(), variableIndices.size());
+				if (
+					variableOccurrence.kind() != VariableOccurrence::Kind::Assignment &&
+					variableOccurrence.kind() != VariableOccurrence::Kind::Declaration
+				)
+				{
+					accessIndices.emplace(&variableOccurrence, accesses.size());
+					accesses.push_back(&variableOccurrence);
+				}
+			}
+			for (CFGNode const* exit: _node->exits)
+				_addChild(exit);
+		}
+	);
+
 	struct NodeInfo
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
+		boost::dynamic_bitset<> unassignedVariablesAtEntry;
+		boost::dynamic_bitset<> unassignedVariablesAtExit;
+		boost::dynamic_bitset<> uninitializedVariableAccesses;
 		/// Propagate the information from another node to this node.
 		/// To be used to propagate information from a node to its exit nodes.
 		/// Returns true, if new variables were added and thus the current node has
 		/// to be traversed again.
 		bool propagateFrom(NodeInfo const& _entryNode)
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			bool changed =
+				!_entryNode.unassignedVariablesAtExit.is_subset_of(unassignedVariablesAtEntry) ||
+				!_entryNode.uninitializedVariableAccesses.is_subset_of(uninitializedVariableAccesses);
+			unassignedVariablesAtEntry |= _entryNode.unassignedVariablesAtExit;
+			uninitializedVariableAccesses |= _entryNode.uninitializedVariableAccesses;
+			return changed;
 		}
 	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
+	vector<NodeInfo> nodeInfos(nodes.size(), NodeInfo{
+		boost::dynamic_bitset<>(variableIndices.size()),
+		boost::dynamic_bitset<>(variableIndices.size()),
+		boost::dynamic_bitset<>(accesses.size())
+	});
 
-	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
-	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
-	// variables and accesses.
+	// Every node is traversed at least once. Afterwards, a node is queued again whenever
+	// ``NodeInfo::propagateFrom`` adds something to it, until all paths have been walked with
+	// maximal sets of unassigned variables and accesses.
+	deque<size_t> nodesToTraverse;
+	vector<bool> queued(nodes.size(), true);
+	for (size_t i = 0; i < nodes.size(); ++i)
+		nodesToTraverse.push_back(i);
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
-		nodesToTraverse.erase(nodesToTraverse.begin());
+		size_t currentIndex = nodesToTraverse.front();
+		nodesToTraverse.pop_front();
+		queued[currentIndex] = false;
 
-		auto& nodeInfo = nodeInfos[currentNode];
+		auto& nodeInfo = nodeInfos[currentIndex];
 		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		for (auto const& variableOccurrence: nodes[currentIndex]->variableOccurrences)
 		{
+			size_t variableIndex = variableIndices.at(&variableOccurrence.declaration());
 			switch (variableOccurrence.kind())
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(variableIndex);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -111,37 +150,40 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
+					if (unassignedVariables.test(variableIndex))
 					{
 						// Merely store the unassigned access. We do not generate an error right away, since this
 						// path might still always revert. It is only an error if this is propagated to the exit
 						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
+						nodeInfo.uninitializedVariableAccesses.set(accessIndices.at(&variableOccurrence));
 					}
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(variableIndex);
 					break;
 			}
 		}
 		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = util::valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
+		for (CFGNode const* exit: nodes[currentIndex]->exits)
+		{
+			size_t exitIndex = nodeIndices.at(exit);
+			if (nodeInfos[exitIndex].propagateFrom(nodeInfo) && !queued[exitIndex])
+			{
+				queued[exitIndex] = true;
+				nodesToTraverse.push_back(exitIndex);
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	auto exitIndex = nodeIndices.find(_exit);
+	if (exitIndex != nodeIndices.end() && nodeInfos[exitIndex->second].uninitializedVariableAccesses.any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		auto const& exitAccesses = nodeInfos[exitIndex->second].uninitializedVariableAccesses;
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (size_t i = exitAccesses.find_first(); i != boost::dynamic_bitset<>::npos; i = exitAccesses.find_next(i))
+			uninitializedAccessesOrdered.push_back(accesses[i]);
 		ranges::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
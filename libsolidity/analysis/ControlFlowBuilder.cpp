@@ -335,7 +335,9 @@ bool ControlFlowBuilder::visit(ModifierInvocation const& _modifierInvocation)
 	else
 		solAssert(requiredLookup == VirtualLookup::Static);
 
-	if (!modifierDefinition->isImplemented())
+	// Treat modifiers with skipped bodies like unimplemented ones, since we do not know
+	// where their placeholder is.
+	if (!modifierDefinition->isImplemented() || modifierDefinition->body().skipped())
 		return false;
 
 	solAssert(!!m_returnNode, "");
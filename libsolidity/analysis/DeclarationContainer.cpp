@@ -42,10 +42,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(*_name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(*_name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -92,6 +92,7 @@ void DeclarationContainer::activateVariable(ASTString const& _name)
 	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
 	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
 	m_invisibleDeclarations.erase(_name);
+	++m_version;
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -130,6 +131,7 @@ bool DeclarationContainer::registerDeclaration(
 	vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
+	++m_version;
 	return true;
 }
 
@@ -150,30 +152,55 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 ) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
-	vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	// Recursive lookups from deeply nested scopes walk the whole chain of enclosing
+	// containers, so their results are memoized until one of those containers changes.
+	size_t version = 0;
+	unordered_map<ASTString, pair<size_t, vector<Declaration const*>>>* resolvedNames = nullptr;
+	if (_recursive && m_enclosingContainer)
 	{
-		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_declarations.at(_name);
+		version = chainVersion();
+		resolvedNames = &m_resolvedNames[(_alsoInvisible ? 1u : 0u) | (_onlyVisibleAsUnqualifiedNames ? 2u : 0u)];
+		if (auto it = resolvedNames->find(_name); it != resolvedNames->end() && it->second.first == version)
+			return it->second.second;
 	}
 
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
+	vector<Declaration const*> result;
+
+	if (auto it = m_declarations.find(_name); it != m_declarations.end())
 	{
 		if (_onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_invisibleDeclarations.at(_name);
+			result += it->second;
 	}
 
+	if (_alsoInvisible)
+		if (auto it = m_invisibleDeclarations.find(_name); it != m_invisibleDeclarations.end())
+		{
+			if (_onlyVisibleAsUnqualifiedNames)
+				result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			else
+				result += it->second;
+		}
+
 	if (result.empty() && _recursive && m_enclosingContainer)
 		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible, _onlyVisibleAsUnqualifiedNames);
 
+	if (resolvedNames)
+		(*resolvedNames)[_name] = {version, result};
+
 	return result;
 }
 
+size_t DeclarationContainer::chainVersion() const
+{
+	size_t version = 0;
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+		version += container->m_version;
+	return version;
+}
+
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
 
@@ -27,6 +27,9 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
+#include <unordered_map>
+
 namespace solidity::frontend
 {
 
@@ -92,6 +95,11 @@ public:
 	void populateHomonyms(std::back_insert_iterator<Homonyms> _it) const;
 
 private:
+	/// @returns the sum of the modification counters of this and all enclosing containers.
+	/// Since the counters only ever increase, an unchanged sum means that none of the
+	/// containers a recursive lookup can reach has been modified.
+	size_t chainVersion() const;
+
 	ASTNode const* m_enclosingNode = nullptr;
 	DeclarationContainer const* m_enclosingContainer = nullptr;
 	std::vector<DeclarationContainer const*> m_innerContainers;
@@ -99,6 +107,14 @@ private:
 	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
 	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
+	/// Number of modifications of this container, used to invalidate m_resolvedNames.
+	size_t m_version = 0;
+	/// Results of recursive lookups, indexed by the flags of resolveName, together with the
+	/// chain version they were computed at.
+	mutable std::array<
+		std::unordered_map<ASTString, std::pair<size_t, std::vector<Declaration const*>>>,
+		4
+	> m_resolvedNames;
 };
 
 }
@@ -124,7 +124,10 @@ bool DocStringTagParser::visit(FunctionDefinition const& _function)
 	if (_function.isConstructor())
 		handleConstructor(_function, _function, _function.annotation());
 	else
+	{
 		handleCallable(_function, _function, _function.annotation());
+		handleOptimizerHint(_function);
+	}
 	return true;
 }
 
@@ -282,7 +285,7 @@ void DocStringTagParser::handleCallable(
 	static set<string> const validEventTags = set<string>{"dev", "notice", "return", "param"};
 	static set<string> const validErrorTags = set<string>{"dev", "notice", "param"};
 	static set<string> const validModifierTags = set<string>{"dev", "notice", "param", "inheritdoc"};
-	static set<string> const validTags = set<string>{"dev", "notice", "return", "param", "inheritdoc"};
+	static set<string> const validTags = set<string>{"dev", "notice", "return", "param", "inheritdoc", "solidity"};
 
 	if (dynamic_cast<EventDefinition const*>(&_callable))
 		parseDocStrings(_node, _annotation, validEventTags, "events");
@@ -296,6 +299,41 @@ void DocStringTagParser::handleCallable(
 	checkParameters(_callable, _node, _annotation);
 }
 
+void DocStringTagParser::handleOptimizerHint(FunctionDefinition const& _function)
+{
+	using OptimizerHint = FunctionDefinitionAnnotation::OptimizerHint;
+	static map<string, OptimizerHint> const hints{
+		{"optimize-size", OptimizerHint::Size},
+		{"optimize-speed", OptimizerHint::Speed},
+		{"no-inlining", OptimizerHint::NoInlining}
+	};
+
+	auto const& docTags = _function.annotation().docTags;
+	for (auto [it, end] = docTags.equal_range("solidity"); it != end; ++it)
+	{
+		vector<string> values;
+		boost::split(values, it->second.content, isWhiteSpace);
+		for (auto const& value: values | ranges::views::filter(not_fn(&string::empty)))
+		{
+			auto hint = hints.find(value);
+			if (hint == hints.end())
+				m_errorReporter.warning(
+					3271_error,
+					_function.documentation()->location(),
+					"Unexpected value for @solidity tag in function: " + value
+				);
+			else if (_function.annotation().optimizerHint && *_function.annotation().optimizerHint != hint->second)
+				m_errorReporter.docstringParsingError(
+					5912_error,
+					_function.documentation()->location(),
+					"Conflicting optimizer hints for function: " + value
+				);
+			else
+				_function.annotation().optimizerHint = hint->second;
+		}
+	}
+}
+
 void DocStringTagParser::parseDocStrings(
 	StructurallyDocumented const& _node,
 	StructurallyDocumentedAnnotation& _annotation,
@@ -68,6 +68,9 @@ private:
 		StructurallyDocumentedAnnotation& _annotation
 	);
 
+	/// Sets the optimizer hint of @a _function from the values of its ``@solidity`` tag.
+	void handleOptimizerHint(FunctionDefinition const& _function);
+
 	void parseDocStrings(
 		StructurallyDocumented const& _node,
 		StructurallyDocumentedAnnotation& _annotation,
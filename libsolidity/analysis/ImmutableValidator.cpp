@@ -47,8 +47,15 @@ void ImmutableValidator::analyze()
 			if (stateVar->value())
 				m_initializedStateVariables.emplace(stateVar);
 
-		if (contract->constructor())
-			visitCallableIfNew(*contract->constructor());
+		if (FunctionDefinition const* constructor = contract->constructor())
+		{
+			// A constructor whose body was skipped may initialize any immutable of its contract.
+			if (constructor->isImplemented() && constructor->body().skipped())
+				for (VariableDeclaration const* stateVar: contract->stateVariables())
+					if (stateVar->immutable())
+						m_initializedStateVariables.emplace(stateVar);
+			visitCallableIfNew(*constructor);
+		}
 	}
 
 	m_inCreationContext = false;
@@ -46,7 +46,7 @@ class ConstructorUsesAssembly;
  * programmers write cleaner code. For every warning generated here, it has to be possible to write
  * equivalent code that does not generate the warning.
  */
-class StaticAnalyzer: private ASTConstVisitor
+class StaticAnalyzer: public ASTConstVisitor
 {
 public:
 	/// @param _errorReporter provides the error logging functionality.
@@ -55,6 +55,7 @@ public:
 
 	/// Performs static analysis on the given source unit and all of its sub-nodes.
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
+	/// The analyzer can also be accepted on the source units directly, e.g. through an ASTFusedConstVisitor.
 	bool analyze(SourceUnit const& _sourceUnit);
 
 private:
@@ -144,6 +144,7 @@ bool ViewPureChecker::visit(FunctionDefinition const& _funDef)
 	solAssert(!m_currentFunction, "");
 	m_currentFunction = &_funDef;
 	m_bestMutabilityAndLocation = {StateMutability::Pure, _funDef.location()};
+	m_usesSkippedModifier = false;
 	return true;
 }
 
@@ -155,6 +156,7 @@ void ViewPureChecker::endVisit(FunctionDefinition const& _funDef)
 		_funDef.stateMutability() != StateMutability::Payable &&
 		_funDef.isImplemented() &&
 		!_funDef.body().statements().empty() &&
+		!m_usesSkippedModifier &&
 		!_funDef.isConstructor() &&
 		!_funDef.isFallback() &&
 		!_funDef.isReceive() &&
@@ -444,6 +446,9 @@ void ViewPureChecker::endVisit(ModifierInvocation const& _modifier)
 {
 	if (ModifierDefinition const* mod = dynamic_cast<decltype(mod)>(_modifier.name().annotation().referencedDeclaration))
 	{
+		// The mutability of a modifier whose body was skipped is unknown.
+		if (mod->isImplemented() && mod->body().skipped())
+			m_usesSkippedModifier = true;
 		MutabilityAndLocation const& mutAndLocation = modifierMutability(*mod);
 		reportMutability(mutAndLocation.mutability, _modifier.location(), mutAndLocation.location);
 	}
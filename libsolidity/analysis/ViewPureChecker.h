@@ -35,12 +35,15 @@ struct SourceLocation;
 namespace solidity::frontend
 {
 
-class ViewPureChecker: private ASTConstVisitor
+class ViewPureChecker: public ASTConstVisitor
 {
 public:
 	ViewPureChecker(std::vector<std::shared_ptr<ASTNode>> const& _ast, langutil::ErrorReporter& _errorReporter):
 		m_ast(_ast), m_errorReporter(_errorReporter) {}
 
+	/// Checks all source units passed to the constructor.
+	/// The checker can also be accepted on the source units directly, e.g. through an ASTFusedConstVisitor,
+	/// in which case the source units passed to the constructor are not used.
 	bool check();
 
 private:
@@ -82,6 +85,8 @@ private:
 	bool m_errors = false;
 	MutabilityAndLocation m_bestMutabilityAndLocation = MutabilityAndLocation{StateMutability::Payable, langutil::SourceLocation()};
 	FunctionDefinition const* m_currentFunction = nullptr;
+	/// Whether the current function uses a modifier whose body was skipped by the parser.
+	bool m_usesSkippedModifier = false;
 	std::map<ModifierDefinition const*, MutabilityAndLocation> m_inferredMutability;
 };
 
@@ -114,6 +114,10 @@ public:
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
 
+	/// Drops the annotation and everything else the analysis cached on this node,
+	/// so that the node can be analysed again.
+	virtual void clearAnalysis() const { m_annotation.reset(); }
+
 	///@{
 	///@name equality operators
 	/// Equality relies on the fact that nodes cannot be copied.
@@ -122,7 +126,10 @@ public:
 	///@}
 
 protected:
-	size_t const m_id = 0;
+	friend class Parser;
+
+	/// Only modified by the parser, which might shift the IDs of a source unit parsed on its own.
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -560,6 +567,8 @@ public:
 
 	ContractDefinitionAnnotation& annotation() const override;
 
+	void clearAnalysis() const override;
+
 	ContractKind contractKind() const { return m_contractKind; }
 
 	bool abstract() const { return m_abstract; }
@@ -1521,23 +1530,30 @@ public:
 		SourceLocation const& _location,
 		ASTPointer<ASTString> const& _docString,
 		bool _unchecked,
-		std::vector<ASTPointer<Statement>> _statements
+		std::vector<ASTPointer<Statement>> _statements,
+		bool _skipped = false
 	):
 		Statement(_id, _location, _docString),
 		m_statements(std::move(_statements)),
-		m_unchecked(_unchecked)
+		m_unchecked(_unchecked),
+		m_skipped(_skipped)
 	{}
 	void accept(ASTVisitor& _visitor) override;
 	void accept(ASTConstVisitor& _visitor) const override;
 
 	std::vector<ASTPointer<Statement>> const& statements() const { return m_statements; }
 	bool unchecked() const { return m_unchecked; }
+	/// @returns true if this is the body of a function or modifier whose statements were
+	/// skipped by the parser. Such a block has no statements and must not be analysed
+	/// further than its enclosing declaration or used for code generation.
+	bool skipped() const { return m_skipped; }
 
 	BlockAnnotation& annotation() const override;
 
 private:
 	std::vector<ASTPointer<Statement>> m_statements;
 	bool m_unchecked;
+	bool m_skipped;
 };
 
 /**
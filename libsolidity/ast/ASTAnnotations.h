@@ -49,6 +49,7 @@ class Type;
 class ArrayType;
 
 struct CallGraph;
+struct AttachedFunctionCandidates;
 
 struct ASTAnnotation
 {
@@ -97,6 +98,9 @@ struct SourceUnitAnnotation: ASTAnnotation
 	std::set<ExperimentalFeature> experimentalFeatures;
 	/// Using the new ABI coder. Set to `false` if using ABI coder v1.
 	util::SetOnce<bool> useABICoderV2;
+	/// Functions attached to types by ``using for`` directives in this source unit.
+	/// Computed on first use by Type::members.
+	std::shared_ptr<AttachedFunctionCandidates const> attachedFunctionCandidates;
 };
 
 struct ScopableAnnotation
@@ -168,6 +172,9 @@ struct ContractDefinitionAnnotation: TypeDeclarationAnnotation, StructurallyDocu
 	/// List of contracts whose bytecode is referenced by this contract, e.g. through "new".
 	/// The Value represents the ast node that referenced the contract.
 	std::map<ContractDefinition const*, ASTNode const*, ASTCompareByID<ContractDefinition>> contractDependencies;
+	/// Functions attached to types by ``using for`` directives in this contract and its source unit.
+	/// Computed on first use by Type::members.
+	std::shared_ptr<AttachedFunctionCandidates const> attachedFunctionCandidates;
 };
 
 struct CallableDeclarationAnnotation: DeclarationAnnotation
@@ -178,6 +185,10 @@ struct CallableDeclarationAnnotation: DeclarationAnnotation
 
 struct FunctionDefinitionAnnotation: CallableDeclarationAnnotation, StructurallyDocumentedAnnotation
 {
+	/// Hint for the optimizer given by the NatSpec tag ``@solidity optimize-size``,
+	/// ``@solidity optimize-speed`` or ``@solidity no-inlining``.
+	enum class OptimizerHint { Size, Speed, NoInlining };
+	std::optional<OptimizerHint> optimizerHint;
 };
 
 struct EventDefinitionAnnotation: CallableDeclarationAnnotation, StructurallyDocumentedAnnotation
@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Visitor that runs several independent visitors in a single traversal of the AST.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Forwards every visit and endVisit call to a list of visitors, so that analysis passes that do
+ * not depend on each other's results only need one walk over the AST.
+ *
+ * Each of the visitors receives exactly the calls it would receive when accepted on its own:
+ * If a visitor returns false from visit, it does not see the sub-nodes of that node, but still
+ * receives the endVisit call for it. The children are only visited if at least one of the
+ * visitors wants to see them.
+ *
+ * The visitors are called in list order for every node, so their side effects (e.g. errors) are
+ * interleaved. Callers that need the output of a sequential run have to give each visitor its own
+ * error reporter and merge the errors afterwards.
+ */
+class ASTFusedConstVisitor: public ASTConstVisitor
+{
+public:
+	explicit ASTFusedConstVisitor(std::vector<ASTConstVisitor*> const& _visitors);
+
+#define SOL_FUSED_VISIT(NodeType) \
+	bool visit(NodeType const& _node) override { return fusedVisit(_node); } \
+	void endVisit(NodeType const& _node) override { fusedEndVisit(_node); }
+
+	SOL_FUSED_VISIT(SourceUnit)
+	SOL_FUSED_VISIT(PragmaDirective)
+	SOL_FUSED_VISIT(ImportDirective)
+	SOL_FUSED_VISIT(ContractDefinition)
+	SOL_FUSED_VISIT(IdentifierPath)
+	SOL_FUSED_VISIT(InheritanceSpecifier)
+	SOL_FUSED_VISIT(StructDefinition)
+	SOL_FUSED_VISIT(UsingForDirective)
+	SOL_FUSED_VISIT(UserDefinedValueTypeDefinition)
+	SOL_FUSED_VISIT(EnumDefinition)
+	SOL_FUSED_VISIT(EnumValue)
+	SOL_FUSED_VISIT(ParameterList)
+	SOL_FUSED_VISIT(OverrideSpecifier)
+	SOL_FUSED_VISIT(FunctionDefinition)
+	SOL_FUSED_VISIT(VariableDeclaration)
+	SOL_FUSED_VISIT(ModifierDefinition)
+	SOL_FUSED_VISIT(ModifierInvocation)
+	SOL_FUSED_VISIT(EventDefinition)
+	SOL_FUSED_VISIT(ErrorDefinition)
+	SOL_FUSED_VISIT(ElementaryTypeName)
+	SOL_FUSED_VISIT(UserDefinedTypeName)
+	SOL_FUSED_VISIT(FunctionTypeName)
+	SOL_FUSED_VISIT(Mapping)
+	SOL_FUSED_VISIT(ArrayTypeName)
+	SOL_FUSED_VISIT(Block)
+	SOL_FUSED_VISIT(PlaceholderStatement)
+	SOL_FUSED_VISIT(IfStatement)
+	SOL_FUSED_VISIT(TryCatchClause)
+	SOL_FUSED_VISIT(TryStatement)
+	SOL_FUSED_VISIT(WhileStatement)
+	SOL_FUSED_VISIT(ForStatement)
+	SOL_FUSED_VISIT(Continue)
+	SOL_FUSED_VISIT(InlineAssembly)
+	SOL_FUSED_VISIT(Break)
+	SOL_FUSED_VISIT(Return)
+	SOL_FUSED_VISIT(Throw)
+	SOL_FUSED_VISIT(EmitStatement)
+	SOL_FUSED_VISIT(RevertStatement)
+	SOL_FUSED_VISIT(VariableDeclarationStatement)
+	SOL_FUSED_VISIT(ExpressionStatement)
+	SOL_FUSED_VISIT(Conditional)
+	SOL_FUSED_VISIT(Assignment)
+	SOL_FUSED_VISIT(TupleExpression)
+	SOL_FUSED_VISIT(UnaryOperation)
+	SOL_FUSED_VISIT(BinaryOperation)
+	SOL_FUSED_VISIT(FunctionCall)
+	SOL_FUSED_VISIT(FunctionCallOptions)
+	SOL_FUSED_VISIT(NewExpression)
+	SOL_FUSED_VISIT(MemberAccess)
+	SOL_FUSED_VISIT(IndexAccess)
+	SOL_FUSED_VISIT(IndexRangeAccess)
+	SOL_FUSED_VISIT(Identifier)
+	SOL_FUSED_VISIT(ElementaryTypeNameExpression)
+	SOL_FUSED_VISIT(Literal)
+	SOL_FUSED_VISIT(StructuredDocumentation)
+
+#undef SOL_FUSED_VISIT
+
+private:
+	struct Pass
+	{
+		ASTConstVisitor* visitor = nullptr;
+		/// The node whose sub-nodes the visitor does not want to see, if any.
+		ASTNode const* skippedNode = nullptr;
+	};
+
+	template <class NodeType>
+	bool fusedVisit(NodeType const& _node)
+	{
+		bool visitChildren = false;
+		for (Pass& pass: m_passes)
+			if (!pass.skippedNode)
+			{
+				if (pass.visitor->visit(_node))
+					visitChildren = true;
+				else
+					pass.skippedNode = &_node;
+			}
+		return visitChildren;
+	}
+
+	template <class NodeType>
+	void fusedEndVisit(NodeType const& _node)
+	{
+		for (Pass& pass: m_passes)
+			if (!pass.skippedNode || pass.skippedNode == &_node)
+			{
+				pass.skippedNode = nullptr;
+				pass.visitor->endVisit(_node);
+			}
+	}
+
+	std::vector<Pass> m_passes;
+};
+
+}
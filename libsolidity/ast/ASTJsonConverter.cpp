@@ -84,14 +84,10 @@ ASTJsonConverter::ASTJsonConverter(CompilerStack::State _stackState, map<string,
 void ASTJsonConverter::setJsonNode(
 	ASTNode const& _node,
 	string const& _nodeName,
-	initializer_list<pair<string, Json::Value>>&& _attributes
+	initializer_list<Attribute>&& _attributes
 )
 {
-	ASTJsonConverter::setJsonNode(
-		_node,
-		_nodeName,
-		std::vector<pair<string, Json::Value>>(std::move(_attributes))
-	);
+	ASTJsonConverter::setJsonNode(_node, _nodeName, attributeVector(std::move(_attributes)));
 }
 
 void ASTJsonConverter::setJsonNode(
@@ -159,19 +155,19 @@ void ASTJsonConverter::appendExpressionAttributes(
 	ExpressionAnnotation const& _annotation
 )
 {
-	std::vector<pair<string, Json::Value>> exprAttributes = {
+	std::vector<pair<string, Json::Value>> exprAttributes = attributeVector({
 		make_pair("typeDescriptions", typePointerToJson(_annotation.type)),
 		make_pair("argumentTypes", typePointerToJson(_annotation.arguments))
-	};
+	});
 
 	addIfSet(exprAttributes, "isLValue", _annotation.isLValue);
 	addIfSet(exprAttributes, "isPure", _annotation.isPure);
 	addIfSet(exprAttributes, "isConstant", _annotation.isConstant);
 
-	if (m_stackState > CompilerStack::State::ParsedAndImported)
+	if (m_stackState >= CompilerStack::State::TypesChecked)
 		exprAttributes.emplace_back("lValueRequested", _annotation.willBeWrittenTo);
 
-	_attributes += exprAttributes;
+	_attributes += std::move(exprAttributes);
 }
 
 Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifier const*, InlineAssemblyAnnotation::ExternalIdentifierInfo> _info) const
@@ -195,18 +191,36 @@ void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node, util::JsonF
 	_stream << util::jsonPrint(toJson(_node), _format);
 }
 
+vector<pair<string, Json::Value>> ASTJsonConverter::attributeVector(initializer_list<Attribute> _attributes)
+{
+	vector<pair<string, Json::Value>> result;
+	result.reserve(_attributes.size());
+	for (Attribute const& attribute: _attributes)
+		result.emplace_back(attribute.name, std::move(attribute.value));
+	return result;
+}
+
 Json::Value ASTJsonConverter::toJson(ASTNode const& _node)
 {
+	// Null members are removed from the whole tree once, at the end of the outermost call.
+	if (m_converting)
+	{
+		_node.accept(*this);
+		return std::move(m_currentValue);
+	}
+
+	m_converting = true;
+	ScopeGuard resetConverting{[&] { m_converting = false; }};
 	_node.accept(*this);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
 bool ASTJsonConverter::visit(SourceUnit const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
 		make_pair("nodes", toJson(_node.nodes()))
-	};
+	});
 
 	if (_node.annotation().exportedSymbols.set())
 	{
@@ -241,11 +255,11 @@ bool ASTJsonConverter::visit(PragmaDirective const& _node)
 
 bool ASTJsonConverter::visit(ImportDirective const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("file", _node.path()),
 		make_pair("sourceUnit", idOrNull(_node.annotation().sourceUnit)),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	addIfSet(attributes, "absolutePath", _node.annotation().absolutePath);
 
@@ -269,7 +283,7 @@ bool ASTJsonConverter::visit(ImportDirective const& _node)
 
 bool ASTJsonConverter::visit(ContractDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -280,7 +294,7 @@ bool ASTJsonConverter::visit(ContractDefinition const& _node)
 		make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
 		make_pair("nodes", toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
 
 	if (_node.annotation().unimplementedDeclarations.has_value())
@@ -312,9 +326,9 @@ bool ASTJsonConverter::visit(InheritanceSpecifier const& _node)
 
 bool ASTJsonConverter::visit(UsingForDirective const& _node)
 {
-	vector<pair<string, Json::Value>> attributes = {
+	vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("typeName", _node.typeName() ? toJson(*_node.typeName()) : Json::nullValue)
-	};
+	});
 	if (_node.usesBraces())
 	{
 		Json::Value functionList;
@@ -337,13 +351,13 @@ bool ASTJsonConverter::visit(UsingForDirective const& _node)
 
 bool ASTJsonConverter::visit(StructDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("visibility", Declaration::visibilityToString(_node.visibility())),
 		make_pair("members", toJson(_node.members())),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
 
@@ -354,11 +368,11 @@ bool ASTJsonConverter::visit(StructDefinition const& _node)
 
 bool ASTJsonConverter::visit(EnumDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("members", toJson(_node.members()))
-	};
+	});
 
 	addIfSet(attributes,"canonicalName", _node.annotation().canonicalName);
 
@@ -379,11 +393,11 @@ bool ASTJsonConverter::visit(EnumValue const& _node)
 bool ASTJsonConverter::visit(UserDefinedValueTypeDefinition const& _node)
 {
 	solAssert(_node.underlyingType(), "");
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("underlyingType", toJson(*_node.underlyingType()))
-	};
+	});
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
 
 	setJsonNode(_node, "UserDefinedValueTypeDefinition", std::move(attributes));
@@ -409,7 +423,7 @@ bool ASTJsonConverter::visit(OverrideSpecifier const& _node)
 
 bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -423,7 +437,7 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue),
 		make_pair("implemented", _node.isImplemented()),
 		make_pair("scope", idOrNull(_node.scope()))
-	};
+	});
 
 	optional<Visibility> visibility;
 	if (_node.isConstructor())
@@ -447,7 +461,7 @@ bool ASTJsonConverter::visit(FunctionDefinition const& _node)
 
 bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("typeName", toJson(_node.typeName())),
@@ -460,7 +474,7 @@ bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 		make_pair("value", _node.value() ? toJson(*_node.value()) : Json::nullValue),
 		make_pair("scope", idOrNull(_node.scope())),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
-	};
+	});
 	if (_node.isStateVariable() && _node.isPublic())
 		attributes.emplace_back("functionSelector", _node.externalIdentifierHex());
 	if (_node.isStateVariable() && _node.documentation())
@@ -475,7 +489,7 @@ bool ASTJsonConverter::visit(VariableDeclaration const& _node)
 
 bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
@@ -484,7 +498,7 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 		make_pair("virtual", _node.markedVirtual()),
 		make_pair("overrides", _node.overrides() ? toJson(*_node.overrides()) : Json::nullValue),
 		make_pair("body", _node.isImplemented() ? toJson(_node.body()) : Json::nullValue)
-	};
+	});
 	if (!_node.annotation().baseFunctions.empty())
 		attributes.emplace_back(make_pair("baseModifiers", getContainerIds(_node.annotation().baseFunctions, true)));
 	setJsonNode(_node, "ModifierDefinition", std::move(attributes));
@@ -493,10 +507,10 @@ bool ASTJsonConverter::visit(ModifierDefinition const& _node)
 
 bool ASTJsonConverter::visit(ModifierInvocation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes{
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("modifierName", toJson(_node.name())),
 		make_pair("arguments", _node.arguments() ? toJson(*_node.arguments()) : Json::nullValue)
-	};
+	});
 	if (Declaration const* declaration = _node.name().annotation().referencedDeclaration)
 	{
 		if (dynamic_cast<ModifierDefinition const*>(declaration))
@@ -511,13 +525,13 @@ bool ASTJsonConverter::visit(ModifierInvocation const& _node)
 bool ASTJsonConverter::visit(EventDefinition const& _node)
 {
 	m_inEvent = true;
-	std::vector<pair<string, Json::Value>> _attributes = {
+	std::vector<pair<string, Json::Value>> _attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
 		make_pair("parameters", toJson(_node.parameterList())),
 		make_pair("anonymous", _node.isAnonymous())
-	};
+	});
 	if (m_stackState >= CompilerStack::State::AnalysisPerformed)
 			_attributes.emplace_back(
 				make_pair(
@@ -531,12 +545,12 @@ bool ASTJsonConverter::visit(EventDefinition const& _node)
 
 bool ASTJsonConverter::visit(ErrorDefinition const& _node)
 {
-	std::vector<pair<string, Json::Value>> _attributes = {
+	std::vector<pair<string, Json::Value>> _attributes = attributeVector({
 		make_pair("name", _node.name()),
 		make_pair("nameLocation", sourceLocationToString(_node.nameLocation())),
 		make_pair("documentation", _node.documentation() ? toJson(*_node.documentation()) : Json::nullValue),
 		make_pair("parameters", toJson(_node.parameterList()))
-	};
+	});
 	if (m_stackState >= CompilerStack::State::AnalysisPerformed)
 		_attributes.emplace_back(make_pair("errorSelector", _node.functionType(true)->externalIdentifierHex()));
 
@@ -546,10 +560,10 @@ bool ASTJsonConverter::visit(ErrorDefinition const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeName const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("name", _node.typeName().toString()),
 		make_pair("typeDescriptions", typePointerToJson(_node.annotation().type, true))
-	};
+	});
 
 	if (_node.stateMutability())
 		attributes.emplace_back(make_pair("stateMutability", stateMutabilityToString(*_node.stateMutability())));
@@ -617,11 +631,11 @@ bool ASTJsonConverter::visit(InlineAssembly const& _node)
 	for (Json::Value& it: externalReferences | ranges::views::values)
 		externalReferencesJson.append(std::move(it));
 
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("AST", Json::Value(yul::AsmJsonConverter(sourceIndexFromLocation(_node.location()))(_node.operations()))),
 		make_pair("externalReferences", std::move(externalReferencesJson)),
 		make_pair("evmVersion", dynamic_cast<solidity::yul::EVMDialect const&>(_node.dialect()).evmVersion().name())
-	};
+	});
 
 	if (_node.flags())
 	{
@@ -771,11 +785,11 @@ bool ASTJsonConverter::visit(ExpressionStatement const& _node)
 
 bool ASTJsonConverter::visit(Conditional const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("condition", toJson(_node.condition())),
 		make_pair("trueExpression", toJson(_node.trueExpression())),
 		make_pair("falseExpression", toJson(_node.falseExpression()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Conditional", std::move(attributes));
 	return false;
@@ -783,11 +797,11 @@ bool ASTJsonConverter::visit(Conditional const& _node)
 
 bool ASTJsonConverter::visit(Assignment const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("operator", TokenTraits::toString(_node.assignmentOperator())),
 		make_pair("leftHandSide", toJson(_node.leftHandSide())),
 		make_pair("rightHandSide", toJson(_node.rightHandSide()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Assignment", std::move(attributes));
 	return false;
@@ -795,10 +809,10 @@ bool ASTJsonConverter::visit(Assignment const& _node)
 
 bool ASTJsonConverter::visit(TupleExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("isInlineArray", Json::Value(_node.isInlineArray())),
 		make_pair("components", toJson(_node.components())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "TupleExpression", std::move(attributes));
 	return false;
@@ -806,11 +820,11 @@ bool ASTJsonConverter::visit(TupleExpression const& _node)
 
 bool ASTJsonConverter::visit(UnaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("prefix", _node.isPrefixOperation()),
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
 		make_pair("subExpression", toJson(_node.subExpression()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "UnaryOperation", std::move(attributes));
 	return false;
@@ -818,12 +832,12 @@ bool ASTJsonConverter::visit(UnaryOperation const& _node)
 
 bool ASTJsonConverter::visit(BinaryOperation const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("operator", TokenTraits::toString(_node.getOperator())),
 		make_pair("leftExpression", toJson(_node.leftExpression())),
 		make_pair("rightExpression", toJson(_node.rightExpression())),
 		make_pair("commonType", typePointerToJson(_node.annotation().commonType)),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "BinaryOperation", std::move(attributes));
 	return false;
@@ -834,12 +848,12 @@ bool ASTJsonConverter::visit(FunctionCall const& _node)
 	Json::Value names(Json::arrayValue);
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("names", std::move(names)),
 		make_pair("arguments", toJson(_node.arguments())),
 		make_pair("tryCall", _node.annotation().tryCall)
-	};
+	});
 
 	if (_node.annotation().kind.set())
 	{
@@ -858,11 +872,11 @@ bool ASTJsonConverter::visit(FunctionCallOptions const& _node)
 	for (auto const& name: _node.names())
 		names.append(Json::Value(*name));
 
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("names", std::move(names)),
 		make_pair("options", toJson(_node.options())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 
 	setJsonNode(_node, "FunctionCallOptions", std::move(attributes));
@@ -871,9 +885,9 @@ bool ASTJsonConverter::visit(FunctionCallOptions const& _node)
 
 bool ASTJsonConverter::visit(NewExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("typeName", toJson(_node.typeName()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "NewExpression", std::move(attributes));
 	return false;
@@ -881,11 +895,11 @@ bool ASTJsonConverter::visit(NewExpression const& _node)
 
 bool ASTJsonConverter::visit(MemberAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("memberName", _node.memberName()),
 		make_pair("expression", toJson(_node.expression())),
 		make_pair("referencedDeclaration", idOrNull(_node.annotation().referencedDeclaration)),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "MemberAccess", std::move(attributes));
 	return false;
@@ -893,10 +907,10 @@ bool ASTJsonConverter::visit(MemberAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("baseExpression", toJson(_node.baseExpression())),
 		make_pair("indexExpression", toJsonOrNull(_node.indexExpression())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexAccess", std::move(attributes));
 	return false;
@@ -904,11 +918,11 @@ bool ASTJsonConverter::visit(IndexAccess const& _node)
 
 bool ASTJsonConverter::visit(IndexRangeAccess const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("baseExpression", toJson(_node.baseExpression())),
 		make_pair("startExpression", toJsonOrNull(_node.startExpression())),
 		make_pair("endExpression", toJsonOrNull(_node.endExpression())),
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "IndexRangeAccess", std::move(attributes));
 	return false;
@@ -931,9 +945,9 @@ bool ASTJsonConverter::visit(Identifier const& _node)
 
 bool ASTJsonConverter::visit(ElementaryTypeNameExpression const& _node)
 {
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("typeName", toJson(_node.type()))
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "ElementaryTypeNameExpression", std::move(attributes));
 	return false;
@@ -945,7 +959,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 	if (!util::validateUTF8(_node.value()))
 		value = Json::nullValue;
 	Token subdenomination = Token(_node.subDenomination());
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("kind", literalTokenKind(_node.token())),
 		make_pair("value", value),
 		make_pair("hexValue", util::toHex(util::asBytes(_node.value()))),
@@ -955,7 +969,7 @@ bool ASTJsonConverter::visit(Literal const& _node)
 			Json::nullValue :
 			Json::Value{TokenTraits::toString(subdenomination)}
 		)
-	};
+	});
 	appendExpressionAttributes(attributes, _node.annotation());
 	setJsonNode(_node, "Literal", std::move(attributes));
 	return false;
@@ -964,9 +978,9 @@ bool ASTJsonConverter::visit(Literal const& _node)
 bool ASTJsonConverter::visit(StructuredDocumentation const& _node)
 {
 	Json::Value text{*_node.text()};
-	std::vector<pair<string, Json::Value>> attributes = {
+	std::vector<pair<string, Json::Value>> attributes = attributeVector({
 		make_pair("text", text)
-	};
+	});
 	setJsonNode(_node, "StructuredDocumentation", std::move(attributes));
 	return false;
 }
@@ -131,10 +131,25 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Name and value of a node attribute. The value is mutable, so that it can be moved out of
+	/// an initializer list instead of copying the JSON of all child nodes.
+	struct Attribute
+	{
+		template <class Name, class Value>
+		Attribute(std::pair<Name, Value>&& _attribute):
+			name(std::move(_attribute.first)),
+			value(std::move(_attribute.second))
+		{}
+
+		std::string name;
+		mutable Json::Value value;
+	};
+	static std::vector<std::pair<std::string, Json::Value>> attributeVector(std::initializer_list<Attribute> _attributes);
+
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
-		std::initializer_list<std::pair<std::string, Json::Value>>&& _attributes
+		std::initializer_list<Attribute>&& _attributes
 	);
 	void setJsonNode(
 		ASTNode const& _node,
@@ -198,6 +213,8 @@ private:
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
 	Json::Value m_currentValue;
+	/// True while a node is converted, so that nested conversions can skip removing null members.
+	bool m_converting = false;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
 
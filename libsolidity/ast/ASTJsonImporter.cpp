@@ -36,6 +36,8 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <unordered_map>
+
 using namespace std;
 
 namespace solidity::frontend
@@ -58,7 +60,7 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(map<string, Json::Value> const& _sourceList)
 {
 	for (auto const& src: _sourceList)
-		m_sourceNames.emplace_back(make_shared<string const>(src.first));
+		m_sourceNames.emplace_back(langutil::internSourceName(src.first));
 	for (auto const& srcPair: _sourceList)
 	{
 		astAssert(!srcPair.second.isNull());
@@ -102,6 +104,12 @@ SourceLocation ASTJsonImporter::createNameSourceLocation(Json::Value const& _nod
 	return solidity::langutil::parseSourceLocation(_node["nameLocation"].asString(), m_sourceNames);
 }
 
+template<auto _create, auto... _arguments>
+ASTPointer<ASTNode> ASTJsonImporter::createAnyNode(Json::Value const& _node)
+{
+	return (this->*_create)(_node, _arguments...);
+}
+
 template<class T>
 ASTPointer<T> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _node)
 {
@@ -114,121 +122,69 @@ ASTPointer<T> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _node)
 ASTPointer<ASTNode> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _json)
 {
 	astAssert(_json["nodeType"].isString() && _json.isMember("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
+	static unordered_map<string, ASTPointer<ASTNode> (ASTJsonImporter::*)(Json::Value const&)> const nodeCreators{
+		{"PragmaDirective", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createPragmaDirective>},
+		{"ImportDirective", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createImportDirective>},
+		{"ContractDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createContractDefinition>},
+		{"IdentifierPath", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createIdentifierPath>},
+		{"InheritanceSpecifier", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createInheritanceSpecifier>},
+		{"UsingForDirective", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createUsingForDirective>},
+		{"StructDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createStructDefinition>},
+		{"EnumDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createEnumDefinition>},
+		{"EnumValue", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createEnumValue>},
+		{"UserDefinedValueTypeDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createUserDefinedValueTypeDefinition>},
+		{"ParameterList", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createParameterList>},
+		{"OverrideSpecifier", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createOverrideSpecifier>},
+		{"FunctionDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createFunctionDefinition>},
+		{"VariableDeclaration", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createVariableDeclaration>},
+		{"ModifierDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createModifierDefinition>},
+		{"ModifierInvocation", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createModifierInvocation>},
+		{"EventDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createEventDefinition>},
+		{"ErrorDefinition", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createErrorDefinition>},
+		{"ElementaryTypeName", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createElementaryTypeName>},
+		{"UserDefinedTypeName", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createUserDefinedTypeName>},
+		{"FunctionTypeName", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createFunctionTypeName>},
+		{"Mapping", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createMapping>},
+		{"ArrayTypeName", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createArrayTypeName>},
+		{"InlineAssembly", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createInlineAssembly>},
+		{"Block", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createBlock, false>},
+		{"UncheckedBlock", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createBlock, true>},
+		{"PlaceholderStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createPlaceholderStatement>},
+		{"IfStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createIfStatement>},
+		{"TryCatchClause", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createTryCatchClause>},
+		{"TryStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createTryStatement>},
+		{"WhileStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createWhileStatement, false>},
+		{"DoWhileStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createWhileStatement, true>},
+		{"ForStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createForStatement>},
+		{"Continue", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createContinue>},
+		{"Break", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createBreak>},
+		{"Return", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createReturn>},
+		{"EmitStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createEmitStatement>},
+		{"RevertStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createRevertStatement>},
+		{"Throw", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createThrow>},
+		{"VariableDeclarationStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createVariableDeclarationStatement>},
+		{"ExpressionStatement", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createExpressionStatement>},
+		{"Conditional", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createConditional>},
+		{"Assignment", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createAssignment>},
+		{"TupleExpression", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createTupleExpression>},
+		{"UnaryOperation", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createUnaryOperation>},
+		{"BinaryOperation", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createBinaryOperation>},
+		{"FunctionCall", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createFunctionCall>},
+		{"FunctionCallOptions", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createFunctionCallOptions>},
+		{"NewExpression", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createNewExpression>},
+		{"MemberAccess", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createMemberAccess>},
+		{"IndexAccess", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createIndexAccess>},
+		{"IndexRangeAccess", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createIndexRangeAccess>},
+		{"Identifier", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createIdentifier>},
+		{"ElementaryTypeNameExpression", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createElementaryTypeNameExpression>},
+		{"Literal", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createLiteral>},
+		{"StructuredDocumentation", &ASTJsonImporter::createAnyNode<&ASTJsonImporter::createDocumentation>}
+	};
+
 	string nodeType = _json["nodeType"].asString();
-	if (nodeType == "PragmaDirective")
-		return createPragmaDirective(_json);
-	if (nodeType == "ImportDirective")
-		return createImportDirective(_json);
-	if (nodeType == "ContractDefinition")
-		return createContractDefinition(_json);
-	if (nodeType == "IdentifierPath")
-		return createIdentifierPath(_json);
-	if (nodeType == "InheritanceSpecifier")
-		return createInheritanceSpecifier(_json);
-	if (nodeType == "UsingForDirective")
-		return createUsingForDirective(_json);
-	if (nodeType == "StructDefinition")
-		return createStructDefinition(_json);
-	if (nodeType == "EnumDefinition")
-		return createEnumDefinition(_json);
-	if (nodeType == "EnumValue")
-		return createEnumValue(_json);
-	if (nodeType == "UserDefinedValueTypeDefinition")
-		return createUserDefinedValueTypeDefinition(_json);
-	if (nodeType == "ParameterList")
-		return createParameterList(_json);
-	if (nodeType == "OverrideSpecifier")
-		return createOverrideSpecifier(_json);
-	if (nodeType == "FunctionDefinition")
-		return createFunctionDefinition(_json);
-	if (nodeType == "VariableDeclaration")
-		return createVariableDeclaration(_json);
-	if (nodeType == "ModifierDefinition")
-		return createModifierDefinition(_json);
-	if (nodeType == "ModifierInvocation")
-		return createModifierInvocation(_json);
-	if (nodeType == "EventDefinition")
-		return createEventDefinition(_json);
-	if (nodeType == "ErrorDefinition")
-		return createErrorDefinition(_json);
-	if (nodeType == "ElementaryTypeName")
-		return createElementaryTypeName(_json);
-	if (nodeType == "UserDefinedTypeName")
-		return createUserDefinedTypeName(_json);
-	if (nodeType == "FunctionTypeName")
-		return createFunctionTypeName(_json);
-	if (nodeType == "Mapping")
-		return createMapping(_json);
-	if (nodeType == "ArrayTypeName")
-		return createArrayTypeName(_json);
-	if (nodeType == "InlineAssembly")
-		return createInlineAssembly(_json);
-	if (nodeType == "Block")
-		return createBlock(_json, false);
-	if (nodeType == "UncheckedBlock")
-		return createBlock(_json, true);
-	if (nodeType == "PlaceholderStatement")
-		return createPlaceholderStatement(_json);
-	if (nodeType == "IfStatement")
-		return createIfStatement(_json);
-	if (nodeType == "TryCatchClause")
-		return createTryCatchClause(_json);
-	if (nodeType == "TryStatement")
-		return createTryStatement(_json);
-	if (nodeType == "WhileStatement")
-		return createWhileStatement(_json, false);
-	if (nodeType == "DoWhileStatement")
-		return createWhileStatement(_json, true);
-	if (nodeType == "ForStatement")
-		return createForStatement(_json);
-	if (nodeType == "Continue")
-		return createContinue(_json);
-	if (nodeType == "Break")
-		return createBreak(_json);
-	if (nodeType == "Return")
-		return createReturn(_json);
-	if (nodeType == "EmitStatement")
-		return createEmitStatement(_json);
-	if (nodeType == "RevertStatement")
-		return createRevertStatement(_json);
-	if (nodeType == "Throw")
-		return createThrow(_json);
-	if (nodeType == "VariableDeclarationStatement")
-		return createVariableDeclarationStatement(_json);
-	if (nodeType == "ExpressionStatement")
-		return createExpressionStatement(_json);
-	if (nodeType == "Conditional")
-		return createConditional(_json);
-	if (nodeType == "Assignment")
-		return createAssignment(_json);
-	if (nodeType == "TupleExpression")
-		return createTupleExpression(_json);
-	if (nodeType == "UnaryOperation")
-		return createUnaryOperation(_json);
-	if (nodeType == "BinaryOperation")
-		return createBinaryOperation(_json);
-	if (nodeType == "FunctionCall")
-		return createFunctionCall(_json);
-	if (nodeType == "FunctionCallOptions")
-		return createFunctionCallOptions(_json);
-	if (nodeType == "NewExpression")
-		return createNewExpression(_json);
-	if (nodeType == "MemberAccess")
-		return createMemberAccess(_json);
-	if (nodeType == "IndexAccess")
-		return createIndexAccess(_json);
-	if (nodeType == "IndexRangeAccess")
-		return createIndexRangeAccess(_json);
-	if (nodeType == "Identifier")
-		return createIdentifier(_json);
-	if (nodeType == "ElementaryTypeNameExpression")
-		return createElementaryTypeNameExpression(_json);
-	if (nodeType == "Literal")
-		return createLiteral(_json);
-	if (nodeType == "StructuredDocumentation")
-		return createDocumentation(_json);
-	else
-		astAssert(false, "Unknown type of ASTNode: " + nodeType);
+	auto creator = nodeCreators.find(nodeType);
+	astAssert(creator != nodeCreators.end(), "Unknown type of ASTNode: " + nodeType);
+	return (this->*creator->second)(_json);
 }
 
 // ============ functions to instantiate the AST-Nodes from Json-Nodes ==============
@@ -983,10 +939,10 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json::V
 
 // ===== helper functions ==========
 
-Json::Value ASTJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& ASTJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
@@ -1005,14 +961,14 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json::Value const& _json,
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isString(), "field " + _name + " must be of type string.");
 	return make_shared<ASTString>(_node[_name].asString());
 }
 
 bool ASTJsonImporter::memberAsBool(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isBool(), "field " + _name + " must be of type boolean.");
 	return _node[_name].asBool();
 }
@@ -1056,7 +1012,7 @@ Token ASTJsonImporter::literalTokenKind(Json::Value const& _node)
 
 Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 {
-	Json::Value visibility = member(_node, "visibility");
+	Json::Value const& visibility = member(_node, "visibility");
 	astAssert(visibility.isString(), "'visibility' expected to be a string.");
 
 	string const visibilityStr = visibility.asString();
@@ -1077,7 +1033,7 @@ Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 
 VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node)
 {
-	Json::Value storageLoc = member(_node, "storageLocation");
+	Json::Value const& storageLoc = member(_node, "storageLocation");
 	astAssert(storageLoc.isString(), "'storageLocation' expected to be a string.");
 
 	string const storageLocStr = storageLoc.asString();
@@ -1096,7 +1052,7 @@ VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node
 
 Literal::SubDenomination ASTJsonImporter::subdenomination(Json::Value const& _node)
 {
-	Json::Value subDen = member(_node, "subdenomination");
+	Json::Value const& subDen = member(_node, "subdenomination");
 
 	if (subDen.isNull())
 		return Literal::SubDenomination::None;
@@ -66,6 +66,9 @@ private:
 	/// as indicated by the nodeType field of the json
 	template<class T>
 	ASTPointer<T> convertJsonToASTNode(Json::Value const& _node);
+	/// Calls @a _create with @a _node and @a _arguments, used to look up the creation function by node type.
+	template<auto _create, auto... _arguments>
+	ASTPointer<ASTNode> createAnyNode(Json::Value const& _node);
 
 	langutil::SourceLocation createNameSourceLocation(Json::Value const& _node);
 
@@ -129,8 +132,8 @@ private:
 	///@}
 
 	// =============== general helper functions ===================
-	/// @returns the member of a given JSON object, throws if member does not exist
-	Json::Value member(Json::Value const& _node, std::string const& _name);
+	/// @returns the member of a given JSON object, or a null value if the member does not exist
+	Json::Value const& member(Json::Value const& _node, std::string const& _name);
 	/// @returns the appropriate TokenObject used in parsed Strings (pragma directive or operator)
 	Token scanSingleToken(Json::Value const& _node);
 	template<class T>
@@ -154,7 +157,7 @@ private:
 
 	// =========== member variables ===============
 	/// list of source names, order by source index
-	std::vector<std::shared_ptr<std::string const>> m_sourceNames;
+	std::vector<std::string const*> m_sourceNames;
 	/// filepath to AST
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	/// IDs already used by the nodes
@@ -22,6 +22,9 @@
 
 #include <libsolutil/Algorithms.h>
 
+#include <algorithm>
+#include <numeric>
+
 namespace solidity::frontend
 {
 
@@ -47,6 +50,75 @@ ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sour
 	return innermostMatch;
 }
 
+ASTLocationIndex::ASTLocationIndex(SourceUnit const& _sourceUnit)
+{
+	// Collect the nodes in the order they are visited, remembering the enclosing node of each.
+	// Nodes without a location are skipped together with their children, just as
+	// locateInnermostASTNode never descends into them.
+	std::vector<Entry> visited;
+	std::vector<size_t> enclosing;
+	auto collector = SimpleASTVisitor(
+		[&](ASTNode const& _node) -> bool
+		{
+			if (!_node.location().hasText())
+				return false;
+			visited.push_back({
+				_node.location().start,
+				_node.location().end,
+				&_node,
+				enclosing.empty() ? noParent : enclosing.back()
+			});
+			enclosing.push_back(visited.size() - 1);
+			return true;
+		},
+		[&](ASTNode const& _node)
+		{
+			if (!enclosing.empty() && visited[enclosing.back()].node == &_node)
+				enclosing.pop_back();
+		}
+	);
+	_sourceUnit.accept(collector);
+
+	// Nodes with the same start are ordered from the outermost to the innermost one.
+	std::vector<size_t> order(visited.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t _a, size_t _b) {
+		if (visited[_a].start != visited[_b].start)
+			return visited[_a].start < visited[_b].start;
+		return visited[_a].end > visited[_b].end;
+	});
+	std::vector<size_t> position(visited.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		position[order[i]] = i;
+
+	m_entries.reserve(visited.size());
+	for (size_t index: order)
+	{
+		Entry entry = visited[index];
+		if (entry.parent != noParent)
+			entry.parent = position[entry.parent];
+		m_entries.push_back(entry);
+	}
+}
+
+ASTNode const* ASTLocationIndex::innermostNode(int _offsetInFile) const
+{
+	// The last node that starts at or before the offset is either the innermost node
+	// at the offset or nested inside a sibling of it, so the result is one of its ancestors.
+	auto it = std::upper_bound(
+		m_entries.begin(),
+		m_entries.end(),
+		_offsetInFile,
+		[](int _offset, Entry const& _entry) { return _offset < _entry.start; }
+	);
+	if (it == m_entries.begin())
+		return nullptr;
+	for (size_t index = static_cast<size_t>(it - m_entries.begin()) - 1; index != noParent; index = m_entries[index].parent)
+		if (m_entries[index].node->location().containsOffset(_offsetInFile))
+			return m_entries[index].node;
+	return nullptr;
+}
+
 bool isConstantVariableRecursive(VariableDeclaration const& _varDecl)
 {
 	solAssert(_varDecl.isConstant(), "Constant variable expected");
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 namespace solidity::frontend
 {
 
@@ -38,4 +41,33 @@ bool isConstantVariableRecursive(VariableDeclaration const& _varDecl);
 /// Returns the innermost AST node that covers the given location or nullptr if not found.
 ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sourceUnit);
 
+/**
+ * The locations of all nodes of a source unit, sorted by their start, so that the innermost
+ * node at an offset can be found without visiting the whole AST.
+ * A query takes O(log n + d) time, where d is the nesting depth of the result.
+ * Like locateInnermostASTNode, it relies on the location of a node covering the locations
+ * of its children. The index refers to the nodes, so it must not outlive the AST.
+ */
+class ASTLocationIndex
+{
+public:
+	explicit ASTLocationIndex(SourceUnit const& _sourceUnit);
+
+	/// @returns the innermost AST node that covers the given offset or nullptr if not found.
+	ASTNode const* innermostNode(int _offsetInFile) const;
+
+private:
+	struct Entry
+	{
+		int start;
+		int end;
+		ASTNode const* node;
+		/// Index of the entry of the closest enclosing node or `noParent`.
+		size_t parent;
+	};
+	static size_t constexpr noParent = static_cast<size_t>(-1);
+
+	std::vector<Entry> m_entries;
+};
+
 }
@@ -29,6 +29,8 @@ using namespace solidity::util;
 BoolType const TypeProvider::m_boolean{};
 InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
 
+recursive_mutex TypeProvider::m_mutex;
+
 /// The string and bytes unique_ptrs are initialized when they are first used because
 /// they rely on `byte` being available which we cannot guarantee in the static init context.
 unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
@@ -174,8 +176,19 @@ inline void clearCaches(Container& container)
 		clearCache(e);
 }
 
+size_t TypeProvider::size()
+{
+	lock_guard<recursive_mutex> lock(m_mutex);
+	return
+		instance().m_generalTypes.size() +
+		instance().m_stringLiteralTypes.size() +
+		instance().m_ufixedMxN.size() +
+		instance().m_fixedMxN.size();
+}
+
 void TypeProvider::reset()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	clearCache(m_boolean);
 	clearCache(m_inaccessibleDynamic);
 	clearCache(m_bytesStorage);
@@ -192,6 +205,20 @@ void TypeProvider::reset()
 	clearCaches(instance().m_magics);
 
 	instance().m_generalTypes.clear();
+	instance().m_withLocation.clear();
+	instance().m_tuples.clear();
+	instance().m_rationalNumbers.clear();
+	instance().m_byteArrays.clear();
+	instance().m_dynamicArrays.clear();
+	instance().m_staticArrays.clear();
+	instance().m_arraySlices.clear();
+	instance().m_contracts.clear();
+	instance().m_enums.clear();
+	instance().m_typeTypes.clear();
+	instance().m_structs.clear();
+	instance().m_metaTypes.clear();
+	instance().m_mappings.clear();
+	instance().m_userDefinedValueTypes.clear();
 	instance().m_stringLiteralTypes.clear();
 	instance().m_ufixedMxN.clear();
 	instance().m_fixedMxN.clear();
@@ -200,10 +227,21 @@ void TypeProvider::reset()
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
 	return static_cast<T const*>(instance().m_generalTypes.back().get());
 }
 
+template <typename T, typename Key, typename... Args>
+inline T const* TypeProvider::createAndGetCached(map<Key, T const*>& _cache, Key _key, Args&& ... _args)
+{
+	lock_guard<recursive_mutex> lock(m_mutex);
+	auto [it, inserted] = _cache.try_emplace(std::move(_key), nullptr);
+	if (inserted)
+		it->second = createAndGet<T>(std::forward<Args>(_args)...);
+	return it->second;
+}
+
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
 {
 	solAssert(
@@ -306,6 +344,7 @@ Type const* TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	if (!m_bytesStorage)
 		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
 	return m_bytesStorage.get();
@@ -313,6 +352,7 @@ ArrayType const* TypeProvider::bytesStorage()
 
 ArrayType const* TypeProvider::bytesMemory()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	if (!m_bytesMemory)
 		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
 	return m_bytesMemory.get();
@@ -320,6 +360,7 @@ ArrayType const* TypeProvider::bytesMemory()
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	if (!m_bytesCalldata)
 		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
 	return m_bytesCalldata.get();
@@ -327,6 +368,7 @@ ArrayType const* TypeProvider::bytesCalldata()
 
 ArrayType const* TypeProvider::stringStorage()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	if (!m_stringStorage)
 		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
 	return m_stringStorage.get();
@@ -334,6 +376,7 @@ ArrayType const* TypeProvider::stringStorage()
 
 ArrayType const* TypeProvider::stringMemory()
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	if (!m_stringMemory)
 		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
 	return m_stringMemory.get();
@@ -378,15 +421,18 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
-	else
-		return instance().m_stringLiteralTypes.emplace(literal, make_unique<StringLiteralType>(literal)).first->second.get();
+	auto type = make_unique<StringLiteralType>(literal);
+	string_view const value = type->value();
+	return instance().m_stringLiteralTypes.emplace(value, std::move(type)).first->second.get();
 }
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<recursive_mutex> lock(m_mutex);
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -404,7 +450,7 @@ TupleType const* TypeProvider::tuple(vector<Type const*> members)
 	if (members.empty())
 		return &m_emptyTuple;
 
-	return createAndGet<TupleType>(move(members));
+	return createAndGetCached<TupleType>(instance().m_tuples, members, members);
 }
 
 ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, DataLocation _location, bool _isPointer)
@@ -412,8 +458,14 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	lock_guard<recursive_mutex> lock(m_mutex);
+	auto [it, inserted] = instance().m_withLocation.try_emplace(make_tuple(_type, _location, _isPointer), nullptr);
+	if (inserted)
+	{
+		instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
+		it->second = static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	}
+	return it->second;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -485,7 +537,12 @@ FunctionType const* TypeProvider::function(
 
 RationalNumberType const* TypeProvider::rationalNumber(rational const& _value, Type const* _compatibleBytesType)
 {
-	return createAndGet<RationalNumberType>(_value, _compatibleBytesType);
+	return createAndGetCached<RationalNumberType>(
+		instance().m_rationalNumbers,
+		make_pair(_value, _compatibleBytesType),
+		_value,
+		_compatibleBytesType
+	);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
@@ -504,32 +561,38 @@ ArrayType const* TypeProvider::array(DataLocation _location, bool _isString)
 		if (_location == DataLocation::Memory)
 			return bytesMemory();
 	}
-	return createAndGet<ArrayType>(_location, _isString);
+	return createAndGetCached<ArrayType>(instance().m_byteArrays, make_pair(_location, _isString), _location, _isString);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType)
 {
-	return createAndGet<ArrayType>(_location, _baseType);
+	return createAndGetCached<ArrayType>(instance().m_dynamicArrays, make_pair(_location, _baseType), _location, _baseType);
 }
 
 ArrayType const* TypeProvider::array(DataLocation _location, Type const* _baseType, u256 const& _length)
 {
-	return createAndGet<ArrayType>(_location, _baseType, _length);
+	return createAndGetCached<ArrayType>(
+		instance().m_staticArrays,
+		make_tuple(_location, _baseType, _length),
+		_location,
+		_baseType,
+		_length
+	);
 }
 
 ArraySliceType const* TypeProvider::arraySlice(ArrayType const& _arrayType)
 {
-	return createAndGet<ArraySliceType>(_arrayType);
+	return createAndGetCached<ArraySliceType>(instance().m_arraySlices, &_arrayType, _arrayType);
 }
 
 ContractType const* TypeProvider::contract(ContractDefinition const& _contractDef, bool _isSuper)
 {
-	return createAndGet<ContractType>(_contractDef, _isSuper);
+	return createAndGetCached<ContractType>(instance().m_contracts, make_pair(&_contractDef, _isSuper), _contractDef, _isSuper);
 }
 
 EnumType const* TypeProvider::enumType(EnumDefinition const& _enumDef)
 {
-	return createAndGet<EnumType>(_enumDef);
+	return createAndGetCached<EnumType>(instance().m_enums, &_enumDef, _enumDef);
 }
 
 ModuleType const* TypeProvider::module(SourceUnit const& _source)
@@ -539,12 +602,12 @@ ModuleType const* TypeProvider::module(SourceUnit const& _source)
 
 TypeType const* TypeProvider::typeType(Type const* _actualType)
 {
-	return createAndGet<TypeType>(_actualType);
+	return createAndGetCached<TypeType>(instance().m_typeTypes, _actualType, _actualType);
 }
 
 StructType const* TypeProvider::structType(StructDefinition const& _struct, DataLocation _location)
 {
-	return createAndGet<StructType>(_struct, _location);
+	return createAndGetCached<StructType>(instance().m_structs, make_pair(&_struct, _location), _struct, _location);
 }
 
 ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
@@ -568,15 +631,15 @@ MagicType const* TypeProvider::meta(Type const* _type)
 		),
 		"Only enum, contracts or integer types supported for now."
 	);
-	return createAndGet<MagicType>(_type);
+	return createAndGetCached<MagicType>(instance().m_metaTypes, _type, _type);
 }
 
 MappingType const* TypeProvider::mapping(Type const* _keyType, Type const* _valueType)
 {
-	return createAndGet<MappingType>(_keyType, _valueType);
+	return createAndGetCached<MappingType>(instance().m_mappings, make_pair(_keyType, _valueType), _keyType, _valueType);
 }
 
 UserDefinedValueType const* TypeProvider::userDefinedValueType(UserDefinedValueTypeDefinition const& _definition)
 {
-	return createAndGet<UserDefinedValueType>(_definition);
+	return createAndGetCached<UserDefinedValueType>(instance().m_userDefinedValueTypes, &_definition, _definition);
 }
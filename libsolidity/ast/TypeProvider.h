@@ -23,8 +23,12 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string_view>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -37,6 +41,9 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Types can be requested from multiple threads at the same time. Note that this does not extend
+ * to the caches inside the types (e.g. their members), which are filled on first use.
  */
 class TypeProvider
 {
@@ -52,6 +59,10 @@ public:
 	/// This invalidates all dangling pointers to types provided by this TypeProvider.
 	static void reset();
 
+	/// @returns the number of types created since the last reset, apart from the fixed set of
+	/// elementary types that always exists.
+	static size_t size();
+
 	/// @name Factory functions
 	/// Factory functions that convert an AST @ref TypeName to a Type.
 	static Type const* fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability = {});
@@ -209,6 +220,14 @@ private:
 
 	template <typename T, typename... Args>
 	static inline T const* createAndGet(Args&& ... _args);
+	/// Same as createAndGet, but only creates one instance per @a _key and returns it from
+	/// @a _cache afterwards. Only usable for types that are fully determined by @a _key.
+	template <typename T, typename Key, typename... Args>
+	static inline T const* createAndGetCached(std::map<Key, T const*>& _cache, Key _key, Args&& ... _args);
+
+	/// Guards the creation of types. Recursive, because the constructors of some types request
+	/// further types.
+	static std::recursive_mutex m_mutex;
 
 	static BoolType const m_boolean;
 	static InaccessibleDynamicType const m_inaccessibleDynamic;
@@ -230,8 +249,25 @@ private:
 
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_ufixedMxN{};
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
-	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
+	/// String literal types by their value, the keys refer to the value stored in the type.
+	std::map<std::string_view, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+
+	/// Instances in m_generalTypes by the arguments they were created from.
+	std::map<std::tuple<ReferenceType const*, DataLocation, bool>, ReferenceType const*> m_withLocation{};
+	std::map<std::vector<Type const*>, TupleType const*> m_tuples{};
+	std::map<std::pair<rational, Type const*>, RationalNumberType const*> m_rationalNumbers{};
+	std::map<std::pair<DataLocation, bool>, ArrayType const*> m_byteArrays{};
+	std::map<std::pair<DataLocation, Type const*>, ArrayType const*> m_dynamicArrays{};
+	std::map<std::tuple<DataLocation, Type const*, u256>, ArrayType const*> m_staticArrays{};
+	std::map<ArrayType const*, ArraySliceType const*> m_arraySlices{};
+	std::map<std::pair<ContractDefinition const*, bool>, ContractType const*> m_contracts{};
+	std::map<EnumDefinition const*, EnumType const*> m_enums{};
+	std::map<Type const*, TypeType const*> m_typeTypes{};
+	std::map<std::pair<StructDefinition const*, DataLocation>, StructType const*> m_structs{};
+	std::map<Type const*, MagicType const*> m_metaTypes{};
+	std::map<std::pair<Type const*, Type const*>, MappingType const*> m_mappings{};
+	std::map<UserDefinedValueTypeDefinition const*, UserDefinedValueType const*> m_userDefinedValueTypes{};
 };
 
 }
@@ -74,7 +74,11 @@ BoolResult fitsIntegerType(bigint const& _value, IntegerType const& _type)
 	if (_value < 0 && !_type.isSigned())
 		return BoolResult::err("Cannot implicitly convert signed literal to unsigned type.");
 
-	if (_type.minValue() > _value || _value > _type.maxValue())
+	// Compare the number of value bits instead of materialising the bounds of the type,
+	// this is called for every literal that is converted implicitly.
+	bigint magnitude = _value < 0 ? bigint(-_value - 1) : _value;
+	unsigned valueBits = magnitude == 0 ? 0 : boost::multiprecision::msb(magnitude) + 1;
+	if (valueBits > _type.numBits() - (_type.isSigned() ? 1 : 0))
 		return BoolResult::err("Literal is too large to fit in " + _type.toString(false) + ".");
 
 	return true;
@@ -128,6 +132,7 @@ void Type::clearCache() const
 	m_members.clear();
 	m_stackItems.reset();
 	m_stackSize.reset();
+	m_identifier.reset();
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -262,15 +267,19 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::identifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(richIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_identifier = move(ret);
+	}
+	return *m_identifier;
 }
 
 Type const* Type::commonType(Type const* _a, Type const* _b)
@@ -330,37 +339,98 @@ Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) c
 }
 
 MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _scope)
+{
+	// Normalise data location of type.
+	DataLocation typeLocation = DataLocation::Storage;
+	if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
+		typeLocation = refType->location();
+	Type const* normalisedType = TypeProvider::withLocationIfReference(typeLocation, &_type, true);
+
+	MemberList::MemberMap members;
+
+	set<pair<string, Declaration const*>> seenFunctions;
+	// Many functions are bound to the same type, e.g. all functions of a library of
+	// arithmetic operations, so whether the type converts to it is only checked once.
+	map<Type const*, bool> directiveApplies;
+	map<Type const*, bool> convertible;
+	auto addCandidates = [&](vector<AttachedFunctionCandidates::Candidate> const& _candidates, bool _onlyGlobal)
+	{
+		for (auto const& candidate: _candidates)
+		{
+			if (_onlyGlobal && !(candidate.directive->global() && candidate.directiveType))
+				continue;
+
+			// Convert both types to pointers for comparison to see if the `using for`
+			// directive applies.
+			if (candidate.directiveType)
+			{
+				auto [it, inserted] = directiveApplies.try_emplace(candidate.directiveType, false);
+				if (inserted)
+					it->second =
+						*normalisedType ==
+						*TypeProvider::withLocationIfReference(typeLocation, candidate.directiveType, true);
+				if (!it->second)
+					continue;
+			}
+
+			Type const* selfType = candidate.boundFunction->selfType();
+			auto [it, inserted] = convertible.try_emplace(selfType, false);
+			if (inserted)
+				it->second = _type.isImplicitlyConvertibleTo(*selfType);
+			if (it->second && seenFunctions.insert(make_pair(candidate.name, candidate.function)).second)
+				members.emplace_back(candidate.function, candidate.boundFunction, candidate.name);
+		}
+	};
+
+	AttachedFunctionCandidates const& candidates = attachedFunctionCandidates(_scope);
+	switch (_type.category())
+	{
+	// Only these types can be implicitly converted to types of other categories.
+	case Category::Integer:
+	case Category::RationalNumber:
+	case Category::StringLiteral:
+	case Category::ArraySlice:
+		addCandidates(candidates.all, false);
+		break;
+	default:
+		if (auto it = candidates.byCategory.find(_type.category()); it != candidates.byCategory.end())
+			addCandidates(it->second, false);
+		break;
+	}
+
+	if (Declaration const* typeDefinition = _type.typeDefinition())
+		if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(typeDefinition->scope()))
+			// We do not yet compare the type name because of normalization.
+			addCandidates(attachedFunctionCandidates(*sourceUnit).all, true);
+
+	return members;
+}
+
+AttachedFunctionCandidates const& Type::attachedFunctionCandidates(ASTNode const& _scope)
 {
 	vector<UsingForDirective const*> usingForDirectives;
+	shared_ptr<AttachedFunctionCandidates const>* cache = nullptr;
 	SourceUnit const* sourceUnit = dynamic_cast<SourceUnit const*>(&_scope);
 	if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_scope))
 	{
+		cache = &contract->annotation().attachedFunctionCandidates;
 		sourceUnit = &contract->sourceUnit();
 		usingForDirectives += contract->usingForDirectives();
 	}
 	else
+	{
 		solAssert(sourceUnit, "");
+		cache = &sourceUnit->annotation().attachedFunctionCandidates;
+	}
+	if (*cache)
+		return **cache;
 	usingForDirectives += ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes());
 
-	if (Declaration const* typeDefinition = _type.typeDefinition())
-		if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(typeDefinition->scope()))
-			for (auto usingFor: ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes()))
-				// We do not yet compare the type name because of normalization.
-				if (usingFor->global() && usingFor->typeName())
-					usingForDirectives.emplace_back(usingFor);
-
-	// Normalise data location of type.
-	DataLocation typeLocation = DataLocation::Storage;
-	if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
-		typeLocation = refType->location();
-
-	MemberList::MemberMap members;
-
-	set<pair<string, Declaration const*>> seenFunctions;
-	auto addFunction = [&](FunctionDefinition const& _function, optional<string> _name = {})
+	auto candidates = make_shared<AttachedFunctionCandidates>();
+	auto addCandidate = [&](UsingForDirective const& _directive, FunctionDefinition const& _function, string _name)
 	{
-		if (!_name)
-			_name = _function.name();
+		if (_function.parameters().empty())
+			return;
 		Type const* functionType =
 			_function.libraryFunction() ? _function.typeViaContractName() : _function.type();
 		solAssert(functionType, "");
@@ -368,28 +438,18 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 			dynamic_cast<FunctionType const&>(*functionType).asBoundFunction();
 		solAssert(asBoundFunction, "");
 
-		if (_type.isImplicitlyConvertibleTo(*asBoundFunction->selfType()))
-			if (seenFunctions.insert(make_pair(*_name, &_function)).second)
-				members.emplace_back(&_function, asBoundFunction, *_name);
+		AttachedFunctionCandidates::Candidate candidate{
+			&_directive,
+			_directive.typeName() ? _directive.typeName()->annotation().type : nullptr,
+			&_function,
+			move(_name),
+			asBoundFunction
+		};
+		candidates->byCategory[asBoundFunction->selfType()->category()].emplace_back(candidate);
+		candidates->all.emplace_back(move(candidate));
 	};
 
 	for (UsingForDirective const* ufd: usingForDirectives)
-	{
-		// Convert both types to pointers for comparison to see if the `using for`
-		// directive applies.
-		// Further down, we check more detailed for each function if `_type` is
-		// convertible to the function parameter type.
-		if (
-			ufd->typeName() &&
-			*TypeProvider::withLocationIfReference(typeLocation, &_type, true) !=
-			*TypeProvider::withLocationIfReference(
-				typeLocation,
-				ufd->typeName()->annotation().type,
-				true
-			)
-		)
-			continue;
-
 		for (auto const& pathPointer: ufd->functionsOrLibrary())
 		{
 			solAssert(pathPointer);
@@ -401,20 +461,21 @@ MemberList::MemberMap Type::boundFunctions(Type const& _type, ASTNode const& _sc
 				solAssert(library->isLibrary());
 				for (FunctionDefinition const* function: library->definedFunctions())
 				{
-					if (!function->isOrdinary() || !function->isVisibleAsLibraryMember() || function->parameters().empty())
+					if (!function->isOrdinary() || !function->isVisibleAsLibraryMember())
 						continue;
-					addFunction(*function);
+					addCandidate(*ufd, *function, function->name());
 				}
 			}
 			else
-				addFunction(
+				addCandidate(
+					*ufd,
 					dynamic_cast<FunctionDefinition const&>(*declaration),
 					pathPointer->path().back()
 				);
 		}
-	}
 
-	return members;
+	*cache = move(candidates);
+	return **cache;
 }
 
 AddressType::AddressType(StateMutability _stateMutability):
@@ -1071,8 +1132,14 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 	else if (optional<rational> value = ConstantEvaluator::evaluateBinaryOperator(_operator, m_value, other.m_value))
 	{
 		// verify that numerator and denominator fit into 4096 bit after every operation
-		if (value->numerator() != 0 && max(boost::multiprecision::msb(abs(value->numerator())), boost::multiprecision::msb(abs(value->denominator()))) > 4096)
-			return TypeResult::err("Precision of rational constants is limited to 4096 bits.");
+		if (value->numerator() != 0)
+		{
+			unsigned bits = boost::multiprecision::msb(abs(value->numerator()));
+			if (value->denominator() != 1)
+				bits = max(bits, boost::multiprecision::msb(value->denominator()));
+			if (bits > 4096)
+				return TypeResult::err("Precision of rational constants is limited to 4096 bits.");
+		}
 
 		return TypeResult{TypeProvider::rationalNumber(*value)};
 	}
@@ -1213,13 +1280,17 @@ FixedPointType const* RationalNumberType::fixedPointType() const
 }
 
 StringLiteralType::StringLiteralType(Literal const& _literal):
-	m_value(_literal.value())
+	StringLiteralType(_literal.value())
 {
 }
 
 StringLiteralType::StringLiteralType(string _value):
-	m_value{std::move(_value)}
+	m_value{std::move(_value)},
+	m_hash{util::keccak256(m_value)}
 {
+	size_t invalidSequence;
+	if (!util::validateUTF8(m_value, invalidSequence))
+		m_invalidUTF8Position = invalidSequence;
 }
 
 BoolResult StringLiteralType::isImplicitlyConvertibleTo(Type const& _convertTo) const
@@ -1232,11 +1303,10 @@ BoolResult StringLiteralType::isImplicitlyConvertibleTo(Type const& _convertTo)
 	}
 	else if (auto arrayType = dynamic_cast<ArrayType const*>(&_convertTo))
 	{
-		size_t invalidSequence;
-		if (arrayType->isString() && !util::validateUTF8(value(), invalidSequence))
+		if (arrayType->isString() && m_invalidUTF8Position)
 			return BoolResult::err(
 				"Contains invalid UTF-8 sequence at position " +
-				util::toString(invalidSequence) +
+				util::toString(*m_invalidUTF8Position) +
 				"."
 			);
 		return
@@ -1252,14 +1322,17 @@ string StringLiteralType::richIdentifier() const
 {
 	// Since we have to return a valid identifier and the string itself may contain
 	// anything, we hash it.
-	return "t_stringliteral_" + util::toHex(util::keccak256(m_value).asBytes());
+	return "t_stringliteral_" + util::toHex(m_hash.asBytes());
 }
 
 bool StringLiteralType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
-	return m_value == dynamic_cast<StringLiteralType const&>(_other).m_value;
+	auto const& other = dynamic_cast<StringLiteralType const&>(_other);
+	return m_hash == other.m_hash && m_value == other.m_value;
 }
 
 std::string StringLiteralType::toString(bool) const
@@ -3487,8 +3560,11 @@ bool FunctionType::isBareCall() const
 	}
 }
 
-string FunctionType::externalSignature() const
+string const& FunctionType::externalSignature() const
 {
+	if (m_externalSignature)
+		return *m_externalSignature;
+
 	solAssert(m_declaration != nullptr, "External signature of function needs declaration");
 	solAssert(!m_declaration->name().empty(), "Fallback function has no signature.");
 	switch (kind())
@@ -3522,17 +3598,33 @@ string FunctionType::externalSignature() const
 			typeName += " storage";
 		return typeName;
 	});
-	return m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	m_externalSignature = m_declaration->name() + "(" + boost::algorithm::join(typeStrings, ",") + ")";
+	return *m_externalSignature;
+}
+
+util::FixedHash<4> const& FunctionType::externalSelector() const
+{
+	if (!m_externalSelector)
+		m_externalSelector = util::FixedHash<4>(util::keccak256(externalSignature()));
+	return *m_externalSelector;
 }
 
 u256 FunctionType::externalIdentifier() const
 {
-	return util::selectorFromSignature32(externalSignature());
+	return u256(util::FixedHash<4>::Arith(externalSelector()));
 }
 
 string FunctionType::externalIdentifierHex() const
 {
-	return util::FixedHash<4>(util::keccak256(externalSignature())).hex();
+	return externalSelector().hex();
+}
+
+void FunctionType::clearCache() const
+{
+	Type::clearCache();
+
+	m_externalSignature.reset();
+	m_externalSelector.reset();
 }
 
 bool FunctionType::isPure() const
@@ -31,6 +31,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Numeric.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/Result.h>
 
@@ -49,6 +50,7 @@ namespace solidity::frontend
 class TypeProvider;
 class Type; // forward
 class FunctionType; // forward
+struct AttachedFunctionCandidates; // forward
 using FunctionTypePointer = FunctionType const*;
 using TypePointers = std::vector<Type const*>;
 using rational = boost::rational<bigint>;
@@ -193,7 +195,8 @@ public:
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	/// The result is cached, since it is used heavily to name utility functions.
+	std::string const& identifier() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -379,6 +382,9 @@ public:
 private:
 	/// @returns a member list containing all members added to this type by `using for` directives.
 	static MemberList::MemberMap boundFunctions(Type const& _type, ASTNode const& _scope);
+	/// @returns the functions attached by `using for` directives in @a _scope, computing them
+	/// on first use.
+	static AttachedFunctionCandidates const& attachedFunctionCandidates(ASTNode const& _scope);
 
 protected:
 	/// @returns the members native to this type depending on the given context. This function
@@ -399,6 +405,27 @@ protected:
 	mutable std::map<ASTNode const*, std::unique_ptr<MemberList>> m_members;
 	mutable std::optional<std::vector<std::tuple<std::string, Type const*>>> m_stackItems;
 	mutable std::optional<size_t> m_stackSize;
+	mutable std::optional<std::string> m_identifier;
+};
+
+/**
+ * Functions attached to types by the ``using for`` directives of a scope, in the order of the
+ * directives, together with their bound function types.
+ */
+struct AttachedFunctionCandidates
+{
+	struct Candidate
+	{
+		UsingForDirective const* directive = nullptr;
+		/// The type named in the directive or nullptr for ``*``.
+		Type const* directiveType = nullptr;
+		FunctionDefinition const* function = nullptr;
+		std::string name;
+		FunctionType const* boundFunction = nullptr;
+	};
+	std::vector<Candidate> all;
+	/// The candidates grouped by the category of the type they are bound to.
+	std::map<Type::Category, std::vector<Candidate>> byCategory;
 };
 
 /**
@@ -641,6 +668,9 @@ protected:
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override { return {}; }
 private:
 	std::string m_value;
+	/// Computed once, since literals can be large and the identifier and the validity are queried often.
+	util::h256 m_hash;
+	std::optional<size_t> m_invalidUTF8Position;
 };
 
 /**
@@ -1420,7 +1450,9 @@ public:
 	Kind const& kind() const { return m_kind; }
 	StateMutability stateMutability() const { return m_stateMutability; }
 	/// @returns the external signature of this function type given the function name
-	std::string externalSignature() const;
+	std::string const& externalSignature() const;
+	/// @returns the first four bytes of the hash of the external signature.
+	util::FixedHash<4> const& externalSelector() const;
 	/// @returns the external identifier of this function (the hash of the signature).
 	u256 externalIdentifier() const;
 	/// @returns the external identifier of this function (the hash of the signature) as a hex string.
@@ -1483,11 +1515,17 @@ public:
 	/// @param _inLibrary if true, uses DelegateCall as location.
 	FunctionTypePointer asExternallyCallableFunction(bool _inLibrary) const;
 
+	void clearCache() const override;
+
 protected:
 	std::vector<std::tuple<std::string, Type const*>> makeStackItems() const override;
 private:
 	static TypePointers parseElementaryTypeVector(strings const& _types);
 
+	/// The signature and selector are requested many times during analysis and code generation.
+	mutable std::optional<std::string> m_externalSignature;
+	mutable std::optional<util::FixedHash<4>> m_externalSelector;
+
 	TypePointers m_parameterTypes;
 	TypePointers m_returnParameterTypes;
 	std::vector<std::string> m_parameterNames;
@@ -23,6 +23,7 @@
 
 #include <libsolidity/codegen/ABIFunctions.h>
 
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
@@ -190,17 +191,58 @@ string ABIFunctions::tupleEncoderPacked(
 		return templ.render();
 	});
 }
+namespace
+{
+
+/// @returns a type that is ABI-decoded by exactly the same code as @a _type, preferring
+/// a small set of types, so that decoders for these types can be shared.
+Type const* sharedDecodingType(Type const* _type)
+{
+	if (auto const* userDefinedValueType = dynamic_cast<UserDefinedValueType const*>(_type))
+		return sharedDecodingType(&userDefinedValueType->underlyingType());
+	else if (dynamic_cast<AddressType const*>(_type) || dynamic_cast<ContractType const*>(_type))
+		return TypeProvider::address();
+	else if (auto const* integerType = dynamic_cast<IntegerType const*>(_type))
+	{
+		// There is nothing to validate for 256 bit values.
+		if (integerType->numBits() == 256)
+			return TypeProvider::uint256();
+	}
+	else if (auto const* fixedBytesType = dynamic_cast<FixedBytesType const*>(_type))
+	{
+		if (fixedBytesType->numBytes() == 32)
+			return TypeProvider::uint256();
+	}
+	else if (auto const* arrayType = dynamic_cast<ArrayType const*>(_type))
+		if (!arrayType->isByteArrayOrString())
+		{
+			Type const* baseType = sharedDecodingType(arrayType->baseType());
+			if (baseType != arrayType->baseType())
+				return arrayType->isDynamicallySized() ?
+					TypeProvider::array(arrayType->location(), baseType) :
+					TypeProvider::array(arrayType->location(), baseType, arrayType->length());
+		}
+	return _type;
+}
+
+}
+
 string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 {
+	TypePointers types = _types;
+	if (m_decoderMode == ABIDecoderMode::Compact)
+		for (auto& t: types)
+			t = sharedDecodingType(t);
+
 	string functionName = string("abi_decode_tuple_");
-	for (auto const& t: _types)
+	for (auto const& t: types)
 		functionName += t->identifier();
 	if (_fromMemory)
 		functionName += "_fromMemory";
 
 	return createFunction(functionName, [&]() {
 		TypePointers decodingTypes;
-		for (auto const& t: _types)
+		for (auto const& t: types)
 			decodingTypes.emplace_back(t->decodingType());
 
 		Whiskers templ(R"(
@@ -217,11 +259,11 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 		vector<string> valueReturnParams;
 		size_t headPos = 0;
 		size_t stackPos = 0;
-		for (size_t i = 0; i < _types.size(); ++i)
+		for (size_t i = 0; i < types.size(); ++i)
 		{
-			solAssert(_types[i], "");
+			solAssert(types[i], "");
 			solAssert(decodingTypes[i], "");
-			size_t sizeOnStack = _types[i]->sizeOnStack();
+			size_t sizeOnStack = types[i]->sizeOnStack();
 			solAssert(sizeOnStack == decodingTypes[i]->sizeOnStack(), "");
 			solAssert(sizeOnStack > 0, "");
 			vector<string> valueNamesLocal;
@@ -248,7 +290,7 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 			elementTempl("load", _fromMemory ? "mload" : "calldataload");
 			elementTempl("values", boost::algorithm::join(valueNamesLocal, ", "));
 			elementTempl("pos", to_string(headPos));
-			elementTempl("abiDecode", abiDecodingFunction(*_types[i], _fromMemory, true));
+			elementTempl("abiDecode", abiDecodingFunction(*types[i], _fromMemory, true));
 			decodeElements += elementTempl.render();
 			headPos += decodingTypes[i]->calldataHeadSize();
 		}
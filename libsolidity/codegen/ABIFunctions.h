@@ -26,6 +26,7 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <liblangutil/EVMVersion.h>
@@ -57,10 +58,12 @@ public:
 	explicit ABIFunctions(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		MultiUseYulFunctionCollector& _functionCollector
+		MultiUseYulFunctionCollector& _functionCollector,
+		ABIDecoderMode _decoderMode = ABIDecoderMode::Default
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
+		m_decoderMode(_decoderMode),
 		m_functionCollector(_functionCollector),
 		m_utils(_evmVersion, m_revertStrings, m_functionCollector)
 	{}
@@ -123,6 +126,8 @@ public:
 	/// Outputs: <value0> <value1> ... <valuen>
 	/// The values represent stack slots. If a type occupies more or less than one
 	/// stack slot, it takes exactly that number of values.
+	/// In the compact decoder mode, the decoder is shared with all tuples whose types are
+	/// decoded in the same way, e.g. ``(address, bytes32)`` and ``(address payable, uint256)``.
 	std::string tupleDecoder(TypePointers const& _types, bool _fromMemory = false);
 
 	struct EncodingOptions
@@ -279,6 +284,7 @@ private:
 
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings const m_revertStrings;
+	ABIDecoderMode const m_decoderMode;
 	MultiUseYulFunctionCollector& m_functionCollector;
 	YulUtilFunctions m_utils;
 };
@@ -25,6 +25,7 @@
 
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <liblangutil/EVMVersion.h>
 #include <libevmasm/Assembly.h>
@@ -37,10 +38,15 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		ABIDecoderMode _abiDecoderMode = ABIDecoderMode::Default
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _revertStrings),
-		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, _revertStrings, nullptr, _abiDecoderMode, m_optimiserSettings.experimentalOptimisations),
+		m_context(_evmVersion, _revertStrings, &m_runtimeContext, _abiDecoderMode, m_optimiserSettings.experimentalOptimisations)
 	{ }
 
 	/// Compiles a contract.
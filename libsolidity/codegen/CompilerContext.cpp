@@ -26,6 +26,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 #include <libsolidity/interface/Version.h>
 
 #include <libyul/AST.h>
@@ -41,6 +42,7 @@
 #include <libyul/YulString.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/FunctionSelector.h>
 
@@ -388,24 +390,11 @@ void CompilerContext::appendInlineAssembly(
 {
 	unsigned startStackHeight = stackHeight();
 
-	set<yul::YulString> externallyUsedIdentifiers;
-	for (auto const& fun: _externallyUsedFunctions)
-		externallyUsedIdentifiers.insert(yul::YulString(fun));
-	for (auto const& var: _localVariables)
-		externallyUsedIdentifiers.insert(yul::YulString(var));
+	optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
 
-	yul::ExternalIdentifierAccess identifierAccess;
-	identifierAccess.resolve = [&](
-		yul::Identifier const& _identifier,
-		yul::IdentifierContext,
-		bool _insideFunction
-	) -> bool
-	{
-		if (_insideFunction)
-			return false;
-		return util::contains(_localVariables, _identifier.name.str());
-	};
-	identifierAccess.generateCode = [&](
+	yul::ExternalIdentifierAccess::CodeGenerator identifierAccess = [&](
 		yul::Identifier const& _identifier,
 		yul::IdentifierContext _context,
 		yul::AbstractAssembly& _assembly
@@ -421,7 +410,7 @@ void CompilerContext::appendInlineAssembly(
 		if (stackDiff < 1 || stackDiff > 16)
 			BOOST_THROW_EXCEPTION(
 				StackTooDeepError() <<
-				errinfo_sourceLocation(nativeLocationOf(_identifier)) <<
+				errinfo_sourceLocation(locationOverride ? *locationOverride : nativeLocationOf(_identifier)) <<
 				util::errinfo_comment("Stack too deep (" + to_string(stackDiff) + "), try removing local variables.")
 			);
 		if (_context == yul::IdentifierContext::RValue)
@@ -433,16 +422,101 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	// The snippet is parsed without the source location it is assigned to, so that it can be
+	// reused for other call sites. The location is applied during code generation instead.
+	InlineAssemblyCache* cache = InlineAssemblyCache::active();
+	InlineAssemblyCache::Snippet parsedSnippet;
+	InlineAssemblyCache::Snippet const* snippet = nullptr;
+	util::h256 cacheKey;
+	if (cache)
+	{
+		cacheKey = inlineAssemblyCacheKey(_assembly, _localVariables, _externallyUsedFunctions, _system, _optimiserSettings, _sourceName);
+		snippet = cache->find(cacheKey);
+	}
+	if (!snippet)
+	{
+		parsedSnippet = parseInlineAssembly(_assembly, _localVariables, _externallyUsedFunctions, _system, _optimiserSettings, _sourceName);
+		snippet = cache ? &cache->store(cacheKey, move(parsedSnippet)) : &parsedSnippet;
+	}
+
+	if (_system)
+	{
+		solAssert(m_generatedYulUtilityCode.empty(), "");
+		m_generatedYulUtilityCode = snippet->generatedSource;
+	}
+
+	yul::CodeGenerator::assemble(
+		*snippet->code,
+		*snippet->analysisInfo,
+		*m_asm,
+		m_evmVersion,
+		identifierAccess,
+		_system,
+		_optimiserSettings.optimizeStackAllocation,
+		locationOverride
+	);
+
+	// Reset the source location to the one of the node (instead of the CODEGEN source location)
+	updateSourceLocation();
+}
+
+util::h256 CompilerContext::inlineAssemblyCacheKey(
+	string const& _assembly,
+	vector<string> const& _localVariables,
+	set<string> const& _externallyUsedFunctions,
+	bool _system,
+	OptimiserSettings const& _optimiserSettings,
+	string const& _sourceName
+) const
+{
+	string key = _assembly + '\0' + _sourceName + '\0' + m_evmVersion.name() + '\0' + (_system ? "system" : "") + '\0';
+	for (string const& variable: _localVariables)
+		key += variable + ',';
+	key += '\0';
+	for (string const& function: _externallyUsedFunctions)
+		key += function + ',';
+	key += '\0';
+	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+		key +=
+			string(runtimeContext() ? "creation" : "runtime") + '\0' +
+			(_optimiserSettings.optimizeStackAllocation ? "stackAllocation" : "") + '\0' +
+			_optimiserSettings.yulOptimiserSteps + '\0' +
+			to_string(_optimiserSettings.expectedExecutionsPerDeployment) + '\0' +
+			(_optimiserSettings.yulOptimiserBudget ? to_string(*_optimiserSettings.yulOptimiserBudget) : "");
+	return util::keccak256(key);
+}
+
+InlineAssemblyCache::Snippet CompilerContext::parseInlineAssembly(
+	string const& _assembly,
+	vector<string> const& _localVariables,
+	set<string> const& _externallyUsedFunctions,
+	bool _system,
+	OptimiserSettings const& _optimiserSettings,
+	string const& _sourceName
+)
+{
+	set<yul::YulString> externallyUsedIdentifiers;
+	for (auto const& fun: _externallyUsedFunctions)
+		externallyUsedIdentifiers.insert(yul::YulString(fun));
+	for (auto const& var: _localVariables)
+		externallyUsedIdentifiers.insert(yul::YulString(var));
+
+	yul::ExternalIdentifierAccess::Resolver resolver = [&](
+		yul::Identifier const& _identifier,
+		yul::IdentifierContext,
+		bool _insideFunction
+	) -> bool
+	{
+		if (_insideFunction)
+			return false;
+		return util::contains(_localVariables, _identifier.name.str());
+	};
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	langutil::CharStream charStream(_assembly, _sourceName);
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(charStream);
+	shared_ptr<yul::Block> parserResult = yul::Parser(errorReporter, dialect).parse(charStream);
 #ifdef SOL_OUTPUT_ASM
 	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
 #endif
@@ -456,48 +530,46 @@ void CompilerContext::appendInlineAssembly(
 			_assembly + "\n"
 			"------------------ Errors: ----------------\n";
 		for (auto const& error: errorReporter.errors())
-			// TODO if we have "locationOverride", it will be the wrong char stream,
-			// but we do not have access to the solidity scanner.
 			message += SourceReferenceFormatter::formatErrorInformation(*error, charStream);
 		message += "-------------------------------------------\n";
 
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
+	auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
 	bool analyzerResult = false;
 	if (parserResult)
 		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
+			*analysisInfo,
 			errorReporter,
 			dialect,
-			identifierAccess.resolve
+			resolver
 		).analyze(*parserResult);
 	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
 		reportError("Invalid assembly generated by code generator.");
 
+	InlineAssemblyCache::Snippet snippet;
+
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
 	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
 	{
 		yul::Object obj;
 		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
+		obj.analysisInfo = analysisInfo;
 
 		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
 
 		if (_system)
 		{
 			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			langutil::CharStream charStream(m_generatedYulUtilityCode, _sourceName);
+			snippet.generatedSource = yul::AsmPrinter(dialect)(*obj.code);
+			langutil::CharStream charStream(snippet.generatedSource, _sourceName);
 			obj.code = yul::Parser(errorReporter, dialect).parse(charStream);
 			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
+		analysisInfo = std::move(obj.analysisInfo);
 		parserResult = std::move(obj.code);
 
 #ifdef SOL_OUTPUT_ASM
@@ -506,28 +578,16 @@ void CompilerContext::appendInlineAssembly(
 #endif
 	}
 	else if (_system)
-	{
 		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
+		snippet.generatedSource = _assembly;
 
 	if (!errorReporter.errors().empty())
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
-		*m_asm,
-		m_evmVersion,
-		identifierAccess.generateCode,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
-
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	snippet.code = std::move(parserResult);
+	snippet.analysisInfo = std::move(analysisInfo);
+	return snippet;
 }
 
 
@@ -546,7 +606,10 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
 		isCreation? nullopt : make_optional(_optimiserSettings.expectedExecutionsPerDeployment),
-		_externalIdentifiers
+		_externalIdentifiers,
+		_optimiserSettings.yulOptimiserBudget,
+		{},
+		_optimiserSettings.experimentalOptimisations
 	);
 
 #ifdef SOL_OUTPUT_ASM
@@ -572,7 +635,7 @@ void CompilerContext::updateSourceLocation()
 evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, m_evmVersion, 0, 1, {}};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -581,6 +644,8 @@ evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
+	asmSettings.experimentalOptimisations = _settings.experimentalOptimisations;
+	asmSettings.threads = yul::OptimiserSuite::ParallelismActivation::threads();
 	return asmSettings;
 }
 
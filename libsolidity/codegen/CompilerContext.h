@@ -27,7 +27,9 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -37,6 +39,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <libsolutil/Common.h>
 #include <libsolutil/ErrorCodes.h>
+#include <libsolutil/FixedHash.h>
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -63,15 +66,18 @@ public:
 	explicit CompilerContext(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		ABIDecoderMode _abiDecoderMode = ABIDecoderMode::Default,
+		std::set<ExperimentalOptimisation> _experimentalOptimisations = {}
 	):
 		m_asm(std::make_shared<evmasm::Assembly>(_runtimeContext != nullptr, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
+		m_experimentalOptimisations(std::move(_experimentalOptimisations)),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
-		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector),
-		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector)
+		m_abiFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector, _abiDecoderMode),
+		m_yulUtilFunctions(m_evmVersion, m_revertStrings, m_yulFunctionCollector, m_experimentalOptimisations)
 	{
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
@@ -165,6 +171,19 @@ public:
 	);
 	/// Generates the code for missing low-level functions, i.e. calls the generators passed above.
 	void appendMissingLowLevelFunctions();
+
+	/// @returns the code stored for the type conversion described by @a _key or nullptr.
+	/// @see CompilerUtils::convertType
+	evmasm::AssemblyItems const* cachedConversion(std::string const& _key) const
+	{
+		auto it = m_conversionCache.find(_key);
+		return it == m_conversionCache.end() ? nullptr : &it->second;
+	}
+	/// Stores the code of a type conversion for reuse. The code must not contain tags.
+	void cacheConversion(std::string _key, evmasm::AssemblyItems _code)
+	{
+		m_conversionCache.emplace(std::move(_key), std::move(_code));
+	}
 	ABIFunctions& abiFunctions() { return m_abiFunctions; }
 	YulUtilFunctions& utilFunctions() { return m_yulUtilFunctions; }
 
@@ -263,6 +282,7 @@ public:
 	///                and the code is marked to be exported as "compiler-generated assembly utility file".
 	/// @param _optimiserSettings settings for the Yul optimiser, which is run in this function already.
 	/// @param _sourceName the name of the assembly file to be used for source locations
+	/// Snippets are only parsed, analysed and optimised once per active InlineAssemblyCache.
 	void appendInlineAssembly(
 		std::string const& _assembly,
 		std::vector<std::string> const& _localVariables = std::vector<std::string>(),
@@ -309,11 +329,35 @@ public:
 	void setModifierDepth(size_t _modifierDepth) { m_asm->m_currentModifierDepth = _modifierDepth; }
 
 	RevertStrings revertStrings() const { return m_revertStrings; }
+	/// @returns true if the experimental optimisation @a _optimisation affecting the generated code was requested.
+	bool runExperimental(ExperimentalOptimisation _optimisation) const
+	{
+		return m_experimentalOptimisations.count(_optimisation) > 0;
+	}
 
 private:
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
+	/// @returns the key of an inline assembly snippet in the InlineAssemblyCache.
+	util::h256 inlineAssemblyCacheKey(
+		std::string const& _assembly,
+		std::vector<std::string> const& _localVariables,
+		std::set<std::string> const& _externallyUsedFunctions,
+		bool _system,
+		OptimiserSettings const& _optimiserSettings,
+		std::string const& _sourceName
+	) const;
+	/// Parses, analyses and optimises an inline assembly snippet for appendInlineAssembly().
+	InlineAssemblyCache::Snippet parseInlineAssembly(
+		std::string const& _assembly,
+		std::vector<std::string> const& _localVariables,
+		std::set<std::string> const& _externallyUsedFunctions,
+		bool _system,
+		OptimiserSettings const& _optimiserSettings,
+		std::string const& _sourceName
+	);
+
 	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
 
 	/**
@@ -352,6 +396,7 @@ private:
 	/// Version of the EVM to compile against.
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings const m_revertStrings;
+	std::set<ExperimentalOptimisation> const m_experimentalOptimisations;
 	bool m_useABICoderV2 = false;
 	/// Other already compiled contracts to be used in contract creation calls.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> m_otherCompilers;
@@ -380,6 +425,8 @@ private:
 	size_t m_runtimeSub = std::numeric_limits<size_t>::max();
 	/// An index of low-level function labels by name.
 	std::map<std::string, evmasm::AssemblyItem> m_lowLevelFunctions;
+	/// Code of type conversions by conversion, see CompilerUtils::convertType.
+	std::map<std::string, evmasm::AssemblyItems> m_conversionCache;
 	/// Collector for yul functions.
 	MultiUseYulFunctionCollector m_yulFunctionCollector;
 	/// Set of externally used yul functions.
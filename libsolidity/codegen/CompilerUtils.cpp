@@ -29,6 +29,7 @@
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libevmasm/GasMeter.h>
 #include <libevmasm/Instruction.h>
 #include <libsolutil/Whiskers.h>
 
@@ -93,14 +94,7 @@ void CompilerUtils::toSizeAfterFreeMemoryPointer()
 void CompilerUtils::revertWithStringData(Type const& _argumentType)
 {
 	solAssert(_argumentType.isImplicitlyConvertibleTo(*TypeProvider::fromElementaryTypeName("string memory")));
-	fetchFreeMemoryPointer();
-	m_context << util::selectorFromSignature("Error(string)");
-	m_context << Instruction::DUP2 << Instruction::MSTORE;
-	m_context << u256(4) << Instruction::ADD;
-	// Stack: <string data> <mem pos of encoding start>
-	abiEncode({&_argumentType}, {TypeProvider::array(DataLocation::Memory, true)});
-	toSizeAfterFreeMemoryPointer();
-	m_context << Instruction::REVERT;
+	revertWithError("Error(string)", {TypeProvider::array(DataLocation::Memory, true)}, {&_argumentType});
 }
 
 void CompilerUtils::revertWithError(
@@ -108,6 +102,36 @@ void CompilerUtils::revertWithError(
 	vector<Type const*> const& _parameterTypes,
 	vector<Type const*> const& _argumentTypes
 )
+{
+	if (!m_context.runExperimental(ExperimentalOptimisation::SharedReverts))
+	{
+		encodeAndRevertWithError(_signature, _parameterTypes, _argumentTypes);
+		return;
+	}
+
+	// The code only depends on the error and the types, so it is shared by all
+	// reverts with the same error, e.g. all ``require``s with the same reason string.
+	string name = "$revertWithError_" + _signature;
+	for (Type const* type: _argumentTypes)
+		name += "_" + type->identifier();
+	name += "_to";
+	for (Type const* type: _parameterTypes)
+		name += "_" + type->identifier();
+	m_context.callLowLevelFunction(
+		name,
+		sizeOnStack(_argumentTypes),
+		0,
+		[=](CompilerContext& _context) {
+			CompilerUtils(_context).encodeAndRevertWithError(_signature, _parameterTypes, _argumentTypes);
+		}
+	);
+}
+
+void CompilerUtils::encodeAndRevertWithError(
+	string const& _signature,
+	vector<Type const*> const& _parameterTypes,
+	vector<Type const*> const& _argumentTypes
+)
 {
 	fetchFreeMemoryPointer();
 	m_context << util::selectorFromSignature(_signature);
@@ -682,8 +706,18 @@ void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
+	optional<size_t> threshold;
+	if (m_context.runExperimental(ExperimentalOptimisation::IdentityPrecompileCopy))
+		threshold = identityPrecompileCopyThreshold(m_context.evmVersion());
+	Whiskers templ(R"(
 		{
+			<?useIdentity>
+			let copied := 0
+			if iszero(lt(len, <threshold>)) {
+				copied := staticcall(gas(), 4, src, len, dst, len)
+			}
+			if iszero(copied) {
+			</useIdentity>
 			// copy 32 bytes at once
 			for
 				{}
@@ -700,10 +734,14 @@ void CompilerUtils::memoryCopy()
 			let srcpart := and(mload(src), not(mask))
 			let dstpart := and(mload(dst), mask)
 			mstore(dst, or(srcpart, dstpart))
+			<?useIdentity>
+			}
+			</useIdentity>
 		}
-	)",
-		{ "len", "dst", "src" }
-	);
+	)");
+	templ("useIdentity", threshold.has_value());
+	templ("threshold", threshold ? to_string(*threshold) : "");
+	m_context.appendInlineAssembly(templ.render(), { "len", "dst", "src" });
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
 }
 
@@ -762,6 +800,49 @@ void CompilerUtils::convertType(
 	bool _chopSignBits,
 	bool _asPartOfArgumentDecoding
 )
+{
+	if (_typeOnStack == _targetType && !_cleanupNeeded)
+		return;
+
+	// Conversions between value types mostly consist of a few plain instructions,
+	// which are reused instead of walking through the conversion logic again.
+	// Code that contains tags or references to data is never reused.
+	string key =
+		_typeOnStack.identifier() + "," +
+		_targetType.identifier() + "," +
+		(_cleanupNeeded ? "c" : "") +
+		(_chopSignBits ? "s" : "") +
+		(_asPartOfArgumentDecoding ? "a" : "") +
+		(m_context.useABICoderV2() ? "2" : "");
+	if (AssemblyItems const* code = m_context.cachedConversion(key))
+	{
+		for (AssemblyItem const& item: *code)
+			m_context << item;
+		return;
+	}
+
+	size_t start = m_context.assembly().items().size();
+	convertTypeUncached(_typeOnStack, _targetType, _cleanupNeeded, _chopSignBits, _asPartOfArgumentDecoding);
+
+	AssemblyItems const& items = m_context.assembly().items();
+	AssemblyItems code;
+	for (size_t i = start; i < items.size(); ++i)
+	{
+		if (items[i].type() != Operation && items[i].type() != Push)
+			return;
+		code.emplace_back(items[i]);
+		code.back().setLocation({});
+	}
+	m_context.cacheConversion(move(key), move(code));
+}
+
+void CompilerUtils::convertTypeUncached(
+	Type const& _typeOnStack,
+	Type const& _targetType,
+	bool _cleanupNeeded,
+	bool _chopSignBits,
+	bool _asPartOfArgumentDecoding
+)
 {
 	// For a type extension, we need to remove all higher-order bits that we might have ignored in
 	// previous operations.
@@ -1492,6 +1573,62 @@ void CompilerUtils::popAndJump(unsigned _toHeight, evmasm::AssemblyItem const& _
 	m_context.adjustStackOffset(static_cast<int>(amount));
 }
 
+bool CompilerUtils::splitFunctionDispatch(size_t _functions, size_t _runs)
+{
+	// Code for selecting from n functions without split:
+	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
+	//   push2/3 <notfound> jump
+	// (called SELECT[n])
+	// Code for selecting from n functions with split:
+	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
+	//     SELECT[n/2]
+	//   tag_less:
+	//     SELECT[n/2]
+	//
+	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
+	// The average execution cost if we do not split at all are:
+	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
+	// If we split once:
+	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
+	//
+	// We should split if
+	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+	//
+	// Which also means that the execution itself is not profitable
+	// unless we have at least 5 functions.
+	// The code generated via IR has the same shape, so the same estimate is used there.
+
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_functions <= 4)
+		return false;
+	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return _runs * 6 * (_functions - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
+
+optional<size_t> CompilerUtils::identityPrecompileCopyThreshold(langutil::EVMVersion _evmVersion)
+{
+	// Without static calls, the precompile would have to be called with a value, which is
+	// not worth it.
+	if (!_evmVersion.hasStaticCall())
+		return nullopt;
+
+	// One iteration of the copy loop costs about
+	//   mload + mstore + 3 * add + lt + iszero + jumpi + jump + jumpdest + stack operations
+	//   = 3 + 3 + 9 + 3 + 3 + 10 + 8 + 1 + ~20 = ~60
+	// while the call costs the call itself, the base cost of the precompile and about 40 for
+	// pushing the arguments and checking the result, plus 3 per word.
+	// The memory expansion cost is the same in both cases.
+	size_t const loopWordGas = 60;
+	size_t const callGas =
+		evmasm::GasCosts::precompileCallGas(_evmVersion) +
+		evmasm::GasCosts::identityGas +
+		40;
+	return (callGas / (loopWordGas - evmasm::GasCosts::identityWordGas) + 1) * 32;
+}
+
 unsigned CompilerUtils::sizeOnStack(vector<Type const*> const& _variableTypes)
 {
 	unsigned size = 0;
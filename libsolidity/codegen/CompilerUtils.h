@@ -70,8 +70,14 @@ public:
 	/// Stack post:
 	void revertWithStringData(Type const& _argumentType);
 
+	/// Appends code that performs a revert with the error of signature @a _signature,
+	/// encoding the arguments of types @a _argumentTypes as @a _parameterTypes.
+	/// With the experimental optimisation ``SharedReverts``, the encoding is done in a
+	/// low-level function shared by all reverts with the same error and types.
+	/// Stack pre: <arguments>
+	/// Stack post:
 	void revertWithError(
-		std::string const& _errorName,
+		std::string const& _signature,
 		std::vector<Type const*> const& _parameterTypes,
 		std::vector<Type const*> const& _argumentTypes
 	);
@@ -210,6 +216,8 @@ public:
 	void memoryCopy32();
 	/// Copies data in memory (regions cannot overlap).
 	/// Length can be zero, in this case, it copies nothing.
+	/// With the experimental optimisation ``IdentityPrecompileCopy``, uses the identity precompile
+	/// for sizes of at least @see identityPrecompileCopyThreshold.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
 	void memoryCopy();
@@ -303,6 +311,16 @@ public:
 	/// @note the contract has to be compiled already, so beware of cyclic dependencies!
 	void copyContractCodeToMemory(ContractDefinition const& contract, bool _creationCode);
 
+	/// @returns true if a function dispatcher that selects among @a _functions sorted selectors
+	/// should compare against a pivot first and continue in either half, given that the contract
+	/// is expected to be executed @a _runs times.
+	static bool splitFunctionDispatch(size_t _functions, size_t _runs);
+
+	/// @returns the number of bytes from which copying memory by a static call to the identity
+	/// precompile is expected to be cheaper than a loop copying one word per iteration, or
+	/// nullopt if static calls are not available.
+	static std::optional<size_t> identityPrecompileCopyThreshold(langutil::EVMVersion _evmVersion);
+
 	/// Bytes we need to the start of call data.
 	///  - The size in bytes of the function (hash) identifier.
 	static unsigned const dataStartOffset;
@@ -315,6 +333,23 @@ public:
 	static size_t const generalPurposeMemoryStart;
 
 private:
+	/// Appends the code of @see revertWithError in place.
+	void encodeAndRevertWithError(
+		std::string const& _signature,
+		std::vector<Type const*> const& _parameterTypes,
+		std::vector<Type const*> const& _argumentTypes
+	);
+
+	/// Appends the code for the conversion, bypassing the cache of conversion code in the context.
+	/// @see convertType
+	void convertTypeUncached(
+		Type const& _typeOnStack,
+		Type const& _targetType,
+		bool _cleanupNeeded,
+		bool _chopSignBits,
+		bool _asPartOfArgumentDecoding
+	);
+
 	/// Appends code that cleans higher-order bits for integer types.
 	void cleanHigherOrderBits(IntegerType const& _typeOnStack);
 
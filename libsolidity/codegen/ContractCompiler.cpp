@@ -42,7 +42,6 @@
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
-#include <libevmasm/GasMeter.h>
 
 #include <liblangutil/ErrorReporter.h>
 
@@ -329,37 +328,9 @@ void ContractCompiler::appendInternalSelector(
 	size_t _runs
 )
 {
-	// Code for selecting from n functions without split:
-	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
-	//   push2/3 <notfound> jump
-	// (called SELECT[n])
-	// Code for selecting from n functions with split:
-	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
-	//     SELECT[n/2]
-	//   tag_less:
-	//     SELECT[n/2]
-	//
-	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
-	// The average execution cost if we do not split at all are:
-	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
-	// If we split once:
-	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
-	//
-	// We should split if
-	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
-	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
-	//
-	// Which also means that the execution itself is not profitable
-	// unless we have at least 5 functions.
-
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
+	bool split =
+		m_optimiserSettings.functionDispatch != FunctionDispatch::Linear &&
+		CompilerUtils::splitFunctionDispatch(_ids.size(), _runs);
 
 	if (split)
 	{
@@ -949,6 +920,21 @@ bool ContractCompiler::visit(InlineAssembly const& _inlineAssembly)
 		analysisInfo = object.analysisInfo.get();
 	}
 
+	// Blocks that only work on their own variables can be compiled like Yul code, which avoids
+	// most of the stack shuffling of the legacy code transform. We fall back to it on stack errors.
+	if (
+		m_optimiserSettings.optimizeInlineAssemblyStack &&
+		m_optimiserSettings.optimizeStackAllocation &&
+		m_context.evmVersion().canOverchargeGasForCall() &&
+		_inlineAssembly.annotation().externalReferences.empty() &&
+		(_inlineAssembly.annotation().markedMemorySafe || !*_inlineAssembly.annotation().hasMemoryEffects) &&
+		yul::CodeGenerator::assembleOptimized(*code, *analysisInfo, *m_context.assemblyPtr(), m_context.evmVersion())
+	)
+	{
+		solAssert(m_context.stackHeight() == startStackHeight, "");
+		return false;
+	}
+
 	yul::CodeGenerator::assemble(
 		*code,
 		*analysisInfo,
@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for inline assembly snippets of the legacy code generator.
+ */
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+thread_local InlineAssemblyCache* t_activeCache = nullptr;
+
+}
+
+InlineAssemblyCache::Snippet const* InlineAssemblyCache::find(util::h256 const& _key) const
+{
+	auto it = m_snippets.find(_key);
+	return it != m_snippets.end() ? &it->second : nullptr;
+}
+
+InlineAssemblyCache::Snippet const& InlineAssemblyCache::store(util::h256 const& _key, Snippet _snippet)
+{
+	return m_snippets.emplace(_key, std::move(_snippet)).first->second;
+}
+
+InlineAssemblyCache* InlineAssemblyCache::active()
+{
+	return t_activeCache;
+}
+
+InlineAssemblyCache::Activation::Activation(InlineAssemblyCache* _cache):
+	m_previousCache(t_activeCache)
+{
+	t_activeCache = _cache;
+}
+
+InlineAssemblyCache::Activation::~Activation()
+{
+	t_activeCache = m_previousCache;
+}
@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for inline assembly snippets of the legacy code generator.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace solidity::yul
+{
+struct AsmAnalysisInfo;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Parsed, analysed and (if requested) optimised inline assembly snippets that the legacy code
+ * generator appends via CompilerContext::appendInlineAssembly(). Many of these snippets are
+ * identical across call sites and contracts, so only the code transform has to run for each use.
+ *
+ * Snippets are keyed by a hash of everything the result depends on except for the source
+ * location they are assigned to, which is applied during code generation instead.
+ * The code stays valid until YulStringRepository::reset() is called.
+ * Not thread-safe, the legacy code generator compiles contracts sequentially.
+ */
+class InlineAssemblyCache
+{
+public:
+	struct Snippet
+	{
+		std::shared_ptr<yul::Block const> code;
+		/// Analysis information of @a code. Code generation only reads it.
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+		/// Code stored as generated source, only set for snippets of utility functions.
+		std::string generatedSource;
+	};
+
+	/// @returns the snippet stored for @a _key or nullptr if there is none.
+	Snippet const* find(util::h256 const& _key) const;
+	Snippet const& store(util::h256 const& _key, Snippet _snippet);
+	size_t size() const { return m_snippets.size(); }
+
+	/// @returns the cache activated for the current thread or nullptr.
+	static InlineAssemblyCache* active();
+
+	/// Activates a cache (which can be nullptr) for the current thread until destruction.
+	class Activation
+	{
+	public:
+		explicit Activation(InlineAssemblyCache* _cache);
+		~Activation();
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		InlineAssemblyCache* m_previousCache = nullptr;
+	};
+
+private:
+	std::map<util::h256, Snippet> m_snippets;
+};
+
+}
@@ -23,9 +23,12 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/Common.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
@@ -33,7 +36,13 @@ using namespace solidity::util;
 
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
-	string result = move(m_code);
+	size_t size = 0;
+	for (string const& function: m_code)
+		size += function.size();
+	string result;
+	result.reserve(size);
+	for (string const& function: m_code)
+		result += function;
 	m_code.clear();
 	m_requestedFunctions.clear();
 	return result;
@@ -41,32 +50,94 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
-		string fun = _creator();
-		solAssert(!fun.empty(), "");
-		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
-		m_code += move(fun);
-	}
-	return _name;
+	return collect(_name, true, _creator);
 }
 
 string MultiUseYulFunctionCollector::createFunction(
 	string const& _name,
 	function<string(vector<string>&, vector<string>&)> const& _creator
 )
+{
+	return collect(_name, true, renderer(_name, _creator));
+}
+
+string MultiUseYulFunctionCollector::createContextDependentFunction(string const& _name, function<string ()> const& _creator)
+{
+	return collect(_name, false, _creator);
+}
+
+string MultiUseYulFunctionCollector::createContextDependentFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return collect(_name, false, renderer(_name, _creator));
+}
+
+string MultiUseYulFunctionCollector::collect(string const& _name, bool _shared, function<string()> const& _creator)
 {
 	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
+	if (!m_dependencies.empty())
+		m_dependencies.back().emplace_back(_name);
+	if (m_requestedFunctions.count(_name))
+		return _name;
+
+	YulFunctionCache* cache = _shared ? YulFunctionCache::active() : nullptr;
+	if (cache)
+		if (shared_ptr<YulFunctionCache::Function const> function = cache->find(_name))
+		{
+			addCachedFunction(*cache, _name, *function);
+			return _name;
+		}
+
+	m_requestedFunctions.insert(_name);
+	m_dependencies.emplace_back();
+	ScopeGuard popDependencies([&]() { m_dependencies.pop_back(); });
+	string fun = _creator();
+	solAssert(!fun.empty(), "");
+	solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+
+	// The function can only be restored from the cache if all its dependencies can be restored as well.
+	if (cache && all_of(
+		m_dependencies.back().begin(),
+		m_dependencies.back().end(),
+		[&](string const& _dependency) { return _dependency == _name || cache->find(_dependency); }
+	))
+		cache->store(_name, make_shared<YulFunctionCache::Function const>(YulFunctionCache::Function{fun, m_dependencies.back()}));
+
+	m_code.emplace_back(move(fun));
+	return _name;
+}
+
+void MultiUseYulFunctionCollector::addCachedFunction(
+	YulFunctionCache const& _cache,
+	string const& _name,
+	YulFunctionCache::Function const& _function
+)
+{
+	m_requestedFunctions.insert(_name);
+	for (string const& dependency: _function.dependencies)
+		if (!m_requestedFunctions.count(dependency))
+		{
+			shared_ptr<YulFunctionCache::Function const> dependencyFunction = _cache.find(dependency);
+			solAssert(dependencyFunction, "");
+			addCachedFunction(_cache, dependency, *dependencyFunction);
+		}
+	m_code.emplace_back(_function.code);
+}
+
+function<string()> MultiUseYulFunctionCollector::renderer(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return [&_name, &_creator]() {
 		vector<string> arguments;
 		vector<string> returnParameters;
 		string body = _creator(arguments, returnParameters);
 		solAssert(!body.empty(), "");
 
-		m_code += Whiskers(R"(
+		return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
@@ -74,8 +145,7 @@ string MultiUseYulFunctionCollector::createFunction(
 		("functionName", _name)
 		("args", joinHumanReadable(arguments))
 		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
+		("body", move(body))
 		.render();
-	}
-	return _name;
+	};
 }
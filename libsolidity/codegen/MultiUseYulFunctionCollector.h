@@ -22,10 +22,13 @@
 
 #pragma once
 
+#include <libsolidity/codegen/YulFunctionCache.h>
+
 #include <functional>
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -40,6 +43,8 @@ public:
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
+	/// The function is taken from the active YulFunctionCache if it is stored there and
+	/// stored in it otherwise, so its code must only depend on its name.
 	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
 
 	std::string createFunction(
@@ -47,6 +52,15 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Same as createFunction, but for functions whose code depends on more than their name,
+	/// e.g. on the AST or the state of the code generator. These are never shared via the YulFunctionCache.
+	std::string createContextDependentFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createContextDependentFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -57,8 +71,20 @@ public:
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
 private:
+	std::string collect(std::string const& _name, bool _shared, std::function<std::string()> const& _creator);
+	/// Adds a function taken from @a _cache together with its dependencies that have not been collected yet,
+	/// in the order in which they would have been generated.
+	void addCachedFunction(YulFunctionCache const& _cache, std::string const& _name, YulFunctionCache::Function const& _function);
+	static std::function<std::string()> renderer(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	std::set<std::string> m_requestedFunctions;
-	std::string m_code;
+	/// The code of the generated functions. Kept in separate strings, so that every function
+	/// is only copied once more, when they are all joined by `requestedFunctions`.
+	std::vector<std::string> m_code;
+	/// Names of the functions requested by the functions that are currently being generated, innermost last.
+	std::vector<std::vector<std::string>> m_dependencies;
 };
-
 }
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for Yul utility functions shared by all contracts of a compilation.
+ */
+
+#include <libsolidity/codegen/YulFunctionCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+thread_local YulFunctionCache* t_activeCache = nullptr;
+
+}
+
+shared_ptr<YulFunctionCache::Function const> YulFunctionCache::find(string const& _name) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_functions.find(_name);
+	return it != m_functions.end() ? it->second : nullptr;
+}
+
+void YulFunctionCache::store(string const& _name, shared_ptr<Function const> _function)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_functions.emplace(_name, std::move(_function));
+}
+
+size_t YulFunctionCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_functions.size();
+}
+
+YulFunctionCache* YulFunctionCache::active()
+{
+	return t_activeCache;
+}
+
+YulFunctionCache::Activation::Activation(YulFunctionCache* _cache):
+	m_previousCache(t_activeCache)
+{
+	t_activeCache = _cache;
+}
+
+YulFunctionCache::Activation::~Activation()
+{
+	t_activeCache = m_previousCache;
+}
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for Yul utility functions shared by all contracts of a compilation.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Yul utility functions (from YulUtilFunctions and ABIFunctions) that have been generated
+ * during a compilation, keyed by their name.
+ *
+ * Every contract requests the same helper functions (e.g. ABI decoders, checked arithmetic),
+ * so MultiUseYulFunctionCollector takes them from the cache activated for the current thread
+ * using YulFunctionCache::Activation instead of generating them again for every contract.
+ *
+ * Apart from their name, the code of these functions depends on the settings of the compilation,
+ * i.e. the EVM version, the revert strings setting, the experimental optimisations and the ABI
+ * decoder mode. A cache may only be shared by code generated with the same settings, which holds
+ * for all contracts compiled by one CompilerStack. Access is thread-safe.
+ */
+class YulFunctionCache
+{
+public:
+	struct Function
+	{
+		std::string code;
+		/// Names of the functions that were requested while generating the function,
+		/// in the order in which they were requested.
+		std::vector<std::string> dependencies;
+	};
+
+	/// @returns the function stored under @a _name or nullptr if there is none.
+	std::shared_ptr<Function const> find(std::string const& _name) const;
+	void store(std::string const& _name, std::shared_ptr<Function const> _function);
+	size_t size() const;
+
+	/// @returns the cache activated for the current thread or nullptr.
+	static YulFunctionCache* active();
+
+	/// Activates a cache (which can be nullptr) for the current thread until destruction.
+	class Activation
+	{
+	public:
+		explicit Activation(YulFunctionCache* _cache);
+		~Activation();
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		YulFunctionCache* m_previousCache = nullptr;
+	};
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, std::shared_ptr<Function const>> m_functions;
+};
+
+}
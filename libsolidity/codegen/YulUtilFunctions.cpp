@@ -98,8 +98,20 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 		}
 		else
 		{
+			optional<size_t> threshold;
+			if (runExperimental(ExperimentalOptimisation::IdentityPrecompileCopy))
+				threshold = CompilerUtils::identityPrecompileCopyThreshold(m_evmVersion);
 			return Whiskers(R"(
 				function <functionName>(src, dst, length) {
+					<?useIdentity>
+					if iszero(lt(length, <threshold>)) {
+						if staticcall(gas(), 4, src, length, dst, length) {
+							// clear end like the loop below
+							if and(length, 31) { mstore(add(dst, length), 0) }
+							leave
+						}
+					}
+					</useIdentity>
 					let i := 0
 					for { } lt(i, length) { i := add(i, 32) }
 					{
@@ -113,6 +125,8 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata)
 				}
 			)")
 			("functionName", functionName)
+			("useIdentity", threshold.has_value())
+			("threshold", threshold ? to_string(*threshold) : "")
 			.render();
 		}
 	});
@@ -230,34 +244,82 @@ string YulUtilFunctions::requireOrAssertFunction(bool _assert, Type const* _mess
 			("functionName", functionName)
 			.render();
 
-		int const hashHeaderSize = 4;
-		u256 const errorHash = util::selectorFromSignature("Error(string)");
-
-		string const encodeFunc = ABIFunctions(m_evmVersion, m_revertStrings, m_functionCollector)
-			.tupleEncoder(
+		if (!runExperimental(ExperimentalOptimisation::SharedReverts))
+			return Whiskers(R"(
+				function <functionName>(condition <messageVars>) {
+					if iszero(condition) {
+						let memPtr := <allocateUnbounded>()
+						mstore(memPtr, <errorHash>)
+						let end := <abiEncodeFunc>(add(memPtr, 4) <messageVars>)
+						revert(memPtr, sub(end, memPtr))
+					}
+				}
+			)")
+			("functionName", functionName)
+			("allocateUnbounded", allocateUnboundedFunction())
+			("errorHash", formatNumber(util::selectorFromSignature("Error(string)")))
+			("abiEncodeFunc", ABIFunctions(m_evmVersion, m_revertStrings, m_functionCollector).tupleEncoder(
 				{_messageType},
 				{TypeProvider::stringMemory()}
-			);
+			))
+			("messageVars",
+				(_messageType->sizeOnStack() > 0 ? ", " : "") +
+				suffixedVariableNameList("message_", 1, 1 + _messageType->sizeOnStack())
+			)
+			.render();
 
+		string const messageVars = suffixedVariableNameList("message_", 1, 1 + _messageType->sizeOnStack());
 		return Whiskers(R"(
-			function <functionName>(condition <messageVars>) {
+			function <functionName>(condition <?+messageVars>, <messageVars></+messageVars>) {
 				if iszero(condition) {
-					let memPtr := <allocateUnbounded>()
-					mstore(memPtr, <errorHash>)
-					let end := <abiEncodeFunc>(add(memPtr, <hashHeaderSize>) <messageVars>)
-					revert(memPtr, sub(end, memPtr))
+					<revertWithError>(<messageVars>)
 				}
 			}
 		)")
 		("functionName", functionName)
+		("revertWithError", revertWithErrorFunction("Error(string)", {TypeProvider::stringMemory()}, {_messageType}))
+		("messageVars", messageVars)
+		.render();
+	});
+}
+
+string YulUtilFunctions::revertWithErrorFunction(
+	string const& _signature,
+	vector<Type const*> const& _parameterTypes,
+	vector<Type const*> const& _argumentTypes
+)
+{
+	// The function only depends on the error and the types, so all reverts with
+	// the same error, e.g. with the same reason string, share it.
+	string functionName = "revert_with_error_" + util::FixedHash<4>(util::keccak256(_signature)).hex();
+	for (Type const* type: _argumentTypes)
+		functionName += "_" + type->identifier();
+	functionName += "_to";
+	for (Type const* type: _parameterTypes)
+		functionName += "_" + type->identifier();
+
+	return m_functionCollector.createFunction(functionName, [&]() {
+		size_t argumentSlots = 0;
+		for (Type const* type: _argumentTypes)
+			argumentSlots += type->sizeOnStack();
+		string const arguments = suffixedVariableNameList("arg_", 0, argumentSlots);
+
+		return Whiskers(R"(
+			function <functionName>(<arguments>) {
+				let memPtr := <allocateUnbounded>()
+				mstore(memPtr, <errorHash>)
+				let end := <abiEncodeFunc>(add(memPtr, 4) <?+arguments>, <arguments></+arguments>)
+				revert(memPtr, sub(end, memPtr))
+			}
+		)")
+		("functionName", functionName)
+		("arguments", arguments)
 		("allocateUnbounded", allocateUnboundedFunction())
-		("errorHash", formatNumber(errorHash))
-		("abiEncodeFunc", encodeFunc)
-		("hashHeaderSize", to_string(hashHeaderSize))
-		("messageVars",
-			(_messageType->sizeOnStack() > 0 ? ", " : "") +
-			suffixedVariableNameList("message_", 1, 1 + _messageType->sizeOnStack())
-		)
+		("errorHash", formatNumber(util::selectorFromSignature(_signature)))
+		("abiEncodeFunc", ABIFunctions(m_evmVersion, m_revertStrings, m_functionCollector).tupleEncoder(
+			_argumentTypes,
+			_parameterTypes
+		))
 		.render();
 	});
 }
@@ -1799,6 +1861,12 @@ string YulUtilFunctions::copyArrayToStorageFunction(ArrayType const& _fromType,
 		return copyByteArrayToStorageFunction(_fromType, _toType);
 	if (_fromType.dataStoredIn(DataLocation::Storage) && _toType.baseType()->isValueType())
 		return copyValueArrayStorageToStorageFunction(_fromType, _toType);
+	if (
+		runExperimental(ExperimentalOptimisation::PackedArrayCopy) &&
+		_toType.baseType()->isValueType() &&
+		_toType.storageStride() <= 16
+	)
+		return copyPackedValueArrayToStorageFunction(_fromType, _toType);
 
 	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
 	return m_functionCollector.createFunction(functionName, [&](){
@@ -1974,6 +2042,68 @@ string YulUtilFunctions::copyByteArrayToStorageFunction(ArrayType const& _fromTy
 }
 
 
+string YulUtilFunctions::copyPackedValueArrayToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType)
+{
+	solAssert(_fromType.baseType()->isValueType());
+	solAssert(*_fromType.baseType() == *_toType.baseType());
+	solAssert(!_fromType.isByteArrayOrString());
+	solAssert(!_fromType.dataStoredIn(DataLocation::Storage));
+	solAssert(_toType.dataStoredIn(DataLocation::Storage));
+	solAssert(_toType.storageStride() <= 16);
+
+	string functionName = "copy_array_to_storage_from_" + _fromType.identifier() + "_to_" + _toType.identifier();
+	return m_functionCollector.createFunction(functionName, [&](){
+		Whiskers templ(R"(
+			function <functionName>(slot, value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>) {
+				let length := <arrayLength>(value<?isFromDynamicCalldata>, len</isFromDynamicCalldata>)
+
+				<resizeArray>(slot, length)
+
+				let srcPtr := <srcDataLocation>(value)
+				let dstSlot := <dstDataLocation>(slot)
+
+				// Assemble the value of each slot on the stack and store it at once.
+				let fullSlots := div(length, <itemsPerSlot>)
+				for { let i := 0 } lt(i, fullSlots) { i := add(i, 1) } {
+					let dstSlotValue := 0
+					for { let j := 0 } lt(j, <itemsPerSlot>) { j := add(j, 1) } {
+						let itemValue := <prepareStore>(<read>(srcPtr))
+						dstSlotValue := <updateByteSlice>(dstSlotValue, mul(<storageStride>, j), itemValue)
+						srcPtr := add(srcPtr, <srcStride>)
+					}
+					sstore(add(dstSlot, i), dstSlotValue)
+				}
+
+				// The unused part of the last slot is cleared, as it is beyond the end of the array.
+				let spill := sub(length, mul(fullSlots, <itemsPerSlot>))
+				if spill {
+					let dstSlotValue := 0
+					for { let j := 0 } lt(j, spill) { j := add(j, 1) } {
+						let itemValue := <prepareStore>(<read>(srcPtr))
+						dstSlotValue := <updateByteSlice>(dstSlotValue, mul(<storageStride>, j), itemValue)
+						srcPtr := add(srcPtr, <srcStride>)
+					}
+					sstore(add(dstSlot, fullSlots), dstSlotValue)
+				}
+			}
+		)");
+		templ("functionName", functionName);
+		bool fromCalldata = _fromType.dataStoredIn(DataLocation::CallData);
+		templ("isFromDynamicCalldata", _fromType.isDynamicallySized() && fromCalldata);
+		templ("arrayLength", arrayLengthFunction(_fromType));
+		templ("resizeArray", resizeArrayFunction(_toType));
+		templ("srcDataLocation", arrayDataAreaFunction(_fromType));
+		templ("dstDataLocation", arrayDataAreaFunction(_toType));
+		templ("itemsPerSlot", to_string(32 / _toType.storageStride()));
+		templ("storageStride", to_string(_toType.storageStride()));
+		templ("srcStride", to_string(fromCalldata ? _fromType.calldataStride() : _fromType.memoryStride()));
+		templ("read", readFromMemoryOrCalldata(*_fromType.baseType(), fromCalldata));
+		templ("prepareStore", prepareStoreFunction(*_toType.baseType()));
+		templ("updateByteSlice", updateByteSliceFunctionDynamic(_toType.storageStride()));
+		return templ.render();
+	});
+}
+
 string YulUtilFunctions::copyValueArrayStorageToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType)
 {
 	solAssert(_fromType.baseType()->isValueType(), "");
@@ -3552,15 +3682,16 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 		MemberList::MemberMap structMembers = _from.nativeMembers(nullptr);
 		MemberList::MemberMap toStructMembers = _to.nativeMembers(nullptr);
 
-		vector<map<string, string>> memberParams(structMembers.size());
-		for (size_t i = 0; i < structMembers.size(); ++i)
+		// Value type members that share a storage slot are written with a single sload / sstore
+		// pair. @a _batched means that the member is merged into the variable `slotValue`.
+		auto updateMember = [&](size_t i, bool _batched) -> string
 		{
 			Type const& memberType = *structMembers[i].type;
 			solAssert(memberType.memoryHeadSize() == 32, "");
 			auto const&[slotDiff, offset] = _to.storageOffsetsOfMember(structMembers[i].name);
 
 			Whiskers t(R"(
-				let memberSlot := add(slot, <memberStorageSlotDiff>)
+				<?batched><!batched>let memberSlot := add(slot, <memberStorageSlotDiff>)</batched>
 				let memberSrcPtr := add(value, <memberOffset>)
 
 				<?fromCalldata>
@@ -3589,8 +3720,9 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 						</isValueType>
 				</fromStorage>
 
-				<updateStorageValue>(memberSlot, <memberValues>)
+				<?batched>slotValue := <update>(slotValue, <prepare>(<convert>(<memberValues>)))<!batched><updateStorageValue>(memberSlot, <memberValues>)</batched>
 			)");
+			t("batched", _batched);
 			bool fromCalldata = _from.location() == DataLocation::CallData;
 			t("fromCalldata", fromCalldata);
 			bool fromMemory = _from.location() == DataLocation::Memory;
@@ -3625,12 +3757,48 @@ string YulUtilFunctions::copyStructToStorageFunction(StructType const& _from, St
 					solAssert(srcOffset == 0, "");
 
 			}
-			t("updateStorageValue", updateStorageValueFunction(
-				memberType,
-				*toStructMembers[i].type,
-				optional<unsigned>{offset}
-			));
-			memberParams[i]["updateMemberCall"] = t.render();
+			if (_batched)
+			{
+				Type const& toMemberType = *toStructMembers[i].type;
+				t("update", updateByteSliceFunction(toMemberType.storageBytes(), offset));
+				t("prepare", prepareStoreFunction(toMemberType));
+				t("convert", conversionFunction(memberType, toMemberType));
+			}
+			else
+				t("updateStorageValue", updateStorageValueFunction(
+					memberType,
+					*toStructMembers[i].type,
+					optional<unsigned>{offset}
+				));
+			return t.render();
+		};
+
+		vector<map<string, string>> memberParams;
+		for (size_t i = 0; i < structMembers.size();)
+		{
+			// Find the run of value type members stored in the same slot as member i.
+			u256 slotDiff = _to.storageOffsetsOfMember(structMembers[i].name).first;
+			size_t end = i + 1;
+			if (runExperimental(ExperimentalOptimisation::PackedStructCopy) && structMembers[i].type->isValueType())
+				while (
+					end < structMembers.size() &&
+					structMembers[end].type->isValueType() &&
+					_to.storageOffsetsOfMember(structMembers[end].name).first == slotDiff
+				)
+					++end;
+
+			memberParams.emplace_back();
+			if (end - i == 1)
+				memberParams.back()["updateMemberCall"] = updateMember(i, false);
+			else
+			{
+				string code = "let slotValue := sload(add(slot, " + slotDiff.str() + "))\n";
+				for (size_t j = i; j < end; ++j)
+					code += "{\n" + updateMember(j, true) + "\n}\n";
+				code += "sstore(add(slot, " + slotDiff.str() + "), slotValue)";
+				memberParams.back()["updateMemberCall"] = move(code);
+			}
+			i = end;
 		}
 		templ("member", memberParams);
 
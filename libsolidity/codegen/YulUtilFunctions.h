@@ -27,10 +27,12 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <libsolidity/interface/DebugSettings.h>
+#include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libsolutil/ErrorCodes.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -52,11 +54,13 @@ public:
 	explicit YulUtilFunctions(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		MultiUseYulFunctionCollector& _functionCollector
+		MultiUseYulFunctionCollector& _functionCollector,
+		std::set<ExperimentalOptimisation> _experimentalOptimisations = {}
 	):
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
-		m_functionCollector(_functionCollector)
+		m_functionCollector(_functionCollector),
+		m_experimentalOptimisations(std::move(_experimentalOptimisations))
 	{}
 
 	/// @returns the name of a function that returns its argument.
@@ -93,6 +97,15 @@ public:
 	// `assert` or `require` call.
 	std::string requireOrAssertFunction(bool _assert, Type const* _messageType = nullptr);
 
+	/// @returns the name of a function that reverts with the error of signature @a _signature,
+	/// ABI-encoding arguments of types @a _argumentTypes as @a _parameterTypes.
+	/// signature: (arguments) ->
+	std::string revertWithErrorFunction(
+		std::string const& _signature,
+		std::vector<Type const*> const& _parameterTypes,
+		std::vector<Type const*> const& _argumentTypes
+	);
+
 	/// @returns the name of a function that takes a (cleaned) value of the given value type and
 	/// left-aligns it, usually for use in non-padded encoding.
 	std::string leftAlignFunction(Type const& _type);
@@ -262,6 +275,11 @@ public:
 	/// signature (to_slot, from_slot) ->
 	std::string copyValueArrayStorageToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
 
+	/// @returns the name of a function that will copy an array of value types that are packed
+	/// into storage slots from memory or calldata to storage, writing each slot only once.
+	/// signature (to_slot, from_ptr) ->
+	std::string copyPackedValueArrayToStorageFunction(ArrayType const& _fromType, ArrayType const& _toType);
+
 	/// Returns the name of a function that will convert a given length to the
 	/// size in memory (number of storage slots or calldata/memory bytes) it
 	/// will require.
@@ -602,9 +620,16 @@ private:
 	/// signature: (array, index)
 	std::string longByteArrayStorageIndexAccessNoCheckFunction();
 
+	bool runExperimental(ExperimentalOptimisation _optimisation) const
+	{
+		return m_experimentalOptimisations.count(_optimisation) > 0;
+	}
+
 	langutil::EVMVersion m_evmVersion;
 	RevertStrings m_revertStrings;
 	MultiUseYulFunctionCollector& m_functionCollector;
+	/// Experimental optimisations that change the generated functions.
+	std::set<ExperimentalOptimisation> m_experimentalOptimisations;
 };
 
 }
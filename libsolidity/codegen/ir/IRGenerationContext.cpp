@@ -62,6 +62,13 @@ ContractDefinition const& IRGenerationContext::mostDerivedContract() const
 	return *m_mostDerivedContract;
 }
 
+bool IRGenerationContext::allocatesOnlyTemporaryMemory(FunctionDefinition const& _function)
+{
+	if (!m_memoryEscapeAnalysis)
+		m_memoryEscapeAnalysis = make_unique<MemoryEscapeAnalysis>(mostDerivedContract());
+	return m_memoryEscapeAnalysis->allocatesOnlyTemporaryMemory(_function);
+}
+
 IRVariable const& IRGenerationContext::addLocalVariable(VariableDeclaration const& _varDecl)
 {
 	auto const& [it, didInsert] = m_localVariables.emplace(
@@ -170,12 +177,12 @@ void IRGenerationContext::internalFunctionCalledThroughDispatch(YulArity const&
 
 YulUtilFunctions IRGenerationContext::utils()
 {
-	return YulUtilFunctions(m_evmVersion, m_revertStrings, m_functions);
+	return YulUtilFunctions(m_evmVersion, m_revertStrings, m_functions, m_optimiserSettings.experimentalOptimisations);
 }
 
 ABIFunctions IRGenerationContext::abiFunctions()
 {
-	return ABIFunctions(m_evmVersion, m_revertStrings, m_functions);
+	return ABIFunctions(m_evmVersion, m_revertStrings, m_functions, m_abiDecoderMode);
 }
 
 uint64_t IRGenerationContext::internalFunctionID(FunctionDefinition const& _function, bool _requirePresent)
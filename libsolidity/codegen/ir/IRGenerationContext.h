@@ -23,11 +23,13 @@
 
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/codegen/ir/IRVariable.h>
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 #include <libsolidity/codegen/ir/Common.h>
+#include <libsolidity/codegen/ir/MemoryEscapeAnalysis.h>
 
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/DebugInfoSelection.h>
@@ -73,6 +75,7 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExecutionContext _executionContext,
 		RevertStrings _revertStrings,
+		ABIDecoderMode _abiDecoderMode,
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
@@ -81,6 +84,7 @@ public:
 		m_evmVersion(_evmVersion),
 		m_executionContext(_executionContext),
 		m_revertStrings(_revertStrings),
+		m_abiDecoderMode(_abiDecoderMode),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_sourceIndices(std::move(_sourceIndices)),
 		m_debugInfoSelection(_debugInfoSelection),
@@ -102,9 +106,14 @@ public:
 	void setMostDerivedContract(ContractDefinition const& _mostDerivedContract)
 	{
 		m_mostDerivedContract = &_mostDerivedContract;
+		m_memoryEscapeAnalysis.reset();
 	}
 	ContractDefinition const& mostDerivedContract() const;
 
+	/// @returns true if a direct call to @a _function may allocate memory and all of it
+	/// can be released once the call returns.
+	bool allocatesOnlyTemporaryMemory(FunctionDefinition const& _function);
+
 
 	IRVariable const& addLocalVariable(VariableDeclaration const& _varDecl);
 	bool isLocalVariable(VariableDeclaration const& _varDecl) const { return m_localVariables.count(&_varDecl); }
@@ -157,6 +166,8 @@ public:
 	ABIFunctions abiFunctions();
 
 	RevertStrings revertStrings() const { return m_revertStrings; }
+	ABIDecoderMode abiDecoderMode() const { return m_abiDecoderMode; }
+	OptimiserSettings const& optimiserSettings() const { return m_optimiserSettings; }
 
 	std::set<ContractDefinition const*, ASTNode::CompareByID>& subObjectsCreated() { return m_subObjects; }
 
@@ -184,10 +195,12 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	ExecutionContext m_executionContext;
 	RevertStrings m_revertStrings;
+	ABIDecoderMode m_abiDecoderMode;
 	OptimiserSettings m_optimiserSettings;
 	std::map<std::string, unsigned> m_sourceIndices;
 	std::set<std::string> m_usedSourceNames;
 	ContractDefinition const* m_mostDerivedContract = nullptr;
+	std::unique_ptr<MemoryEscapeAnalysis> m_memoryEscapeAnalysis;
 	std::map<VariableDeclaration const*, IRVariable> m_localVariables;
 	/// Memory offsets reserved for the values of immutable variables during contract creation.
 	/// This map is empty in the runtime context.
@@ -30,7 +30,9 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libyul/ObjectParser.h>
 #include <libyul/YulStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/Algorithms.h>
@@ -38,6 +40,9 @@
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/Whiskers.h>
 
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <sstream>
@@ -85,54 +90,235 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+// Placeholders for the code of the sub-objects in the generated code. They cannot occur in
+// any other part of the code, since control characters are escaped in comments and literals.
+string const creationSubObjectsPlaceholder = "\x01subObjects\x01";
+string const deployedSubObjectsPlaceholder = "\x01" "deployedSubObjects\x01";
+
+void replacePlaceholder(string& _code, string const& _placeholder, string_view _replacement)
+{
+	size_t position = _code.find(_placeholder);
+	solAssert(position != string::npos, "");
+	solAssert(_code.find(_placeholder, position + _placeholder.size()) == string::npos, "");
+	_code.replace(position, _placeholder.size(), _replacement);
 }
 
-pair<string, string> IRGenerator::run(
-	ContractDefinition const& _contract,
-	bytes const& _cborMetadata,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+/// Inserts copies of the given objects into @a _container before its existing sub-objects
+/// (or after them, if @a _append is set) and updates the name index.
+void insertSubObjects(
+	yul::Object& _container,
+	set<ContractDefinition const*, ASTNode::CompareByID> const& _contracts,
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> const& _objects,
+	bool _append
 )
 {
-	string ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	vector<shared_ptr<yul::ObjectNode>> copies;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		shared_ptr<yul::Object const> const& object = _objects.at(contract);
+		solAssert(object, "");
+		copies.emplace_back(object->structuralClone());
+	}
+	if (_append)
+		_container.subObjects += move(copies);
+	else
+		_container.subObjects = move(copies) + move(_container.subObjects);
 
-	yul::YulStack asmStack(
-		m_evmVersion,
-		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
-		m_context.debugInfoSelection()
-	);
-	if (!asmStack.parseAndAnalyze("", ir))
+	_container.subIndexByName.clear();
+	for (size_t i = 0; i < _container.subObjects.size(); ++i)
+		_container.subIndexByName[_container.subObjects[i]->name] = i;
+}
+
+/// @returns code that calls the function in @a _cases whose selector equals the variable `selector`.
+/// The cases have to be sorted by selector. If @a _split is set, they are split in halves around
+/// a pivot as long as this is profitable for @a _runs executions of the contract.
+/// The cases of each switch are ordered by decreasing number of executions in @a _profile,
+/// so that frequently called functions are compared first.
+string selectorSwitch(
+	vector<map<string, string>> _cases,
+	bool _split,
+	size_t _runs,
+	map<string, size_t> const& _profile
+)
+{
+	if (_split && CompilerUtils::splitFunctionDispatch(_cases.size(), _runs))
 	{
-		string errorMessage;
-		for (auto const& error: asmStack.errors())
-			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(
-				*error,
-				asmStack.charStream("")
-			);
-		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+		auto pivot = _cases.begin() + static_cast<ptrdiff_t>(_cases.size() / 2);
+		return Whiskers(R"(switch lt(selector, <pivot>)
+			case 0 {
+				<larger>
+			}
+			default {
+				<smaller>
+			})")
+		("pivot", pivot->at("functionSelector"))
+		("larger", selectorSwitch({pivot, _cases.end()}, _split, _runs, _profile))
+		("smaller", selectorSwitch({_cases.begin(), pivot}, _split, _runs, _profile))
+		.render();
 	}
-	asmStack.optimize();
+	if (!_profile.empty())
+		stable_sort(_cases.begin(), _cases.end(), [&](map<string, string> const& _a, map<string, string> const& _b) {
+			return
+				valueOrDefault(_profile, _a.at("functionSelector"), size_t(0)) >
+				valueOrDefault(_profile, _b.at("functionSelector"), size_t(0));
+		});
+	return Whiskers(R"(switch selector
+		<#cases>
+		case <functionSelector>
+		{
+			// <functionName>
+			<delegatecallCheck>
+			<externalFunction>()
+		}
+		</cases>
+		default {})")
+	("cases", _cases)
+	.render();
+}
 
-	return {move(ir), asmStack.print(m_context.soliditySourceProvider())};
+/// @returns code that assigns the result of calling the function in @a _cases whose ID equals the
+/// variable `fun` to @a _out, or calls @a _panic if there is no such function. The cases have to be
+/// sorted by ID. If @a _split is set, they are split like in selectorSwitch.
+string internalDispatchSwitch(
+	vector<map<string, string>> const& _cases,
+	string const& _in,
+	string const& _out,
+	string const& _panic,
+	bool _split,
+	size_t _runs
+)
+{
+	if (_split && CompilerUtils::splitFunctionDispatch(_cases.size(), _runs))
+	{
+		auto pivot = _cases.begin() + static_cast<ptrdiff_t>(_cases.size() / 2);
+		return Whiskers(R"(switch lt(fun, <pivot>)
+			case 0 {
+				<larger>
+			}
+			default {
+				<smaller>
+			})")
+		("pivot", pivot->at("funID"))
+		("larger", internalDispatchSwitch({pivot, _cases.end()}, _in, _out, _panic, _split, _runs))
+		("smaller", internalDispatchSwitch({_cases.begin(), pivot}, _in, _out, _panic, _split, _runs))
+		.render();
+	}
+	return Whiskers(R"(switch fun
+		<#cases>
+		case <funID>
+		{
+			<?+out> <out> :=</+out> <name>(<in>)
+		}
+		</cases>
+		default { <panic>() })")
+	("cases", _cases)
+	("in", _in)
+	("out", _out)
+	("panic", _panic)
+	.render();
 }
 
-string IRGenerator::generate(
+/// @returns the number of executions per deployment the optimiser assumes for the code of
+/// @a _function according to its optimizer hint, if it has one.
+/// ``optimize-size`` optimises for a single execution, ``optimize-speed`` for at least
+/// @a speedExecutions and ``no-inlining`` prevents inlining into the function.
+optional<size_t> annotatedExecutions(FunctionDefinition const& _function, size_t _runs)
+{
+	using OptimizerHint = FunctionDefinitionAnnotation::OptimizerHint;
+	size_t constexpr speedExecutions = 10000;
+	if (!_function.annotation().optimizerHint)
+		return nullopt;
+	switch (*_function.annotation().optimizerHint)
+	{
+	case OptimizerHint::Size:
+		return 1;
+	case OptimizerHint::Speed:
+		return max(_runs, speedExecutions);
+	case OptimizerHint::NoInlining:
+		return 0;
+	}
+	solAssert(false, "");
+	return nullopt;
+}
+
+}
+
+tuple<string, shared_ptr<yul::Object const>, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> const& _otherYulObjects,
+	bool _keepUnoptimizedObject,
+	bool _optimize
 )
 {
-	auto subObjectSources = [&_otherYulSources](std::set<ContractDefinition const*, ASTNode::CompareByID> const& subObjects) -> string
+	string code = generate(_contract, _cborMetadata);
+
+	auto subObjectSources = [&_otherYulSources](set<ContractDefinition const*, ASTNode::CompareByID> const& _subObjects)
 	{
-		std::string subObjectsSources;
-		for (ContractDefinition const* subObject: subObjects)
+		string subObjectsSources;
+		for (ContractDefinition const* subObject: _subObjects)
 			subObjectsSources += _otherYulSources.at(subObject);
 		return subObjectsSources;
 	};
+	string ir = code;
+	replacePlaceholder(ir, creationSubObjectsPlaceholder, subObjectSources(m_creationSubObjects));
+	replacePlaceholder(ir, deployedSubObjectsPlaceholder, subObjectSources(m_deployedSubObjects));
+	ir = yul::reindent(ir);
+
+	// Only the code generated for this contract is parsed. The sub-objects have already been
+	// parsed when their own IR was generated and are copied into the parsed object.
+	replacePlaceholder(code, creationSubObjectsPlaceholder, {});
+	replacePlaceholder(code, deployedSubObjectsPlaceholder, {});
+
+	auto const& dialect = yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion);
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(code, "");
+	shared_ptr<yul::Object> object = yul::ObjectParser(errorReporter, dialect).parse(make_shared<Scanner>(charStream), false);
+	auto invalidIR = [&](ErrorList const& _errors)
+	{
+		string errorMessage;
+		for (auto const& error: _errors)
+			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error, charStream);
+		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+	};
+	if (!errors.empty())
+		invalidIR(errors);
+	solAssert(object && object->code, "");
+
+	insertSubObjects(*object, m_creationSubObjects, _otherYulObjects, true);
+	auto deployedObject = dynamic_pointer_cast<yul::Object>(
+		object->subObjects.at(object->subIndexByName.at(yul::YulString(IRNames::deployedObject(_contract))))
+	);
+	solAssert(deployedObject, "");
+	insertSubObjects(*deployedObject, m_deployedSubObjects, _otherYulObjects, false);
+
+	shared_ptr<yul::Object const> unoptimizedObject;
+	if (_keepUnoptimizedObject)
+		unoptimizedObject = object->structuralClone();
+
+	yul::YulStack asmStack(
+		m_evmVersion,
+		yul::YulStack::Language::StrictAssembly,
+		m_optimiserSettings.withFunctionExecutions(m_functionExecutions),
+		m_context.debugInfoSelection()
+	);
+	if (!asmStack.analyzeObject(object))
+		invalidIR(asmStack.errors());
+	if (!_optimize)
+		return {move(ir), move(unoptimizedObject), nullptr};
+	asmStack.optimize();
+
+	return {move(ir), move(unoptimizedObject), asmStack.parserResult()};
+}
+
+string IRGenerator::generate(ContractDefinition const& _contract, bytes const& _cborMetadata)
+{
 	auto formatUseSrcMap = [](IRGenerationContext const& _context) -> string
 	{
 		return joinHumanReadable(
-			ranges::views::transform(_context.usedSourceNames(), [_context](string const& _sourceName) {
+			ranges::views::transform(_context.usedSourceNames(), [&_context](string const& _sourceName) {
 				return to_string(_context.sourceIndices().at(_sourceName)) + ":" + escapeAndQuoteString(_sourceName);
 			}),
 			", "
@@ -202,7 +388,8 @@ string IRGenerator::generate(
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions(_contract);
 
 	t("functions", m_context.functionCollector().requestedFunctions());
-	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	m_creationSubObjects = m_context.subObjectsCreated();
+	t("subObjects", creationSubObjectsPlaceholder);
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesMemoryUnsafeAssembly = m_context.memoryUnsafeInlineAssemblySeen();
@@ -224,7 +411,8 @@ string IRGenerator::generate(
 	set<FunctionDefinition const*> deployedFunctionList = generateQueuedFunctions();
 	generateInternalDispatchFunctions(_contract);
 	t("deployedFunctions", m_context.functionCollector().requestedFunctions());
-	t("deployedSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	m_deployedSubObjects = m_context.subObjectsCreated();
+	t("deployedSubObjects", deployedSubObjectsPlaceholder);
 	t("metadataName", yul::Object::metadataName());
 	t("cborMetadata", util::toHex(_cborMetadata));
 
@@ -277,26 +465,20 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 	for (YulArity const& arity: internalDispatchMap | ranges::views::keys)
 	{
 		string funName = IRNames::internalDispatch(arity);
-		m_context.functionCollector().createFunction(funName, [&]() {
+		m_context.functionCollector().createContextDependentFunction(funName, [&]() {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
-					switch fun
-					<#cases>
-					case <funID>
-					{
-						<?+out> <out> :=</+out> <name>(<in>)
-					}
-					</cases>
-					default { <panic>() }
+					<dispatch>
 				}
 				<sourceLocationComment>
 			)");
 			templ("sourceLocationComment", dispenseLocationComment(_contract));
 			templ("functionName", funName);
-			templ("panic", m_utils.panicFunction(PanicCode::InvalidInternalFunction));
-			templ("in", suffixedVariableNameList("in_", 0, arity.in));
-			templ("out", suffixedVariableNameList("out_", 0, arity.out));
+			string in = suffixedVariableNameList("in_", 0, arity.in);
+			string out = suffixedVariableNameList("out_", 0, arity.out);
+			templ("in", in);
+			templ("out", out);
 
 			vector<map<string, string>> cases;
 			for (FunctionDefinition const* function: internalDispatchMap.at(arity))
@@ -317,7 +499,20 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 				});
 			}
 
-			templ("cases", move(cases));
+			bool const split = m_optimiserSettings.functionDispatch == FunctionDispatch::BinarySearch;
+			// Function IDs are assigned in order of first use, which need not be the order of the set.
+			if (split)
+				sort(cases.begin(), cases.end(), [](map<string, string> const& _a, map<string, string> const& _b) {
+					return stoull(_a.at("funID")) < stoull(_b.at("funID"));
+				});
+			templ("dispatch", internalDispatchSwitch(
+				cases,
+				in,
+				out,
+				m_utils.panicFunction(PanicCode::InvalidInternalFunction),
+				split,
+				m_optimiserSettings.expectedExecutionsPerDeployment
+			));
 			return templ.render();
 		});
 	}
@@ -334,7 +529,13 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::function(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	if (auto executions = annotatedExecutions(_function, m_optimiserSettings.expectedExecutionsPerDeployment))
+	{
+		m_functionExecutions[functionName] = *executions;
+		if (!_function.modifiers().empty())
+			m_functionExecutions[IRNames::functionWithModifierInner(_function)] = *executions;
+	}
+	return m_context.functionCollector().createContextDependentFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -405,7 +606,7 @@ string IRGenerator::generateModifier(
 )
 {
 	string functionName = IRNames::modifierInvocation(_modifierInvocation);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContextDependentFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -497,7 +698,7 @@ string IRGenerator::generateModifier(
 string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::functionWithModifierInner(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContextDependentFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<sourceLocationComment>
@@ -537,7 +738,7 @@ string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const&
 string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 {
 	string functionName = IRNames::function(_varDecl);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContextDependentFunction(functionName, [&]() {
 		Type const* type = _varDecl.annotation().type;
 
 		solAssert(_varDecl.isStateVariable(), "");
@@ -730,7 +931,7 @@ string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 string IRGenerator::generateExternalFunction(ContractDefinition const& _contract, FunctionType const& _functionType)
 {
 	string functionName = IRNames::externalFunctionABIWrapper(_functionType.declaration());
-	return m_context.functionCollector().createFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
+	return m_context.functionCollector().createContextDependentFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
 		Whiskers t(R"X(
 			<callValueCheck>
 			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
@@ -744,7 +945,7 @@ string IRGenerator::generateExternalFunction(ContractDefinition const& _contract
 		unsigned paramVars = make_shared<TupleType>(_functionType.parameterTypes())->sizeOnStack();
 		unsigned retVars = make_shared<TupleType>(_functionType.returnParameterTypes())->sizeOnStack();
 
-		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
+		ABIFunctions abiFunctions = m_context.abiFunctions();
 		t("abiDecode", abiFunctions.tupleDecoder(_functionType.parameterTypes()));
 		t("params",  suffixedVariableNameList("param_", 0, paramVars));
 		t("retParams",  suffixedVariableNameList("ret_", 0, retVars));
@@ -865,7 +1066,7 @@ void IRGenerator::generateConstructors(ContractDefinition const& _contract)
 		baseConstructorParams.erase(contract);
 
 		m_context.resetLocalVariables();
-		m_context.functionCollector().createFunction(IRNames::constructor(*contract), [&]() {
+		m_context.functionCollector().createContextDependentFunction(IRNames::constructor(*contract), [&]() {
 			Whiskers t(R"(
 				<astIDComment><sourceLocationComment>
 				function <functionName>(<params><comma><baseParams>) {
@@ -1000,16 +1201,7 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		<?+cases>if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
-			case <functionSelector>
-			{
-				// <functionName>
-				<delegatecallCheck>
-				<externalFunction>()
-			}
-			</cases>
-			default {}
+			<selectorSwitch>
 		}</+cases>
 		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
 		<fallback>
@@ -1040,6 +1232,13 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		templ["externalFunction"] = generateExternalFunction(_contract, *type);
 	}
 	t("cases", functions);
+	// interfaceFunctions() is ordered by selector, so the cases are sorted.
+	t("selectorSwitch", selectorSwitch(
+		functions,
+		m_optimiserSettings.functionDispatch == FunctionDispatch::BinarySearch,
+		m_optimiserSettings.expectedExecutionsPerDeployment,
+		m_optimiserSettings.executionProfile
+	));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -1111,6 +1310,7 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_evmVersion,
 		_context,
 		m_context.revertStrings(),
+		m_context.abiDecoderMode(),
 		m_optimiserSettings,
 		m_context.sourceIndices(),
 		m_context.debugInfoSelection(),
@@ -32,7 +32,15 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Object;
+}
 
 namespace solidity::frontend
 {
@@ -47,6 +55,7 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
+		ABIDecoderMode _abiDecoderMode,
 		OptimiserSettings _optimiserSettings,
 		std::map<std::string, unsigned> _sourceIndices,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
@@ -58,28 +67,44 @@ public:
 			_evmVersion,
 			ExecutionContext::Creation,
 			_revertStrings,
+			_abiDecoderMode,
 			std::move(_optimiserSettings),
 			std::move(_sourceIndices),
 			_debugInfoSelection,
 			_soliditySourceProvider
 		),
-		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
+		m_utils(
+			_evmVersion,
+			m_context.revertStrings(),
+			m_context.functionCollector(),
+			m_optimiserSettings.experimentalOptimisations
+		)
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates and returns the IR code in unoptimized form, the unoptimized IR as an analyzed
+	/// Yul object (only if @a _keepUnoptimizedObject is set) and the analyzed Yul object after
+	/// running the optimizer on it (if enabled by the optimizer settings; only if @a _optimize is set).
+	/// @param _otherYulSources unoptimized IR code of the contracts that might be created.
+	/// @param _otherYulObjects unoptimized IR of the same contracts as analyzed objects. They are
+	/// copied into the object of @a _contract instead of parsing their code again.
+	std::tuple<std::string, std::shared_ptr<yul::Object const>, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		std::map<ContractDefinition const*, std::shared_ptr<yul::Object const>> const& _otherYulObjects,
+		bool _keepUnoptimizedObject,
+		bool _optimize = true
 	);
 
+	/// @returns the expected number of executions of the Yul functions generated for functions
+	/// with an optimizer hint, available after @a run.
+	std::map<std::string, size_t> const& functionExecutions() const { return m_functionExecutions; }
+
 private:
-	std::string generate(
-		ContractDefinition const& _contract,
-		bytes const& _cborMetadata,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
-	);
+	/// Generates the IR code of @a _contract, with placeholders at the places where the
+	/// code of the sub-objects belongs. The sub-objects are stored in
+	/// m_creationSubObjects and m_deployedSubObjects.
+	std::string generate(ContractDefinition const& _contract, bytes const& _cborMetadata);
 	std::string generate(Block const& _block);
 
 	/// Generates code for all the functions from the function generation queue.
@@ -139,9 +164,14 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Expected executions of Yul functions taken from annotations in the source.
+	std::map<std::string, size_t> m_functionExecutions;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+
+	std::set<ContractDefinition const*, ASTNode::CompareByID> m_creationSubObjects;
+	std::set<ContractDefinition const*, ASTNode::CompareByID> m_deployedSubObjects;
 };
 
 }
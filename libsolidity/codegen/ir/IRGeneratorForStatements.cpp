@@ -344,7 +344,7 @@ string IRGeneratorForStatements::constantValueFunction(VariableDeclaration const
 	try
 	{
 		string functionName = IRNames::constantValueFunction(_constant);
-		return m_context.functionCollector().createFunction(functionName, [&] {
+		return m_context.functionCollector().createContextDependentFunction(functionName, [&] {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>() -> <ret> {
@@ -964,11 +964,24 @@ void IRGeneratorForStatements::endVisit(FunctionCall const& _functionCall)
 		{
 			solAssert(functionDef->isImplemented());
 
+			// Memory that cannot be referenced after the call is released again, so that
+			// repeated calls, e.g. in a loop, do not keep expanding memory.
+			string memoryBefore;
+			if (
+				m_context.optimiserSettings().runExperimental(ExperimentalOptimisation::ReleaseTemporaryMemory) &&
+				m_context.allocatesOnlyTemporaryMemory(*functionDef)
+			)
+			{
+				memoryBefore = m_context.newYulVariable();
+				appendCode() << "let " << memoryBefore << " := " << m_utils.allocateUnboundedFunction() << "()\n";
+			}
 			define(_functionCall) <<
 				m_context.enqueueFunctionForCodeGeneration(*functionDef) <<
 				"(" <<
 				joinHumanReadable(args) <<
 				")\n";
+			if (!memoryBefore.empty())
+				appendCode() << "mstore(" << CompilerUtils::freeMemoryPointer << ", " << memoryBefore << ")\n";
 		}
 		else
 		{
@@ -3297,17 +3310,6 @@ void IRGeneratorForStatements::revertWithError(
 	vector<ASTPointer<Expression const>> const& _errorArguments
 )
 {
-	Whiskers templ(R"({
-		let <pos> := <allocateUnbounded>()
-		mstore(<pos>, <hash>)
-		let <end> := <encode>(add(<pos>, 4) <argumentVars>)
-		revert(<pos>, sub(<end>, <pos>))
-	})");
-	templ("pos", m_context.newYulVariable());
-	templ("end", m_context.newYulVariable());
-	templ("hash", util::selectorFromSignature(_signature).str());
-	templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
-
 	vector<string> errorArgumentVars;
 	vector<Type const*> errorArgumentTypes;
 	for (ASTPointer<Expression const> const& arg: _errorArguments)
@@ -3316,10 +3318,30 @@ void IRGeneratorForStatements::revertWithError(
 		solAssert(arg->annotation().type);
 		errorArgumentTypes.push_back(arg->annotation().type);
 	}
-	templ("argumentVars", joinHumanReadablePrefixed(errorArgumentVars));
-	templ("encode", m_context.abiFunctions().tupleEncoder(errorArgumentTypes, _parameterTypes));
 
-	appendCode() << templ.render();
+	if (!m_context.optimiserSettings().runExperimental(ExperimentalOptimisation::SharedReverts))
+	{
+		Whiskers templ(R"({
+			let <pos> := <allocateUnbounded>()
+			mstore(<pos>, <hash>)
+			let <end> := <encode>(add(<pos>, 4) <argumentVars>)
+			revert(<pos>, sub(<end>, <pos>))
+		})");
+		templ("pos", m_context.newYulVariable());
+		templ("end", m_context.newYulVariable());
+		templ("hash", util::selectorFromSignature(_signature).str());
+		templ("allocateUnbounded", m_utils.allocateUnboundedFunction());
+		templ("argumentVars", joinHumanReadablePrefixed(errorArgumentVars));
+		templ("encode", m_context.abiFunctions().tupleEncoder(errorArgumentTypes, _parameterTypes));
+		appendCode() << templ.render();
+		return;
+	}
+
+	appendCode() <<
+		m_utils.revertWithErrorFunction(_signature, _parameterTypes, errorArgumentTypes) <<
+		"(" <<
+		joinHumanReadable(errorArgumentVars) <<
+		")\n";
 }
 
 
@@ -0,0 +1,162 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/ir/MemoryEscapeAnalysis.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+bool isMemoryReference(Type const* _type)
+{
+	auto const* referenceType = dynamic_cast<ReferenceType const*>(_type);
+	return referenceType && referenceType->dataStoredIn(DataLocation::Memory);
+}
+
+class LocalSummaryCollector: private ASTConstVisitor
+{
+public:
+	LocalSummaryCollector(
+		ContractDefinition const& _mostDerivedContract,
+		bool& _allocates,
+		bool& _unsafe,
+		set<CallableDeclaration const*>& _callees
+	):
+		m_mostDerivedContract(_mostDerivedContract),
+		m_allocates(_allocates),
+		m_unsafe(_unsafe),
+		m_callees(_callees)
+	{}
+
+	void run(CallableDeclaration const& _callable) { _callable.accept(*this); }
+
+private:
+	bool visitNode(ASTNode const& _node) override
+	{
+		if (auto const* expression = dynamic_cast<Expression const*>(&_node))
+			m_allocates = m_allocates || isMemoryReference(expression->annotation().type);
+		else if (auto const* variable = dynamic_cast<VariableDeclaration const*>(&_node))
+			m_allocates = m_allocates || isMemoryReference(variable->type());
+		return true;
+	}
+
+	bool visit(InlineAssembly const&) override
+	{
+		m_unsafe = true;
+		return false;
+	}
+
+	bool visit(FunctionCall const& _functionCall) override
+	{
+		visitNode(_functionCall);
+		if (*_functionCall.annotation().kind != FunctionCallKind::FunctionCall)
+			return true;
+
+		auto const& functionType = dynamic_cast<FunctionType const&>(*_functionCall.expression().annotation().type);
+		switch (functionType.kind())
+		{
+		case FunctionType::Kind::Internal:
+		{
+			FunctionDefinition const* function = ASTNode::resolveFunctionCall(_functionCall, &m_mostDerivedContract);
+			if (function && function->isImplemented())
+				m_callees.insert(function);
+			else
+				m_unsafe = true;
+			break;
+		}
+		case FunctionType::Kind::External:
+		case FunctionType::Kind::DelegateCall:
+		case FunctionType::Kind::BareCall:
+		case FunctionType::Kind::BareDelegateCall:
+		case FunctionType::Kind::BareStaticCall:
+		case FunctionType::Kind::Creation:
+			// Return data is decoded into newly allocated memory.
+			m_allocates = true;
+			break;
+		default:
+			break;
+		}
+		return true;
+	}
+
+	bool visit(ModifierInvocation const& _invocation) override
+	{
+		if (auto const* modifier = dynamic_cast<ModifierDefinition const*>(
+			_invocation.name().annotation().referencedDeclaration
+		))
+		{
+			if (*_invocation.name().annotation().requiredLookup == VirtualLookup::Virtual)
+				modifier = &modifier->resolveVirtual(m_mostDerivedContract);
+			m_callees.insert(modifier);
+		}
+		return true;
+	}
+
+	ContractDefinition const& m_mostDerivedContract;
+	bool& m_allocates;
+	bool& m_unsafe;
+	set<CallableDeclaration const*>& m_callees;
+};
+
+}
+
+bool MemoryEscapeAnalysis::allocatesOnlyTemporaryMemory(FunctionDefinition const& _function)
+{
+	if (m_results.count(&_function))
+		return m_results.at(&_function);
+
+	bool& result = m_results[&_function];
+	for (auto const& parameters: {_function.parameters(), _function.returnParameters()})
+		for (auto const& parameter: parameters)
+			if (isMemoryReference(parameter->type()))
+				return result = false;
+
+	bool allocates = false;
+	set<CallableDeclaration const*> visited{&_function};
+	vector<CallableDeclaration const*> toVisit{&_function};
+	while (!toVisit.empty())
+	{
+		CallableDeclaration const* callable = toVisit.back();
+		toVisit.pop_back();
+		LocalSummary const& summary = localSummary(*callable);
+		if (summary.unsafe)
+			return result = false;
+		allocates = allocates || summary.allocates;
+		for (CallableDeclaration const* callee: summary.callees)
+			if (visited.insert(callee).second)
+				toVisit.push_back(callee);
+	}
+	return result = allocates;
+}
+
+MemoryEscapeAnalysis::LocalSummary const& MemoryEscapeAnalysis::localSummary(CallableDeclaration const& _callable)
+{
+	if (!m_localSummaries.count(&_callable))
+	{
+		LocalSummary summary;
+		LocalSummaryCollector{m_mostDerivedContract, summary.allocates, summary.unsafe, summary.callees}.run(_callable);
+		m_localSummaries[&_callable] = move(summary);
+	}
+	return m_localSummaries.at(&_callable);
+}
@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Analysis that finds internal functions whose memory allocations are not
+ * reachable anymore once a call to them returns.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::frontend
+{
+
+/**
+ * Determines whether all memory allocated during a direct call to an internal function
+ * becomes garbage when the call returns, so that the caller can reset the free memory
+ * pointer to its value before the call.
+ *
+ * This is the case if the function does not take or return memory references
+ * and neither it nor any function or modifier it can reach contains inline assembly
+ * (which could pass a pointer on as an integer) or calls an internal function through
+ * a function pointer (which might reach such code).
+ */
+class MemoryEscapeAnalysis
+{
+public:
+	explicit MemoryEscapeAnalysis(ContractDefinition const& _mostDerivedContract):
+		m_mostDerivedContract(_mostDerivedContract)
+	{}
+
+	/// @returns true if a direct call to @a _function may allocate memory and none of
+	/// that memory can be referenced after the call returns.
+	bool allocatesOnlyTemporaryMemory(FunctionDefinition const& _function);
+
+private:
+	/// Properties of a single function or modifier body, without its callees.
+	struct LocalSummary
+	{
+		bool allocates = false;
+		bool unsafe = false;
+		std::set<CallableDeclaration const*> callees;
+	};
+
+	LocalSummary const& localSummary(CallableDeclaration const& _callable);
+
+	ContractDefinition const& m_mostDerivedContract;
+	std::map<CallableDeclaration const*, LocalSummary> m_localSummaries;
+	std::map<FunctionDefinition const*, bool> m_results;
+};
+
+}
@@ -912,9 +912,6 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -926,7 +923,7 @@ void BMC::checkCondition(
 		}
 	smtutil::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = checkSatisfiableAndGenerateModel({move(_condition)}, expressionsToEvaluate);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -991,8 +988,6 @@ void BMC::checkCondition(
 		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -1006,15 +1001,10 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	// Both checks share the constraints as an assumption, so that the solver can reuse
+	// what it learned about them in the first check for the second one.
+	auto positiveResult = checkSatisfiable({_constraints, _value});
+	auto negatedResult = checkSatisfiable({_constraints, !_value});
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
@@ -1054,13 +1044,16 @@ void BMC::checkBooleanNotConstant(
 }
 
 pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::checkSatisfiableAndGenerateModel(
+	vector<smtutil::Expression> const& _assumptions,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
 	smtutil::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = m_interface->checkAssuming(_assumptions, _expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
@@ -1084,9 +1077,9 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 	return make_pair(result, values);
 }
 
-smtutil::CheckResult BMC::checkSatisfiable()
+smtutil::CheckResult BMC::checkSatisfiable(vector<smtutil::Expression> const& _assumptions)
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	return checkSatisfiableAndGenerateModel(_assumptions, {}).first;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
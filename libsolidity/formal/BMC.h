@@ -174,10 +174,14 @@ private:
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
+	/// Checks the assertions together with @a _assumptions, which are not kept afterwards.
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	checkSatisfiableAndGenerateModel(
+		std::vector<smtutil::Expression> const& _assumptions,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 
-	smtutil::CheckResult checkSatisfiable();
+	smtutil::CheckResult checkSatisfiable(std::vector<smtutil::Expression> const& _assumptions);
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
@@ -29,10 +29,14 @@
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -57,6 +61,14 @@ using namespace solidity::smtutil;
 using namespace solidity::frontend;
 using namespace solidity::frontend::smt;
 
+namespace
+{
+/// Time that rendering counterexamples may take in one run of the CHC engine. Counterexamples
+/// of targets reported afterwards are omitted, so that the reconstruction of many counterexamples
+/// does not take longer than finding them.
+chrono::steady_clock::duration const c_counterexampleTimeLimit = chrono::seconds(10);
+}
+
 CHC::CHC(
 	EncodingContext& _context,
 	UniqueErrorReporter& _errorReporter,
@@ -75,6 +87,8 @@ CHC::CHC(
 #endif
 	if (!usesZ3 && m_settings.solvers.smtlib2)
 		m_interface = make_unique<CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback, m_settings.timeout);
+	if (!m_settings.cacheDirectory.empty())
+		m_proofCache.emplace(m_settings.cacheDirectory);
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -1005,8 +1019,14 @@ void CHC::resetSourceAnalysis()
 	{
 		/// z3::fixedpoint does not have a reset mechanism, so we need to create another.
 		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
-		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+		auto z3Interface = dynamic_cast<Z3CHCInterface*>(m_interface.get());
 		solAssert(z3Interface, "");
+		// The Horn system is copied into further solver instances to answer queries concurrently
+		// or sliced for every query. Cached proofs are keyed by the slice of their query.
+		if (m_settings.sliceQueries)
+			z3Interface->enableSlicing();
+		else if (m_settings.jobs > 1 || m_proofCache)
+			z3Interface->enableRecording();
 		m_context.setSolver(z3Interface->z3Interface());
 	}
 #endif
@@ -1542,38 +1562,26 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 
 tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
 {
-	CheckResult result;
-	smtutil::Expression invariant(true);
-	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
-#ifdef HAVE_Z3
-		if (m_settings.solvers.z3)
-		{
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
-
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+	auto result = querySolver(*m_interface, _query);
+	reportQueryResult(get<0>(result), _location);
+	return result;
+}
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = move(cexNoOpt);
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::querySolver(
+	CHCSolverInterface& _interface,
+	smtutil::Expression const& _query
+) const
+{
+	// The counterexample is only completed if the target is reported, see completeCounterexample().
+	return _interface.query(_query);
+}
 
-			spacer->setSpacerOptions(true);
-		}
-#endif
-		break;
-	}
+void CHC::reportQueryResult(CheckResult _result, SourceLocation const& _location)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE:
 	case CheckResult::UNSATISFIABLE:
-		break;
 	case CheckResult::UNKNOWN:
 		break;
 	case CheckResult::CONFLICTING:
@@ -1583,7 +1591,6 @@ tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
 		break;
 	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1631,6 +1638,7 @@ void CHC::checkVerificationTargets()
 	// Also, all possible contexts in which an external function can be called has been recorded (m_queryPlaceholders).
 	// Here we combine every context in which an external function can be called with all possible verification conditions
 	// in its call graph. Each such combination forms a unique verification target.
+	m_querySizes.clear();
 	map<unsigned, vector<CHCQueryPlaceholder>> targetEntryPoints;
 	for (auto const& [function, placeholders]: m_queryPlaceholders)
 	{
@@ -1641,6 +1649,7 @@ void CHC::checkVerificationTargets()
 	}
 
 	set<unsigned> checkedErrorIds;
+	vector<CHCTargetCheck> targetChecks;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		string errorType;
@@ -1695,23 +1704,59 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		targetChecks.push_back({&target, &placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
 		checkedErrorIds.insert(target.errorId);
 	}
 
-	auto toReport = m_unsafeTargets;
+	size_t jobs = 1;
+#ifdef HAVE_Z3
+	if (dynamic_cast<Z3CHCInterface const*>(m_interface.get()))
+		jobs = min<size_t>(m_settings.jobs, targetChecks.size());
+#endif
+	if (jobs > 1)
+		checkAndReportTargets(targetChecks, jobs);
+	else
+		for (auto const& check: targetChecks)
+			checkAndReportTarget(*check.target, *check.placeholders, check.errorReporterId, check.satMsg, check.unknownMsg);
+
+	map<ASTNode const*, map<VerificationTargetType, ReportTargetInfo*>, smt::EncodingContext::IdCompare> toReport;
+	for (auto& [node, targets]: m_unsafeTargets)
+		for (auto& [target, info]: targets)
+			toReport[node].emplace(target, &info);
 	if (m_settings.showUnproved)
-		for (auto const& [node, targets]: m_unprovedTargets)
-			for (auto const& [target, info]: targets)
-				toReport[node].emplace(target, info);
+		for (auto& [node, targets]: m_unprovedTargets)
+			for (auto& [target, info]: targets)
+				toReport[node].emplace(target, &info);
 
+	size_t const omittedCounterexamples = m_omittedCounterexamples;
 	for (auto const& [node, targets]: toReport)
 		for (auto const& [target, info]: targets)
+		{
+			if (m_errorReporter.reported(info->error, info->location))
+				continue;
+			// Counterexamples are only rendered for the warnings that are actually reported.
+			if (info->counterexample && !m_errorReporter.hasExcessiveWarnings())
+			{
+				if (optional<string> counterexample = renderCounterexample(*info->counterexample))
+					info->message += "\nCounterexample:\n" + *counterexample;
+				info->counterexample.reset();
+			}
 			m_errorReporter.warning(
-				info.error,
-				info.location,
-				info.message
+				info->error,
+				info->location,
+				info->message
 			);
+		}
+
+	if (m_omittedCounterexamples > omittedCounterexamples)
+		m_errorReporter.info(
+			3721_error,
+			"CHC: " +
+			to_string(m_omittedCounterexamples - omittedCounterexamples) +
+			" counterexample(s) were omitted because generating counterexamples took more than " +
+			to_string(chrono::duration_cast<chrono::seconds>(c_counterexampleTimeLimit).count()) +
+			" seconds in total."
+		);
 
 	if (!m_settings.showUnproved && !m_unprovedTargets.empty())
 		m_errorReporter.warning(
@@ -1766,6 +1811,19 @@ void CHC::checkVerificationTargets()
 			m_errorReporter.info(1180_error, msg);
 	}
 
+	if (!m_querySizes.empty())
+	{
+		string msg = "Horn clauses per query:\n";
+		for (auto const& [target, sliceRules, rules]: m_querySizes)
+		{
+			string loc = string(m_charStreamProvider.charStream(*target->errorNode->location().sourceName).text(target->errorNode->location()));
+			msg +=
+				ModelCheckerTargets::targetTypeToString.at(target->type) + " at " + loc + ": " +
+				to_string(sliceRules) + " of " + to_string(rules) + "\n";
+		}
+		m_errorReporter.info(6152_error, msg);
+	}
+
 	// There can be targets in internal functions that are not reachable from the external interface.
 	// These are safe by definition and are not even checked by the CHC engine, but this information
 	// must still be reported safe by the BMC engine.
@@ -1797,6 +1855,97 @@ void CHC::checkAndReportTarget(
 	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
 		return;
 
+	smtutil::Expression errorQuery = targetQuery(_target, _placeholders);
+	optional<h256> cacheKey = proofCacheKey(errorQuery);
+	if (cacheKey)
+		if (optional<CHCTargetOutcome> outcome = loadOutcome(*cacheKey))
+		{
+			reportOutcome(_target, _errorReporterId, _satMsg, _unknownMsg, *outcome);
+			return;
+		}
+
+	auto result = query(errorQuery, _target.errorNode->location());
+	CHCTargetOutcome outcome = targetOutcome(move(result), errorQuery, cacheKey);
+	reportOutcome(_target, _errorReporterId, _satMsg, _unknownMsg, outcome);
+	// Counterexamples are stored once they are rendered.
+	if (cacheKey && !outcome.rawCounterexample)
+		storeOutcome(*cacheKey, errorQuery, outcome);
+}
+
+void CHC::checkAndReportTargets(vector<CHCTargetCheck> const& _checks, size_t _jobs)
+{
+#ifdef HAVE_Z3
+	auto isUnsafe = [&](CHCVerificationTarget const& _target) {
+		return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+	};
+
+	// All error blocks are added before the Horn system is copied. Targets that turn out to be
+	// unsafe because of an earlier target are still solved, but not reported.
+	vector<optional<smtutil::Expression>> queries;
+	for (auto const& check: _checks)
+		if (isUnsafe(*check.target))
+			queries.emplace_back();
+		else
+			queries.emplace_back(targetQuery(*check.target, *check.placeholders));
+
+	// Outcomes found in the proof cache do not have to be solved again.
+	vector<optional<h256>> cacheKeys(queries.size());
+	vector<optional<CHCTargetOutcome>> cachedOutcomes(queries.size());
+	for (size_t i = 0; i < queries.size(); ++i)
+		if (queries[i])
+			if ((cacheKeys[i] = proofCacheKey(*queries[i])))
+				cachedOutcomes[i] = loadOutcome(*cacheKeys[i]);
+
+	auto const* z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
+	solAssert(z3Interface, "");
+	// With slicing, every query is answered by its own slice instead of a copy of the whole system.
+	vector<unique_ptr<Z3CHCInterface>> solvers;
+	if (!m_settings.sliceQueries)
+		for (size_t i = 0; i < _jobs; ++i)
+			solvers.emplace_back(z3Interface->clone());
+
+	vector<optional<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>>> results(queries.size());
+	atomic<size_t> nextQuery{0};
+	util::parallelFor(_jobs, _jobs, [&](size_t _solver) {
+		for (size_t i = nextQuery++; i < queries.size(); i = nextQuery++)
+			if (queries[i] && !cachedOutcomes[i])
+			{
+				if (m_settings.sliceQueries)
+					results[i] = querySolver(*z3Interface->slice(*queries[i]), *queries[i]);
+				else
+					results[i] = querySolver(*solvers[_solver], *queries[i]);
+			}
+	});
+
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		CHCTargetCheck const& check = _checks[i];
+		if (!queries[i] || isUnsafe(*check.target))
+			continue;
+		if (cachedOutcomes[i])
+		{
+			reportOutcome(*check.target, check.errorReporterId, check.satMsg, check.unknownMsg, *cachedOutcomes[i]);
+			continue;
+		}
+		solAssert(results[i], "");
+		reportQueryResult(get<0>(*results[i]), check.target->errorNode->location());
+		CHCTargetOutcome outcome = targetOutcome(move(*results[i]), *queries[i], cacheKeys[i]);
+		reportOutcome(*check.target, check.errorReporterId, check.satMsg, check.unknownMsg, outcome);
+		if (cacheKeys[i] && !outcome.rawCounterexample)
+			storeOutcome(*cacheKeys[i], *queries[i], outcome);
+	}
+#else
+	solAssert(false, "Concurrent queries require z3.");
+	(void)_checks;
+	(void)_jobs;
+#endif
+}
+
+smtutil::Expression CHC::targetQuery(
+	CHCVerificationTarget const& _target,
+	vector<CHCQueryPlaceholder> const& _placeholders
+)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -1804,45 +1953,219 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
-	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
+#ifdef HAVE_Z3
+	if (m_settings.sliceQueries)
+		if (auto const* z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get()))
+		{
+			auto [sliceRules, rules] = z3Interface->sliceSize(error());
+			m_querySizes.push_back({&_target, sliceRules, rules});
+		}
+#endif
+	return error();
+}
+
+CHC::CHCTargetOutcome CHC::targetOutcome(
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> _result,
+	smtutil::Expression const& _query,
+	optional<h256> const& _cacheKey
+)
+{
+	auto& [result, invariant, model] = _result;
+	CHCTargetOutcome outcome{result, {}, {}, {}};
 	if (result == CheckResult::UNSATISFIABLE)
 	{
-		m_safeTargets[_target.errorNode].insert(_target.type);
 		set<Predicate const*> predicates;
 		for (auto const* pred: m_interfaces | ranges::views::values)
 			predicates.insert(pred);
 		for (auto const* pred: m_nondetInterfaces | ranges::views::values)
 			predicates.insert(pred);
-		map<Predicate const*, set<string>> invariants = collectInvariants(invariant, predicates, m_settings.invariants);
-		for (auto pred: invariants | ranges::views::keys)
-			m_invariants[pred] += move(invariants.at(pred));
+		outcome.invariants = collectInvariants(invariant, predicates, m_settings.invariants);
 	}
 	else if (result == CheckResult::SATISFIABLE)
+		outcome.rawCounterexample = make_shared<RawCounterexample const>(RawCounterexample{_query, move(model), _cacheKey});
+	return outcome;
+}
+
+void CHC::reportOutcome(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	CHCTargetOutcome const& _outcome
+)
+{
+	auto const& location = _target.errorNode->location();
+	if (_outcome.result == CheckResult::UNSATISFIABLE)
+	{
+		m_safeTargets[_target.errorNode].insert(_target.type);
+		for (auto const& [pred, invariants]: _outcome.invariants)
+			m_invariants[pred] += invariants;
+	}
+	else if (_outcome.result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
-		if (cex)
+		if (_outcome.counterexample)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
 				location,
-				"CHC: " + _satMsg + "\nCounterexample:\n" + *cex
+				"CHC: " + _satMsg + "\nCounterexample:\n" + *_outcome.counterexample,
+				nullptr
 			};
 		else
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
 				location,
-				"CHC: " + _satMsg
+				"CHC: " + _satMsg,
+				_outcome.rawCounterexample
 			};
 	}
 	else if (!_unknownMsg.empty())
 		m_unprovedTargets[_target.errorNode][_target.type] = {
 			_errorReporterId,
 			location,
-			"CHC: " + _unknownMsg
+			"CHC: " + _unknownMsg,
+			nullptr
 		};
 }
 
+optional<h256> CHC::proofCacheKey(smtutil::Expression const& _query)
+{
+	if (!m_proofCache)
+		return nullopt;
+	optional<string> description = m_interface->queryDescription(_query);
+	if (!description)
+		return nullopt;
+	// The invariants that are reported depend on the settings, and the formatting of
+	// counterexamples and invariants depends on the compiler version.
+	string invariantTypes;
+	for (InvariantType type: m_settings.invariants.invariants)
+		invariantTypes += to_string(static_cast<int>(type)) + ",";
+	return keccak256("CHC " + VersionString + " " + invariantTypes + "\n" + *description);
+}
+
+optional<CHC::CHCTargetOutcome> CHC::loadOutcome(h256 const& _key) const
+{
+	optional<string> entryString = m_proofCache->load(_key);
+	Json::Value entry;
+	if (!entryString || !jsonParseStrict(*entryString, entry) || !entry.isObject())
+		return nullopt;
+
+	CHCTargetOutcome outcome{CheckResult::ERROR, {}, {}, {}};
+	string const result = entry["result"].asString();
+	if (result == "safe")
+		outcome.result = CheckResult::UNSATISFIABLE;
+	else if (result == "unsafe")
+		outcome.result = CheckResult::SATISFIABLE;
+	else if (result == "unknown")
+		outcome.result = CheckResult::UNKNOWN;
+	else
+		return nullopt;
+
+	if (entry["counterexample"].isString())
+		outcome.counterexample = entry["counterexample"].asString();
+	for (string const& name: entry["invariants"].getMemberNames())
+	{
+		// Predicates are named after the program elements, so entries that were stored for
+		// a query of this compilation refer to existing predicates.
+		Predicate const* pred = nullptr;
+		try
+		{
+			pred = Predicate::predicate(name);
+		}
+		catch (out_of_range const&)
+		{
+			return nullopt;
+		}
+		if (!entry["invariants"][name].isArray())
+			return nullopt;
+		for (Json::Value const& invariant: entry["invariants"][name])
+			outcome.invariants[pred].insert(invariant.asString());
+	}
+	return outcome;
+}
+
+void CHC::storeOutcome(h256 const& _key, smtutil::Expression const& _query, CHCTargetOutcome const& _outcome) const
+{
+	Json::Value entry{Json::objectValue};
+	switch (_outcome.result)
+	{
+	case CheckResult::UNSATISFIABLE:
+		entry["result"] = "safe";
+		break;
+	case CheckResult::SATISFIABLE:
+		entry["result"] = "unsafe";
+		break;
+	case CheckResult::UNKNOWN:
+		entry["result"] = "unknown";
+		break;
+	case CheckResult::CONFLICTING:
+	case CheckResult::ERROR:
+		// Solver errors may be temporary, so they are not stored.
+		return;
+	}
+	if (_outcome.counterexample)
+		entry["counterexample"] = *_outcome.counterexample;
+	// The key only covers the slice of the query, so invariants of relations outside of it
+	// might not hold in other systems with the same key.
+	optional<set<string>> sliceRelations;
+#ifdef HAVE_Z3
+	if (auto const* z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get()))
+		sliceRelations = z3Interface->sliceRelations(_query);
+#else
+	(void)_query;
+#endif
+	entry["invariants"] = Json::objectValue;
+	for (auto const& [pred, invariants]: _outcome.invariants)
+	{
+		if (sliceRelations && !sliceRelations->count(pred->functor().name))
+			continue;
+		Json::Value& predicateInvariants = entry["invariants"][pred->functor().name];
+		predicateInvariants = Json::arrayValue;
+		for (string const& invariant: invariants)
+			predicateInvariants.append(invariant);
+	}
+	m_proofCache->store(_key, jsonCompactPrint(entry));
+}
+
+optional<string> CHC::renderCounterexample(RawCounterexample const& _counterexample)
+{
+	if (m_counterexampleTime >= c_counterexampleTimeLimit)
+	{
+		++m_omittedCounterexamples;
+		return nullopt;
+	}
+
+	auto start = chrono::steady_clock::now();
+	optional<string> counterexample = generateCounterexample(completeCounterexample(_counterexample), _counterexample.query.name);
+	m_counterexampleTime += chrono::steady_clock::now() - start;
+
+	if (_counterexample.cacheKey)
+		storeOutcome(*_counterexample.cacheKey, _counterexample.query, {CheckResult::SATISFIABLE, counterexample, {}, {}});
+	return counterexample;
+}
+
+CHCSolverInterface::CexGraph CHC::completeCounterexample(RawCounterexample const& _counterexample)
+{
+#ifdef HAVE_Z3
+	if (m_settings.solvers.z3)
+	{
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		// The Horn system only grew since the query was solved, which does not affect the
+		// reachability of its error predicate.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
+		auto [resultNoOpt, invariantNoOpt, cexNoOpt] = spacer->query(_counterexample.query);
+		spacer->setSpacerOptions(true);
+
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			return cexNoOpt;
+	}
+#endif
+	return _counterexample.graph;
+}
+
 /**
 The counterexample DAG has the following properties:
 1) The root node represents the reachable error predicate.
@@ -35,6 +35,7 @@
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
@@ -44,7 +45,9 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 
@@ -65,11 +68,24 @@ public:
 
 	void analyze(SourceUnit const& _sources);
 
+	/// Counterexample of an unsafe target as found by the solver. It is only turned into
+	/// a transaction trace if the target is actually reported.
+	struct RawCounterexample
+	{
+		/// The error predicate that was found to be reachable.
+		smtutil::Expression query;
+		smtutil::CHCSolverInterface::CexGraph graph;
+		/// Key under which the outcome is stored in the proof cache once the trace is known.
+		std::optional<util::h256> cacheKey;
+	};
+
 	struct ReportTargetInfo
 	{
 		langutil::ErrorId error;
 		langutil::SourceLocation location;
 		std::string message;
+		/// Counterexample that is appended to @a message when the target is reported.
+		std::shared_ptr<RawCounterexample const> counterexample;
 	};
 	std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> const& safeTargets() const { return m_safeTargets; }
 	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> const& unsafeTargets() const { return m_unsafeTargets; }
@@ -248,6 +264,15 @@ private:
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
 	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// Sends @a _query to @a _interface without reporting anything.
+	/// Does not modify the state of the analysis, so it can be called from several threads
+	/// with different interfaces.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> querySolver(
+		smtutil::CHCSolverInterface& _interface,
+		smtutil::Expression const& _query
+	) const;
+	/// Reports solver errors and conflicting answers for a query at @a _location.
+	void reportQueryResult(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
@@ -263,7 +288,67 @@ private:
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
-
+	/// A verification target together with the error it is reported as.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const* target;
+		std::vector<CHCQueryPlaceholder> const* placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+	/// Checks and reports @a _checks like `checkAndReportTarget`, but solves the queries on
+	/// @a _jobs independent copies of the Horn system concurrently.
+	/// The results are reported in the order of @a _checks.
+	void checkAndReportTargets(std::vector<CHCTargetCheck> const& _checks, size_t _jobs);
+	/// Adds an error block for @a _target that is reachable from @a _placeholders.
+	/// @returns the query for the error block.
+	smtutil::Expression targetQuery(
+		CHCVerificationTarget const& _target,
+		std::vector<CHCQueryPlaceholder> const& _placeholders
+	);
+	/// Result of the check of a verification target, as it is stored in the proof cache.
+	struct CHCTargetOutcome
+	{
+		smtutil::CheckResult result;
+		/// Counterexample of an unsafe target, if one could be generated.
+		std::optional<std::string> counterexample;
+		/// Invariants found for a safe target.
+		std::map<Predicate const*, std::set<std::string>> invariants;
+		/// Counterexample of an unsafe target that was just solved, which is only turned into
+		/// text if the target is reported. Not stored in the proof cache.
+		std::shared_ptr<RawCounterexample const> rawCounterexample;
+	};
+	/// @returns the outcome of @a _query with result @a _result. The counterexample of an unsafe
+	/// target is stored under @a _cacheKey once it is rendered.
+	CHCTargetOutcome targetOutcome(
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> _result,
+		smtutil::Expression const& _query,
+		std::optional<util::h256> const& _cacheKey
+	);
+	/// Records @a _outcome as the result for @a _target.
+	void reportOutcome(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		CHCTargetOutcome const& _outcome
+	);
+	/// @returns the key of the outcome of @a _query in the proof cache, if the cache is enabled
+	/// and the solver can describe the query. With z3, the key only depends on the part of the
+	/// Horn system that the query depends on, so it stays the same when unrelated code changes.
+	std::optional<util::h256> proofCacheKey(smtutil::Expression const& _query);
+	std::optional<CHCTargetOutcome> loadOutcome(util::h256 const& _key) const;
+	/// Stores @a _outcome of @a _query under @a _key.
+	void storeOutcome(util::h256 const& _key, smtutil::Expression const& _query, CHCTargetOutcome const& _outcome) const;
+
+	/// @returns the transaction trace of @a _counterexample, if one can be generated before
+	/// the time for rendering counterexamples in this run is used up.
+	/// Stores the outcome in the proof cache.
+	std::optional<std::string> renderCounterexample(RawCounterexample const& _counterexample);
+	/// @returns the counterexample graph of @a _counterexample, solved again without Spacer's
+	/// preprocessing if possible, which makes the counterexamples found by z3 incomplete.
+	smtutil::CHCSolverInterface::CexGraph completeCounterexample(RawCounterexample const& _counterexample);
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
 	/// @returns a call graph for function summaries in the counterexample graph.
@@ -381,8 +466,22 @@ private:
 	/// Targets not proved.
 	std::map<ASTNode const*, std::map<VerificationTargetType, ReportTargetInfo>, smt::EncodingContext::IdCompare> m_unprovedTargets;
 
+	struct QuerySize
+	{
+		CHCVerificationTarget const* target;
+		size_t sliceRules;
+		size_t rules;
+	};
+	/// Number of rules in the slice of each query and in the whole Horn system, if slicing is enabled.
+	std::vector<QuerySize> m_querySizes;
+
 	/// Inferred invariants.
 	std::map<Predicate const*, std::set<std::string>, PredicateCompare> m_invariants;
+
+	/// Time spent rendering counterexamples in this run, see renderCounterexample().
+	std::chrono::steady_clock::duration m_counterexampleTime{};
+	/// Number of counterexamples not rendered because the time was used up.
+	size_t m_omittedCounterexamples = 0;
 	//@}
 
 	/// Control-flow.
@@ -421,6 +520,8 @@ private:
 
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
+	/// On-disk cache of the outcomes of queries, if enabled.
+	std::optional<CompilationCache> m_proofCache;
 };
 
 }
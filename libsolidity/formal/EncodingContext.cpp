@@ -20,6 +20,8 @@
 
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <unordered_set>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -37,6 +39,7 @@ void EncodingContext::reset()
 	m_globalContext.clear();
 	m_state.reset();
 	m_assertions.clear();
+	m_indexLog.clear();
 }
 
 void EncodingContext::resetUniqueId()
@@ -63,6 +66,10 @@ bool EncodingContext::createVariable(frontend::VariableDeclaration const& _varDe
 	auto const& type = _varDecl.type();
 	auto result = newSymbolicVariable(*type, _varDecl.name() + "_" + to_string(_varDecl.id()), *this);
 	m_variables.emplace(&_varDecl, result.second);
+	m_indexLog.emplace_back(&_varDecl, nullopt);
+	result.second->observeIndex([this, decl = &_varDecl](unsigned _previousIndex) {
+		m_indexLog.emplace_back(decl, _previousIndex);
+	});
 	return result.first;
 }
 
@@ -97,6 +104,18 @@ void EncodingContext::resetAllVariables()
 	resetVariables([&](frontend::VariableDeclaration const&) { return true; });
 }
 
+vector<pair<frontend::VariableDeclaration const*, optional<unsigned>>> EncodingContext::indicesAt(size_t _position) const
+{
+	solAssert(_position <= m_indexLog.size(), "");
+	vector<pair<frontend::VariableDeclaration const*, optional<unsigned>>> indices;
+	unordered_set<frontend::VariableDeclaration const*> seen;
+	// The first change after the position records the index at the position.
+	for (size_t i = _position; i < m_indexLog.size(); ++i)
+		if (seen.insert(m_indexLog[i].first).second)
+			indices.emplace_back(m_indexLog[i]);
+	return indices;
+}
+
 smtutil::Expression EncodingContext::newValue(frontend::VariableDeclaration const& _decl)
 {
 	solAssert(knownVariable(_decl), "");
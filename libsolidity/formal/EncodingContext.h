@@ -24,6 +24,8 @@
 #include <libsmtutil/SolverInterface.h>
 
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace solidity::frontend::smt
 {
@@ -99,6 +101,14 @@ public:
 	/// Allocates a new index for the declaration, updates the current
 	/// index to this value and returns the expression.
 	smtutil::Expression newValue(frontend::VariableDeclaration const& _decl);
+	/// @returns the current position in the log of SSA index changes of the variables.
+	/// The position identifies the indices of all variables at this point.
+	size_t indexLogPosition() const { return m_indexLog.size(); }
+	/// @returns the variables that were created or whose index changed since @a _position in the
+	/// order of their first change, together with their index at @a _position or nullopt if they
+	/// were created later. The costs only depend on the number of changes since @a _position.
+	std::vector<std::pair<frontend::VariableDeclaration const*, std::optional<unsigned>>> indicesAt(size_t _position) const;
+
 	/// Sets the value of the declaration to zero.
 	void setZeroValue(frontend::VariableDeclaration const& _decl);
 	void setZeroValue(SymbolicVariable& _variable);
@@ -157,6 +167,9 @@ private:
 	//{@
 	/// Symbolic variables.
 	std::map<frontend::VariableDeclaration const*, std::shared_ptr<SymbolicVariable>, IdCompare> m_variables;
+	/// Variables in the order they were created or their SSA index changed, together with
+	/// their previous index or nullopt on creation. Cleared by reset().
+	std::vector<std::pair<frontend::VariableDeclaration const*, std::optional<unsigned>>> m_indexLog;
 
 	/// Symbolic expressions.
 	std::map<frontend::Expression const*, std::shared_ptr<SymbolicVariable>, IdCompare> m_expressions;
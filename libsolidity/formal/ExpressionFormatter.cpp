@@ -128,11 +128,14 @@ smtutil::Expression substitute(smtutil::Expression _from, map<string, string> co
 	// but we should support them in the future.
 	if (_from.name == "forall" || _from.name == "exists")
 		return smtutil::Expression(true);
-	if (_subst.count(_from.name))
-		_from.name = _subst.at(_from.name);
-	for (auto& arg: _from.arguments)
-		arg = substitute(arg, _subst);
-	return _from;
+	vector<smtutil::Expression> arguments;
+	for (auto const& arg: _from.arguments)
+		arguments.push_back(substitute(arg, _subst));
+	return smtutil::Expression(
+		_subst.count(_from.name) ? _subst.at(_from.name) : _from.name,
+		std::move(arguments),
+		_from.sort
+	);
 }
 
 string toSolidityStr(smtutil::Expression const& _expr)
@@ -45,6 +45,8 @@ map<Predicate const*, set<string>> collectInvariants(
 		targets.insert("interface_");
 	if (_invariantsSetting.has(InvariantType::Reentrancy))
 		targets.insert("nondet_interface_");
+	if (targets.empty())
+		return {};
 
 	map<string, pair<smtutil::Expression, smtutil::Expression>> equalities;
 	// Collect equalities where one of the sides is a predicate we're interested in.
@@ -20,6 +20,8 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <set>
 
@@ -156,6 +158,13 @@ struct ModelCheckerSettings
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Number of solver instances that answer the queries of the CHC engine concurrently.
+	unsigned jobs = 1;
+	/// Directory of the on-disk cache of the results of CHC queries. Empty if disabled.
+	boost::filesystem::path cacheDirectory;
+	/// Answer every CHC query on the part of the Horn system that it depends on
+	/// and report the sizes of these parts.
+	bool sliceQueries = false;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
@@ -168,7 +177,10 @@ struct ModelCheckerSettings
 			showUnproved == _other.showUnproved &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			jobs == _other.jobs &&
+			cacheDirectory == _other.cacheDirectory &&
+			sliceQueries == _other.sliceQueries;
 	}
 };
 
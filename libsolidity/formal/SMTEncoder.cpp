@@ -2430,20 +2430,33 @@ Type const* SMTEncoder::typeWithoutPointer(Type const* _type)
 	return _type;
 }
 
-void SMTEncoder::mergeVariables(smtutil::Expression const& _condition, VariableIndices const& _indicesEndTrue, VariableIndices const& _indicesEndFalse)
-{
-	for (auto const& entry: _indicesEndTrue)
-	{
-		VariableDeclaration const* var = entry.first;
-		auto trueIndex = entry.second;
-		if (_indicesEndFalse.count(var) && _indicesEndFalse.at(var) != trueIndex)
-		{
+void SMTEncoder::mergeVariables(smtutil::Expression const& _condition, VariableIndices _indicesEndTrue, VariableIndices _indicesEndFalse)
+{
+	// Only variables that changed since the earlier of the two points can differ between them.
+	// Variables that did not change since the later point still have their current index there.
+	auto indicesSince = [&](VariableIndices _position) {
+		unordered_map<VariableDeclaration const*, optional<unsigned>> indices;
+		for (auto const& [var, index]: m_context.indicesAt(_position))
+			indices.emplace(var, index);
+		return indices;
+	};
+	auto indexAt = [&](auto const& _changedIndices, VariableDeclaration const* _var) -> optional<unsigned> {
+		auto it = _changedIndices.find(_var);
+		return it != _changedIndices.end() ? it->second : m_context.variable(*_var)->index();
+	};
+	auto const changedSinceTrue = indicesSince(_indicesEndTrue);
+	auto const changedSinceFalse = indicesSince(_indicesEndFalse);
+	auto const changedSinceEarlier = m_context.indicesAt(min(_indicesEndTrue, _indicesEndFalse));
+	for (VariableDeclaration const* var: changedSinceEarlier | ranges::views::keys)
+	{
+		optional<unsigned> trueIndex = indexAt(changedSinceTrue, var);
+		optional<unsigned> falseIndex = indexAt(changedSinceFalse, var);
+		if (trueIndex && falseIndex && *trueIndex != *falseIndex)
 			m_context.addAssertion(m_context.newValue(*var) == smtutil::Expression::ite(
 				_condition,
-				valueAtIndex(*var, trueIndex),
-				valueAtIndex(*var, _indicesEndFalse.at(var)))
+				valueAtIndex(*var, *trueIndex),
+				valueAtIndex(*var, *falseIndex))
 			);
-		}
 	}
 }
 
@@ -2609,18 +2622,17 @@ ContractDefinition const* SMTEncoder::currentScopeContract()
 	return nullptr;
 }
 
-SMTEncoder::VariableIndices SMTEncoder::copyVariableIndices()
+SMTEncoder::VariableIndices SMTEncoder::copyVariableIndices() const
 {
-	VariableIndices indices;
-	for (auto const& var: m_context.variables())
-		indices.emplace(var.first, var.second->index());
-	return indices;
+	return m_context.indexLogPosition();
 }
 
-void SMTEncoder::resetVariableIndices(VariableIndices const& _indices)
+void SMTEncoder::resetVariableIndices(VariableIndices _indices)
 {
-	for (auto const& var: _indices)
-		m_context.variable(*var.first)->setIndex(var.second);
+	// Variables created since then keep their index, they were not part of the indices.
+	for (auto const& [var, index]: m_context.indicesAt(_indices))
+		if (index)
+			m_context.variable(*var)->setIndex(*index);
 }
 
 void SMTEncoder::clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function)
@@ -298,8 +298,10 @@ protected:
 	/// Handles assignment of an expression to a tuple of variables.
 	void expressionToTupleAssignment(std::vector<std::shared_ptr<VariableDeclaration>> const& _variables, Expression const& _rhs);
 
-	/// Maps a variable to an SSA index.
-	using VariableIndices = std::unordered_map<VariableDeclaration const*, unsigned>;
+	/// The SSA indices of all variables at some point, given as the position in the index log
+	/// of the encoding context. Taking, restoring and comparing them only costs as much as
+	/// the number of index changes since then.
+	using VariableIndices = size_t;
 
 	/// Visits the branch given by the statement, pushes and pops the current path conditions.
 	/// @param _condition if present, asserts that this condition is true within the branch.
@@ -333,7 +335,7 @@ protected:
 
 	/// Given the state of the symbolic variables at the end of two different branches,
 	/// create a merged state using the given branch condition.
-	void mergeVariables(smtutil::Expression const& _condition, VariableIndices const& _indicesEndTrue, VariableIndices const& _indicesEndFalse);
+	void mergeVariables(smtutil::Expression const& _condition, VariableIndices _indicesEndTrue, VariableIndices _indicesEndFalse);
 	/// Tries to create an uninitialized variable and returns true on success.
 	bool createVariable(VariableDeclaration const& _varDecl);
 
@@ -370,10 +372,10 @@ protected:
 	/// Add to the solver: the given expression implied by the current path conditions
 	void addPathImpliedExpression(smtutil::Expression const& _e);
 
-	/// Copy the SSA indices of m_variables.
-	VariableIndices copyVariableIndices();
-	/// Resets the variable indices.
-	void resetVariableIndices(VariableIndices const& _indices);
+	/// @returns the current SSA indices of all variables.
+	VariableIndices copyVariableIndices() const;
+	/// Restores the variable indices to @a _indices.
+	void resetVariableIndices(VariableIndices _indices);
 	/// Used when starting a new block.
 	virtual void clearIndices(ContractDefinition const* _contract, FunctionDefinition const* _function = nullptr);
 
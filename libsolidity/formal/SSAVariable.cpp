@@ -29,12 +29,16 @@ SSAVariable::SSAVariable()
 
 void SSAVariable::resetIndex()
 {
+	if (m_indexObserver && m_currentIndex != 0)
+		m_indexObserver(m_currentIndex);
 	m_currentIndex = 0;
 	m_nextFreeIndex = 1;
 }
 
 void SSAVariable::setIndex(unsigned _index)
 {
+	if (m_indexObserver && m_currentIndex != _index)
+		m_indexObserver(m_currentIndex);
 	m_currentIndex = _index;
 	if (m_nextFreeIndex <= _index)
 		m_nextFreeIndex = _index + 1;
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 namespace solidity::frontend::smt
@@ -37,16 +38,21 @@ public:
 
 	/// This function returns the current index of this SSA variable.
 	unsigned index() const { return m_currentIndex; }
-	unsigned& index() { return m_currentIndex; }
 
 	unsigned operator++()
 	{
+		if (m_indexObserver)
+			m_indexObserver(m_currentIndex);
 		return m_currentIndex = m_nextFreeIndex++;
 	}
 
+	/// Sets a function that is called with the previous index whenever the current index changes.
+	void setIndexObserver(std::function<void(unsigned)> _observer) { m_indexObserver = std::move(_observer); }
+
 private:
 	unsigned m_currentIndex;
 	unsigned m_nextFreeIndex;
+	std::function<void(unsigned)> m_indexObserver;
 };
 
 }
@@ -68,7 +68,8 @@ public:
 	}
 
 	unsigned index() const { return m_ssa->index(); }
-	unsigned& index() { return m_ssa->index(); }
+	/// Calls @a _observer with the previous index whenever the index of this variable changes.
+	void observeIndex(std::function<void(unsigned)> _observer) { m_ssa->setIndexObserver(std::move(_observer)); }
 
 	smtutil::SortPointer const& sort() const { return m_sort; }
 	frontend::Type const* type() const { return m_type; }
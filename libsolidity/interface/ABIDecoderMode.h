@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Setting for the code generated to decode ABI-encoded data.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+enum class ABIDecoderMode
+{
+	Default, // specialised decoders for every combination of types
+	Compact // decoders are shared between types that are decoded in the same way
+};
+
+inline std::string abiDecoderModeToString(ABIDecoderMode _mode)
+{
+	switch (_mode)
+	{
+	case ABIDecoderMode::Default: return "default";
+	case ABIDecoderMode::Compact: return "compact";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<ABIDecoderMode> abiDecoderModeFromString(std::string const& _mode)
+{
+	for (auto i: {ABIDecoderMode::Default, ABIDecoderMode::Compact})
+		if (abiDecoderModeToString(i) == _mode)
+			return i;
+	return std::nullopt;
+}
+
+}
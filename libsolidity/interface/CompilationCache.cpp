@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+optional<string> CompilationCache::load(util::h256 const& _key) const
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code errorCode;
+	if (!fs::is_regular_file(path, errorCode))
+		return nullopt;
+
+	try
+	{
+		return util::readFileAsString(path);
+	}
+	catch (...)
+	{
+		return nullopt;
+	}
+}
+
+void CompilationCache::store(util::h256 const& _key, string const& _data) const
+{
+	boost::system::error_code errorCode;
+	fs::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = m_directory / fs::unique_path(path.filename().string() + ".%%%%-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+		file << _data;
+		if (!file)
+		{
+			file.close();
+			fs::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+
+	fs::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		fs::remove(temporaryPath, errorCode);
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
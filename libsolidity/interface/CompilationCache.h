@@ -0,0 +1,59 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent on-disk cache of compilation results.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed cache that stores each entry in a separate file in a directory.
+ * The cache is only an optimization, so failures to read or write it are not reported
+ * and simply result in cache misses.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the data stored under @a _key or nullopt if there is no such entry.
+	std::optional<std::string> load(util::h256 const& _key) const;
+	/// Stores @a _data under @a _key, replacing a previous entry.
+	/// The entry is written to a temporary file first so that concurrent readers
+	/// never see partially written data.
+	void store(util::h256 const& _key, std::string const& _data) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
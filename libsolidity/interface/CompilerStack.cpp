@@ -45,6 +45,7 @@
 #include <libsolidity/analysis/ImmutableValidator.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTFusedVisitor.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/codegen/Compiler.h>
@@ -57,6 +58,8 @@
 #include <libsolidity/parsing/Parser.h>
 
 #include <libsolidity/codegen/ir/Common.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+#include <libsolidity/codegen/YulFunctionCache.h>
 #include <libsolidity/codegen/ir/IRGenerator.h>
 
 #include <libyul/YulString.h>
@@ -65,6 +68,14 @@
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/OptimisedObjectCache.h>
+#include <libyul/optimiser/OptimiserProfile.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMAssemblyCache.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -76,6 +87,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
@@ -85,6 +98,7 @@
 
 #include <utility>
 #include <map>
+#include <optional>
 #include <limits>
 #include <string>
 
@@ -114,35 +128,71 @@ CompilerStack::~CompilerStack()
 	TypeProvider::reset();
 }
 
-void CompilerStack::createAndAssignCallGraphs()
+vector<ContractDefinition const*> CompilerStack::contractsInSourceOrder() const
+{
+	vector<ContractDefinition const*> contracts;
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+				contracts.push_back(contract);
+	return contracts;
+}
+
+void CompilerStack::prepareConcurrentContractAnalysis()
 {
+	SimpleASTVisitor annotationCreator(
+		[](ASTNode const& _node) { _node.annotation(); return true; },
+		[](ASTNode const&) {}
+	);
 	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			source->ast->accept(annotationCreator);
+
+	for (ContractDefinition const* contract: contractsInSourceOrder())
 	{
-		if (!source->ast)
-			continue;
+		// Looking up functions by name initializes the lookup table used for virtual resolution.
+		contract->definedFunctions(string{});
+		contract->interfaceFunctionList();
+	}
+}
 
-		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
-		{
-			ContractDefinitionAnnotation& annotation =
-				m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
+void CompilerStack::createAndAssignCallGraphs()
+{
+	vector<ContractDefinition const*> contracts = contractsInSourceOrder();
 
-			annotation.creationCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildCreationGraph(*contract)
-			);
-			annotation.deployedCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildDeployedGraph(
-					*contract,
-					**annotation.creationCallGraph
-				)
-			);
+	auto createAndAssign = [&](size_t _index) {
+		ContractDefinition const* contract = contracts[_index];
+		ContractDefinitionAnnotation& annotation =
+			m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
+
+		annotation.creationCallGraph = make_unique<CallGraph>(
+			FunctionCallGraphBuilder::buildCreationGraph(*contract)
+		);
+		annotation.deployedCallGraph = make_unique<CallGraph>(
+			FunctionCallGraphBuilder::buildDeployedGraph(
+				*contract,
+				**annotation.creationCallGraph
+			)
+		);
 
-			solAssert(annotation.contractDependencies.empty(), "contractDependencies expected to be empty?!");
+		solAssert(annotation.contractDependencies.empty(), "contractDependencies expected to be empty?!");
 
-			annotation.contractDependencies = annotation.creationCallGraph->get()->bytecodeDependency;
+		annotation.contractDependencies = annotation.creationCallGraph->get()->bytecodeDependency;
 
-			for (auto const& [dependencyContract, referencee]: annotation.deployedCallGraph->get()->bytecodeDependency)
-				annotation.contractDependencies.emplace(dependencyContract, referencee);
-		}
+		for (auto const& [dependencyContract, referencee]: annotation.deployedCallGraph->get()->bytecodeDependency)
+			annotation.contractDependencies.emplace(dependencyContract, referencee);
+	};
+
+	if (m_parallelism <= 1)
+		for (size_t i = 0; i < contracts.size(); ++i)
+			createAndAssign(i);
+	else
+	{
+		util::Profiler* profiler = util::Profiler::active();
+		util::parallelFor(contracts.size(), m_parallelism, [&](size_t _index) {
+			util::ProfilerActivation profilerActivation(profiler, "");
+			createAndAssign(_index);
+		});
 	}
 }
 
@@ -218,6 +268,37 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setLazyFunctionBodies(bool _lazyFunctionBodies)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set lazy function bodies before parsing.");
+	m_lazyFunctionBodies = _lazyFunctionBodies;
+}
+
+void CompilerStack::setReuseParsedSources(bool _reuse)
+{
+	m_reuseParsedSources = _reuse;
+	if (!_reuse)
+		m_reusableSources.clear();
+}
+
+void CompilerStack::setReuseUnoptimisedIR(bool _reuse)
+{
+	m_reuseUnoptimisedIR = _reuse;
+	if (!_reuse)
+	{
+		m_unoptimisedIR.clear();
+		m_usedUnoptimisedIR.clear();
+	}
+}
+
+void CompilerStack::enableBatchedReads(bool _enable)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must enable batched reads before parsing.");
+	m_batchedReads = _enable;
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -261,6 +342,13 @@ void CompilerStack::setRevertStringBehaviour(RevertStrings _revertStrings)
 	m_revertStrings = _revertStrings;
 }
 
+void CompilerStack::setABIDecoderMode(ABIDecoderMode _abiDecoderMode)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must set ABI decoder mode before parsing.");
+	m_abiDecoderMode = _abiDecoderMode;
+}
+
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -282,6 +370,34 @@ void CompilerStack::selectDebugInfo(DebugInfoSelection _debugInfoSelection)
 	m_debugInfoSelection = _debugInfoSelection;
 }
 
+void CompilerStack::setParallelism(size_t _threads)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set parallelism before compilation.");
+	solAssert(_threads >= 1, "");
+	m_parallelism = _threads;
+}
+
+void CompilerStack::enableOptimiserProfiling(bool _enable)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must enable optimiser profiling before compiling.");
+	if (!_enable)
+		m_optimiserProfile.reset();
+	else if (!m_optimiserProfile)
+		m_optimiserProfile = make_unique<yul::OptimiserProfile>();
+}
+
+void CompilerStack::enableProfiling(bool _enable)
+{
+	if (m_stackState >= ParsedAndImported)
+		solThrow(CompilerError, "Must enable profiling before parsing.");
+	if (!_enable)
+		m_profiler.reset();
+	else if (!m_profiler)
+		m_profiler = make_unique<util::Profiler>();
+}
+
 void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _response)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -291,9 +407,33 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 
 void CompilerStack::reset(bool _keepSettings)
 {
+	if (m_reuseParsedSources && m_stackState >= ParsedAndImported && !m_importedSources)
+	{
+		SimpleASTVisitor analysisRemover(
+			[](ASTNode const& _node) { _node.clearAnalysis(); return true; },
+			[](ASTNode const&) {}
+		);
+		m_reusableSources.clear();
+		m_reusableSourcesEVMVersion = m_evmVersion;
+		for (auto& [path, source]: m_sources)
+			if (source.ast && source.parsedWithoutDiagnostics)
+			{
+				source.ast->accept(analysisRemover);
+				m_reusableSources[path] = std::move(source);
+			}
+	}
 	m_stackState = Empty;
 	m_hasError = false;
+	m_errorCountBeforeCodeGeneration.reset();
+	for (auto it = m_unoptimisedIR.begin(); it != m_unoptimisedIR.end();)
+		if (m_usedUnoptimisedIR.count(it->first))
+			++it;
+		else
+			it = m_unoptimisedIR.erase(it);
+	m_usedUnoptimisedIR.clear();
 	m_sources.clear();
+	m_sourceIndices.reset();
+	m_missingSources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
@@ -301,11 +441,18 @@ void CompilerStack::reset(bool _keepSettings)
 		m_importRemapper.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_lazyFunctionBodies = false;
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_generateOptimizedIR = true;
 		m_generateEwasm = false;
+		m_parallelism = 1;
+		m_batchedReads = false;
+		m_profiler.reset();
+		m_optimiserProfile.reset();
 		m_revertStrings = RevertStrings::Default;
+		m_abiDecoderMode = ABIDecoderMode::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
@@ -315,6 +462,10 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	if (m_profiler)
+		m_profiler->clear();
+	if (m_optimiserProfile)
+		m_optimiserProfile = make_unique<yul::OptimiserProfile>();
 	TypeProvider::reset();
 }
 
@@ -324,8 +475,9 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
+	m_sourceIndices.reset();
 	m_stackState = SourcesSet;
 }
 
@@ -334,26 +486,23 @@ bool CompilerStack::parse()
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
+	util::ProfilerActivation profilerActivation(m_profiler.get(), "");
+	util::ProfilerScope profilerScope("Parsing");
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
-
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
 
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
-	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
+	auto processParsedSource = [&](string const& _path) {
+		Source& source = m_sources[_path];
 		if (!source.ast)
 			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
-			source.ast->annotation().path = path;
+			source.ast->annotation().path = _path;
 
 			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
 			{
@@ -364,19 +513,117 @@ bool CompilerStack::parse()
 				// as seen globally.
 				import->annotation().absolutePath = applyRemapping(util::absolutePath(
 					import->path(),
-					path
-				), path);
+					_path
+				), _path);
 			}
 
 			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+				for (auto& newSource: loadMissingSources(*source.ast))
 				{
 					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
+					m_sources[newPath].charStream = make_shared<CharStream>(std::move(newSource.second), newPath);
 					sourcesToParse.push_back(newPath);
 				}
 		}
+	};
+
+	auto skipFunctionBodies = [&](string const& _path) {
+		return m_lazyFunctionBodies && !isRequestedSource(_path);
+	};
+
+	// Takes the AST of the previous compilation if the source did not change and shifts its
+	// node IDs so that they start at @a _firstNodeID, just like the IDs of a fresh parse.
+	auto reuseParsedSource = [&](string const& _path, int64_t _firstNodeID) -> bool {
+		auto reusable = m_reusableSources.find(_path);
+		if (
+			reusable == m_reusableSources.end() ||
+			m_reusableSourcesEVMVersion != m_evmVersion ||
+			reusable->second.functionBodiesSkipped != skipFunctionBodies(_path) ||
+			reusable->second.charStream->source() != m_sources[_path].charStream->source()
+		)
+			return false;
+		Source& source = m_sources[_path];
+		source.ast = std::move(reusable->second.ast);
+		source.functionBodiesSkipped = reusable->second.functionBodiesSkipped;
+		source.nodeIDCount = reusable->second.nodeIDCount;
+		source.parsedWithoutDiagnostics = true;
+		// The content is the same, so are its hashes.
+		source.keccak256HashCached = reusable->second.keccak256HashCached;
+		source.swarmHashCached = reusable->second.swarmHashCached;
+		source.ipfsUrlCached = std::move(reusable->second.ipfsUrlCached);
+		Parser::shiftNodeIDs(*source.ast, _firstNodeID - reusable->second.firstNodeID);
+		source.firstNodeID = _firstNodeID;
+		m_reusableSources.erase(reusable);
+		return true;
+	};
+
+	if (m_parallelism <= 1)
+	{
+		Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		{
+			Source& source = m_sources[sourcesToParse[i]];
+			if (reuseParsedSource(sourcesToParse[i], parser.lastNodeID()))
+				parser.skipNodeIDs(source.nodeIDCount);
+			else
+			{
+				size_t errorCount = m_errorReporter.errors().size();
+				source.firstNodeID = parser.lastNodeID();
+				source.functionBodiesSkipped = skipFunctionBodies(sourcesToParse[i]);
+				source.ast = parser.parse(*source.charStream, source.functionBodiesSkipped);
+				source.nodeIDCount = parser.lastNodeID() - source.firstNodeID;
+				source.parsedWithoutDiagnostics = m_errorReporter.errors().size() == errorCount;
+			}
+			processParsedSource(sourcesToParse[i]);
+		}
+	}
+	else
+	{
+		// Parses all sources that are known so far in parallel, each with its own parser and
+		// error reporter. Processing the results in order afterwards yields the same errors, the
+		// same read callback requests and, after shifting them, the same node IDs as parsing
+		// the sources one after the other with a single parser.
+		util::Profiler* profiler = util::Profiler::active();
+		int64_t lastNodeID = 0;
+		for (size_t waveStart = 0; waveStart < sourcesToParse.size();)
+		{
+			size_t const waveEnd = sourcesToParse.size();
+			vector<ErrorList> errors(waveEnd - waveStart);
+			vector<int64_t> nodeCounts(waveEnd - waveStart);
+			// Reused sources are moved to node ID zero here and shifted into place below,
+			// together with the freshly parsed ones.
+			vector<char> reused(waveEnd - waveStart, false);
+			for (size_t i = waveStart; i < waveEnd; ++i)
+				if (reuseParsedSource(sourcesToParse[i], 0))
+				{
+					reused[i - waveStart] = true;
+					nodeCounts[i - waveStart] = m_sources[sourcesToParse[i]].nodeIDCount;
+				}
+				else
+					m_sources[sourcesToParse[i]].functionBodiesSkipped = skipFunctionBodies(sourcesToParse[i]);
+			util::parallelFor(waveEnd - waveStart, m_parallelism, [&](size_t _index) {
+				if (reused[_index])
+					return;
+				util::ProfilerActivation profilerActivation(profiler, "");
+				ErrorReporter errorReporter(errors[_index]);
+				Parser parser{errorReporter, m_evmVersion, m_parserErrorRecovery};
+				Source& source = m_sources.at(sourcesToParse[waveStart + _index]);
+				source.ast = parser.parse(*source.charStream, source.functionBodiesSkipped);
+				source.nodeIDCount = nodeCounts[_index] = parser.lastNodeID();
+				source.parsedWithoutDiagnostics = errors[_index].empty();
+			});
+			for (size_t i = waveStart; i < waveEnd; ++i)
+			{
+				m_errorReporter.append(errors[i - waveStart]);
+				Source& source = m_sources[sourcesToParse[i]];
+				if (source.ast && lastNodeID > 0)
+					Parser::shiftNodeIDs(*source.ast, lastNodeID);
+				source.firstNodeID = lastNodeID;
+				lastNodeID += nodeCounts[i - waveStart];
+				processParsedSource(sourcesToParse[i]);
+			}
+			waveStart = waveEnd;
+		}
 	}
 
 	if (m_stopAfter <= Parsed)
@@ -386,6 +633,11 @@ bool CompilerStack::parse()
 	if (Error::containsErrors(m_errorReporter.errors()))
 		m_hasError = true;
 
+	// All sources are known now. Computing their indices here keeps later queries,
+	// which may come from multiple code generation threads, read-only.
+	m_sourceIndices.reset();
+	sourceIndices();
+
 	storeContractDefinitions();
 
 	return !m_hasError;
@@ -410,14 +662,74 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 	}
 	m_stackState = ParsedAndImported;
 	m_importedSources = true;
+	m_sourceIndices.reset();
+	sourceIndices();
 
 	storeContractDefinitions();
 }
 
+void CompilerStack::validateImmutables()
+{
+	vector<ContractDefinition const*> contracts = contractsInSourceOrder();
+	if (m_parallelism <= 1)
+	{
+		for (ContractDefinition const* contract: contracts)
+			ImmutableValidator(m_errorReporter, *contract).analyze();
+		return;
+	}
+
+	// Each contract reports to its own list. Appending the lists in source order results in
+	// the same errors as validating the contracts one after the other.
+	vector<ErrorList> errors(contracts.size());
+	vector<char> fatal(contracts.size(), false);
+	util::Profiler* profiler = util::Profiler::active();
+	util::parallelFor(contracts.size(), m_parallelism, [&](size_t _index) {
+		util::ProfilerActivation profilerActivation(profiler, "");
+		ErrorReporter errorReporter(errors[_index]);
+		try
+		{
+			ImmutableValidator(errorReporter, *contracts[_index]).analyze();
+		}
+		catch (FatalError const&)
+		{
+			fatal[_index] = true;
+		}
+	});
+	for (size_t i = 0; i < contracts.size(); ++i)
+	{
+		m_errorReporter.append(errors[i]);
+		if (fatal[i])
+			BOOST_THROW_EXCEPTION(FatalError());
+	}
+}
+
+vector<pair<string, CompilerStack::State>> const& CompilerStack::stopAfterStages()
+{
+	static vector<pair<string, State>> const stages{
+		{"parsing", Parsed},
+		{"nameResolution", NamesResolved},
+		{"typeChecking", TypesChecked},
+	};
+	return stages;
+}
+
 bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
+	util::ProfilerActivation profilerActivation(m_profiler.get(), "");
+	// Measures the individual analysis steps. Each of them ends when the next one starts.
+	optional<util::ProfilerScope> profilerScope;
+
+	auto finishAnalysis = [&](State _reachedState, bool _noErrors) {
+		profilerScope.reset();
+		m_stackState = _reachedState;
+		if (!_noErrors)
+			m_hasError = true;
+		return !m_hasError;
+	};
+
+	profilerScope.emplace("Scoper");
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
@@ -428,12 +740,14 @@ bool CompilerStack::analyze()
 
 	try
 	{
+		profilerScope.emplace("SyntaxChecker");
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
 		m_globalContext = make_shared<GlobalContext>();
+		profilerScope.emplace("NameAndTypeResolver");
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
@@ -449,22 +763,29 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
+		profilerScope.emplace("DocStringTagParser");
 		DocStringTagParser docStringTagParser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
 		// Requires DocStringTagParser
+		profilerScope.emplace("NameAndTypeResolver");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		profilerScope.emplace("DeclarationTypeChecker");
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
+		if (m_stopAfter <= NamesResolved)
+			return finishAnalysis(NamesResolved, noErrors);
+
 		// Requires DeclarationTypeChecker to have run
+		profilerScope.emplace("DocStringTagParser");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
@@ -473,6 +794,7 @@ bool CompilerStack::analyze()
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		profilerScope.emplace("ContractLevelChecker");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 		for (Source const* source: m_sourceOrder)
@@ -480,6 +802,7 @@ bool CompilerStack::analyze()
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
+		profilerScope.emplace("DocStringAnalyser");
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -492,14 +815,19 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		profilerScope.emplace("TypeChecker");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
+		if (m_stopAfter <= TypesChecked)
+			return finishAnalysis(TypesChecked, noErrors);
+
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			profilerScope.emplace("PostTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !postTypeChecker.check(*source->ast))
@@ -511,28 +839,37 @@ bool CompilerStack::analyze()
 		// Create & assign callgraphs and check for contract dependency cycles
 		if (noErrors)
 		{
+			if (m_parallelism > 1)
+			{
+				profilerScope.emplace("PrepareConcurrentContractAnalysis");
+				prepareConcurrentContractAnalysis();
+			}
+			profilerScope.emplace("FunctionCallGraph");
 			createAndAssignCallGraphs();
 			findAndReportCyclicContractDependencies();
 		}
 
 		if (noErrors)
+		{
+			profilerScope.emplace("PostTypeContractLevelChecker");
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 					noErrors = false;
+		}
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-							ImmutableValidator(m_errorReporter, *contract).analyze();
+		{
+			profilerScope.emplace("ImmutableValidator");
+			validateImmutables();
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			profilerScope.emplace("ControlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !cfg.constructFlow(*source->ast))
@@ -551,27 +888,38 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
-
-		if (noErrors)
-		{
-			// Check for state mutability in every function.
-			vector<ASTPointer<ASTNode>> ast;
+			// Checks for common mistakes, which mostly generates warnings, and checks the state
+			// mutability of every function. The two are independent and share a single walk
+			// over the AST. Each of them reports to its own error list, so that the errors can
+			// be merged into the order of running them one after the other, where the state
+			// mutability is only checked if the static analysis found no errors.
+			profilerScope.emplace("StaticAnalyzer, ViewPureChecker");
+			ErrorList staticAnalyzerErrors;
+			ErrorList viewPureCheckerErrors;
+			ErrorReporter staticAnalyzerErrorReporter(staticAnalyzerErrors);
+			ErrorReporter viewPureCheckerErrorReporter(viewPureCheckerErrors);
+			StaticAnalyzer staticAnalyzer(staticAnalyzerErrorReporter);
+			ViewPureChecker viewPureChecker({}, viewPureCheckerErrorReporter);
+			ASTFusedConstVisitor fusedVisitor({&staticAnalyzer, &viewPureChecker});
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
-					ast.push_back(source->ast);
+					source->ast->accept(fusedVisitor);
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			m_errorReporter.append(staticAnalyzerErrors);
+			if (Error::containsErrors(staticAnalyzerErrors))
 				noErrors = false;
+			else
+			{
+				m_errorReporter.append(viewPureCheckerErrors);
+				if (Error::containsErrors(viewPureCheckerErrors))
+					noErrors = false;
+			}
 		}
 
-		if (noErrors)
+		// The model checker needs the bodies of all called functions.
+		if (noErrors && !m_lazyFunctionBodies)
 		{
+			profilerScope.emplace("ModelChecker");
 			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
 			auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 			modelChecker.enableAllEnginesIfPragmaPresent(allSources);
@@ -589,11 +937,8 @@ bool CompilerStack::analyze()
 		noErrors = false;
 	}
 
-	m_stackState = AnalysisPerformed;
-	if (!noErrors)
-		m_hasError = true;
-
-	return !m_hasError;
+	// A fatal error may have ended the analysis before the requested stage.
+	return finishAnalysis(min(m_stopAfter, AnalysisPerformed), noErrors);
 }
 
 bool CompilerStack::parseAndAnalyze(State _stopAfter)
@@ -645,64 +990,180 @@ bool CompilerStack::compile(State _stopAfter)
 
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
+	if (m_lazyFunctionBodies)
+		solThrow(CompilerError, "Code generation requires function bodies to be parsed.");
+	m_errorCountBeforeCodeGeneration = m_errorList.size();
+
+	util::ProfilerActivation profilerActivation(m_profiler.get(), "");
+	yul::OptimiserProfile::Activation optimiserProfileActivation(m_optimiserProfile.get());
+	// Only used on this thread, generateEVMAssembliesInParallel splits the threads between its tasks.
+	yul::OptimiserSuite::ParallelismActivation optimiserParallelismActivation(m_parallelism);
+	// Contracts that create other contracts contain their Yul objects, so they are only optimised once.
+	yul::OptimisedObjectCache optimisedObjectCache;
+	yul::OptimisedObjectCache::Activation optimisedObjectCacheActivation(&optimisedObjectCache);
+	// The same holds for generating and optimising their EVM assembly.
+	yul::EVMAssemblyCache evmAssemblyCache;
+	yul::EVMAssemblyCache::Activation evmAssemblyCacheActivation(&evmAssemblyCache);
+	// The legacy code generator appends many identical inline assembly snippets.
+	InlineAssemblyCache inlineAssemblyCache;
+	InlineAssemblyCache::Activation inlineAssemblyCacheActivation(&inlineAssemblyCache);
+	// All contracts request the same utility functions, they are only generated once.
+	YulFunctionCache yulFunctionCache;
+	YulFunctionCache::Activation yulFunctionCacheActivation(&yulFunctionCache);
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
-				}
+					requestedContracts.push_back(contract);
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+
+	try
+	{
+		// IR generation works on the shared AST and type information, so it always
+		// runs sequentially. The EVM backend only works on the generated Yul code of
+		// each contract independently and can run on multiple threads.
+		if (m_viaIR && m_generateEvmBytecode && m_parallelism > 1)
+		{
+			for (ContractDefinition const* contract: requestedContracts)
+				generateIR(*contract);
+			generateEVMAssembliesInParallel(requestedContracts);
+		}
+
+		for (ContractDefinition const* contract: requestedContracts)
+		{
+			if (m_viaIR || m_generateIR || m_generateEwasm)
+				generateIR(*contract);
+			if (m_generateEvmBytecode)
+			{
+				if (m_viaIR)
+					generateEVMFromIR(*contract);
+				else
+					compileContract(*contract, otherCompilers);
+			}
+			if (m_generateEwasm)
+				generateEwasm(*contract);
+		}
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
+	if (m_profiler)
+		recordRetainedObjects();
 	return true;
 }
 
+void CompilerStack::resetCodeGeneration(OptimiserSettings _optimiserSettings, bool _viaIR)
+{
+	if (m_stackState < AnalysisPerformed || m_hasError)
+		solThrow(CompilerError, "Analysis was not successful.");
+	if (_optimiserSettings.runYulOptimiser != m_optimiserSettings.runYulOptimiser)
+		solThrow(CompilerError, "Cannot enable or disable the Yul optimiser after the analysis.");
+
+	if (m_errorCountBeforeCodeGeneration)
+		m_errorList.resize(*m_errorCountBeforeCodeGeneration);
+	m_errorCountBeforeCodeGeneration.reset();
+
+	for (auto& [name, contract]: m_contracts)
+	{
+		clearCompiledOutputs(contract);
+		contract.metadata.reset();
+		contract.compiledOutputsReleased = false;
+	}
+
+	m_optimiserSettings = std::move(_optimiserSettings);
+	m_viaIR = _viaIR;
+	m_stackState = AnalysisPerformed;
+}
+
+void CompilerStack::releaseCompiledOutputs(string const& _contractName)
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	// Other contracts only refer to the assemblies of the contracts they create through shared
+	// pointers, so their outputs are not affected.
+	Contract& releasedContract = m_contracts.at(contract(_contractName).contract->fullyQualifiedName());
+	clearCompiledOutputs(releasedContract);
+	releasedContract.compiledOutputsReleased = true;
+}
+
+void CompilerStack::clearCompiledOutputs(Contract& _contract)
+{
+	_contract.compiler.reset();
+	_contract.evmAssembly.reset();
+	_contract.evmRuntimeAssembly.reset();
+	_contract.object = {};
+	_contract.runtimeObject = {};
+	_contract.yulIR.clear();
+	_contract.yulIROptimized.clear();
+	_contract.yulIRObject.reset();
+	_contract.yulIROptimizedObject.reset();
+	_contract.yulIRFunctionExecutions.clear();
+	_contract.ewasm.clear();
+	_contract.ewasmObject = {};
+	_contract.irGasEstimates = Json::Value();
+	_contract.generatedSources.reset();
+	_contract.runtimeGeneratedSources.reset();
+	_contract.sourceMapping.reset();
+	_contract.runtimeSourceMapping.reset();
+}
+
+void CompilerStack::recordRetainedObjects() const
+{
+	solAssert(m_profiler);
+	size_t astNodes = 0;
+	for (auto const& [path, source]: m_sources)
+		astNodes += static_cast<size_t>(source.nodeIDCount);
+	m_profiler->recordRetainedObjects("", "AST nodes", astNodes);
+	m_profiler->recordRetainedObjects("", "Types", TypeProvider::size());
+	m_profiler->recordRetainedObjects("", "Yul strings", yul::YulStringRepository::size());
+
+	auto assemblyItems = [](shared_ptr<evmasm::Assembly> const& _assembly) -> size_t {
+		return _assembly ? _assembly->items().size() : 0;
+	};
+	for (auto const& [name, contract]: m_contracts)
+	{
+		if (size_t items = assemblyItems(contract.evmAssembly) + assemblyItems(contract.evmRuntimeAssembly))
+			m_profiler->recordRetainedObjects(name, "EVM assembly items", items);
+		if (size_t irSize = contract.yulIR.size() + contract.yulIROptimized.size())
+			m_profiler->recordRetainedObjects(name, "Yul IR bytes", irSize);
+		if (size_t bytecodeSize = contract.object.bytecode.size())
+			m_profiler->recordRetainedObjects(name, "Bytecode bytes", bytecodeSize);
+	}
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -741,7 +1202,7 @@ evmasm::AssemblyItems const* CompilerStack::assemblyItems(string const& _contrac
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& currentContract = contract(_contractName);
+	Contract const& currentContract = compiledContract(_contractName);
 	return currentContract.evmAssembly ? &currentContract.evmAssembly->items() : nullptr;
 }
 
@@ -750,7 +1211,7 @@ evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& currentContract = contract(_contractName);
+	Contract const& currentContract = compiledContract(_contractName);
 	return currentContract.evmRuntimeAssembly ? &currentContract.evmRuntimeAssembly->items() : nullptr;
 }
 
@@ -759,7 +1220,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
+	Contract const& c = compiledContract(_contractName);
 	util::LazyInit<Json::Value const> const& sources =
 		_runtime ?
 		c.runtimeGeneratedSources :
@@ -778,7 +1239,7 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 			if (!source.empty())
 			{
 				string sourceName = CompilerContext::yulUtilityFileName();
-				unsigned sourceIndex = sourceIndices()[sourceName];
+				unsigned sourceIndex = sourceIndices().at(sourceName);
 				ErrorList errors;
 				ErrorReporter errorReporter(errors);
 				CharStream charStream(source, sourceName);
@@ -802,7 +1263,7 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
+	Contract const& c = compiledContract(_contractName);
 	if (!c.sourceMapping)
 	{
 		if (auto items = assemblyItems(_contractName))
@@ -816,7 +1277,7 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
+	Contract const& c = compiledContract(_contractName);
 	if (!c.runtimeSourceMapping)
 	{
 		if (auto items = runtimeAssemblyItems(_contractName))
@@ -856,15 +1317,25 @@ string const& CompilerStack::yulIR(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIR;
+	return compiledContract(_contractName).yulIR;
 }
 
 string const& CompilerStack::yulIROptimized(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+	if (!(m_generateIR && m_generateOptimizedIR) && !m_generateEwasm)
+		solThrow(CompilerError, "Optimized IR generation was not enabled.");
+
+	return compiledContract(_contractName).yulIROptimized;
+}
+
+Json::Value const& CompilerStack::irGasEstimates(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimized;
+	return compiledContract(_contractName).irGasEstimates;
 }
 
 string const& CompilerStack::ewasm(string const& _contractName) const
@@ -872,7 +1343,7 @@ string const& CompilerStack::ewasm(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).ewasm;
+	return compiledContract(_contractName).ewasm;
 }
 
 evmasm::LinkerObject const& CompilerStack::ewasmObject(string const& _contractName) const
@@ -880,7 +1351,7 @@ evmasm::LinkerObject const& CompilerStack::ewasmObject(string const& _contractNa
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).ewasmObject;
+	return compiledContract(_contractName).ewasmObject;
 }
 
 evmasm::LinkerObject const& CompilerStack::object(string const& _contractName) const
@@ -888,7 +1359,7 @@ evmasm::LinkerObject const& CompilerStack::object(string const& _contractName) c
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).object;
+	return compiledContract(_contractName).object;
 }
 
 evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contractName) const
@@ -896,7 +1367,7 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).runtimeObject;
+	return compiledContract(_contractName).runtimeObject;
 }
 
 /// TODO: cache this string
@@ -905,7 +1376,7 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap cons
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& currentContract = contract(_contractName);
+	Contract const& currentContract = compiledContract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(m_debugInfoSelection, _sourceCodes);
 	else
@@ -918,7 +1389,7 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& currentContract = contract(_contractName);
+	Contract const& currentContract = compiledContract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
 	else
@@ -933,15 +1404,18 @@ vector<string> CompilerStack::sourceNames() const
 	return names;
 }
 
-map<string, unsigned> CompilerStack::sourceIndices() const
+map<string, unsigned> const& CompilerStack::sourceIndices() const
 {
-	map<string, unsigned> indices;
-	unsigned index = 0;
-	for (auto const& s: m_sources)
-		indices[s.first] = index++;
-	solAssert(!indices.count(CompilerContext::yulUtilityFileName()), "");
-	indices[CompilerContext::yulUtilityFileName()] = index++;
-	return indices;
+	if (!m_sourceIndices)
+	{
+		map<string, unsigned>& indices = m_sourceIndices.emplace();
+		unsigned index = 0;
+		for (auto const& s: m_sources)
+			indices[s.first] = index++;
+		solAssert(!indices.count(CompilerContext::yulUtilityFileName()), "");
+		indices[CompilerContext::yulUtilityFileName()] = index++;
+	}
+	return *m_sourceIndices;
 }
 
 Json::Value const& CompilerStack::contractABI(string const& _contractName) const
@@ -1100,7 +1574,7 @@ size_t CompilerStack::functionEntryPoint(
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	for (auto&& [name, data]: contract(_contractName).runtimeObject.functionDebugData)
+	for (auto&& [name, data]: compiledContract(_contractName).runtimeObject.functionDebugData)
 		if (data.sourceID == _function.id())
 			if (data.instructionIndex)
 				return *data.instructionIndex;
@@ -1134,30 +1608,61 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 	StringMap newSources;
 	try
 	{
-		for (auto const& node: _ast.nodes())
-			if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
-			{
-				string const& importPath = *import->annotation().absolutePath;
+		vector<ImportDirective const*> missingImports;
+		set<string> missingPaths;
+		for (auto const& import: ASTNode::filteredNodes<ImportDirective>(_ast.nodes()))
+		{
+			string const& importPath = *import->annotation().absolutePath;
+			if (!m_sources.count(importPath) && missingPaths.insert(importPath).second)
+				missingImports.push_back(import);
+		}
 
-				if (m_sources.count(importPath) || newSources.count(importPath))
-					continue;
+		// Sources returned by a batched request. Errors are still reported in import order below.
+		StringMap prefetchedSources;
+		Json::Value paths{Json::arrayValue};
+		if (m_batchedReads && m_readFile)
+			for (ImportDirective const* import: missingImports)
+				if (!m_missingSources.count(*import->annotation().absolutePath))
+					paths.append(*import->annotation().absolutePath);
+		if (paths.size() > 1)
+		{
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFiles), util::jsonCompactPrint(paths));
+			Json::Value contents;
+			if (result.success && util::jsonParseStrict(result.responseOrErrorMessage, contents) && contents.isObject())
+				for (string const& path: contents.getMemberNames())
+					if (missingPaths.count(path) && contents[path].isString())
+						prefetchedSources[path] = contents[path].asString();
+		}
 
-				ReadCallback::Result result{false, string("File not supplied initially.")};
-				if (m_readFile)
-					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
+		for (ImportDirective const* import: missingImports)
+		{
+			string const& importPath = *import->annotation().absolutePath;
 
-				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
-				else
-				{
-					m_errorReporter.parserError(
-						6275_error,
-						import->location(),
-						string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
-					);
-					continue;
-				}
+			if (auto prefetched = prefetchedSources.find(importPath); prefetched != prefetchedSources.end())
+			{
+				newSources[importPath] = std::move(prefetched->second);
+				continue;
+			}
+
+			ReadCallback::Result result{false, string("File not supplied initially.")};
+			if (auto missing = m_missingSources.find(importPath); missing != m_missingSources.end())
+				result.responseOrErrorMessage = missing->second;
+			else if (m_readFile)
+				result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
+
+			if (result.success)
+				newSources[importPath] = std::move(result.responseOrErrorMessage);
+			else
+			{
+				m_missingSources.emplace(importPath, result.responseOrErrorMessage);
+				m_errorReporter.parserError(
+					6275_error,
+					import->location(),
+					string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
+				);
+				continue;
 			}
+		}
 	}
 	catch (FatalError const&)
 	{
@@ -1166,6 +1671,39 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 	return newSources;
 }
 
+bool CompilerStack::sourcesUnchanged(StringMap const& _sources) const
+{
+	if (m_stackState < ParsedAndImported || !m_sourceJsons.empty())
+		return false;
+
+	for (auto const& [name, content]: _sources)
+	{
+		auto source = m_sources.find(name);
+		if (source == m_sources.end() || !source->second.charStream || source->second.charStream->source() != content)
+			return false;
+	}
+
+	auto readFile = [&](string const& _path) -> ReadCallback::Result {
+		if (!m_readFile)
+			return {false, string("File not supplied initially.")};
+		return m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), _path);
+	};
+
+	for (auto const& [name, source]: m_sources)
+		if (!_sources.count(name))
+		{
+			ReadCallback::Result result = readFile(name);
+			if (!result.success || !source.charStream || source.charStream->source() != result.responseOrErrorMessage)
+				return false;
+		}
+
+	for (auto const& missingSource: m_missingSources)
+		if (readFile(missingSource.first).success)
+			return false;
+
+	return true;
+}
+
 string CompilerStack::applyRemapping(string const& _path, string const& _context)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1307,9 +1845,12 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::ProfilerActivation profilerContext(_contract.fullyQualifiedName());
+	util::ProfilerScope profilerScope("Compiler");
+
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_abiDecoderMode);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1330,6 +1871,32 @@ void CompilerStack::compileContract(
 	assemble(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
 }
 
+namespace
+{
+/// Adds the CBOR metadata of @a _object and all its sub-objects to @a _cborMetadata,
+/// by the name of the object containing it.
+void collectCBORMetadata(yul::Object const& _object, map<string, bytes>& _cborMetadata)
+{
+	for (shared_ptr<yul::ObjectNode> const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<yul::Object const*>(subNode.get()))
+			collectCBORMetadata(*subObject, _cborMetadata);
+		else if (auto const* data = dynamic_cast<yul::Data const*>(subNode.get()))
+			if (data->name.str() == yul::Object::metadataName())
+				_cborMetadata[_object.name.str()] = data->data;
+}
+
+/// Replaces the CBOR metadata in @a _object and all its sub-objects by the one in @a _cborMetadata.
+/// The data nodes are replaced instead of modified, since they are shared by structural clones.
+void replaceCBORMetadata(yul::Object& _object, map<string, bytes> const& _cborMetadata)
+{
+	for (shared_ptr<yul::ObjectNode>& subNode: _object.subObjects)
+		if (auto subObject = dynamic_pointer_cast<yul::Object>(subNode))
+			replaceCBORMetadata(*subObject, _cborMetadata);
+		else if (subNode->name.str() == yul::Object::metadataName())
+			subNode = make_shared<yul::Data>(subNode->name, _cborMetadata.at(_object.name.str()));
+}
+}
+
 void CompilerStack::generateIR(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1340,6 +1907,9 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!compiledContract.yulIR.empty())
 		return;
 
+	util::ProfilerActivation profilerContext(_contract.fullyQualifiedName());
+	util::ProfilerScope profilerScope("IRGenerator");
+
 	if (!*_contract.sourceUnit().annotation().useABICoderV2)
 		m_errorReporter.warning(
 			2066_error,
@@ -1356,15 +1926,147 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		return;
 
 	map<ContractDefinition const*, string_view const> otherYulSources;
+	map<ContractDefinition const*, shared_ptr<yul::Object const>> otherYulObjects;
+	bool isDependency = false;
 	for (auto const& pair: m_contracts)
+	{
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
+		otherYulObjects.emplace(pair.second.contract, pair.second.yulIRObject);
+		isDependency = isDependency || pair.second.contract->annotation().contractDependencies.count(&_contract);
+	}
+
+	// The optimizer only runs if the optimized IR itself is requested or if code is generated from it.
+	bool const optimize =
+		(m_generateIR && m_generateOptimizedIR) ||
+		m_generateEwasm ||
+		(m_viaIR && m_generateEvmBytecode);
+	shared_ptr<yul::Object> optimizedObject;
+	optional<util::h256> unoptimisedIRKey;
+	if (m_reuseUnoptimisedIR)
+		unoptimisedIRKey = this->unoptimisedIRKey(_contract);
+	if (auto reusable = unoptimisedIRKey ? m_unoptimisedIR.find(*unoptimisedIRKey) : m_unoptimisedIR.end(); reusable != m_unoptimisedIR.end())
+	{
+		tie(compiledContract.yulIR, compiledContract.yulIRObject, optimizedObject) =
+			reuseUnoptimisedIR(reusable->second, isDependency, optimize);
+		compiledContract.yulIRFunctionExecutions = reusable->second.functionExecutions;
+	}
+	else
+	{
+		IRGenerator generator(
+			m_evmVersion,
+			m_revertStrings,
+			m_abiDecoderMode,
+			m_optimiserSettings,
+			sourceIndices(),
+			m_debugInfoSelection,
+			this
+		);
+		shared_ptr<yul::Object const> unoptimizedObject;
+		tie(compiledContract.yulIR, unoptimizedObject, optimizedObject) = generator.run(
+			_contract,
+			createCBORMetadata(compiledContract, /* _forIR */ true),
+			otherYulSources,
+			otherYulObjects,
+			isDependency || unoptimisedIRKey.has_value(),
+			optimize
+		);
+		compiledContract.yulIRFunctionExecutions = generator.functionExecutions();
+		if (unoptimisedIRKey)
+		{
+			UnoptimisedIR& unoptimisedIR = m_unoptimisedIR[*unoptimisedIRKey];
+			unoptimisedIR.yulIR = compiledContract.yulIR;
+			unoptimisedIR.object = unoptimizedObject;
+			unoptimisedIR.functionExecutions = compiledContract.yulIRFunctionExecutions;
+			unoptimisedIR.cborMetadata.clear();
+			collectCBORMetadata(*unoptimizedObject, unoptimisedIR.cborMetadata);
+		}
+		if (isDependency)
+			compiledContract.yulIRObject = move(unoptimizedObject);
+	}
+	if (unoptimisedIRKey)
+		m_usedUnoptimisedIR.insert(*unoptimisedIRKey);
+
+	// The EVM backend can continue to work on the optimized object, unless debug info was deselected.
+	// The printed code does not contain that debug info, so it has to be reparsed in that case
+	// to make sure that it does not end up in the bytecode.
+	bool const keepObject =
+		m_viaIR &&
+		m_generateEvmBytecode &&
+		m_debugInfoSelection.location &&
+		m_debugInfoSelection.astID;
+	if (optimizedObject && (!keepObject || m_generateIR || m_generateEwasm))
+		compiledContract.yulIROptimized = optimizedObject->toString(
+			&yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion),
+			m_debugInfoSelection,
+			this
+		) + "\n";
+	if (keepObject)
+		compiledContract.yulIROptimizedObject = move(optimizedObject);
+}
+
+util::h256 CompilerStack::unoptimisedIRKey(ContractDefinition const& _contract) const
+{
+	// The IR contains the AST IDs and the source indices, which are only the same
+	// if all sources are the same.
+	ostringstream key;
+	key << _contract.fullyQualifiedName() << "\n";
+	for (Source const* source: m_sourceOrder)
+		key << source->charStream->name() << "\n" << util::keccak256(source->charStream->source()).hex() << "\n";
+	key << m_evmVersion.name() << "\n";
+	key << revertStringsToString(m_revertStrings) << "\n";
+	key << static_cast<int>(m_abiDecoderMode) << "\n";
+	key << m_debugInfoSelection << "\n";
+	// Decides whether the metadata replaced in reuseUnoptimisedIR() is empty.
+	key << static_cast<int>(m_metadataFormat) << "\n";
+	// The only optimiser settings the IR generator uses.
+	key << functionDispatchToString(m_optimiserSettings.functionDispatch) << "\n";
+	key << m_optimiserSettings.expectedExecutionsPerDeployment << "\n";
+	for (auto const& [name, executions]: m_optimiserSettings.executionProfile)
+		key << name << ":" << executions << "\n";
+	for (ExperimentalOptimisation optimisation: m_optimiserSettings.experimentalOptimisations)
+		key << experimentalOptimisationToString(optimisation) << "\n";
+	return util::keccak256(key.str());
+}
+
+tuple<string, shared_ptr<yul::Object const>, shared_ptr<yul::Object>> CompilerStack::reuseUnoptimisedIR(
+	UnoptimisedIR const& _ir,
+	bool _keepUnoptimizedObject,
+	bool _optimize
+) const
+{
+	// The metadata of this contract and of the contracts it creates has to match the current settings.
+	map<string, bytes> cborMetadata;
+	for (auto const& [name, contract]: m_contracts)
+		if (contract.contract->canBeDeployed())
+		{
+			string objectName = IRNames::deployedObject(*contract.contract);
+			if (_ir.cborMetadata.count(objectName))
+				cborMetadata[objectName] = createCBORMetadata(contract, /* _forIR */ true);
+		}
+	solAssert(cborMetadata.size() == _ir.cborMetadata.size());
+
+	string ir = _ir.yulIR;
+	for (auto const& [objectName, metadata]: _ir.cborMetadata)
+		if (!metadata.empty())
+			boost::replace_all(ir, util::toHex(metadata), util::toHex(cborMetadata.at(objectName)));
+	shared_ptr<yul::Object> object = _ir.object->structuralClone();
+	replaceCBORMetadata(*object, cborMetadata);
+
+	shared_ptr<yul::Object const> unoptimizedObject;
+	if (_keepUnoptimizedObject)
+		unoptimizedObject = object->structuralClone();
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, sourceIndices(), m_debugInfoSelection, this);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
-		_contract,
-		createCBORMetadata(compiledContract, /* _forIR */ true),
-		otherYulSources
+	yul::YulStack asmStack(
+		m_evmVersion,
+		yul::YulStack::Language::StrictAssembly,
+		m_optimiserSettings.withFunctionExecutions(_ir.functionExecutions),
+		m_debugInfoSelection
 	);
+	solAssert(asmStack.analyzeObject(object));
+	if (!_optimize)
+		return {move(ir), move(unoptimizedObject), nullptr};
+	asmStack.optimize();
+	return {move(ir), move(unoptimizedObject), asmStack.parserResult()};
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1377,26 +2079,138 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	util::ProfilerActivation profilerContext(_contract.fullyQualifiedName());
+	// The assemblies might have already been generated by generateEVMAssembliesInParallel.
+	if (!compiledContract.evmAssembly)
+		compileIRToEVMAssembly(compiledContract);
+	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+}
+
+void CompilerStack::generateEVMAssembliesInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		solThrow(CompilerError, "Called generateEVMAssembliesInParallel with errors.");
+
+	vector<Contract*> contractsToCompile;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		if (!contract->canBeDeployed())
+			continue;
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		if (!compiledContract.evmAssembly)
+			contractsToCompile.push_back(&compiledContract);
+	}
+
+	// Every task only touches its own Contract object, so no further synchronization is needed.
+	util::Profiler* profiler = util::Profiler::active();
+	yul::OptimisedObjectCache* optimisedObjectCache = yul::OptimisedObjectCache::active();
+	yul::EVMAssemblyCache* evmAssemblyCache = yul::EVMAssemblyCache::active();
+	size_t const threadsPerContract = max<size_t>(1, m_parallelism / max<size_t>(1, contractsToCompile.size()));
+	util::parallelFor(contractsToCompile.size(), m_parallelism, [&](size_t _index) {
+		util::ProfilerActivation profilerActivation(profiler, "");
+		yul::OptimiserSuite::ParallelismActivation optimiserParallelismActivation(threadsPerContract);
+		yul::OptimiserProfile::Activation optimiserProfileActivation(m_optimiserProfile.get());
+		yul::OptimisedObjectCache::Activation optimisedObjectCacheActivation(optimisedObjectCache);
+		yul::EVMAssemblyCache::Activation evmAssemblyCacheActivation(evmAssemblyCache);
+		compileIRToEVMAssembly(*contractsToCompile[_index]);
+	});
+}
+
+namespace
+{
+
+Json::Value irGasEstimateToJson(yul::ControlFlowGasEstimator::Estimate const& _estimate)
+{
+	Json::Value estimate(Json::objectValue);
+	estimate["min"] = util::toString(_estimate.min);
+	estimate["typical"] = util::toString(_estimate.typical);
+	estimate["max"] = _estimate.max ? util::toString(*_estimate.max) : "infinite";
+	estimate["loops"] = _estimate.loops;
+	return estimate;
+}
+
+/// @returns the gas estimates for the creation code of @a _object and for the external functions
+/// of @a _contract in the deployed sub-object @a _deployedName.
+Json::Value estimateIRGas(
+	yul::Object const& _object,
+	string const& _deployedName,
+	ContractDefinition const& _contract,
+	yul::EVMDialect const& _dialect
+)
+{
+	solAssert(_object.code && _object.analysisInfo, "");
+	Json::Value output(Json::objectValue);
+
+	unique_ptr<yul::CFG> creationCFG = yul::ControlFlowGraphBuilder::build(*_object.analysisInfo, _dialect, *_object.code);
+	output["creation"] = irGasEstimateToJson(yul::ControlFlowGasEstimator(*creationCFG, _dialect).run());
+
+	yul::Object const* deployedObject = nullptr;
+	if (size_t const* index = util::valueOrNullptr(_object.subIndexByName, yul::YulString(_deployedName)))
+		deployedObject = dynamic_cast<yul::Object const*>(_object.subObjects.at(*index).get());
+	if (!deployedObject || !deployedObject->code || !deployedObject->analysisInfo)
+		return output;
+
+	map<util::FixedHash<4>, FunctionTypePointer> interfaceFunctions = _contract.interfaceFunctions();
+	set<u256> selectors;
+	for (auto const& function: interfaceFunctions)
+		selectors.insert(u256(util::FixedHash<4>::Arith(function.first)));
+
+	unique_ptr<yul::CFG> deployedCFG = yul::ControlFlowGraphBuilder::build(
+		*deployedObject->analysisInfo,
+		_dialect,
+		*deployedObject->code
+	);
+	yul::ControlFlowGasEstimator estimator(*deployedCFG, _dialect);
+	Json::Value externalFunctions(Json::objectValue);
+	for (auto const& [selector, function]: interfaceFunctions)
+		if (auto estimate = estimator.run(u256(util::FixedHash<4>::Arith(selector)), selectors))
+			externalFunctions[function->externalSignature()] = irGasEstimateToJson(*estimate);
+	if (!externalFunctions.empty())
+		output["external"] = externalFunctions;
+	return output;
+}
+
+}
+
+void CompilerStack::compileIRToEVMAssembly(Contract& _compiledContract) const
+{
+	util::ProfilerActivation profilerContext(_compiledContract.contract->fullyQualifiedName());
 	yul::YulStack stack(
 		m_evmVersion,
 		yul::YulStack::Language::StrictAssembly,
-		m_optimiserSettings,
+		m_optimiserSettings.withFunctionExecutions(_compiledContract.yulIRFunctionExecutions),
 		m_debugInfoSelection
 	);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	if (_compiledContract.yulIROptimizedObject)
+	{
+		bool analysisSuccessful = stack.analyzeObject(move(_compiledContract.yulIROptimizedObject));
+		solAssert(analysisSuccessful, "");
+		_compiledContract.yulIROptimizedObject.reset();
+	}
+	else
+	{
+		// Re-parse the Yul IR in EVM dialect
+		solAssert(!_compiledContract.yulIROptimized.empty(), "");
+		stack.parseAndAnalyze("", _compiledContract.yulIROptimized);
+	}
 	stack.optimize();
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
-	string deployedName = IRNames::deployedObject(_contract);
+	string deployedName = IRNames::deployedObject(*_compiledContract.contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	if (m_generateIRGasEstimates)
+		_compiledContract.irGasEstimates = estimateIRGas(
+			*stack.parserResult(),
+			deployedName,
+			*_compiledContract.contract,
+			yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion)
+		);
+	tie(_compiledContract.evmAssembly, _compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
 }
 
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
@@ -1413,6 +2227,9 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	if (!compiledContract.ewasm.empty())
 		return;
 
+	util::ProfilerActivation profilerContext(_contract.fullyQualifiedName());
+	util::ProfilerScope profilerScope("Ewasm");
+
 	// Re-parse the Yul IR in EVM dialect
 	yul::YulStack stack(
 		m_evmVersion,
@@ -1465,6 +2282,14 @@ CompilerStack::Contract const& CompilerStack::contract(string const& _contractNa
 	solThrow(CompilerError, "Contract \"" + _contractName + "\" not found.");
 }
 
+CompilerStack::Contract const& CompilerStack::compiledContract(string const& _contractName) const
+{
+	Contract const& compiledContract = contract(_contractName);
+	if (compiledContract.compiledOutputsReleased)
+		solThrow(CompilerError, "The compiled outputs of contract \"" + _contractName + "\" were already released.");
+	return compiledContract;
+}
+
 CompilerStack::Source const& CompilerStack::source(string const& _sourceName) const
 {
 	auto it = m_sources.find(_sourceName);
@@ -1510,11 +2335,18 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	if (!m_optimiserSettings.executionProfile.empty())
+	{
+		meta["settings"]["optimizer"]["profile"] = Json::objectValue;
+		for (auto const& [name, executions]: m_optimiserSettings.executionProfile)
+			meta["settings"]["optimizer"]["profile"][name] = Json::Value(Json::LargestUInt(executions));
+	}
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.executionProfile.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1531,11 +2363,23 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
+		if (m_optimiserSettings.functionDispatch != FunctionDispatch::Default)
+			details["dispatcher"] = functionDispatchToString(m_optimiserSettings.functionDispatch);
+		if (!m_optimiserSettings.experimentalOptimisations.empty())
+		{
+			details["experimental"] = Json::arrayValue;
+			for (ExperimentalOptimisation optimisation: m_optimiserSettings.experimentalOptimisations)
+				details["experimental"].append(experimentalOptimisationToString(optimisation));
+		}
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+			if (m_optimiserSettings.optimizeInlineAssemblyStack)
+				details["yulDetails"]["inlineAssemblyStack"] = true;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+			if (m_optimiserSettings.yulOptimiserBudget)
+				details["yulDetails"]["budget"] = Json::UInt64(*m_optimiserSettings.yulOptimiserBudget);
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1544,6 +2388,9 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	if (m_revertStrings != RevertStrings::Default)
 		meta["settings"]["debug"]["revertStrings"] = revertStringsToString(m_revertStrings);
 
+	if (m_abiDecoderMode != ABIDecoderMode::Default)
+		meta["settings"]["abiCoder"]["decoderMode"] = abiDecoderModeToString(m_abiDecoderMode);
+
 	if (m_metadataLiteralSources)
 		meta["settings"]["metadata"]["useLiteralContent"] = true;
 
@@ -29,6 +29,7 @@
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/DebugSettings.h>
 
 #include <libsolidity/formal/ModelCheckerSettings.h>
@@ -46,6 +47,7 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/Profiler.h>
 
 #include <json/json.h>
 
@@ -54,6 +56,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace solidity::langutil
@@ -62,6 +65,12 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+struct Object;
+class OptimiserProfile;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -101,10 +110,17 @@ public:
 		SourcesSet,
 		Parsed,
 		ParsedAndImported,
+		NamesResolved, ///< Only reached when stopping after name resolution, which includes the types of declarations.
+		TypesChecked, ///< Only reached when stopping after the type checker.
 		AnalysisPerformed,
 		CompilationSuccessful
 	};
 
+	/// @returns the names of the stages after which compilation can be stopped, in the order in
+	/// which they run, together with the state reached by stopping there.
+	/// These are the values of `--stop-after` and of `settings.stopAfter` in Standard JSON.
+	static std::vector<std::pair<std::string, State>> const& stopAfterStages();
+
 	enum class MetadataFormat {
 		WithReleaseVersionTag,
 		WithPrereleaseVersionTag,
@@ -157,6 +173,11 @@ public:
 	/// Sets whether to strip revert strings, add additional strings or do nothing at all.
 	void setRevertStringBehaviour(RevertStrings _revertStrings);
 
+	/// Sets whether ABI decoders are specialised for every combination of types or shared
+	/// between types that are decoded in the same way.
+	/// Must be set before parsing.
+	void setABIDecoderMode(ABIDecoderMode _abiDecoderMode);
+
 	/// Set whether or not parser error is desired.
 	/// When called without an argument it will revert to the default.
 	/// Must be set before parsing.
@@ -169,6 +190,26 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets whether the bodies of functions and modifiers in sources that are not requested
+	/// (see setRequestedContractNames) are skipped by the parser. Their declarations are still
+	/// available for name and type resolution, but their bodies are not analysed, so this
+	/// cannot be combined with code generation or the model checker.
+	/// Must be set before parsing.
+	void setLazyFunctionBodies(bool _lazyFunctionBodies);
+
+	/// Sets whether the ASTs of sources that parsed without any errors or warnings are kept
+	/// across @a reset and used again instead of parsing a source whose content did not change.
+	/// Their analysis annotations are dropped, only the result of parsing is reused.
+	/// Not affected by @a reset.
+	void setReuseParsedSources(bool _reuse);
+
+	/// Sets whether the unoptimised IR of every contract is kept across @a reset and
+	/// @a resetCodeGeneration and used again instead of generating it, if neither the sources
+	/// nor the settings the IR generator depends on changed. Changing only the optimiser steps,
+	/// for example, then only runs the analysis and the optimiser again.
+	/// Not affected by @a reset.
+	void setReuseUnoptimisedIR(bool _reuse);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -190,11 +231,41 @@ public:
 	void enableEvmBytecodeGeneration(bool _enable = true) { m_generateEvmBytecode = _enable; }
 
 	/// Enable generation of Yul IR code.
-	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
+	/// The optimized IR is only generated if @a _optimized is true or if Ewasm or EVM bytecode
+	/// are generated from the IR, which skips the Yul optimizer when only the IR is needed.
+	void enableIRGeneration(bool _enable = true, bool _optimized = true)
+	{
+		m_generateIR = _enable;
+		m_generateOptimizedIR = _optimized;
+	}
 
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable the static gas estimation on the optimized Yul code of contracts compiled via IR.
+	void enableIRGasEstimation(bool _enable = true) { m_generateIRGasEstimates = _enable; }
+
+	/// Enables requesting all missing imports of a source unit with a single read callback
+	/// invocation of kind ReadCallback::Kind::ReadFiles before falling back to single files.
+	/// Must be set before parsing.
+	void enableBatchedReads(bool _enable = true);
+
+	/// Sets the maximum number of threads used during code generation.
+	/// The translation of the optimized IR of independent contracts into EVM assembly is
+	/// parallelized and the Yul optimiser applies intra-procedural steps to multiple functions
+	/// at the same time, i.e. this has hardly any effect unless the IR pipeline is used.
+	/// Must be set before compiling.
+	void setParallelism(size_t _threads);
+
+	/// Enables or disables recording of wall time and memory usage of the compilation phases.
+	/// Must be set before parsing.
+	void enableProfiling(bool _enable = true);
+
+	/// Enables or disables the collection of statistics about all Yul optimiser step invocations
+	/// (see yul::OptimiserProfile). This slows down the optimiser considerably.
+	/// Must be set before compiling.
+	void enableOptimiserProfiling(bool _enable = true);
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -231,16 +302,34 @@ public:
 	/// @returns false on error.
 	bool parseAndAnalyze(State _stopAfter = State::CompilationSuccessful);
 
+	/// @returns true if the sources were already parsed and @a _sources, together with all files
+	/// loaded through the read callback, are identical to the ones used for that.
+	/// The loaded files are read again for the comparison. If this returns true, resetting the
+	/// stack and processing @a _sources again with the same settings would produce the same result.
+	bool sourcesUnchanged(StringMap const& _sources) const;
+
 	/// Compiles the source units that were previously added and parsed.
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Discards the generated code, everything derived from it and the errors reported during
+	/// code generation and returns to the state after the analysis. Afterwards, compile() generates
+	/// the code again with the given optimiser settings and pipeline, without repeating the analysis.
+	/// The settings the analysis depends on, i.e. the EVM version and whether the Yul optimiser
+	/// is enabled, cannot be changed this way.
+	void resetCodeGeneration(OptimiserSettings _optimiserSettings, bool _viaIR);
+
+	/// Frees the generated code and the intermediate representations of @a _contractName once
+	/// its outputs were retrieved. Afterwards, only the outputs derived from the AST, e.g. the
+	/// ABI, the documentation and the metadata, can be queried for this contract.
+	void releaseCompiledOutputs(std::string const& _contractName);
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
 	/// @returns a mapping assigning each source name its index inside the vector returned
 	/// by sourceNames().
-	std::map<std::string, unsigned> sourceIndices() const;
+	std::map<std::string, unsigned> const& sourceIndices() const;
 
 	/// @returns the previously used character stream, useful for counting lines during error reporting.
 	langutil::CharStream const& charStream(std::string const& _sourceName) const override;
@@ -256,6 +345,12 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the recorded profiling data or nullptr if profiling is not enabled.
+	util::Profiler const* profiler() const { return m_profiler.get(); }
+
+	/// @returns the statistics about the Yul optimiser steps or nullptr if optimiser profiling is not enabled.
+	yul::OptimiserProfile const* optimiserProfile() const { return m_optimiserProfile.get(); }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -269,6 +364,8 @@ public:
 	std::string const& yulIR(std::string const& _contractName) const;
 
 	/// @returns the optimized IR representation of a contract.
+	/// Only available if optimized IR or Ewasm generation was enabled, because the EVM backend
+	/// does not need the textual representation. Throws a CompilerError otherwise.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
 	/// @returns the Ewasm text representation of a contract.
@@ -344,6 +441,11 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns a JSON representing the gas usage for contract creation and external functions
+	/// estimated on the optimized Yul code, or null if the contract was not compiled via IR
+	/// or the estimation was not enabled.
+	Json::Value const& irGasEstimates(std::string const& _contractName) const;
+
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	/// This is mostly a workaround to avoid bytecode and gas differences between compiler builds
 	/// caused by differences in metadata. Should only be used for testing.
@@ -358,6 +460,14 @@ private:
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
+		/// Number of node IDs in use before the parser created the nodes of @a ast
+		/// and the number of IDs it used for them.
+		int64_t firstNodeID = 0;
+		int64_t nodeIDCount = 0;
+		/// Whether parsing the source resulted in neither errors nor warnings.
+		bool parsedWithoutDiagnostics = false;
+		/// Whether the parser skipped the bodies of functions and modifiers.
+		bool functionBodiesSkipped = false;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
@@ -375,8 +485,15 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
 		std::string yulIROptimized; ///< Optimized Yul IR code.
+		/// Unoptimized Yul IR as an object, only kept if other contracts can create this one.
+		std::shared_ptr<yul::Object const> yulIRObject;
+		/// Optimized Yul IR as an analyzed object. Only kept until it is consumed by the EVM backend.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
+		/// Expected executions of Yul functions from optimizer hints in the NatSpec of functions.
+		std::map<std::string, size_t> yulIRFunctionExecutions;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
+		Json::Value irGasEstimates; ///< Gas estimates on the optimized Yul code.
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json::Value const> abi;
 		util::LazyInit<Json::Value const> storageLayout;
@@ -386,13 +503,35 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Set by releaseCompiledOutputs().
+		bool compiledOutputsReleased = false;
 	};
 
+	/// Unoptimised IR of a contract kept for setReuseUnoptimisedIR.
+	struct UnoptimisedIR
+	{
+		std::string yulIR;
+		/// The parsed IR including the objects of the contracts it creates.
+		std::shared_ptr<yul::Object const> object;
+		std::map<std::string, size_t> functionExecutions;
+		/// The CBOR metadata contained in @a object and @a yulIR, by the name of the object containing it.
+		/// It depends on all settings and is replaced when the IR is used again.
+		std::map<std::string, bytes> cborMetadata;
+	};
+
+	/// @returns the contracts of all sources in source order.
+	std::vector<ContractDefinition const*> contractsInSourceOrder() const;
+	/// Fills the caches the AST creates on first use and that the analysis of one contract can
+	/// reach from other contracts, i.e. the annotations and the function lookup tables of
+	/// contracts. Afterwards, contracts can be analysed on multiple threads.
+	void prepareConcurrentContractAnalysis();
 	void createAndAssignCallGraphs();
 	void findAndReportCyclicContractDependencies();
+	/// Runs the ImmutableValidator on all contracts, on multiple threads if m_parallelism allows it.
+	void validateImmutables();
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
-	/// @a m_readFile
+	/// @a m_readFile, in a single batch if m_batchedReads is set.
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
@@ -423,14 +562,40 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Reports the number of AST nodes, types, Yul strings and the size of the generated code
+	/// of every contract to the profiler.
+	void recordRetainedObjects() const;
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
+	/// @returns the key of the unoptimised IR of @a _contract, which covers the sources and
+	/// the settings the IR generator depends on, except for the CBOR metadata.
+	util::h256 unoptimisedIRKey(ContractDefinition const& _contract) const;
+	/// @returns @a _ir with the CBOR metadata of the current settings, the unoptimised object
+	/// if @a _keepUnoptimizedObject is set and the optimised object if @a _optimize is set.
+	std::tuple<std::string, std::shared_ptr<yul::Object const>, std::shared_ptr<yul::Object>> reuseUnoptimisedIR(
+		UnoptimisedIR const& _ir,
+		bool _keepUnoptimizedObject,
+		bool _optimize
+	) const;
 
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Runs the Yul optimiser and the EVM code transform for all given contracts on up to
+	/// m_parallelism threads and stores the resulting assemblies. They are assembled later,
+	/// sequentially, by generateEVMFromIR.
+	/// Depends on output generated by generateIR.
+	void generateEVMAssembliesInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Compiles the optimized IR of @a _contract into creation and deployed assemblies and stores them.
+	/// Consumes the optimized Yul object if there is one and falls back to parsing the optimized IR otherwise.
+	/// Only accesses the state of @a _contract and does not report errors, so it can be called
+	/// for different contracts concurrently.
+	void compileIRToEVMAssembly(Contract& _compiledContract) const;
+
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
@@ -442,6 +607,11 @@ private:
 	/// @returns the contract object for the given @a _contractName.
 	/// Can only be called after state is CompilationSuccessful.
 	Contract const& contract(std::string const& _contractName) const;
+	/// @returns the contract object for the given @a _contractName and throws if its compiled
+	/// outputs were released.
+	Contract const& compiledContract(std::string const& _contractName) const;
+	/// Discards the generated code of @a _contract and everything derived from it.
+	static void clearCompiledOutputs(Contract& _contract);
 
 	/// @returns the source object for the given @a _sourceName.
 	/// Can only be called after state is SourcesSet.
@@ -485,6 +655,7 @@ private:
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
+	ABIDecoderMode m_abiDecoderMode = ABIDecoderMode::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
 	langutil::EVMVersion m_evmVersion;
@@ -492,10 +663,26 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_generateOptimizedIR = true;
 	bool m_generateEwasm = false;
+	bool m_generateIRGasEstimates = false;
+	size_t m_parallelism = 1;
+	bool m_batchedReads = false;
+	std::unique_ptr<util::Profiler> m_profiler;
+	std::unique_ptr<yul::OptimiserProfile> m_optimiserProfile;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
+	bool m_reuseParsedSources = false;
+	/// Sources of the previous compilation whose ASTs can be used again if their content
+	/// has not changed, together with the EVM version they were parsed for.
+	std::map<std::string, Source> m_reusableSources;
+	langutil::EVMVersion m_reusableSourcesEVMVersion;
+	/// Cache of @a sourceIndices(). Recomputed once parsing or importing has added all sources.
+	mutable std::optional<std::map<std::string, unsigned>> m_sourceIndices;
+	/// Imports that could not be loaded through the read callback, with the error message it returned.
+	/// Further imports of the same path report the same error without invoking the callback again.
+	std::map<std::string, std::string> m_missingSources;
 	// if imported, store AST-JSONS for each filename
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
@@ -506,10 +693,18 @@ private:
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Number of errors and warnings reported before the code generation started, if it did.
+	std::optional<size_t> m_errorCountBeforeCodeGeneration;
+	bool m_reuseUnoptimisedIR = false;
+	/// Unoptimised IR of the contracts, by unoptimisedIRKey(). Only entries that were used
+	/// since the last @a reset are kept.
+	std::map<util::h256, UnoptimisedIR> m_unoptimisedIR;
+	std::set<util::h256> m_usedUnoptimisedIR;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
 	bool m_parserErrorRecovery = false;
+	bool m_lazyFunctionBodies = false;
 	State m_stackState = Empty;
 	bool m_importedSources = false;
 	/// Whether or not there has been an error during processing.
@@ -69,6 +69,7 @@ void FileReader::setBasePath(boost::filesystem::path const& _path)
 	}
 	else
 		m_basePath = normalizeCLIPathForVFS(_path);
+	m_normalizedAllowedPaths.reset();
 }
 
 void FileReader::addIncludePath(boost::filesystem::path const& _path)
@@ -76,12 +77,14 @@ void FileReader::addIncludePath(boost::filesystem::path const& _path)
 	solAssert(!m_basePath.empty(), "");
 	solAssert(!_path.empty(), "");
 	m_includePaths.push_back(normalizeCLIPathForVFS(_path));
+	m_normalizedAllowedPaths.reset();
 }
 
 void FileReader::allowDirectory(boost::filesystem::path _path)
 {
 	solAssert(!_path.empty(), "");
 	m_allowedDirectories.insert(std::move(_path));
+	m_normalizedAllowedPaths.reset();
 }
 
 void FileReader::addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source)
@@ -144,9 +147,18 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			decltype(allowedPaths){m_basePath.empty() ? "." : m_basePath} +
 			m_includePaths;
 
+		// Resolving symlinks requires filesystem access for every path component, so the result
+		// is reused for all imports until the set of allowed paths changes.
+		if (!m_normalizedAllowedPaths.has_value())
+		{
+			m_normalizedAllowedPaths.emplace();
+			for (boost::filesystem::path const& allowedDir: allowedPaths)
+				m_normalizedAllowedPaths->push_back(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled));
+		}
+
 		bool isAllowed = false;
-		for (boost::filesystem::path const& allowedDir: allowedPaths)
-			if (isPathPrefix(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled), candidates[0]))
+		for (boost::filesystem::path const& allowedDir: *m_normalizedAllowedPaths)
+			if (isPathPrefix(allowedDir, candidates[0]))
 			{
 				isAllowed = true;
 				break;
@@ -164,9 +176,8 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			return ReadCallback::Result{false, "Not a valid file."};
 
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		auto contents = readFileAsString(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
+		SourceCode const& contents = m_sourceCodes[_sourceUnitName] = readFileAsString(candidates[0]);
 		return ReadCallback::Result{true, contents};
 	}
 	catch (util::Exception const& _exception)
@@ -23,7 +23,9 @@
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -164,6 +166,10 @@ private:
 	/// list of allowed directories to read files from
 	FileSystemPathSet m_allowedDirectories;
 
+	/// Base path, include paths and allowed directories with symlinks resolved.
+	/// Computed on first use by @a readFile() and reset whenever one of them changes.
+	std::optional<std::vector<boost::filesystem::path>> m_normalizedAllowedPaths;
+
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
 };
@@ -78,7 +78,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return pathGasMeter(_items).estimateMax(0, state);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
@@ -100,7 +100,17 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return pathGasMeter(_items).estimateMax(_offset, state);
+}
+
+PathGasMeter& GasEstimator::pathGasMeter(AssemblyItems const& _items) const
+{
+	if (!m_pathGasMeter || m_pathGasMeterItems != &_items)
+	{
+		m_pathGasMeter = make_unique<PathGasMeter>(_items, m_evmVersion);
+		m_pathGasMeterItems = &_items;
+	}
+	return *m_pathGasMeter;
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
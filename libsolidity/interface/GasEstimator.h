@@ -27,9 +27,11 @@
 
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/PathGasMeter.h>
 
 #include <array>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::frontend
@@ -67,7 +69,14 @@ public:
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
+	/// @returns a path gas meter for @a _items. It is reused as long as the same items are passed,
+	/// since all functions of a contract are estimated on the same items. The items must not be
+	/// modified in between.
+	evmasm::PathGasMeter& pathGasMeter(evmasm::AssemblyItems const& _items) const;
+
 	langutil::EVMVersion m_evmVersion;
+	mutable evmasm::AssemblyItems const* m_pathGasMeterItems = nullptr;
+	mutable std::unique_ptr<evmasm::PathGasMeter> m_pathGasMeter;
 };
 
 }
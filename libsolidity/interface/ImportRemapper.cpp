@@ -36,11 +36,34 @@ void ImportRemapper::setRemappings(vector<Remapping> _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = move(_remappings);
+
+	m_sanitizedRemappings.clear();
+	m_prefixTrie.assign(1, PrefixNode{});
+	for (auto const& remapping: m_remappings)
+	{
+		m_sanitizedRemappings.push_back({
+			util::sanitizePath(remapping.context),
+			util::sanitizePath(remapping.prefix),
+			util::sanitizePath(remapping.target)
+		});
+
+		size_t node = 0;
+		for (char c: m_sanitizedRemappings.back().prefix)
+		{
+			auto [child, inserted] = m_prefixTrie[node].children.emplace(c, m_prefixTrie.size());
+			if (inserted)
+				m_prefixTrie.emplace_back();
+			node = child->second;
+		}
+		m_prefixTrie[node].remappings.push_back(m_sanitizedRemappings.size() - 1);
+	}
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
 {
-	// Try to find the longest prefix match in all remappings that are active in the current context.
+	// Find the remapping with the longest context among those that are active in the current context
+	// and whose prefix matches, preferring longer prefixes and then later remappings.
+	// Walking the trie along the path visits the matching prefixes in order of increasing length.
 	auto isPrefixOf = [](string const& _a, string const& _b)
 	{
 		if (_a.length() > _b.length())
@@ -48,34 +71,32 @@ SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _con
 		return equal(_a.begin(), _a.end(), _b.begin());
 	};
 
-	size_t longestPrefix = 0;
-	size_t longestContext = 0;
-	string bestMatchTarget;
-
-	for (auto const& redir: m_remappings)
+	Remapping const* bestMatch = nullptr;
+	size_t node = 0;
+	for (size_t position = 0; ; ++position)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		for (size_t index: m_prefixTrie[node].remappings)
+		{
+			Remapping const& remapping = m_sanitizedRemappings[index];
+			if (
+				isPrefixOf(remapping.context, _context) &&
+				(!bestMatch || remapping.context.length() >= bestMatch->context.length())
+			)
+				bestMatch = &remapping;
+		}
+
+		if (position == _path.size())
+			break;
+		auto child = m_prefixTrie[node].children.find(_path[position]);
+		if (child == m_prefixTrie[node].children.end())
+			break;
+		node = child->second;
 	}
-	string path = bestMatchTarget;
-	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
+
+	if (!bestMatch)
+		return _path;
+	string path = bestMatch->target;
+	path.append(_path.begin() + static_cast<string::difference_type>(bestMatch->prefix.length()), _path.end());
 	return path;
 }
 
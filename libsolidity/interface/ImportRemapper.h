@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,7 +50,7 @@ public:
 		std::string target;
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear() { setRemappings({}); }
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
@@ -63,9 +64,21 @@ public:
 	static std::optional<Remapping> parseRemapping(std::string_view _input);
 
 private:
+	/// Node of a trie over the sanitized prefixes of all remappings.
+	struct PrefixNode
+	{
+		std::map<char, size_t> children;
+		/// Indices of the remappings whose prefix ends at this node, in ascending order.
+		std::vector<size_t> remappings;
+	};
+
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+	/// @a m_remappings with sanitized paths, in the same order.
+	std::vector<Remapping> m_sanitizedRemappings = {};
+	/// Trie over the prefixes of @a m_sanitizedRemappings. The first node is the root.
+	std::vector<PrefixNode> m_prefixTrie = {PrefixNode{}};
 };
 
 }
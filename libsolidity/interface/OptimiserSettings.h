@@ -26,7 +26,11 @@
 #include <liblangutil/Exceptions.h>
 
 #include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -39,6 +43,112 @@ enum class OptimisationPreset
 	Full,
 };
 
+/// Shape of the code that selects the external function to call based on the function selector.
+enum class FunctionDispatch
+{
+	Default, // binary search driven by the cost model in the legacy pipeline, a single switch via IR
+	Linear, // one comparison per function in both pipelines
+	BinarySearch // binary search driven by the cost model in both pipelines
+};
+
+inline std::string functionDispatchToString(FunctionDispatch _dispatch)
+{
+	switch (_dispatch)
+	{
+	case FunctionDispatch::Default: return "default";
+	case FunctionDispatch::Linear: return "linear";
+	case FunctionDispatch::BinarySearch: return "binarySearch";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<FunctionDispatch> functionDispatchFromString(std::string const& _dispatch)
+{
+	for (auto i: {FunctionDispatch::Default, FunctionDispatch::Linear, FunctionDispatch::BinarySearch})
+		if (functionDispatchToString(i) == _dispatch)
+			return i;
+	return std::nullopt;
+}
+
+/// Optimisations that change the generated code in ways that are still being evaluated.
+/// They are not part of any preset and only run if requested explicitly.
+enum class ExperimentalOptimisation
+{
+	ControlFlowGraph, // legacy assembly: remove unreachable blocks and move blocks behind their only jump
+	BoundedSpecialization, // Yul: only specialize functions if it enables simplifications, share and limit specializations
+	ComparisonBounds, // Yul: evaluate comparisons from bounds of values derived from definitions and conditions
+	ComparisonRelations, // Yul: also evaluate comparisons from relations between variables compared in conditions
+	SharedReverts, // code generation: share the code reverting with the same error between all sites
+	IdentityPrecompileCopy, // code generation: copy large memory areas using the identity precompile
+	PackedArrayCopy, // IR code generation: store each slot of packed arrays copied to storage only once
+	ReleaseTemporaryMemory, // IR code generation: reset the free memory pointer after calls that only allocate temporary memory
+	GasWeightedInlining, // Yul: repeat sequences until gas costs are stable and inline larger functions for more runs
+	StoreSummaries, // Yul: keep storage and memory knowledge across calls to functions with known written keys
+	CheapSpilling, // Yul: move rarely accessed variables to memory and share memory slots between disjoint scopes
+	CSEPropagation, // evmasm: keep the knowledge of the CSE for blocks that are only entered from the previous block
+	DispatchInlining, // Yul: only count the selected case when inlining a switch over a constant argument
+	PackedStructCopy, // IR code generation: write struct members sharing a slot with one sload and sstore
+	ConstantSlotHoisting, // Yul: move loads from constant storage slots out of loops that only write other constant slots
+	MultiWordKeccak // Yul: evaluate keccak256 over several consecutive known memory words
+};
+
+inline std::vector<ExperimentalOptimisation> const& allExperimentalOptimisations()
+{
+	static std::vector<ExperimentalOptimisation> const all{
+		ExperimentalOptimisation::ControlFlowGraph,
+		ExperimentalOptimisation::BoundedSpecialization,
+		ExperimentalOptimisation::ComparisonBounds,
+		ExperimentalOptimisation::ComparisonRelations,
+		ExperimentalOptimisation::SharedReverts,
+		ExperimentalOptimisation::IdentityPrecompileCopy,
+		ExperimentalOptimisation::PackedArrayCopy,
+		ExperimentalOptimisation::ReleaseTemporaryMemory,
+		ExperimentalOptimisation::GasWeightedInlining,
+		ExperimentalOptimisation::StoreSummaries,
+		ExperimentalOptimisation::CheapSpilling,
+		ExperimentalOptimisation::CSEPropagation,
+		ExperimentalOptimisation::DispatchInlining,
+		ExperimentalOptimisation::PackedStructCopy,
+		ExperimentalOptimisation::ConstantSlotHoisting,
+		ExperimentalOptimisation::MultiWordKeccak
+	};
+	return all;
+}
+
+inline std::string experimentalOptimisationToString(ExperimentalOptimisation _optimisation)
+{
+	switch (_optimisation)
+	{
+	case ExperimentalOptimisation::ControlFlowGraph: return "controlFlowGraph";
+	case ExperimentalOptimisation::BoundedSpecialization: return "boundedSpecialization";
+	case ExperimentalOptimisation::ComparisonBounds: return "comparisonBounds";
+	case ExperimentalOptimisation::ComparisonRelations: return "comparisonRelations";
+	case ExperimentalOptimisation::SharedReverts: return "sharedReverts";
+	case ExperimentalOptimisation::IdentityPrecompileCopy: return "identityPrecompileCopy";
+	case ExperimentalOptimisation::PackedArrayCopy: return "packedArrayCopy";
+	case ExperimentalOptimisation::ReleaseTemporaryMemory: return "releaseTemporaryMemory";
+	case ExperimentalOptimisation::GasWeightedInlining: return "gasWeightedInlining";
+	case ExperimentalOptimisation::StoreSummaries: return "storeSummaries";
+	case ExperimentalOptimisation::CheapSpilling: return "cheapSpilling";
+	case ExperimentalOptimisation::CSEPropagation: return "csePropagation";
+	case ExperimentalOptimisation::DispatchInlining: return "dispatchInlining";
+	case ExperimentalOptimisation::PackedStructCopy: return "packedStructCopy";
+	case ExperimentalOptimisation::ConstantSlotHoisting: return "constantSlotHoisting";
+	case ExperimentalOptimisation::MultiWordKeccak: return "multiWordKeccak";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<ExperimentalOptimisation> experimentalOptimisationFromString(std::string const& _optimisation)
+{
+	for (auto i: allExperimentalOptimisations())
+		if (experimentalOptimisationToString(i) == _optimisation)
+			return i;
+	return std::nullopt;
+}
+
 struct OptimiserSettings
 {
 	static char constexpr DefaultYulOptimiserSteps[] =
@@ -105,6 +215,15 @@ struct OptimiserSettings
 		}
 	}
 
+	/// @returns a copy of these settings where @a _functionExecutions is added to the execution
+	/// profile for all functions the profile does not mention yet.
+	OptimiserSettings withFunctionExecutions(std::map<std::string, size_t> const& _functionExecutions) const
+	{
+		OptimiserSettings s = *this;
+		s.executionProfile.insert(_functionExecutions.begin(), _functionExecutions.end());
+		return s;
+	}
+
 	bool operator==(OptimiserSettings const& _other) const
 	{
 		return
@@ -116,9 +235,20 @@ struct OptimiserSettings
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
+			optimizeInlineAssemblyStack == _other.optimizeInlineAssemblyStack &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			yulOptimiserBudget == _other.yulOptimiserBudget &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			functionDispatch == _other.functionDispatch &&
+			executionProfile == _other.executionProfile &&
+			experimentalOptimisations == _other.experimentalOptimisations;
+	}
+
+	/// @returns true if the experimental optimisation @a _optimisation was requested.
+	bool runExperimental(ExperimentalOptimisation _optimisation) const
+	{
+		return experimentalOptimisations.count(_optimisation) > 0;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -139,6 +269,10 @@ struct OptimiserSettings
 	bool runConstantOptimiser = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
+	/// Generate code for self-contained, memory-safe inline assembly blocks in the legacy code generator
+	/// like for Yul code, i.e. with a stack layout derived from their control flow graph.
+	/// Only effective together with @a optimizeStackAllocation.
+	bool optimizeInlineAssemblyStack = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
 	bool runYulOptimiser = false;
 	/// Sequence of optimisation steps to be performed by Yul optimiser.
@@ -146,9 +280,23 @@ struct OptimiserSettings
 	/// them just by setting this to an empty string. Set @a runYulOptimiser to false if you want
 	/// no optimisations.
 	std::string yulOptimiserSteps = DefaultYulOptimiserSteps;
+	/// Maximum amount of work the sequence in @a yulOptimiserSteps may perform on a single Yul object,
+	/// measured as the sum of the code size the individual steps are applied to.
+	/// The remaining steps are skipped once it is used up. Unlimited if not set.
+	std::optional<size_t> yulOptimiserBudget;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Shape of the external function dispatcher. The split points of a binary search are
+	/// chosen based on @a expectedExecutionsPerDeployment.
+	FunctionDispatch functionDispatch = FunctionDispatch::Default;
+	/// Expected number of executions per deployment of individual functions of the runtime code,
+	/// overriding @a expectedExecutionsPerDeployment for them. External functions are identified
+	/// by their selector (``0x`` followed by eight lowercase hex digits) and determine the order
+	/// of the cases of a linear dispatcher, other keys are names of Yul functions and affect inlining.
+	std::map<std::string, size_t> executionProfile;
+	/// Optimisations that are not enabled by any preset, see ExperimentalOptimisation.
+	std::set<ExperimentalOptimisation> experimentalOptimisations;
 };
 
 }
@@ -43,6 +43,10 @@ public:
 	enum class Kind
 	{
 		ReadFile,
+		/// Request for several files at once. The data is a JSON array of source unit names
+		/// and a successful response is a JSON object mapping names to their contents.
+		/// Names missing from the response are requested again one by one.
+		ReadFiles,
 		SMTQuery
 	};
 
@@ -52,6 +56,8 @@ public:
 		{
 		case Kind::ReadFile:
 			return "source";
+		case Kind::ReadFiles:
+			return "sources";
 		case Kind::SMTQuery:
 			return "smt-query";
 		default:
@@ -23,10 +23,13 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/ImportRemapper.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Disassemble.h>
@@ -38,10 +41,13 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <optional>
 
 using namespace std;
@@ -266,7 +272,7 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"*",
 		"ir", "irOptimized",
 		"wast", "wasm", "ewasm.wast", "ewasm.wasm",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.irGasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
 	for (auto const& fileRequests: _outputSelection)
@@ -285,7 +291,7 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 
 	static vector<string> const outputsThatRequireEvmBinaries = vector<string>{
 		"*",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.irGasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
 	for (auto const& fileRequests: _outputSelection)
@@ -296,6 +302,19 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the gas estimates on the optimized Yul code were requested.
+bool isIRGasEstimationRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			if (isArtifactRequested(requests, "evm.irGasEstimates", false))
+				return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -331,6 +350,22 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the optimized Yul IR was requested. Note that as an exception, '*' does not
+/// yet match "irOptimized"
+bool isOptimizedIRRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "irOptimized")
+					return true;
+
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -439,25 +474,25 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"abiCoder", "batchedImports", "parserErrorRecovery", "debug", "evmVersion", "lazyBodies", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "profileOptimizer", "profiles", "profiling", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"cacheDirectory", "contracts", "divModNoSlacks", "engine", "invariants", "jobs", "showUnproved", "sliceQueries", "solvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "runs", "profile"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails", "dispatcher", "experimental"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -584,6 +619,28 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("profile"))
+	{
+		Json::Value const& profile = _jsonInput["profile"];
+		if (!profile.isObject())
+			return formatFatalError("JSONError", "The \"profile\" setting must be an object.");
+		for (auto const& key: profile.getMemberNames())
+		{
+			if (!profile[key].isUInt())
+				return formatFatalError("JSONError", "The values of the \"profile\" setting must be unsigned numbers.");
+			string name = key;
+			if (boost::starts_with(name, "0x"))
+			{
+				if (name.size() != 10 || !all_of(name.begin() + 2, name.end(), [](char _c) { return isxdigit(static_cast<unsigned char>(_c)) != 0; }))
+					return formatFatalError("JSONError", "Invalid function selector \"" + key + "\" in the \"profile\" setting.");
+				boost::to_lower(name);
+			}
+			else if (name.empty())
+				return formatFatalError("JSONError", "Empty function name in the \"profile\" setting.");
+			settings.executionProfile[name] = profile[key].asUInt();
+		}
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -607,22 +664,182 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		if (details.isMember("dispatcher"))
+		{
+			if (!details["dispatcher"].isString())
+				return formatFatalError("JSONError", "The \"dispatcher\" setting must be a string.");
+			std::optional<FunctionDispatch> dispatch = functionDispatchFromString(details["dispatcher"].asString());
+			if (!dispatch)
+				return formatFatalError("JSONError", "Invalid value for \"dispatcher\". Options are \"default\", \"linear\" and \"binarySearch\".");
+			settings.functionDispatch = *dispatch;
+		}
+		if (details.isMember("experimental"))
+		{
+			if (!details["experimental"].isArray())
+				return formatFatalError("JSONError", "The \"experimental\" setting must be an array of strings.");
+			for (Json::Value const& optimisation: details["experimental"])
+			{
+				if (!optimisation.isString())
+					return formatFatalError("JSONError", "The \"experimental\" setting must be an array of strings.");
+				std::optional<ExperimentalOptimisation> experimental = experimentalOptimisationFromString(optimisation.asString());
+				if (!experimental)
+					return formatFatalError("JSONError", "Unknown experimental optimization \"" + optimisation.asString() + "\".");
+				settings.experimentalOptimisations.insert(*experimental);
+			}
+		}
 		if (details.isMember("yulDetails"))
 		{
 			if (!settings.runYulOptimiser)
 				return formatFatalError("JSONError", "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "inlineAssemblyStack", "optimizerSteps", "budget"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
+			if (auto error = checkOptimizerDetail(details["yulDetails"], "inlineAssemblyStack", settings.optimizeInlineAssemblyStack))
+				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps))
 				return *error;
+			if (details["yulDetails"].isMember("budget"))
+			{
+				if (!details["yulDetails"]["budget"].isUInt())
+					return formatFatalError("JSONError", "The \"budget\" setting must be an unsigned number.");
+				settings.yulOptimiserBudget = details["yulDetails"]["budget"].asUInt();
+			}
 		}
 	}
 	return { std::move(settings) };
 }
 
+/// Runs @a _compile and appends the errors reported by @a _compilerStack as well as
+/// the exceptions that escape from it to @a _errors.
+void runCompilerStack(CompilerStack& _compilerStack, function<void()> const& _compile, Json::Value& _errors)
+{
+	try
+	{
+		_compile();
+
+		for (auto const& error: _compilerStack.errors())
+		{
+			Error const& err = dynamic_cast<Error const&>(*error);
+
+			_errors.append(formatErrorWithException(
+				_compilerStack,
+				*error,
+				Error::errorSeverity(err.type()),
+				err.typeName(),
+				"general",
+				"",
+				err.errorId()
+			));
+		}
+	}
+	/// This is only thrown in a very few locations.
+	catch (Error const& _error)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_error,
+			Error::Severity::Error,
+			_error.typeName(),
+			"general",
+			"Uncaught error: "
+		));
+	}
+	/// This should not be leaked from compile().
+	catch (FatalError const& _exception)
+	{
+		_errors.append(formatError(
+			Error::Severity::Error,
+			"FatalError",
+			"general",
+			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (CompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			Error::Severity::Error,
+			"CompilerError",
+			"general",
+			"Compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (InternalCompilerError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			Error::Severity::Error,
+			"InternalCompilerError",
+			"general",
+			"Internal compiler error (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			Error::Severity::Error,
+			"UnimplementedFeatureError",
+			"general",
+			"Unimplemented feature (" + _exception.lineInfo() + ")"
+		));
+	}
+	catch (yul::YulException const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			Error::Severity::Error,
+			"YulException",
+			"general",
+			"Yul exception"
+		));
+	}
+	catch (smtutil::SMTLogicError const& _exception)
+	{
+		_errors.append(formatErrorWithException(
+			_compilerStack,
+			_exception,
+			Error::Severity::Error,
+			"SMTLogicException",
+			"general",
+			"SMT logic exception"
+		));
+	}
+	catch (util::Exception const& _exception)
+	{
+		_errors.append(formatError(
+			Error::Severity::Error,
+			"Exception",
+			"general",
+			"Exception during compilation: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (std::exception const& _exception)
+	{
+		_errors.append(formatError(
+			Error::Severity::Error,
+			"Exception",
+			"general",
+			"Unknown exception during compilation: " + boost::diagnostic_information(_exception)
+		));
+	}
+	catch (...)
+	{
+		_errors.append(formatError(
+			Error::Severity::Error,
+			"Exception",
+			"general",
+			"Unknown exception during compilation: " + boost::current_exception_diagnostic_information()
+		));
+	}
+}
+
 }
 
 
@@ -669,7 +886,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -683,7 +900,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			{
 				if (!url.isString())
 					return formatFatalError("JSONError", "URL must be a string.");
-				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
+				ReadCallback::Result result = readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
 				if (result.success)
 				{
 					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
@@ -695,7 +912,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -765,10 +982,21 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		if (!settings["stopAfter"].isString())
 			return formatFatalError("JSONError", "\"settings.stopAfter\" must be a string.");
 
-		if (settings["stopAfter"].asString() != "parsing")
-			return formatFatalError("JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\".");
+		optional<CompilerStack::State> stopAfter;
+		vector<string> validStages;
+		for (auto const& [name, state]: CompilerStack::stopAfterStages())
+		{
+			if (name == settings["stopAfter"].asString())
+				stopAfter = state;
+			validStages.push_back("\"" + name + "\"");
+		}
+		if (!stopAfter)
+			return formatFatalError(
+				"JSONError",
+				"Invalid value for \"settings.stopAfter\". Valid values are " + util::joinHumanReadable(validStages, ", ", " and ") + "."
+			);
 
-		ret.stopAfter = CompilerStack::State::Parsed;
+		ret.stopAfter = *stopAfter;
 	}
 
 	if (settings.isMember("parserErrorRecovery"))
@@ -785,6 +1013,42 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt())
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be an unsigned integer.");
+		unsigned parallelism = settings["parallelism"].asUInt();
+		ret.parallelism = (parallelism == 0 ? util::hardwareConcurrency() : parallelism);
+	}
+
+	if (settings.isMember("batchedImports"))
+	{
+		if (!settings["batchedImports"].isBool())
+			return formatFatalError("JSONError", "\"settings.batchedImports\" must be a Boolean.");
+		ret.batchedImports = settings["batchedImports"].asBool();
+	}
+
+	if (settings.isMember("lazyBodies"))
+	{
+		if (!settings["lazyBodies"].isBool())
+			return formatFatalError("JSONError", "\"settings.lazyBodies\" must be a Boolean.");
+		ret.lazyBodies = settings["lazyBodies"].asBool();
+	}
+
+	if (settings.isMember("profiling"))
+	{
+		if (!settings["profiling"].isBool())
+			return formatFatalError("JSONError", "\"settings.profiling\" must be a Boolean.");
+		ret.profiling = settings["profiling"].asBool();
+	}
+
+	if (settings.isMember("profileOptimizer"))
+	{
+		if (!settings["profileOptimizer"].isBool())
+			return formatFatalError("JSONError", "\"settings.profileOptimizer\" must be a Boolean.");
+		ret.profileOptimizer = settings["profileOptimizer"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -795,6 +1059,22 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.evmVersion = *version;
 	}
 
+	if (settings.isMember("abiCoder"))
+	{
+		if (auto result = checkKeys(settings["abiCoder"], {"decoderMode"}, "settings.abiCoder"))
+			return *result;
+
+		if (settings["abiCoder"].isMember("decoderMode"))
+		{
+			if (!settings["abiCoder"]["decoderMode"].isString())
+				return formatFatalError("JSONError", "settings.abiCoder.decoderMode must be a string.");
+			std::optional<ABIDecoderMode> decoderMode = abiDecoderModeFromString(settings["abiCoder"]["decoderMode"].asString());
+			if (!decoderMode)
+				return formatFatalError("JSONError", "Invalid value for settings.abiCoder.decoderMode.");
+			ret.abiDecoderMode = *decoderMode;
+		}
+	}
+
 	if (settings.isMember("debug"))
 	{
 		if (auto result = checkKeys(settings["debug"], {"revertStrings", "debugInfo"}, "settings.debug"))
@@ -933,6 +1213,12 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			"Requested output selection conflicts with \"settings.stopAfter\"."
 		);
 
+	if (ret.lazyBodies && isBinaryRequested(ret.outputSelection))
+		return formatFatalError(
+			"JSONError",
+			"Requested output selection conflicts with \"settings.lazyBodies\"."
+		);
+
 	Json::Value const& modelCheckerSettings = settings.get("modelChecker", Json::Value());
 
 	if (auto result = checkModelCheckerSettingsKeys(modelCheckerSettings))
@@ -1016,6 +1302,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.showUnproved = showUnproved.asBool();
 	}
 
+	if (modelCheckerSettings.isMember("sliceQueries"))
+	{
+		auto const& sliceQueries = modelCheckerSettings["sliceQueries"];
+		if (!sliceQueries.isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.sliceQueries must be a Boolean value.");
+		ret.modelCheckerSettings.sliceQueries = sliceQueries.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("solvers"))
 	{
 		auto const& solversArray = modelCheckerSettings["solvers"];
@@ -1062,25 +1356,100 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("jobs"))
+	{
+		if (!modelCheckerSettings["jobs"].isUInt() || modelCheckerSettings["jobs"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.modelChecker.jobs must be a positive integer.");
+		ret.modelCheckerSettings.jobs = modelCheckerSettings["jobs"].asUInt();
+	}
+
+	if (modelCheckerSettings.isMember("cacheDirectory"))
+	{
+		if (!modelCheckerSettings["cacheDirectory"].isString() || modelCheckerSettings["cacheDirectory"].asString().empty())
+			return formatFatalError("JSONError", "settings.modelChecker.cacheDirectory must be a non-empty string.");
+		ret.modelCheckerSettings.cacheDirectory = modelCheckerSettings["cacheDirectory"].asString();
+	}
+
+	if (ret.lazyBodies && ret.modelCheckerSettings.engine.any())
+		return formatFatalError("JSONError", "The model checker cannot be used together with \"settings.lazyBodies\".");
+
+	if (settings.isMember("profiles"))
+	{
+		Json::Value const& profiles = settings["profiles"];
+		if (!profiles.isObject() || profiles.empty())
+			return formatFatalError("JSONError", "\"settings.profiles\" must be a non-empty object.");
+		if (ret.language != "Solidity")
+			return formatFatalError("JSONError", "\"settings.profiles\" is only supported for Solidity.");
+
+		for (string const& name: profiles.getMemberNames())
+		{
+			Json::Value const& profileSettings = profiles[name];
+			if (auto result = checkKeys(profileSettings, {"evmVersion", "optimizer", "viaIR"}, "settings.profiles." + name))
+				return *result;
+
+			// Settings that are not given in the profile are taken from the top level.
+			CompilationProfile profile{name, ret.evmVersion, ret.optimiserSettings, ret.viaIR};
+			if (profileSettings.isMember("evmVersion"))
+			{
+				if (!profileSettings["evmVersion"].isString())
+					return formatFatalError("JSONError", "evmVersion must be a string.");
+				std::optional<langutil::EVMVersion> version = langutil::EVMVersion::fromString(profileSettings["evmVersion"].asString());
+				if (!version)
+					return formatFatalError("JSONError", "Invalid EVM version requested.");
+				profile.evmVersion = *version;
+			}
+			if (profileSettings.isMember("optimizer"))
+			{
+				auto optimiserSettings = parseOptimizerSettings(profileSettings["optimizer"]);
+				if (std::holds_alternative<Json::Value>(optimiserSettings))
+					return std::get<Json::Value>(std::move(optimiserSettings)); // was an error
+				profile.optimiserSettings = std::get<OptimiserSettings>(std::move(optimiserSettings));
+			}
+			if (profileSettings.isMember("viaIR"))
+			{
+				if (!profileSettings["viaIR"].isBool())
+					return formatFatalError("JSONError", "\"settings.profiles." + name + ".viaIR\" must be a Boolean.");
+				profile.viaIR = profileSettings["viaIR"].asBool();
+			}
+			ret.profiles.emplace_back(std::move(profile));
+		}
+	}
+
 	return { std::move(ret) };
 }
 
 Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	unique_ptr<CompilerStack> temporaryCompilerStack;
+	if (!m_keepCompilerStack)
+		temporaryCompilerStack = make_unique<CompilerStack>(recordingReadCallback());
+	else if (!m_compilerStack)
+	{
+		m_compilerStack = make_unique<CompilerStack>(recordingReadCallback());
+		m_compilerStack->setReuseParsedSources(true);
+		m_compilerStack->setReuseUnoptimisedIR(true);
+	}
+	else
+		m_compilerStack->reset();
+	CompilerStack& compilerStack = m_keepCompilerStack ? *m_compilerStack : *temporaryCompilerStack;
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	compilerStack.setSources(sourceList);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
+	compilerStack.enableBatchedReads(_inputsAndSettings.batchedImports);
+	compilerStack.setLazyFunctionBodies(_inputsAndSettings.lazyBodies);
+	compilerStack.enableProfiling(_inputsAndSettings.profiling);
+	compilerStack.enableOptimiserProfiling(_inputsAndSettings.profileOptimizer);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
 	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
-	if (_inputsAndSettings.debugInfoSelection.has_value())
-		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value());
+	compilerStack.setABIDecoderMode(_inputsAndSettings.abiDecoderMode);
+	compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value_or(DebugInfoSelection::Default()));
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
@@ -1088,221 +1457,206 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableIRGeneration(
+		isIRRequested(_inputsAndSettings.outputSelection),
+		isOptimizedIRRequested(_inputsAndSettings.outputSelection)
+	);
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableIRGasEstimation(isIRGasEstimationRequested(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
+	if (!_inputsAndSettings.profiles.empty())
+		return compileSolidityProfiles(compilerStack, _inputsAndSettings, sourceList, errors);
+
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
-	try
-	{
+	runCompilerStack(compilerStack, [&]() {
 		if (binariesRequested)
 			compilerStack.compile();
 		else
 			compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
+	}, errors);
+
+	return formatSolidityOutput(compilerStack, _inputsAndSettings, sourceList, std::move(errors));
+}
 
-		for (auto const& error: compilerStack.errors())
+Json::Value StandardCompiler::compileSolidityProfiles(
+	CompilerStack& _compilerStack,
+	InputsAndSettings const& _inputsAndSettings,
+	StringMap const& _sourceList,
+	Json::Value const& _errors
+)
+{
+	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	// Profiles that only differ in the optimiser steps generate the same unoptimised IR.
+	_compilerStack.setReuseUnoptimisedIR(true);
+
+	// The analysis depends on the EVM version and on whether the Yul optimiser is enabled.
+	map<pair<EVMVersion, bool>, vector<CompilationProfile const*>> profileGroups;
+	for (CompilationProfile const& profile: _inputsAndSettings.profiles)
+		profileGroups[{profile.evmVersion, profile.optimiserSettings.runYulOptimiser}].push_back(&profile);
+
+	Json::Value output = Json::objectValue;
+	output["profiles"] = Json::objectValue;
+	bool firstGroup = true;
+	for (auto const& [analysisSettings, profiles]: profileGroups)
+	{
+		// The types are shared by the whole process, so the groups are compiled one after the other
+		// and the outputs of a group are collected before the next one is analysed.
+		if (!firstGroup)
 		{
-			Error const& err = dynamic_cast<Error const&>(*error);
+			_compilerStack.reset(true);
+			_compilerStack.setSources(_sourceList);
+			for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+				_compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		}
+		firstGroup = false;
+		_compilerStack.setEVMVersion(analysisSettings.first);
+		_compilerStack.setOptimiserSettings(profiles.front()->optimiserSettings);
+		_compilerStack.setViaIR(profiles.front()->viaIR);
 
-			errors.append(formatErrorWithException(
-				compilerStack,
-				*error,
-				Error::errorSeverity(err.type()),
-				err.typeName(),
-				"general",
-				"",
-				err.errorId()
-			));
+		for (CompilationProfile const* profile: profiles)
+		{
+			Json::Value errors = _errors;
+			runCompilerStack(_compilerStack, [&]() {
+				if (profile == profiles.front())
+				{
+					if (binariesRequested)
+						_compilerStack.compile();
+					else
+						_compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
+				}
+				else if (_compilerStack.state() >= CompilerStack::State::AnalysisPerformed && !_compilerStack.hasError())
+				{
+					_compilerStack.resetCodeGeneration(profile->optimiserSettings, profile->viaIR);
+					if (binariesRequested)
+						_compilerStack.compile();
+				}
+			}, errors);
+
+			Json::Value profileOutput = formatSolidityOutput(_compilerStack, _inputsAndSettings, _sourceList, std::move(errors));
+			// The sources and their ASTs do not depend on the profile.
+			if (!output.isMember("sources") && profileOutput.isMember("sources"))
+				output["sources"] = std::move(profileOutput["sources"]);
+			profileOutput.removeMember("sources");
+			output["profiles"][profile->name] = std::move(profileOutput);
 		}
 	}
-	/// This is only thrown in a very few locations.
-	catch (Error const& _error)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_error,
-			Error::Severity::Error,
-			_error.typeName(),
-			"general",
-			"Uncaught error: "
-		));
-	}
-	/// This should not be leaked from compile().
-	catch (FatalError const& _exception)
-	{
-		errors.append(formatError(
-			Error::Severity::Error,
-			"FatalError",
-			"general",
-			"Uncaught fatal error: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (CompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_exception,
-			Error::Severity::Error,
-			"CompilerError",
-			"general",
-			"Compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (InternalCompilerError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_exception,
-			Error::Severity::Error,
-			"InternalCompilerError",
-			"general",
-			"Internal compiler error (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (UnimplementedFeatureError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_exception,
-			Error::Severity::Error,
-			"UnimplementedFeatureError",
-			"general",
-			"Unimplemented feature (" + _exception.lineInfo() + ")"
-		));
-	}
-	catch (yul::YulException const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_exception,
-			Error::Severity::Error,
-			"YulException",
-			"general",
-			"Yul exception"
-		));
-	}
-	catch (smtutil::SMTLogicError const& _exception)
-	{
-		errors.append(formatErrorWithException(
-			compilerStack,
-			_exception,
-			Error::Severity::Error,
-			"SMTLogicException",
-			"general",
-			"SMT logic exception"
-		));
-	}
-	catch (util::Exception const& _exception)
-	{
-		errors.append(formatError(
-			Error::Severity::Error,
-			"Exception",
-			"general",
-			"Exception during compilation: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (std::exception const& _exception)
-	{
-		errors.append(formatError(
-			Error::Severity::Error,
-			"Exception",
-			"general",
-			"Unknown exception during compilation: " + boost::diagnostic_information(_exception)
-		));
-	}
-	catch (...)
-	{
-		errors.append(formatError(
-			Error::Severity::Error,
-			"Exception",
-			"general",
-			"Unknown exception during compilation: " + boost::current_exception_diagnostic_information()
-		));
-	}
 
-	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool const compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	return output;
+}
 
-	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
+Json::Value StandardCompiler::formatSolidityOutput(
+	CompilerStack& _compilerStack,
+	InputsAndSettings const& _inputsAndSettings,
+	StringMap const& _sourceList,
+	Json::Value _errors
+)
+{
+	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
+	bool analysisPerformed = _compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
+	bool const compilationSuccess = _compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+
+	if (_compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
 
 	/// Inconsistent state - stop here to receive error reports from users
 	if (
 		((binariesRequested && !compilationSuccess) || !analysisPerformed) &&
-		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
+		(_errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
 		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
 
 	Json::Value output = Json::objectValue;
 
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	if (_errors.size() > 0)
+		output["errors"] = std::move(_errors);
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
-		for (string const& query: compilerStack.unhandledSMTLib2Queries())
+	if (!_compilerStack.unhandledSMTLib2Queries().empty())
+		for (string const& query: _compilerStack.unhandledSMTLib2Queries())
 			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
 
 	bool const wildcardMatchesExperimental = false;
 
 	output["sources"] = Json::objectValue;
 	unsigned sourceIndex = 0;
-	if (compilerStack.state() >= CompilerStack::State::Parsed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
+	if (_compilerStack.state() >= CompilerStack::State::Parsed && (!_compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+		for (string const& sourceName: _compilerStack.sourceNames())
 		{
 			Json::Value sourceResult = Json::objectValue;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonConverter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+				sourceResult["ast"] = ASTJsonConverter(_compilerStack.state(), _compilerStack.sourceIndices()).toJson(_compilerStack.ast(sourceName));
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
-	{
-		size_t colon = contractName.rfind(':');
+	vector<string> const contractNames = analysisPerformed ? _compilerStack.contractNames() : vector<string>();
+	vector<Json::Value> contractOutputs(contractNames.size(), Json::Value(Json::objectValue));
+	vector<Json::Value> evmOutputs(contractNames.size(), Json::Value(Json::objectValue));
+	auto splitContractName = [](string const& _contractName) {
+		size_t colon = _contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		return make_pair(_contractName.substr(0, colon), _contractName.substr(colon + 1));
+	};
+
+	// Outputs that are derived from the AST and the types, which are shared between the contracts
+	// and fill their caches on first use, are collected one contract after the other.
+	for (size_t i = 0; i < contractNames.size(); ++i)
+	{
+		string const& contractName = contractNames[i];
+		string file, name;
+		tie(file, name) = splitContractName(contractName);
+		Json::Value& contractData = contractOutputs[i];
+		Json::Value& evmData = evmOutputs[i];
 
 		// ABI, storage layout, documentation and metadata
-		Json::Value contractData(Json::objectValue);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
+			contractData["abi"] = _compilerStack.contractABI(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+			contractData["storageLayout"] = _compilerStack.storageLayout(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
+			contractData["metadata"] = _compilerStack.metadata(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
+			contractData["userdoc"] = _compilerStack.natspecUser(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+			contractData["devdoc"] = _compilerStack.natspecDev(contractName);
 
 		// IR
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
+			contractData["ir"] = _compilerStack.yulIR(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+			contractData["irOptimized"] = _compilerStack.yulIROptimized(contractName);
 
 		// Ewasm
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.ewasm(contractName);
+			contractData["ewasm"]["wast"] = _compilerStack.ewasm(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wasm", wildcardMatchesExperimental))
-			contractData["ewasm"]["wasm"] = compilerStack.ewasmObject(contractName).toHex();
+			contractData["ewasm"]["wasm"] = _compilerStack.ewasmObject(contractName).toHex();
 
 		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
+			evmData["methodIdentifiers"] = _compilerStack.interfaceSymbols(contractName)["methods"];
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+			evmData["gasEstimates"] = _compilerStack.gasEstimates(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.irGasEstimates", wildcardMatchesExperimental))
+			evmData["irGasEstimates"] = _compilerStack.irGasEstimates(contractName);
+	}
+
+	// Assembly, bytecode, source maps and generated sources only depend on the compiled code of
+	// the respective contract, so they are collected on multiple threads.
+	auto collectCompiledOutputs = [&](size_t _index) {
+		string const& contractName = contractNames[_index];
+		string file, name;
+		tie(file, name) = splitContractName(contractName);
+		Json::Value& evmData = evmOutputs[_index];
 
-		if (compilationSuccess && isArtifactRequested(
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+			evmData["assembly"] = _compilerStack.assemblyString(contractName, _sourceList);
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+			evmData["legacyAssembly"] = _compilerStack.assemblyJSON(contractName);
+
+		if (isArtifactRequested(
 			_inputsAndSettings.outputSelection,
 			file,
 			name,
@@ -1310,9 +1664,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			wildcardMatchesExperimental
 		))
 			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
+				_compilerStack.object(contractName),
+				_compilerStack.sourceMapping(contractName),
+				_compilerStack.generatedSources(contractName),
 				false,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
@@ -1323,7 +1677,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				); }
 			);
 
-		if (compilationSuccess && isArtifactRequested(
+		if (isArtifactRequested(
 			_inputsAndSettings.outputSelection,
 			file,
 			name,
@@ -1331,9 +1685,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			wildcardMatchesExperimental
 		))
 			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
+				_compilerStack.runtimeObject(contractName),
+				_compilerStack.runtimeSourceMapping(contractName),
+				_compilerStack.generatedSources(contractName, true),
 				true,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
@@ -1344,23 +1698,43 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				); }
 			);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+		// The compiled code is not needed anymore once its outputs are collected, so memory
+		// does not grow with the number of contracts while the output is assembled.
+		_compilerStack.releaseCompiledOutputs(contractName);
+	};
+	if (compilationSuccess)
+		util::parallelFor(contractNames.size(), _inputsAndSettings.parallelism, collectCompiledOutputs);
+
+	// The results are merged in the order of the contract names, independent of the scheduling.
+	Json::Value contractsOutput = Json::objectValue;
+	for (size_t i = 0; i < contractNames.size(); ++i)
+	{
+		string file, name;
+		tie(file, name) = splitContractName(contractNames[i]);
+		Json::Value& contractData = contractOutputs[i];
+		if (!evmOutputs[i].empty())
+			contractData["evm"] = move(evmOutputs[i]);
 
 		if (!contractData.empty())
 		{
 			if (!contractsOutput.isMember(file))
 				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			contractsOutput[file][name] = move(contractData);
 		}
 	}
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (_compilerStack.profiler())
+		output["profiling"] = _compilerStack.profiler()->toJson();
+	if (_compilerStack.optimiserProfile())
+		output["optimizerProfile"] = _compilerStack.optimiserProfile()->toJson();
+
 	return output;
 }
 
 
+
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	Json::Value output = Json::objectValue;
@@ -1406,6 +1780,16 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		));
 		return output;
 	}
+	if (_inputsAndSettings.abiDecoderMode != ABIDecoderMode::Default)
+	{
+		output["errors"].append(formatError(
+			Error::Severity::Error,
+			"JSONError",
+			"general",
+			"Field \"settings.abiCoder.decoderMode\" cannot be used for Yul."
+		));
+		return output;
+	}
 
 	YulStack stack(
 		_inputsAndSettings.evmVersion,
@@ -1501,9 +1885,155 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
+Json::Value StandardCompiler::compileInputsAndSettings(InputsAndSettings _inputsAndSettings)
+{
+	if (_inputsAndSettings.language == "Solidity")
+		return compileSolidity(std::move(_inputsAndSettings));
+	else if (_inputsAndSettings.language == "Yul")
+		return compileYul(std::move(_inputsAndSettings));
+	else
+		return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+}
+
+Json::Value StandardCompiler::compileCached(
+	Json::Value const& _input,
+	InputsAndSettings _inputsAndSettings,
+	boost::filesystem::path const& _cacheDirectory
+)
+{
+	CompilationCache cache(_cacheDirectory);
+
+	// Settings that do not influence the output are not part of the key.
+	Json::Value normalizedInput = _input;
+	if (normalizedInput["settings"].isObject())
+	{
+		normalizedInput["settings"].removeMember("parallelism");
+		normalizedInput["settings"].removeMember("batchedImports");
+		normalizedInput["settings"].removeMember("profiling");
+		normalizedInput["settings"].removeMember("profileOptimizer");
+		if (normalizedInput["settings"].isMember("modelChecker") && normalizedInput["settings"]["modelChecker"].isObject())
+		{
+			normalizedInput["settings"]["modelChecker"].removeMember("cacheDirectory");
+			normalizedInput["settings"]["modelChecker"].removeMember("jobs");
+		}
+	}
+	util::h256 key = util::keccak256(VersionString + "\n" + util::jsonCompactPrint(normalizedInput));
+
+	auto cacheStatistics = [&]() {
+		Json::Value statistics{Json::objectValue};
+		statistics["hits"] = Json::UInt64(m_cacheHits);
+		statistics["misses"] = Json::UInt64(m_cacheMisses);
+		return statistics;
+	};
+
+	// The input only identifies the sources given directly. Files loaded via the read callback
+	// (URLs and imports) are recorded with the entry and have to be checked separately.
+	if (optional<string> entryString = cache.load(key))
+	{
+		Json::Value entry;
+		if (
+			util::jsonParseStrict(*entryString, entry) &&
+			entry.isObject() &&
+			entry["output"].isObject() &&
+			entry["dependencies"].isArray() &&
+			dependenciesUnchanged(entry["dependencies"])
+		)
+		{
+			++m_cacheHits;
+			Json::Value output = std::move(entry["output"]);
+			output["cache"] = cacheStatistics();
+			return output;
+		}
+	}
+
+	++m_cacheMisses;
+	Json::Value output = compileInputsAndSettings(std::move(_inputsAndSettings));
+
+	// Failed compilations are cheap and may depend on the environment (e.g. missing files),
+	// so only successful results are stored.
+	bool hasErrors = false;
+	if (output.isMember("errors"))
+		for (Json::Value const& error: output["errors"])
+			if (error["severity"].asString() == "error")
+				hasErrors = true;
+	if (!hasErrors)
+	{
+		Json::Value entry{Json::objectValue};
+		entry["dependencies"] = m_readDependencies;
+		entry["output"] = output;
+		// Profiling data is only meaningful for the compilation that produced it.
+		entry["output"].removeMember("profiling");
+		entry["output"].removeMember("optimizerProfile");
+		cache.store(key, util::jsonCompactPrint(entry));
+	}
+
+	output["cache"] = cacheStatistics();
+	return output;
+}
+
+bool StandardCompiler::dependenciesUnchanged(Json::Value const& _dependencies) const
+{
+	for (Json::Value const& dependency: _dependencies)
+	{
+		if (
+			!m_readFile ||
+			!dependency["kind"].isString() ||
+			!dependency["path"].isString() ||
+			!dependency["success"].isBool() ||
+			!dependency["keccak256"].isString()
+		)
+			return false;
+
+		ReadCallback::Result result = m_readFile(dependency["kind"].asString(), dependency["path"].asString());
+		if (
+			result.success != dependency["success"].asBool() ||
+			!hashMatchesContent(dependency["keccak256"].asString(), result.responseOrErrorMessage)
+		)
+			return false;
+	}
+	return true;
+}
+
+ReadCallback::Result StandardCompiler::readFile(string const& _kind, string const& _path)
+{
+	solAssert(m_readFile, "");
+	ReadCallback::Result result = m_readFile(_kind, _path);
+
+	Json::Value dependency{Json::objectValue};
+	dependency["kind"] = _kind;
+	dependency["path"] = _path;
+	dependency["success"] = result.success;
+	dependency["keccak256"] = util::keccak256(result.responseOrErrorMessage).hex();
+	m_readDependencies.append(std::move(dependency));
+
+	return result;
+}
+
+ReadCallback::Callback StandardCompiler::recordingReadCallback()
+{
+	if (!m_readFile)
+		return {};
+	return [this](string const& _kind, string const& _path) { return readFile(_kind, _path); };
+}
+
+void StandardCompiler::keepCompilerStack(bool _keep)
+{
+	m_keepCompilerStack = _keep;
+	if (!_keep)
+		m_compilerStack.reset();
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// The strings are only dropped once there are many of them, so that the dialects do not
+	// have to be rebuilt for every compilation. The ASTs kept for reuse still refer to the
+	// strings of their inline assembly blocks, so they are dropped as well in that case.
+	if (YulStringRepository::largerThan(YulStringRepository::MaxRetainedStrings))
+	{
+		m_compilerStack.reset();
+		YulStringRepository::reset();
+	}
+	m_readDependencies = Json::arrayValue;
 
 	try
 	{
@@ -1511,12 +2041,10 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+		if (m_cacheDirectory)
+			return compileCached(_input, std::move(settings), *m_cacheDirectory);
 		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+			return compileInputsAndSettings(std::move(settings));
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -28,6 +28,8 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <boost/filesystem/path.hpp>
+
 #include <optional>
 #include <utility>
 #include <variant>
@@ -63,11 +65,30 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Enables the persistent compilation cache in @a _directory.
+	/// The directory is not part of the input, so that the input cannot make the compiler write
+	/// to paths outside of the allowed directories.
+	void setCacheDirectory(boost::filesystem::path _directory) { m_cacheDirectory = std::move(_directory); }
+	/// Keeps the compiler stack alive between calls to compile(), so that the ASTs of sources
+	/// whose content did not change are not parsed again. Meant for long-running processes.
+	/// The stack is still dropped together with the YulString repository once the repository
+	/// exceeds YulStringRepository::MaxRetainedStrings, which bounds the memory usage.
+	void keepCompilerStack(bool _keep = true);
+
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 	);
 
 private:
+	/// Settings of one of the compilations requested via ``settings.profiles``.
+	struct CompilationProfile
+	{
+		std::string name;
+		langutil::EVMVersion evmVersion;
+		OptimiserSettings optimiserSettings;
+		bool viaIR = false;
+	};
+
 	struct InputsAndSettings
 	{
 		std::string language;
@@ -79,6 +100,7 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<ImportRemapper::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
+		ABIDecoderMode abiDecoderMode = ABIDecoderMode::Default;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		std::map<std::string, util::h160> libraries;
@@ -87,17 +109,65 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelism = 1;
+		bool batchedImports = false;
+		bool lazyBodies = false;
+		bool profiling = false;
+		bool profileOptimizer = false;
+		/// If not empty, the sources are compiled once for each profile instead of with the settings above.
+		std::vector<CompilationProfile> profiles;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
+	Json::Value compileInputsAndSettings(InputsAndSettings _inputsAndSettings);
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles the sources set in @a _compilerStack once for every profile in @a _inputsAndSettings.
+	/// Profiles that agree in the settings the analysis depends on share the parsed and analysed sources.
+	Json::Value compileSolidityProfiles(
+		CompilerStack& _compilerStack,
+		InputsAndSettings const& _inputsAndSettings,
+		StringMap const& _sourceList,
+		Json::Value const& _errors
+	);
+	/// @returns the output of the Solidity compilation performed by @a _compilerStack, given that
+	/// it reported @a _errors.
+	static Json::Value formatSolidityOutput(
+		CompilerStack& _compilerStack,
+		InputsAndSettings const& _inputsAndSettings,
+		StringMap const& _sourceList,
+		Json::Value _errors
+	);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Looks up the output for @a _input in the cache in @a _cacheDirectory and compiles
+	/// and stores it on a miss.
+	Json::Value compileCached(
+		Json::Value const& _input,
+		InputsAndSettings _inputsAndSettings,
+		boost::filesystem::path const& _cacheDirectory
+	);
+	/// @returns true if all files and queries recorded in @a _dependencies still produce the same results.
+	bool dependenciesUnchanged(Json::Value const& _dependencies) const;
+
+	/// Invokes the read callback and records the result as a dependency of the current compilation.
+	ReadCallback::Result readFile(std::string const& _kind, std::string const& _path);
+	/// @returns a callback that forwards to readFile() or an empty callback if there is no read callback.
+	ReadCallback::Callback recordingReadCallback();
+
 	ReadCallback::Callback m_readFile;
 
+	std::optional<boost::filesystem::path> m_cacheDirectory;
+	bool m_keepCompilerStack = false;
+	/// Compiler stack reused across compilations if m_keepCompilerStack is set.
+	std::unique_ptr<CompilerStack> m_compilerStack;
+	/// Results of all read callback invocations during the current compilation.
+	Json::Value m_readDependencies{Json::arrayValue};
+	size_t m_cacheHits = 0;
+	size_t m_cacheMisses = 0;
+
 	util::JsonFormat m_jsonPrintingFormat;
 };
 
@@ -56,7 +56,7 @@ void GotoDefinition::operator()(MessageID _id, Json::Value const& _args)
 	{
 		auto const& path = *importDirective->annotation().absolutePath;
 		if (fileRepository().sourceUnits().count(path))
-			locations.emplace_back(SourceLocation{0, 0, make_shared<string const>(path)});
+			locations.emplace_back(SourceLocation{0, 0, internSourceName(path)});
 	}
 
 	Json::Value reply = Json::arrayValue;
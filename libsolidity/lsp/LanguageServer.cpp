@@ -26,6 +26,7 @@
 
 // LSP feature implementations
 #include <libsolidity/lsp/GotoDefinition.h>
+#include <libsolidity/lsp/References.h>
 
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
@@ -41,6 +42,7 @@
 
 #include <ostream>
 #include <string>
+#include <thread>
 
 using namespace std;
 using namespace std::string_literals;
@@ -53,6 +55,10 @@ using namespace solidity::frontend;
 namespace
 {
 
+/// Time to wait for further messages after the sources changed, before compiling them.
+/// Changes that arrive in the meantime, e.g. while the user is typing, are compiled together.
+chrono::milliseconds constexpr c_diagnosticsDelay{50};
+
 int toDiagnosticSeverity(Error::Type _errorType)
 {
 	// 1=Error, 2=Warning, 3=Info, 4=Hint
@@ -82,14 +88,19 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/didOpen", bind(&LanguageServer::handleTextDocumentDidOpen, this, _2)},
 		{"textDocument/didChange", bind(&LanguageServer::handleTextDocumentDidChange, this, _2)},
 		{"textDocument/didClose", bind(&LanguageServer::handleTextDocumentDidClose, this, _2)},
+		{"textDocument/documentHighlight", DocumentHighlight(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
+		{"textDocument/references", References(*this) },
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */),
 	m_compilerStack{m_fileRepository.reader()}
 {
+	// Most edits touch a single file, the others do not have to be parsed again.
+	m_compilerStack.setReuseParsedSources(true);
 }
 
+
 Json::Value LanguageServer::toRange(SourceLocation const& _location)
 {
 	return HandlerBase(*this).toRange(_location);
@@ -105,7 +116,7 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	m_settingsObject = _settings;
 }
 
-void LanguageServer::compile()
+bool LanguageServer::compile(bool _cancellable)
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
@@ -119,24 +130,43 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.clientPathToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	// The settings never change, so the previous analysis can be reused if the
+	// sources and all files they import are the same.
+	if (!m_compilerStack.sourcesUnchanged(m_fileRepository.sourceUnits()))
+	{
+		m_locationIndices.clear();
+		m_referenceIndex.reset();
+		m_compilerStack.reset(false);
+		m_compilerStack.setSources(m_fileRepository.sourceUnits());
+		m_compilerStack.compile(CompilerStack::State::ParsedAndImported);
+	}
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	// Sources with parser errors are not analyzed.
+	if (
+		m_compilerStack.state() != CompilerStack::State::ParsedAndImported ||
+		Error::containsErrors(m_compilerStack.errors())
+	)
+		return true;
+	// The analysis would be outdated by the time it is finished.
+	if (_cancellable && sourceChangePending())
+		return false;
+	m_compilerStack.analyze();
+	return true;
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::compileAndUpdateDiagnostics(bool _cancellable)
 {
-	compile();
+	if (!compile(_cancellable))
+		return;
+	m_diagnosticsOutdated = false;
 
-	// These are the source units we will sent diagnostics to the client for sure,
-	// even if it is just to clear previous diagnostics.
 	map<string, Json::Value> diagnosticsBySourceUnit;
 	for (string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
-	for (string const& sourceUnitName: m_nonemptyDiagnostics)
-		diagnosticsBySourceUnit[sourceUnitName] = Json::arrayValue;
+	// Source units that are no longer compiled lose their diagnostics.
+	for (auto const& [sourceUnitName, diagnostics]: m_publishedDiagnostics)
+		if (!diagnostics.empty())
+			diagnosticsBySourceUnit.emplace(sourceUnitName, Json::arrayValue);
 
 	for (shared_ptr<Error const> const& error: m_compilerStack.errors())
 	{
@@ -167,59 +197,156 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		diagnosticsBySourceUnit[*location->sourceName].append(jsonDiag);
 	}
 
+	// Only the diagnostics that differ from the ones the client already has are sent.
+	// A source unit that was not published before is always sent, even without diagnostics,
+	// so that the client knows that it was checked.
+	vector<string> changedSourceUnits;
+	for (auto const& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
+		if (
+			auto published = m_publishedDiagnostics.find(sourceUnitName);
+			published == m_publishedDiagnostics.end() || published->second != diagnostics
+		)
+			changedSourceUnits.push_back(sourceUnitName);
+
 	if (m_client.traceValue() != TraceValue::Off)
 	{
 		Json::Value extra;
-		extra["openFileCount"] = Json::UInt64(diagnosticsBySourceUnit.size());
-		m_client.trace("Number of currently open files: " + to_string(diagnosticsBySourceUnit.size()), extra);
+		extra["changedFileCount"] = Json::UInt64(changedSourceUnits.size());
+		m_client.trace("Number of files with changed diagnostics: " + to_string(changedSourceUnits.size()), extra);
 	}
 
-	m_nonemptyDiagnostics.clear();
-	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
+	for (string const& sourceUnitName: changedSourceUnits)
 	{
 		Json::Value params;
 		params["uri"] = m_fileRepository.sourceUnitNameToClientPath(sourceUnitName);
-		if (!diagnostics.empty())
-			m_nonemptyDiagnostics.insert(sourceUnitName);
-		params["diagnostics"] = move(diagnostics);
+		params["diagnostics"] = diagnosticsBySourceUnit[sourceUnitName];
 		m_client.notify("textDocument/publishDiagnostics", move(params));
 	}
+
+	// Source units that are no longer compiled and have no diagnostics left are forgotten,
+	// so that they are published again should they come back.
+	m_publishedDiagnostics.clear();
+	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
+		if (!diagnostics.empty() || m_fileRepository.sourceUnits().count(sourceUnitName))
+			m_publishedDiagnostics[sourceUnitName] = move(diagnostics);
 }
 
 bool LanguageServer::run()
 {
-	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
-	{
-		MessageID id;
-		try
-		{
-			optional<Json::Value> const jsonMessage = m_client.receive();
-			if (!jsonMessage)
-				continue;
+	thread reader([this]() { readMessages(); });
+	// The reader stops by itself after the exit notification or at the end of the input.
+	ScopeGuard joinReader([&]() { reader.join(); });
 
-			if ((*jsonMessage)["method"].isString())
+	auto const exiting = [&]() { return m_state == State::ExitRequested || m_state == State::ExitWithoutShutdown; };
+	while (!exiting())
+	{
+		optional<Json::Value> message = nextMessage(chrono::milliseconds::max());
+		if (!message)
+			break;
+		handleMessage(*message);
+
+		// Further changes are applied before compiling, as long as they arrive quickly.
+		while (m_diagnosticsOutdated && !exiting() && (message = nextMessage(c_diagnosticsDelay)))
+			handleMessage(*message);
+		if (m_diagnosticsOutdated && !exiting())
+			try
 			{
-				string const methodName = (*jsonMessage)["method"].asString();
-				id = (*jsonMessage)["id"];
-
-				if (auto handler = util::valueOrDefault(m_handlers, methodName))
-					handler(id, (*jsonMessage)["params"]);
-				else
-					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+				compileAndUpdateDiagnostics(true /* _cancellable */);
 			}
-			else
-				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
-		}
-		catch (RequestError const& error)
+			catch (...)
+			{
+				m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			}
+	}
+	return m_state == State::ExitRequested;
+}
+
+void LanguageServer::readMessages()
+{
+	while (!m_client.closed())
+	{
+		optional<Json::Value> message;
+		try
 		{
-			m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+			message = m_client.receive();
 		}
 		catch (...)
 		{
-			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+		if (!message)
+			continue;
+
+		bool const exit = (*message)["method"] == "exit";
+		{
+			lock_guard lock(m_incomingMutex);
+			m_incoming.emplace_back(move(*message));
 		}
+		m_incomingAvailable.notify_one();
+		if (exit)
+			break;
+	}
+
+	{
+		lock_guard lock(m_incomingMutex);
+		m_inputFinished = true;
+	}
+	m_incomingAvailable.notify_one();
+}
+
+optional<Json::Value> LanguageServer::nextMessage(chrono::milliseconds _timeout)
+{
+	unique_lock lock(m_incomingMutex);
+	auto const available = [&]() { return !m_incoming.empty() || m_inputFinished; };
+	if (_timeout == chrono::milliseconds::max())
+		m_incomingAvailable.wait(lock, available);
+	else
+		m_incomingAvailable.wait_for(lock, _timeout, available);
+	if (m_incoming.empty())
+		return nullopt;
+	Json::Value message = move(m_incoming.front());
+	m_incoming.pop_front();
+	return message;
+}
+
+bool LanguageServer::sourceChangePending()
+{
+	lock_guard lock(m_incomingMutex);
+	return any_of(m_incoming.begin(), m_incoming.end(), [](Json::Value const& _message) {
+		return _message["method"].isString() && boost::starts_with(_message["method"].asString(), "textDocument/did");
+	});
+}
+
+void LanguageServer::handleMessage(Json::Value const& _message)
+{
+	MessageID id;
+	try
+	{
+		if (_message["method"].isString())
+		{
+			string const methodName = _message["method"].asString();
+			id = _message["id"];
+
+			// Requests about the sources are answered for the sources as they are now.
+			if (m_diagnosticsOutdated && !id.isNull() && boost::starts_with(methodName, "textDocument/"))
+				compileAndUpdateDiagnostics();
+
+			if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				handler(id, _message["params"]);
+			else
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+		}
+		else
+			m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+	}
+	catch (RequestError const& error)
+	{
+		m_client.error(id, error.code(), error.comment() ? *error.comment() : ""s);
+	}
+	catch (...)
+	{
+		m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 	}
-	return m_state == State::ExitRequested;
 }
 
 void LanguageServer::requireServerInitialized()
@@ -267,6 +394,8 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	replyArgs["serverInfo"]["version"] = string(VersionNumber);
 	replyArgs["capabilities"]["definitionProvider"] = true;
 	replyArgs["capabilities"]["implementationProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
+	replyArgs["capabilities"]["documentHighlightProvider"] = true;
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 
@@ -310,7 +439,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.insert(uri);
 	m_fileRepository.setSourceByClientPath(uri, move(text));
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -351,7 +480,7 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 		m_fileRepository.setSourceByClientPath(uri, move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -367,7 +496,20 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.erase(uri);
 
-	compileAndUpdateDiagnostics();
+	m_diagnosticsOutdated = true;
+}
+
+ReferenceIndex const& LanguageServer::referenceIndex()
+{
+	solAssert(m_compilerStack.state() >= CompilerStack::AnalysisPerformed);
+	if (!m_referenceIndex)
+	{
+		vector<SourceUnit const*> sourceUnits;
+		for (string const& sourceName: m_compilerStack.sourceNames())
+			sourceUnits.push_back(&m_compilerStack.ast(sourceName));
+		m_referenceIndex.emplace(sourceUnits);
+	}
+	return *m_referenceIndex;
 }
 
 ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
@@ -380,7 +522,12 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 	if (optional<int> sourcePos =
 		m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos))
-		return locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName));
+	{
+		auto index = m_locationIndices.find(_sourceUnitName);
+		if (index == m_locationIndices.end())
+			index = m_locationIndices.emplace(_sourceUnitName, ASTLocationIndex(m_compilerStack.ast(_sourceUnitName))).first;
+		return index->second.innermostNode(*sourcePos);
+	}
 	else
 		return nullptr;
 }
@@ -19,13 +19,19 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/lsp/ReferenceIndex.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
+#include <libsolidity/ast/ASTUtils.h>
 
 #include <json/value.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -46,10 +52,15 @@ public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
-	void compileAndUpdateDiagnostics();
+	/// Re-compiles the project and sends the diagnostics of the files whose diagnostics changed
+	/// since the last update to the client.
+	/// If @a _cancellable is true, nothing is updated if further changes to the sources
+	/// are received before the analysis starts.
+	void compileAndUpdateDiagnostics(bool _cancellable = false);
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
+	/// Messages are read on a separate thread, so that changes that arrive while the project
+	/// is compiled are applied together and only trigger one more compilation.
 	///
 	/// The standard shutdown condition is when the maximum number of consecutive failures
 	/// has been exceeded.
@@ -60,6 +71,9 @@ public:
 	FileRepository& fileRepository() noexcept { return m_fileRepository; }
 	Transport& client() noexcept { return m_client; }
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
+	/// @returns the references of the analysed sources, collecting them on first use after
+	/// a compilation. Only valid if the analysis was performed.
+	ReferenceIndex const& referenceIndex();
 	langutil::CharStreamProvider const& charStreamProvider() const noexcept { return m_compilerStack; }
 
 private:
@@ -78,7 +92,18 @@ private:
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
-	void compile();
+	/// @returns false if the analysis was skipped because @a _cancellable is true
+	/// and further changes to the sources were received.
+	bool compile(bool _cancellable);
+
+	/// Receives messages from the client and queues them until the input ends or exit is requested.
+	void readMessages();
+	/// Waits for the next queued message for at most @a _timeout.
+	/// @returns the message or nullopt if there was none.
+	std::optional<Json::Value> nextMessage(std::chrono::milliseconds _timeout);
+	void handleMessage(Json::Value const& _message);
+	/// @returns true if a notification that changes the sources is waiting to be handled.
+	bool sourceChangePending();
 	using MessageHandler = std::function<void(MessageID, Json::Value const&)>;
 
 	Json::Value toRange(langutil::SourceLocation const& _location);
@@ -94,14 +119,27 @@ private:
 
 	/// Set of files known to be open by the client.
 	std::set<std::string> m_openFiles;
-	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
-	std::set<std::string> m_nonemptyDiagnostics;
+	/// Diagnostics that were last sent to the client for each source unit.
+	std::map<std::string, Json::Value> m_publishedDiagnostics;
 	FileRepository m_fileRepository;
 
 	frontend::CompilerStack m_compilerStack;
+	/// Location indices of the source units of the current compilation, built on first use.
+	std::map<std::string, frontend::ASTLocationIndex> m_locationIndices;
+	/// References of the current compilation, collected on first use.
+	std::optional<ReferenceIndex> m_referenceIndex;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
+
+	/// Whether the sources changed since the diagnostics were published.
+	bool m_diagnosticsOutdated = false;
+	/// Messages that were received, but not handled yet.
+	std::deque<Json::Value> m_incoming;
+	/// Set when no more messages will be received.
+	bool m_inputFinished = false;
+	std::mutex m_incomingMutex;
+	std::condition_variable m_incomingAvailable;
 };
 
 }
@@ -0,0 +1,84 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/ReferenceIndex.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <algorithm>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+namespace
+{
+
+/// @returns the part of @a _location that holds @a _name, which ends the referencing node,
+/// e.g. the member name of a member access.
+SourceLocation trailingName(SourceLocation _location, string const& _name)
+{
+	int length = static_cast<int>(_name.size());
+	if (_location.hasText() && _location.end - length >= _location.start)
+		_location.start = _location.end - length;
+	return _location;
+}
+
+}
+
+ReferenceIndex::ReferenceIndex(vector<SourceUnit const*> const& _sourceUnits)
+{
+	auto addReference = [&](Declaration const* _declaration, SourceLocation const& _location) {
+		if (_declaration && _location.hasText())
+			m_references[_declaration].push_back(_location);
+	};
+	SimpleASTVisitor collector(
+		[&](ASTNode const& _node) -> bool
+		{
+			if (auto const* identifier = dynamic_cast<Identifier const*>(&_node))
+				addReference(identifier->annotation().referencedDeclaration, identifier->location());
+			else if (auto const* memberAccess = dynamic_cast<MemberAccess const*>(&_node))
+				addReference(
+					memberAccess->annotation().referencedDeclaration,
+					trailingName(memberAccess->location(), memberAccess->memberName())
+				);
+			else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(&_node))
+				addReference(
+					identifierPath->annotation().referencedDeclaration,
+					trailingName(identifierPath->location(), identifierPath->path().back())
+				);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		sourceUnit->accept(collector);
+
+	for (auto& [declaration, locations]: m_references)
+	{
+		sort(locations.begin(), locations.end());
+		locations.erase(unique(locations.begin(), locations.end()), locations.end());
+	}
+}
+
+vector<SourceLocation> const& ReferenceIndex::references(Declaration const& _declaration) const
+{
+	static vector<SourceLocation> const noReferences;
+	auto it = m_references.find(&_declaration);
+	return it == m_references.end() ? noReferences : it->second;
+}
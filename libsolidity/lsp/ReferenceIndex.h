@@ -0,0 +1,50 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <map>
+#include <vector>
+
+namespace solidity::lsp
+{
+
+/**
+ * Maps every declaration to the locations of the identifiers, member accesses and identifier
+ * paths that refer to it, so that all references to a declaration can be listed without
+ * visiting the ASTs again.
+ * The index refers to the declarations, so it must not outlive the ASTs.
+ */
+class ReferenceIndex
+{
+public:
+	/// Collects the references in @a _sourceUnits, which have to be analysed.
+	explicit ReferenceIndex(std::vector<frontend::SourceUnit const*> const& _sourceUnits);
+
+	/// @returns the locations of the names that refer to @a _declaration,
+	/// ordered by source unit name and offset.
+	std::vector<langutil::SourceLocation> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	std::map<frontend::Declaration const*, std::vector<langutil::SourceLocation>> m_references;
+};
+
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/References.h>
+#include <libsolidity/lsp/ReferenceIndex.h>
+#include <libsolidity/lsp/Utils.h>
+#include <libsolidity/ast/AST.h>
+
+#include <algorithm>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+vector<SourceLocation> References::referencesAtPosition(Json::Value const& _args, bool _includeDeclaration)
+{
+	auto const [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
+
+	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
+
+	Declaration const* declaration = nullptr;
+	if (auto const* expression = dynamic_cast<Expression const*>(sourceNode))
+		declaration = referencedDeclaration(expression);
+	else if (auto const* identifierPath = dynamic_cast<IdentifierPath const*>(sourceNode))
+		declaration = identifierPath->annotation().referencedDeclaration;
+	else
+		declaration = dynamic_cast<Declaration const*>(sourceNode);
+	if (!declaration)
+		return {};
+
+	vector<SourceLocation> locations = m_server.referenceIndex().references(*declaration);
+	if (_includeDeclaration)
+		if (optional<SourceLocation> location = declarationLocation(declaration); location && location->hasText())
+		{
+			locations.insert(upper_bound(locations.begin(), locations.end(), *location), *location);
+			locations.erase(unique(locations.begin(), locations.end()), locations.end());
+		}
+	return locations;
+}
+
+void References::operator()(MessageID _id, Json::Value const& _args)
+{
+	Json::Value reply = Json::arrayValue;
+	for (SourceLocation const& location: referencesAtPosition(_args, _args["context"]["includeDeclaration"].asBool()))
+		reply.append(toJson(location));
+	client().reply(_id, reply);
+}
+
+void DocumentHighlight::operator()(MessageID _id, Json::Value const& _args)
+{
+	string const sourceUnitName = fileRepository().clientPathToSourceUnitName(_args["textDocument"]["uri"].asString());
+
+	Json::Value reply = Json::arrayValue;
+	for (SourceLocation const& location: referencesAtPosition(_args, true))
+		if (*location.sourceName == sourceUnitName)
+		{
+			Json::Value highlight = Json::objectValue;
+			highlight["range"] = toRange(location);
+			reply.append(highlight);
+		}
+	client().reply(_id, reply);
+}
@@ -0,0 +1,48 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/HandlerBase.h>
+
+#include <vector>
+
+namespace solidity::lsp
+{
+
+/// Handles `textDocument/references`.
+class References: public HandlerBase
+{
+public:
+	explicit References(LanguageServer& _server): HandlerBase(_server) {}
+
+	void operator()(MessageID, Json::Value const&);
+
+protected:
+	/// @returns the locations of all references to the declaration at the position given in
+	/// @a _args, which includes the name of the declaration itself if @a _includeDeclaration is true.
+	std::vector<langutil::SourceLocation> referencesAtPosition(Json::Value const& _args, bool _includeDeclaration);
+};
+
+/// Handles `textDocument/documentHighlight` by listing the references within the same document.
+class DocumentHighlight: public References
+{
+public:
+	explicit DocumentHighlight(LanguageServer& _server): References(_server) {}
+
+	void operator()(MessageID, Json::Value const&);
+};
+
+}
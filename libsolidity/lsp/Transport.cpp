@@ -34,6 +34,10 @@ IOStreamTransport::IOStreamTransport(istream& _in, ostream& _out):
 	m_input{_in},
 	m_output{_out}
 {
+	// Same settings as util::jsonCompactPrint.
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+	m_jsonWriter.reset(builder.newStreamWriter());
 }
 
 IOStreamTransport::IOStreamTransport():
@@ -117,7 +121,10 @@ void IOStreamTransport::send(Json::Value _json, MessageID _id)
 	if (_id != Json::nullValue)
 		_json["id"] = _id;
 
-	string const jsonString = solidity::util::jsonCompactPrint(_json);
+	lock_guard lock(m_outputMutex);
+	m_messageBuffer.str({});
+	m_jsonWriter->write(_json, &m_messageBuffer);
+	string const jsonString = m_messageBuffer.str();
 
 	m_output << "Content-Length: " << jsonString.size() << "\r\n";
 	m_output << "\r\n";
@@ -20,11 +20,15 @@
 #include <libsolutil/Exceptions.h>
 
 #include <json/value.h>
+#include <json/writer.h>
 
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -109,6 +113,7 @@ private:
 
 /**
  * LSP Transport using JSON-RPC over iostreams.
+ * Messages can be sent from one thread while another one receives.
  */
 class IOStreamTransport: public Transport
 {
@@ -140,6 +145,12 @@ protected:
 private:
 	std::istream& m_input;
 	std::ostream& m_output;
+	/// Keeps messages that are sent concurrently from interleaving.
+	std::mutex m_outputMutex;
+	/// Writer for the compact JSON of the messages, created once instead of for every message.
+	/// Guarded by @a m_outputMutex together with @a m_messageBuffer.
+	std::unique_ptr<Json::StreamWriter> m_jsonWriter;
+	std::ostringstream m_messageBuffer;
 };
 
 }
@@ -98,7 +98,7 @@ optional<SourceLocation> parsePosition(
 			_fileRepository.sourceUnits().at(_sourceUnitName),
 			*lineColumn
 		))
-			return SourceLocation{*offset, *offset, make_shared<string>(_sourceUnitName)};
+			return SourceLocation{*offset, *offset, internSourceName(_sourceUnitName)};
 	return nullopt;
 }
 
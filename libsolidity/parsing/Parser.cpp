@@ -23,6 +23,7 @@
 
 #include <libsolidity/parsing/Parser.h>
 
+#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
@@ -38,6 +39,7 @@
 #include <cctype>
 #include <vector>
 #include <regex>
+#include <unordered_set>
 
 using namespace std;
 using namespace solidity::langutil;
@@ -72,7 +74,12 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return allocate_shared<NodeType>(
+			util::ArenaAllocator<NodeType>(m_parser.m_arena),
+			m_parser.nextID(),
+			m_location,
+			std::forward<Args>(_args)...
+		);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -82,13 +89,15 @@ private:
 	SourceLocation m_location;
 };
 
-ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
+ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream, bool _skipFunctionBodies)
 {
 	solAssert(!m_insideModifier, "");
+	m_skipFunctionBodies = _skipFunctionBodies;
 	try
 	{
 		m_recursionDepth = 0;
 		m_scanner = make_shared<Scanner>(_charStream);
+		m_arena = make_shared<util::Arena>();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -156,6 +165,29 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+void Parser::shiftNodeIDs(SourceUnit& _sourceUnit, int64_t _offset)
+{
+	if (_offset == 0)
+		return;
+	struct NodeCollector: ASTVisitor
+	{
+		bool visitNode(ASTNode& _node) override
+		{
+			nodes.insert(&_node);
+			return true;
+		}
+		// A set, so that nodes reachable in more than one way are only shifted once.
+		unordered_set<ASTNode*> nodes;
+	};
+	NodeCollector collector;
+	_sourceUnit.accept(collector);
+	for (ASTNode* node: collector.nodes)
+	{
+		solAssert(static_cast<int64_t>(node->m_id) + _offset > 0, "");
+		node->m_id = static_cast<size_t>(static_cast<int64_t>(node->m_id) + _offset);
+	}
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, vector<Token> const& _tokens, vector<string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -650,7 +682,7 @@ ASTPointer<ASTNode> Parser::parseFunctionDefinition(bool _freeFunction)
 		advance();
 	else
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	return nodeFactory.createNode<FunctionDefinition>(
@@ -903,7 +935,7 @@ ASTPointer<ModifierDefinition> Parser::parseModifierDefinition()
 	nodeFactory.markEndPosition();
 	if (m_scanner->currentToken() != Token::Semicolon)
 	{
-		block = parseBlock();
+		block = parseFunctionBody();
 		nodeFactory.setEndPositionFromNode(block);
 	}
 	else
@@ -1242,6 +1274,33 @@ ASTPointer<Block> Parser::parseBlock(bool _allowUnchecked, ASTPointer<ASTString>
 	return nodeFactory.createNode<Block>(_docString, unchecked, statements);
 }
 
+ASTPointer<Block> Parser::parseFunctionBody()
+{
+	if (!m_skipFunctionBodies)
+		return parseBlock();
+
+	RecursionGuard recursionGuard(*this);
+	ASTNodeFactory nodeFactory(*this);
+	expectToken(Token::LBrace);
+	// Braces inside of string literals and comments are part of other tokens,
+	// so counting the brace tokens is enough to find the end of the body.
+	size_t depth = 0;
+	while (
+		m_scanner->currentToken() != Token::EOS &&
+		(depth > 0 || m_scanner->currentToken() != Token::RBrace)
+	)
+	{
+		if (m_scanner->currentToken() == Token::LBrace)
+			depth++;
+		else if (m_scanner->currentToken() == Token::RBrace)
+			depth--;
+		advance();
+	}
+	nodeFactory.markEndPosition();
+	expectToken(Token::RBrace);
+	return nodeFactory.createNode<Block>(nullptr, false, vector<ASTPointer<Statement>>{}, true);
+}
+
 ASTPointer<Statement> Parser::parseStatement(bool _allowUnchecked)
 {
 	RecursionGuard recursionGuard(*this);
@@ -1366,7 +1425,15 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, move(flags), block);
+	return allocate_shared<InlineAssembly>(
+		util::ArenaAllocator<InlineAssembly>(m_arena),
+		nextID(),
+		location,
+		_docString,
+		dialect,
+		move(flags),
+		block
+	);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
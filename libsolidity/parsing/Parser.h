@@ -27,6 +27,8 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Arena.h>
+
 namespace solidity::langutil
 {
 class CharStream;
@@ -47,7 +49,22 @@ public:
 		m_evmVersion(_evmVersion)
 	{}
 
-	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
+	/// @param _skipFunctionBodies if true, the bodies of functions and modifiers are only
+	/// matched for braces and represented by empty blocks (see Block::skipped). This is
+	/// sufficient for name and type resolution of the declarations, but not for code generation.
+	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream, bool _skipFunctionBodies = false);
+
+	/// @returns the ID of the last node created by this parser, i.e. the number of IDs it used.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+
+	/// Lets the parser continue as if it had created @a _count more nodes. Used for source units
+	/// that are not parsed again, whose nodes keep their IDs.
+	void skipNodeIDs(int64_t _count) { m_currentNodeID += _count; }
+
+	/// Adds @a _offset to the IDs of all nodes of @a _sourceUnit. Gives a source unit that was
+	/// parsed by its own parser the IDs it would have received from a parser that had already
+	/// created @a _offset nodes. The offset can be negative as long as all IDs stay positive.
+	static void shiftNodeIDs(SourceUnit& _sourceUnit, int64_t _offset);
 
 private:
 	class ASTNodeFactory;
@@ -119,6 +136,9 @@ private:
 		bool _allowEmpty = true
 	);
 	ASTPointer<Block> parseBlock(bool _allowUncheckedBlock = false, ASTPointer<ASTString> const& _docString = {});
+	/// Parses the body of a function or modifier, or only matches its braces if
+	/// m_skipFunctionBodies is set.
+	ASTPointer<Block> parseFunctionBody();
 	ASTPointer<Statement> parseStatement(bool _allowUncheckedBlock = false);
 	ASTPointer<InlineAssembly> parseInlineAssembly(ASTPointer<ASTString> const& _docString = {});
 	ASTPointer<IfStatement> parseIfStatement(ASTPointer<ASTString> const& _docString);
@@ -214,9 +234,13 @@ private:
 
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
+	/// Whether the bodies of functions and modifiers are skipped in the current source unit.
+	bool m_skipFunctionBodies = false;
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Memory of the nodes of the source unit that is being parsed. Every node keeps it alive.
+	std::shared_ptr<util::Arena> m_arena;
 };
 
 }
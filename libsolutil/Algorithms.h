@@ -18,9 +18,12 @@
 #pragma once
 
 
+#include <algorithm>
 #include <functional>
 #include <list>
+#include <map>
 #include <set>
+#include <vector>
 
 namespace solidity::util
 {
@@ -125,4 +128,69 @@ struct BreadthFirstSearch
 	std::set<V> visited{};
 };
 
+/**
+ * Computes the strongly connected components of a directed graph using Tarjan's algorithm.
+ * The components are returned in reverse topological order, i.e. every component appears
+ * after all components reachable from it. This allows bottom-up propagation of properties
+ * along the edges of the graph, visiting every vertex once.
+ *
+ * Note that V needs to be a comparable value type or a pointer.
+ *
+ * @param _vertices the vertices to start the search from, the order of the result follows their order.
+ * @param _forEachSuccessor is a callable of the form [...](V const& _vertex, auto&& _addSuccessor) { ... }
+ * that is supposed to call _addSuccessor(successor) for every successor of _vertex.
+ */
+template<typename V, typename ForEachSuccessor>
+std::vector<std::vector<V>> stronglyConnectedComponents(std::vector<V> const& _vertices, ForEachSuccessor&& _forEachSuccessor)
+{
+	struct VertexInfo
+	{
+		size_t index = 0;
+		size_t lowLink = 0;
+		bool onStack = false;
+	};
+	std::map<V, VertexInfo> info;
+	std::vector<V> stack;
+	std::vector<std::vector<V>> components;
+
+	auto visit = [&](V const& _vertex, auto&& _recurse) -> void {
+		size_t const index = info.size();
+		VertexInfo& vertexInfo = info[_vertex];
+		vertexInfo = {index, index, true};
+		stack.push_back(_vertex);
+
+		_forEachSuccessor(_vertex, [&](V const& _successor) {
+			if (!info.count(_successor))
+			{
+				_recurse(_successor, _recurse);
+				vertexInfo.lowLink = std::min(vertexInfo.lowLink, info.at(_successor).lowLink);
+			}
+			else if (info.at(_successor).onStack)
+				vertexInfo.lowLink = std::min(vertexInfo.lowLink, info.at(_successor).index);
+		});
+
+		if (vertexInfo.lowLink == vertexInfo.index)
+		{
+			std::vector<V> component;
+			while (true)
+			{
+				V member = std::move(stack.back());
+				stack.pop_back();
+				info.at(member).onStack = false;
+				bool const done = member == _vertex;
+				component.emplace_back(std::move(member));
+				if (done)
+					break;
+			}
+			components.emplace_back(std::move(component));
+		}
+	};
+
+	for (V const& vertex: _vertices)
+		if (!info.count(vertex))
+			visit(vertex, visit);
+
+	return components;
+}
+
 }
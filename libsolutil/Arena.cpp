@@ -0,0 +1,42 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+void* Arena::allocateSlow(size_t _size, size_t _alignment)
+{
+	// Allocations that do not fit into a regular block get a block of their own,
+	// which does not replace the current block.
+	size_t required = _size + _alignment - 1;
+	if (required > m_blockSize / 4)
+	{
+		m_blocks.emplace_back(new byte[required]);
+		uintptr_t start = reinterpret_cast<uintptr_t>(m_blocks.back().get());
+		return reinterpret_cast<void*>((start + _alignment - 1) & ~(uintptr_t(_alignment) - 1));
+	}
+
+	m_blocks.emplace_back(new byte[m_blockSize]);
+	m_position = m_blocks.back().get();
+	m_end = m_position + m_blockSize;
+	return allocate(_size, _alignment);
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Bump-pointer allocation of many small objects that are freed together.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Memory region that hands out memory by advancing a pointer inside large blocks.
+ * Individual allocations are never returned, all blocks are freed at once when the arena
+ * is destroyed. Destructors of the objects placed in the arena are not called by the arena.
+ * Not thread-safe.
+ */
+class Arena
+{
+public:
+	explicit Arena(size_t _blockSize = 64 * 1024): m_blockSize(_blockSize) {}
+
+	Arena(Arena const&) = delete;
+	Arena& operator=(Arena const&) = delete;
+
+	/// @returns @a _size bytes of memory aligned to @a _alignment, which has to be a power of two.
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		uintptr_t aligned = (reinterpret_cast<uintptr_t>(m_position) + _alignment - 1) & ~(uintptr_t(_alignment) - 1);
+		if (m_position && aligned + _size <= reinterpret_cast<uintptr_t>(m_end))
+		{
+			m_position = reinterpret_cast<std::byte*>(aligned + _size);
+			return reinterpret_cast<void*>(aligned);
+		}
+		return allocateSlow(_size, _alignment);
+	}
+
+	/// @returns the number of blocks allocated so far.
+	size_t blocks() const { return m_blocks.size(); }
+
+private:
+	void* allocateSlow(size_t _size, size_t _alignment);
+
+	size_t m_blockSize;
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	std::byte* m_position = nullptr;
+	std::byte* m_end = nullptr;
+};
+
+/**
+ * Standard allocator that takes its memory from a shared Arena, which it keeps alive.
+ * Deallocation is a no-op, the memory is released together with the arena.
+ * Meant for `std::allocate_shared`, which stores a copy of the allocator next to the object,
+ * so that the arena lives as long as the last object allocated from it.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _n) { return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
@@ -153,7 +153,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string_view _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +163,46 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
+		string_view chunkData = _data.substr(chunkIndex * maxChunkSize, maxChunkSize);
+		bytes lengthAsVarint = varintEncoding(chunkData.size());
 
-		bytes protobufEncodedData;
+		// The protobuf encoding surrounds the data with a header and a footer.
+		// They are hashed together with the data directly from the input instead of copying it.
+		bytes protobufHeader;
 		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
-		{
+		protobufHeader += bytes{0x08, 0x02};
+		if (!chunkData.empty())
 			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
+			protobufHeader += bytes{0x12} + lengthAsVarint;
 		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
+		bytes protobufFooter = bytes{0x18} + lengthAsVarint;
 
 		// PBDag:
 		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
-
+		size_t protobufSize = protobufHeader.size() + chunkData.size() + protobufFooter.size();
+		bytes blockHeader = bytes{0x0a} + varintEncoding(protobufSize) + protobufHeader;
+
+		picosha2::hash256_one_by_one hasher;
+		hasher.process(blockHeader.begin(), blockHeader.end());
+		hasher.process(chunkData.begin(), chunkData.end());
+		hasher.process(protobufFooter.begin(), protobufFooter.end());
+		hasher.finish();
 		// Multihash: sha2-256, 256 bits
+		bytes hash{0x12, 0x20};
+		hash.resize(2 + picosha2::k_digest_size);
+		hasher.get_hash_bytes(hash.begin() + 2, hash.end());
+
 		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
+			std::move(hash),
+			chunkData.size(),
+			blockHeader.size() + chunkData.size() + protobufFooter.size()
 		);
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string_view _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -76,6 +76,135 @@ string print(Json::Value const& _input, Json::StreamWriterBuilder const& _builde
 	return stream.str();
 }
 
+/// Compact serialisation that produces the same bytes as jsoncpp's StreamWriter with empty
+/// indentation, but appends to a single string instead of going through streams and
+/// temporary strings for every value. Strings with characters that jsoncpp escapes as
+/// ``\u`` sequences, floating point numbers and comments are rare, so they are still written by jsoncpp.
+class CompactWriter
+{
+public:
+	string write(Json::Value const& _value)
+	{
+		writeValue(_value);
+		return std::move(m_output);
+	}
+
+private:
+	void writeValue(Json::Value const& _value)
+	{
+		if (
+			_value.hasComment(Json::commentBefore) ||
+			_value.hasComment(Json::commentAfterOnSameLine) ||
+			_value.hasComment(Json::commentAfter)
+		)
+		{
+			m_output += print(_value, fallbackBuilder());
+			return;
+		}
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			m_output += "null";
+			break;
+		case Json::intValue:
+			m_output += to_string(_value.asLargestInt());
+			break;
+		case Json::uintValue:
+			m_output += to_string(_value.asLargestUInt());
+			break;
+		case Json::realValue:
+			m_output += print(_value, fallbackBuilder());
+			break;
+		case Json::booleanValue:
+			m_output += _value.asBool() ? "true" : "false";
+			break;
+		case Json::stringValue:
+		{
+			char const* begin = nullptr;
+			char const* end = nullptr;
+			if (_value.getString(&begin, &end))
+				writeString(begin, end);
+			break;
+		}
+		case Json::arrayValue:
+		{
+			m_output += '[';
+			for (Json::ArrayIndex i = 0; i < _value.size(); ++i)
+			{
+				if (i > 0)
+					m_output += ',';
+				writeValue(_value[i]);
+			}
+			m_output += ']';
+			break;
+		}
+		case Json::objectValue:
+		{
+			m_output += '{';
+			bool first = true;
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				if (!first)
+					m_output += ',';
+				first = false;
+				char const* nameEnd = nullptr;
+				char const* name = it.memberName(&nameEnd);
+				writeString(name, nameEnd);
+				m_output += ':';
+				writeValue(*it);
+			}
+			m_output += '}';
+			break;
+		}
+		}
+	}
+
+	void writeString(char const* _begin, char const* _end)
+	{
+		for (char const* c = _begin; c != _end; ++c)
+		{
+			auto byte = static_cast<unsigned char>(*c);
+			if (byte >= 0x80 || (byte < 0x20 && !shortEscape(*c)))
+			{
+				m_output += print(Json::Value(_begin, _end), fallbackBuilder());
+				return;
+			}
+		}
+		m_output += '"';
+		for (char const* c = _begin; c != _end; ++c)
+			if (char const* escape = shortEscape(*c))
+				m_output += escape;
+			else if (*c == '"')
+				m_output += "\\\"";
+			else if (*c == '\\')
+				m_output += "\\\\";
+			else
+				m_output += *c;
+		m_output += '"';
+	}
+
+	static char const* shortEscape(char _c)
+	{
+		switch (_c)
+		{
+		case '\b': return "\\b";
+		case '\f': return "\\f";
+		case '\n': return "\\n";
+		case '\r': return "\\r";
+		case '\t': return "\\t";
+		default: return nullptr;
+		}
+	}
+
+	static Json::StreamWriterBuilder const& fallbackBuilder()
+	{
+		static StreamWriterBuilder const builder(map<string, Json::Value>{{"indentation", ""}});
+		return builder;
+	}
+
+	string m_output;
+};
+
 /// Parse a JSON string (@a _input) with specified builder (@ _builder) and writes resulting JSON object to (@a _json)
 /// \param _builder CharReaderBuilder that is used to create new Json::CharReaders
 /// \param _input JSON input string
@@ -125,6 +254,9 @@ string jsonCompactPrint(Json::Value const& _input)
 
 string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 {
+	if (_format.format == JsonFormat::Compact)
+		return CompactWriter{}.write(_input);
+
 	map<string, Json::Value> settings;
 	if (_format.format == JsonFormat::Pretty)
 	{
@@ -73,8 +73,11 @@ static uint64_t const RC[24] = \
 	REPEAT5(e; v = static_cast<type>(v + s);)
 
 /*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
+static inline void keccakf(uint8_t* state) {
+	// The lanes are copied out of the byte array instead of accessing it through
+	// a uint64_t pointer, which would violate strict aliasing.
+	uint64_t a[25];
+	memcpy(a, state, sizeof(a));
 	uint64_t b[5] = {0};
 
 	for (int i = 0; i < 24; i++)
@@ -106,6 +109,7 @@ static inline void keccakf(void* state) {
 		// Iota
 		a[0] ^= RC[i];
 	}
+	memcpy(state, a, sizeof(a));
 }
 
 /******** The FIPS202-defined functions. ********/
@@ -20,28 +20,36 @@
 
 #include <libsolutil/Common.h>
 
+#include <optional>
+
 namespace solidity::util
 {
 
-inline bytes lebEncode(uint64_t _n)
+/// Appends the unsigned LEB128 encoding of @a _n to @a _out.
+inline void lebEncodeTo(bytes& _out, uint64_t _n)
 {
-	bytes encoded;
 	while (_n > 0x7f)
 	{
-		encoded.emplace_back(uint8_t(0x80 | (_n & 0x7f)));
+		_out.emplace_back(uint8_t(0x80 | (_n & 0x7f)));
 		_n >>= 7;
 	}
-	encoded.emplace_back(_n);
+	_out.emplace_back(_n);
+}
+
+inline bytes lebEncode(uint64_t _n)
+{
+	bytes encoded;
+	lebEncodeTo(encoded, _n);
 	return encoded;
 }
 
 // signed right shift is an arithmetic right shift
 static_assert((-1 >> 1) == -1, "Arithmetic shift not supported.");
 
-inline bytes lebEncodeSigned(int64_t _n)
+/// Appends the signed LEB128 encoding of @a _n to @a _out.
+inline void lebEncodeSignedTo(bytes& _out, int64_t _n)
 {
 	// Based on https://github.com/llvm/llvm-project/blob/master/llvm/include/llvm/Support/LEB128.h
-	bytes result;
 	bool more;
 	do
 	{
@@ -50,10 +58,54 @@ inline bytes lebEncodeSigned(int64_t _n)
 		more = !((((_n == 0) && ((v & 0x40) == 0)) || ((_n == -1) && ((v & 0x40) != 0))));
 		if (more)
 			v |= 0x80; // Mark this byte to show that more bytes will follow.
-		result.emplace_back(v);
+		_out.emplace_back(v);
 	}
 	while (more);
+}
+
+inline bytes lebEncodeSigned(int64_t _n)
+{
+	bytes result;
+	lebEncodeSignedTo(result, _n);
 	return result;
 }
 
+/// Decodes an unsigned LEB128 number that starts at @a _position in @a _data
+/// and moves @a _position past it.
+/// @returns nullopt if the encoding is truncated or does not fit into 64 bits.
+inline std::optional<uint64_t> lebDecode(bytesConstRef _data, size_t& _position)
+{
+	uint64_t result = 0;
+	for (unsigned shift = 0; _position < _data.size() && shift < 64; shift += 7)
+	{
+		uint8_t byte = _data[_position++];
+		if (shift == 63 && (byte & 0x7e))
+			return std::nullopt;
+		result |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return result;
+	}
+	return std::nullopt;
+}
+
+/// Decodes a signed LEB128 number that starts at @a _position in @a _data
+/// and moves @a _position past it.
+/// @returns nullopt if the encoding is truncated or longer than needed for 64 bits.
+inline std::optional<int64_t> lebDecodeSigned(bytesConstRef _data, size_t& _position)
+{
+	uint64_t result = 0;
+	for (unsigned shift = 0; _position < _data.size() && shift < 64; shift += 7)
+	{
+		uint8_t byte = _data[_position++];
+		result |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+		{
+			if (shift + 7 < 64 && (byte & 0x40))
+				result |= ~uint64_t(0) << (shift + 7);
+			return static_cast<int64_t>(result);
+		}
+	}
+	return std::nullopt;
+}
+
 }
@@ -38,3 +38,21 @@ bool solidity::fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, u
 	bigint bitsNeeded = mostSignificantMantissaBit + bigint(floor(double(_exp) * _log2OfBase)) + 1;
 	return bitsNeeded <= bitsMax;
 }
+
+std::string solidity::toCompactHexWithPrefix(u256 const& _value)
+{
+	static char const hexDigits[] = "0123456789abcdef";
+	char digits[64];
+	for (size_t word = 0; word < 4; ++word)
+	{
+		// Conversion to uint64_t saturates, so the word has to be masked first.
+		auto value = static_cast<uint64_t>((_value >> (64 * (3 - word))) & std::numeric_limits<uint64_t>::max());
+		for (size_t i = 0; i < 16; ++i)
+			digits[16 * word + i] = hexDigits[(value >> (60 - 4 * i)) & 0xf];
+	}
+	// Skip leading zero bytes, but keep at least one byte.
+	size_t start = 0;
+	while (start < 62 && digits[start] == '0' && digits[start + 1] == '0')
+		start += 2;
+	return "0x" + std::string(digits + start, digits + 64);
+}
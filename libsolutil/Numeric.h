@@ -136,6 +136,9 @@ inline std::string toCompactHexWithPrefix(T _value)
 	return "0x" + util::toHex(toCompactBigEndian(_value, 1));
 }
 
+/// Same as the generic version, but formats 64 bit words instead of shifting out single bytes.
+std::string toCompactHexWithPrefix(u256 const& _value);
+
 /// Returns decimal representation for small numbers and hex for large numbers.
 inline std::string formatNumber(bigint const& _value)
 {
@@ -152,7 +155,7 @@ inline std::string formatNumber(u256 const& _value)
 	if (_value > 0x1000000)
 		return toCompactHexWithPrefix(_value);
 	else
-		return _value.str();
+		return std::to_string(static_cast<uint64_t>(_value));
 }
 
 
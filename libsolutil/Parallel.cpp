@@ -0,0 +1,150 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity::util;
+
+void solidity::util::parallelFor(size_t _count, size_t _threads, function<void(size_t)> const& _task)
+{
+	if (_threads <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	vector<exception_ptr> exceptions(_count);
+	atomic<size_t> nextIndex{0};
+	auto worker = [&]() {
+		for (size_t i = nextIndex++; i < _count; i = nextIndex++)
+			try
+			{
+				_task(i);
+			}
+			catch (...)
+			{
+				exceptions[i] = current_exception();
+			}
+	};
+
+	vector<thread> threads;
+	size_t const numThreads = min(_threads, _count);
+	threads.reserve(numThreads - 1);
+	for (size_t i = 1; i < numThreads; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (thread& t: threads)
+		t.join();
+
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+size_t solidity::util::hardwareConcurrency()
+{
+	return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+	for (thread& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::parallelFor(size_t _count, function<void(size_t)> const& _task)
+{
+	if (m_threads <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	if (m_workers.empty())
+		for (size_t i = 1; i < m_threads; ++i)
+			m_workers.emplace_back([this]() { workerLoop(); });
+
+	{
+		lock_guard lock(m_mutex);
+		m_task = &_task;
+		m_count = _count;
+		m_nextIndex = 0;
+		m_exceptions.assign(_count, nullptr);
+		m_busyWorkers = m_workers.size();
+		++m_generation;
+	}
+	m_taskAvailable.notify_all();
+	runTasks();
+	{
+		unique_lock lock(m_mutex);
+		m_workersDone.wait(lock, [&]() { return m_busyWorkers == 0; });
+		m_task = nullptr;
+	}
+
+	for (exception_ptr const& exception: m_exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
+
+void ThreadPool::workerLoop()
+{
+	size_t generation = 0;
+	while (true)
+	{
+		{
+			unique_lock lock(m_mutex);
+			m_taskAvailable.wait(lock, [&]() { return m_stopping || m_generation != generation; });
+			if (m_stopping)
+				return;
+			generation = m_generation;
+		}
+		runTasks();
+		{
+			lock_guard lock(m_mutex);
+			if (--m_busyWorkers == 0)
+				m_workersDone.notify_all();
+		}
+	}
+}
+
+void ThreadPool::runTasks()
+{
+	for (size_t i = m_nextIndex++; i < m_count; i = m_nextIndex++)
+		try
+		{
+			(*m_task)(i);
+		}
+		catch (...)
+		{
+			m_exceptions[i] = current_exception();
+		}
+}
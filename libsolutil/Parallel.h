@@ -0,0 +1,90 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent tasks on multiple threads.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Calls @a _task once for each index in [0, @a _count), using at most @a _threads threads
+/// (including the calling thread). Indices are handed out dynamically, so that threads that
+/// finish early pick up the remaining work.
+/// If @a _threads is at most one, the tasks are executed sequentially on the calling thread.
+/// If one or more tasks throw, the exception thrown by the task with the lowest index is rethrown
+/// after all threads have finished. This keeps error reporting independent of scheduling.
+/// Note that other tasks are still executed in that case, unless everything runs sequentially.
+void parallelFor(size_t _count, size_t _threads, std::function<void(size_t)> const& _task);
+
+/// @returns the number of threads the hardware can run concurrently or one if this is unknown.
+size_t hardwareConcurrency();
+
+/**
+ * Set of threads that execute the tasks of repeated calls to `parallelFor`.
+ * In contrast to the free function, the threads (and their thread-local data) are kept
+ * alive between calls. They are only started by the first call that can make use of them.
+ */
+class ThreadPool
+{
+public:
+	/// Creates a pool that uses at most @a _threads threads, including the calling thread.
+	explicit ThreadPool(size_t _threads): m_threads(_threads) {}
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	size_t threads() const { return m_threads; }
+
+	/// Same as the free function `parallelFor`, but uses the threads of the pool.
+	/// Must not be called from within a task or concurrently from multiple threads.
+	void parallelFor(size_t _count, std::function<void(size_t)> const& _task);
+
+private:
+	void workerLoop();
+	void runTasks();
+
+	size_t m_threads = 1;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::condition_variable m_workersDone;
+	/// Incremented with every call to `parallelFor` to wake up the workers.
+	size_t m_generation = 0;
+	size_t m_busyWorkers = 0;
+	bool m_stopping = false;
+
+	std::function<void(size_t)> const* m_task = nullptr;
+	size_t m_count = 0;
+	std::atomic<size_t> m_nextIndex{0};
+	std::vector<std::exception_ptr> m_exceptions;
+};
+
+}
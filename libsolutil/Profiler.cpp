@@ -0,0 +1,271 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Profiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+thread_local Profiler* t_activeProfiler = nullptr;
+thread_local string t_activeContext;
+
+double milliseconds(chrono::steady_clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+template <typename T>
+double mebibytes(T _bytes)
+{
+	return static_cast<double>(_bytes) / (1024.0 * 1024.0);
+}
+
+/// @returns the contexts of @a _items in the order of their first occurrence.
+template <typename T>
+vector<string> contextsInOrder(vector<T> const& _items)
+{
+	vector<string> contexts;
+	for (T const& item: _items)
+		if (find(contexts.begin(), contexts.end(), item.context) == contexts.end())
+			contexts.push_back(item.context);
+	return contexts;
+}
+
+}
+
+void Profiler::record(
+	string const& _context,
+	string const& _phase,
+	chrono::steady_clock::duration _wallTime,
+	size_t _peakResidentSetSize,
+	size_t _heapInUse,
+	int64_t _heapGrowth
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto [it, inserted] = m_entryIndices.emplace(make_pair(_context, _phase), m_entries.size());
+	if (inserted)
+		m_entries.push_back(Entry{_context, _phase, 0, {}, 0, 0, 0});
+	Entry& entry = m_entries[it->second];
+	++entry.invocations;
+	entry.wallTime += _wallTime;
+	entry.peakResidentSetSize = _peakResidentSetSize;
+	entry.heapInUse = _heapInUse;
+	entry.heapGrowth += _heapGrowth;
+}
+
+void Profiler::recordRetainedObjects(string const& _context, string const& _objects, size_t _count)
+{
+	lock_guard<mutex> lock(m_mutex);
+	for (RetainedObjects& retained: m_retainedObjects)
+		if (retained.context == _context && retained.objects == _objects)
+		{
+			retained.count = _count;
+			return;
+		}
+	m_retainedObjects.push_back(RetainedObjects{_context, _objects, _count});
+}
+
+void Profiler::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_entries.clear();
+	m_entryIndices.clear();
+	m_retainedObjects.clear();
+}
+
+vector<Profiler::Entry> Profiler::entries() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries;
+}
+
+vector<Profiler::RetainedObjects> Profiler::retainedObjects() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_retainedObjects;
+}
+
+Json::Value Profiler::toJson() const
+{
+	Json::Value result{Json::arrayValue};
+	for (Entry const& entry: entries())
+	{
+		Json::Value jsonEntry{Json::objectValue};
+		jsonEntry["context"] = entry.context;
+		jsonEntry["phase"] = entry.phase;
+		jsonEntry["invocations"] = Json::UInt64(entry.invocations);
+		jsonEntry["wallTimeMs"] = milliseconds(entry.wallTime);
+		jsonEntry["peakRSS"] = Json::UInt64(entry.peakResidentSetSize);
+		jsonEntry["heapInUse"] = Json::UInt64(entry.heapInUse);
+		jsonEntry["heapGrowth"] = Json::Int64(entry.heapGrowth);
+		result.append(move(jsonEntry));
+	}
+	return result;
+}
+
+string Profiler::toString() const
+{
+	ostringstream output;
+	output << setw(12) << "Wall (ms)" << setw(10) << "Count" << setw(16) << "Peak RSS (MiB)" << "  Phase" << endl;
+	vector<Entry> allEntries = entries();
+	for (string const& context: contextsInOrder(allEntries))
+	{
+		output << (context.empty() ? "General" : context) << ":" << endl;
+		for (Entry const& entry: allEntries)
+			if (entry.context == context)
+				output <<
+					fixed << setprecision(3) << setw(12) << milliseconds(entry.wallTime) <<
+					setw(10) << entry.invocations <<
+					setprecision(1) << setw(16) << mebibytes(entry.peakResidentSetSize) <<
+					"  " << entry.phase << endl;
+	}
+	return output.str();
+}
+
+string Profiler::memoryString() const
+{
+	ostringstream output;
+	output << setw(18) << "Heap growth (MiB)" << setw(18) << "Heap in use (MiB)" << setw(16) << "Peak RSS (MiB)" << "  Phase" << endl;
+	vector<Entry> allEntries = entries();
+	for (string const& context: contextsInOrder(allEntries))
+	{
+		output << (context.empty() ? "General" : context) << ":" << endl;
+		for (Entry const& entry: allEntries)
+			if (entry.context == context)
+				output <<
+					fixed << setprecision(1) << setw(18) << mebibytes(entry.heapGrowth) <<
+					setw(18) << mebibytes(entry.heapInUse) <<
+					setw(16) << mebibytes(entry.peakResidentSetSize) <<
+					"  " << entry.phase << endl;
+	}
+
+	vector<RetainedObjects> allRetainedObjects = retainedObjects();
+	if (!allRetainedObjects.empty())
+	{
+		output << endl << setw(18) << "Retained" << "  Objects" << endl;
+		for (string const& context: contextsInOrder(allRetainedObjects))
+		{
+			output << (context.empty() ? "General" : context) << ":" << endl;
+			for (RetainedObjects const& retained: allRetainedObjects)
+				if (retained.context == context)
+					output << setw(18) << retained.count << "  " << retained.objects << endl;
+		}
+	}
+	return output.str();
+}
+
+Profiler* Profiler::active()
+{
+	return t_activeProfiler;
+}
+
+string const& Profiler::activeContext()
+{
+	return t_activeContext;
+}
+
+ProfilerActivation::ProfilerActivation(Profiler* _profiler, string _context):
+	m_previousProfiler(t_activeProfiler),
+	m_previousContext(move(t_activeContext))
+{
+	t_activeProfiler = _profiler;
+	t_activeContext = move(_context);
+}
+
+ProfilerActivation::ProfilerActivation(string _context):
+	ProfilerActivation(t_activeProfiler, move(_context))
+{
+}
+
+ProfilerActivation::~ProfilerActivation()
+{
+	t_activeProfiler = m_previousProfiler;
+	t_activeContext = move(m_previousContext);
+}
+
+ProfilerScope::ProfilerScope(string _phase):
+	m_profiler(t_activeProfiler)
+{
+	if (m_profiler)
+	{
+		m_phase = move(_phase);
+		m_start = chrono::steady_clock::now();
+		m_heapAtStart = heapInUse();
+	}
+}
+
+ProfilerScope::~ProfilerScope()
+{
+	if (m_profiler)
+	{
+		size_t heap = heapInUse();
+		m_profiler->record(
+			t_activeContext,
+			m_phase,
+			chrono::steady_clock::now() - m_start,
+			peakResidentSetSize(),
+			heap,
+			static_cast<int64_t>(heap) - static_cast<int64_t>(m_heapAtStart)
+		);
+	}
+}
+
+size_t util::peakResidentSetSize()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0 || usage.ru_maxrss < 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS.
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	// Reported in kilobytes on Linux and the BSDs.
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+size_t util::heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2();
+	// Small blocks in the main arena and large blocks allocated with mmap.
+	return info.uordblks + info.hblkhd;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,158 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of wall time and memory usage of compilation phases.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Accumulates the wall time and the peak memory usage of named phases, grouped by a context
+ * (usually the contract that is being compiled).
+ *
+ * Phases are measured by ProfilerScope objects, which only record anything while a profiler
+ * is activated for the current thread using ProfilerActivation, so instrumented code does not
+ * need to know whether profiling was requested. Phases can be nested, in which case the time
+ * of the inner phase is also contained in the outer one. Recording is thread-safe.
+ *
+ * Memory is attributed to phases by the change of the heap usage during each invocation,
+ * which includes allocations of other threads running at the same time. Additionally, the
+ * owners of long-lived data (ASTs, types, assembly items, ...) can report how many objects
+ * they retain.
+ */
+class Profiler
+{
+public:
+	struct Entry
+	{
+		std::string context;
+		std::string phase;
+		size_t invocations = 0;
+		std::chrono::steady_clock::duration wallTime{};
+		/// Peak resident set size of the process in bytes at the end of the last invocation.
+		/// Zero if it cannot be determined on this platform.
+		size_t peakResidentSetSize = 0;
+		/// Heap memory in use in bytes at the end of the last invocation (zero if unknown).
+		size_t heapInUse = 0;
+		/// Sum of the changes of the heap memory in use during all invocations, i.e. the memory
+		/// the phase allocated and did not free again.
+		std::int64_t heapGrowth = 0;
+	};
+
+	/// Number of objects of some kind retained by an owner at the end of the compilation.
+	struct RetainedObjects
+	{
+		std::string context;
+		std::string objects;
+		size_t count = 0;
+	};
+
+	void record(
+		std::string const& _context,
+		std::string const& _phase,
+		std::chrono::steady_clock::duration _wallTime,
+		size_t _peakResidentSetSize,
+		size_t _heapInUse,
+		std::int64_t _heapGrowth
+	);
+	/// Records that @a _count objects described by @a _objects are retained in @a _context,
+	/// replacing an earlier record for the same objects.
+	void recordRetainedObjects(std::string const& _context, std::string const& _objects, size_t _count);
+	void clear();
+
+	/// @returns all entries in the order in which the first invocation of each one finished.
+	std::vector<Entry> entries() const;
+	std::vector<RetainedObjects> retainedObjects() const;
+	Json::Value toJson() const;
+	/// @returns a human-readable table of the wall time of all entries.
+	std::string toString() const;
+	/// @returns a human-readable table of the memory usage of all entries and of the retained objects.
+	std::string memoryString() const;
+
+	/// @returns the profiler that is activated for the current thread or nullptr.
+	static Profiler* active();
+	/// @returns the context that is recorded with all phases on the current thread.
+	static std::string const& activeContext();
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector<Entry> m_entries;
+	std::map<std::pair<std::string, std::string>, size_t> m_entryIndices;
+	std::vector<RetainedObjects> m_retainedObjects;
+};
+
+/**
+ * Activates a profiler for the current thread and sets the context of all phases recorded
+ * by it until the object is destroyed. The previous state is restored afterwards.
+ */
+class ProfilerActivation
+{
+public:
+	/// Activates @a _profiler, which can be nullptr to disable profiling.
+	ProfilerActivation(Profiler* _profiler, std::string _context);
+	/// Keeps the currently active profiler and only changes the context.
+	explicit ProfilerActivation(std::string _context);
+	~ProfilerActivation();
+
+	ProfilerActivation(ProfilerActivation const&) = delete;
+	ProfilerActivation& operator=(ProfilerActivation const&) = delete;
+
+private:
+	Profiler* m_previousProfiler = nullptr;
+	std::string m_previousContext;
+};
+
+/**
+ * Measures the wall time between construction and destruction and records it as a phase
+ * with the profiler that was active at construction, if any.
+ */
+class ProfilerScope
+{
+public:
+	explicit ProfilerScope(std::string _phase);
+	~ProfilerScope();
+
+	ProfilerScope(ProfilerScope const&) = delete;
+	ProfilerScope& operator=(ProfilerScope const&) = delete;
+
+private:
+	Profiler* m_profiler = nullptr;
+	std::string m_phase;
+	std::chrono::steady_clock::time_point m_start;
+	size_t m_heapAtStart = 0;
+};
+
+/// @returns the peak resident set size of the current process in bytes or zero if unknown.
+size_t peakResidentSetSize();
+/// @returns the heap memory currently allocated by the process in bytes or zero if unknown.
+size_t heapInUse();
+
+}
@@ -38,6 +38,9 @@ bool solidity::util::stringWithinDistance(string const& _str1, string const& _st
 	size_t n2 = _str2.size();
 	if (_lenThreshold > 0 && n1 * n2 > _lenThreshold)
 		return false;
+	// The edit distance is at least the difference in length.
+	if (max(n1, n2) - min(n1, n2) > _maxDistance)
+		return false;
 
 	size_t distance = stringDistance(_str1, _str2);
 
@@ -26,7 +26,8 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
@@ -69,16 +70,39 @@ Whiskers& Whiskers::operator()(
 	return *this;
 }
 
+struct Whiskers::Node
+{
+	enum class Kind { Text, Parameter, List, Condition };
+	Kind kind;
+	/// The text or the name of the parameter, list or condition. The name of a conditional
+	/// value parameter starts with "+".
+	string value;
+	Nodes children;
+	/// The part after "<!name>" of a condition.
+	Nodes elseChildren;
+};
+
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	shared_ptr<Nodes const> nodes = parsedTemplate(m_template);
+	// Most parameters are used once, so this is a good estimate of the size of the result,
+	// which avoids reallocations when large pieces of code are inserted.
+	size_t size = m_template.size();
+	for (auto const& parameter: m_parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+	render(result, *nodes, nullptr, &m_listParameters);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
+	bool valid = !_parameter.empty();
+	for (char c: _parameter)
+		valid = valid && isParameterCharacter(c);
 	assertThrow(
-		regex_match(_parameter, validParam),
+		valid,
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -116,117 +140,193 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Nodes const> Whiskers::parsedTemplate(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	// Templates that are assembled at runtime could make the cache grow without bound,
+	// so they are only parsed once the cache is full.
+	static size_t const maxCacheSize = 10000;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Nodes const>> cache;
+
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+	auto nodes = make_shared<Nodes const>(parse(_template, 0, _template.size()));
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() < maxCacheSize)
+		cache.emplace(_template, nodes);
+	return nodes;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+Whiskers::Nodes Whiskers::parse(string const& _template, size_t _begin, size_t _end)
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	// Recognizes the same elements as the regular expression
+	//   <(name)>|<#(name)>(.*?)</\2>|<\?(\+?name)>(.*?)(<!\4>(.*?))?</\4>
+	// did before: At every "<", the alternatives are tried in this order and the bodies of
+	// lists and conditions end at the first matching closing tag.
+	Nodes nodes;
+	auto appendText = [&](size_t _from, size_t _to) {
+		if (_from == _to)
+			return;
+		if (nodes.empty() || nodes.back().kind != Node::Kind::Text)
+			nodes.push_back(Node{Node::Kind::Text, {}, {}, {}});
+		nodes.back().value.append(_template, _from, _to - _from);
+	};
+	// @returns the end of the parameter name starting at @a _pos if it is followed by ">", or _pos otherwise.
+	auto nameEnd = [&](size_t _pos) -> size_t {
+		size_t pos = _pos;
+		while (pos < _end && isParameterCharacter(_template[pos]))
+			++pos;
+		return (pos > _pos && pos < _end && _template[pos] == '>') ? pos : _pos;
+	};
+	// @returns the position of @a _tag between @a _from and _end or string::npos.
+	auto findTag = [&](string const& _tag, size_t _from) -> size_t {
+		size_t pos = _template.find(_tag, _from);
+		return (pos != string::npos && pos + _tag.size() <= _end) ? pos : string::npos;
+	};
+
+	size_t textStart = _begin;
+	size_t pos = _begin;
+	while (true)
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		pos = _template.find('<', pos);
+		if (pos == string::npos || pos >= _end)
+			break;
+
+		if (size_t end = nameEnd(pos + 1); end != pos + 1)
+		{
+			appendText(textStart, pos);
+			nodes.push_back(Node{Node::Kind::Parameter, _template.substr(pos + 1, end - pos - 1), {}, {}});
+			pos = textStart = end + 1;
+			continue;
+		}
+		if (pos + 1 < _end && _template[pos + 1] == '#')
+			if (size_t end = nameEnd(pos + 2); end != pos + 2)
+			{
+				string name = _template.substr(pos + 2, end - pos - 2);
+				string closingTag = "</" + name + ">";
+				if (size_t closing = findTag(closingTag, end + 1); closing != string::npos)
+				{
+					appendText(textStart, pos);
+					nodes.push_back(Node{Node::Kind::List, move(name), parse(_template, end + 1, closing), {}});
+					pos = textStart = closing + closingTag.size();
+					continue;
+				}
+			}
+		if (pos + 1 < _end && _template[pos + 1] == '?')
+		{
+			size_t nameStart = pos + 2;
+			if (nameStart < _end && _template[nameStart] == '+')
+				++nameStart;
+			if (size_t end = nameEnd(nameStart); end != nameStart)
+			{
+				string name = _template.substr(pos + 2, end - pos - 2);
+				string closingTag = "</" + name + ">";
+				if (size_t closing = findTag(closingTag, end + 1); closing != string::npos)
+				{
+					appendText(textStart, pos);
+					string elseTag = "<!" + name + ">";
+					size_t elsePos = findTag(elseTag, end + 1);
+					if (elsePos != string::npos && elsePos < closing)
+						nodes.push_back(Node{
+							Node::Kind::Condition,
+							move(name),
+							parse(_template, end + 1, elsePos),
+							parse(_template, elsePos + elseTag.size(), closing)
+						});
+					else
+						nodes.push_back(Node{Node::Kind::Condition, move(name), parse(_template, end + 1, closing), {}});
+					pos = textStart = closing + closingTag.size();
+					continue;
+				}
+			}
+		}
+		++pos;
+	}
+	appendText(textStart, _end);
+	return nodes;
+}
+
+void Whiskers::render(
+	string& _output,
+	Nodes const& _nodes,
+	StringMap const* _listElement,
+	StringListMap const* _listParameters
+) const
+{
+	auto findParameter = [&](string const& _name) -> string const* {
+		if (_listElement)
+			if (auto it = _listElement->find(_name); it != _listElement->end())
+				return &it->second;
+		if (auto it = m_parameters.find(_name); it != m_parameters.end())
+			return &it->second;
+		return nullptr;
+	};
+
+	for (Node const& node: _nodes)
+		switch (node.kind)
+		{
+		case Node::Kind::Text:
+			_output += node.value;
+			break;
+		case Node::Kind::Parameter:
 		{
+			string const* value = findParameter(node.value);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + node.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				m_template
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			break;
 		}
-		else if (!listName.empty())
+		case Node::Kind::List:
 		{
-			string templ(_match[3]);
+			auto list = _listParameters ? _listParameters->find(node.value) : m_listParameters.end();
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				_listParameters && list != _listParameters->end(),
+				WhiskersError, "List parameter " + node.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (StringMap const& element: list->second)
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!m_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(_output, node.children, &element, nullptr);
+			}
+			break;
 		}
-		else
+		case Node::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (node.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = node.value.substr(1);
 
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+				if (string const* value = findParameter(tag))
+					conditionValue = !value->empty();
+				else if (_listParameters && _listParameters->count(tag))
+					conditionValue = !_listParameters->at(tag).empty();
 				else
 					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
 			}
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					m_conditions.count(node.value),
+					WhiskersError, "Condition parameter " + node.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = m_conditions.at(node.value);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			render(_output, conditionValue ? node.children : node.elseChildren, _listElement, _listParameters);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -26,8 +26,9 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace solidity::util
@@ -90,8 +91,13 @@ public:
 	std::string render() const;
 
 private:
+	/// Element of a parsed template.
+	struct Node;
+	using Nodes = std::vector<Node>;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
+
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
@@ -101,17 +107,30 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	/// @returns the parsed form of @a _template. Templates are parsed only once per process,
+	/// since most of them are string literals in the code generator.
+	static std::shared_ptr<Nodes const> parsedTemplate(std::string const& _template);
+	/// Parses the part of @a _template between @a _begin and @a _end.
+	static Nodes parse(std::string const& _template, size_t _begin, size_t _end);
+
+	/// Appends @a _nodes to @a _output, looking up parameters first in @a _listElement (if given)
+	/// and then in @a _parameters. List parameters are not available inside of lists.
+	void render(
+		std::string& _output,
+		Nodes const& _nodes,
+		StringMap const* _listElement,
+		StringListMap const* _listParameters
+	) const;
+
+	/// @returns true if @a _c can be part of a parameter name.
+	static bool isParameterCharacter(char _c)
+	{
+		return
+			('a' <= _c && _c <= 'z') ||
+			('A' <= _c && _c <= 'Z') ||
+			('0' <= _c && _c <= '9') ||
+			_c == '_' || _c == '$' || _c == '-';
+	}
 
 	std::string m_template;
 	StringMap m_parameters;
@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Parsed inline assembly to be used by the AST
+ */
+
+#include <libyul/AST.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+struct DebugDataHash
+{
+	size_t operator()(DebugData const& _debugData) const
+	{
+		size_t seed = 0;
+		for (SourceLocation const* location: {&_debugData.nativeLocation, &_debugData.originLocation})
+		{
+			boost::hash_combine(seed, location->start);
+			boost::hash_combine(seed, location->end);
+			boost::hash_combine(seed, location->sourceName);
+		}
+		boost::hash_combine(seed, _debugData.astID.value_or(-1));
+		return seed;
+	}
+};
+
+/// Pool of interned debug data. It is split into shards with separate locks, so that threads
+/// that generate code concurrently rarely wait for each other.
+class DebugDataPool
+{
+public:
+	static DebugDataPool& instance()
+	{
+		static DebugDataPool pool;
+		return pool;
+	}
+
+	DebugData const* intern(DebugData _debugData)
+	{
+		Shard& shard = m_shards[DebugDataHash{}(_debugData) % m_shards.size()];
+		lock_guard lock(shard.entriesMutex);
+		return &*shard.entries.insert(move(_debugData)).first;
+	}
+
+	size_t size()
+	{
+		size_t result = 0;
+		for (Shard& shard: m_shards)
+		{
+			lock_guard lock(shard.entriesMutex);
+			result += shard.entries.size();
+		}
+		return result;
+	}
+
+	void clear()
+	{
+		for (Shard& shard: m_shards)
+		{
+			lock_guard lock(shard.entriesMutex);
+			shard.entries.clear();
+		}
+	}
+
+private:
+	struct Shard
+	{
+		mutex entriesMutex;
+		// Elements of an unordered set are never moved, not even on rehashing.
+		unordered_set<DebugData, DebugDataHash> entries;
+	};
+	array<Shard, 16> m_shards;
+};
+
+// Registered on startup rather than on first use, so that the pool is cleared by every reset.
+YulStringRepository::ResetCallback const debugDataPoolReset{
+	[] { DebugDataPool::instance().clear(); },
+	[] { return DebugDataPool::instance().size(); }
+};
+
+}
+
+DebugData const* DebugData::intern(DebugData _debugData)
+{
+	return DebugDataPool::instance().intern(move(_debugData));
+}
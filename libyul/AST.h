@@ -48,17 +48,34 @@ struct DebugData
 		astID(std::move(_astID))
 	{}
 
-	static std::shared_ptr<DebugData const> create(
+	/// @returns the interned copy of the given debug data, see `intern`.
+	static DebugData const* create(
 		langutil::SourceLocation _nativeLocation = {},
 		langutil::SourceLocation _originLocation = {},
 		std::optional<int64_t> _astID = {}
 	)
 	{
-		return std::make_shared<DebugData const>(
+		return intern(DebugData(
 			std::move(_nativeLocation),
 			std::move(_originLocation),
 			std::move(_astID)
-		);
+		));
+	}
+
+	/// @returns a pointer to debug data equal to @a _debugData that is shared by all nodes
+	/// with the same debug data. Like YulStrings, it stays valid until the next reset of the
+	/// YulStringRepository, which clears the pool and counts its entries towards the limit of
+	/// YulStringRepository::resetIfLargerThan(). Nodes refer to it by a plain pointer, so
+	/// copying a node does not need to touch any reference count, and must not outlive a reset.
+	/// Can be called from multiple threads concurrently.
+	static DebugData const* intern(DebugData _debugData);
+
+	bool operator==(DebugData const& _other) const
+	{
+		return
+			nativeLocation == _other.nativeLocation &&
+			originLocation == _other.originLocation &&
+			astID == _other.astID;
 	}
 
 	/// Location in the Yul code.
@@ -70,43 +87,43 @@ struct DebugData
 	std::optional<int64_t> astID;
 };
 
-struct TypedName { std::shared_ptr<DebugData const> debugData; YulString name; Type type; };
+struct TypedName { DebugData const* debugData = nullptr; YulString name; Type type; };
 using TypedNameList = std::vector<TypedName>;
 
 /// Literal number or string (up to 32 bytes)
 enum class LiteralKind { Number, Boolean, String };
-struct Literal { std::shared_ptr<DebugData const> debugData; LiteralKind kind; YulString value; Type type; };
+struct Literal { DebugData const* debugData = nullptr; LiteralKind kind; YulString value; Type type; };
 /// External / internal identifier or label reference
-struct Identifier { std::shared_ptr<DebugData const> debugData; YulString name; };
+struct Identifier { DebugData const* debugData = nullptr; YulString name; };
 /// Assignment ("x := mload(20:u256)", expects push-1-expression on the right hand
 /// side and requires x to occupy exactly one stack slot.
 ///
 /// Multiple assignment ("x, y := f()"), where the left hand side variables each occupy
 /// a single stack slot and expects a single expression on the right hand returning
 /// the same amount of items as the number of variables.
-struct Assignment { std::shared_ptr<DebugData const> debugData; std::vector<Identifier> variableNames; std::unique_ptr<Expression> value; };
-struct FunctionCall { std::shared_ptr<DebugData const> debugData; Identifier functionName; std::vector<Expression> arguments; };
+struct Assignment { DebugData const* debugData = nullptr; std::vector<Identifier> variableNames; std::unique_ptr<Expression> value; };
+struct FunctionCall { DebugData const* debugData = nullptr; Identifier functionName; std::vector<Expression> arguments; };
 /// Statement that contains only a single expression
-struct ExpressionStatement { std::shared_ptr<DebugData const> debugData; Expression expression; };
+struct ExpressionStatement { DebugData const* debugData = nullptr; Expression expression; };
 /// Block-scope variable declaration ("let x:u256 := mload(20:u256)"), non-hoisted
-struct VariableDeclaration { std::shared_ptr<DebugData const> debugData; TypedNameList variables; std::unique_ptr<Expression> value; };
+struct VariableDeclaration { DebugData const* debugData = nullptr; TypedNameList variables; std::unique_ptr<Expression> value; };
 /// Block that creates a scope (frees declared stack variables)
-struct Block { std::shared_ptr<DebugData const> debugData; std::vector<Statement> statements; };
+struct Block { DebugData const* debugData = nullptr; std::vector<Statement> statements; };
 /// Function definition ("function f(a, b) -> (d, e) { ... }")
-struct FunctionDefinition { std::shared_ptr<DebugData const> debugData; YulString name; TypedNameList parameters; TypedNameList returnVariables; Block body; };
+struct FunctionDefinition { DebugData const* debugData = nullptr; YulString name; TypedNameList parameters; TypedNameList returnVariables; Block body; };
 /// Conditional execution without "else" part.
-struct If { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Expression> condition; Block body; };
+struct If { DebugData const* debugData = nullptr; std::unique_ptr<Expression> condition; Block body; };
 /// Switch case or default case
-struct Case { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Literal> value; Block body; };
+struct Case { DebugData const* debugData = nullptr; std::unique_ptr<Literal> value; Block body; };
 /// Switch statement
-struct Switch { std::shared_ptr<DebugData const> debugData; std::unique_ptr<Expression> expression; std::vector<Case> cases; };
-struct ForLoop { std::shared_ptr<DebugData const> debugData; Block pre; std::unique_ptr<Expression> condition; Block post; Block body; };
+struct Switch { DebugData const* debugData = nullptr; std::unique_ptr<Expression> expression; std::vector<Case> cases; };
+struct ForLoop { DebugData const* debugData = nullptr; Block pre; std::unique_ptr<Expression> condition; Block post; Block body; };
 /// Break statement (valid within for loop)
-struct Break { std::shared_ptr<DebugData const> debugData; };
+struct Break { DebugData const* debugData = nullptr; };
 /// Continue statement (valid within for loop)
-struct Continue { std::shared_ptr<DebugData const> debugData; };
+struct Continue { DebugData const* debugData = nullptr; };
 /// Leave statement (valid within function)
-struct Leave { std::shared_ptr<DebugData const> debugData; };
+struct Leave { DebugData const* debugData = nullptr; };
 
 /// Extracts the IR source location from a Yul node.
 template <class T> inline langutil::SourceLocation nativeLocationOf(T const& _node)
@@ -133,13 +150,13 @@ template <class... Args> inline langutil::SourceLocation originLocationOf(std::v
 }
 
 /// Extracts the debug data from a Yul node.
-template <class T> inline std::shared_ptr<DebugData const> debugDataOf(T const& _node)
+template <class T> inline DebugData const* debugDataOf(T const& _node)
 {
 	return _node.debugData;
 }
 
 /// Extracts the debug data from a Yul node.
-template <class... Args> inline std::shared_ptr<DebugData const> debugDataOf(std::variant<Args...> const& _node)
+template <class... Args> inline DebugData const* debugDataOf(std::variant<Args...> const& _node)
 {
 	return std::visit([](auto const& _arg) { return debugDataOf(_arg); }, _node);
 }
@@ -23,9 +23,8 @@
 
 #include <libyul/ASTForward.h>
 
-#include <map>
 #include <memory>
-#include <vector>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -34,11 +33,11 @@ struct Scope;
 
 struct AsmAnalysisInfo
 {
-	using StackHeightInfo = std::map<void const*, int>;
-	using Scopes = std::map<Block const*, std::shared_ptr<Scope>>;
+	/// Hash tables, since these are only ever looked up by pointer and never iterated.
+	using Scopes = std::unordered_map<Block const*, std::shared_ptr<Scope>>;
 	Scopes scopes;
 	/// Virtual blocks which will be used for scopes for function arguments and return values.
-	std::map<FunctionDefinition const*, std::shared_ptr<Block const>> virtualBlocks;
+	std::unordered_map<FunctionDefinition const*, std::shared_ptr<Block const>> virtualBlocks;
 };
 
 }
@@ -35,7 +35,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
-#include <regex>
+#include <array>
 
 using namespace std;
 using namespace solidity;
@@ -58,9 +58,68 @@ optional<int> toInt(string const& _value)
 	}
 }
 
+bool isWhitespace(char _c)
+{
+	return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' || _c == '\r';
+}
+
+bool isDecimalDigit(char _c)
+{
+	return '0' <= _c && _c <= '9';
+}
+
+bool isTagCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		isDecimalDigit(_c) ||
+		_c == '-' ||
+		_c == '_';
+}
+
+string_view skipWhitespace(string_view _text)
+{
+	size_t pos = 0;
+	while (pos < _text.size() && isWhitespace(_text[pos]))
+		++pos;
+	return _text.substr(pos);
 }
 
-std::shared_ptr<DebugData const> Parser::createDebugData() const
+/// Finds the first tag (e.g. `@src`) in @a _text that is at its start or preceded by whitespace
+/// and that is followed by whitespace or the end of @a _text.
+/// @returns the tag and the text after the whitespace following it.
+optional<pair<string_view, string_view>> findTag(string_view _text)
+{
+	for (size_t pos = _text.find('@'); pos != string_view::npos; pos = _text.find('@', pos + 1))
+	{
+		if (pos > 0 && !isWhitespace(_text[pos - 1]))
+			continue;
+		size_t end = pos + 1;
+		while (end < _text.size() && isTagCharacter(_text[end]))
+			++end;
+		if (end == pos + 1 || (end < _text.size() && !isWhitespace(_text[end])))
+			continue;
+		return {{_text.substr(pos, end - pos), skipWhitespace(_text.substr(end))}};
+	}
+	return nullopt;
+}
+
+/// @returns the length of the value at the start of @a _text that is either `-1` or a non-empty
+/// sequence of decimal digits, or zero if there is none.
+size_t locationValueLength(string_view _text)
+{
+	if (_text.substr(0, 2) == "-1")
+		return 2;
+	size_t length = 0;
+	while (length < _text.size() && isDecimalDigit(_text[length]))
+		++length;
+	return length;
+}
+
+}
+
+DebugData const* Parser::createDebugData() const
 {
 	switch (m_useSourceLocationFrom)
 	{
@@ -75,7 +134,7 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 }
 
 void Parser::updateLocationEndFrom(
-	shared_ptr<DebugData const>& _debugData,
+	DebugData const*& _debugData,
 	SourceLocation const& _location
 ) const
 {
@@ -88,7 +147,7 @@ void Parser::updateLocationEndFrom(
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
 			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			_debugData = DebugData::intern(move(updatedDebugData));
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -98,7 +157,7 @@ void Parser::updateLocationEndFrom(
 		{
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(move(updatedDebugData));
+			_debugData = DebugData::intern(move(updatedDebugData));
 			break;
 		}
 	}
@@ -146,31 +205,24 @@ void Parser::fetchDebugDataFromComment()
 {
 	solAssert(m_sourceNames.has_value(), "");
 
-	static regex const tagRegex = regex(
-		R"~~((?:^|\s+)(@[a-zA-Z0-9\-_]+)(?:\s+|$))~~", // tag, e.g: @src
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-
 	string_view commentLiteral = m_scanner->currentCommentLiteral();
-	match_results<string_view::const_iterator> match;
 
 	langutil::SourceLocation originLocation = m_locationFromComment;
 	// Empty for each new node.
 	optional<int> astID;
 
-	while (regex_search(commentLiteral.cbegin(), commentLiteral.cend(), match, tagRegex))
+	while (auto tag = findTag(commentLiteral))
 	{
-		solAssert(match.size() == 2, "");
-		commentLiteral = commentLiteral.substr(static_cast<size_t>(match.position() + match.length()));
+		commentLiteral = tag->second;
 
-		if (match[1] == "@src")
+		if (tag->first == "@src")
 		{
 			if (auto parseResult = parseSrcComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, originLocation) = *parseResult;
 			else
 				break;
 		}
-		else if (match[1] == "@ast-id")
+		else if (tag->first == "@ast-id")
 		{
 			if (auto parseResult = parseASTIDComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, astID) = *parseResult;
@@ -191,13 +243,24 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argsRegex = regex(
-		R"~~(^(-1|\d+):(-1|\d+):(-1|\d+)(?:\s+|$))~~"  // index and location, e.g.: 1:234:-1
-		R"~~(("(?:[^"\\]|\\.)*"?)?)~~",                // optional code snippet, e.g.: "string memory s = \"abc\";..."
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
-	if (!regex_search(_arguments.cbegin(), _arguments.cend(), match, argsRegex))
+	string_view tail = _arguments;
+	// Index and location, e.g.: 1:234:-1
+	array<string_view, 3> values;
+	bool matched = true;
+	for (size_t i = 0; i < values.size() && matched; ++i)
+	{
+		size_t length = locationValueLength(tail);
+		values[i] = tail.substr(0, length);
+		tail = tail.substr(length);
+		if (i + 1 < values.size())
+			matched = length > 0 && !tail.empty() && tail.front() == ':';
+		else
+			matched = length > 0 && (tail.empty() || isWhitespace(tail.front()));
+		if (matched && i + 1 < values.size())
+			tail = tail.substr(1);
+	}
+
+	if (!matched)
 	{
 		m_errorReporter.syntaxError(
 			8387_error,
@@ -207,12 +270,28 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return nullopt;
 	}
 
-	solAssert(match.size() == 5, "");
-	string_view tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
+	// Optional code snippet, e.g.: "string memory s = \"abc\";..."
+	tail = skipWhitespace(tail);
+	optional<string_view> snippet;
+	if (!tail.empty() && tail.front() == '"')
+	{
+		size_t end = 1;
+		while (end < tail.size() && tail[end] != '"')
+			if (tail[end] != '\\')
+				++end;
+			else if (end + 1 < tail.size() && tail[end + 1] != '\n' && tail[end + 1] != '\r')
+				end += 2;
+			else
+				break;
+		if (end < tail.size() && tail[end] == '"')
+			++end;
+		snippet = tail.substr(0, end);
+		tail = tail.substr(end);
+	}
 
-	if (match[4].matched && (
-		!boost::algorithm::ends_with(match[4].str(), "\"") ||
-		boost::algorithm::ends_with(match[4].str(), "\\\"")
+	if (snippet && (
+		!boost::algorithm::ends_with(*snippet, "\"") ||
+		boost::algorithm::ends_with(*snippet, "\\\"")
 	))
 	{
 		m_errorReporter.syntaxError(
@@ -223,9 +302,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return {{tail, SourceLocation{}}};
 	}
 
-	optional<int> const sourceIndex = toInt(match[1].str());
-	optional<int> const start = toInt(match[2].str());
-	optional<int> const end = toInt(match[3].str());
+	optional<int> const sourceIndex = toInt(string(values[0]));
+	optional<int> const start = toInt(string(values[1]));
+	optional<int> const end = toInt(string(values[2]));
 
 	if (!sourceIndex.has_value() || !start.has_value() || !end.has_value())
 		m_errorReporter.syntaxError(
@@ -244,9 +323,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		);
 	else
 	{
-		shared_ptr<string const> sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
+		string const* sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
 		solAssert(sourceName, "");
-		return {{tail, SourceLocation{start.value(), end.value(), move(sourceName)}}};
+		return {{tail, SourceLocation{start.value(), end.value(), sourceName}}};
 	}
 	return {{tail, SourceLocation{}}};
 }
@@ -256,21 +335,13 @@ optional<pair<string_view, optional<int>>> Parser::parseASTIDComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argRegex = regex(
-		R"~~(^(\d+)(?:\s|$))~~",
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
+	size_t length = 0;
+	while (length < _arguments.size() && isDecimalDigit(_arguments[length]))
+		++length;
+	bool const matched = length > 0 && (length == _arguments.size() || isWhitespace(_arguments[length]));
 	optional<int> astID;
-	bool matched = regex_search(_arguments.cbegin(), _arguments.cend(), match, argRegex);
-	string_view tail = _arguments;
 	if (matched)
-	{
-		solAssert(match.size() == 2, "");
-		tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
-
-		astID = toInt(match[1].str());
-	}
+		astID = toInt(string(_arguments.substr(0, length)));
 
 	if (!matched || !astID || *astID < 0 || static_cast<int64_t>(*astID) != *astID)
 	{
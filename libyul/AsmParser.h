@@ -73,7 +73,7 @@ public:
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		Dialect const& _dialect,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceNames
+		std::optional<std::map<unsigned, std::string const*>> _sourceNames
 	):
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
@@ -118,10 +118,10 @@ protected:
 	);
 
 	/// Creates a DebugData object with the correct source location set.
-	std::shared_ptr<DebugData const> createDebugData() const;
+	DebugData const* createDebugData() const;
 
 	void updateLocationEndFrom(
-		std::shared_ptr<DebugData const>& _debugData,
+		DebugData const*& _debugData,
 		langutil::SourceLocation const& _location
 	) const;
 
@@ -156,7 +156,7 @@ protected:
 private:
 	Dialect const& m_dialect;
 
-	std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> m_sourceNames;
+	std::optional<std::map<unsigned, std::string const*>> m_sourceNames;
 	langutil::SourceLocation m_locationOverride;
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
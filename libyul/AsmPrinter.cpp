@@ -32,8 +32,6 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/replace.hpp>
 
-#include <range/v3/view/transform.hpp>
-
 #include <memory>
 #include <functional>
 
@@ -43,206 +41,277 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
-string AsmPrinter::operator()(Literal const& _literal)
+string AsmPrinter::operator()(Literal const& _literal) { return format(_literal); }
+string AsmPrinter::operator()(Identifier const& _identifier) { return format(_identifier); }
+string AsmPrinter::operator()(ExpressionStatement const& _statement) { return format(_statement); }
+string AsmPrinter::operator()(Assignment const& _assignment) { return format(_assignment); }
+string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration) { return format(_variableDeclaration); }
+string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition) { return format(_functionDefinition); }
+string AsmPrinter::operator()(FunctionCall const& _functionCall) { return format(_functionCall); }
+string AsmPrinter::operator()(If const& _if) { return format(_if); }
+string AsmPrinter::operator()(Switch const& _switch) { return format(_switch); }
+string AsmPrinter::operator()(ForLoop const& _forLoop) { return format(_forLoop); }
+string AsmPrinter::operator()(Break const& _break) { return format(_break); }
+string AsmPrinter::operator()(Continue const& _continue) { return format(_continue); }
+// '_leave' and '__leave' is reserved in VisualStudio
+string AsmPrinter::operator()(Leave const& leave_) { return format(leave_); }
+string AsmPrinter::operator()(Block const& _block) { return format(_block); }
+
+template <class T>
+string AsmPrinter::format(T const& _node)
+{
+	m_out.clear();
+	m_indentation = 0;
+	m_lineBreaks = 0;
+	print(_node);
+	string out;
+	swap(out, m_out);
+	return out;
+}
+
+void AsmPrinter::print(Literal const& _literal)
 {
-	string const locationComment = formatDebugData(_literal);
+	printDebugData(_literal);
 
 	switch (_literal.kind)
 	{
 	case LiteralKind::Number:
 		yulAssert(isValidDecimal(_literal.value.str()) || isValidHex(_literal.value.str()), "Invalid number literal");
-		return locationComment + _literal.value.str() + appendTypeName(_literal.type);
+		m_out += _literal.value.str();
+		appendTypeName(_literal.type);
+		return;
 	case LiteralKind::Boolean:
 		yulAssert(_literal.value == "true"_yulstring || _literal.value == "false"_yulstring, "Invalid bool literal.");
-		return locationComment + ((_literal.value == "true"_yulstring) ? "true" : "false") + appendTypeName(_literal.type, true);
+		m_out += (_literal.value == "true"_yulstring) ? "true" : "false";
+		appendTypeName(_literal.type, true);
+		return;
 	case LiteralKind::String:
 		break;
 	}
 
-	return locationComment + escapeAndQuoteString(_literal.value.str()) + appendTypeName(_literal.type);
+	m_out += escapeAndQuoteString(_literal.value.str());
+	appendTypeName(_literal.type);
 }
 
-string AsmPrinter::operator()(Identifier const& _identifier)
+void AsmPrinter::print(Identifier const& _identifier)
 {
 	yulAssert(!_identifier.name.empty(), "Invalid identifier.");
-	return formatDebugData(_identifier) + _identifier.name.str();
+	printDebugData(_identifier);
+	m_out += _identifier.name.str();
 }
 
-string AsmPrinter::operator()(ExpressionStatement const& _statement)
+void AsmPrinter::print(ExpressionStatement const& _statement)
 {
-	string const locationComment = formatDebugData(_statement);
-
-	return locationComment + std::visit(*this, _statement.expression);
+	printDebugData(_statement);
+	print(_statement.expression);
 }
 
-string AsmPrinter::operator()(Assignment const& _assignment)
+void AsmPrinter::print(Assignment const& _assignment)
 {
-	string const locationComment = formatDebugData(_assignment);
+	printDebugData(_assignment);
 
 	yulAssert(_assignment.variableNames.size() >= 1, "");
-	string variables = (*this)(_assignment.variableNames.front());
-	for (size_t i = 1; i < _assignment.variableNames.size(); ++i)
-		variables += ", " + (*this)(_assignment.variableNames[i]);
+	for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+	{
+		if (i > 0)
+			m_out += ", ";
+		print(_assignment.variableNames[i]);
+	}
 
-	return locationComment + variables + " := " + std::visit(*this, *_assignment.value);
+	m_out += " := ";
+	print(*_assignment.value);
 }
 
-string AsmPrinter::operator()(VariableDeclaration const& _variableDeclaration)
+void AsmPrinter::print(VariableDeclaration const& _variableDeclaration)
 {
-	string out = formatDebugData(_variableDeclaration);
-
-	out += "let ";
-	out += boost::algorithm::join(
-		_variableDeclaration.variables | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
+	printDebugData(_variableDeclaration);
+
+	m_out += "let ";
+	printTypedNames(_variableDeclaration.variables);
 	if (_variableDeclaration.value)
 	{
-		out += " := ";
-		out += std::visit(*this, *_variableDeclaration.value);
+		m_out += " := ";
+		print(*_variableDeclaration.value);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(FunctionDefinition const& _functionDefinition)
+void AsmPrinter::print(FunctionDefinition const& _functionDefinition)
 {
 	yulAssert(!_functionDefinition.name.empty(), "Invalid function name.");
 
-	string out = formatDebugData(_functionDefinition);
-	out += "function " + _functionDefinition.name.str() + "(";
-	out += boost::algorithm::join(
-		_functionDefinition.parameters | ranges::views::transform(
-			[this](TypedName argument) { return formatTypedName(argument); }
-		),
-		", "
-	);
-	out += ")";
+	printDebugData(_functionDefinition);
+	m_out += "function ";
+	m_out += _functionDefinition.name.str();
+	m_out += '(';
+	printTypedNames(_functionDefinition.parameters);
+	m_out += ')';
 	if (!_functionDefinition.returnVariables.empty())
 	{
-		out += " -> ";
-		out += boost::algorithm::join(
-			_functionDefinition.returnVariables | ranges::views::transform(
-				[this](TypedName argument) { return formatTypedName(argument); }
-			),
-			", "
-		);
+		m_out += " -> ";
+		printTypedNames(_functionDefinition.returnVariables);
 	}
 
-	return out + "\n" + (*this)(_functionDefinition.body);
+	newline();
+	print(_functionDefinition.body);
 }
 
-string AsmPrinter::operator()(FunctionCall const& _functionCall)
+void AsmPrinter::print(FunctionCall const& _functionCall)
 {
-	string const locationComment = formatDebugData(_functionCall);
-	string const functionName = (*this)(_functionCall.functionName);
-	return
-		locationComment +
-		functionName + "(" +
-		boost::algorithm::join(
-			_functionCall.arguments | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-			", " ) +
-		")";
+	printDebugData(_functionCall);
+	print(_functionCall.functionName);
+	m_out += '(';
+	for (size_t i = 0; i < _functionCall.arguments.size(); ++i)
+	{
+		if (i > 0)
+			m_out += ", ";
+		print(_functionCall.arguments[i]);
+	}
+	m_out += ')';
 }
 
-string AsmPrinter::operator()(If const& _if)
+void AsmPrinter::print(If const& _if)
 {
 	yulAssert(_if.condition, "Invalid if condition.");
 
-	string out = formatDebugData(_if);
-	out += "if " + std::visit(*this, *_if.condition);
-
-	string body = (*this)(_if.body);
-	char delim = '\n';
-	if (body.find('\n') == string::npos)
-		delim = ' ';
-
-	return out + delim + body;
+	printDebugData(_if);
+	m_out += "if ";
+	print(*_if.condition);
+
+	// The body goes on the same line if it fits on a single line.
+	size_t const lineBreak = m_out.size();
+	size_t const lineBreaks = m_lineBreaks;
+	newline();
+	print(_if.body);
+	if (m_lineBreaks == lineBreaks + 1)
+		joinLine(lineBreak, m_indentation);
 }
 
-string AsmPrinter::operator()(Switch const& _switch)
+void AsmPrinter::print(Switch const& _switch)
 {
 	yulAssert(_switch.expression, "Invalid expression pointer.");
 
-	string out = formatDebugData(_switch);
-	out += "switch " + std::visit(*this, *_switch.expression);
+	printDebugData(_switch);
+	m_out += "switch ";
+	print(*_switch.expression);
 
 	for (auto const& _case: _switch.cases)
 	{
+		newline();
 		if (!_case.value)
-			out += "\ndefault ";
+			m_out += "default ";
 		else
-			out += "\ncase " + (*this)(*_case.value) + " ";
-		out += (*this)(_case.body);
+		{
+			m_out += "case ";
+			print(*_case.value);
+			m_out += ' ';
+		}
+		print(_case.body);
 	}
-	return out;
 }
 
-string AsmPrinter::operator()(ForLoop const& _forLoop)
+void AsmPrinter::print(ForLoop const& _forLoop)
 {
 	yulAssert(_forLoop.condition, "Invalid for loop condition.");
-	string const locationComment = formatDebugData(_forLoop);
-
-	string pre = (*this)(_forLoop.pre);
-	string condition = std::visit(*this, *_forLoop.condition);
-	string post = (*this)(_forLoop.post);
+	printDebugData(_forLoop);
+
+	m_out += "for ";
+	size_t const lineBreaks = m_lineBreaks;
+	size_t const preStart = m_out.size();
+	print(_forLoop.pre);
+	size_t const firstLineBreak = m_out.size();
+	newline();
+	size_t const conditionStart = m_out.size();
+	print(*_forLoop.condition);
+	size_t const secondLineBreak = m_out.size();
+	newline();
+	size_t const postStart = m_out.size();
+	print(_forLoop.post);
+
+	// Short headers go on a single line.
+	size_t const headerLength =
+		(firstLineBreak - preStart) +
+		(secondLineBreak - conditionStart) +
+		(m_out.size() - postStart);
+	if (headerLength < 60 && m_lineBreaks == lineBreaks + 2)
+	{
+		joinLine(secondLineBreak, m_indentation);
+		joinLine(firstLineBreak, m_indentation);
+	}
 
-	char delim = '\n';
-	if (
-		pre.size() + condition.size() + post.size() < 60 &&
-		pre.find('\n') == string::npos &&
-		post.find('\n') == string::npos
-	)
-		delim = ' ';
-	return
-		locationComment +
-		("for " + move(pre) + delim + move(condition) + delim + move(post) + "\n") +
-		(*this)(_forLoop.body);
+	newline();
+	print(_forLoop.body);
 }
 
-string AsmPrinter::operator()(Break const& _break)
+void AsmPrinter::print(Break const& _break)
 {
-	return formatDebugData(_break) + "break";
+	printDebugData(_break);
+	m_out += "break";
 }
 
-string AsmPrinter::operator()(Continue const& _continue)
+void AsmPrinter::print(Continue const& _continue)
 {
-	return formatDebugData(_continue) + "continue";
+	printDebugData(_continue);
+	m_out += "continue";
 }
 
-// '_leave' and '__leave' is reserved in VisualStudio
-string AsmPrinter::operator()(Leave const& leave_)
+void AsmPrinter::print(Leave const& leave_)
 {
-	return formatDebugData(leave_) + "leave";
+	printDebugData(leave_);
+	m_out += "leave";
 }
 
-string AsmPrinter::operator()(Block const& _block)
+void AsmPrinter::print(Block const& _block)
 {
-	string const locationComment = formatDebugData(_block);
+	printDebugData(_block);
 
 	if (_block.statements.empty())
-		return locationComment + "{ }";
-	string body = boost::algorithm::join(
-		_block.statements | ranges::views::transform([&](auto&& _node) { return std::visit(*this, _node); }),
-		"\n"
-	);
-	if (body.size() < 30 && body.find('\n') == string::npos)
-		return locationComment + "{ " + body + " }";
+	{
+		m_out += "{ }";
+		return;
+	}
+
+	m_out += '{';
+	size_t const lineBreak = m_out.size();
+	size_t const lineBreaks = m_lineBreaks;
+	m_indentation += 4;
+	newline();
+	size_t const bodyStart = m_out.size();
+	for (size_t i = 0; i < _block.statements.size(); ++i)
+	{
+		if (i > 0)
+			newline();
+		print(_block.statements[i]);
+	}
+	m_indentation -= 4;
+
+	// Short bodies without line breaks go on the same line as the braces.
+	if (m_lineBreaks == lineBreaks + 1 && m_out.size() - bodyStart < 30)
+	{
+		joinLine(lineBreak, m_indentation + 4);
+		m_out += " }";
+	}
 	else
 	{
-		boost::replace_all(body, "\n", "\n    ");
-		return locationComment + "{\n    " + body + "\n}";
+		newline();
+		m_out += '}';
 	}
 }
 
-string AsmPrinter::formatTypedName(TypedName _variable)
+void AsmPrinter::printTypedNames(vector<TypedName> const& _variables)
 {
-	yulAssert(!_variable.name.empty(), "Invalid variable name.");
-	return formatDebugData(_variable) + _variable.name.str() + appendTypeName(_variable.type);
+	for (size_t i = 0; i < _variables.size(); ++i)
+	{
+		TypedName const& variable = _variables[i];
+		yulAssert(!variable.name.empty(), "Invalid variable name.");
+		if (i > 0)
+			m_out += ", ";
+		printDebugData(variable);
+		m_out += variable.name.str();
+		appendTypeName(variable.type);
+	}
 }
 
-string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
+void AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral)
 {
 	if (m_dialect && !_type.empty())
 	{
@@ -252,10 +321,25 @@ string AsmPrinter::appendTypeName(YulString _type, bool _isBoolLiteral) const
 			// Special case: If we have a bool type but empty default type, do not remove the type.
 			_type = {};
 	}
-	if (_type.empty())
-		return {};
-	else
-		return ":" + _type.str();
+	if (!_type.empty())
+	{
+		m_out += ':';
+		m_out += _type.str();
+	}
+}
+
+void AsmPrinter::newline()
+{
+	m_out += '\n';
+	m_out.append(m_indentation, ' ');
+	++m_lineBreaks;
+}
+
+void AsmPrinter::joinLine(size_t _position, size_t _indentation)
+{
+	yulAssert(m_out[_position] == '\n', "");
+	m_out.replace(_position, 1 + _indentation, " ");
+	--m_lineBreaks;
 }
 
 string AsmPrinter::formatSourceLocation(
@@ -302,10 +386,10 @@ string AsmPrinter::formatSourceLocation(
 	return sourceLocation + (solidityCodeSnippet.empty() ? "" : "  ") + solidityCodeSnippet;
 }
 
-string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData, bool _statement)
+void AsmPrinter::printDebugData(DebugData const* _debugData, bool _statement)
 {
 	if (!_debugData || m_debugInfoSelection.none())
-		return "";
+		return;
 
 	vector<string> items;
 	if (auto id = _debugData->astID)
@@ -329,10 +413,17 @@ string AsmPrinter::formatDebugData(shared_ptr<DebugData const> const& _debugData
 
 	string commentBody = joinHumanReadable(items, " ");
 	if (commentBody.empty())
-		return "";
+		return;
+	else if (_statement)
+	{
+		m_out += "/// ";
+		m_out += commentBody;
+		newline();
+	}
 	else
-		return
-			_statement ?
-			"/// " + commentBody + "\n" :
-			"/** " + commentBody + " */ ";
+	{
+		m_out += "/** ";
+		m_out += commentBody;
+		m_out += " */ ";
+	}
 }
@@ -33,6 +33,8 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <map>
+#include <variant>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -48,7 +50,7 @@ class AsmPrinter
 public:
 	explicit AsmPrinter(
 		Dialect const* _dialect = nullptr,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceIndexToName = {},
+		std::optional<std::map<unsigned, std::string const*>> _sourceIndexToName = {},
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	):
@@ -63,7 +65,7 @@ public:
 
 	explicit AsmPrinter(
 		Dialect const& _dialect,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceIndexToName = {},
+		std::optional<std::map<unsigned, std::string const*>> _sourceIndexToName = {},
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	): AsmPrinter(&_dialect, _sourceIndexToName, _debugInfoSelection, _soliditySourceProvider) {}
@@ -91,21 +93,58 @@ public:
 	);
 
 private:
-	std::string formatTypedName(TypedName _variable);
-	std::string appendTypeName(YulString _type, bool _isBoolLiteral = false) const;
-	std::string formatDebugData(std::shared_ptr<DebugData const> const& _debugData, bool _statement);
+	/// Prints @a _node to the end of m_out and returns the whole buffer.
 	template <class T>
-	std::string formatDebugData(T const& _node)
+	std::string format(T const& _node);
+
+	void print(Literal const& _literal);
+	void print(Identifier const& _identifier);
+	void print(ExpressionStatement const& _expr);
+	void print(Assignment const& _assignment);
+	void print(VariableDeclaration const& _variableDeclaration);
+	void print(FunctionDefinition const& _functionDefinition);
+	void print(FunctionCall const& _functionCall);
+	void print(If const& _if);
+	void print(Switch const& _switch);
+	void print(ForLoop const& _forLoop);
+	void print(Break const& _break);
+	void print(Continue const& _continue);
+	void print(Leave const& _continue);
+	void print(Block const& _block);
+	template <class... Ts>
+	void print(std::variant<Ts...> const& _node)
+	{
+		std::visit([this](auto const& _alternative) { print(_alternative); }, _node);
+	}
+	void printTypedNames(std::vector<TypedName> const& _variables);
+	void appendTypeName(YulString _type, bool _isBoolLiteral = false);
+	void printDebugData(DebugData const* _debugData, bool _statement);
+	template <class T>
+	void printDebugData(T const& _node)
 	{
 		bool isExpression = std::is_constructible<Expression, T>::value;
-		return formatDebugData(_node.debugData, !isExpression);
+		printDebugData(_node.debugData, !isExpression);
 	}
 
+	/// Starts a new line at the current indentation.
+	void newline();
+	/// Replaces the line break at @a _position, which was followed by @a _indentation spaces,
+	/// by a single space.
+	void joinLine(size_t _position, size_t _indentation);
+
 	Dialect const* const m_dialect = nullptr;
 	std::map<std::string, unsigned> m_nameToSourceIndex;
 	langutil::SourceLocation m_lastLocation = {};
 	langutil::DebugInfoSelection m_debugInfoSelection = {};
 	langutil::CharStreamProvider const* m_soliditySourceProvider = nullptr;
+
+	/// Output buffer. Nodes are printed in a single pass, the few layout decisions that depend
+	/// on the printed size of a node are fixed up afterwards.
+	std::string m_out;
+	/// Number of spaces at the start of each new line.
+	size_t m_indentation = 0;
+	/// Number of line breaks in m_out.
+	size_t m_lineBreaks = 0;
 };
 
 }
@@ -25,6 +25,7 @@
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 using namespace std;
 using namespace solidity;
@@ -36,6 +37,58 @@ CompilabilityChecker::CompilabilityChecker(
 	Object const& _object,
 	bool _optimizeStackAllocation
 )
+{
+	check(_dialect, _object, _optimizeStackAllocation);
+}
+
+CompilabilityChecker::CompilabilityChecker(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functions
+)
+{
+	yulAssert(
+		_object.code &&
+		!_object.code->statements.empty() && holds_alternative<Block>(_object.code->statements.front()),
+		"Need to run the function grouper before checking individual functions."
+	);
+
+	// The stack layout inside a function only depends on the function itself and
+	// on the signatures of the functions it calls, so all other functions are checked
+	// with an empty body.
+	Object reducedObject;
+	reducedObject.name = _object.name;
+	reducedObject.subObjects = _object.subObjects;
+	reducedObject.subIndexByName = _object.subIndexByName;
+	reducedObject.code = make_shared<Block>();
+	reducedObject.code->debugData = _object.code->debugData;
+	for (Statement const& statement: _object.code->statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement); function && !_functions.count(function->name))
+			reducedObject.code->statements.emplace_back(FunctionDefinition{
+				function->debugData,
+				function->name,
+				function->parameters,
+				function->returnVariables,
+				Block{function->body.debugData, {}}
+			});
+		else if (auto const* block = get_if<Block>(&statement); block && !_functions.count(YulString{}))
+			reducedObject.code->statements.emplace_back(Block{block->debugData, {}});
+		else
+			reducedObject.code->statements.emplace_back(ASTCopier{}.translate(statement));
+
+	check(_dialect, reducedObject, _optimizeStackAllocation);
+	for (auto it = stackDeficit.begin(); it != stackDeficit.end();)
+		it = _functions.count(it->first) ? next(it) : stackDeficit.erase(it);
+	for (auto it = unreachableVariables.begin(); it != unreachableVariables.end();)
+		it = _functions.count(it->first) ? next(it) : unreachableVariables.erase(it);
+}
+
+void CompilabilityChecker::check(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation
+)
 {
 	if (auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
 	{
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 namespace solidity::yul
 {
@@ -45,8 +46,20 @@ namespace solidity::yul
 struct CompilabilityChecker
 {
 	CompilabilityChecker(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
+	/// Only checks the functions in @a _functions, where the empty name denotes the outermost block.
+	/// The results for all other functions are left out.
+	/// Requires the function grouper to have been run.
+	CompilabilityChecker(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::set<YulString> const& _functions
+	);
 	std::map<YulString, std::set<YulString>> unreachableVariables;
 	std::map<YulString, int> stackDeficit;
+
+private:
+	void check(Dialect const& _dialect, Object const& _object, bool _optimizeStackAllocation);
 };
 
 }
@@ -26,6 +26,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Algorithms.h>
 
+#include <range/v3/range/conversion.hpp>
 #include <range/v3/view/map.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/algorithm/find_if.hpp>
@@ -45,6 +46,8 @@ void ControlFlowBuilder::operator()(FunctionCall const& _functionCall)
 	walkVector(_functionCall.arguments | ranges::views::reverse);
 	newConnectedNode();
 	m_currentNode->functionCall = &_functionCall;
+	if (m_currentFunction)
+		m_functionCalls[m_currentFunction].emplace_back(&_functionCall);
 }
 
 void ControlFlowBuilder::operator()(If const& _if)
@@ -81,6 +84,8 @@ void ControlFlowBuilder::operator()(FunctionDefinition const& _function)
 	ScopedSaveAndRestore leave(m_leave, nullptr);
 	ScopedSaveAndRestore _break(m_break, nullptr);
 	ScopedSaveAndRestore _continue(m_continue, nullptr);
+	ScopedSaveAndRestore currentFunction(m_currentFunction, &_function);
+	m_functionCalls[&_function];
 
 	FunctionFlow flow;
 	flow.exit = newNode();
@@ -179,15 +184,20 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 		m_functionCalls[function] = {};
 	}
 
-	// Process functions while we have progress. For now, we are only interested
-	// in `canContinue`.
-	bool progress = true;
-	while (progress)
+	// Process the functions bottom-up along the call graph, so that the side-effects
+	// of all called functions outside of the current strongly connected component are
+	// final. Inside of a component (i.e. for recursive functions), process the functions
+	// while we have progress. For now, we are only interested in `canContinue`.
+	for (vector<FunctionDefinition const*> const& component: callGraphComponents(false))
 	{
-		progress = false;
-		for (FunctionDefinition const* function: m_pendingNodes | ranges::views::keys)
-			if (processFunction(*function))
-				progress = true;
+		bool progress = true;
+		while (progress)
+		{
+			progress = false;
+			for (FunctionDefinition const* function: component)
+				if (processFunction(*function))
+					progress = true;
+		}
 	}
 
 	// No progress anymore: All remaining nodes are calls
@@ -197,30 +207,26 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 
 	// Now it is sufficient to handle the reachable function calls (`m_functionCalls`),
 	// we do not have to consider the control-flow graph anymore.
-	for (auto&& [function, calls]: m_functionCalls)
+	// All functions in a strongly connected component of the graph of reachable calls
+	// reach the same calls, so they share the same side-effects.
+	for (vector<FunctionDefinition const*> const& component: callGraphComponents(true))
 	{
-		yulAssert(function);
-		ControlFlowSideEffects& functionSideEffects = m_functionSideEffects[function];
-		auto _visit = [&, visited = std::set<FunctionDefinition const*>{}](FunctionDefinition const& _function, auto&& _recurse) mutable {
-			// Worst side-effects already, stop searching.
-			if (functionSideEffects.canTerminate && functionSideEffects.canRevert)
-				return;
-			if (!visited.insert(&_function).second)
-				return;
-
-			for (FunctionCall const* call: m_functionCalls.at(&_function))
+		ControlFlowSideEffects componentSideEffects;
+		for (FunctionDefinition const* function: component)
+			for (FunctionCall const* call: m_functionCalls.at(function))
 			{
 				ControlFlowSideEffects const& calledSideEffects = sideEffects(*call);
 				if (calledSideEffects.canTerminate)
-					functionSideEffects.canTerminate = true;
+					componentSideEffects.canTerminate = true;
 				if (calledSideEffects.canRevert)
-					functionSideEffects.canRevert = true;
-
-				if (m_functionReferences.count(call))
-					_recurse(*m_functionReferences.at(call), _recurse);
+					componentSideEffects.canRevert = true;
 			}
-		};
-		_visit(*function, _visit);
+		for (FunctionDefinition const* function: component)
+		{
+			ControlFlowSideEffects& functionSideEffects = m_functionSideEffects[function];
+			functionSideEffects.canTerminate = componentSideEffects.canTerminate;
+			functionSideEffects.canRevert = componentSideEffects.canRevert;
+		}
 	}
 }
 
@@ -232,6 +238,23 @@ map<YulString, ControlFlowSideEffects> ControlFlowSideEffectsCollector::function
 	return result;
 }
 
+vector<vector<FunctionDefinition const*>> ControlFlowSideEffectsCollector::callGraphComponents(bool _reachableOnly) const
+{
+	vector<FunctionDefinition const*> functions = m_functionSideEffects | ranges::views::keys | ranges::to<vector>;
+	return util::stronglyConnectedComponents(functions, [&](FunctionDefinition const* _function, auto&& _addSuccessor) {
+		auto addCallee = [&](FunctionCall const* _call) {
+			if (FunctionDefinition const* const* callee = util::valueOrNullptr(m_functionReferences, _call))
+				_addSuccessor(*callee);
+		};
+		if (_reachableOnly)
+			for (FunctionCall const* call: m_functionCalls.at(_function))
+				addCallee(call);
+		else
+			for (FunctionCall const* call: m_cfgBuilder.functionCalls().at(_function))
+				addCallee(call);
+	});
+}
+
 bool ControlFlowSideEffectsCollector::processFunction(FunctionDefinition const& _function)
 {
 	bool progress = false;
@@ -57,6 +57,8 @@ public:
 	/// Assumes the functions are hoisted to the topmost block.
 	explicit ControlFlowBuilder(Block const& _ast);
 	std::map<FunctionDefinition const*, FunctionFlow> const& functionFlows() const { return m_functionFlows; }
+	/// @returns all function calls in the body of each function, regardless of their reachability.
+	std::map<FunctionDefinition const*, std::vector<FunctionCall const*>> const& functionCalls() const { return m_functionCalls; }
 
 private:
 	using ASTWalker::operator();
@@ -78,8 +80,10 @@ private:
 	ControlFlowNode const* m_leave = nullptr;
 	ControlFlowNode const* m_break = nullptr;
 	ControlFlowNode const* m_continue = nullptr;
+	FunctionDefinition const* m_currentFunction = nullptr;
 
 	std::map<FunctionDefinition const*, FunctionFlow> m_functionFlows;
+	std::map<FunctionDefinition const*, std::vector<FunctionCall const*>> m_functionCalls;
 };
 
 
@@ -104,6 +108,12 @@ public:
 	std::map<YulString, ControlFlowSideEffects> functionSideEffectsNamed() const;
 private:
 
+	/// @returns the strongly connected components of the graph of calls to user-defined functions,
+	/// callees before callers.
+	/// @param _reachableOnly if true, only consider the reachable calls recorded in m_functionCalls,
+	/// otherwise consider all calls.
+	std::vector<std::vector<FunctionDefinition const*>> callGraphComponents(bool _reachableOnly) const;
+
 	/// @returns false if nothing could be processed.
 	bool processFunction(FunctionDefinition const& _function);
 
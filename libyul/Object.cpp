@@ -21,18 +21,22 @@
 
 #include <libyul/Object.h>
 
+#include <libyul/AST.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/replace.hpp>
 
 #include <range/v3/view/transform.hpp>
 
+#include <array>
+#include <sstream>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -42,18 +46,52 @@ using namespace solidity::yul;
 namespace
 {
 
-string indent(std::string const& _input)
+/// Writes @a _text to @a _stream, following every line break by @a _indentation levels of indentation.
+void printIndented(ostream& _stream, string_view _text, size_t _indentation)
 {
-	if (_input.empty())
-		return _input;
-	return boost::replace_all_copy("    " + _input, "\n", "\n    ");
+	for (size_t lineBreak = _text.find('\n'); lineBreak != string_view::npos; lineBreak = _text.find('\n'))
+	{
+		_stream << _text.substr(0, lineBreak + 1);
+		for (size_t i = 0; i < _indentation; ++i)
+			_stream << "    ";
+		_text.remove_prefix(lineBreak + 1);
+	}
+	_stream << _text;
 }
 
 }
 
-string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
+string ObjectNode::toString(
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider
+) const
 {
-	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
+	ostringstream stream;
+	print(stream, 0, _dialect, _debugInfoSelection, _soliditySourceProvider);
+	return stream.str();
+}
+
+void Data::print(ostream& _stream, size_t _indentation, Dialect const*, DebugInfoSelection const&, CharStreamProvider const*) const
+{
+	printIndented(_stream, "data \"" + name.str() + "\" hex\"", _indentation);
+	// Large data (e.g. the creation code of other contracts) is converted in chunks
+	// to avoid building the complete hex string in memory.
+	static char const hexDigits[] = "0123456789abcdef";
+	array<char, 8192> buffer;
+	size_t bufferSize = 0;
+	for (uint8_t byte: data)
+	{
+		buffer[bufferSize++] = hexDigits[byte >> 4];
+		buffer[bufferSize++] = hexDigits[byte & 0xf];
+		if (bufferSize == buffer.size())
+		{
+			_stream.write(buffer.data(), static_cast<streamsize>(bufferSize));
+			bufferSize = 0;
+		}
+	}
+	_stream.write(buffer.data(), static_cast<streamsize>(bufferSize));
+	_stream << "\"";
 }
 
 string Object::toString(
@@ -61,31 +99,52 @@ string Object::toString(
 	DebugInfoSelection const& _debugInfoSelection,
 	CharStreamProvider const* _soliditySourceProvider
 ) const
+{
+	return ObjectNode::toString(_dialect, _debugInfoSelection, _soliditySourceProvider);
+}
+
+void Object::print(
+	ostream& _stream,
+	size_t _indentation,
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider
+) const
 {
 	yulAssert(code, "No code");
 	yulAssert(debugData, "No debug data");
 
-	string useSrcComment;
-
 	if (debugData->sourceNames)
-		useSrcComment =
+		printIndented(
+			_stream,
 			"/// @use-src " +
 			joinHumanReadable(ranges::views::transform(*debugData->sourceNames, [](auto&& _pair) {
 				return to_string(_pair.first) + ":" + util::escapeAndQuoteString(*_pair.second);
 			})) +
-			"\n";
+			"\n",
+			_indentation
+		);
 
-	string inner = "code " + AsmPrinter(
-		_dialect,
-		debugData->sourceNames,
-		_debugInfoSelection,
-		_soliditySourceProvider
-	)(*code);
+	printIndented(_stream, "object \"" + name.str() + "\" {", _indentation);
+	printIndented(_stream, "\ncode ", _indentation + 1);
+	printIndented(
+		_stream,
+		AsmPrinter(
+			_dialect,
+			debugData->sourceNames,
+			_debugInfoSelection,
+			_soliditySourceProvider
+		)(*code),
+		_indentation + 1
+	);
 
 	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_dialect, _debugInfoSelection, _soliditySourceProvider);
+	{
+		printIndented(_stream, "\n", _indentation + 1);
+		obj->print(_stream, _indentation + 1, _dialect, _debugInfoSelection, _soliditySourceProvider);
+	}
 
-	return useSrcComment + "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	printIndented(_stream, "\n}", _indentation);
 }
 
 set<YulString> Object::qualifiedDataNames() const
@@ -144,3 +203,20 @@ vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 
 	return path;
 }
+
+shared_ptr<Object> Object::structuralClone() const
+{
+	auto clone = make_shared<Object>();
+	clone->name = name;
+	clone->subId = subId;
+	if (code)
+		clone->code = make_shared<Block>(ASTCopier{}.translate(*code));
+	for (shared_ptr<ObjectNode> const& subObject: subObjects)
+		if (auto const* subObjectAsObject = dynamic_cast<Object const*>(subObject.get()))
+			clone->subObjects.emplace_back(subObjectAsObject->structuralClone());
+		else
+			clone->subObjects.emplace_back(subObject);
+	clone->subIndexByName = subIndexByName;
+	clone->debugData = debugData;
+	return clone;
+}
@@ -30,6 +30,7 @@
 #include <libsolutil/Common.h>
 
 #include <memory>
+#include <ostream>
 #include <set>
 #include <limits>
 
@@ -39,7 +40,7 @@ struct Dialect;
 struct AsmAnalysisInfo;
 
 
-using SourceNameMap = std::map<unsigned, std::shared_ptr<std::string const>>;
+using SourceNameMap = std::map<unsigned, std::string const*>;
 
 struct Object;
 
@@ -57,6 +58,16 @@ struct ObjectNode
 		Dialect const* _dialect,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
+	) const;
+	/// Writes the same text as ``toString`` to @a _stream, but follows every line break
+	/// by @a _indentation levels of indentation. Nested objects are written directly into
+	/// the stream instead of being built up as separate strings and indented afterwards.
+	virtual void print(
+		std::ostream& _stream,
+		size_t _indentation,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const = 0;
 };
 
@@ -69,7 +80,9 @@ struct Data: public ObjectNode
 
 	bytes data;
 
-	std::string toString(
+	void print(
+		std::ostream& _stream,
+		size_t _indentation,
 		Dialect const* _dialect,
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
@@ -94,7 +107,14 @@ public:
 		Dialect const* _dialect,
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
-	) const;
+	) const override;
+	void print(
+		std::ostream& _stream,
+		size_t _indentation,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider
+	) const override;
 
 	/// @returns the set of names of data objects accessible from within the code of
 	/// this object, including the name of object itself
@@ -113,6 +133,10 @@ public:
 	/// The path must not lead to a @a Data object (will throw in that case).
 	std::vector<size_t> pathToSubObject(YulString _qualifiedName) const;
 
+	/// @returns a copy of this object and all its sub-objects that does not share any code with the original.
+	/// Data nodes and debug data are shared, analysis information is not copied.
+	std::shared_ptr<Object> structuralClone() const;
+
 	/// sub id for object if it is subobject of another object, max value if it is not subobject
 	size_t subId = std::numeric_limits<size_t>::max();
 
@@ -30,7 +30,8 @@
 
 #include <libsolutil/StringUtils.h>
 
-#include <regex>
+#include <cctype>
+#include <string_view>
 
 using namespace std;
 using namespace solidity;
@@ -125,16 +126,19 @@ optional<SourceNameMap> ObjectParser::tryParseSourceNameMapping() const
 	// FileName   := "(([^\"]|\.)*)"
 
 	// Matches some "@use-src TEXT".
-	static std::regex const lineRE = std::regex(
-		"(^|\\s)@use-src\\b",
-		std::regex_constants::ECMAScript | std::regex_constants::optimize
-	);
-	std::smatch sm;
-	if (!std::regex_search(m_scanner->currentCommentLiteral(), sm, lineRE))
+	string const& comment = m_scanner->currentCommentLiteral();
+	string_view const tag = "@use-src";
+	auto const isWordCharacter = [](char _c) { return isalnum(static_cast<unsigned char>(_c)) || _c == '_'; };
+	size_t pos = comment.find(tag);
+	while (pos != string::npos && !(
+		(pos == 0 || isspace(static_cast<unsigned char>(comment[pos - 1]))) &&
+		(pos + tag.size() == comment.size() || !isWordCharacter(comment[pos + tag.size()]))
+	))
+		pos = comment.find(tag, pos + 1);
+	if (pos == string::npos)
 		return nullopt;
 
-	solAssert(sm.size() == 2, "");
-	auto text = m_scanner->currentCommentLiteral().substr(static_cast<size_t>(sm.position() + sm.length()));
+	auto text = comment.substr(pos + tag.size());
 	CharStream charStream(text, "");
 	Scanner scanner(charStream);
 	if (scanner.currentToken() == Token::EOS)
@@ -152,7 +156,7 @@ optional<SourceNameMap> ObjectParser::tryParseSourceNameMapping() const
 			break;
 		if (scanner.next() != Token::StringLiteral)
 			break;
-		sourceNames[*sourceIndex] = make_shared<string const>(scanner.currentLiteral());
+		sourceNames[*sourceIndex] = internSourceName(scanner.currentLiteral());
 
 		Token const next = scanner.next();
 		if (next == Token::EOS)
@@ -0,0 +1,697 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/ObjectSerialiser.h>
+
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Object.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/LEB128.h>
+
+#include <limits>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+bytes const magic{'Y', 'U', 'L', 'B'};
+
+enum class NodeKind: uint8_t
+{
+	FunctionCall,
+	Identifier,
+	Literal,
+	ExpressionStatement,
+	Assignment,
+	VariableDeclaration,
+	FunctionDefinition,
+	If,
+	Switch,
+	ForLoop,
+	Break,
+	Continue,
+	Leave,
+	Block
+};
+
+enum class ObjectNodeKind: uint8_t
+{
+	Object,
+	Data
+};
+
+class Writer
+{
+public:
+	bytes run(Object const& _object)
+	{
+		write(_object);
+
+		bytes debugData = lebEncode(m_debugData.size());
+		int64_t previousNativeStart = 0;
+		int64_t previousOriginStart = 0;
+		for (DebugData const* entry: m_debugData)
+		{
+			writeLocation(debugData, entry->nativeLocation, previousNativeStart);
+			writeLocation(debugData, entry->originLocation, previousOriginStart);
+			debugData += lebEncode(entry->astID.has_value());
+			if (entry->astID)
+				debugData += lebEncodeSigned(*entry->astID);
+		}
+
+		bytes result = magic;
+		result += lebEncode(ObjectSerialiser::version);
+		result += lebEncode(m_strings.size());
+		for (string const* str: m_strings)
+		{
+			result += lebEncode(str->size());
+			result += asBytes(*str);
+		}
+		result += debugData;
+		result += m_nodes;
+		return result;
+	}
+
+private:
+	void write(Object const& _object)
+	{
+		writeString(_object.name.str());
+		writeNumber(_object.subId == numeric_limits<size_t>::max() ? 0 : _object.subId + 1);
+
+		writeNumber(_object.code != nullptr);
+		if (_object.code)
+			write(*_object.code);
+
+		bool hasSourceNames = _object.debugData && _object.debugData->sourceNames;
+		writeNumber(hasSourceNames);
+		if (hasSourceNames)
+		{
+			writeNumber(_object.debugData->sourceNames->size());
+			for (auto const& [index, name]: *_object.debugData->sourceNames)
+			{
+				writeNumber(index);
+				writeString(*name);
+			}
+		}
+
+		writeNumber(_object.subObjects.size());
+		for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			{
+				writeNumber(static_cast<uint8_t>(ObjectNodeKind::Object));
+				write(*subObject);
+			}
+			else
+			{
+				auto const* data = dynamic_cast<Data const*>(subNode.get());
+				yulAssert(data, "");
+				writeNumber(static_cast<uint8_t>(ObjectNodeKind::Data));
+				writeString(data->name.str());
+				writeNumber(data->data.size());
+				m_nodes += data->data;
+			}
+
+		writeNumber(_object.subIndexByName.size());
+		for (auto const& [name, index]: _object.subIndexByName)
+		{
+			writeString(name.str());
+			writeNumber(index);
+		}
+	}
+
+	void write(Expression const& _expression)
+	{
+		std::visit([&](auto const& _node) { write(_node); }, _expression);
+	}
+
+	void write(Statement const& _statement)
+	{
+		std::visit([&](auto const& _node) { write(_node); }, _statement);
+	}
+
+	void write(FunctionCall const& _call)
+	{
+		writeHeader(NodeKind::FunctionCall, _call.debugData);
+		writeIdentifier(_call.functionName);
+		writeNumber(_call.arguments.size());
+		for (Expression const& argument: _call.arguments)
+			write(argument);
+	}
+
+	void write(Identifier const& _identifier)
+	{
+		writeHeader(NodeKind::Identifier, _identifier.debugData);
+		writeString(_identifier.name.str());
+	}
+
+	void write(Literal const& _literal)
+	{
+		writeHeader(NodeKind::Literal, _literal.debugData);
+		writeLiteral(_literal);
+	}
+
+	void write(ExpressionStatement const& _statement)
+	{
+		writeHeader(NodeKind::ExpressionStatement, _statement.debugData);
+		write(_statement.expression);
+	}
+
+	void write(Assignment const& _assignment)
+	{
+		writeHeader(NodeKind::Assignment, _assignment.debugData);
+		writeNumber(_assignment.variableNames.size());
+		for (Identifier const& variable: _assignment.variableNames)
+			writeIdentifier(variable);
+		yulAssert(_assignment.value, "");
+		write(*_assignment.value);
+	}
+
+	void write(VariableDeclaration const& _declaration)
+	{
+		writeHeader(NodeKind::VariableDeclaration, _declaration.debugData);
+		writeTypedNames(_declaration.variables);
+		writeNumber(_declaration.value != nullptr);
+		if (_declaration.value)
+			write(*_declaration.value);
+	}
+
+	void write(FunctionDefinition const& _function)
+	{
+		writeHeader(NodeKind::FunctionDefinition, _function.debugData);
+		writeString(_function.name.str());
+		writeTypedNames(_function.parameters);
+		writeTypedNames(_function.returnVariables);
+		write(_function.body);
+	}
+
+	void write(If const& _if)
+	{
+		writeHeader(NodeKind::If, _if.debugData);
+		yulAssert(_if.condition, "");
+		write(*_if.condition);
+		write(_if.body);
+	}
+
+	void write(Switch const& _switch)
+	{
+		writeHeader(NodeKind::Switch, _switch.debugData);
+		yulAssert(_switch.expression, "");
+		write(*_switch.expression);
+		writeNumber(_switch.cases.size());
+		for (Case const& _case: _switch.cases)
+		{
+			writeDebugData(_case.debugData);
+			writeNumber(_case.value != nullptr);
+			if (_case.value)
+			{
+				writeDebugData(_case.value->debugData);
+				writeLiteral(*_case.value);
+			}
+			write(_case.body);
+		}
+	}
+
+	void write(ForLoop const& _loop)
+	{
+		writeHeader(NodeKind::ForLoop, _loop.debugData);
+		write(_loop.pre);
+		yulAssert(_loop.condition, "");
+		write(*_loop.condition);
+		write(_loop.post);
+		write(_loop.body);
+	}
+
+	void write(Break const& _break) { writeHeader(NodeKind::Break, _break.debugData); }
+	void write(Continue const& _continue) { writeHeader(NodeKind::Continue, _continue.debugData); }
+	void write(Leave const& _leave) { writeHeader(NodeKind::Leave, _leave.debugData); }
+
+	void write(Block const& _block)
+	{
+		writeHeader(NodeKind::Block, _block.debugData);
+		writeNumber(_block.statements.size());
+		for (Statement const& statement: _block.statements)
+			write(statement);
+	}
+
+	void writeHeader(NodeKind _kind, DebugData const* _debugData)
+	{
+		writeNumber(static_cast<uint8_t>(_kind));
+		writeDebugData(_debugData);
+	}
+
+	void writeIdentifier(Identifier const& _identifier)
+	{
+		writeDebugData(_identifier.debugData);
+		writeString(_identifier.name.str());
+	}
+
+	void writeLiteral(Literal const& _literal)
+	{
+		writeNumber(static_cast<uint8_t>(_literal.kind));
+		writeString(_literal.value.str());
+		writeString(_literal.type.str());
+	}
+
+	void writeTypedNames(TypedNameList const& _names)
+	{
+		writeNumber(_names.size());
+		for (TypedName const& name: _names)
+		{
+			writeDebugData(name.debugData);
+			writeString(name.name.str());
+			writeString(name.type.str());
+		}
+	}
+
+	/// Writes the index of @a _debugData in the debug data table plus one, or zero for null.
+	void writeDebugData(DebugData const* _debugData)
+	{
+		if (!_debugData)
+		{
+			writeNumber(0);
+			return;
+		}
+		auto [it, inserted] = m_debugDataIndices.try_emplace(_debugData, m_debugData.size());
+		if (inserted)
+			m_debugData.emplace_back(_debugData);
+		writeNumber(it->second + 1);
+	}
+
+	void writeLocation(bytes& _out, SourceLocation const& _location, int64_t& _previousStart)
+	{
+		_out += lebEncodeSigned(int64_t(_location.start) - _previousStart);
+		_out += lebEncodeSigned(int64_t(_location.end) - int64_t(_location.start));
+		_out += lebEncode(_location.sourceName ? stringIndex(*_location.sourceName) + 1 : 0);
+		_previousStart = _location.start;
+	}
+
+	void writeString(string const& _string) { writeNumber(stringIndex(_string)); }
+	void writeNumber(uint64_t _number) { m_nodes += lebEncode(_number); }
+
+	size_t stringIndex(string const& _string)
+	{
+		auto [it, inserted] = m_stringIndices.try_emplace(_string, m_strings.size());
+		if (inserted)
+			m_strings.emplace_back(&it->first);
+		return it->second;
+	}
+
+	bytes m_nodes;
+	/// Strings in the order of their indices. Points into the keys of m_stringIndices.
+	vector<string const*> m_strings;
+	unordered_map<string, size_t> m_stringIndices;
+	vector<DebugData const*> m_debugData;
+	unordered_map<DebugData const*, size_t> m_debugDataIndices;
+};
+
+/// Thrown by the reader if the data is malformed.
+struct MalformedData {};
+
+class Reader
+{
+public:
+	explicit Reader(bytesConstRef _data): m_data(_data) {}
+
+	shared_ptr<Object> run()
+	{
+		if (m_data.size() < magic.size() || !equal(magic.begin(), magic.end(), m_data.begin()))
+			throw MalformedData{};
+		m_position = magic.size();
+		if (readNumber() != ObjectSerialiser::version)
+			throw MalformedData{};
+
+		size_t stringCount = readCount();
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t length = readCount();
+			m_strings.emplace_back(asString(m_data.cropped(m_position, length)));
+			m_position += length;
+		}
+		m_yulStrings.resize(stringCount);
+		m_sourceNames.resize(stringCount);
+
+		size_t debugDataCount = readCount();
+		int64_t previousNativeStart = 0;
+		int64_t previousOriginStart = 0;
+		for (size_t i = 0; i < debugDataCount; ++i)
+		{
+			SourceLocation nativeLocation = readLocation(previousNativeStart);
+			SourceLocation originLocation = readLocation(previousOriginStart);
+			optional<int64_t> astID;
+			if (readFlag())
+				astID = readSigned();
+			m_debugData.emplace_back(DebugData::create(move(nativeLocation), move(originLocation), astID));
+		}
+
+		shared_ptr<Object> object = readObject();
+		if (m_position != m_data.size())
+			throw MalformedData{};
+		return object;
+	}
+
+private:
+	shared_ptr<Object> readObject()
+	{
+		DepthGuard guard{*this};
+		auto object = make_shared<Object>();
+		object->name = readYulString();
+		if (uint64_t subId = readNumber())
+			object->subId = static_cast<size_t>(subId - 1);
+
+		if (readFlag())
+			object->code = make_shared<Block>(readBlock());
+
+		if (readFlag())
+		{
+			SourceNameMap sourceNames;
+			size_t count = readCount();
+			for (size_t i = 0; i < count; ++i)
+			{
+				uint64_t index = readNumber();
+				if (index > numeric_limits<unsigned>::max())
+					throw MalformedData{};
+				sourceNames[static_cast<unsigned>(index)] = readSourceName(readNumber());
+			}
+			object->debugData = make_shared<ObjectDebugData>(ObjectDebugData{move(sourceNames)});
+		}
+
+		size_t subObjectCount = readCount();
+		for (size_t i = 0; i < subObjectCount; ++i)
+			switch (static_cast<ObjectNodeKind>(readNumber()))
+			{
+			case ObjectNodeKind::Object:
+				object->subObjects.emplace_back(readObject());
+				break;
+			case ObjectNodeKind::Data:
+			{
+				YulString name = readYulString();
+				size_t length = readCount();
+				bytesConstRef data = m_data.cropped(m_position, length);
+				m_position += length;
+				object->subObjects.emplace_back(make_shared<Data>(name, data.toBytes()));
+				break;
+			}
+			default:
+				throw MalformedData{};
+			}
+
+		size_t nameCount = readCount();
+		for (size_t i = 0; i < nameCount; ++i)
+		{
+			YulString name = readYulString();
+			uint64_t index = readNumber();
+			if (index >= object->subObjects.size())
+				throw MalformedData{};
+			object->subIndexByName[name] = static_cast<size_t>(index);
+		}
+		return object;
+	}
+
+	Expression readExpression()
+	{
+		DepthGuard guard{*this};
+		auto kind = static_cast<NodeKind>(readNumber());
+		DebugData const* debugData = readDebugData();
+		switch (kind)
+		{
+		case NodeKind::FunctionCall:
+		{
+			FunctionCall call{debugData, readIdentifier(), {}};
+			size_t count = readCount();
+			for (size_t i = 0; i < count; ++i)
+				call.arguments.emplace_back(readExpression());
+			return call;
+		}
+		case NodeKind::Identifier:
+			return Identifier{debugData, readYulString()};
+		case NodeKind::Literal:
+			return readLiteral(debugData);
+		default:
+			throw MalformedData{};
+		}
+	}
+
+	Statement readStatement()
+	{
+		DepthGuard guard{*this};
+		auto kind = static_cast<NodeKind>(readNumber());
+		DebugData const* debugData = readDebugData();
+		switch (kind)
+		{
+		case NodeKind::ExpressionStatement:
+			return ExpressionStatement{debugData, readExpression()};
+		case NodeKind::Assignment:
+		{
+			Assignment assignment{debugData, {}, {}};
+			size_t count = readCount();
+			for (size_t i = 0; i < count; ++i)
+				assignment.variableNames.emplace_back(readIdentifier());
+			assignment.value = make_unique<Expression>(readExpression());
+			return assignment;
+		}
+		case NodeKind::VariableDeclaration:
+		{
+			VariableDeclaration declaration{debugData, readTypedNames(), {}};
+			if (readFlag())
+				declaration.value = make_unique<Expression>(readExpression());
+			return declaration;
+		}
+		case NodeKind::FunctionDefinition:
+		{
+			FunctionDefinition function{debugData, readYulString(), {}, {}, {}};
+			function.parameters = readTypedNames();
+			function.returnVariables = readTypedNames();
+			function.body = readBlock();
+			return function;
+		}
+		case NodeKind::If:
+		{
+			If ifStatement{debugData, make_unique<Expression>(readExpression()), {}};
+			ifStatement.body = readBlock();
+			return ifStatement;
+		}
+		case NodeKind::Switch:
+		{
+			Switch switchStatement{debugData, make_unique<Expression>(readExpression()), {}};
+			size_t count = readCount();
+			for (size_t i = 0; i < count; ++i)
+			{
+				Case& switchCase = switchStatement.cases.emplace_back(Case{readDebugData(), {}, {}});
+				if (readFlag())
+				{
+					DebugData const* valueDebugData = readDebugData();
+					switchCase.value = make_unique<Literal>(readLiteral(valueDebugData));
+				}
+				switchCase.body = readBlock();
+			}
+			return switchStatement;
+		}
+		case NodeKind::ForLoop:
+		{
+			ForLoop loop{debugData, readBlock(), {}, {}, {}};
+			loop.condition = make_unique<Expression>(readExpression());
+			loop.post = readBlock();
+			loop.body = readBlock();
+			return loop;
+		}
+		case NodeKind::Break:
+			return Break{debugData};
+		case NodeKind::Continue:
+			return Continue{debugData};
+		case NodeKind::Leave:
+			return Leave{debugData};
+		case NodeKind::Block:
+			return readBlockContents(debugData);
+		default:
+			throw MalformedData{};
+		}
+	}
+
+	Block readBlock()
+	{
+		DepthGuard guard{*this};
+		if (static_cast<NodeKind>(readNumber()) != NodeKind::Block)
+			throw MalformedData{};
+		return readBlockContents(readDebugData());
+	}
+
+	Block readBlockContents(DebugData const* _debugData)
+	{
+		Block block{_debugData, {}};
+		size_t count = readCount();
+		block.statements.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			block.statements.emplace_back(readStatement());
+		return block;
+	}
+
+	Identifier readIdentifier()
+	{
+		DebugData const* debugData = readDebugData();
+		return Identifier{debugData, readYulString()};
+	}
+
+	Literal readLiteral(DebugData const* _debugData)
+	{
+		uint64_t kind = readNumber();
+		if (kind > static_cast<uint8_t>(LiteralKind::String))
+			throw MalformedData{};
+		YulString value = readYulString();
+		return Literal{_debugData, static_cast<LiteralKind>(kind), value, readYulString()};
+	}
+
+	TypedNameList readTypedNames()
+	{
+		TypedNameList names;
+		size_t count = readCount();
+		for (size_t i = 0; i < count; ++i)
+		{
+			DebugData const* debugData = readDebugData();
+			YulString name = readYulString();
+			names.emplace_back(TypedName{debugData, name, readYulString()});
+		}
+		return names;
+	}
+
+	DebugData const* readDebugData()
+	{
+		uint64_t index = readNumber();
+		if (index == 0)
+			return nullptr;
+		if (index > m_debugData.size())
+			throw MalformedData{};
+		return m_debugData[index - 1];
+	}
+
+	SourceLocation readLocation(int64_t& _previousStart)
+	{
+		int64_t start = _previousStart + readSigned();
+		int64_t end = start + readSigned();
+		if (
+			start < numeric_limits<int>::min() || start > numeric_limits<int>::max() ||
+			end < numeric_limits<int>::min() || end > numeric_limits<int>::max()
+		)
+			throw MalformedData{};
+		_previousStart = start;
+		uint64_t sourceName = readNumber();
+		return SourceLocation{
+			static_cast<int>(start),
+			static_cast<int>(end),
+			sourceName ? readSourceName(sourceName - 1) : nullptr
+		};
+	}
+
+	YulString readYulString()
+	{
+		uint64_t index = readNumber();
+		if (index >= m_strings.size())
+			throw MalformedData{};
+		if (!m_yulStrings[index])
+			m_yulStrings[index] = YulString{m_strings[index]};
+		return *m_yulStrings[index];
+	}
+
+	/// @returns the source name with index @a _index in the string table. All references to
+	/// the same name share one pointer.
+	string const* readSourceName(uint64_t _index)
+	{
+		if (_index >= m_strings.size())
+			throw MalformedData{};
+		if (!m_sourceNames[_index])
+			m_sourceNames[_index] = internSourceName(m_strings[_index]);
+		return m_sourceNames[_index];
+	}
+
+	bool readFlag()
+	{
+		uint64_t flag = readNumber();
+		if (flag > 1)
+			throw MalformedData{};
+		return flag == 1;
+	}
+
+	/// Reads a number of elements or bytes that follow, each of which takes at least one byte.
+	size_t readCount()
+	{
+		uint64_t count = readNumber();
+		if (count > m_data.size() - m_position)
+			throw MalformedData{};
+		return static_cast<size_t>(count);
+	}
+
+	uint64_t readNumber()
+	{
+		if (optional<uint64_t> number = lebDecode(m_data, m_position))
+			return *number;
+		throw MalformedData{};
+	}
+
+	int64_t readSigned()
+	{
+		if (optional<int64_t> number = lebDecodeSigned(m_data, m_position))
+			return *number;
+		throw MalformedData{};
+	}
+
+	/// Limits the nesting depth, so that malformed data cannot exhaust the stack.
+	struct DepthGuard
+	{
+		explicit DepthGuard(Reader& _reader): reader(_reader)
+		{
+			if (++reader.m_depth > 4096)
+				throw MalformedData{};
+		}
+		~DepthGuard() { --reader.m_depth; }
+		Reader& reader;
+	};
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	size_t m_depth = 0;
+	vector<string> m_strings;
+	vector<optional<YulString>> m_yulStrings;
+	vector<string const*> m_sourceNames;
+	vector<DebugData const*> m_debugData;
+};
+
+}
+
+bytes ObjectSerialiser::serialise(Object const& _object)
+{
+	return Writer{}.run(_object);
+}
+
+shared_ptr<Object> ObjectSerialiser::deserialise(bytesConstRef _data)
+{
+	try
+	{
+		return Reader{_data}.run();
+	}
+	catch (MalformedData const&)
+	{
+		return nullptr;
+	}
+}
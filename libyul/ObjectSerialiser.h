@@ -0,0 +1,54 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary encoding of Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <memory>
+
+namespace solidity::yul
+{
+struct Object;
+
+/**
+ * Encodes Yul objects, including their code, data, sub-objects and debug data, in a compact,
+ * versioned binary format, so that they can be cached or passed between processes without
+ * printing and re-parsing them. Analysis information is not stored, a decoded object has to be
+ * analyzed again before it is used, e.g. via YulStack::analyzeObject.
+ *
+ * The encoding starts with the magic bytes "YULB" and a version number. It is followed by a
+ * table of all strings (identifiers, literal values, types, source and object names) and a table
+ * of all distinct debug data, whose source locations are stored relative to the previous entry.
+ * Nodes refer to both tables by index. All numbers are LEB128 encoded.
+ */
+class ObjectSerialiser
+{
+public:
+	static uint64_t constexpr version = 1;
+
+	static bytes serialise(Object const& _object);
+	/// @returns the object encoded in @a _data or nullptr if the data is malformed
+	/// or was written by a different version.
+	static std::shared_ptr<Object> deserialise(bytesConstRef _data);
+};
+
+}
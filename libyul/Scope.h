@@ -28,7 +28,9 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -91,7 +93,9 @@ struct Scope
 	/// If true, variables from the super scope are not visible here (other identifiers are),
 	/// but they are still taken into account to prevent shadowing.
 	bool functionScope = false;
-	std::map<YulString, Identifier> identifiers;
+	/// Identifiers registered directly in this scope. The iteration order is unspecified.
+	/// References to the elements stay valid when further identifiers are registered.
+	std::unordered_map<YulString, Identifier> identifiers;
 };
 
 }
@@ -26,6 +26,7 @@
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
+#include <libyul/backends/evm/EVMAssemblyCache.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMObjectCompiler.h>
@@ -34,10 +35,15 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/OptimisedObjectCache.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
 #include <boost/algorithm/string.hpp>
 #include <optional>
 
@@ -72,7 +78,7 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 )
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0, 1, {}};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -81,10 +87,59 @@ evmasm::Assembly::OptimiserSettings translateOptimiserSettings(
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = _evmVersion;
+	asmSettings.experimentalOptimisations = _settings.experimentalOptimisations;
+	asmSettings.threads = OptimiserSuite::ParallelismActivation::threads();
 
 	return asmSettings;
 }
 
+/// @returns a description of all settings the optimised EVM assembly of an object depends on.
+string evmAssemblyCacheSettings(
+	YulStack::Language _language,
+	frontend::OptimiserSettings const& _settings,
+	EVMVersion _evmVersion
+)
+{
+	string experimental;
+	for (frontend::ExperimentalOptimisation optimisation: _settings.experimentalOptimisations)
+		experimental += " " + frontend::experimentalOptimisationToString(optimisation);
+	return
+		to_string(static_cast<int>(_language)) + " " +
+		_evmVersion.name() + " " +
+		(_settings.optimizeStackAllocation ? "stack " : "") +
+		(_settings.runInliner ? "i" : "") +
+		(_settings.runJumpdestRemover ? "j" : "") +
+		(_settings.runPeephole ? "p" : "") +
+		(_settings.runDeduplicate ? "d" : "") +
+		(_settings.runCSE ? "c" : "") +
+		(_settings.runConstantOptimiser ? "o" : "") + " " +
+		to_string(_settings.expectedExecutionsPerDeployment) +
+		experimental;
+}
+
+/// Stores the optimised assemblies of @a _object and all its sub-objects in @a _cache.
+void storeEVMAssemblies(
+	EVMAssemblyCache& _cache,
+	Object const& _object,
+	bool _creation,
+	shared_ptr<evmasm::Assembly> const& _assembly,
+	Dialect const& _dialect,
+	string const& _settings
+)
+{
+	_cache.store(EVMAssemblyCache::key(_object, _creation, _dialect, _settings), _assembly);
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			storeEVMAssemblies(
+				_cache,
+				*subObject,
+				!boost::ends_with(subObject->name.str(), "_deployed"),
+				_assembly->subPointer(subObject->subId),
+				_dialect,
+				_settings
+			);
+}
+
 }
 
 
@@ -110,6 +165,18 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
+bool YulStack::analyzeObject(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_charStream.reset();
+	m_parserResult = move(_object);
+
+	return analyzeParsed();
+}
+
 void YulStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -168,7 +235,7 @@ bool YulStack::analyzeParsed(Object& _object)
 	return success;
 }
 
-void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
+void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize, optional<string> _cacheSettings) const
 {
 	EVMDialect const* dialect = nullptr;
 	switch (m_language)
@@ -185,21 +252,85 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, std::move(_cacheSettings));
 }
 
 void YulStack::optimize(Object& _object, bool _isCreation)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
+	vector<Object*> subObjects;
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+			subObjects.emplace_back(subObject);
+
+	auto optimizeSubObject = [&](size_t _index)
+	{
+		bool isCreation = !boost::ends_with(subObjects[_index]->name.str(), "_deployed");
+		optimize(*subObjects[_index], isCreation);
+	};
+	// Sub-objects only refer to each other by name, so they can be optimised independently.
+	// The available threads are split between them.
+	size_t const threads = OptimiserSuite::ParallelismActivation::threads();
+	if (threads > 1 && subObjects.size() > 1)
+	{
+		OptimiserProfile* profile = OptimiserProfile::active();
+		OptimisedObjectCache* cache = OptimisedObjectCache::active();
+		size_t const threadsPerSubObject = max<size_t>(1, threads / subObjects.size());
+		util::parallelFor(subObjects.size(), threads, [&](size_t _index) {
+			OptimiserProfile::Activation profileActivation(profile);
+			OptimisedObjectCache::Activation cacheActivation(cache);
+			OptimiserSuite::ParallelismActivation parallelismActivation(threadsPerSubObject);
+			optimizeSubObject(_index);
+		});
+	}
+	else
+		for (size_t i = 0; i < subObjects.size(); ++i)
+			optimizeSubObject(i);
+
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+
+	// The result only depends on the object (whose sub-objects are already optimised),
+	// the dialect and the optimiser settings.
+	// Selectors in the profile only concern the dispatcher, the other entries are Yul functions
+	// of the runtime code.
+	map<YulString, size_t> functionExecutions;
+	string profileKey;
+	if (!_isCreation)
+		for (auto const& [name, executions]: m_optimiserSettings.executionProfile)
+			if (!boost::starts_with(name, "0x"))
+			{
+				functionExecutions[YulString{name}] = executions;
+				profileKey += name + "=" + to_string(executions) + ",";
+			}
+	for (frontend::ExperimentalOptimisation optimisation: m_optimiserSettings.experimentalOptimisations)
+		profileKey += " " + frontend::experimentalOptimisationToString(optimisation);
+
+	OptimisedObjectCache* cache = OptimisedObjectCache::active();
+	util::h256 cacheKey;
+	if (cache)
+	{
+		cacheKey = util::keccak256(
+			to_string(static_cast<int>(m_language)) + " " +
+			m_evmVersion.name() + " " +
+			(_isCreation ? "creation " : "runtime ") +
+			to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + " " +
+			(m_optimiserSettings.optimizeStackAllocation ? "stack " : "") +
+			m_optimiserSettings.yulOptimiserSteps + " " +
+			(m_optimiserSettings.yulOptimiserBudget ? to_string(*m_optimiserSettings.yulOptimiserBudget) : "") + " " +
+			profileKey + "\n" +
+			_object.toString(&dialect, DebugInfoSelection::All())
+		);
+		if (shared_ptr<Block const> code = cache->find(cacheKey))
 		{
-			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
+			_object.code = make_shared<Block>(std::get<Block>(ASTCopier{}(*code)));
+			_object.analysisInfo = make_shared<AsmAnalysisInfo>(
+				AsmAnalyzer::analyzeStrictAssertCorrect(dialect, _object)
+			);
+			return;
 		}
+	}
 
-	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -210,8 +341,14 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		m_optimiserSettings.optimizeStackAllocation,
 		m_optimiserSettings.yulOptimiserSteps,
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		m_optimiserSettings.yulOptimiserBudget,
+		std::move(functionExecutions),
+		m_optimiserSettings.experimentalOptimisations
 	);
+
+	if (cache)
+		cache->store(cacheKey, make_shared<Block const>(std::get<Block>(ASTCopier{}(*_object.code))));
 }
 
 MachineAssemblyObject YulStack::assemble(Machine _machine) const
@@ -284,11 +421,29 @@ YulStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	yulAssert(m_parserResult->code, "");
 	yulAssert(m_parserResult->analysisInfo, "");
 
-	evmasm::Assembly assembly(true, {});
-	EthAssemblyAdapter adapter(assembly);
-	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
+	// Contracts contain the objects of the contracts they create, their assemblies are only
+	// generated and optimised once per compilation.
+	EVMAssemblyCache* cache = EVMAssemblyCache::active();
+	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	string const cacheSettings = evmAssemblyCacheSettings(m_language, m_optimiserSettings, m_evmVersion);
+	shared_ptr<evmasm::Assembly> compiledAssembly;
+	if (cache)
+		compiledAssembly = cache->find(EVMAssemblyCache::key(*m_parserResult, true, dialect, cacheSettings));
+	if (!compiledAssembly)
+	{
+		compiledAssembly = make_shared<evmasm::Assembly>(true, string{});
+		EthAssemblyAdapter adapter(*compiledAssembly);
+		compileEVM(
+			adapter,
+			m_optimiserSettings.optimizeStackAllocation,
+			cache ? make_optional(cacheSettings) : nullopt
+		);
 
-	assembly.optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion));
+		compiledAssembly->optimise(translateOptimiserSettings(m_optimiserSettings, m_evmVersion));
+		if (cache)
+			storeEVMAssemblies(*cache, *m_parserResult, true, compiledAssembly, dialect, cacheSettings);
+	}
+	evmasm::Assembly const& assembly = *compiledAssembly;
 
 	optional<size_t> subIndex;
 
@@ -310,7 +465,7 @@ YulStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 
 	if (subIndex.has_value())
 	{
-		evmasm::Assembly& runtimeAssembly = assembly.sub(*subIndex);
+		evmasm::Assembly const& runtimeAssembly = assembly.sub(*subIndex);
 		return {make_shared<evmasm::Assembly>(assembly), make_shared<evmasm::Assembly>(runtimeAssembly)};
 	}
 
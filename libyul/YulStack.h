@@ -98,6 +98,13 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the analysis step on an object that has already been parsed, e.g. by another stack,
+	/// and continues to work on it. The object is not copied, so later steps modify it in place.
+	/// Since there is no source code, the char stream is not available afterwards.
+	/// Multiple calls overwrite the previous state.
+	/// @returns false if the object cannot be assembled.
+	bool analyzeObject(std::shared_ptr<Object> _object);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -140,7 +147,11 @@ private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
 
-	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
+	void compileEVM(
+		yul::AbstractAssembly& _assembly,
+		bool _optimize,
+		std::optional<std::string> _cacheSettings = std::nullopt
+	) const;
 
 	void optimize(yul::Object& _object, bool _isCreation);
 
@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+YulStringRepository::Table::Table(size_t _capacity):
+	slots(make_unique<atomic<Entry const*>[]>(_capacity)),
+	mask(_capacity - 1)
+{
+	yulAssert(_capacity > 0 && (_capacity & mask) == 0, "Capacity has to be a power of two.");
+	for (size_t i = 0; i < _capacity; ++i)
+		slots[i].store(nullptr, memory_order_relaxed);
+}
+
+void YulStringRepository::Table::add(Entry const& _entry)
+{
+	size_t index = _entry.hash & mask;
+	while (slots[index].load(memory_order_relaxed))
+		index = (index + 1) & mask;
+	// Publishes the completely constructed entry to readers.
+	slots[index].store(&_entry, memory_order_release);
+	++size;
+}
+
+YulStringRepository::YulStringRepository()
+{
+	m_tables.emplace_back(make_unique<Table>(InitialCapacity));
+	m_table.store(m_tables.back().get(), memory_order_release);
+}
+
+YulStringRepository::Entry const* YulStringRepository::insert(string const& _string, uint64_t _hash)
+{
+	lock_guard lock(m_mutex);
+	Table& table = *m_tables.back();
+	// Another thread might have added the string since we looked it up.
+	if (Entry const* entry = table.find(_string, _hash))
+		return entry;
+
+	Entry const& entry = m_entries.emplace_back(Entry{_string, _hash, m_entries.size() + 1});
+	// Keep the load factor below one half so that probe sequences stay short.
+	if (2 * (table.size + 1) > table.mask + 1)
+	{
+		auto newTable = make_unique<Table>(2 * (table.mask + 1));
+		for (Entry const& existingEntry: m_entries)
+			newTable->add(existingEntry);
+		m_tables.emplace_back(move(newTable));
+		m_table.store(m_tables.back().get(), memory_order_release);
+	}
+	else
+		table.add(entry);
+	return &entry;
+}
+
+void YulStringRepository::reset()
+{
+	for (auto const& cb: resetCallbacks())
+		cb();
+	YulStringRepository& repository = instance();
+	lock_guard lock(repository.m_mutex);
+	repository.m_entries.clear();
+	repository.m_tables.clear();
+	repository.m_tables.emplace_back(make_unique<Table>(InitialCapacity));
+	repository.m_table.store(repository.m_tables.back().get(), memory_order_release);
+}
+
+void YulStringRepository::resetIfLargerThan(size_t _maxStrings)
+{
+	if (largerThan(_maxStrings))
+		reset();
+}
+
+bool YulStringRepository::largerThan(size_t _maxStrings)
+{
+	if (size() > _maxStrings)
+		return true;
+	for (auto const& sizeCallback: sizeCallbacks())
+		if (sizeCallback() > _maxStrings)
+			return true;
+	return false;
+}
+
+size_t YulStringRepository::size()
+{
+	YulStringRepository& repository = instance();
+	lock_guard lock(repository.m_mutex);
+	return repository.m_entries.size();
+}
@@ -23,8 +23,11 @@
 
 #include <fmt/format.h>
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -34,14 +37,30 @@ namespace solidity::yul
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the entry of the string (whose value depends on the
+/// insertion order of YulStrings and is non-deterministic) and a deterministic string hash.
+///
+/// Entries are allocated in blocks and never moved or freed before ``reset()``.
+/// They are found through an open-addressing hash table that is read without locking,
+/// so looking up strings that are already present scales with the number of threads.
+/// Only inserting a new string takes a lock.
+/// The repository can be used from multiple threads concurrently, except for ``reset()``,
+/// which must only be called while no other thread is using YulStrings.
 class YulStringRepository
 {
 public:
+	struct Entry
+	{
+		std::string value;
+		std::uint64_t hash;
+		/// Position of the entry in insertion order, starting at one.
+		/// Ids are dense, so they can be used as indices into side tables.
+		std::size_t id;
+	};
 	struct Handle
 	{
-		size_t id;
+		/// Null for the empty string.
+		Entry const* entry;
 		std::uint64_t hash;
 	};
 
@@ -54,23 +73,17 @@ public:
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
+			return { nullptr, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		if (Entry const* entry = m_table.load(std::memory_order_acquire)->find(_string, h))
+			return Handle{entry, h};
+		return Handle{insert(_string, h), h};
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. Note that the hash determines the order of YulStrings
+		// and thus has to stay fixed for the generated code to be stable.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -85,41 +98,99 @@ public:
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
+	/// Calls ``reset()`` if the repository holds more than @a _maxStrings strings, or if the
+	/// data that is cleared together with it (see ``ResetCallback``) has more entries.
+	/// Processes that handle many inputs in a row can use this instead of ``reset()``
+	/// to keep the dialects, which are rebuilt after every reset, while still bounding
+	/// the memory usage. The same rules as for ``reset()`` apply.
+	static void resetIfLargerThan(size_t _maxStrings);
+	/// @returns true if ``resetIfLargerThan(_maxStrings)`` would reset the repository.
+	static bool largerThan(size_t _maxStrings);
+	/// @returns the number of strings in the repository.
+	static size_t size();
+	/// Default limit for ``resetIfLargerThan``.
+	static constexpr size_t MaxRetainedStrings = 100000;
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
+	/// The optional @a _size returns the number of entries of the data cleared by the callback,
+	/// which ``resetIfLargerThan()`` bounds in the same way as the number of strings.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
+		ResetCallback(std::function<void()> _fun, std::function<size_t()> _size = {})
 		{
+			std::lock_guard lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
+			if (_size)
+				YulStringRepository::sizeCallbacks().emplace_back(std::move(_size));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Hash table with linear probing. Slots are only ever filled, never cleared,
+	/// so readers can probe without locking. Once the table gets too full, it is
+	/// replaced by a larger copy, but kept alive for readers that still use it.
+	struct Table
+	{
+		explicit Table(size_t _capacity);
+
+		/// @returns the entry of @a _string with hash @a _hash if it is present in the table.
+		Entry const* find(std::string const& _string, std::uint64_t _hash) const
+		{
+			for (size_t index = _hash & mask;; index = (index + 1) & mask)
+			{
+				Entry const* entry = slots[index].load(std::memory_order_acquire);
+				if (!entry)
+					return nullptr;
+				if (entry->hash == _hash && entry->value == _string)
+					return entry;
+			}
+		}
+		/// Adds @a _entry to the table. Requires the repository lock to be held.
+		void add(Entry const& _entry);
+
+		std::unique_ptr<std::atomic<Entry const*>[]> slots;
+		size_t mask = 0;
+		size_t size = 0;
+	};
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	/// Adds @a _string unless another thread already did so.
+	/// @returns the entry of @a _string.
+	Entry const* insert(std::string const& _string, std::uint64_t _hash);
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::vector<std::function<size_t()>>& sizeCallbacks()
+	{
+		static std::vector<std::function<size_t()>> callbacks;
+		return callbacks;
+	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	static constexpr size_t InitialCapacity = 4096;
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// Protects all members apart from reads of the current table.
+	std::mutex m_mutex;
+	/// Entries of all strings. Elements of a deque are never moved when appending.
+	std::deque<Entry> m_entries;
+	/// All tables created since the last reset, the last one is the current table.
+	std::vector<std::unique_ptr<Table>> m_tables;
+	std::atomic<Table const*> m_table{nullptr};
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing their entries.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -134,32 +205,36 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical entries (only identical strings have
+	/// identical entries and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.entry == _other.m_handle.entry) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the string entry.
+	bool operator==(YulString const& _other) const { return m_handle.entry == _other.m_handle.entry; }
+	bool operator!=(YulString const& _other) const { return m_handle.entry != _other.m_handle.entry; }
 
-	bool empty() const { return m_handle.id == 0; }
+	bool empty() const { return !m_handle.entry; }
 	std::string const& str() const
 	{
-		return YulStringRepository::instance().idToString(m_handle.id);
+		static std::string const emptyString;
+		return m_handle.entry ? m_handle.entry->value : emptyString;
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
+	/// @returns a small integer that identifies the string until the next reset of the repository.
+	/// Distinct strings have distinct ids and the empty string has id zero.
+	std::size_t id() const { return m_handle.entry ? m_handle.entry->id : 0; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. The empty string does not have an entry.
+	YulStringRepository::Handle m_handle{ nullptr, YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
@@ -27,6 +27,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
 #include <libsolutil/Numeric.h>
 
 #include <functional>
@@ -99,6 +100,9 @@ public:
 	virtual void appendAssemblySize() = 0;
 	/// Creates a new sub-assembly, which can be referenced using dataSize and dataOffset.
 	virtual std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(bool _creation, std::string _name = "") = 0;
+	/// Adds the sub-assembly stored for @a _key in the active EVMAssemblyCache instead of creating a new one.
+	/// @returns its ID or nullopt if there is no such sub-assembly.
+	virtual std::optional<SubID> appendCachedSubAssembly(util::h256 const& _key) = 0;
 	/// Appends the offset of the given sub-assembly or data.
 	virtual void appendDataOffset(std::vector<SubID> const& _subPath) = 0;
 	/// Appends the size of the given sub-assembly or data.
@@ -23,6 +23,8 @@
 
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
+#include <libyul/backends/evm/NoOutputAssembly.h>
+#include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
 #include <libyul/AST.h>
 #include <libyul/AsmAnalysisInfo.h>
 
@@ -39,10 +41,11 @@ void CodeGenerator::assemble(
 	langutil::EVMVersion _evmVersion,
 	ExternalIdentifierAccess::CodeGenerator _identifierAccessCodeGen,
 	bool _useNamedLabelsForFunctions,
-	bool _optimizeStackAllocation
+	bool _optimizeStackAllocation,
+	optional<SourceLocation> _sourceLocationOverride
 )
 {
-	EthAssemblyAdapter assemblyAdapter(_assembly);
+	EthAssemblyAdapter assemblyAdapter(_assembly, std::move(_sourceLocationOverride));
 	BuiltinContext builtinContext;
 	CodeTransform transform(
 		assemblyAdapter,
@@ -65,3 +68,41 @@ void CodeGenerator::assemble(
 			(transform.stackErrors().front().comment() ? ": " + *transform.stackErrors().front().comment() : ".")
 		);
 }
+
+bool CodeGenerator::assembleOptimized(
+	Block const& _parsedData,
+	AsmAnalysisInfo& _analysisInfo,
+	evmasm::Assembly& _assembly,
+	langutil::EVMVersion _evmVersion,
+	optional<SourceLocation> _sourceLocationOverride
+)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(_evmVersion);
+	auto generate = [&](AbstractAssembly& _target) {
+		BuiltinContext builtinContext;
+		return OptimizedEVMCodeTransform::run(
+			_target,
+			_analysisInfo,
+			_parsedData,
+			dialect,
+			builtinContext,
+			OptimizedEVMCodeTransform::UseNamedLabels::Never,
+			true
+		);
+	};
+
+	// Stack errors are only reported after code was generated, so check for them in a dry run first.
+	NoOutputAssembly dryRun;
+	if (!generate(dryRun).empty())
+		return false;
+
+	EthAssemblyAdapter assemblyAdapter(_assembly, std::move(_sourceLocationOverride));
+	int const startStackHeight = assemblyAdapter.stackHeight();
+	// The transform keeps track of the whole stack, which only consists of the slots of the code itself.
+	assemblyAdapter.setStackHeight(0);
+	vector<StackTooDeepError> stackErrors = generate(assemblyAdapter);
+	yulAssert(stackErrors.empty(), "");
+	yulAssert(assemblyAdapter.stackHeight() == 0, "");
+	assemblyAdapter.setStackHeight(startStackHeight);
+	return true;
+}
@@ -24,6 +24,9 @@
 #include <libyul/backends/evm/AbstractAssembly.h>
 #include <libyul/AsmAnalysis.h>
 #include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -39,6 +42,7 @@ class CodeGenerator
 {
 public:
 	/// Performs code generation and appends generated to _assembly.
+	/// If @a _sourceLocationOverride is set, it is used instead of the source locations of the code.
 	static void assemble(
 		Block const& _parsedData,
 		AsmAnalysisInfo& _analysisInfo,
@@ -46,7 +50,20 @@ public:
 		langutil::EVMVersion _evmVersion,
 		ExternalIdentifierAccess::CodeGenerator _identifierAccess = {},
 		bool _useNamedLabelsForFunctions = false,
-		bool _optimizeStackAllocation = false
+		bool _optimizeStackAllocation = false,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
+	);
+	/// Performs code generation via the optimized code transform, which schedules the stack based on the
+	/// control flow graph of the code, and appends it to @a _assembly. The code must not access any
+	/// identifiers from outside. It continues after the appended code with the stack height it started with.
+	/// @returns false and leaves @a _assembly unchanged if the code cannot be generated without
+	/// stack too deep errors.
+	static bool assembleOptimized(
+		Block const& _parsedData,
+		AsmAnalysisInfo& _analysisInfo,
+		evmasm::Assembly& _assembly,
+		langutil::EVMVersion _evmVersion,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
 	);
 };
 }
@@ -0,0 +1,345 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::evmasm;
+
+ControlFlowGasEstimator::ControlFlowGasEstimator(CFG const& _cfg, EVMDialect const& _dialect):
+	m_cfg(_cfg),
+	m_dialect(_dialect)
+{
+	for (CFG::BasicBlock const& block: m_cfg.blocks)
+		if (auto const* jump = get_if<CFG::BasicBlock::Jump>(&block.exit))
+			if (jump->backwards)
+				m_loopHeads.insert(jump->target);
+}
+
+ControlFlowGasEstimator::Estimate ControlFlowGasEstimator::run()
+{
+	yulAssert(m_cfg.entry, "");
+	m_selectors = nullptr;
+	optional<Estimate> estimate = blockEstimate(*m_cfg.entry, false);
+	yulAssert(estimate, "");
+	return *estimate;
+}
+
+optional<ControlFlowGasEstimator::Estimate> ControlFlowGasEstimator::run(
+	u256 const& _selector,
+	set<u256> const& _selectors
+)
+{
+	yulAssert(m_cfg.entry, "");
+	m_selector = _selector;
+	m_selectors = &_selectors;
+	m_searchEstimates.clear();
+	optional<Estimate> estimate = blockEstimate(*m_cfg.entry, true);
+	m_selectors = nullptr;
+	return estimate;
+}
+
+optional<ControlFlowGasEstimator::Estimate> ControlFlowGasEstimator::blockEstimate(
+	CFG::BasicBlock const& _block,
+	bool _searching
+)
+{
+	if (_searching)
+	{
+		if (auto const* estimate = util::valueOrNullptr(m_searchEstimates, &_block))
+			return *estimate;
+	}
+	else if (auto const* estimate = util::valueOrNullptr(m_blockEstimates, &_block))
+		return *estimate;
+
+	// Cycles are only closed by backwards jumps, which do not recurse. This only guards against
+	// control flow the builder does not generate.
+	if (!m_blocksInProgress.insert(&_block).second)
+		return Estimate{0, 0, nullopt, true, false};
+	optional<Estimate> estimate = computeBlockEstimate(_block, _searching);
+	m_blocksInProgress.erase(&_block);
+
+	if (_searching)
+		m_searchEstimates[&_block] = estimate;
+	else
+	{
+		yulAssert(estimate, "");
+		m_blockEstimates[&_block] = *estimate;
+	}
+	return estimate;
+}
+
+optional<ControlFlowGasEstimator::Estimate> ControlFlowGasEstimator::computeBlockEstimate(
+	CFG::BasicBlock const& _block,
+	bool _searching
+)
+{
+	Estimate operations = operationsEstimate(_block);
+	auto jumpEstimate = [&](Instruction _jump) {
+		bigint costs =
+			instructionCosts(Instruction::PUSH1) +
+			instructionCosts(_jump) +
+			instructionCosts(Instruction::JUMPDEST);
+		return Estimate{costs, costs, costs};
+	};
+
+	return std::visit(util::GenericVisitor{
+		[&](CFG::BasicBlock::MainExit const&) -> optional<Estimate>
+		{
+			if (_searching)
+				return nullopt;
+			return operations;
+		},
+		[&](CFG::BasicBlock::FunctionReturn const&) -> optional<Estimate>
+		{
+			if (_searching)
+				return nullopt;
+			return operations;
+		},
+		[&](CFG::BasicBlock::Terminated const&) -> optional<Estimate>
+		{
+			if (_searching)
+				return nullopt;
+			if (!_block.operations.empty())
+				if (auto const* call = get_if<CFG::BuiltinCall>(&_block.operations.back().operation))
+					if (auto const* builtin = m_dialect.builtin(call->functionCall.get().functionName.name))
+						if (builtin->instruction == Instruction::REVERT || builtin->instruction == Instruction::INVALID)
+							operations.succeeds = false;
+			return operations;
+		},
+		[&](CFG::BasicBlock::Jump const& _jump) -> optional<Estimate>
+		{
+			if (!_jump.backwards)
+			{
+				optional<Estimate> target = blockEstimate(*_jump.target, _searching);
+				if (!target)
+					return nullopt;
+				return sequence(operations, *target);
+			}
+			if (_searching)
+				return nullopt;
+			// Loops without condition can only be left via ``break``, ``leave`` or termination,
+			// which is accounted for at the respective branch.
+			Estimate loopExit{0, 0, nullopt, true, false};
+			if (auto const* exit = util::valueOrNullptr(m_loopExitEstimates, _jump.target))
+				loopExit = *exit;
+			loopExit.max = nullopt;
+			loopExit.loops = true;
+			return sequence(sequence(operations, jumpEstimate(Instruction::JUMP)), loopExit);
+		},
+		[&](CFG::BasicBlock::ConditionalJump const& _jump) -> optional<Estimate>
+		{
+			operations = sequence(operations, jumpEstimate(Instruction::JUMPI));
+			optional<Estimate> estimate;
+			if (optional<bool> selected = _searching ? dispatcherCondition(_jump.condition) : nullopt)
+				estimate = *selected ? blockEstimate(*_jump.nonZero, false) : blockEstimate(*_jump.zero, true);
+			else if (m_loopHeads.count(&_block))
+			{
+				// The zero branch leaves the loop and is needed by the backwards jump at the end of its body.
+				optional<Estimate> zero = blockEstimate(*_jump.zero, _searching);
+				if (zero && !_searching)
+					m_loopExitEstimates[&_block] = sequence(operations, *zero);
+				optional<Estimate> nonZero = blockEstimate(*_jump.nonZero, _searching);
+				estimate = either(zero, nonZero);
+				// Typically, the body is executed once.
+				if (estimate && nonZero && nonZero->succeeds)
+					estimate->typical = nonZero->typical;
+			}
+			else
+				estimate = either(blockEstimate(*_jump.zero, _searching), blockEstimate(*_jump.nonZero, _searching));
+			if (!estimate)
+				return nullopt;
+			return sequence(operations, *estimate);
+		}
+	}, _block.exit);
+}
+
+ControlFlowGasEstimator::Estimate ControlFlowGasEstimator::operationsEstimate(CFG::BasicBlock const& _block)
+{
+	Estimate estimate;
+	for (CFG::Operation const& operation: _block.operations)
+	{
+		// Arguments that are not the results of previous operations are pushed or duplicated.
+		for (StackSlot const& slot: operation.input)
+			if (holds_alternative<LiteralSlot>(slot) || holds_alternative<VariableSlot>(slot))
+				estimate = sequence(estimate, instructionEstimate(Instruction::DUP1));
+		estimate = sequence(estimate, std::visit(util::GenericVisitor{
+			[&](CFG::BuiltinCall const& _call)
+			{
+				BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_call.functionCall.get().functionName.name);
+				yulAssert(builtin, "");
+				if (builtin->instruction)
+					return instructionEstimate(*builtin->instruction);
+				// Builtins like ``datasize`` are replaced by a value.
+				return instructionEstimate(Instruction::PUSH1);
+			},
+			[&](CFG::FunctionCall const& _call)
+			{
+				bigint callCosts = GasMeterVisitor::functionCallCosts(m_dialect, false).first;
+				return sequence(Estimate{callCosts, callCosts, callCosts}, functionEstimate(_call.function));
+			},
+			[&](CFG::Assignment const&)
+			{
+				return Estimate{};
+			}
+		}, operation.operation));
+	}
+	return estimate;
+}
+
+ControlFlowGasEstimator::Estimate ControlFlowGasEstimator::functionEstimate(Scope::Function const& _function)
+{
+	if (auto const* estimate = util::valueOrNullptr(m_functionEstimates, &_function))
+		return *estimate;
+	// Recursion is treated like a loop that is not executed.
+	if (!m_functionsInProgress.insert(&_function).second)
+		return Estimate{0, 0, nullopt, true, true};
+
+	CFG::FunctionInfo const& info = m_cfg.functionInfo.at(&_function);
+	yulAssert(info.entry, "");
+	optional<Estimate> estimate = blockEstimate(*info.entry, false);
+	yulAssert(estimate, "");
+	m_functionsInProgress.erase(&_function);
+	return m_functionEstimates[&_function] = *estimate;
+}
+
+ControlFlowGasEstimator::Estimate ControlFlowGasEstimator::instructionEstimate(Instruction _instruction) const
+{
+	langutil::EVMVersion const evmVersion = m_dialect.evmVersion();
+	switch (_instruction)
+	{
+	case Instruction::SLOAD:
+		return Estimate{
+			evmVersion >= langutil::EVMVersion::berlin() ? GasCosts::warmStorageReadCost : GasCosts::sloadGas(evmVersion),
+			GasCosts::sloadGas(evmVersion),
+			bigint(GasCosts::sloadGas(evmVersion))
+		};
+	case Instruction::SSTORE:
+		return Estimate{
+			GasCosts::totalSstoreResetGas(evmVersion),
+			GasCosts::totalSstoreResetGas(evmVersion),
+			bigint(GasCosts::totalSstoreSetGas(evmVersion))
+		};
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+	{
+		bigint costs = GasCosts::logGas + GasCosts::logTopicGas * getLogNumber(_instruction);
+		return Estimate{costs, costs, costs};
+	}
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		// The gas forwarded to the callee is not bounded.
+		return Estimate{GasCosts::callGas(evmVersion), GasCosts::callGas(evmVersion), nullopt};
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return Estimate{GasCosts::createGas, GasCosts::createGas, nullopt};
+	case Instruction::SELFDESTRUCT:
+	{
+		bigint costs = GasCosts::selfdestructGas(evmVersion);
+		return Estimate{costs, costs, costs};
+	}
+	default:
+	{
+		bigint costs = instructionCosts(_instruction);
+		return Estimate{costs, costs, costs};
+	}
+	}
+}
+
+bigint ControlFlowGasEstimator::instructionCosts(Instruction _instruction) const
+{
+	return GasMeterVisitor::instructionCosts(_instruction, m_dialect).first;
+}
+
+optional<bool> ControlFlowGasEstimator::dispatcherCondition(StackSlot const& _condition) const
+{
+	auto const* temporary = get_if<TemporarySlot>(&_condition);
+	if (!m_selectors || !temporary)
+		return nullopt;
+	yul::FunctionCall const& call = temporary->call;
+	if (call.functionName.name != "eq"_yulstring || call.arguments.size() != 2)
+		return nullopt;
+	for (Expression const& argument: call.arguments)
+		if (auto const* literal = get_if<Literal>(&argument))
+		{
+			u256 value = valueOfLiteral(*literal);
+			if (m_selectors->count(value))
+				return value == m_selector;
+		}
+	return nullopt;
+}
+
+ControlFlowGasEstimator::Estimate ControlFlowGasEstimator::sequence(Estimate _first, Estimate const& _second)
+{
+	_first.min += _second.min;
+	_first.typical += _second.typical;
+	if (_first.max && _second.max)
+		*_first.max += *_second.max;
+	else
+		_first.max = nullopt;
+	_first.loops = _first.loops || _second.loops;
+	_first.succeeds = _first.succeeds && _second.succeeds;
+	return _first;
+}
+
+optional<ControlFlowGasEstimator::Estimate> ControlFlowGasEstimator::either(
+	optional<Estimate> _first,
+	optional<Estimate> _second
+)
+{
+	if (!_first || !_second)
+		return _first ? _first : _second;
+
+	Estimate result;
+	if (_first->succeeds == _second->succeeds)
+	{
+		result.min = std::min(_first->min, _second->min);
+		result.typical = (_first->typical + _second->typical) / 2;
+	}
+	else
+	{
+		Estimate const& succeeding = _first->succeeds ? *_first : *_second;
+		result.min = succeeding.min;
+		result.typical = succeeding.typical;
+	}
+	if (_first->max && _second->max)
+		result.max = std::max(*_first->max, *_second->max);
+	else
+		result.max = nullopt;
+	result.loops = _first->loops || _second->loops;
+	result.succeeds = _first->succeeds || _second->succeeds;
+	return result;
+}
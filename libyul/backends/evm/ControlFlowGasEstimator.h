@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Static gas estimation on the control flow graph of Yul code.
+ */
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * Estimates the gas costs of running Yul code on its control flow graph.
+ *
+ * Every basic block and function is only visited once per estimate, the costs from a block
+ * to the end of the code are reused for all paths through it. The costs of the instructions
+ * are static: memory expansion, copies and the gas forwarded by calls are not taken into account,
+ * storage slots are assumed to be cold and stack shuffling is not modelled.
+ *
+ * Loops are assumed to be executed once for the typical costs and make the maximum unbounded.
+ * Paths that end in ``revert`` or ``invalid`` are ignored for the minimum and typical costs,
+ * unless all paths do.
+ */
+class ControlFlowGasEstimator
+{
+public:
+	struct Estimate
+	{
+		/// Costs of the cheapest path.
+		bigint min = 0;
+		/// Costs of a path that executes every loop once and averages over branches.
+		bigint typical = 0;
+		/// Upper bound of the costs or nullopt if there is none.
+		std::optional<bigint> max = 0;
+		/// True if there is a loop or recursion on some path.
+		bool loops = false;
+		/// True if there is a path that does not end in ``revert`` or ``invalid``.
+		bool succeeds = true;
+	};
+
+	ControlFlowGasEstimator(CFG const& _cfg, EVMDialect const& _dialect);
+
+	/// @returns the estimate for running the code from its entry.
+	Estimate run();
+	/// @returns the estimate for running the code on a call that selects the function with
+	/// the selector @a _selector, or nullopt if the dispatcher does not handle it.
+	/// @a _selectors are the selectors of all functions of the contract. A comparison of
+	/// a value with one of them is considered to be part of the dispatcher and only the
+	/// branch that matches @a _selector is followed until the function is entered.
+	std::optional<Estimate> run(u256 const& _selector, std::set<u256> const& _selectors);
+
+private:
+	/// @returns the estimate from the start of @a _block to the end of the code or function.
+	/// If @a _searching is true, only paths through the dispatcher case of m_selector are considered.
+	std::optional<Estimate> blockEstimate(CFG::BasicBlock const& _block, bool _searching);
+	std::optional<Estimate> computeBlockEstimate(CFG::BasicBlock const& _block, bool _searching);
+	/// @returns the costs of the operations of @a _block.
+	Estimate operationsEstimate(CFG::BasicBlock const& _block);
+	Estimate functionEstimate(Scope::Function const& _function);
+	Estimate instructionEstimate(evmasm::Instruction _instruction) const;
+	bigint instructionCosts(evmasm::Instruction _instruction) const;
+	/// @returns whether branching on @a _condition is part of the dispatcher and if so, whether
+	/// it compares against m_selector.
+	std::optional<bool> dispatcherCondition(StackSlot const& _condition) const;
+
+	/// @returns the estimate of running @a _first and then @a _second.
+	static Estimate sequence(Estimate _first, Estimate const& _second);
+	/// @returns the estimate of running either @a _first or @a _second.
+	static std::optional<Estimate> either(std::optional<Estimate> _first, std::optional<Estimate> _second);
+
+	CFG const& m_cfg;
+	EVMDialect const& m_dialect;
+	/// Targets of backwards jumps, i.e. loop heads.
+	std::set<CFG::BasicBlock const*> m_loopHeads;
+
+	std::map<CFG::BasicBlock const*, Estimate> m_blockEstimates;
+	std::set<CFG::BasicBlock const*> m_blocksInProgress;
+	/// Estimates from the start of loop heads for the paths that leave the loop.
+	std::map<CFG::BasicBlock const*, Estimate> m_loopExitEstimates;
+	std::map<Scope::Function const*, Estimate> m_functionEstimates;
+	std::set<Scope::Function const*> m_functionsInProgress;
+
+	/// State of the current run with a selector, reset for every run.
+	u256 m_selector;
+	std::set<u256> const* m_selectors = nullptr;
+	std::map<CFG::BasicBlock const*, std::optional<Estimate>> m_searchEstimates;
+};
+
+}
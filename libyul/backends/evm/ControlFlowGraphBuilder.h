@@ -65,13 +65,13 @@ private:
 	Scope::Variable const& lookupVariable(YulString _name) const;
 	/// Resets m_currentBlock to enforce a subsequent explicit reassignment.
 	void makeConditionalJump(
-		std::shared_ptr<DebugData const> _debugData,
+		DebugData const* _debugData,
 		StackSlot _condition,
 		CFG::BasicBlock& _nonZero,
 		CFG::BasicBlock& _zero
 	);
 	void jump(
-		std::shared_ptr<DebugData const> _debugData,
+		DebugData const* _debugData,
 		CFG::BasicBlock& _target,
 		bool _backwards = false
 	);
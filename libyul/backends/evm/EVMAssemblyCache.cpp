@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the optimised EVM assemblies of Yul objects.
+ */
+
+#include <libyul/backends/evm/EVMAssemblyCache.h>
+
+#include <libyul/Object.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+thread_local EVMAssemblyCache* t_activeCache = nullptr;
+
+}
+
+util::h256 EVMAssemblyCache::key(Object const& _object, bool _creation, Dialect const& _dialect, string const& _settings)
+{
+	return util::keccak256(
+		_settings + " " +
+		(_creation ? "creation" : "runtime") + "\n" +
+		_object.toString(&_dialect, langutil::DebugInfoSelection::All())
+	);
+}
+
+shared_ptr<evmasm::Assembly> EVMAssemblyCache::find(util::h256 const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_assemblies.find(_key);
+	return it != m_assemblies.end() ? it->second : nullptr;
+}
+
+void EVMAssemblyCache::store(util::h256 const& _key, shared_ptr<evmasm::Assembly> _assembly)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_assemblies.emplace(_key, std::move(_assembly));
+}
+
+size_t EVMAssemblyCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_assemblies.size();
+}
+
+EVMAssemblyCache* EVMAssemblyCache::active()
+{
+	return t_activeCache;
+}
+
+EVMAssemblyCache::Activation::Activation(EVMAssemblyCache* _cache):
+	m_previousCache(t_activeCache)
+{
+	t_activeCache = _cache;
+}
+
+EVMAssemblyCache::Activation::~Activation()
+{
+	t_activeCache = m_previousCache;
+}
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the optimised EVM assemblies of Yul objects.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace solidity::evmasm
+{
+class Assembly;
+}
+
+namespace solidity::yul
+{
+struct Dialect;
+struct Object;
+
+/**
+ * Optimised EVM assemblies of Yul objects, keyed by a hash of the object (including its
+ * sub-objects and the debug information it prints) and of the code generator and
+ * optimiser settings.
+ *
+ * A contract that creates other contracts contains their objects, so without the cache, their
+ * code would be generated and optimised once for every contract that contains them and once
+ * for themselves. The EVM object compiler instead adds the assembly stored in the cache activated
+ * for the current thread as a sub-assembly, which is shared between all its users.
+ *
+ * Only assemblies whose optimisation is finished are stored, so users do not modify them
+ * until they are assembled. Access is thread-safe.
+ */
+class EVMAssemblyCache
+{
+public:
+	/// @returns the key of the creation or runtime assembly of @a _object, which is generated
+	/// and optimised with settings described by @a _settings.
+	static util::h256 key(Object const& _object, bool _creation, Dialect const& _dialect, std::string const& _settings);
+
+	/// @returns the assembly stored for @a _key or nullptr if there is none.
+	std::shared_ptr<evmasm::Assembly> find(util::h256 const& _key) const;
+	/// Stores @a _assembly for @a _key unless there already is an assembly for it.
+	void store(util::h256 const& _key, std::shared_ptr<evmasm::Assembly> _assembly);
+	size_t size() const;
+
+	/// @returns the cache activated for the current thread or nullptr.
+	static EVMAssemblyCache* active();
+
+	/// Activates a cache (which can be nullptr) for the current thread until destruction.
+	class Activation
+	{
+	public:
+		explicit Activation(EVMAssemblyCache* _cache);
+		~Activation();
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		EVMAssemblyCache* m_previousCache = nullptr;
+	};
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<evmasm::Assembly>> m_assemblies;
+};
+
+}
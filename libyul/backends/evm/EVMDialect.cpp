@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std;
@@ -46,40 +47,82 @@ using namespace solidity::util;
 namespace
 {
 
-pair<YulString, BuiltinFunctionForEVM> createEVMFunction(
-	string const& _name,
-	evmasm::Instruction _instruction
-)
+/// Properties of an instruction as a builtin function. They neither depend on the EVM version
+/// nor on the YulString repository, so they are computed only once per process and reused
+/// whenever a dialect is created, e.g. after ``YulStringRepository::reset()``.
+struct InstructionBuiltin
 {
-	evmasm::InstructionInfo info = evmasm::instructionInfo(_instruction);
-	BuiltinFunctionForEVM f;
-	f.name = YulString{_name};
-	f.parameters.resize(static_cast<size_t>(info.args));
-	f.returns.resize(static_cast<size_t>(info.ret));
-	f.sideEffects = EVMDialect::sideEffectsOfInstruction(_instruction);
-	if (evmasm::SemanticInformation::terminatesControlFlow(_instruction))
+	std::string name;
+	evmasm::Instruction instruction;
+	size_t parameters;
+	size_t returns;
+	SideEffects sideEffects;
+	ControlFlowSideEffects controlFlowSideEffects;
+	/// False for the instructions that are only reserved identifiers, like ``jump`` or ``dup1``.
+	bool isBuiltin;
+};
+
+vector<InstructionBuiltin> const& instructionBuiltins()
+{
+	static vector<InstructionBuiltin> const builtins = []
 	{
-		f.controlFlowSideEffects.canContinue = false;
-		if (evmasm::SemanticInformation::reverts(_instruction))
+		vector<InstructionBuiltin> result;
+		for (auto const& [name, instruction]: evmasm::c_instructions)
 		{
-			f.controlFlowSideEffects.canTerminate = false;
-			f.controlFlowSideEffects.canRevert = true;
-		}
-		else
-		{
-			f.controlFlowSideEffects.canTerminate = true;
-			f.controlFlowSideEffects.canRevert = false;
+			evmasm::InstructionInfo const& info = evmasm::instructionInfo(instruction);
+			InstructionBuiltin builtin{
+				toLower(name),
+				instruction,
+				static_cast<size_t>(info.args),
+				static_cast<size_t>(info.ret),
+				EVMDialect::sideEffectsOfInstruction(instruction),
+				{},
+				!evmasm::isDupInstruction(instruction) &&
+				!evmasm::isSwapInstruction(instruction) &&
+				!evmasm::isPushInstruction(instruction) &&
+				instruction != evmasm::Instruction::JUMP &&
+				instruction != evmasm::Instruction::JUMPI &&
+				instruction != evmasm::Instruction::JUMPDEST
+			};
+			if (evmasm::SemanticInformation::terminatesControlFlow(instruction))
+			{
+				builtin.controlFlowSideEffects.canContinue = false;
+				if (evmasm::SemanticInformation::reverts(instruction))
+				{
+					builtin.controlFlowSideEffects.canTerminate = false;
+					builtin.controlFlowSideEffects.canRevert = true;
+				}
+				else
+				{
+					builtin.controlFlowSideEffects.canTerminate = true;
+					builtin.controlFlowSideEffects.canRevert = false;
+				}
+			}
+			result.emplace_back(move(builtin));
 		}
-	}
-	f.isMSize = _instruction == evmasm::Instruction::MSIZE;
+		return result;
+	}();
+	return builtins;
+}
+
+pair<YulString, BuiltinFunctionForEVM> createEVMFunction(InstructionBuiltin const& _builtin)
+{
+	evmasm::Instruction const instruction = _builtin.instruction;
+	BuiltinFunctionForEVM f;
+	f.name = YulString{_builtin.name};
+	f.parameters.resize(_builtin.parameters);
+	f.returns.resize(_builtin.returns);
+	f.sideEffects = _builtin.sideEffects;
+	f.controlFlowSideEffects = _builtin.controlFlowSideEffects;
+	f.isMSize = instruction == evmasm::Instruction::MSIZE;
 	f.literalArguments.clear();
-	f.instruction = _instruction;
-	f.generateCode = [_instruction](
+	f.instruction = instruction;
+	f.generateCode = [instruction](
 		FunctionCall const&,
 		AbstractAssembly& _assembly,
 		BuiltinContext&
 	) {
-		_assembly.appendInstruction(_instruction);
+		_assembly.appendInstruction(instruction);
 	};
 
 	return {f.name, move(f)};
@@ -119,12 +162,9 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 	};
 
 	set<YulString> reserved;
-	for (auto const& instr: evmasm::c_instructions)
-	{
-		string name = toLower(instr.first);
-		if (!baseFeeException(instr.second))
-			reserved.emplace(name);
-	}
+	for (InstructionBuiltin const& builtin: instructionBuiltins())
+		if (!baseFeeException(builtin.instruction))
+			reserved.emplace(builtin.name);
 	reserved += vector<YulString>{
 		"linkersymbol"_yulstring,
 		"datasize"_yulstring,
@@ -139,22 +179,9 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVersion, bool _objectAccess)
 {
 	map<YulString, BuiltinFunctionForEVM> builtins;
-	for (auto const& instr: evmasm::c_instructions)
-	{
-		string name = toLower(instr.first);
-		auto const opcode = instr.second;
-
-		if (
-			!evmasm::isDupInstruction(opcode) &&
-			!evmasm::isSwapInstruction(opcode) &&
-			!evmasm::isPushInstruction(opcode) &&
-			opcode != evmasm::Instruction::JUMP &&
-			opcode != evmasm::Instruction::JUMPI &&
-			opcode != evmasm::Instruction::JUMPDEST &&
-			_evmVersion.hasOpcode(opcode)
-		)
-			builtins.emplace(createEVMFunction(name, opcode));
-	}
+	for (InstructionBuiltin const& builtin: instructionBuiltins())
+		if (builtin.isBuiltin && _evmVersion.hasOpcode(builtin.instruction))
+			builtins.emplace(createEVMFunction(builtin));
 
 	if (_objectAccess)
 	{
@@ -292,35 +319,38 @@ EVMDialect::EVMDialect(langutil::EVMVersion _evmVersion, bool _objectAccess):
 	m_functions(createBuiltins(_evmVersion, _objectAccess)),
 	m_reserved(createReservedIdentifiers(_evmVersion))
 {
+	updateLookupTables();
 }
 
 BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 {
+	if (BuiltinFunctionForEVM const* function = lookupBuiltin(_name))
+		return function;
 	if (m_objectAccess)
 	{
 		smatch match;
 		if (regex_match(_name.str(), match, verbatimPattern()))
 			return verbatimFunction(stoul(match[1]), stoul(match[2]));
 	}
-	auto it = m_functions.find(_name);
-	if (it != m_functions.end())
-		return &it->second;
-	else
-		return nullptr;
+	return nullptr;
 }
 
 bool EVMDialect::reservedIdentifier(YulString _name) const
 {
+	if (_name.id() < m_reservedById.size() && m_reservedById[_name.id()])
+		return true;
 	if (m_objectAccess)
-		if (_name.str().substr(0, "verbatim"s.size()) == "verbatim")
+		if (_name.str().compare(0, "verbatim"s.size(), "verbatim") == 0)
 			return true;
-	return m_reserved.count(_name) != 0;
+	return false;
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
+	static mutex dialectsMutex;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
 	return *dialects[_version];
@@ -329,7 +359,9 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
+	static mutex dialectsMutex;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
 	return *dialects[_version];
@@ -354,9 +386,37 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 	};
 }
 
+void EVMDialect::updateLookupTables()
+{
+	m_builtinsById.clear();
+	for (auto const& [name, function]: m_functions)
+	{
+		if (name.id() >= m_builtinsById.size())
+			m_builtinsById.resize(name.id() + 1, nullptr);
+		m_builtinsById[name.id()] = &function;
+	}
+	m_reservedById.clear();
+	for (YulString name: m_reserved)
+	{
+		if (name.id() >= m_reservedById.size())
+			m_reservedById.resize(name.id() + 1, false);
+		m_reservedById[name.id()] = true;
+	}
+
+	m_discardFunction = lookupBuiltin("pop"_yulstring);
+	m_equalityFunction = lookupBuiltin("eq"_yulstring);
+	m_booleanNegationFunction = lookupBuiltin("iszero"_yulstring);
+	m_memoryStoreFunction = lookupBuiltin("mstore"_yulstring);
+	m_memoryLoadFunction = lookupBuiltin("mload"_yulstring);
+	m_storageStoreFunction = lookupBuiltin("sstore"_yulstring);
+	m_storageLoadFunction = lookupBuiltin("sload"_yulstring);
+	m_hashFunction = "keccak256"_yulstring;
+}
+
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	pair<size_t, size_t> key{_arguments, _returnVariables};
+	lock_guard lock(m_verbatimFunctionsMutex);
 	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
@@ -457,34 +517,40 @@ EVMDialectTyped::EVMDialectTyped(langutil::EVMVersion _evmVersion, bool _objectA
 	}));
 	m_functions["u256_to_bool"_yulstring].parameters = {"u256"_yulstring};
 	m_functions["u256_to_bool"_yulstring].returns = {"bool"_yulstring};
+
+	updateLookupTables();
+	m_booleanNegationFunction = lookupBuiltin("not"_yulstring);
+	m_boolDiscardFunction = lookupBuiltin("popbool"_yulstring);
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::discardFunction(YulString _type) const
 {
-	if (_type == "bool"_yulstring)
-		return builtin("popbool"_yulstring);
+	if (_type == boolType)
+		return m_boolDiscardFunction;
 	else
 	{
 		yulAssert(_type == defaultType, "");
-		return builtin("pop"_yulstring);
+		return m_discardFunction;
 	}
 }
 
 BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type) const
 {
-	if (_type == "bool"_yulstring)
+	if (_type == boolType)
 		return nullptr;
 	else
 	{
 		yulAssert(_type == defaultType, "");
-		return builtin("eq"_yulstring);
+		return m_equalityFunction;
 	}
 }
 
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
+	static mutex dialectsMutex;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
 	return *dialects[_version];
@@ -28,7 +28,9 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -75,14 +77,14 @@ struct EVMDialect: public Dialect
 	/// @returns true if the identifier is reserved. This includes the builtins too.
 	bool reservedIdentifier(YulString _name) const override;
 
-	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return builtin("pop"_yulstring); }
-	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return builtin("eq"_yulstring); }
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("iszero"_yulstring); }
-	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return builtin("mstore"_yulstring); }
-	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return builtin("mload"_yulstring); }
-	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return builtin("sstore"_yulstring); }
-	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return builtin("sload"_yulstring); }
-	YulString hashFunction(YulString /*_type*/) const override { return "keccak256"_yulstring; }
+	BuiltinFunctionForEVM const* discardFunction(YulString /*_type*/) const override { return m_discardFunction; }
+	BuiltinFunctionForEVM const* equalityFunction(YulString /*_type*/) const override { return m_equalityFunction; }
+	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return m_booleanNegationFunction; }
+	BuiltinFunctionForEVM const* memoryStoreFunction(YulString /*_type*/) const override { return m_memoryStoreFunction; }
+	BuiltinFunctionForEVM const* memoryLoadFunction(YulString /*_type*/) const override { return m_memoryLoadFunction; }
+	BuiltinFunctionForEVM const* storageStoreFunction(YulString /*_type*/) const override { return m_storageStoreFunction; }
+	BuiltinFunctionForEVM const* storageLoadFunction(YulString /*_type*/) const override { return m_storageLoadFunction; }
+	YulString hashFunction(YulString /*_type*/) const override { return m_hashFunction; }
 
 	static EVMDialect const& strictAssemblyForEVM(langutil::EVMVersion _version);
 	static EVMDialect const& strictAssemblyForEVMObjects(langutil::EVMVersion _version);
@@ -95,12 +97,33 @@ struct EVMDialect: public Dialect
 
 protected:
 	BuiltinFunctionForEVM const* verbatimFunction(size_t _arguments, size_t _returnVariables) const;
+	/// Rebuilds the lookup tables indexed by YulString ids and the cached builtins
+	/// from ``m_functions`` and ``m_reserved``. Has to be called after modifying them.
+	void updateLookupTables();
+	/// @returns the builtin function of the given name, ignoring verbatim functions.
+	BuiltinFunctionForEVM const* lookupBuiltin(YulString _name) const
+	{
+		return _name.id() < m_builtinsById.size() ? m_builtinsById[_name.id()] : nullptr;
+	}
 
 	bool const m_objectAccess;
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulString, BuiltinFunctionForEVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<YulString> m_reserved;
+	/// Builtins and reserved identifiers indexed by the id of their name.
+	/// Dialects are cleared when the YulString repository is reset, so the ids stay valid.
+	std::vector<BuiltinFunctionForEVM const*> m_builtinsById;
+	std::vector<bool> m_reservedById;
+	BuiltinFunctionForEVM const* m_discardFunction = nullptr;
+	BuiltinFunctionForEVM const* m_equalityFunction = nullptr;
+	BuiltinFunctionForEVM const* m_booleanNegationFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_memoryLoadFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageStoreFunction = nullptr;
+	BuiltinFunctionForEVM const* m_storageLoadFunction = nullptr;
+	YulString m_hashFunction;
 };
 
 /**
@@ -120,9 +143,11 @@ struct EVMDialectTyped: public EVMDialect
 
 	BuiltinFunctionForEVM const* discardFunction(YulString _type) const override;
 	BuiltinFunctionForEVM const* equalityFunction(YulString _type) const override;
-	BuiltinFunctionForEVM const* booleanNegationFunction() const override { return builtin("not"_yulstring); }
 
 	static EVMDialectTyped const& instance(langutil::EVMVersion _version);
+
+private:
+	BuiltinFunctionForEVM const* m_boolDiscardFunction = nullptr;
 };
 
 }
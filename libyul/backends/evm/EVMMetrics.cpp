@@ -41,6 +41,16 @@ bigint GasMeter::costs(Expression const& _expression) const
 	return combineCosts(GasMeterVisitor::costs(_expression, m_dialect, m_isCreation));
 }
 
+bigint GasMeter::costs(Block const& _block) const
+{
+	return combineCosts(GasMeterVisitor::costs(_block, m_dialect, m_isCreation));
+}
+
+bigint GasMeter::functionCallCosts() const
+{
+	return combineCosts(GasMeterVisitor::functionCallCosts(m_dialect, m_isCreation));
+}
+
 bigint GasMeter::instructionCosts(evmasm::Instruction _instruction) const
 {
 	return combineCosts(GasMeterVisitor::instructionCosts(_instruction, m_dialect, m_isCreation));
@@ -74,16 +84,38 @@ pair<bigint, bigint> GasMeterVisitor::instructionCosts(
 	return {gmv.m_runGas, gmv.m_dataGas};
 }
 
+pair<bigint, bigint> GasMeterVisitor::costs(
+	Block const& _block,
+	EVMDialect const& _dialect,
+	bool _isCreation
+)
+{
+	GasMeterVisitor gmv(_dialect, _isCreation);
+	gmv.m_allowFunctionCalls = true;
+	gmv(_block);
+	return {gmv.m_runGas, gmv.m_dataGas};
+}
+
+pair<bigint, bigint> GasMeterVisitor::functionCallCosts(EVMDialect const& _dialect, bool _isCreation)
+{
+	GasMeterVisitor gmv(_dialect, _isCreation);
+	gmv.functionCallCostsInternal();
+	return {gmv.m_runGas, gmv.m_dataGas};
+}
+
 void GasMeterVisitor::operator()(FunctionCall const& _funCall)
 {
 	ASTWalker::operator()(_funCall);
-	if (BuiltinFunctionForEVM const* f = m_dialect.builtin(_funCall.functionName.name))
-		if (f->instruction)
-		{
-			instructionCostsInternal(*f->instruction);
-			return;
-		}
-	yulAssert(false, "Functions not implemented.");
+	BuiltinFunctionForEVM const* f = m_dialect.builtin(_funCall.functionName.name);
+	if (f && f->instruction)
+		instructionCostsInternal(*f->instruction);
+	else if (m_allowFunctionCalls && f)
+		// Builtins like ``datasize`` are replaced by a value.
+		instructionCostsInternal(evmasm::Instruction::PUSH1);
+	else if (m_allowFunctionCalls)
+		functionCallCostsInternal();
+	else
+		yulAssert(false, "Functions not implemented.");
 }
 
 void GasMeterVisitor::operator()(Literal const& _lit)
@@ -112,6 +144,16 @@ bigint GasMeterVisitor::singleByteDataGas() const
 		return evmasm::GasCosts::createDataGas;
 }
 
+void GasMeterVisitor::functionCallCostsInternal()
+{
+	// Push of the return label, jump to the function and jump back.
+	instructionCostsInternal(evmasm::Instruction::PUSH1);
+	instructionCostsInternal(evmasm::Instruction::JUMP);
+	instructionCostsInternal(evmasm::Instruction::JUMPDEST);
+	instructionCostsInternal(evmasm::Instruction::JUMP);
+	instructionCostsInternal(evmasm::Instruction::JUMPDEST);
+}
+
 void GasMeterVisitor::instructionCostsInternal(evmasm::Instruction _instruction)
 {
 	if (_instruction == evmasm::Instruction::EXP)
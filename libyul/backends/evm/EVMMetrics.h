@@ -51,6 +51,14 @@ public:
 
 	/// @returns the full combined costs of deploying and evaluating the expression.
 	bigint costs(Expression const& _expression) const;
+	/// @returns the combined costs of deploying and evaluating all expressions in the block,
+	/// including the bodies of the functions defined in it. Calls to user-defined functions are
+	/// charged with the costs of jumping into and out of the function.
+	/// Does not take control flow and stack shuffling into account.
+	bigint costs(Block const& _block) const;
+	/// @returns the combined costs of deploying and running the jumps into and out of
+	/// a user-defined function.
+	bigint functionCallCosts() const;
 	/// @returns the combined costs of deploying and running the instruction, not including
 	/// the costs for its arguments.
 	bigint instructionCosts(evmasm::Instruction _instruction) const;
@@ -78,12 +86,21 @@ public:
 		bool _isCreation = false
 	);
 
+	static std::pair<bigint, bigint> costs(
+		Block const& _block,
+		EVMDialect const& _dialect,
+		bool _isCreation
+	);
+
+	static std::pair<bigint, bigint> functionCallCosts(EVMDialect const& _dialect, bool _isCreation);
+
 public:
 	GasMeterVisitor(EVMDialect const& _dialect, bool _isCreation):
 		m_dialect(_dialect),
 		m_isCreation{_isCreation}
 	{}
 
+	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
 	void operator()(Literal const& _literal) override;
 	void operator()(Identifier const& _identifier) override;
@@ -94,9 +111,13 @@ private:
 	/// For EXP, it assumes that the exponent is at most 255.
 	/// Does not work particularly exact for anything apart from arithmetic.
 	void instructionCostsInternal(evmasm::Instruction _instruction);
+	void functionCallCostsInternal();
 
 	EVMDialect const& m_dialect;
 	bool m_isCreation = false;
+	/// If true, calls to user-defined functions and to builtins that are not instructions
+	/// are allowed and charged with the costs of the call resp. a push.
+	bool m_allowFunctionCalls = false;
 	bigint m_runGas = 0;
 	bigint m_dataGas = 0;
 };
@@ -21,6 +21,7 @@
 
 #include <libyul/backends/evm/EVMObjectCompiler.h>
 
+#include <libyul/backends/evm/EVMAssemblyCache.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/OptimizedEVMCodeTransform.h>
@@ -30,14 +31,40 @@
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/Profiler.h>
+
 #include <boost/algorithm/string.hpp>
 
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize)
+namespace
+{
+
+/// Assigns the IDs of the sub-objects of an object whose assembly is reused from the cache
+/// in the order EVMObjectCompiler::run creates their sub-assemblies.
+void assignSubIds(Object& _object)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect);
+	size_t subId = 0;
+	for (auto const& subNode: _object.subObjects)
+		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
+		{
+			subObject->subId = subId++;
+			assignSubIds(*subObject);
+		}
+}
+
+}
+
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _optimize,
+	optional<string> _cacheSettings
+)
+{
+	EVMObjectCompiler compiler(_assembly, _dialect, std::move(_cacheSettings));
 	compiler.run(_object, _optimize);
 }
 
@@ -51,10 +78,20 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
+			if (m_cacheSettings && EVMAssemblyCache::active())
+				if (optional<AbstractAssembly::SubID> subId = m_assembly.appendCachedSubAssembly(
+					EVMAssemblyCache::key(*subObject, isCreation, m_dialect, *m_cacheSettings)
+				))
+				{
+					context.subIDs[subObject->name] = *subId;
+					subObject->subId = *subId;
+					assignSubIds(*subObject);
+					continue;
+				}
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize);
+			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_cacheSettings);
 		}
 		else
 		{
@@ -70,14 +107,18 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	yulAssert(_object.code, "No code.");
 	if (_optimize && m_dialect.evmVersion().canOverchargeGasForCall())
 	{
-		auto stackErrors = OptimizedEVMCodeTransform::run(
-			m_assembly,
-			*_object.analysisInfo,
-			*_object.code,
-			m_dialect,
-			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
-		);
+		vector<StackTooDeepError> stackErrors;
+		{
+			util::ProfilerScope profilerScope("OptimizedEVMCodeTransform");
+			stackErrors = OptimizedEVMCodeTransform::run(
+				m_assembly,
+				*_object.analysisInfo,
+				*_object.code,
+				m_dialect,
+				context,
+				OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			);
+		}
 		if (!stackErrors.empty())
 		{
 			vector<FunctionCall*> memoryGuardCalls = FunctionCallFinder::run(
@@ -100,6 +141,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	{
 		// We do not catch and re-throw the stack too deep exception here because it is a YulException,
 		// which should be native to this part of the code.
+		util::ProfilerScope profilerScope("CodeTransform");
 		CodeTransform transform{
 			m_assembly,
 			*_object.analysisInfo,
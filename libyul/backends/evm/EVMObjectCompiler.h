@@ -21,6 +21,9 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 namespace solidity::yul
 {
 struct Object;
@@ -30,16 +33,26 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _optimize);
+	/// Compiles @a _object into @a _assembly. If @a _cacheSettings is given, it describes the settings
+	/// the assemblies are generated and optimised with and sub-objects whose assembly is stored
+	/// in the active EVMAssemblyCache are not compiled again.
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _optimize,
+		std::optional<std::string> _cacheSettings = std::nullopt
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect):
-		m_assembly(_assembly), m_dialect(_dialect)
+	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, std::optional<std::string> _cacheSettings):
+		m_assembly(_assembly), m_dialect(_dialect), m_cacheSettings(std::move(_cacheSettings))
 	{}
 
 	void run(Object& _object, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
+	std::optional<std::string> m_cacheSettings;
 };
 
 }
@@ -22,6 +22,7 @@
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
 
 #include <libyul/backends/evm/AbstractAssembly.h>
+#include <libyul/backends/evm/EVMAssemblyCache.h>
 #include <libyul/Exceptions.h>
 
 #include <libevmasm/Assembly.h>
@@ -39,14 +40,21 @@ using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
-EthAssemblyAdapter::EthAssemblyAdapter(evmasm::Assembly& _assembly):
-	m_assembly(_assembly)
+EthAssemblyAdapter::EthAssemblyAdapter(
+	evmasm::Assembly& _assembly,
+	optional<SourceLocation> _sourceLocationOverride
+):
+	m_assembly(_assembly),
+	m_sourceLocationOverride(std::move(_sourceLocationOverride))
 {
 }
 
 void EthAssemblyAdapter::setSourceLocation(SourceLocation const& _location)
 {
-	m_assembly.setSourceLocation(_location);
+	if (m_sourceLocationOverride && _location.isValid())
+		m_assembly.setSourceLocation(*m_sourceLocationOverride);
+	else
+		m_assembly.setSourceLocation(_location);
 }
 
 int EthAssemblyAdapter::stackHeight() const
@@ -129,6 +137,17 @@ pair<shared_ptr<AbstractAssembly>, AbstractAssembly::SubID> EthAssemblyAdapter::
 	return {make_shared<EthAssemblyAdapter>(*assembly), static_cast<size_t>(sub.data())};
 }
 
+optional<AbstractAssembly::SubID> EthAssemblyAdapter::appendCachedSubAssembly(util::h256 const& _key)
+{
+	EVMAssemblyCache* cache = EVMAssemblyCache::active();
+	if (!cache)
+		return nullopt;
+	shared_ptr<evmasm::Assembly> assembly = cache->find(_key);
+	if (!assembly)
+		return nullopt;
+	return static_cast<size_t>(m_assembly.newSub(assembly).data());
+}
+
 void EthAssemblyAdapter::appendDataOffset(vector<AbstractAssembly::SubID> const& _subPath)
 {
 	if (auto it = m_dataHashBySubId.find(_subPath[0]); it != m_dataHashBySubId.end())
@@ -27,6 +27,7 @@
 
 #include <functional>
 #include <limits>
+#include <optional>
 
 namespace solidity::evmasm
 {
@@ -39,7 +40,11 @@ namespace solidity::yul
 class EthAssemblyAdapter: public AbstractAssembly
 {
 public:
-	explicit EthAssemblyAdapter(evmasm::Assembly& _assembly);
+	/// @param _sourceLocationOverride if set, replaces all valid source locations of the generated code.
+	explicit EthAssemblyAdapter(
+		evmasm::Assembly& _assembly,
+		std::optional<langutil::SourceLocation> _sourceLocationOverride = std::nullopt
+	);
 	void setSourceLocation(langutil::SourceLocation const& _location) override;
 	int stackHeight() const override;
 	void setStackHeight(int height) override;
@@ -56,6 +61,7 @@ public:
 	void appendJumpToIf(LabelID _labelId, JumpType _jumpType) override;
 	void appendAssemblySize() override;
 	std::pair<std::shared_ptr<AbstractAssembly>, SubID> createSubAssembly(bool _creation, std::string _name = {}) override;
+	std::optional<SubID> appendCachedSubAssembly(util::h256 const& _key) override;
 	void appendDataOffset(std::vector<SubID> const& _subPath) override;
 	void appendDataSize(std::vector<SubID> const& _subPath) override;
 	SubID appendData(bytes const& _data) override;
@@ -72,6 +78,7 @@ private:
 	void appendJumpInstruction(evmasm::Instruction _instruction, JumpType _jumpType);
 
 	evmasm::Assembly& m_assembly;
+	std::optional<langutil::SourceLocation> m_sourceLocationOverride;
 	std::map<SubID, u256> m_dataHashBySubId;
 	size_t m_nextDataCounter = std::numeric_limits<size_t>::max() / 2;
 };
@@ -20,6 +20,7 @@
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/StackHelpers.h>
 #include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libyul/Utilities.h>
 
@@ -44,11 +45,12 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 	Block const& _block,
 	EVMDialect const& _dialect,
 	BuiltinContext& _builtinContext,
-	UseNamedLabels _useNamedLabelsForFunctions
+	UseNamedLabels _useNamedLabelsForFunctions,
+	bool _continueAfterMainBlock
 )
 {
 	std::unique_ptr<CFG> dfg = ControlFlowGraphBuilder::build(_analysisInfo, _dialect, _block);
-	StackLayout stackLayout = StackLayoutGenerator::run(*dfg);
+	StackLayout stackLayout = StackLayoutGenerator::run(*dfg, OptimiserSuite::ParallelismActivation::threads());
 	OptimizedEVMCodeTransform optimizedCodeTransform(
 		_assembly,
 		_builtinContext,
@@ -56,11 +58,18 @@ vector<StackTooDeepError> OptimizedEVMCodeTransform::run(
 		*dfg,
 		stackLayout
 	);
+	if (_continueAfterMainBlock)
+		optimizedCodeTransform.m_mainExitLabel = _assembly.newLabelId();
 	// Create initial entry layout.
 	optimizedCodeTransform.createStackLayout(debugDataOf(*dfg->entry), stackLayout.blockInfos.at(dfg->entry).entryLayout);
 	optimizedCodeTransform(*dfg->entry);
 	for (Scope::Function const* function: dfg->functions)
 		optimizedCodeTransform(dfg->functionInfo.at(function));
+	if (optimizedCodeTransform.m_mainExitLabel)
+	{
+		_assembly.setStackHeight(0);
+		_assembly.appendLabel(*optimizedCodeTransform.m_mainExitLabel);
+	}
 	return move(optimizedCodeTransform.m_stackErrors);
 }
 
@@ -232,7 +241,7 @@ void OptimizedEVMCodeTransform::validateSlot(StackSlot const& _slot, Expression
 	}, _expression);
 }
 
-void OptimizedEVMCodeTransform::createStackLayout(std::shared_ptr<DebugData const> _debugData, Stack _targetStack)
+void OptimizedEVMCodeTransform::createStackLayout(DebugData const* _debugData, Stack _targetStack)
 {
 	static constexpr auto slotVariableName = [](StackSlot const& _slot) {
 		return std::visit(util::GenericVisitor{
@@ -407,7 +416,14 @@ void OptimizedEVMCodeTransform::operator()(CFG::BasicBlock const& _block)
 	std::visit(util::GenericVisitor{
 		[&](CFG::BasicBlock::MainExit const&)
 		{
-			m_assembly.appendInstruction(evmasm::Instruction::STOP);
+			if (!m_mainExitLabel)
+			{
+				m_assembly.appendInstruction(evmasm::Instruction::STOP);
+				return;
+			}
+			// Pop all variables of the outermost block and jump past the remaining blocks and functions.
+			createStackLayout(debugDataOf(_block), {});
+			m_assembly.appendJumpTo(*m_mainExitLabel);
 		},
 		[&](CFG::BasicBlock::Jump const& _jump)
 		{
@@ -47,13 +47,18 @@ public:
 	/// 2) For none of the functions 3) for the first function of each name.
 	enum class UseNamedLabels { YesAndForceUnique, Never, ForFirstFunctionOfEachName };
 
+	/// Generates code for @a _block and appends it to @a _assembly.
+	/// The outermost block is terminated by STOP, unless @a _continueAfterMainBlock is set. In that case
+	/// its variables are popped and the code continues after the generated code with an empty stack,
+	/// which allows embedding it into surrounding code.
 	[[nodiscard]] static std::vector<StackTooDeepError> run(
 		AbstractAssembly& _assembly,
 		AsmAnalysisInfo& _analysisInfo,
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		bool _continueAfterMainBlock = false
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
@@ -83,7 +88,7 @@ private:
 
 	/// Shuffles m_stack to the desired @a _targetStack while emitting the shuffling code to m_assembly.
 	/// Sets the source locations to the one in @a _debugData.
-	void createStackLayout(std::shared_ptr<DebugData const> _debugData, Stack _targetStack);
+	void createStackLayout(DebugData const* _debugData, Stack _targetStack);
 
 	/// Generate code for the given block @a _block.
 	/// Expects the current stack layout m_stack to be a stack layout that is compatible with the
@@ -109,6 +114,9 @@ private:
 	/// contain a jump label for it.
 	std::set<CFG::BasicBlock const*> m_generated;
 	CFG::FunctionInfo const* m_currentFunctionInfo = nullptr;
+	/// Label at the end of the generated code, if the outermost block is supposed to continue there
+	/// instead of terminating.
+	std::optional<AbstractAssembly::LabelID> m_mainExitLabel;
 	std::vector<StackTooDeepError> m_stackErrors;
 };
 
@@ -27,6 +27,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -48,13 +49,30 @@ using namespace solidity;
 using namespace solidity::yul;
 using namespace std;
 
-StackLayout StackLayoutGenerator::run(CFG const& _cfg)
+StackLayout StackLayoutGenerator::run(CFG const& _cfg, size_t _threads)
 {
 	StackLayout stackLayout;
 	StackLayoutGenerator{stackLayout}.processEntryPoint(*_cfg.entry);
 
-	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout}.processEntryPoint(*functionInfo.entry);
+	// The blocks of different functions are disjoint and the layout of a function does not
+	// depend on the layouts of other functions, so they are generated independently.
+	vector<CFG::FunctionInfo const*> functionInfos;
+	for (auto const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		functionInfos.emplace_back(&functionInfo);
+	vector<StackLayout> functionLayouts(functionInfos.size());
+	util::parallelFor(functionInfos.size(), _threads, [&](size_t _index) {
+		StackLayoutGenerator{functionLayouts[_index]}.processEntryPoint(*functionInfos[_index]->entry);
+	});
+
+	for (StackLayout& functionLayout: functionLayouts)
+	{
+		stackLayout.blockInfos.merge(functionLayout.blockInfos);
+		stackLayout.operationEntryLayout.merge(functionLayout.operationEntryLayout);
+		yulAssert(
+			functionLayout.blockInfos.empty() && functionLayout.operationEntryLayout.empty(),
+			"Functions share blocks or operations."
+		);
+	}
 
 	return stackLayout;
 }
@@ -544,7 +562,16 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 	});
 }
 
-Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2)
+Stack const& StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _stack2) const
+{
+	auto key = make_pair(_stack1, _stack2);
+	auto it = m_combinedStacks.find(key);
+	if (it == m_combinedStacks.end())
+		it = m_combinedStacks.emplace(std::move(key), computeCombinedStack(_stack1, _stack2)).first;
+	return it->second;
+}
+
+Stack StackLayoutGenerator::computeCombinedStack(Stack const& _stack1, Stack const& _stack2)
 {
 	// TODO: it would be nicer to replace this by a constructive algorithm.
 	// Currently it uses a reduced version of the Heap Algorithm to partly brute-force, which seems
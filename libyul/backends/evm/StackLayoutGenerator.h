@@ -24,6 +24,7 @@
 #include <libyul/backends/evm/ControlFlowGraph.h>
 
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -37,11 +38,11 @@ struct StackLayout
 		/// The resulting stack layout after executing the block.
 		Stack exitLayout;
 	};
-	std::map<CFG::BasicBlock const*, BlockInfo> blockInfos;
+	std::unordered_map<CFG::BasicBlock const*, BlockInfo> blockInfos;
 	/// For each operation the complete stack layout that:
 	/// - has the slots required for the operation at the stack top.
 	/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
-	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+	std::unordered_map<CFG::Operation const*, Stack> operationEntryLayout;
 };
 
 class StackLayoutGenerator
@@ -55,7 +56,9 @@ public:
 		std::vector<YulString> variableChoices;
 	};
 
-	static StackLayout run(CFG const& _cfg);
+	/// Generates the layouts of the functions of @a _cfg on up to @a _threads threads.
+	/// The result does not depend on the number of threads.
+	static StackLayout run(CFG const& _cfg, size_t _threads = 1);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
 	/// The empty string is mapped to the stack too deep errors of the main entry point.
@@ -100,7 +103,10 @@ private:
 
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
-	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// The results are memoized, since the same layouts are combined again whenever the
+	/// layouts are propagated along backwards jumps.
+	Stack const& combineStack(Stack const& _stack1, Stack const& _stack2) const;
+	static Stack computeCombinedStack(Stack const& _stack1, Stack const& _stack2);
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -115,6 +121,7 @@ private:
 	void fillInJunk(CFG::BasicBlock const& _block);
 
 	StackLayout& m_layout;
+	mutable std::map<std::pair<Stack, Stack>, Stack> m_combinedStacks;
 };
 
 }
@@ -38,11 +38,6 @@ using namespace solidity::util;
 namespace
 {
 
-bytes toBytes(uint8_t _b)
-{
-	return bytes(1, _b);
-}
-
 enum class LimitsKind: uint8_t
 {
 	Min = 0x00,
@@ -67,11 +62,6 @@ enum class Section: uint8_t
 	CODE = 0x0a
 };
 
-bytes toBytes(Section _s)
-{
-	return toBytes(uint8_t(_s));
-}
-
 enum class ValueType: uint8_t
 {
 	Void = 0x40,
@@ -80,11 +70,6 @@ enum class ValueType: uint8_t
 	I32 = 0x7f
 };
 
-bytes toBytes(ValueType _vt)
-{
-	return toBytes(uint8_t(_vt));
-}
-
 ValueType toValueType(wasm::Type _type)
 {
 	if (_type == wasm::Type::i32)
@@ -101,11 +86,6 @@ enum class Export: uint8_t
 	Memory = 0x2
 };
 
-bytes toBytes(Export _export)
-{
-	return toBytes(uint8_t(_export));
-}
-
 // NOTE: This is a subset of WebAssembly opcodes.
 //       Those available as a builtin are listed further down.
 enum class Opcode: uint8_t
@@ -130,9 +110,10 @@ enum class Opcode: uint8_t
 	I64Const = 0x42,
 };
 
-bytes toBytes(Opcode _o)
+template <typename Enum>
+void append(bytes& _output, Enum _value)
 {
-	return toBytes(uint8_t(_o));
+	_output.push_back(static_cast<uint8_t>(_value));
 }
 
 Opcode constOpcodeFor(ValueType _type)
@@ -236,15 +217,35 @@ static map<string, uint8_t> const builtins = {
 	{"i64.extend_i32_u", 0xad},
 };
 
-bytes prefixSize(bytes _data)
+/// Maximal length of the LEB128 encoding of a size_t.
+size_t constexpr maxSizePrefixLength = 10;
+
+/// Reserves space for the size of the data that is appended to @a _output afterwards.
+/// @returns the position of the reserved space, which has to be passed to ``endSizePrefix``.
+size_t beginSizePrefix(bytes& _output)
 {
-	size_t size = _data.size();
-	return lebEncode(size) + move(_data);
+	size_t const position = _output.size();
+	_output.resize(position + maxSizePrefixLength);
+	return position;
 }
 
-bytes makeSection(Section _section, bytes _data)
+/// Writes the size of the data appended since ``beginSizePrefix`` returned @a _position in front of it.
+/// The encoding of the size is not padded, so the unused reserved space is removed, which moves the
+/// data once.
+void endSizePrefix(bytes& _output, size_t _position)
 {
-	return toBytes(_section) + prefixSize(move(_data));
+	bytes const size = lebEncode(_output.size() - _position - maxSizePrefixLength);
+	auto const reserved = _output.begin() + static_cast<ptrdiff_t>(_position);
+	copy(size.begin(), size.end(), reserved);
+	_output.erase(reserved + static_cast<ptrdiff_t>(size.size()), reserved + static_cast<ptrdiff_t>(maxSizePrefixLength));
+}
+
+/// Appends the id of @a _section and reserves space for its size.
+/// @returns the position to pass to ``endSizePrefix`` once the content of the section is appended.
+size_t beginSection(bytes& _output, Section _section)
+{
+	append(_output, _section);
+	return beginSizePrefix(_output);
 }
 
 /// This is a kind of run-length-encoding of local types.
@@ -281,9 +282,9 @@ bytes BinaryTransform::run(Module const& _module)
 {
 	map<Type, vector<string>> const types = typeToFunctionMap(_module.imports, _module.functions);
 
-	map<string, size_t> const globalIDs = enumerateGlobals(_module);
-	map<string, size_t> const functionIDs = enumerateFunctions(_module);
-	map<string, size_t> const functionTypes = enumerateFunctionTypes(types);
+	IndexMap globalIDs = enumerateGlobals(_module);
+	IndexMap functionIDs = enumerateFunctions(_module);
+	IndexMap const functionTypes = enumerateFunctionTypes(types);
 
 	yulAssert(globalIDs.size() == _module.globals.size(), "");
 	yulAssert(functionIDs.size() == _module.imports.size() + _module.functions.size(), "");
@@ -293,70 +294,76 @@ bytes BinaryTransform::run(Module const& _module)
 	bytes ret{0, 'a', 's', 'm'};
 	// version
 	ret += bytes{1, 0, 0, 0};
-	ret += typeSection(types);
-	ret += importSection(_module.imports, functionTypes);
-	ret += functionSection(_module.functions, functionTypes);
-	ret += memorySection();
-	ret += globalSection(_module.globals);
-	ret += exportSection(functionIDs);
+	typeSection(ret, types);
+	importSection(ret, _module.imports, functionTypes);
+	functionSection(ret, _module.functions, functionTypes);
+	memorySection(ret);
+	globalSection(ret, _module.globals);
+	exportSection(ret, functionIDs);
 
 	map<string, pair<size_t, size_t>> subModulePosAndSize;
 	for (auto const& [name, module]: _module.subModules)
 	{
 		// TODO should we prefix and / or shorten the name?
-		bytes data = BinaryTransform::run(module);
-		size_t const length = data.size();
-		ret += customSection(name, move(data));
+		bytes const data = BinaryTransform::run(module);
+		customSection(ret, name, data);
 		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
+		size_t const offset = ret.size() - data.size();
+		subModulePosAndSize[name] = {offset, data.size()};
 	}
 	for (auto const& [name, data]: _module.customSections)
 	{
-		size_t const length = data.size();
-		ret += customSection(name, data);
+		customSection(ret, name, data);
 		// Skip all the previous sections and the size field of this current custom section.
-		size_t const offset = ret.size() - length;
-		subModulePosAndSize[name] = {offset, length};
+		size_t const offset = ret.size() - data.size();
+		subModulePosAndSize[name] = {offset, data.size()};
 	}
 
 	BinaryTransform bt(
+		ret,
 		move(globalIDs),
 		move(functionIDs),
-		move(functionTypes),
 		move(subModulePosAndSize)
 	);
 
-	ret += bt.codeSection(_module.functions);
+	bt.codeSection(_module.functions);
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
+void BinaryTransform::operator()(Literal const& _literal)
 {
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			append(m_output, Opcode::I32Const);
+			lebEncodeSignedTo(m_output, static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			append(m_output, Opcode::I64Const);
+			lebEncodeSignedTo(m_output, static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	append(m_output, Opcode::LocalGet);
+	lebEncodeTo(m_output, m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	append(m_output, Opcode::GlobalGet);
+	lebEncodeTo(m_output, m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -365,20 +372,25 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		append(m_output, Opcode::I64Const);
+		lebEncodeSignedTo(m_output, static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		append(m_output, Opcode::I64Const);
+		lebEncodeSignedTo(m_output, static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
-	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
+	auto builtin = builtins.find(_call.functionName);
+	yulAssert(builtin != builtins.end(), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_output.push_back(builtin->second);
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
@@ -387,103 +399,101 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_output += bytes{{0, 0}}; // 2^0 == 1-byte alignment
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	append(m_output, Opcode::Call);
+	lebEncodeTo(m_output, m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	append(m_output, Opcode::LocalSet);
+	lebEncodeTo(m_output, m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	append(m_output, Opcode::GlobalSet);
+	lebEncodeTo(m_output, m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	append(m_output, Opcode::If);
+	append(m_output, ValueType::Void);
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		append(m_output, Opcode::Else);
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	append(m_output, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	append(m_output, Opcode::Loop);
+	append(m_output, ValueType::Void);
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	append(m_output, Opcode::End);
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	append(m_output, Opcode::Br);
+	encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	append(m_output, Opcode::BrIf);
+	encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	append(m_output, Opcode::Return);
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	append(m_output, Opcode::Block);
+	append(m_output, ValueType::Void);
+	visit(_block.statements);
+	append(m_output, Opcode::End);
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
+	size_t const sizePosition = beginSizePrefix(m_output);
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	lebEncodeTo(m_output, localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		lebEncodeTo(m_output, entry.first);
+		append(m_output, entry.second);
 	}
 
 	m_locals.clear();
@@ -495,12 +505,12 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	append(m_output, Opcode::End);
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(move(ret));
+	endSizePrefix(m_output, sizePosition);
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -554,18 +564,18 @@ map<BinaryTransform::Type, vector<string>> BinaryTransform::typeToFunctionMap(
 	return types;
 }
 
-map<string, size_t> BinaryTransform::enumerateGlobals(Module const& _module)
+BinaryTransform::IndexMap BinaryTransform::enumerateGlobals(Module const& _module)
 {
-	map<string, size_t> globals;
+	IndexMap globals;
 	for (size_t i = 0; i < _module.globals.size(); ++i)
 		globals[_module.globals[i].variableName] = i;
 
 	return globals;
 }
 
-map<string, size_t> BinaryTransform::enumerateFunctions(Module const& _module)
+BinaryTransform::IndexMap BinaryTransform::enumerateFunctions(Module const& _module)
 {
-	map<string, size_t> functions;
+	IndexMap functions;
 	size_t funID = 0;
 	for (FunctionImport const& fun: _module.imports)
 		functions[fun.internalName] = funID++;
@@ -575,9 +585,9 @@ map<string, size_t> BinaryTransform::enumerateFunctions(Module const& _module)
 	return functions;
 }
 
-map<string, size_t> BinaryTransform::enumerateFunctionTypes(map<Type, vector<string>> const& _typeToFunctionMap)
+BinaryTransform::IndexMap BinaryTransform::enumerateFunctionTypes(map<Type, vector<string>> const& _typeToFunctionMap)
 {
-	map<string, size_t> functionTypes;
+	IndexMap functionTypes;
 	size_t typeID = 0;
 	for (vector<string> const& funNames: _typeToFunctionMap | ranges::views::values)
 	{
@@ -589,134 +599,140 @@ map<string, size_t> BinaryTransform::enumerateFunctionTypes(map<Type, vector<str
 	return functionTypes;
 }
 
-bytes BinaryTransform::typeSection(map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap)
+void BinaryTransform::typeSection(bytes& _output, map<BinaryTransform::Type, vector<string>> const& _typeToFunctionMap)
 {
-	bytes result;
-	size_t index = 0;
+	size_t const sizePosition = beginSection(_output, Section::TYPE);
+	lebEncodeTo(_output, _typeToFunctionMap.size());
 	for (Type const& type: _typeToFunctionMap | ranges::views::keys)
 	{
-		result += toBytes(ValueType::Function);
-		result += lebEncode(type.first.size()) + type.first;
-		result += lebEncode(type.second.size()) + type.second;
-
-		index++;
+		append(_output, ValueType::Function);
+		lebEncodeTo(_output, type.first.size());
+		_output += type.first;
+		lebEncodeTo(_output, type.second.size());
+		_output += type.second;
 	}
-
-	return makeSection(Section::TYPE, lebEncode(index) + move(result));
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::importSection(
+void BinaryTransform::importSection(
+	bytes& _output,
 	vector<FunctionImport> const& _imports,
-	map<string, size_t> const& _functionTypes
+	IndexMap const& _functionTypes
 )
 {
-	bytes result = lebEncode(_imports.size());
+	size_t const sizePosition = beginSection(_output, Section::IMPORT);
+	lebEncodeTo(_output, _imports.size());
 	for (FunctionImport const& import: _imports)
 	{
 		uint8_t importKind = 0; // function
-		result +=
-			encodeName(import.module) +
-			encodeName(import.externalName) +
-			toBytes(importKind) +
-			lebEncode(_functionTypes.at(import.internalName));
+		encodeName(_output, import.module);
+		encodeName(_output, import.externalName);
+		_output.push_back(importKind);
+		lebEncodeTo(_output, _functionTypes.at(import.internalName));
 	}
-	return makeSection(Section::IMPORT, move(result));
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::functionSection(
+void BinaryTransform::functionSection(
+	bytes& _output,
 	vector<FunctionDefinition> const& _functions,
-	map<string, size_t> const& _functionTypes
+	IndexMap const& _functionTypes
 )
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const sizePosition = beginSection(_output, Section::FUNCTION);
+	lebEncodeTo(_output, _functions.size());
 	for (auto const& fun: _functions)
-		result += lebEncode(_functionTypes.at(fun.name));
-	return makeSection(Section::FUNCTION, move(result));
+		lebEncodeTo(_output, _functionTypes.at(fun.name));
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::memorySection()
+void BinaryTransform::memorySection(bytes& _output)
 {
-	bytes result = lebEncode(1);
-	result.push_back(static_cast<uint8_t>(LimitsKind::Min));
-	result.push_back(1); // initial length
-	return makeSection(Section::MEMORY, move(result));
+	size_t const sizePosition = beginSection(_output, Section::MEMORY);
+	lebEncodeTo(_output, 1);
+	append(_output, LimitsKind::Min);
+	_output.push_back(1); // initial length
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::globalSection(vector<wasm::GlobalVariableDeclaration> const& _globals)
+void BinaryTransform::globalSection(bytes& _output, vector<wasm::GlobalVariableDeclaration> const& _globals)
 {
-	bytes result = lebEncode(_globals.size());
+	size_t const sizePosition = beginSection(_output, Section::GLOBAL);
+	lebEncodeTo(_output, _globals.size());
 	for (wasm::GlobalVariableDeclaration const& global: _globals)
 	{
 		ValueType globalType = toValueType(global.type);
-		result +=
-			toBytes(globalType) +
-			lebEncode(static_cast<uint8_t>(Mutability::Var)) +
-			toBytes(constOpcodeFor(globalType)) +
-			lebEncodeSigned(0) +
-			toBytes(Opcode::End);
+		append(_output, globalType);
+		lebEncodeTo(_output, static_cast<uint8_t>(Mutability::Var));
+		append(_output, constOpcodeFor(globalType));
+		lebEncodeSignedTo(_output, 0);
+		append(_output, Opcode::End);
 	}
-
-	return makeSection(Section::GLOBAL, move(result));
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::exportSection(map<string, size_t> const& _functionIDs)
+void BinaryTransform::exportSection(bytes& _output, IndexMap const& _functionIDs)
 {
 	bool hasMain = _functionIDs.count("main");
-	bytes result = lebEncode(hasMain ? 2 : 1);
-	result += encodeName("memory") + toBytes(Export::Memory) + lebEncode(0);
+	size_t const sizePosition = beginSection(_output, Section::EXPORT);
+	lebEncodeTo(_output, hasMain ? 2 : 1);
+	encodeName(_output, "memory");
+	append(_output, Export::Memory);
+	lebEncodeTo(_output, 0);
 	if (hasMain)
-		result += encodeName("main") + toBytes(Export::Function) + lebEncode(_functionIDs.at("main"));
-	return makeSection(Section::EXPORT, move(result));
+	{
+		encodeName(_output, "main");
+		append(_output, Export::Function);
+		lebEncodeTo(_output, _functionIDs.at("main"));
+	}
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::customSection(string const& _name, bytes _data)
+void BinaryTransform::customSection(bytes& _output, string const& _name, bytes const& _data)
 {
-	bytes result = encodeName(_name) + move(_data);
-	return makeSection(Section::CUSTOM, move(result));
+	size_t const sizePosition = beginSection(_output, Section::CUSTOM);
+	encodeName(_output, _name);
+	_output += _data;
+	endSizePrefix(_output, sizePosition);
 }
 
-bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
+void BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	size_t const sizePosition = beginSection(m_output, Section::CODE);
+	lebEncodeTo(m_output, _functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, move(result));
+		(*this)(fun);
+	endSizePrefix(m_output, sizePosition);
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
-{
-	bytes result;
-	for (auto const& expr: _expressions | ranges::views::reverse)
-		result += std::visit(*this, expr);
-	return result;
-}
-
-bytes BinaryTransform::encodeLabelIdx(string const& _label) const
+void BinaryTransform::encodeLabelIdx(string const& _label)
 {
 	yulAssert(!_label.empty(), "Empty label.");
 	size_t depth = 0;
 	for (string const& label: m_labels | ranges::views::reverse)
 		if (label == _label)
-			return lebEncode(depth);
+		{
+			lebEncodeTo(m_output, depth);
+			return;
+		}
 		else
 			++depth;
 	yulAssert(false, "Label not found.");
 }
 
-bytes BinaryTransform::encodeName(string const& _name)
+void BinaryTransform::encodeName(bytes& _output, string const& _name)
 {
 	// UTF-8 is allowed here by the Wasm spec, but since all names here should stem from
 	// Solidity or Yul identifiers or similar, non-ascii characters ending up here
 	// is a very bad sign.
 	for (char c: _name)
 		yulAssert(uint8_t(c) <= 0x7f, "Non-ascii character found.");
-	return lebEncode(_name.size()) + asBytes(_name);
+	lebEncodeTo(_output, _name.size());
+	_output += asBytes(_name);
 }
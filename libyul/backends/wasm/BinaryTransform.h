@@ -25,8 +25,9 @@
 
 #include <libsolutil/Common.h>
 
+#include <map>
+#include <unordered_map>
 #include <vector>
-#include <stack>
 
 namespace solidity::yul::wasm
 {
@@ -39,32 +40,34 @@ class BinaryTransform
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
+	using IndexMap = std::unordered_map<std::string, size_t>;
+
 	BinaryTransform(
-		std::map<std::string, size_t> _globalIDs,
-		std::map<std::string, size_t> _functionIDs,
-		std::map<std::string, size_t> _functionTypes,
+		bytes& _output,
+		IndexMap _globalIDs,
+		IndexMap _functionIDs,
 		std::map<std::string, std::pair<size_t, size_t>> _subModulePosAndSize
 	):
+		m_output(_output),
 		m_globalIDs(std::move(_globalIDs)),
 		m_functionIDs(std::move(_functionIDs)),
-		m_functionTypes(std::move(_functionTypes)),
 		m_subModulePosAndSize(std::move(_subModulePosAndSize))
 	{}
 
@@ -81,42 +84,46 @@ private:
 		std::vector<wasm::FunctionDefinition> const& _functions
 	);
 
-	static std::map<std::string, size_t> enumerateGlobals(Module const& _module);
-	static std::map<std::string, size_t> enumerateFunctions(Module const& _module);
-	static std::map<std::string, size_t> enumerateFunctionTypes(
+	static IndexMap enumerateGlobals(Module const& _module);
+	static IndexMap enumerateFunctions(Module const& _module);
+	static IndexMap enumerateFunctionTypes(
 		std::map<Type, std::vector<std::string>> const& _typeToFunctionMap
 	);
 
-	static bytes typeSection(std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
-	static bytes importSection(
+	/// The section writers append the complete section to @a _output.
+	static void typeSection(bytes& _output, std::map<Type, std::vector<std::string>> const& _typeToFunctionMap);
+	static void importSection(
+		bytes& _output,
 		std::vector<wasm::FunctionImport> const& _imports,
-		std::map<std::string, size_t> const& _functionTypes
+		IndexMap const& _functionTypes
 	);
-	static bytes functionSection(
+	static void functionSection(
+		bytes& _output,
 		std::vector<wasm::FunctionDefinition> const& _functions,
-		std::map<std::string, size_t> const& _functionTypes
+		IndexMap const& _functionTypes
 	);
-	static bytes memorySection();
-	static bytes globalSection(std::vector<wasm::GlobalVariableDeclaration> const& _globals);
-	static bytes exportSection(std::map<std::string, size_t> const& _functionIDs);
-	static bytes customSection(std::string const& _name, bytes _data);
-	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
+	static void memorySection(bytes& _output);
+	static void globalSection(bytes& _output, std::vector<wasm::GlobalVariableDeclaration> const& _globals);
+	static void exportSection(bytes& _output, IndexMap const& _functionIDs);
+	static void customSection(bytes& _output, std::string const& _name, bytes const& _data);
+	void codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
 
-	bytes encodeLabelIdx(std::string const& _label) const;
+	void encodeLabelIdx(std::string const& _label);
 
-	static bytes encodeName(std::string const& _name);
+	static void encodeName(bytes& _output, std::string const& _name);
 
-	std::map<std::string, size_t> const m_globalIDs;
-	std::map<std::string, size_t> const m_functionIDs;
-	std::map<std::string, size_t> const m_functionTypes;
+	/// The binary of the module. The code is appended to it directly, so that the encoding of nested
+	/// expressions and functions does not have to be copied into the encoding of their parents.
+	bytes& m_output;
+	IndexMap const m_globalIDs;
+	IndexMap const m_functionIDs;
 	/// The map of submodules, where the pair refers to the [offset, length]. The offset is
 	/// an absolute offset within the resulting assembled bytecode.
 	std::map<std::string, std::pair<size_t, size_t>> const m_subModulePosAndSize;
 
-	std::map<std::string, size_t> m_locals;
+	IndexMap m_locals;
 	std::vector<std::string> m_labels;
 };
 
@@ -31,6 +31,7 @@
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
@@ -45,6 +46,10 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <libsolutil/Parallel.h>
+
+#include <mutex>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -66,7 +71,7 @@ using namespace solidity::langutil;
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
 	if (!m_polyfill)
-		parsePolyfill();
+		m_polyfill = polyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -86,8 +91,8 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
+	NameDisplacer{nameDispenser, m_polyfill->functions}(ast);
+	for (auto const& st: m_polyfill->code->statements)
 		ast.statements.emplace_back(ASTCopier{}.translate(st));
 
 	Object ret;
@@ -112,17 +117,35 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		yulAssert(false, message);
 	}
 
-	for (auto const& subObjectNode: _object.subObjects)
-		if (Object const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
-			ret.subObjects.push_back(make_shared<Object>(run(*subObject)));
+	// Sub-objects are translated independently of each other, so they can be translated
+	// concurrently if the optimiser suite may use multiple threads.
+	ret.subObjects.resize(_object.subObjects.size());
+	size_t const threads = OptimiserSuite::ParallelismActivation::threads();
+	util::parallelFor(_object.subObjects.size(), threads, [&](size_t _index) {
+		OptimiserSuite::ParallelismActivation parallelismActivation(1);
+		ObjectNode const& subObjectNode = *_object.subObjects[_index];
+		if (Object const* subObject = dynamic_cast<Object const*>(&subObjectNode))
+			ret.subObjects[_index] = make_shared<Object>(run(*subObject));
 		else
-			ret.subObjects.push_back(make_shared<Data>(dynamic_cast<Data const&>(*subObjectNode)));
+			ret.subObjects[_index] = make_shared<Data>(dynamic_cast<Data const&>(subObjectNode));
+	});
 	ret.subIndexByName = _object.subIndexByName;
 
 	return ret;
 }
 
-void EVMToEwasmTranslator::parsePolyfill()
+shared_ptr<EVMToEwasmTranslator::Polyfill const> EVMToEwasmTranslator::polyfill()
+{
+	static shared_ptr<Polyfill const> polyfill;
+	static mutex polyfillMutex;
+	static YulStringRepository::ResetCallback callback{[&] { polyfill.reset(); }};
+	lock_guard lock(polyfillMutex);
+	if (!polyfill)
+		polyfill = parsePolyfill();
+	return polyfill;
+}
+
+shared_ptr<EVMToEwasmTranslator::Polyfill const> EVMToEwasmTranslator::parsePolyfill()
 {
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
@@ -141,7 +164,8 @@ void EVMToEwasmTranslator::parsePolyfill()
 	// Passing an empty SourceLocation() here is a workaround to prevent a crash
 	// when compiling from yul->ewasm. We're stripping nativeLocation and
 	// originLocation from the AST (but we only really need to strip nativeLocation)
-	m_polyfill = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
+	auto polyfill = make_shared<Polyfill>();
+	polyfill->code = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
 	if (!errors.empty())
 	{
 		string message;
@@ -153,7 +177,7 @@ void EVMToEwasmTranslator::parsePolyfill()
 		yulAssert(false, message);
 	}
 
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
+	for (auto const& statement: polyfill->code->statements)
+		polyfill->functions.insert(std::get<FunctionDefinition>(statement).name);
+	return polyfill;
 }
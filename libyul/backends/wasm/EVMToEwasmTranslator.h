@@ -43,13 +43,22 @@ public:
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	/// Parsed polyfill code and the names of its functions.
+	struct Polyfill
+	{
+		std::shared_ptr<Block const> code;
+		std::set<YulString> functions;
+	};
+
+	/// @returns the polyfill, which is only parsed once per process
+	/// (or once after each reset of the YulString repository).
+	static std::shared_ptr<Polyfill const> polyfill();
+	static std::shared_ptr<Polyfill const> parsePolyfill();
 
 	Dialect const& m_dialect;
 	langutil::CharStreamProvider const& m_charStreamProvider;
 
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
+	std::shared_ptr<Polyfill const> m_polyfill;
 };
 
 }
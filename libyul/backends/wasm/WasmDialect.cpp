@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -167,7 +169,9 @@ BuiltinFunction const* WasmDialect::equalityFunction(YulString _type) const
 WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
+	static std::mutex dialectMutex;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	std::lock_guard lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -171,7 +171,6 @@ TypedName ASTCopier::translate(TypedName const& _typedName)
 
 YulString FunctionCopier::translateIdentifier(YulString _name)
 {
-	if (m_translations.count(_name))
-		return m_translations.at(_name);
-	return _name;
+	auto it = m_translations.find(_name);
+	return it != m_translations.end() ? it->second : _name;
 }
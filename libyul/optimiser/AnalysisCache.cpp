@@ -0,0 +1,243 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/AnalysisCache.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+CallGraph const& AnalysisCache::callGraph(Block const& _ast)
+{
+	update(_ast);
+	return m_callGraph;
+}
+
+map<YulString, SideEffects> const& AnalysisCache::functionSideEffects(Block const& _ast)
+{
+	update(_ast);
+	if (!m_functionSideEffects)
+		m_functionSideEffects = SideEffectsPropagator::sideEffects(m_dialect, m_callGraph);
+	return *m_functionSideEffects;
+}
+
+bool AnalysisCache::containsMSize(Block const& _ast)
+{
+	update(_ast);
+	return m_containsMSize;
+}
+
+set<YulString> const& AnalysisCache::ssaVariables(Block const& _ast)
+{
+	// Variables of different units are distinct and cannot be assigned to from other units
+	// only if the AST is grouped.
+	yulAssert(FunctionGrouper::alreadyGrouped(_ast), "");
+	update(_ast);
+	if (!m_ssaVariables)
+	{
+		m_ssaVariables.emplace();
+		for (size_t i = 0; i < _ast.statements.size(); ++i)
+		{
+			UnitAnalysis& unit = *m_currentUnits[i];
+			if (!unit.ssaVariables)
+				unit.ssaVariables = SSAValueTracker::ssaVariables(_ast.statements[i]);
+			*m_ssaVariables += *unit.ssaVariables;
+		}
+	}
+	return *m_ssaVariables;
+}
+
+map<YulString, uint64_t> const& AnalysisCache::functionHashes(Block const& _ast)
+{
+	update(_ast);
+	if (!m_functionHashes)
+	{
+		m_functionHashes.emplace();
+		for (size_t i = 0; i < _ast.statements.size(); ++i)
+			if (auto const* function = get_if<FunctionDefinition>(&_ast.statements[i]))
+			{
+				UnitAnalysis& unit = *m_currentUnits[i];
+				if (!unit.functionHash)
+					unit.functionHash = BlockHasher::hashFunction(*function);
+				(*m_functionHashes)[function->name] = *unit.functionHash;
+			}
+	}
+	return *m_functionHashes;
+}
+
+size_t AnalysisCache::codeSizeIncludingFunctions(Block const& _ast)
+{
+	update(_ast);
+	return m_codeSizeIncludingFunctions;
+}
+
+map<YulString, size_t> const& AnalysisCache::functionSizes(Block const& _ast)
+{
+	update(_ast);
+	if (!m_functionSizes)
+	{
+		m_functionSizes.emplace();
+		size_t& topLevelSize = (*m_functionSizes)[YulString{}];
+		for (size_t i = 0; i < _ast.statements.size(); ++i)
+		{
+			size_t codeSize = m_currentUnits[i]->codeSize;
+			if (auto const* function = get_if<FunctionDefinition>(&_ast.statements[i]))
+				(*m_functionSizes)[function->name] = codeSize;
+			else
+				topLevelSize += codeSize;
+		}
+	}
+	return *m_functionSizes;
+}
+
+CallGraph AnalysisCache::callGraph(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache)
+		return _context.analysisCache->callGraph(_ast);
+	return CallGraphGenerator::callGraph(_ast);
+}
+
+map<YulString, SideEffects> AnalysisCache::functionSideEffects(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache)
+		return _context.analysisCache->functionSideEffects(_ast);
+	return SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+}
+
+bool AnalysisCache::containsMSize(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache)
+		return _context.analysisCache->containsMSize(_ast);
+	return MSizeFinder::containsMSize(_context.dialect, _ast);
+}
+
+set<YulString> AnalysisCache::ssaVariables(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache && FunctionGrouper::alreadyGrouped(_ast))
+		return _context.analysisCache->ssaVariables(_ast);
+	return SSAValueTracker::ssaVariables(_ast);
+}
+
+map<YulString, uint64_t> const* AnalysisCache::functionHashes(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache)
+		return &_context.analysisCache->functionHashes(_ast);
+	return nullptr;
+}
+
+map<YulString, size_t> AnalysisCache::functionSizes(OptimiserStepContext const& _context, Block const& _ast)
+{
+	if (_context.analysisCache)
+		return _context.analysisCache->functionSizes(_ast);
+	map<YulString, size_t> sizes;
+	sizes[YulString{}] = CodeSize::codeSize(_ast);
+	for (Statement const& statement: _ast.statements)
+		if (auto const* function = get_if<FunctionDefinition>(&statement))
+			sizes[function->name] = CodeSize::codeSize(function->body);
+	return sizes;
+}
+
+void AnalysisCache::update(Block const& _ast)
+{
+	vector<uint64_t> const& unitHashes = m_changeTracker.unitHashes(_ast);
+	vector<shared_ptr<FunctionChangeTracker::UnitCode const>> const& unitCodes = m_changeTracker.unitCodes(_ast);
+	// The tracker only replaces the code of units that changed.
+	if (unitCodes == m_unitCodes)
+		return;
+
+	// Units with the same hash can still differ, so the code is compared as well.
+	auto findUnit = [](
+		multimap<uint64_t, shared_ptr<UnitAnalysis>> const& _units,
+		uint64_t _hash,
+		FunctionChangeTracker::UnitCode const& _code
+	) -> shared_ptr<UnitAnalysis>
+	{
+		auto [begin, end] = _units.equal_range(_hash);
+		for (auto it = begin; it != end; ++it)
+			if (*it->second->code == _code)
+				return it->second;
+		return nullptr;
+	};
+
+	multimap<uint64_t, shared_ptr<UnitAnalysis>> units;
+	vector<shared_ptr<UnitAnalysis>> currentUnits;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		shared_ptr<UnitAnalysis> unit = findUnit(units, unitHashes[i], *unitCodes[i]);
+		if (!unit)
+		{
+			unit = findUnit(m_units, unitHashes[i], *unitCodes[i]);
+			if (!unit)
+			{
+				Statement const& statement = _ast.statements[i];
+				FunctionDefinition const* function = get_if<FunctionDefinition>(&statement);
+				unit = make_shared<UnitAnalysis>(UnitAnalysis{
+					unitCodes[i],
+					CallGraphGenerator::callGraph(statement),
+					MSizeFinder::containsMSize(m_dialect, statement),
+					CodeSize::codeSizeIncludingFunctions(statement),
+					function ? CodeSize::codeSize(function->body) : CodeSize::codeSize(statement),
+					nullopt,
+					nullopt
+				});
+			}
+			units.emplace(unitHashes[i], unit);
+		}
+		currentUnits.emplace_back(std::move(unit));
+	}
+
+	CallGraph callGraph;
+	bool containsMSize = false;
+	size_t codeSizeIncludingFunctions = 0;
+	for (shared_ptr<UnitAnalysis> const& unit: currentUnits)
+	{
+		for (auto const& [function, callees]: unit->callGraph.functionCalls)
+			callGraph.functionCalls[function] += callees;
+		callGraph.functionsWithLoops += unit->callGraph.functionsWithLoops;
+		containsMSize = containsMSize || unit->containsMSize;
+		codeSizeIncludingFunctions += unit->codeSizeIncludingFunctions;
+	}
+
+	if (
+		!m_functionSideEffects ||
+		callGraph.functionCalls != m_callGraph.functionCalls ||
+		callGraph.functionsWithLoops != m_callGraph.functionsWithLoops
+	)
+		m_functionSideEffects.reset();
+	m_callGraph = std::move(callGraph);
+	m_containsMSize = containsMSize;
+	m_codeSizeIncludingFunctions = codeSizeIncludingFunctions;
+	m_ssaVariables.reset();
+	m_functionHashes.reset();
+	m_functionSizes.reset();
+	m_units = std::move(units);
+	m_unitCodes = unitCodes;
+	m_currentUnits = std::move(currentUnits);
+}
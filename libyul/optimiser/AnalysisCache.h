@@ -0,0 +1,128 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for analyses of the AST that are shared between optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+struct OptimiserStepContext;
+
+/**
+ * Caches the call graph, the side effects of user-defined functions, the presence of
+ * the msize instruction, the SSA variables, the structural hashes of functions and the
+ * code sizes between the steps of an optimiser sequence.
+ *
+ * All of these except for the side effects are determined per unit,
+ * i.e. per top-level statement, and cached by the encoded code of the unit provided by the
+ * FunctionChangeTracker. The hash of the code only selects the candidates, an analysis is
+ * only reused for a unit with exactly the same code. Thus only the units that were modified
+ * since the last request are analysed again. The side effects of functions depend on the
+ * whole call graph and are only recomputed if it changed.
+ *
+ * The analyses have to be requested for the full AST before a step modifies it.
+ */
+class AnalysisCache
+{
+public:
+	AnalysisCache(Dialect const& _dialect, FunctionChangeTracker& _changeTracker):
+		m_dialect(_dialect), m_changeTracker(_changeTracker)
+	{}
+
+	CallGraph const& callGraph(Block const& _ast);
+	std::map<YulString, SideEffects> const& functionSideEffects(Block const& _ast);
+	bool containsMSize(Block const& _ast);
+	/// Requires @a _ast to be disambiguated and grouped.
+	std::set<YulString> const& ssaVariables(Block const& _ast);
+	/// @returns BlockHasher::hashFunction of the top-level functions of @a _ast, keyed by name.
+	std::map<YulString, uint64_t> const& functionHashes(Block const& _ast);
+	/// @returns CodeSize::codeSizeIncludingFunctions(_ast).
+	size_t codeSizeIncludingFunctions(Block const& _ast);
+	/// @returns CodeSize::codeSize of the bodies of the top-level functions of @a _ast, keyed by
+	/// name, and CodeSize::codeSize(_ast) for the empty name.
+	std::map<YulString, size_t> const& functionSizes(Block const& _ast);
+
+	/// @returns the call graph of @a _ast, using the cache of @a _context if there is one.
+	static CallGraph callGraph(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns the side effects of the functions in @a _ast, using the cache of @a _context if there is one.
+	static std::map<YulString, SideEffects> functionSideEffects(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns true if @a _ast contains msize, using the cache of @a _context if there is one.
+	static bool containsMSize(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns the variables of @a _ast that are never assigned to, using the cache of
+	/// @a _context if there is one and @a _ast is grouped.
+	static std::set<YulString> ssaVariables(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns the cached hashes of the top-level functions of @a _ast if @a _context has a cache,
+	/// nullptr otherwise.
+	static std::map<YulString, uint64_t> const* functionHashes(OptimiserStepContext const& _context, Block const& _ast);
+	/// @returns the sizes of the top-level functions and statements of @a _ast as in `functionSizes`,
+	/// using the cache of @a _context if there is one.
+	static std::map<YulString, size_t> functionSizes(OptimiserStepContext const& _context, Block const& _ast);
+
+private:
+	struct UnitAnalysis
+	{
+		/// Code of the unit that was analysed.
+		std::shared_ptr<FunctionChangeTracker::UnitCode const> code;
+		CallGraph callGraph;
+		bool containsMSize = false;
+		/// Size of the code of the unit including function definitions.
+		size_t codeSizeIncludingFunctions = 0;
+		/// Size of the body for function definitions, size excluding function definitions otherwise.
+		size_t codeSize = 0;
+		/// Only determined on request.
+		std::optional<std::set<YulString>> ssaVariables;
+		/// Only determined on request and only for function definitions.
+		std::optional<uint64_t> functionHash;
+	};
+
+	/// Analyses the units of @a _ast that changed since the last call and combines the results.
+	void update(Block const& _ast);
+
+	Dialect const& m_dialect;
+	FunctionChangeTracker& m_changeTracker;
+	/// Analyses of the current units, keyed by the hash of their code.
+	std::multimap<uint64_t, std::shared_ptr<UnitAnalysis>> m_units;
+	/// Code of the units the combined results below belong to and their analyses.
+	std::vector<std::shared_ptr<FunctionChangeTracker::UnitCode const>> m_unitCodes;
+	std::vector<std::shared_ptr<UnitAnalysis>> m_currentUnits;
+	CallGraph m_callGraph;
+	bool m_containsMSize = false;
+	size_t m_codeSizeIncludingFunctions = 0;
+	std::optional<std::map<YulString, SideEffects>> m_functionSideEffects;
+	std::optional<std::set<YulString>> m_ssaVariables;
+	std::optional<std::map<YulString, uint64_t>> m_functionHashes;
+	std::optional<std::map<YulString, size_t>> m_functionSizes;
+};
+
+}
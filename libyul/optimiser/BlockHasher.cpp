@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
+#include <libsolutil/CommonData.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -33,7 +35,7 @@ namespace
 {
 static constexpr uint64_t compileTimeLiteralHash(char const* _literal, size_t _n)
 {
-	return (_n == 0) ? BlockHasher::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * BlockHasher::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
+	return (_n == 0) ? ASTHasherBase::fnvEmptyHash : (static_cast<uint64_t>(_literal[0]) * ASTHasherBase::fnvPrime) ^ compileTimeLiteralHash(_literal + 1, _n - 1);
 }
 
 template<size_t N>
@@ -51,6 +53,24 @@ std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 	return result;
 }
 
+uint64_t BlockHasher::hashFunction(FunctionDefinition const& _function)
+{
+	std::map<Block const*, uint64_t> blockHashes;
+	BlockHasher hasher(blockHashes);
+	hasher.hash64(compileTimeLiteralHash("FunctionDefinition"));
+	hasher.hash64(_function.parameters.size());
+	hasher.hash64(_function.returnVariables.size());
+	// Parameters and return variables are numbered like local variables, so that
+	// the references to them from the body are taken into account independently of their names.
+	for (auto const& variable: _function.parameters + _function.returnVariables)
+		hasher.m_variableReferences[variable.name] = VariableReference{
+			hasher.m_internalIdentifierCount++,
+			false
+		};
+	hasher(_function.body);
+	return hasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -192,3 +212,40 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto& externalReference: subBlockHasher.m_externalReferences)
 		(*this)(Identifier{{}, externalReference});
 }
+
+uint64_t ExpressionHasher::run(Expression const& _e)
+{
+	ExpressionHasher hasher;
+	hasher.visit(_e);
+	return hasher.m_hash;
+}
+
+void ExpressionHasher::operator()(Literal const& _literal)
+{
+	hash64(compileTimeLiteralHash("Literal"));
+	// Number literals are compared by value, so we cannot hash their representation.
+	if (_literal.kind == LiteralKind::Number)
+	{
+		u256 value = valueOfNumberLiteral(_literal);
+		for (size_t i = 0; i < 4; ++i)
+			hash64(static_cast<uint64_t>((value >> (64 * i)) & 0xFFFFFFFFFFFFFFFF));
+	}
+	else
+		hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+	hash8(static_cast<uint8_t>(_literal.kind));
+}
+
+void ExpressionHasher::operator()(Identifier const& _identifier)
+{
+	hash64(compileTimeLiteralHash("Identifier"));
+	hash64(_identifier.name.hash());
+}
+
+void ExpressionHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(compileTimeLiteralHash("FunctionCall"));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
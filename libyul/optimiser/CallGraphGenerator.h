@@ -51,6 +51,7 @@ class CallGraphGenerator: public ASTWalker
 {
 public:
 	static CallGraph callGraph(Block const& _ast);
+	static CallGraph callGraph(Statement const& _statement);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _functionCall) override;
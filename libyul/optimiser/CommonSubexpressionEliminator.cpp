@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
@@ -39,7 +40,7 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 {
 	CommonSubexpressionEliminator cse{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		AnalysisCache::functionSideEffects(_context, _ast)
 	};
 	cse(_ast);
 }
@@ -103,25 +104,31 @@ void CommonSubexpressionEliminator::visit(Expression& _e)
 					_e = Identifier{debugDataOf(_e), value->name};
 		}
 	}
-	else
-	{
-		// TODO this search is rather inefficient.
-		for (auto const& [variable, value]: allValues())
-		{
-			assertThrow(value.value, OptimizerException, "");
-			// Prevent using the default value of return variables
-			// instead of literal zeros.
-			if (
-				m_returnVariables.count(variable) &&
-				holds_alternative<Literal>(*value.value) &&
-				valueOfLiteral(get<Literal>(*value.value)) == 0
-			)
-				continue;
-			if (SyntacticallyEqual{}(_e, *value.value) && inScope(variable))
+	else if (auto const* candidates = util::valueOrNullptr(m_replacementCandidates, _e))
+		for (auto const& variable: *candidates)
+			if (AssignedValue const* value = variableValue(variable))
 			{
-				_e = Identifier{debugDataOf(_e), variable};
-				break;
+				assertThrow(value->value, OptimizerException, "");
+				// Prevent using the default value of return variables
+				// instead of literal zeros.
+				if (
+					m_returnVariables.count(variable) &&
+					holds_alternative<Literal>(*value->value) &&
+					valueOfLiteral(get<Literal>(*value->value)) == 0
+				)
+					continue;
+				// We check for syntactic equality again because the value might have changed.
+				if (inScope(variable) && SyntacticallyEqual{}(_e, *value->value))
+				{
+					_e = Identifier{debugDataOf(_e), variable};
+					break;
+				}
 			}
-		}
-	}
+}
+
+void CommonSubexpressionEliminator::assignValue(YulString _variable, Expression const* _value)
+{
+	if (_value)
+		m_replacementCandidates[*_value].insert(_variable);
+	DataFlowAnalyzer::assignValue(_variable, _value);
 }
@@ -24,8 +24,12 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
 
+#include <functional>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -58,8 +62,18 @@ protected:
 	using ASTModifier::visit;
 	void visit(Expression& _e) override;
 
+	void assignValue(YulString _variable, Expression const* _value) override;
+
 private:
 	std::set<YulString> m_returnVariables;
+	/// Variables that were assigned a value syntactically equal to the key at some point.
+	/// Their current values have to be checked before using them as replacement.
+	std::unordered_map<
+		std::reference_wrapper<Expression const>,
+		std::set<YulString>,
+		ExpressionHash,
+		SyntacticallyEqualExpression
+	> m_replacementCandidates;
 };
 
 }
@@ -25,11 +25,14 @@
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 #include <libyul/Exceptions.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/Instruction.h>
+
 #include <libsolutil/CommonData.h>
 #include <libsolutil/cxx20.h>
 
@@ -44,11 +47,18 @@ using namespace solidity::yul;
 
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
-	map<YulString, SideEffects> _functionSideEffects
+	map<YulString, SideEffects> _functionSideEffects,
+	map<YulString, FunctionStoreSummary> _functionStoreSummaries
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
-	m_knowledgeBase(_dialect, [this](YulString _var) { return variableValue(_var); })
+	m_functionStoreSummaries(std::move(_functionStoreSummaries)),
+	m_knowledgeBase(
+		_dialect,
+		[this](YulString _var) { return variableValue(_var); },
+		[this](YulString _var) { return util::valueOrNullptr(m_state.bounds.ranges, _var); },
+		[this](YulString _a, YulString _b) { return m_state.bounds.lessThan.count({_a, _b}) > 0; }
+	)
 {
 	if (auto const* builtin = _dialect.memoryStoreFunction(YulString{}))
 		m_storeFunctionName[static_cast<unsigned>(StoreLoadLocation::Memory)] = builtin->name;
@@ -65,20 +75,20 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 	if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_state.storage, mapTuple([&](auto&& key, auto&& value) {
+		m_state.storage.eraseIf([&](YulString _key, YulString _value) {
 			return
-				!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
-				!m_knowledgeBase.knownToBeEqual(vars->second, value);
-		}));
-		m_state.storage[vars->first] = vars->second;
+				!m_knowledgeBase.knownToBeDifferent(vars->first, _key) &&
+				!m_knowledgeBase.knownToBeEqual(vars->second, _value);
+		});
+		m_state.storage.set(vars->first, vars->second);
 	}
 	else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 	{
 		ASTModifier::operator()(_statement);
-		cxx20::erase_if(m_state.memory, mapTuple([&](auto&& key, auto&& /* value */) {
-			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
-		}));
-		m_state.memory[vars->first] = vars->second;
+		m_state.memory.eraseIf([&](YulString _key, YulString /* _value */) {
+			return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, _key);
+		});
+		m_state.memory.set(vars->first, vars->second);
 	}
 	else
 	{
@@ -117,14 +127,21 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	unordered_map<YulString, YulString> storage = m_state.storage;
-	unordered_map<YulString, YulString> memory = m_state.memory;
+	KnowledgeCheckpoint olderKnowledge = saveKnowledge();
 
-	ASTModifier::operator()(_if);
+	visit(*_if.condition);
+	{
+		ScopedSaveAndRestore boundsResetter(m_state.bounds, Bounds(m_state.bounds));
+		narrowBounds(*_if.condition, true);
+		(*this)(_if.body);
+	}
 
-	joinKnowledge(storage, memory);
+	joinKnowledge(olderKnowledge);
 
 	clearValues(assignedVariableNames(_if.body));
+
+	if (TerminationFinder{m_dialect}.firstUnconditionalControlFlowChange(_if.body.statements).first != TerminationFinder::ControlFlow::FlowOut)
+		narrowBounds(*_if.condition, false);
 }
 
 void DataFlowAnalyzer::operator()(Switch& _switch)
@@ -134,10 +151,12 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		unordered_map<YulString, YulString> storage = m_state.storage;
-		unordered_map<YulString, YulString> memory = m_state.memory;
-		(*this)(_case.body);
-		joinKnowledge(storage, memory);
+		KnowledgeCheckpoint olderKnowledge = saveKnowledge();
+		{
+			ScopedSaveAndRestore boundsResetter(m_state.bounds, Bounds(m_state.bounds));
+			(*this)(_case.body);
+		}
+		joinKnowledge(olderKnowledge);
 
 		set<YulString> variables = assignedVariableNames(_case.body);
 		assignedVariables += variables;
@@ -195,10 +214,24 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 	clearKnowledgeIfInvalidated(_for.body);
 
 	visit(*_for.condition);
-	(*this)(_for.body);
-	clearValues(assignmentsSinceCont.names());
-	clearKnowledgeIfInvalidated(_for.body);
-	(*this)(_for.post);
+	{
+		ScopedSaveAndRestore boundsResetter(m_state.bounds, Bounds(m_state.bounds));
+		narrowBounds(*_for.condition, true);
+		Bounds boundsAtBodyStart;
+		if (assignmentsSinceCont.continueFound())
+			boundsAtBodyStart = m_state.bounds;
+		(*this)(_for.body);
+		clearValues(assignmentsSinceCont.names());
+		// Bounds derived in the body do not hold at a ``continue`` statement before their condition.
+		if (assignmentsSinceCont.continueFound())
+		{
+			m_state.bounds = std::move(boundsAtBodyStart);
+			for (YulString const& name: assignedVariableNames(_for.body))
+				m_state.bounds.erase(name);
+		}
+		clearKnowledgeIfInvalidated(_for.body);
+		(*this)(_for.post);
+	}
 	clearValues(assignedVariables);
 	clearKnowledgeIfInvalidated(*_for.condition);
 	clearKnowledgeIfInvalidated(_for.post);
@@ -218,7 +251,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 {
-	if (YulString const* value = util::valueOrNullptr(m_state.storage, _key))
+	if (YulString const* value = m_state.storage.find(_key))
 		return *value;
 	else
 		return nullopt;
@@ -226,16 +259,47 @@ optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 
 optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 {
-	if (YulString const* value = util::valueOrNullptr(m_state.memory, _key))
+	if (YulString const* value = m_state.memory.find(_key))
 		return *value;
 	else
 		return nullopt;
 }
 
+optional<vector<YulString>> DataFlowAnalyzer::memoryValues(YulString _key, size_t _words)
+{
+	if (_words > m_state.memory.size())
+		return nullopt;
+	if (_words == 1)
+	{
+		// Avoid querying the knowledge base for the common case.
+		if (optional<YulString> value = memoryValue(_key))
+			return vector<YulString>{*value};
+		return nullopt;
+	}
+
+	vector<optional<YulString>> values(_words);
+	m_state.memory.forEach([&](YulString _otherKey, YulString _value) {
+		if (optional<u256> offset = m_knowledgeBase.differenceIfKnownConstant(_otherKey, _key))
+			if (*offset % 32 == 0 && *offset / 32 < _words)
+				values[static_cast<size_t>(*offset / 32)] = _value;
+	});
+
+	vector<YulString> result;
+	for (optional<YulString> const& value: values)
+		if (value)
+			result.emplace_back(*value);
+		else
+			return nullopt;
+	return result;
+}
+
 void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value, bool _isDeclaration)
 {
 	if (!_isDeclaration)
 		clearValues(_variables);
+	else
+		for (auto const& name: _variables)
+			m_state.bounds.erase(name);
 
 	MovableChecker movableChecker{m_dialect, &m_functionSideEffects};
 	if (_value)
@@ -262,11 +326,11 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// assignment to slot denoted by "name"
 			m_state.storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.storage.eraseIf([&name](YulString /* _key */, YulString _value) { return _value == name; });
 			// assignment to slot denoted by "name"
 			m_state.memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			m_state.memory.eraseIf([&name](YulString /* _key */, YulString _value) { return _value == name; });
 		}
 	}
 
@@ -279,9 +343,9 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.memory[*key] = variable;
+				m_state.memory.set(*key, variable);
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.storage[*key] = variable;
+				m_state.storage.set(*key, variable);
 		}
 	}
 }
@@ -297,6 +361,7 @@ void DataFlowAnalyzer::popScope()
 	{
 		m_state.value.erase(name);
 		m_state.references.erase(name);
+		m_state.bounds.erase(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -319,11 +384,15 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	// First clear storage knowledge, because we do not have to clear
 	// storage knowledge of variables whose expression has changed,
 	// since the value is still unchanged.
-	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
-		return _variables.count(key) || _variables.count(value);
-	});
-	cxx20::erase_if(m_state.storage, eraseCondition);
-	cxx20::erase_if(m_state.memory, eraseCondition);
+	auto eraseCondition = [&_variables](YulString _key, YulString _value) {
+		return _variables.count(_key) || _variables.count(_value);
+	};
+	m_state.storage.eraseIf(eraseCondition);
+	m_state.memory.eraseIf(eraseCondition);
+
+	// Bounds only have to be cleared for variables whose value changes.
+	for (auto const& name: _variables)
+		m_state.bounds.erase(name);
 
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& variableToClear: _variables)
@@ -344,6 +413,82 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 	m_state.value[_variable] = {_value, m_loopDepth};
 }
 
+void DataFlowAnalyzer::narrowBounds(Expression const& _condition, bool _holds)
+{
+	if (!m_deriveBounds)
+		return;
+
+	auto narrow = [&](Expression const& _expression, ValueRange const& _range) {
+		Identifier const* identifier = get_if<Identifier>(&_expression);
+		if (!identifier || (_range.min == 0 && _range.max == numeric_limits<u256>::max()))
+			return;
+		ValueRange bounds;
+		if (ValueRange const* knownBounds = util::valueOrNullptr(m_state.bounds.ranges, identifier->name))
+			bounds = *knownBounds;
+		// The bounds can only contradict each other in unreachable code.
+		if (optional<ValueRange> intersection = bounds.intersect(_range))
+			m_state.bounds.ranges[identifier->name] = *intersection;
+	};
+
+	if (Identifier const* identifier = get_if<Identifier>(&_condition))
+	{
+		if (_holds)
+			narrow(*identifier, {1, numeric_limits<u256>::max()});
+		else
+			narrow(*identifier, {0, 0});
+		// The condition is usually split into a variable holding the comparison.
+		if (AssignedValue const* value = variableValue(identifier->name))
+			if (value->value)
+				narrowBounds(*value->value, _holds);
+		return;
+	}
+
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _condition);
+	if (!instruction)
+		return;
+	vector<Expression> const& arguments = *instruction->second;
+	if (instruction->first == evmasm::Instruction::ISZERO)
+		narrowBounds(arguments.at(0), !_holds);
+	else if (instruction->first == evmasm::Instruction::LT || instruction->first == evmasm::Instruction::GT)
+	{
+		// Either smaller < larger or larger <= smaller holds.
+		bool const isLT = instruction->first == evmasm::Instruction::LT;
+		Expression const& smaller = arguments.at(isLT ? 0 : 1);
+		Expression const& larger = arguments.at(isLT ? 1 : 0);
+		ValueRange smallerRange = m_knowledgeBase.valueRange(smaller);
+		ValueRange largerRange = m_knowledgeBase.valueRange(larger);
+		if (_holds)
+		{
+			Identifier const* smallerVariable = get_if<Identifier>(&smaller);
+			Identifier const* largerVariable = get_if<Identifier>(&larger);
+			if (m_deriveRelations && smallerVariable && largerVariable)
+				m_state.bounds.lessThan.emplace(
+					m_knowledgeBase.originalVariable(smallerVariable->name),
+					m_knowledgeBase.originalVariable(largerVariable->name)
+				);
+			if (largerRange.max > 0)
+				narrow(smaller, {0, largerRange.max - 1});
+			if (smallerRange.min < numeric_limits<u256>::max())
+				narrow(larger, {smallerRange.min + 1, numeric_limits<u256>::max()});
+		}
+		else
+		{
+			narrow(smaller, {largerRange.min, numeric_limits<u256>::max()});
+			narrow(larger, {0, smallerRange.max});
+		}
+	}
+}
+
+void DataFlowAnalyzer::Bounds::erase(YulString _variable)
+{
+	ranges.erase(_variable);
+	for (auto it = lessThan.begin(); it != lessThan.end();)
+		if (it->first == _variable || it->second == _variable)
+			it = lessThan.erase(it);
+		else
+			++it;
+}
+
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
@@ -357,33 +502,98 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
-		m_state.storage.clear();
+	{
+		if (auto keys = writtenKeys(StoreLoadLocation::Storage, _expr))
+			clearKnowledgeAbout(StoreLoadLocation::Storage, *keys);
+		else
+			m_state.storage.clear();
+	}
 	if (sideEffects.invalidatesMemory())
-		m_state.memory.clear();
+	{
+		if (auto keys = writtenKeys(StoreLoadLocation::Memory, _expr))
+			clearKnowledgeAbout(StoreLoadLocation::Memory, *keys);
+		else
+			m_state.memory.clear();
+	}
+}
+
+optional<set<u256>> DataFlowAnalyzer::writtenKeys(StoreLoadLocation _location, Expression const& _expression)
+{
+	FunctionCall const* funCall = get_if<FunctionCall>(&_expression);
+	if (!funCall)
+		return set<u256>{};
+
+	set<u256> keys;
+	for (auto const& argument: funCall->arguments)
+		if (auto argumentKeys = writtenKeys(_location, argument))
+			keys += *argumentKeys;
+		else
+			return nullopt;
+
+	auto writes = [&](SideEffects const& _sideEffects) {
+		return (_location == StoreLoadLocation::Storage ? _sideEffects.storage : _sideEffects.memory) == SideEffects::Write;
+	};
+	YulString name = funCall->functionName.name;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(name))
+		return writes(builtin->sideEffects) ? nullopt : optional<set<u256>>{std::move(keys)};
+	if (SideEffects const* sideEffects = valueOrNullptr(m_functionSideEffects, name))
+		if (!writes(*sideEffects))
+			return keys;
+
+	FunctionStoreSummary const* summary = valueOrNullptr(m_functionStoreSummaries, name);
+	if (!summary)
+		return nullopt;
+	optional<WrittenKeys> const& written = _location == StoreLoadLocation::Storage ? summary->storage : summary->memory;
+	if (!written)
+		return nullopt;
+	keys += written->constants;
+	for (size_t index: written->parameters)
+	{
+		Expression const& argument = funCall->arguments.at(index);
+		optional<u256> value;
+		if (Literal const* literal = get_if<Literal>(&argument))
+			value = valueOfLiteral(*literal);
+		else if (Identifier const* identifier = get_if<Identifier>(&argument))
+			value = valueOfIdentifier(identifier->name);
+		if (!value)
+			return nullopt;
+		keys.insert(*value);
+	}
+	return keys;
+}
+
+void DataFlowAnalyzer::clearKnowledgeAbout(StoreLoadLocation _location, set<u256> const& _writtenKeys)
+{
+	if (_writtenKeys.empty())
+		return;
+	JournaledMap& knowledge = _location == StoreLoadLocation::Storage ? m_state.storage : m_state.memory;
+	knowledge.eraseIf([&](YulString _key, YulString /* _value */) {
+		optional<u256> key = valueOfIdentifier(_key);
+		if (!key)
+			return true;
+		for (u256 const& writtenKey: _writtenKeys)
+			if (_location == StoreLoadLocation::Storage ?
+				*key == writtenKey :
+				(*key - writtenKey < 32 || writtenKey - *key < 32)
+			)
+				return true;
+		return false;
+	});
 }
 
-void DataFlowAnalyzer::joinKnowledge(
-	unordered_map<YulString, YulString> const& _olderStorage,
-	unordered_map<YulString, YulString> const& _olderMemory
-)
+DataFlowAnalyzer::KnowledgeCheckpoint DataFlowAnalyzer::saveKnowledge()
 {
-	joinKnowledgeHelper(m_state.storage, _olderStorage);
-	joinKnowledgeHelper(m_state.memory, _olderMemory);
+	return {m_state.storage.checkpoint(), m_state.memory.checkpoint()};
 }
 
-void DataFlowAnalyzer::joinKnowledgeHelper(
-	std::unordered_map<YulString, YulString>& _this,
-	std::unordered_map<YulString, YulString> const& _older
-)
+void DataFlowAnalyzer::joinKnowledge(KnowledgeCheckpoint _olderKnowledge)
 {
-	// We clear if the key does not exist in the older map or if the value is different.
-	// This also works for memory because _older is an "older version"
+	// We clear if the key did not exist at the older point or if the value is different.
+	// This also works for memory because the older point is an "older version"
 	// of m_state.memory and thus any overlapping write would have cleared the keys
 	// that are not known to be different inside m_state.memory already.
-	cxx20::erase_if(_this, mapTuple([&_older](auto&& key, auto&& currentValue){
-		YulString const* oldValue = util::valueOrNullptr(_older, key);
-		return !oldValue || *oldValue != currentValue;
-	}));
+	m_state.storage.joinWith(_olderKnowledge.first);
+	m_state.memory.joinWith(_olderKnowledge.second);
 }
 
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
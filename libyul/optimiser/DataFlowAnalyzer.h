@@ -24,7 +24,9 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/JournaledMap.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/StoreSummaryGenerator.h>
 #include <libyul/YulString.h>
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
@@ -70,7 +72,16 @@ struct AssignedValue
  * If the keys or values are different or non-existent in one branch, the key is deleted.
  * This works also for memory (where addresses overlap) because one branch is always an
  * older version of the other and thus overlapping contents would have been deleted already
- * at the point of assignment.
+ * at the point of assignment. Instead of copying the knowledge at the branching point,
+ * only the modifications since then are recorded, so that the join only has to look at these.
+ *
+ * Furthermore, if enabled by a derived class, bounds of the values of variables compared by
+ * ``lt``, ``gt`` or ``iszero`` are derived from conditions. They are known inside the body of an ``if`` statement and of
+ * a ``for`` loop (including the post block) and after an ``if`` statement whose body does not
+ * continue to the next statement. They are forgotten when the variable is re-assigned.
+ * In the same way, ``lt(a, b)`` for variables ``a`` and ``b`` is recorded as a relation between
+ * them, so that the bounds check of an index against a length already compared in a loop
+ * condition can be removed.
  *
  * The DataFlowAnalyzer currently does not deal with the ``leave`` statement. This is because
  * it only matters at the end of a function body, which is a point in the code a derived class
@@ -85,9 +96,14 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionStoreSummaries
+	///            Storage slots and memory words user-defined functions write to, if known.
+	///            If a function is found, only the knowledge about these keys is cleared
+	///            at calls to it.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		std::map<YulString, FunctionStoreSummary> _functionStoreSummaries = {}
 	);
 
 	using ASTModifier::operator();
@@ -121,26 +137,31 @@ protected:
 	/// for example at points where control flow is merged.
 	void clearValues(std::set<YulString> _names);
 
-	void assignValue(YulString _variable, Expression const* _value);
+	/// Records @a _value as the current value of @a _variable.
+	/// Can be overridden by derived classes to keep track of all assigned values.
+	virtual void assignValue(YulString _variable, Expression const* _value);
+
+	/// Narrows the bounds of the variables compared in @a _condition under the assumption
+	/// that it is nonzero (@a _holds is true) or zero.
+	void narrowBounds(Expression const& _condition, bool _holds);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the block.
 	void clearKnowledgeIfInvalidated(Block const& _block);
 
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
+	/// Only clears the knowledge about the keys that can be written to if these are known.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
-	/// Joins knowledge about storage and memory with an older point in the control-flow.
-	/// This only works if the current state is a direct successor of the older point,
-	/// i.e. `_otherStorage` and `_otherMemory` cannot have additional changes.
-	void joinKnowledge(
-		std::unordered_map<YulString, YulString> const& _olderStorage,
-		std::unordered_map<YulString, YulString> const& _olderMemory
-	);
+	/// Point in the control-flow knowledge about storage and memory can be joined with later.
+	using KnowledgeCheckpoint = std::pair<JournaledMap::Checkpoint, JournaledMap::Checkpoint>;
 
-	static void joinKnowledgeHelper(
-		std::unordered_map<YulString, YulString>& _thisData,
-		std::unordered_map<YulString, YulString> const& _olderData
-	);
+	/// Starts recording changes to the knowledge about storage and memory.
+	KnowledgeCheckpoint saveKnowledge();
+
+	/// Joins knowledge about storage and memory with an older point in the control-flow.
+	/// This only works if the current state is a direct successor of the older point
+	/// and has to be called for the most recent checkpoint that is not yet joined.
+	void joinKnowledge(KnowledgeCheckpoint _olderKnowledge);
 
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
@@ -148,12 +169,24 @@ protected:
 	/// Returns the literal value of the identifier, if it exists.
 	std::optional<u256> valueOfIdentifier(YulString const& _name);
 
+	/// @returns the variables holding the @a _words consecutive memory words starting at
+	/// memory location @a _key, or nullopt if any of them is not known.
+	std::optional<std::vector<YulString>> memoryValues(YulString _key, size_t _words);
+
 	enum class StoreLoadLocation {
 		Memory = 0,
 		Storage = 1,
 		Last = Storage
 	};
 
+	/// @returns the constant keys of @a _location the function calls in @a _expression can
+	/// write to, or nullopt if they are not known.
+	std::optional<std::set<u256>> writtenKeys(StoreLoadLocation _location, Expression const& _expression);
+
+	/// Clears the knowledge about @a _location for all keys that are not known to be
+	/// unaffected by writes to @a _writtenKeys.
+	void clearKnowledgeAbout(StoreLoadLocation _location, std::set<u256> const& _writtenKeys);
+
 	/// Checks if the statement is sstore(a, b) / mstore(a, b)
 	/// where a and b are variables and returns these variables in that case.
 	std::optional<std::pair<YulString, YulString>> isSimpleStore(
@@ -172,17 +205,38 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Storage slots and memory words written by user-defined functions, if known.
+	std::map<YulString, FunctionStoreSummary> m_functionStoreSummaries;
+	/// Whether bounds of values are derived from conditions, which only pays off for derived
+	/// classes that evaluate comparisons.
+	bool m_deriveBounds = false;
+	/// Whether ``lt`` relations between variables are recorded in addition to the bounds.
+	bool m_deriveRelations = false;
 
 private:
+	/// Facts about variables that follow from conditions rather than from their values.
+	struct Bounds
+	{
+		/// Bounds of the values of variables.
+		std::map<YulString, ValueRange> ranges;
+		/// Pairs of variables (a, b) such that ``lt(a, b)`` holds.
+		std::set<std::pair<YulString, YulString>> lessThan;
+
+		/// Forgets all facts involving @a _variable.
+		void erase(YulString _variable);
+	};
+
 	struct State
 	{
 		/// Current values of variables, always movable.
 		std::map<YulString, AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
 		std::unordered_map<YulString, std::set<YulString>> references;
+		/// Bounds of the values of variables in addition to their current values.
+		Bounds bounds;
 
-		std::unordered_map<YulString, YulString> storage;
-		std::unordered_map<YulString, YulString> memory;
+		JournaledMap storage;
+		JournaledMap memory;
 	};
 	State m_state;
 
@@ -20,6 +20,7 @@
  */
 
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/AST.h>
 #include <libsolutil/CommonData.h>
 
@@ -27,9 +28,11 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
-void EquivalentFunctionCombiner::run(OptimiserStepContext&, Block& _ast)
+void EquivalentFunctionCombiner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	EquivalentFunctionCombiner{EquivalentFunctionDetector::run(_ast)}(_ast);
+	EquivalentFunctionCombiner{
+		EquivalentFunctionDetector::run(_ast, AnalysisCache::functionHashes(_context, _ast))
+	}(_ast);
 }
 
 void EquivalentFunctionCombiner::operator()(FunctionCall& _funCall)
@@ -23,16 +23,78 @@
 #include <libyul/optimiser/SyntacticalEquality.h>
 
 #include <libyul/AST.h>
+#include <libyul/Object.h>
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/CommonData.h>
+
+#include <set>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+void collectFunctions(
+	Object const& _object,
+	string const& _path,
+	vector<pair<EquivalentFunctionDetector::QualifiedFunction, FunctionDefinition const*>>& _functions
+)
+{
+	if (_object.code)
+		for (auto const& statement: _object.code->statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				_functions.emplace_back(EquivalentFunctionDetector::QualifiedFunction{_path, function->name}, function);
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			collectFunctions(*subObject, _path + "." + subObject->name.str(), _functions);
+}
+
+}
+
+vector<vector<EquivalentFunctionDetector::QualifiedFunction>> EquivalentFunctionDetector::duplicatesAcrossObjects(
+	Object const& _object
+)
+{
+	vector<pair<QualifiedFunction, FunctionDefinition const*>> functions;
+	collectFunctions(_object, _object.name.str(), functions);
+
+	// Indices into ``functions`` of the groups of equivalent functions, bucketed by hash.
+	map<uint64_t, vector<vector<size_t>>> groupsByHash;
+	for (size_t i = 0; i < functions.size(); ++i)
+	{
+		auto& groups = groupsByHash[BlockHasher::hashFunction(*functions[i].second)];
+		auto group = find_if(groups.begin(), groups.end(), [&](vector<size_t> const& _group) {
+			return SyntacticallyEqual{}.statementEqual(*functions[i].second, *functions[_group.front()].second);
+		});
+		if (group == groups.end())
+			groups.push_back({i});
+		else
+			group->push_back(i);
+	}
+
+	vector<vector<QualifiedFunction>> result;
+	for (auto const& [hash, groups]: groupsByHash)
+		for (auto const& group: groups)
+		{
+			set<string> objects;
+			for (size_t index: group)
+				objects.insert(functions[index].first.objectPath);
+			if (objects.size() < 2)
+				continue;
+			result.emplace_back();
+			for (size_t index: group)
+				result.back().emplace_back(functions[index].first);
+		}
+	return result;
+}
+
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
-	auto& candidates = m_candidates[bodyHash];
+	uint64_t const* cachedHash = m_functionHashes ? util::valueOrNullptr(*m_functionHashes, _fun.name) : nullptr;
+	auto& candidates = m_candidates[cachedHash ? *cachedHash : BlockHasher::hashFunction(_fun)];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
 		{
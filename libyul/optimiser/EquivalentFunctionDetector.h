@@ -24,31 +24,61 @@
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/ASTForward.h>
 
+#include <string>
+#include <vector>
+
 namespace solidity::yul
 {
 
+struct Object;
+
 /**
  * Optimiser component that detects syntactically equivalent functions.
  *
+ * Functions are grouped by BlockHasher::hashFunction, which takes the signature into account
+ * and does not depend on the names of variables, so that usually only functions that are
+ * actually equal end up in the same bucket and are compared.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter
  */
 class EquivalentFunctionDetector: public ASTWalker
 {
 public:
-	static std::map<YulString, FunctionDefinition const*> run(Block& _block)
+	/// @param _functionHashes precomputed BlockHasher::hashFunction of (some of) the functions,
+	/// keyed by name. The hashes of all other functions are computed on the fly.
+	static std::map<YulString, FunctionDefinition const*> run(
+		Block& _block,
+		std::map<YulString, uint64_t> const* _functionHashes = nullptr
+	)
 	{
-		EquivalentFunctionDetector detector{BlockHasher::run(_block)};
+		EquivalentFunctionDetector detector{_functionHashes};
 		detector(_block);
 		return std::move(detector.m_duplicates);
 	}
 
+	/// Function of an object, identified by the path of the object
+	/// (names of the nested objects separated by dots) and the name of the function.
+	struct QualifiedFunction
+	{
+		std::string objectPath;
+		YulString name;
+	};
+	/// Reports syntactically equivalent functions that are defined in different objects
+	/// of the tree rooted at @a _object, e.g. in creation and deployed code.
+	/// These cannot be combined, since the objects are separate code, but they indicate
+	/// helpers that are generated multiple times.
+	/// @returns groups of at least two equivalent functions that span at least two objects.
+	static std::vector<std::vector<QualifiedFunction>> duplicatesAcrossObjects(Object const& _object);
+
 	using ASTWalker::operator();
 	void operator()(FunctionDefinition const& _fun) override;
 
 private:
-	EquivalentFunctionDetector(std::map<Block const*, uint64_t> _blockHashes): m_blockHashes(std::move(_blockHashes)) {}
+	explicit EquivalentFunctionDetector(std::map<YulString, uint64_t> const* _functionHashes = nullptr):
+		m_functionHashes(_functionHashes)
+	{}
 
-	std::map<Block const*, uint64_t> m_blockHashes;
+	std::map<YulString, uint64_t> const* m_functionHashes = nullptr;
 	std::map<uint64_t, std::vector<FunctionDefinition const*>> m_candidates;
 	std::map<YulString, FunctionDefinition const*> m_duplicates;
 };
@@ -72,6 +72,7 @@ class ExpressionJoiner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ExpressionJoiner"};
+	static constexpr bool intraProcedural = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 private:
@@ -23,15 +23,22 @@
 
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/Instruction.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	ExpressionSimplifier{
+		_context.dialect,
+		_context.runExperimental(frontend::ExperimentalOptimisation::ComparisonBounds),
+		_context.runExperimental(frontend::ExperimentalOptimisation::ComparisonRelations)
+	}(_ast);
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -44,4 +51,19 @@ void ExpressionSimplifier::visit(Expression& _expression)
 		[this](YulString _var) { return variableValue(_var); }
 	))
 		_expression = match->action().toExpression(debugDataOf(_expression));
+
+	if (!m_deriveBounds)
+		return;
+	if (auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression))
+		if (
+			instruction->first == evmasm::Instruction::LT ||
+			instruction->first == evmasm::Instruction::GT ||
+			instruction->first == evmasm::Instruction::EQ ||
+			instruction->first == evmasm::Instruction::ISZERO
+		)
+		{
+			ValueRange range = m_knowledgeBase.valueRange(_expression);
+			if (range.isConstant() && SideEffectsCollector(m_dialect, _expression).movable())
+				_expression = Literal{debugDataOf(_expression), LiteralKind::Number, YulString{formatNumber(range.min)}, {}};
+		}
 }
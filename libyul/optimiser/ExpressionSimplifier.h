@@ -39,19 +39,31 @@ struct OptimiserStepContext;
  * It tracks the current values of variables using the DataFlowAnalyzer
  * and takes them into account for replacements.
  *
+ * With the experimental optimisation ``comparisonBounds``, comparisons whose result
+ * follows from the bounds of the values of their arguments are replaced by the result.
+ * This removes, for example, overflow checks of counters that are compared to a bound
+ * in the condition of a loop. With ``comparisonRelations`` in addition, comparisons of
+ * variables that were compared in an enclosing condition are replaced as well.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class ExpressionSimplifier: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
+	static constexpr bool intraProcedural = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
 	void visit(Expression& _expression) override;
 
 private:
-	explicit ExpressionSimplifier(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+	ExpressionSimplifier(Dialect const& _dialect, bool _foldComparisons, bool _useRelations):
+		DataFlowAnalyzer(_dialect)
+	{
+		m_deriveBounds = _foldComparisons;
+		m_deriveRelations = _useRelations;
+	}
 };
 
 }
@@ -44,6 +44,7 @@ class ForLoopConditionIntoBody: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
+	static constexpr bool intraProcedural = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
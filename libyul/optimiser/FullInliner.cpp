@@ -21,15 +21,19 @@
 
 #include <libyul/optimiser/FullInliner.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Visitor.h>
@@ -40,23 +44,48 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	map<YulString, size_t> functionSizeLimits;
+	for (auto const& [function, executions]: _context.functionExecutions)
+		functionSizeLimits[function] = sizeLimit(_context, executions);
+	FullInliner inliner{
+		_ast,
+		_context.dispenser,
+		_context.dialect,
+		sizeLimit(_context),
+		std::move(functionSizeLimits),
+		AnalysisCache::functionSizes(_context, _ast),
+		_context.runExperimental(frontend::ExperimentalOptimisation::DispatchInlining)
+	};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
-	m_ast(_ast), m_nameDispenser(_dispenser), m_dialect(_dialect)
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	size_t _sizeLimit,
+	map<YulString, size_t> _functionSizeLimits,
+	map<YulString, size_t> _functionSizes,
+	bool _inlineSelectedCases
+):
+	m_ast(_ast),
+	m_functionSizes(std::move(_functionSizes)),
+	m_nameDispenser(_dispenser),
+	m_dialect(_dialect),
+	m_sizeLimit(_sizeLimit),
+	m_functionSizeLimits(std::move(_functionSizeLimits)),
+	m_inlineSelectedCases(_inlineSelectedCases)
 {
 	// Determine constants
 	SSAValueTracker tracker;
 	tracker(m_ast);
 	for (auto const& ssaValue: tracker.values())
 		if (ssaValue.second && holds_alternative<Literal>(*ssaValue.second))
-			m_constants.emplace(ssaValue.first);
+			m_constants.emplace(ssaValue.first, valueOfLiteral(std::get<Literal>(*ssaValue.second)));
 
-	// Store size of global statements.
-	m_functionSizes[YulString{}] = CodeSize::codeSize(_ast);
+	// The sizes of the functions and of the global statements are provided.
+	yulAssert(m_functionSizes.count(YulString{}), "");
 	map<YulString, size_t> references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
@@ -69,7 +98,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		// Always inline functions that are only called once.
 		if (references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
-		updateCodeSize(fun);
+		yulAssert(m_functionSizes.count(fun.name), "");
 	}
 }
 
@@ -99,7 +128,9 @@ void FullInliner::run(Pass _pass)
 	for (FunctionDefinition* fun: functions)
 	{
 		handleBlock(fun->name, fun->body);
-		updateCodeSize(*fun);
+		// The size of functions nothing was inlined into is still accurate.
+		if (m_estimatedSizes.erase(fun->name))
+			updateCodeSize(*fun);
 	}
 
 	for (auto& statement: m_ast.statements)
@@ -169,7 +200,8 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		return false;
 
 	// Inline really, really tiny functions
-	size_t size = m_functionSizes.at(calledFunction->name);
+	optional<size_t> caseSize = m_inlineSelectedCases ? selectedCaseSize(_funCall, *calledFunction) : nullopt;
+	size_t size = caseSize.value_or(m_functionSizes.at(calledFunction->name));
 	if (size <= 1)
 		return true;
 
@@ -196,12 +228,72 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
-	return (size < 6 || (constantArg && size < 12));
+	size_t const limit = util::valueOrDefault(m_functionSizeLimits, _callSite, m_sizeLimit);
+	return (size < limit || (constantArg && size < 2 * limit));
+}
+
+size_t FullInliner::sizeLimit(OptimiserStepContext const& _context, optional<size_t> _executions)
+{
+	size_t const defaultLimit = 6;
+	// Do not go beyond the limit for the size of functions that still get code inlined.
+	size_t const maxLimit = 30;
+	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	// Functions that are not to be optimised do not get any code inlined.
+	if (_executions == 0)
+		return 0;
+	if (!_context.meter || !evmDialect || !_context.expectedExecutionsPerDeployment)
+		return defaultLimit;
+	if (!_executions && !_context.runExperimental(frontend::ExperimentalOptimisation::GasWeightedInlining))
+		return defaultLimit;
+
+	// Inlining saves the costs of the call on every execution and costs the deployment of the
+	// inlined code, where we assume four bytes of code per AST node.
+	bigint const deployCostsPerNode = 4 * GasMeterVisitor::instructionCosts(evmasm::Instruction::POP, *evmDialect).second;
+	bigint const callCosts =
+		_executions ?
+		GasMeter(*evmDialect, false, *_executions).functionCallCosts() :
+		_context.meter->functionCallCosts();
+	// Rarely executed functions from a profile are optimised for size.
+	size_t const minLimit = _executions ? 2 : defaultLimit;
+	return static_cast<size_t>(max<bigint>(minLimit, min<bigint>(maxLimit, callCosts / deployCostsPerNode)));
+}
+
+optional<size_t> FullInliner::selectedCaseSize(FunctionCall const& _funCall, FunctionDefinition const& _function) const
+{
+	if (_function.body.statements.size() != 1)
+		return nullopt;
+	Switch const* switchStatement = get_if<Switch>(&_function.body.statements.front());
+	Identifier const* selector = switchStatement ? get_if<Identifier>(switchStatement->expression.get()) : nullptr;
+	if (!selector)
+		return nullopt;
+
+	optional<u256> value;
+	for (size_t i = 0; i < _function.parameters.size(); ++i)
+		if (_function.parameters[i].name == selector->name)
+		{
+			Expression const& argument = _funCall.arguments.at(i);
+			if (Literal const* literal = get_if<Literal>(&argument))
+				value = valueOfLiteral(*literal);
+			else if (Identifier const* identifier = get_if<Identifier>(&argument))
+				if (u256 const* constant = util::valueOrNullptr(m_constants, identifier->name))
+					value = *constant;
+			break;
+		}
+	if (!value)
+		return nullopt;
+
+	for (Case const& switchCase: switchStatement->cases)
+		if (!switchCase.value || valueOfLiteral(*switchCase.value) == *value)
+			return CodeSize::codeSize(switchCase.body);
+	return 0;
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
 {
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
+	m_estimatedSizes.insert(_callSite);
+	// Inlining can turn indirect recursion into direct recursion.
+	m_recursiveFunctions.erase(_callSite);
 }
 
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
@@ -214,10 +306,15 @@ void FullInliner::handleBlock(YulString _currentFunctionName, Block& _block)
 	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
 }
 
-bool FullInliner::recursive(FunctionDefinition const& _fun) const
+bool FullInliner::recursive(FunctionDefinition const& _fun)
 {
-	map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	auto [it, inserted] = m_recursiveFunctions.try_emplace(_fun.name, false);
+	if (inserted)
+	{
+		map<YulString, size_t> references = ReferencesCounter::countReferences(_fun);
+		it->second = references[_fun.name] > 0;
+	}
+	return it->second;
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -274,6 +371,11 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 		newStatements.emplace_back(std::move(varDecl));
 	};
 
+	newStatements.reserve(
+		function->parameters.size() +
+		2 * function->returnVariables.size() +
+		function->body.statements.size()
+	);
 	for (size_t i = 0; i < _funCall.arguments.size(); ++i)
 		newVariable(function->parameters[i], &_funCall.arguments[i]);
 	for (auto const& var: function->returnVariables)
@@ -328,8 +430,6 @@ Statement BodyCopier::operator()(FunctionDefinition const&)
 
 YulString BodyCopier::translateIdentifier(YulString _name)
 {
-	if (m_variableReplacements.count(_name))
-		return m_variableReplacements.at(_name);
-	else
-		return _name;
+	auto it = m_variableReplacements.find(_name);
+	return it != m_variableReplacements.end() ? it->second : _name;
 }
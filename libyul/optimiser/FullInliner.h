@@ -30,6 +30,9 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <libsolutil/Numeric.h>
+
+#include <map>
 #include <optional>
 #include <set>
 #include <utility>
@@ -64,6 +67,17 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * Small functions are inlined. With the experimental optimisation ``GasWeightedInlining``,
+ * the size limit for runtime code grows with the expected number of executions if a gas
+ * meter is available, since the costs of the call are paid on every execution, while the
+ * additional code is only deployed once.
+ * Functions with an individual number of executions in the optimiser context use their
+ * own limit for the calls inside them, which can also be smaller than the default.
+ * Nothing is inlined into functions with zero expected executions.
+ * With the experimental optimisation ``DispatchInlining``, if a function only consists of a switch
+ * over one of its parameters and the call passes a constant for it, only the size of the selected case counts. This inlines dispatch functions, like the ones
+ * for internal function pointers, at call sites where the target is known.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -93,16 +107,34 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		Dialect const& _dialect,
+		size_t _sizeLimit,
+		std::map<YulString, size_t> _functionSizeLimits,
+		std::map<YulString, size_t> _functionSizes,
+		bool _inlineSelectedCases
+	);
 	void run(Pass _pass);
 
+	/// @returns the size below which functions are inlined into functions that are not too big
+	/// and are expected to be executed @a _executions times per deployment (or the default
+	/// number of times if not given).
+	static size_t sizeLimit(OptimiserStepContext const& _context, std::optional<size_t> _executions = std::nullopt);
+
 	/// @returns a map containing the maximum depths of a call chain starting at each
 	/// function. For recursive functions, the value is one larger than for all others.
 	std::map<YulString, size_t> callDepths() const;
 
 	void updateCodeSize(FunctionDefinition const& _fun);
 	void handleBlock(YulString _currentFunctionName, Block& _block);
-	bool recursive(FunctionDefinition const& _fun) const;
+	/// @returns true if @a _fun calls itself directly. The result is cached until
+	/// code is inlined into @a _fun.
+	bool recursive(FunctionDefinition const& _fun);
+	/// @returns the size of the case that is executed if @a _function consists of a switch over a
+	/// parameter and @a _funCall passes a constant for it, nullopt otherwise.
+	std::optional<size_t> selectedCaseSize(FunctionCall const& _funCall, FunctionDefinition const& _function) const;
 
 	Pass m_pass;
 	/// The AST to be modified. The root block itself will not be modified, because
@@ -113,11 +145,21 @@ private:
 	std::set<YulString> m_noInlineFunctions;
 	/// Names of functions to always inline.
 	std::set<YulString> m_singleUse;
-	/// Variables that are constants (used for inlining heuristic)
-	std::set<YulString> m_constants;
+	/// Variables that are constants and their values (used for inlining heuristic)
+	std::map<YulString, u256> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Functions whose size in ``m_functionSizes`` is only an estimate because code was inlined into them.
+	std::set<YulString> m_estimatedSizes;
+	/// Cached results of ``recursive``.
+	std::map<YulString, bool> m_recursiveFunctions;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	/// Functions smaller than this are inlined, twice the size if an argument is constant.
+	size_t m_sizeLimit = 6;
+	/// Limits replacing @a m_sizeLimit for calls inside specific functions.
+	std::map<YulString, size_t> m_functionSizeLimits;
+	/// If true, only the size of the selected case counts for a switch over a constant argument.
+	bool m_inlineSelectedCases = false;
 };
 
 /**
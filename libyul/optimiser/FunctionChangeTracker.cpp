@@ -0,0 +1,301 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that keeps track of the functions intra-procedural steps have converged on.
+ */
+
+#include <libyul/optimiser/FunctionChangeTracker.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/Exceptions.h>
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Encodes code including the names of all identifiers. In contrast to the BlockHasher,
+ * any renaming or reordering results in a different encoding. Every node adds its kind
+ * and the number of its children, so that different code cannot have the same encoding.
+ */
+class CodeEncoder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override
+	{
+		tag(Tag::Literal);
+		add(static_cast<uint64_t>(_literal.kind));
+		add(_literal.value.id());
+		add(_literal.type.id());
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		tag(Tag::Identifier);
+		add(_identifier.name.id());
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		tag(Tag::FunctionCall);
+		add(_funCall.functionName.name.id());
+		add(_funCall.arguments.size());
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(ExpressionStatement const& _statement) override
+	{
+		tag(Tag::ExpressionStatement);
+		ASTWalker::operator()(_statement);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		tag(Tag::Assignment);
+		add(_assignment.variableNames.size());
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		tag(Tag::VariableDeclaration);
+		add(_varDecl.variables);
+		add(_varDecl.value != nullptr);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(If const& _if) override
+	{
+		tag(Tag::If);
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		tag(Tag::Switch);
+		add(_switch.cases.size());
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(FunctionDefinition const& _funDef) override
+	{
+		tag(Tag::FunctionDefinition);
+		add(_funDef.name.id());
+		add(_funDef.parameters);
+		add(_funDef.returnVariables);
+		ASTWalker::operator()(_funDef);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		tag(Tag::ForLoop);
+		ASTWalker::operator()(_loop);
+	}
+	void operator()(Break const&) override { tag(Tag::Break); }
+	void operator()(Continue const&) override { tag(Tag::Continue); }
+	void operator()(Leave const&) override { tag(Tag::Leave); }
+	void operator()(Block const& _block) override
+	{
+		tag(Tag::Block);
+		add(_block.statements.size());
+		ASTWalker::operator()(_block);
+	}
+
+	FunctionChangeTracker::UnitCode result() { return std::move(m_code); }
+
+private:
+	enum class Tag: uint64_t
+	{
+		Literal = 1,
+		Identifier,
+		FunctionCall,
+		ExpressionStatement,
+		Assignment,
+		VariableDeclaration,
+		If,
+		Switch,
+		FunctionDefinition,
+		ForLoop,
+		Break,
+		Continue,
+		Leave,
+		Block
+	};
+
+	void tag(Tag _tag) { add(static_cast<uint64_t>(_tag)); }
+	void add(uint64_t _value) { m_code.push_back(_value); }
+	void add(TypedNameList const& _names)
+	{
+		add(_names.size());
+		for (TypedName const& name: _names)
+		{
+			add(name.name.id());
+			add(name.type.id());
+		}
+	}
+
+	FunctionChangeTracker::UnitCode m_code;
+};
+
+}
+
+bool FunctionChangeTracker::run(
+	OptimiserStep const& _step,
+	OptimiserStepContext& _context,
+	Block& _ast,
+	util::ThreadPool* _threadPool
+)
+{
+	yulAssert(_step.isIntraProcedural(), "Only intra-procedural steps can skip functions.");
+	if (!FunctionGrouper::alreadyGrouped(_ast))
+		return false;
+
+	unitHashes(_ast);
+
+	set<uint64_t>& fixpoints = m_fixpoints[_step.name];
+	bool mainBlockChanged = !fixpoints.count(m_unitHashes.front());
+	vector<size_t> changedFunctions;
+	for (size_t i = 1; i < _ast.statements.size(); ++i)
+		if (!fixpoints.count(m_unitHashes[i]))
+			changedFunctions.emplace_back(i);
+
+	m_lastUnitsRun = changedFunctions.size() + (mainBlockChanged ? 1 : 0);
+	if (m_lastUnitsRun == 0)
+		return true;
+
+	size_t chunkCount = 1;
+	if (_threadPool)
+		chunkCount = clamp<size_t>(
+			changedFunctions.size() / MinFunctionsPerChunk,
+			1,
+			_threadPool->threads() * ChunksPerThread
+		);
+
+	if (m_lastUnitsRun == _ast.statements.size() && chunkCount == 1)
+	{
+		_step.run(_context, _ast);
+		yulAssert(
+			m_unitHashes.size() == _ast.statements.size() && FunctionGrouper::alreadyGrouped(_ast),
+			"Intra-procedural step changed the top-level structure of the AST."
+		);
+	}
+	else
+	{
+		// Apply the step to grouped ASTs that only consist of the units that are not known
+		// to be stable. An empty main block takes the place of the main block if it is stable
+		// or part of another chunk. Each chunk is a contiguous range of the changed functions.
+		auto chunkOf = [&](size_t _i) { return _i * chunkCount / changedFunctions.size(); };
+		vector<Block> chunks;
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			chunks.emplace_back(Block{_ast.debugData, {}});
+			chunks.back().statements.emplace_back(Block{std::get<Block>(_ast.statements.front()).debugData, {}});
+		}
+		if (mainBlockChanged)
+			swap(chunks.front().statements.front(), _ast.statements.front());
+		for (size_t i = 0; i < changedFunctions.size(); ++i)
+			chunks[chunkOf(i)].statements.emplace_back(std::move(_ast.statements[changedFunctions[i]]));
+
+		auto runOnChunk = [&](size_t _chunk) { _step.run(_context, chunks[_chunk]); };
+		if (chunkCount > 1)
+			_threadPool->parallelFor(chunkCount, runOnChunk);
+		else
+			runOnChunk(0);
+
+		vector<size_t> positions(chunkCount, 1);
+		for (size_t i = 0; i < changedFunctions.size(); ++i)
+			positions[chunkOf(i)]++;
+		for (size_t i = 0; i < chunkCount; ++i)
+			yulAssert(
+				chunks[i].statements.size() == positions[i] && FunctionGrouper::alreadyGrouped(chunks[i]),
+				"Intra-procedural step changed the top-level structure of the AST."
+			);
+
+		if (mainBlockChanged)
+			swap(chunks.front().statements.front(), _ast.statements.front());
+		fill(positions.begin(), positions.end(), 1);
+		for (size_t i = 0; i < changedFunctions.size(); ++i)
+		{
+			size_t chunk = chunkOf(i);
+			_ast.statements[changedFunctions[i]] = std::move(chunks[chunk].statements[positions[chunk]++]);
+		}
+	}
+
+	auto updateUnit = [&](size_t _index)
+	{
+		UnitCode newCode = code(_ast.statements[_index]);
+		if (newCode == *m_unitCodes[_index])
+			fixpoints.insert(m_unitHashes[_index]);
+		else
+		{
+			m_unitHashes[_index] = hash(newCode);
+			m_unitCodes[_index] = make_shared<UnitCode const>(std::move(newCode));
+		}
+	};
+	if (mainBlockChanged)
+		updateUnit(0);
+	for (size_t index: changedFunctions)
+		updateUnit(index);
+
+	return true;
+}
+
+vector<uint64_t> const& FunctionChangeTracker::unitHashes(Block const& _ast)
+{
+	unitCodes(_ast);
+	return m_unitHashes;
+}
+
+vector<shared_ptr<FunctionChangeTracker::UnitCode const>> const& FunctionChangeTracker::unitCodes(Block const& _ast)
+{
+	if (m_unitCodes.size() != _ast.statements.size())
+	{
+		m_unitHashes.clear();
+		m_unitCodes.clear();
+		for (Statement const& statement: _ast.statements)
+		{
+			auto unitCode = make_shared<UnitCode const>(code(statement));
+			m_unitHashes.emplace_back(hash(*unitCode));
+			m_unitCodes.emplace_back(std::move(unitCode));
+		}
+	}
+	return m_unitCodes;
+}
+
+FunctionChangeTracker::UnitCode FunctionChangeTracker::code(Statement const& _statement)
+{
+	CodeEncoder encoder;
+	encoder.visit(_statement);
+	return encoder.result();
+}
+
+uint64_t FunctionChangeTracker::hash(Statement const& _statement)
+{
+	return hash(code(_statement));
+}
+
+uint64_t FunctionChangeTracker::hash(UnitCode const& _code)
+{
+	uint64_t hash = 0;
+	for (uint64_t value: _code)
+		hash ^= value + 0x9e3779b97f4a7c15u + (hash << 6) + (hash >> 2);
+	return hash;
+}
@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that keeps track of the functions intra-procedural steps have converged on.
+ */
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+class ThreadPool;
+}
+
+namespace solidity::yul
+{
+
+struct OptimiserStep;
+struct OptimiserStepContext;
+
+/**
+ * Remembers, for each intra-procedural optimiser step, the units of code (the main block and
+ * the top-level function definitions of a grouped AST) the step was applied to without
+ * changing them. Since the effect of such a step on a unit only depends on the unit itself,
+ * applying it again to an unchanged unit would not change it either, so these units are
+ * left out of the next application of the step.
+ *
+ * Units are identified by an encoding of their code that includes the names of all identifiers
+ * but not their debug data, and by a hash of that encoding.
+ *
+ * If a thread pool is provided, the units are split into chunks to which the step is
+ * applied concurrently. Since intra-procedural steps do not share state between units,
+ * the result does not depend on the number of threads.
+ *
+ * Prerequisite: Disambiguator, FunctionGrouper
+ */
+class FunctionChangeTracker
+{
+public:
+	/// Applies @a _step to all units of @a _ast it has not converged on yet.
+	/// @returns false without running the step if @a _ast is not grouped.
+	bool run(
+		OptimiserStep const& _step,
+		OptimiserStepContext& _context,
+		Block& _ast,
+		util::ThreadPool* _threadPool = nullptr
+	);
+
+	/// Minimal number of functions per chunk when running on multiple threads.
+	static constexpr size_t MinFunctionsPerChunk = 4;
+	/// Number of chunks per thread, so that threads that finish early can take over work.
+	static constexpr size_t ChunksPerThread = 4;
+
+	/// Encoding of the code of a unit. Units are identical apart from their debug data if and only
+	/// if their encodings are equal, as long as the YulString repository is not reset.
+	using UnitCode = std::vector<uint64_t>;
+
+	/// Has to be called whenever @a _ast was modified other than through `run`.
+	void invalidate() { m_unitHashes.clear(); m_unitCodes.clear(); }
+
+	/// @returns the hashes of the top-level statements of @a _ast, which has to be the AST
+	/// the tracker is used for.
+	std::vector<uint64_t> const& unitHashes(Block const& _ast);
+	/// @returns the encoded code of the top-level statements of @a _ast, which has to be the AST
+	/// the tracker is used for. The encoding of a unit is only replaced if the unit changed.
+	std::vector<std::shared_ptr<UnitCode const>> const& unitCodes(Block const& _ast);
+
+	/// @returns the number of units the last call to `run` applied the step to.
+	size_t lastUnitsRun() const { return m_lastUnitsRun; }
+
+	/// @returns the encoding of the code of @a _statement.
+	static UnitCode code(Statement const& _statement);
+	/// @returns a hash of the code of @a _statement that changes with every modification
+	/// apart from changes to the debug data, unless it collides.
+	static uint64_t hash(Statement const& _statement);
+	static uint64_t hash(UnitCode const& _code);
+
+private:
+	/// Hashes of the units a step did not change, keyed by the name of the step.
+	std::map<std::string, std::set<uint64_t>> m_fixpoints;
+	/// Hashes and encoded code of the top-level statements of the AST, empty if unknown.
+	std::vector<uint64_t> m_unitHashes;
+	std::vector<std::shared_ptr<UnitCode const>> m_unitCodes;
+	size_t m_lastUnitsRun = 0;
+};
+
+}
@@ -18,24 +18,132 @@
 
 #include <libyul/optimiser/FunctionSpecializer.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 #include <libyul/YulString.h>
 #include <libsolutil/CommonData.h>
 
+#include <range/v3/algorithm/all_of.hpp>
 #include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/count.hpp>
 #include <range/v3/view/enumerate.hpp>
 
 #include <variant>
 
 using namespace std;
+using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Determines whether the values of the literal arguments of a call enable simplifications in the
+ * body of the called function: a condition, the result of a builtin call or all arguments of a
+ * builtin call become constants according to the KnowledgeBase that are not constants without
+ * these values.
+ *
+ * Parameters that are reassigned in the body are ignored. The values of variables that are
+ * declared with a single variable and never reassigned are known as well.
+ */
+class SimplificationFinder: public ASTWalker
+{
+public:
+	static bool run(
+		Dialect const& _dialect,
+		FunctionDefinition const& _function,
+		FunctionSpecializer::LiteralArguments const& _arguments
+	)
+	{
+		SimplificationFinder finder{_dialect, assignedVariableNames(_function.body)};
+		for (auto&& [index, argument]: _arguments | ranges::views::enumerate)
+			if (argument && !finder.m_assignedVariables.count(_function.parameters[index].name))
+				finder.m_parameterValues[_function.parameters[index].name] = AssignedValue{&*argument};
+		if (finder.m_parameterValues.empty())
+			return false;
+		finder(_function.body);
+		return finder.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		if (
+			_varDecl.variables.size() == 1 &&
+			_varDecl.value &&
+			!m_assignedVariables.count(_varDecl.variables.front().name)
+		)
+			m_variableValues[_varDecl.variables.front().name] = AssignedValue{_varDecl.value.get()};
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		if (!m_found && m_dialect.builtin(_funCall.functionName.name))
+			m_found =
+				enabledByParameters(_funCall) || (
+					ranges::all_of(_funCall.arguments, [&](Expression const& _argument) {
+						return valueRange(_argument, true).isConstant();
+					}) &&
+					ranges::any_of(_funCall.arguments, [&](Expression const& _argument) {
+						return enabledByParameters(_argument);
+					})
+				);
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(If const& _if) override
+	{
+		m_found = m_found || enabledByParameters(*_if.condition);
+		ASTWalker::operator()(_if);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		m_found = m_found || enabledByParameters(*_switch.expression);
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		m_found = m_found || enabledByParameters(*_loop.condition);
+		ASTWalker::operator()(_loop);
+	}
+
+private:
+	SimplificationFinder(Dialect const& _dialect, set<YulString> _assignedVariables):
+		m_dialect(_dialect),
+		m_assignedVariables(move(_assignedVariables))
+	{}
+
+	bool enabledByParameters(Expression const& _expression)
+	{
+		return valueRange(_expression, true).isConstant() && !valueRange(_expression, false).isConstant();
+	}
+	ValueRange valueRange(Expression const& _expression, bool _withParameters)
+	{
+		return KnowledgeBase(m_dialect, [&](YulString _variable) -> AssignedValue const* {
+			if (_withParameters)
+				if (AssignedValue const* value = util::valueOrNullptr(m_parameterValues, _variable))
+					return value;
+			return util::valueOrNullptr(m_variableValues, _variable);
+		}).valueRange(_expression);
+	}
+
+	Dialect const& m_dialect;
+	set<YulString> const m_assignedVariables;
+	map<YulString, AssignedValue> m_parameterValues;
+	map<YulString, AssignedValue> m_variableValues;
+	bool m_found = false;
+};
+
+}
+
 FunctionSpecializer::LiteralArguments FunctionSpecializer::specializableArguments(
 	FunctionCall const& _f
 )
@@ -64,17 +172,85 @@ void FunctionSpecializer::operator()(FunctionCall& _f)
 	LiteralArguments arguments = specializableArguments(_f);
 
 	if (ranges::any_of(arguments, [](auto& _a) { return _a.has_value(); }))
+		if (optional<YulString> newName = specialization(_f.functionName.name, arguments))
+		{
+			_f.functionName.name = *newName;
+			_f.arguments = util::filter(
+				_f.arguments,
+				applyMap(arguments, [](auto& _a) { return !_a; })
+			);
+		}
+}
+
+optional<YulString> FunctionSpecializer::specialization(
+	YulString _function,
+	LiteralArguments const& _arguments
+)
+{
+	if (!m_bounded)
 	{
-		YulString oldName = move(_f.functionName.name);
-		auto newName = m_nameDispenser.newName(oldName);
+		YulString newName = m_nameDispenser.newName(_function);
+		m_oldToNewMap[_function].emplace_back(make_pair(newName, _arguments));
+		return newName;
+	}
 
-		m_oldToNewMap[oldName].emplace_back(make_pair(newName, arguments));
+	SpecializationKey key = applyMap(_arguments, [](optional<Expression> const& _argument) -> optional<u256> {
+		if (_argument)
+			return valueOfLiteral(get<Literal>(*_argument));
+		return nullopt;
+	});
 
-		_f.functionName.name = newName;
-		_f.arguments = util::filter(
-			_f.arguments,
-			applyMap(arguments, [](auto& _a) { return !_a; })
-		);
+	map<SpecializationKey, YulString>& specializations = m_specializations[_function];
+	if (YulString const* existing = util::valueOrNullptr(specializations, key))
+		return *existing;
+	if (m_rejectedSpecializations.count({_function, key}))
+		return nullopt;
+
+	FunctionDefinition const* function = util::valueOrDefault(m_functions, _function, nullptr);
+	if (
+		!function ||
+		specializations.size() >= maxSpecializationsPerFunction ||
+		!SimplificationFinder::run(m_dialect, *function, _arguments)
+	)
+	{
+		m_rejectedSpecializations.emplace(_function, move(key));
+		return nullopt;
+	}
+
+	YulString newName = m_nameDispenser.newName(_function);
+	specializations[move(key)] = newName;
+	m_oldToNewMap[_function].emplace_back(make_pair(newName, _arguments));
+	return newName;
+}
+
+void FunctionSpecializer::removeStaleSpecializations(
+	map<YulString, map<SpecializationKey, YulString>>& _specializations,
+	map<YulString, FunctionDefinition const*> const& _functions
+)
+{
+	for (auto it = _specializations.begin(); it != _specializations.end();)
+	{
+		FunctionDefinition const* function = util::valueOrDefault(_functions, it->first, nullptr);
+		if (!function)
+		{
+			it = _specializations.erase(it);
+			continue;
+		}
+		map<SpecializationKey, YulString>& specializations = it->second;
+		for (auto specialization = specializations.begin(); specialization != specializations.end();)
+		{
+			FunctionDefinition const* specialized = util::valueOrDefault(_functions, specialization->second, nullptr);
+			if (
+				specialized &&
+				specialization->first.size() == function->parameters.size() &&
+				specialized->parameters.size() == static_cast<size_t>(ranges::count(specialization->first, nullopt)) &&
+				specialized->returnVariables.size() == function->returnVariables.size()
+			)
+				++specialization;
+			else
+				specialization = specializations.erase(specialization);
+		}
+		++it;
 	}
 }
 
@@ -127,8 +303,21 @@ FunctionDefinition FunctionSpecializer::specialize(
 
 void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
 {
+	bool const bounded = _context.runExperimental(frontend::ExperimentalOptimisation::BoundedSpecialization);
+	map<YulString, FunctionDefinition const*> functions;
+	if (bounded)
+	{
+		for (Statement const& statement: _ast.statements)
+			if (auto const* function = get_if<FunctionDefinition>(&statement))
+				functions[function->name] = function;
+		removeStaleSpecializations(_context.functionSpecializations, functions);
+	}
+
 	FunctionSpecializer f{
-		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
+		AnalysisCache::callGraph(_context, _ast).recursiveFunctions(),
+		bounded,
+		move(functions),
+		_context.functionSpecializations,
 		_context.dispenser,
 		_context.dialect
 	};
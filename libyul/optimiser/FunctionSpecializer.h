@@ -47,6 +47,13 @@ namespace solidity::yul
  * Other optimization steps will be able to make more simplifications to the function. The
  * optimization step is mainly useful for functions that would not be inlined.
  *
+ * With the experimental optimisation `boundedSpecialization`, a function is only specialized if the
+ * literal arguments enable simplifications according to the KnowledgeBase, i.e. if they make a
+ * condition, the result of a builtin call or all arguments of a builtin call known constants that
+ * are not known otherwise. Calls with the same literal values share one specialization, also across
+ * repeated runs of the step, and at most `maxSpecializationsPerFunction` specializations are created
+ * for each function.
+ *
  * Prerequisites: Disambiguator, FunctionHoister
  *
  * LiteralRematerialiser is recommended as a prerequisite, even though it's not required for
@@ -59,7 +66,11 @@ public:
 	/// corresponding Expression would be the literal.
 	using LiteralArguments = std::vector<std::optional<Expression>>;
 
+	/// The values of the literal arguments, which identify a specialization of a function.
+	using SpecializationKey = std::vector<std::optional<u256>>;
+
 	static constexpr char const* name{"FunctionSpecializer"};
+	static constexpr size_t maxSpecializationsPerFunction = 8;
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
 	using ASTModifier::operator();
@@ -68,16 +79,33 @@ public:
 private:
 	explicit FunctionSpecializer(
 		std::set<YulString> _recursiveFunctions,
+		bool _bounded,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		std::map<YulString, std::map<SpecializationKey, YulString>>& _specializations,
 		NameDispenser& _nameDispenser,
 		Dialect const& _dialect
 	):
 		m_recursiveFunctions(std::move(_recursiveFunctions)),
+		m_bounded(_bounded),
+		m_functions(std::move(_functions)),
+		m_specializations(_specializations),
 		m_nameDispenser(_nameDispenser),
 		m_dialect(_dialect)
 	{}
 	/// Returns a vector of Expressions, where the index `i` is an expression if the function's
 	/// `i`-th argument can be specialized, nullopt otherwise.
 	LiteralArguments specializableArguments(FunctionCall const& _f);
+	/// @returns the name of the specialization of the function `_function` for the literal
+	/// arguments `_arguments`, creating it if it does not exist yet and is worth creating,
+	/// or nullopt if the call should not be specialized. Without `m_bounded`, every call gets
+	/// a new specialization.
+	std::optional<YulString> specialization(YulString _function, LiteralArguments const& _arguments);
+	/// Removes the specializations of @a _specializations whose function or specialized function
+	/// does not exist in @a _functions anymore or has a different number of parameters or return variables.
+	static void removeStaleSpecializations(
+		std::map<YulString, std::map<SpecializationKey, YulString>>& _specializations,
+		std::map<YulString, FunctionDefinition const*> const& _functions
+	);
 	/// Given a function definition `_f` and its arguments `_arguments`, of which, at least one is a
 	/// literal, this function returns a new function with the literal arguments specialized.
 	///
@@ -105,6 +133,14 @@ private:
 	std::map<YulString, std::vector<std::pair<YulString, LiteralArguments>>> m_oldToNewMap;
 	/// We skip specializing recursive functions. Need backtracking to properly deal with them.
 	std::set<YulString> const m_recursiveFunctions;
+	/// Whether the experimental optimisation `boundedSpecialization` is enabled.
+	bool const m_bounded;
+	/// Function definitions by their names.
+	std::map<YulString, FunctionDefinition const*> const m_functions;
+	/// Existing specializations, including those created by earlier runs.
+	std::map<YulString, std::map<SpecializationKey, YulString>>& m_specializations;
+	/// Literal arguments for which specializing the function was found not to be worth it.
+	std::set<std::pair<YulString, SpecializationKey>> m_rejectedSpecializations;
 
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
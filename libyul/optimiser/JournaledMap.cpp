@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/JournaledMap.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void JournaledMap::set(YulString _key, YulString _value)
+{
+	auto [it, inserted] = m_data.try_emplace(_key, _value);
+	if (inserted)
+		record(_key, nullopt);
+	else if (it->second != _value)
+	{
+		record(_key, it->second);
+		it->second = _value;
+	}
+}
+
+void JournaledMap::erase(YulString _key)
+{
+	auto it = m_data.find(_key);
+	if (it == m_data.end())
+		return;
+	record(_key, it->second);
+	m_data.erase(it);
+}
+
+void JournaledMap::clear()
+{
+	if (m_openCheckpoints > 0)
+		for (auto const& [key, value]: m_data)
+			m_journal.emplace_back(key, value);
+	m_data.clear();
+}
+
+JournaledMap::Checkpoint JournaledMap::checkpoint()
+{
+	++m_openCheckpoints;
+	return m_journal.size();
+}
+
+void JournaledMap::joinWith(Checkpoint _checkpoint)
+{
+	yulAssert(m_openCheckpoints > 0 && _checkpoint <= m_journal.size(), "");
+
+	// Determine the values at the checkpoint of all keys modified since then.
+	// The earliest journal entry of a key contains its value at the checkpoint.
+	unordered_map<YulString, optional<YulString>> olderValues;
+	for (size_t i = m_journal.size(); i > _checkpoint; --i)
+		olderValues[m_journal[i - 1].first] = m_journal[i - 1].second;
+
+	for (auto const& [key, olderValue]: olderValues)
+		if (YulString const* currentValue = find(key))
+			if (!olderValue || *olderValue != *currentValue)
+				erase(key);
+
+	--m_openCheckpoints;
+	if (m_openCheckpoints == 0)
+		m_journal.clear();
+}
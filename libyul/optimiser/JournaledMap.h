@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Map from variable names to variable names that can cheaply be joined with earlier versions of itself.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Map from variable names to variable names that records all modifications made
+ * after a checkpoint in a journal.
+ *
+ * This allows the map to be joined with its version at the checkpoint by only looking
+ * at the entries that were modified since then, instead of keeping a full copy
+ * of the older version. Checkpoints have to be joined in reverse order of their creation.
+ */
+class JournaledMap
+{
+public:
+	using Checkpoint = size_t;
+
+	YulString const* find(YulString _key) const { return util::valueOrNullptr(m_data, _key); }
+	size_t size() const { return m_data.size(); }
+
+	void set(YulString _key, YulString _value);
+	void erase(YulString _key);
+	void clear();
+	/// Removes all entries for which @a _predicate, called with key and value, returns true.
+	template <class Predicate>
+	void eraseIf(Predicate const& _predicate)
+	{
+		for (auto it = m_data.begin(); it != m_data.end();)
+			if (_predicate(it->first, it->second))
+			{
+				record(it->first, it->second);
+				it = m_data.erase(it);
+			}
+			else
+				++it;
+	}
+
+	/// Calls @a _function with the key and value of every entry, in unspecified order.
+	template <class Function>
+	void forEach(Function const& _function) const
+	{
+		for (auto const& [key, value]: m_data)
+			_function(key, value);
+	}
+
+	/// Starts recording modifications.
+	Checkpoint checkpoint();
+	/// Removes all entries whose value differs from their value at @a _checkpoint
+	/// or that did not exist at that point. This is equivalent to intersecting the map
+	/// with a copy taken at the checkpoint.
+	/// Has to be called for the most recent checkpoint that is not yet joined.
+	void joinWith(Checkpoint _checkpoint);
+
+private:
+	void record(YulString _key, std::optional<YulString> _oldValue)
+	{
+		if (m_openCheckpoints > 0)
+			m_journal.emplace_back(_key, _oldValue);
+	}
+
+	std::unordered_map<YulString, YulString> m_data;
+	/// Keys modified since the first open checkpoint together with their previous values.
+	std::vector<std::pair<YulString, std::optional<YulString>>> m_journal;
+	size_t m_openCheckpoints = 0;
+};
+
+}
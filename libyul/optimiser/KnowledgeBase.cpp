@@ -26,6 +26,8 @@
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <libevmasm/Instruction.h>
+
 #include <libsolutil/CommonData.h>
 
 #include <variant>
@@ -86,6 +88,31 @@ optional<u256> KnowledgeBase::valueIfKnownConstant(YulString _a)
 	return {};
 }
 
+optional<ValueRange> ValueRange::intersect(ValueRange const& _other) const
+{
+	ValueRange result{std::max(min, _other.min), std::min(max, _other.max)};
+	if (result.min > result.max)
+		return nullopt;
+	return result;
+}
+
+ValueRange KnowledgeBase::valueRange(Expression const& _expression)
+{
+	m_counter = 0;
+	return valueRangeRecursively(_expression);
+}
+
+YulString KnowledgeBase::originalVariable(YulString _variable) const
+{
+	// Values cannot refer to the variables they are assigned to, so this terminates.
+	while (AssignedValue const* value = m_variableValues(_variable))
+		if (Identifier const* identifier = get_if<Identifier>(value->value))
+			_variable = identifier->name;
+		else
+			break;
+	return _variable;
+}
+
 Expression KnowledgeBase::simplify(Expression _expression)
 {
 	m_counter = 0;
@@ -106,3 +133,153 @@ Expression KnowledgeBase::simplifyRecursively(Expression _expression)
 
 	return _expression;
 }
+
+ValueRange KnowledgeBase::valueRangeRecursively(Expression const& _expression)
+{
+	using evmasm::Instruction;
+	u256 const maxValue = numeric_limits<u256>::max();
+
+	if (m_counter++ > 100)
+		return {};
+
+	if (Literal const* literal = get_if<Literal>(&_expression))
+	{
+		u256 value = valueOfLiteral(*literal);
+		return {value, value};
+	}
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		ValueRange range;
+		if (AssignedValue const* value = m_variableValues(identifier->name))
+			if (value->value)
+				range = valueRangeRecursively(*value->value);
+		if (m_variableBounds)
+			if (ValueRange const* bounds = m_variableBounds(identifier->name))
+				// The ranges can only be disjoint in unreachable code.
+				if (optional<ValueRange> intersection = range.intersect(*bounds))
+					range = *intersection;
+		return range;
+	}
+
+	auto instruction = SimplificationRules::instructionAndArguments(m_dialect, _expression);
+	if (!instruction)
+		return {};
+	vector<Expression> const& arguments = *instruction->second;
+	auto argumentRange = [&](size_t _index) { return valueRangeRecursively(arguments.at(_index)); };
+
+	switch (instruction->first)
+	{
+	case Instruction::LT:
+	case Instruction::GT:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		if (instruction->first == Instruction::GT)
+			swap(a, b);
+		if (a.max < b.min)
+			return {1, 1};
+		if (m_knownLessThan)
+		{
+			Identifier const* smaller = get_if<Identifier>(&arguments.at(instruction->first == Instruction::LT ? 0 : 1));
+			Identifier const* larger = get_if<Identifier>(&arguments.at(instruction->first == Instruction::LT ? 1 : 0));
+			if (smaller && larger)
+			{
+				YulString smallerName = originalVariable(smaller->name);
+				YulString largerName = originalVariable(larger->name);
+				if (m_knownLessThan(smallerName, largerName))
+					return {1, 1};
+				if (m_knownLessThan(largerName, smallerName))
+					return {0, 0};
+			}
+		}
+		if (a.min >= b.max)
+			return {0, 0};
+		return {0, 1};
+	}
+	case Instruction::EQ:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		if (!a.intersect(b))
+			return {0, 0};
+		if (a.isConstant() && b.isConstant())
+			return {1, 1};
+		return {0, 1};
+	}
+	case Instruction::ISZERO:
+	{
+		ValueRange a = argumentRange(0);
+		if (a.min > 0)
+			return {0, 0};
+		if (a.max == 0)
+			return {1, 1};
+		return {0, 1};
+	}
+	case Instruction::SLT:
+	case Instruction::SGT:
+		return {0, 1};
+	case Instruction::BYTE:
+		return {0, 0xff};
+	case Instruction::AND:
+		return {0, std::min(argumentRange(0).max, argumentRange(1).max)};
+	case Instruction::NOT:
+	{
+		ValueRange a = argumentRange(0);
+		return {maxValue - a.max, maxValue - a.min};
+	}
+	case Instruction::ADD:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		if (a.max <= maxValue - b.max)
+			return {a.min + b.min, a.max + b.max};
+		break;
+	}
+	case Instruction::SUB:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		if (a.min >= b.max)
+			return {a.min - b.max, a.max - b.min};
+		break;
+	}
+	case Instruction::MUL:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		if (b.max == 0 || a.max <= maxValue / b.max)
+			return {a.min * b.min, a.max * b.max};
+		break;
+	}
+	case Instruction::DIV:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		// Division by zero results in zero.
+		if (b.min > 0)
+			return {a.min / b.max, a.max / b.min};
+		return {0, a.max};
+	}
+	case Instruction::MOD:
+	{
+		ValueRange a = argumentRange(0);
+		ValueRange b = argumentRange(1);
+		// The modulus by zero is zero.
+		if (b.max == 0)
+			return {0, 0};
+		return {0, std::min(a.max, b.max - 1)};
+	}
+	case Instruction::SHR:
+	{
+		ValueRange shift = argumentRange(0);
+		ValueRange a = argumentRange(1);
+		auto shifted = [](u256 const& _value, u256 const& _shift) {
+			return _shift < 256 ? u256(_value >> static_cast<unsigned>(_shift)) : u256(0);
+		};
+		return {shifted(a.min, shift.max), shifted(a.max, shift.min)};
+	}
+	default:
+		break;
+	}
+	return {};
+}
@@ -29,6 +29,7 @@
 
 #include <map>
 #include <functional>
+#include <limits>
 
 namespace solidity::yul
 {
@@ -36,18 +37,39 @@ namespace solidity::yul
 struct Dialect;
 struct AssignedValue;
 
+/**
+ * Inclusive lower and upper bound of a value.
+ */
+struct ValueRange
+{
+	u256 min = 0;
+	u256 max = std::numeric_limits<u256>::max();
+
+	bool isConstant() const { return min == max; }
+	/// @returns the values in both ranges or nullopt if there are none.
+	std::optional<ValueRange> intersect(ValueRange const& _other) const;
+};
+
 /**
  * Class that can answer questions about values of variables and their relations.
+ *
+ * Bounds of values are derived from the current values of variables and, if provided,
+ * from bounds known for variables, e.g. because of conditions of enclosing branches.
+ * Comparisons of variables can also be decided by known relations between them.
  */
 class KnowledgeBase
 {
 public:
 	KnowledgeBase(
 		Dialect const& _dialect,
-		std::function<AssignedValue const*(YulString)> _variableValues
+		std::function<AssignedValue const*(YulString)> _variableValues,
+		std::function<ValueRange const*(YulString)> _variableBounds = {},
+		std::function<bool(YulString, YulString)> _knownLessThan = {}
 	):
 		m_dialect(_dialect),
-		m_variableValues(std::move(_variableValues))
+		m_variableValues(std::move(_variableValues)),
+		m_variableBounds(std::move(_variableBounds)),
+		m_knownLessThan(std::move(_knownLessThan))
 	{}
 
 	bool knownToBeDifferent(YulString _a, YulString _b);
@@ -56,13 +78,22 @@ public:
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
 	bool knownToBeZero(YulString _a);
 	std::optional<u256> valueIfKnownConstant(YulString _a);
+	/// @returns bounds of the value of @a _expression. Comparisons whose result follows from
+	/// the bounds of their arguments have a constant range.
+	ValueRange valueRange(Expression const& _expression);
+	/// @returns the variable @a _variable is a copy of, following chains of copies,
+	/// or @a _variable itself. Relations between variables refer to these names.
+	YulString originalVariable(YulString _variable) const;
 
 private:
 	Expression simplify(Expression _expression);
 	Expression simplifyRecursively(Expression _expression);
+	ValueRange valueRangeRecursively(Expression const& _expression);
 
 	Dialect const& m_dialect;
 	std::function<AssignedValue const*(YulString)> m_variableValues;
+	std::function<ValueRange const*(YulString)> m_variableBounds;
+	std::function<bool(YulString, YulString)> m_knownLessThan;
 	size_t m_counter = 0;
 };
 
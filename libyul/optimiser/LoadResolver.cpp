@@ -24,6 +24,8 @@
 
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/StoreSummaryGenerator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/SideEffects.h>
@@ -43,12 +45,17 @@ using namespace solidity::yul;
 
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool containsMSize = AnalysisCache::containsMSize(_context, _ast);
+	map<YulString, FunctionStoreSummary> storeSummaries;
+	if (_context.runExperimental(frontend::ExperimentalOptimisation::StoreSummaries))
+		storeSummaries = StoreSummaryGenerator::run(_context.dialect, _ast);
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		AnalysisCache::functionSideEffects(_context, _ast),
+		move(storeSummaries),
 		containsMSize,
-		_context.expectedExecutionsPerDeployment
+		_context.expectedExecutionsPerDeployment,
+		_context.runExperimental(frontend::ExperimentalOptimisation::MultiWordKeccak) ? maxKeccakWords : 1
 	}(_ast);
 }
 
@@ -105,6 +112,7 @@ void LoadResolver::tryEvaluateKeccak(
 		return;
 
 	// The costs are only correct for hashes of 32 bytes or 1 word (when rounded up).
+	// Longer hashes are more expensive, so the estimate stays on the safe side.
 	GasMeter gasMeter{
 		dynamic_cast<EVMDialect const&>(m_dialect),
 		!m_expectedExecutionsPerDeployment,
@@ -129,21 +137,28 @@ void LoadResolver::tryEvaluateKeccak(
 	if (costOfLiteral > costOfKeccak)
 		return;
 
-	optional<YulString> value = memoryValue(memoryKey->name);
-	if (value && inScope(*value))
+	optional<u256> byteLength = valueOfIdentifier(length->name);
+	if (!byteLength || *byteLength > 32 * m_maxKeccakWords)
+		return;
+	size_t const words = max<size_t>(1, static_cast<size_t>((*byteLength + 31) / 32));
+	optional<vector<YulString>> values = memoryValues(memoryKey->name, words);
+	if (!values)
+		return;
+
+	bytes content;
+	content.reserve(32 * words);
+	for (YulString value: *values)
 	{
-		optional<u256> memoryContent = valueOfIdentifier(*value);
-		optional<u256> byteLength = valueOfIdentifier(length->name);
-		if (memoryContent && byteLength && *byteLength <= 32)
-		{
-			bytes contentAsBytes = toBigEndian(*memoryContent);
-			contentAsBytes.resize(static_cast<size_t>(*byteLength));
-			_e = Literal{
-				debugDataOf(_e),
-				LiteralKind::Number,
-				YulString{u256(keccak256(contentAsBytes)).str()},
-				m_dialect.defaultType
-			};
-		}
+		optional<u256> word = inScope(value) ? valueOfIdentifier(value) : nullopt;
+		if (!word)
+			return;
+		content += toBigEndian(*word);
 	}
+	content.resize(static_cast<size_t>(*byteLength));
+	_e = Literal{
+		debugDataOf(_e),
+		LiteralKind::Number,
+		YulString{u256(keccak256(content)).str()},
+		m_dialect.defaultType
+	};
 }
@@ -33,7 +33,12 @@ namespace solidity::yul
  * currently stored in storage resp. memory, if known.
  *
  * Also evaluates simple ``keccak256(a, c)`` when the value at memory location `a` is known and `c`
- * is a constant `<= 32`.
+ * is a constant `<= 32`. With the experimental optimisation ``MultiWordKeccak``, `c` can span
+ * several memory words, as long as the values of all of them are known constants.
+ *
+ * With the experimental optimisation ``StoreSummaries``, calls to functions that only write
+ * to constant storage slots or memory words, or to slots and words given by their arguments,
+ * only clear the knowledge about these keys.
  *
  * Works best if the code is in SSA form.
  *
@@ -46,16 +51,23 @@ public:
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
 
+	/// Maximum number of memory words hashed by a ``keccak256`` call that is evaluated
+	/// with the experimental optimisation ``MultiWordKeccak``.
+	static size_t constexpr maxKeccakWords = 8;
+
 private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, FunctionStoreSummary> _functionStoreSummaries,
 		bool _containsMSize,
-		std::optional<size_t> _expectedExecutionsPerDeployment
+		std::optional<size_t> _expectedExecutionsPerDeployment,
+		size_t _maxKeccakWords
 	):
-		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects), std::move(_functionStoreSummaries)),
 		m_containsMSize(_containsMSize),
-		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
+		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment)),
+		m_maxKeccakWords(_maxKeccakWords)
 	{}
 
 protected:
@@ -68,8 +80,8 @@ protected:
 		std::vector<Expression> const& _arguments
 	);
 
-	/// Evaluates simple ``keccak256(a, c)`` when the value at memory location ``a`` is known and
-	/// `c` is a constant `<= 32`.
+	/// Evaluates ``keccak256(a, c)`` when ``c`` is a constant of at most ``32 * m_maxKeccakWords``
+	/// and the constant values of all memory words from ``a`` to ``a + c`` are known.
 	void tryEvaluateKeccak(
 		Expression& _e,
 		std::vector<Expression> const& _arguments
@@ -79,6 +91,8 @@ protected:
 	bool m_containsMSize = false;
 	/// The --optimize-runs parameter. Value `nullopt` represents creation code.
 	std::optional<size_t> m_expectedExecutionsPerDeployment;
+	/// Maximum number of memory words hashed by a ``keccak256`` call that is evaluated.
+	size_t m_maxKeccakWords = 1;
 };
 
 }
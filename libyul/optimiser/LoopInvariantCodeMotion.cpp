@@ -18,11 +18,15 @@
 
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
-#include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -34,10 +38,16 @@ using namespace solidity::yul;
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	map<YulString, SideEffects> functionSideEffects =
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
-	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+		AnalysisCache::functionSideEffects(_context, _ast);
+	bool containsMSize = AnalysisCache::containsMSize(_context, _ast);
+	set<YulString> ssaVars = AnalysisCache::ssaVariables(_context, _ast);
+	LoopInvariantCodeMotion{
+		_context.dialect,
+		ssaVars,
+		functionSideEffects,
+		containsMSize,
+		_context.runExperimental(frontend::ExperimentalOptimisation::ConstantSlotHoisting)
+	}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -55,16 +65,65 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 	);
 }
 
+namespace
+{
+
+/// Collects the storage slots written to by direct calls to ``sstore`` with a constant slot
+/// and notes whether any other statement writes to storage.
+class StorageWriteCollector: public ASTWalker
+{
+public:
+	StorageWriteCollector(Dialect const& _dialect, map<YulString, SideEffects> const& _functionSideEffects):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		if (!m_slots)
+			return;
+
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+		{
+			if (toEVMInstruction(m_dialect, _functionCall.functionName.name) == evmasm::Instruction::SSTORE)
+				if (Literal const* slot = get_if<Literal>(&_functionCall.arguments.front()))
+				{
+					m_slots->insert(valueOfLiteral(*slot));
+					return;
+				}
+			if (builtin->sideEffects.storage == SideEffects::Write)
+				m_slots.reset();
+		}
+		else if (
+			auto it = m_functionSideEffects.find(_functionCall.functionName.name);
+			it == m_functionSideEffects.end() || it->second.storage == SideEffects::Write
+		)
+			m_slots.reset();
+	}
+
+	optional<set<u256>> const& slots() const { return m_slots; }
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	optional<set<u256>> m_slots = set<u256>{};
+};
+
+}
+
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	optional<set<u256>> const& _storageWriteSlots
 ) const
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable, or it loads from a constant storage slot the loop does not write to
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
@@ -76,17 +135,45 @@ bool LoopInvariantCodeMotion::canBePromoted(
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
 		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
-			return false;
+		{
+			optional<u256> slot = constantStorageLoad(*_varDecl.value);
+			if (!slot || !_storageWriteSlots || _storageWriteSlots->count(*slot))
+				return false;
+			// None of the storage writes in the loop can affect the loaded slot.
+			SideEffects loopSideEffects = _forLoopSideEffects;
+			loopSideEffects.storage = SideEffects::Read;
+			if (!sideEffects.movableRelativeTo(loopSideEffects, m_containsMSize))
+				return false;
+		}
 	}
 	return true;
 }
 
+optional<u256> LoopInvariantCodeMotion::constantStorageLoad(Expression const& _expression) const
+{
+	if (FunctionCall const* functionCall = get_if<FunctionCall>(&_expression))
+		if (toEVMInstruction(m_dialect, functionCall->functionName.name) == evmasm::Instruction::SLOAD)
+			if (Literal const* slot = get_if<Literal>(&functionCall->arguments.front()))
+				return valueOfLiteral(*slot);
+	return nullopt;
+}
+
+optional<set<u256>> LoopInvariantCodeMotion::constantStorageWrites(ForLoop const& _for) const
+{
+	StorageWriteCollector collector{m_dialect, m_functionSideEffects};
+	collector(_for);
+	return collector.slots();
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	optional<set<u256>> storageWriteSlots;
+	if (m_hoistConstantSlotLoads && forLoopSideEffects.storage == SideEffects::Write)
+		storageWriteSlots = constantStorageWrites(_for);
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +186,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, storageWriteSlots))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
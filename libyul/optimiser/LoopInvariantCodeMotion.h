@@ -21,6 +21,10 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+
 namespace solidity::yul
 {
 
@@ -32,6 +36,10 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * With the experimental optimisation ``ConstantSlotHoisting``, a declaration whose value is an
+ * ``sload`` from a constant slot is also moved if the loop writes to storage, as long as all of
+ * those writes are direct ``sstore`` calls to other constant slots.
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -50,23 +58,34 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
-		bool _containsMSize
+		bool _containsMSize,
+		bool _hoistConstantSlotLoads
 	):
 		m_containsMSize(_containsMSize),
+		m_hoistConstantSlotLoads(_hoistConstantSlotLoads),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
 		m_functionSideEffects(_functionSideEffects)
 	{ }
 
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
+	/// @param _storageWriteSlots the constant storage slots written to by the loop, or nullopt if
+	/// the loop writes to storage in a different way.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		std::optional<std::set<u256>> const& _storageWriteSlots
 	) const;
+	/// @returns the constant slot of @a _expression if it is an ``sload`` from a constant slot.
+	std::optional<u256> constantStorageLoad(Expression const& _expression) const;
+	/// @returns the storage slots written to by @a _for if all storage writes in the loop are
+	/// direct calls to ``sstore`` with a constant slot and nullopt otherwise.
+	std::optional<std::set<u256>> constantStorageWrites(ForLoop const& _for) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
 	bool m_containsMSize = true;
+	bool m_hoistConstantSlotLoads = false;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
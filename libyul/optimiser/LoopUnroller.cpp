@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that unrolls loops with a small constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// @returns true if @a _block contains a break or continue that belongs to the enclosing
+/// loop or a function definition.
+bool containsLoopExitOrFunction(Block const& _block)
+{
+	for (Statement const& statement: _block.statements)
+	{
+		bool found = std::visit(util::GenericVisitor{
+			[](Break const&) { return true; },
+			[](Continue const&) { return true; },
+			[](FunctionDefinition const&) { return true; },
+			[](If const& _if) { return containsLoopExitOrFunction(_if.body); },
+			[](Switch const& _switch) {
+				for (Case const& _case: _switch.cases)
+					if (containsLoopExitOrFunction(_case.body))
+						return true;
+				return false;
+			},
+			[](Block const& _nested) { return containsLoopExitOrFunction(_nested); },
+			// Break and continue in nested loops belong to those loops.
+			[](auto const&) { return false; }
+		}, statement);
+		if (found)
+			return true;
+	}
+	return false;
+}
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	LoopUnroller{_context.dialect, _context.dispenser, _context.expectedExecutionsPerDeployment}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	// Unroll nested loops first, so that their copies do not have to be unrolled again.
+	ASTModifier::operator()(_block);
+
+	vector<Statement> statements;
+	statements.reserve(_block.statements.size());
+	for (Statement& statement: _block.statements)
+	{
+		if (holds_alternative<ForLoop>(statement) && !statements.empty())
+			if (optional<vector<Statement>> unrolled = tryUnroll(statements.back(), statement))
+			{
+				statements += std::move(*unrolled);
+				continue;
+			}
+		statements.emplace_back(std::move(statement));
+	}
+	_block.statements = std::move(statements);
+}
+
+optional<vector<Statement>> LoopUnroller::tryUnroll(Statement const& _counter, Statement const& _loop)
+{
+	ForLoop const& loop = get<ForLoop>(_loop);
+	VariableDeclaration const* declaration = get_if<VariableDeclaration>(&_counter);
+	if (
+		!loop.pre.statements.empty() ||
+		!declaration ||
+		declaration->variables.size() != 1 ||
+		!declaration->value ||
+		!holds_alternative<Literal>(*declaration->value) ||
+		loop.post.statements.size() != 1 ||
+		!holds_alternative<Assignment>(loop.post.statements.front())
+	)
+		return nullopt;
+
+	YulString counter = declaration->variables.front().name;
+	u256 start = valueOfLiteral(get<Literal>(*declaration->value));
+
+	optional<u256> end = literalOperand(*loop.condition, evmasm::Instruction::LT, counter, 0u);
+	if (!end)
+		end = literalOperand(*loop.condition, evmasm::Instruction::GT, counter, 1u);
+
+	Assignment const& update = get<Assignment>(loop.post.statements.front());
+	if (!end || update.variableNames.size() != 1 || update.variableNames.front().name != counter)
+		return nullopt;
+	optional<u256> step = literalOperand(*update.value, evmasm::Instruction::ADD, counter, 0u);
+	if (!step)
+		step = literalOperand(*update.value, evmasm::Instruction::ADD, counter, 1u);
+	if (!step || *step == 0)
+		return nullopt;
+
+	if (containsLoopExitOrFunction(loop.body) || assignedVariableNames(loop.body).count(counter))
+		return nullopt;
+
+	optional<size_t> iterationCount = iterations(start, *end, *step);
+	if (!iterationCount)
+		return nullopt;
+
+	size_t const originalSize = CodeSize::codeSize(_loop);
+	size_t const unrolledSize =
+		*iterationCount * (CodeSize::codeSize(loop.body) + CodeSize::codeSize(loop.post));
+	// Creation code is executed once, so it is only unrolled if it does not grow.
+	size_t const budget = m_expectedExecutionsPerDeployment ?
+		min(*m_expectedExecutionsPerDeployment / 10, maxSizeIncrease) :
+		0;
+	if (unrolledSize > originalSize + budget)
+		return nullopt;
+
+	vector<Statement> unrolled;
+	unrolled.reserve(2 * *iterationCount);
+	for (size_t i = 0; i < *iterationCount; ++i)
+	{
+		unrolled.emplace_back(BodyCopier{m_nameDispenser, {}}(loop.body));
+		unrolled.emplace_back(ASTCopier{}.translate(loop.post));
+	}
+	return unrolled;
+}
+
+optional<size_t> LoopUnroller::iterations(u256 _start, u256 const& _end, u256 const& _step)
+{
+	for (size_t count = 0; count <= maxIterations; ++count)
+	{
+		if (!(_start < _end))
+			return count;
+		// Wraps around like the EVM addition.
+		_start += _step;
+	}
+	return nullopt;
+}
+
+optional<u256> LoopUnroller::literalOperand(
+	Expression const& _expression,
+	evmasm::Instruction _instruction,
+	YulString _variable,
+	size_t _variableIndex
+) const
+{
+	FunctionCall const* call = get_if<FunctionCall>(&_expression);
+	if (!call || call->arguments.size() != 2 || toEVMInstruction(m_dialect, call->functionName.name) != _instruction)
+		return nullopt;
+	Identifier const* variable = get_if<Identifier>(&call->arguments[_variableIndex]);
+	Literal const* literal = get_if<Literal>(&call->arguments[1 - _variableIndex]);
+	if (!variable || variable->name != _variable || !literal)
+		return nullopt;
+	return valueOfLiteral(*literal);
+}
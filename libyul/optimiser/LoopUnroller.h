@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser step that unrolls loops with a small constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/YulString.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+class NameDispenser;
+
+/**
+ * Unrolls for loops whose number of iterations is a small constant.
+ *
+ * A loop is unrolled if it is directly preceded by the declaration of its counter with a literal
+ * value, its condition is ``lt(i, N)`` or ``gt(N, i)`` for a literal ``N``, its post block only
+ * consists of ``i := add(i, K)`` (or ``add(K, i)``) for a literal ``K`` and its body neither
+ * assigns to the counter nor contains a ``break`` or ``continue`` that belongs to the loop.
+ *
+ * For example
+ *
+ *   let i := 0
+ *   for { } lt(i, 2) { i := add(i, 1) } { mstore(i, 7) }
+ *
+ * is turned into
+ *
+ *   let i := 0
+ *   { mstore(i, 7) }
+ *   { i := add(i, 1) }
+ *   { mstore(i, 7) }
+ *   { i := add(i, 1) }
+ *
+ * Variables declared in the body are renamed in each copy. The counter is still updated, so that
+ * later steps can propagate its value into the copies.
+ *
+ * Loops with more than ``maxIterations`` iterations are never unrolled. Otherwise, a loop is
+ * unrolled only if the code size grows by at most a budget that depends on the expected number
+ * of executions per deployment: there is no budget for creation code and it is
+ * ``runs / 10`` (capped at ``maxSizeIncrease``) for runtime code.
+ *
+ * Requirements:
+ * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	static size_t constexpr maxIterations = 16;
+	static size_t constexpr maxSizeIncrease = 100;
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopUnroller(
+		Dialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::optional<size_t> _expectedExecutionsPerDeployment
+	):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
+	{}
+
+	/// @returns the statements replacing the for loop @a _loop if it can be unrolled, given that
+	/// @a _counter is the statement directly in front of it.
+	std::optional<std::vector<Statement>> tryUnroll(Statement const& _counter, Statement const& _loop);
+	/// @returns the number of iterations of a loop that counts from @a _start in steps of @a _step
+	/// as long as the counter is less than @a _end, or nullopt if it exceeds maxIterations.
+	static std::optional<size_t> iterations(u256 _start, u256 const& _end, u256 const& _step);
+	/// @returns the literal operand of @a _expression if it is a call to @a _instruction
+	/// with the identifier @a _variable as the argument at index @a _variableIndex and a literal as
+	/// the other argument.
+	std::optional<u256> literalOperand(
+		Expression const& _expression,
+		evmasm::Instruction _instruction,
+		YulString _variable,
+		size_t _variableIndex
+	) const;
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
+};
+
+}
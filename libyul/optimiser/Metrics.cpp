@@ -109,6 +109,13 @@ size_t CodeSize::codeSizeIncludingFunctions(Block const& _block, CodeWeights con
 	return cs.m_size;
 }
 
+size_t CodeSize::codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights)
+{
+	CodeSize cs(false, _weights);
+	cs.visit(_statement);
+	return cs.m_size;
+}
+
 void CodeSize::visit(Statement const& _statement)
 {
 	if (holds_alternative<FunctionDefinition>(_statement) && m_ignoreFunctions)
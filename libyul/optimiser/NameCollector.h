@@ -109,6 +109,8 @@ public:
 
 	std::set<YulString> const& names() const { return m_names; }
 	bool empty() const noexcept { return m_names.empty(); }
+	/// @returns true if the loop body contains a ``continue`` statement of the loop itself.
+	bool continueFound() const noexcept { return m_continueFound; }
 
 private:
 	size_t m_forLoopDepth = 0;
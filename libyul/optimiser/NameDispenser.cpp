@@ -42,17 +42,26 @@ NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, set<Yul
 
 NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(_usedNames.begin(), _usedNames.end())
 {
 }
 
 YulString NameDispenser::newName(YulString _nameHint)
 {
 	YulString name = _nameHint;
-	while (illegalName(name))
+	if (illegalName(name))
 	{
-		m_counter++;
-		name = YulString(_nameHint.str() + "_" + to_string(m_counter));
+		// All candidates share the prefix, so only the counter is rewritten for each of them.
+		string candidate = _nameHint.str() + "_";
+		size_t const prefixLength = candidate.size();
+		do
+		{
+			m_counter++;
+			candidate.resize(prefixLength);
+			candidate += to_string(m_counter);
+			name = YulString(candidate);
+		}
+		while (illegalName(name));
 	}
 	m_usedNames.emplace(name);
 	return name;
@@ -60,11 +69,13 @@ YulString NameDispenser::newName(YulString _nameHint)
 
 bool NameDispenser::illegalName(YulString _name)
 {
-	return isRestrictedIdentifier(m_dialect, _name) || m_usedNames.count(_name);
+	return m_usedNames.count(_name) || isRestrictedIdentifier(m_dialect, _name);
 }
 
 void NameDispenser::reset(Block const& _ast)
 {
-	m_usedNames = NameCollector(_ast).names() + m_reservedNames;
+	set<YulString> names = NameCollector(_ast).names();
+	m_usedNames = {names.begin(), names.end()};
+	m_usedNames.insert(m_reservedNames.begin(), m_reservedNames.end());
 	m_counter = 0;
 }
@@ -25,6 +25,7 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <unordered_set>
 
 namespace solidity::yul
 {
@@ -51,7 +52,7 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
-	std::set<YulString> const& usedNames() { return m_usedNames; }
+	std::unordered_set<YulString> const& usedNames() { return m_usedNames; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
@@ -62,7 +63,8 @@ public:
 
 private:
 	Dialect const& m_dialect;
-	std::set<YulString> m_usedNames;
+	/// Only queried for membership, so the order of the names does not matter.
+	std::unordered_set<YulString> m_usedNames;
 	std::set<YulString> m_reservedNames;
 	size_t m_counter = 0;
 };
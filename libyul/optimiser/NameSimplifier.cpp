@@ -30,6 +30,24 @@
 using namespace solidity::yul;
 using namespace std;
 
+void NameSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	NameSimplifier simplifier{_context, _ast};
+	simplifier(_ast);
+
+	map<YulString, size_t> functionExecutions;
+	for (auto const& [name, executions]: _context.functionExecutions)
+		functionExecutions[util::valueOrDefault(simplifier.m_translations, name, name)] = executions;
+	_context.functionExecutions = std::move(functionExecutions);
+
+	map<YulString, map<vector<optional<u256>>, YulString>> functionSpecializations;
+	for (auto const& [name, specializations]: _context.functionSpecializations)
+		for (auto const& [arguments, specialization]: specializations)
+			functionSpecializations[util::valueOrDefault(simplifier.m_translations, name, name)][arguments] =
+				util::valueOrDefault(simplifier.m_translations, specialization, specialization);
+	_context.functionSpecializations = std::move(functionSpecializations);
+}
+
 NameSimplifier::NameSimplifier(OptimiserStepContext& _context, Block const& _ast):
 	m_context(_context)
 {
@@ -45,10 +45,7 @@ class NameSimplifier: public ASTModifier
 {
 public:
 	static constexpr char const* name{"NameSimplifier"};
-	static void run(OptimiserStepContext& _context, Block& _ast)
-	{
-		NameSimplifier{_context, _ast}(_ast);
-	}
+	static void run(OptimiserStepContext& _context, Block& _ast);
 
 	using ASTModifier::operator();
 	void operator()(VariableDeclaration& _varDecl) override;
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the results of optimising Yul objects.
+ */
+
+#include <libyul/optimiser/OptimisedObjectCache.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+thread_local OptimisedObjectCache* t_activeCache = nullptr;
+
+}
+
+shared_ptr<Block const> OptimisedObjectCache::find(util::h256 const& _key) const
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_objects.find(_key);
+	if (it == m_objects.end())
+		return nullptr;
+	++m_hits;
+	return it->second;
+}
+
+void OptimisedObjectCache::store(util::h256 const& _key, shared_ptr<Block const> _code)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_objects.emplace(_key, std::move(_code));
+}
+
+size_t OptimisedObjectCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_objects.size();
+}
+
+size_t OptimisedObjectCache::hits() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_hits;
+}
+
+OptimisedObjectCache* OptimisedObjectCache::active()
+{
+	return t_activeCache;
+}
+
+OptimisedObjectCache::Activation::Activation(OptimisedObjectCache* _cache):
+	m_previousCache(t_activeCache)
+{
+	t_activeCache = _cache;
+}
+
+OptimisedObjectCache::Activation::~Activation()
+{
+	t_activeCache = m_previousCache;
+}
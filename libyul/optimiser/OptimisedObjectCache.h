@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the results of optimising Yul objects.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimised code of Yul objects, keyed by a hash of the unoptimised object (including its
+ * sub-objects and the debug information it prints) and of the optimiser settings.
+ *
+ * The same object is often optimised multiple times in a compilation, e.g. when a contract
+ * creates another contract. YulStack::optimize() reuses the results stored in the cache activated
+ * for the current thread using OptimisedObjectCache::Activation instead of optimising an object
+ * again. When the EVM backend optimises the already optimised IR once more, the objects differ
+ * from the unoptimised ones, so only repeated sub-objects within that second run hit the cache.
+ *
+ * Since the key is based on the printed object, the native source locations of a reused
+ * object refer to the copy of the object it was stored for. The code stays valid until
+ * YulStringRepository::reset() is called. Access is thread-safe.
+ */
+class OptimisedObjectCache
+{
+public:
+	/// @returns the optimised code stored for @a _key or nullptr if there is none.
+	std::shared_ptr<Block const> find(util::h256 const& _key) const;
+	void store(util::h256 const& _key, std::shared_ptr<Block const> _code);
+	size_t size() const;
+	/// @returns the number of successful lookups so far.
+	size_t hits() const;
+
+	/// @returns the cache activated for the current thread or nullptr.
+	static OptimisedObjectCache* active();
+
+	/// Activates a cache (which can be nullptr) for the current thread until destruction.
+	class Activation
+	{
+	public:
+		explicit Activation(OptimisedObjectCache* _cache);
+		~Activation();
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		OptimisedObjectCache* m_previousCache = nullptr;
+	};
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Block const>> m_objects;
+	mutable size_t m_hits = 0;
+};
+
+}
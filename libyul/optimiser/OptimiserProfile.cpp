@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserProfile.h>
+
+#include <libyul/optimiser/Suite.h>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+thread_local OptimiserProfile* t_activeProfile = nullptr;
+
+void add(OptimiserProfile::Statistics& _statistics, OptimiserProfile::Statistics const& _invocation)
+{
+	_statistics.invocations += _invocation.invocations;
+	_statistics.changes += _invocation.changes;
+	_statistics.wallTime += _invocation.wallTime;
+	_statistics.codeSizeBefore += _invocation.codeSizeBefore;
+	_statistics.codeSizeAfter += _invocation.codeSizeAfter;
+}
+
+double milliseconds(chrono::steady_clock::duration _duration)
+{
+	return chrono::duration<double, milli>(_duration).count();
+}
+
+Json::Value toJson(OptimiserProfile::Statistics const& _statistics)
+{
+	Json::Value result{Json::objectValue};
+	result["invocations"] = Json::UInt64(_statistics.invocations);
+	result["changes"] = Json::UInt64(_statistics.changes);
+	result["wallTimeMs"] = milliseconds(_statistics.wallTime);
+	result["codeSizeBefore"] = Json::UInt64(_statistics.codeSizeBefore);
+	result["codeSizeAfter"] = Json::UInt64(_statistics.codeSizeAfter);
+	return result;
+}
+
+void printRow(ostream& _output, string const& _name, OptimiserProfile::Statistics const& _statistics)
+{
+	_output <<
+		fixed << setprecision(3) << setw(12) << milliseconds(_statistics.wallTime) <<
+		setw(10) << _statistics.invocations <<
+		setw(10) << _statistics.changes <<
+		setw(14) << static_cast<int64_t>(_statistics.codeSizeAfter) - static_cast<int64_t>(_statistics.codeSizeBefore) <<
+		"  " << _name << endl;
+}
+
+}
+
+void OptimiserProfile::record(
+	char _abbreviation,
+	size_t _round,
+	chrono::steady_clock::duration _wallTime,
+	size_t _codeSizeBefore,
+	size_t _codeSizeAfter,
+	bool _changed
+)
+{
+	Statistics invocation{1, _changed ? 1u : 0u, _wallTime, _codeSizeBefore, _codeSizeAfter};
+
+	lock_guard<mutex> lock(m_mutex);
+	add(m_steps[_abbreviation], invocation);
+	if (_round > 0)
+	{
+		if (m_rounds.size() < _round)
+			m_rounds.resize(_round);
+		add(m_rounds[_round - 1], invocation);
+	}
+}
+
+map<char, OptimiserProfile::Statistics> OptimiserProfile::steps() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_steps;
+}
+
+vector<OptimiserProfile::Statistics> OptimiserProfile::rounds() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_rounds;
+}
+
+Json::Value OptimiserProfile::toJson() const
+{
+	Json::Value result{Json::objectValue};
+	result["steps"] = Json::objectValue;
+	for (auto const& [abbreviation, statistics]: steps())
+	{
+		Json::Value step = ::toJson(statistics);
+		step["name"] = OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation);
+		result["steps"][string(1, abbreviation)] = move(step);
+	}
+	result["rounds"] = Json::arrayValue;
+	for (Statistics const& statistics: rounds())
+		result["rounds"].append(::toJson(statistics));
+	return result;
+}
+
+string OptimiserProfile::toString() const
+{
+	ostringstream output;
+	output << setw(12) << "Wall (ms)" << setw(10) << "Count" << setw(10) << "Changes" << setw(14) << "Size change" << endl;
+	output << "Steps:" << endl;
+	for (auto const& [abbreviation, statistics]: steps())
+		printRow(output, string(1, abbreviation) + " " + OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation), statistics);
+	output << "Rounds:" << endl;
+	vector<Statistics> allRounds = rounds();
+	for (size_t round = 0; round < allRounds.size(); ++round)
+		printRow(output, "round " + to_string(round + 1), allRounds[round]);
+	return output.str();
+}
+
+OptimiserProfile* OptimiserProfile::active()
+{
+	return t_activeProfile;
+}
+
+OptimiserProfile::Activation::Activation(OptimiserProfile* _profile):
+	m_previousProfile(t_activeProfile)
+{
+	t_activeProfile = _profile;
+}
+
+OptimiserProfile::Activation::~Activation()
+{
+	t_activeProfile = m_previousProfile;
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Statistics about the invocations of optimiser steps.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Cost and effect of optimiser step invocations, collected by OptimiserSuite in Debug::Profile mode.
+ * The statistics are aggregated per step abbreviation and per round of repeat-until-stable loops
+ * (i.e. bracketed parts of an optimiser sequence). Recording is thread-safe.
+ *
+ * OptimiserSuite::run() profiles all suites it creates while a profile is activated for the
+ * current thread using OptimiserProfile::Activation.
+ */
+class OptimiserProfile
+{
+public:
+	struct Statistics
+	{
+		size_t invocations = 0;
+		/// Number of invocations that changed the AST, ignoring changes that only rename variables.
+		size_t changes = 0;
+		std::chrono::steady_clock::duration wallTime{};
+		/// Sums of CodeSize::codeSizeIncludingFunctions() before and after each invocation.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+
+	/// Records an invocation of the step @a _abbreviation during round @a _round of the innermost
+	/// enclosing repeat-until-stable loop. Rounds are counted from one, zero means that the step
+	/// was not run inside such a loop.
+	void record(
+		char _abbreviation,
+		size_t _round,
+		std::chrono::steady_clock::duration _wallTime,
+		size_t _codeSizeBefore,
+		size_t _codeSizeAfter,
+		bool _changed
+	);
+
+	std::map<char, Statistics> steps() const;
+	/// @returns the statistics of all steps run in a given round, the first element corresponds to round one.
+	std::vector<Statistics> rounds() const;
+
+	Json::Value toJson() const;
+	/// @returns a human-readable table of the statistics.
+	std::string toString() const;
+
+	/// @returns the profile activated for the current thread or nullptr.
+	static OptimiserProfile* active();
+
+	/// Activates a profile (which can be nullptr) for the current thread until destruction.
+	class Activation
+	{
+	public:
+		explicit Activation(OptimiserProfile* _profile);
+		~Activation();
+
+		Activation(Activation const&) = delete;
+		Activation& operator=(Activation const&) = delete;
+
+	private:
+		OptimiserProfile* m_previousProfile = nullptr;
+	};
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<char, Statistics> m_steps;
+	std::vector<Statistics> m_rounds;
+};
+
+}
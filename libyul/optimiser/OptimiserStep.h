@@ -19,18 +19,26 @@
 #pragma once
 
 #include <libyul/Exceptions.h>
+#include <libyul/YulString.h>
 
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::yul
 {
 
 struct Dialect;
 struct Block;
-class YulString;
 class NameDispenser;
+class AnalysisCache;
+class GasMeter;
 
 struct OptimiserStepContext
 {
@@ -39,6 +47,25 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Analyses shared between the steps of a sequence. Not available outside of the optimiser suite.
+	AnalysisCache* analysisCache = nullptr;
+	/// Gas meter for EVM dialects, weighting runtime costs with ``expectedExecutionsPerDeployment``.
+	/// Not available outside of the optimiser suite.
+	GasMeter const* meter = nullptr;
+	/// Expected number of executions per deployment of individual functions, overriding
+	/// ``expectedExecutionsPerDeployment`` for them. Kept up to date when functions are renamed.
+	std::map<YulString, size_t> functionExecutions = {};
+	/// Functions created by the FunctionSpecializer by the name of the specialized function and the
+	/// values of the literal arguments (nullopt for the remaining parameters), reused by later runs
+	/// of the step. Kept up to date when functions are renamed.
+	std::map<YulString, std::map<std::vector<std::optional<u256>>, YulString>> functionSpecializations = {};
+	/// Experimental optimisations the steps should perform, see frontend::ExperimentalOptimisation.
+	std::set<frontend::ExperimentalOptimisation> experimentalOptimisations = {};
+
+	bool runExperimental(frontend::ExperimentalOptimisation _optimisation) const
+	{
+		return experimentalOptimisations.count(_optimisation) > 0;
+	}
 };
 
 
@@ -56,6 +83,10 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	/// @returns true if the effect of the step on the main block and on each function definition
+	/// of a grouped AST only depends on that piece of code itself and the step does not use the
+	/// name dispenser. Such a step can be applied to a subset of the top-level statements.
+	virtual bool isIntraProcedural() const = 0;
 	std::string name;
 };
 
@@ -74,6 +105,17 @@ private:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
 
+	template<typename T>
+	struct HasIntraProceduralFlag
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::intraProcedural, std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
 	void run(OptimiserStepContext& _context, Block& _ast) const override
@@ -87,6 +129,13 @@ public:
 		else
 			return std::nullopt;
 	}
+	bool isIntraProcedural() const override
+	{
+		if constexpr (HasIntraProceduralFlag<Step>::value)
+			return Step::intraProcedural;
+		else
+			return false;
+	}
 };
 
 
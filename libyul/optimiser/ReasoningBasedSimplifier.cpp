@@ -18,7 +18,7 @@
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/SMTSolver.h>
 
-#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -39,7 +39,7 @@ using namespace solidity::smtutil;
 
 void ReasoningBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
+	set<YulString> ssaVars = AnalysisCache::ssaVariables(_context, _ast);
 	ReasoningBasedSimplifier{_context.dialect, ssaVars}(_ast);
 }
 
@@ -63,39 +63,28 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 		return;
 
 	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+	if (check(condition == constantValue(0)) == CheckResult::UNSATISFIABLE)
 	{
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.debugData = debugDataOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(move(trueCondition));
 	}
-	else
+	else if (check(condition != constantValue(0)) == CheckResult::UNSATISFIABLE)
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.debugData = debugDataOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.debugData = debugDataOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
-	m_solver->push();
-	m_solver->addAssertion(condition != constantValue(0));
+	push();
+	addAssertion(condition != constantValue(0));
 
 	ASTModifier::operator()(_if.body);
 
-	m_solver->pop();
+	pop();
 }
 
 ReasoningBasedSimplifier::ReasoningBasedSimplifier(
@@ -42,6 +42,7 @@ class Rematerialiser: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"Rematerialiser"};
+	static constexpr bool intraProcedural = true;
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
@@ -85,6 +86,7 @@ class LiteralRematerialiser: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"LiteralRematerialiser"};
+	static constexpr bool intraProcedural = true;
 	static void run(
 		OptimiserStepContext& _context,
 		Block& _ast
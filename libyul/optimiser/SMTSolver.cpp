@@ -23,10 +23,14 @@
 
 #include <libsolutil/Visitor.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 
 #include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/Helpers.h>
 
+#include <map>
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::smtutil;
@@ -84,7 +88,7 @@ smtutil::Expression SMTSolver::newVariable()
 smtutil::Expression SMTSolver::newRestrictedVariable(bigint _maxValue)
 {
 	smtutil::Expression var = newVariable();
-	m_solver->addAssertion(0 <= var && var <= smtutil::Expression(_maxValue));
+	addAssertion(0 <= var && var <= smtutil::Expression(_maxValue));
 	return var;
 }
 
@@ -135,7 +139,7 @@ smtutil::Expression SMTSolver::wrap(smtutil::Expression _value)
 {
 	smtutil::Expression rest = newRestrictedVariable();
 	smtutil::Expression multiplier = newVariable();
-	m_solver->addAssertion(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
+	addAssertion(_value == multiplier * smtutil::Expression(bigint(1) << 256) + rest);
 	return rest;
 }
 
@@ -153,8 +157,74 @@ void SMTSolver::encodeVariableDeclaration(VariableDeclaration const& _varDecl)
 			m_solver->newVariable("yul_" + variableName.str(), defaultSort())
 		}).second;
 		yulAssert(inserted, "");
-		m_solver->addAssertion(
+		addAssertion(
 			m_variables.at(variableName) == encodeExpression(*_varDecl.value)
 		);
 	}
 }
+
+void SMTSolver::push()
+{
+	m_assertionHashes.emplace_back(m_assertionHashes.back());
+	m_solver->push();
+}
+
+void SMTSolver::pop()
+{
+	yulAssert(m_assertionHashes.size() > 1, "");
+	m_assertionHashes.pop_back();
+	m_solver->pop();
+}
+
+void SMTSolver::addAssertion(smtutil::Expression const& _assertion)
+{
+	m_assertionHashes.back() = keccak256(m_assertionHashes.back().asBytes() + asBytes(toString(_assertion)));
+	m_solver->addAssertion(_assertion);
+}
+
+optional<CheckResult> SMTSolver::check(smtutil::Expression const& _assumption)
+{
+	static mutex cacheMutex;
+	static map<h256, CheckResult> cache;
+
+	h256 query = keccak256(m_assertionHashes.back().asBytes() + asBytes(toString(_assumption)));
+	{
+		lock_guard lock(cacheMutex);
+		if (auto it = cache.find(query); it != cache.end())
+			return it->second;
+	}
+
+	if (m_solverQueries >= queryBudget)
+		return nullopt;
+	++m_solverQueries;
+
+	m_solver->push();
+	m_solver->addAssertion(_assumption);
+	CheckResult result = m_solver->check({}).first;
+	m_solver->pop();
+
+	if (result != CheckResult::ERROR)
+	{
+		lock_guard lock(cacheMutex);
+		// Bound the memory used by long-running processes.
+		if (cache.size() >= 1000000)
+			cache.clear();
+		cache.emplace(query, result);
+	}
+	return result;
+}
+
+string SMTSolver::toString(smtutil::Expression const& _expression)
+{
+	string result = _expression.name;
+	// The sort is determined by the operation and its arguments, apart from the
+	// signedness of integers (e.g. for bv2int).
+	if (_expression.sort->kind == Kind::Int && dynamic_cast<IntSort const&>(*_expression.sort).isSigned)
+		result += "!signed";
+	if (_expression.arguments.empty())
+		return result;
+	result = "(" + result;
+	for (smtutil::Expression const& argument: _expression.arguments)
+		result += " " + toString(argument);
+	return result + ")";
+}
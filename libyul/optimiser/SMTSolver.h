@@ -25,7 +25,10 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <libsolutil/FixedHash.h>
+
 #include <memory>
+#include <optional>
 
 namespace solidity::smtutil
 {
@@ -64,6 +67,21 @@ protected:
 
 	smtutil::Expression encodeExpression(Expression const& _expression);
 
+	/// Wrappers around the solver that also keep track of the current assertions,
+	/// so that the results of queries can be cached.
+	void push();
+	void pop();
+	void addAssertion(smtutil::Expression const& _assertion);
+	/// Checks whether the current assertions together with @a _assumption are satisfiable.
+	/// The results are cached across all runs by the text of the assertions, so that queries
+	/// that recur in later rounds of the optimiser are not sent to the solver again.
+	/// @returns nullopt if the query budget of this run is exhausted.
+	std::optional<smtutil::CheckResult> check(smtutil::Expression const& _assumption);
+
+	/// Maximum number of queries per run that are sent to the solver. Keeps the running time
+	/// bounded on large inputs without the non-determinism of a solver timeout.
+	static size_t constexpr queryBudget = 10000;
+
 	static smtutil::Expression int2bv(smtutil::Expression _arg);
 	static smtutil::Expression bv2int(smtutil::Expression _arg);
 
@@ -86,7 +104,13 @@ protected:
 	Dialect const& m_dialect;
 
 private:
+	/// @returns a textual representation of @a _expression that identifies it uniquely.
+	static std::string toString(smtutil::Expression const& _expression);
+
 	size_t m_varCounter = 0;
+	/// Hash over all assertions of the current and the enclosing scopes, one per scope.
+	std::vector<util::h256> m_assertionHashes{util::h256{}};
+	size_t m_solverQueries = 0;
 };
 
 }
@@ -60,6 +60,16 @@ set<YulString> SSAValueTracker::ssaVariables(Block const& _ast)
 	return ssaVars;
 }
 
+set<YulString> SSAValueTracker::ssaVariables(Statement const& _statement)
+{
+	SSAValueTracker t;
+	t.visit(_statement);
+	set<YulString> ssaVars;
+	for (auto const& value: t.values())
+		ssaVars.insert(value.first);
+	return ssaVars;
+}
+
 void SSAValueTracker::setValue(YulString _name, Expression const* _value)
 {
 	assertThrow(
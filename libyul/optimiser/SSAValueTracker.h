@@ -51,6 +51,9 @@ public:
 	Expression const* value(YulString _name) const { return m_values.at(_name); }
 
 	static std::set<YulString> ssaVariables(Block const& _ast);
+	/// @returns the variables of a top-level statement of a disambiguated and grouped AST
+	/// that are never assigned to.
+	static std::set<YulString> ssaVariables(Statement const& _statement);
 
 private:
 	void setValue(YulString _name, Expression const* _value);
@@ -31,6 +31,9 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Algorithms.h>
 
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view/map.hpp>
+
 #include <limits>
 
 using namespace std;
@@ -94,6 +97,13 @@ bool MSizeFinder::containsMSize(Dialect const& _dialect, Block const& _ast)
 	return finder.m_msizeFound;
 }
 
+bool MSizeFinder::containsMSize(Dialect const& _dialect, Statement const& _statement)
+{
+	MSizeFinder finder(_dialect);
+	finder.visit(_statement);
+	return finder.m_msizeFound;
+}
+
 void MSizeFinder::operator()(FunctionCall const& _functionCall)
 {
 	ASTWalker::operator()(_functionCall);
@@ -123,28 +133,30 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 		ret[function].cannotLoop = false;
 	}
 
-	for (auto const& call: _directCallGraph.functionCalls)
+	// Propagate the side-effects bottom-up along the strongly connected components of the
+	// call graph. All functions in a component call each other and thus share the same
+	// side-effects, while the side-effects of all other called functions are already final.
+	vector<YulString> functions = _directCallGraph.functionCalls | ranges::views::keys | ranges::to<vector>;
+	auto components = util::stronglyConnectedComponents(functions, [&](YulString _function, auto&& _addSuccessor) {
+		for (YulString callee: _directCallGraph.functionCalls.at(_function))
+			if (!_dialect.builtin(callee))
+				_addSuccessor(callee);
+	});
+	for (vector<YulString> const& component: components)
 	{
-		YulString funName = call.first;
 		SideEffects sideEffects;
-		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
-			if (!visited.insert(_function).second)
-				return;
-			if (sideEffects == SideEffects::worst())
-				return;
-			if (BuiltinFunction const* f = _dialect.builtin(_function))
-				sideEffects += f->sideEffects;
-			else
-			{
-				if (ret.count(_function))
-					sideEffects += ret[_function];
-				for (YulString callee: _directCallGraph.functionCalls.at(_function))
-					_recurse(callee, _recurse);
-			}
-		};
-		for (auto const& _v: call.second)
-			_visit(_v, _visit);
-		ret[funName] += sideEffects;
+		for (YulString function: component)
+		{
+			if (ret.count(function))
+				sideEffects += ret[function];
+			for (YulString callee: _directCallGraph.functionCalls.at(function))
+				if (BuiltinFunction const* f = _dialect.builtin(callee))
+					sideEffects += f->sideEffects;
+				else if (!util::contains(component, callee))
+					sideEffects += ret.at(callee);
+		}
+		for (YulString function: component)
+			ret[function] = sideEffects;
 	}
 	return ret;
 }
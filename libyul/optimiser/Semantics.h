@@ -143,6 +143,7 @@ class MSizeFinder: public ASTWalker
 {
 public:
 	static bool containsMSize(Dialect const& _dialect, Block const& _ast);
+	static bool containsMSize(Dialect const& _dialect, Statement const& _statement);
 
 	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
@@ -48,7 +48,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules store the match groups of the last match, so they cannot be shared between threads.
+	static thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -60,8 +61,24 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	vector<Rule> const& candidates = rules.m_rules[uint8_t(instruction->first)];
+	if (candidates.empty())
+		return nullptr;
+
+	ArgumentShapes shapes;
+	if (!argumentShapes(*instruction->second, _dialect, _ssaValues, shapes))
+		return nullptr;
+
+	for (size_t ruleIndex = 0; ruleIndex < candidates.size(); ++ruleIndex)
 	{
+		ArgumentShapes const& ruleShapes = rules.m_argumentShapes[uint8_t(instruction->first)][ruleIndex];
+		bool admitted = true;
+		for (size_t i = 0; i < instruction->second->size() && admitted; ++i)
+			admitted = ruleShapes[i].admits(shapes[i]);
+		if (!admitted)
+			continue;
+
+		Rule const& rule = candidates[ruleIndex];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -70,6 +87,42 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	return nullptr;
 }
 
+bool SimplificationRules::argumentShapes(
+	vector<Expression> const& _arguments,
+	Dialect const& _dialect,
+	function<AssignedValue const*(YulString)> const& _ssaValues,
+	ArgumentShapes& _shapes
+)
+{
+	assertThrow(_arguments.size() <= MaxArguments, OptimizerException, "");
+	for (size_t i = 0; i < _arguments.size(); ++i)
+	{
+		// Function call arguments are rejected by Pattern::matches.
+		if (holds_alternative<FunctionCall>(_arguments[i]))
+			return false;
+
+		// Resolve variables the same way Pattern::matches does for constants and operations.
+		Expression const* argument = &_arguments[i];
+		if (holds_alternative<Identifier>(*argument))
+			if (AssignedValue const* value = _ssaValues(std::get<Identifier>(*argument).name))
+				if (value->value)
+					argument = value->value;
+
+		_shapes[i] = ArgumentShape{};
+		if (holds_alternative<Literal>(*argument))
+		{
+			if (std::get<Literal>(*argument).kind == LiteralKind::Number)
+				_shapes[i].kind = PatternKind::Constant;
+		}
+		else if (auto instructionAndArgs = instructionAndArguments(_dialect, *argument))
+		{
+			_shapes[i].kind = PatternKind::Operation;
+			_shapes[i].instruction = instructionAndArgs->first;
+		}
+	}
+	return true;
+}
+
 bool SimplificationRules::isInitialized() const
 {
 	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
@@ -95,7 +148,17 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
+	ArgumentShapes shapes;
+	vector<Pattern> arguments = _rule.pattern.arguments();
+	assertThrow(arguments.size() <= MaxArguments, OptimizerException, "Too many arguments in rule.");
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		shapes[i].kind = arguments[i].kind();
+		if (arguments[i].kind() == PatternKind::Operation)
+			shapes[i].instruction = arguments[i].instruction();
+	}
 	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_argumentShapes[uint8_t(_rule.pattern.instruction())].push_back(shapes);
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
@@ -129,8 +192,9 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	assertThrow(_group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -203,11 +267,9 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if (Expression const* firstMatch = (*m_matchGroups)[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
-			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
 			assertThrow(
 				!holds_alternative<FunctionCall>(_expr) &&
 				!holds_alternative<FunctionCall>(*firstMatch),
@@ -235,7 +297,7 @@ evmasm::Instruction Pattern::instruction() const
 	return m_instruction;
 }
 
-Expression Pattern::toExpression(shared_ptr<DebugData const> const& _debugData) const
+Expression Pattern::toExpression(DebugData const* _debugData) const
 {
 	if (matchGroup())
 		return ASTCopier().translate(matchGroupValue());
@@ -250,7 +312,7 @@ Expression Pattern::toExpression(shared_ptr<DebugData const> const& _debugData)
 		for (auto const& arg: m_arguments)
 			arguments.emplace_back(arg.toExpression(_debugData));
 
-		string name = util::toLower(instructionInfo(m_instruction).name);
+		string name = util::toLower(string(instructionInfo(m_instruction).name));
 
 		return FunctionCall{_debugData,
 			Identifier{_debugData, YulString{name}},
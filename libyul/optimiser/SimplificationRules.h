@@ -32,6 +32,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -42,6 +43,16 @@ struct Dialect;
 struct AssignedValue;
 class Pattern;
 
+enum class PatternKind
+{
+	Operation,
+	Constant,
+	Any
+};
+
+/// Expressions matched by the match groups of a rule, indexed by the match group identifier.
+using MatchGroups = std::array<Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
  */
@@ -73,20 +84,45 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
+	/// Maximal number of arguments of an instruction the rules are about.
+	static constexpr size_t MaxArguments = 3;
+
+	/// The outermost shape of an argument of an instruction: A constant, an instruction
+	/// or anything else.
+	struct ArgumentShape
+	{
+		PatternKind kind = PatternKind::Any;
+		evmasm::Instruction instruction = evmasm::Instruction::STOP;
+
+		/// @returns true if an argument of shape @a _actual can match a pattern of this shape.
+		bool admits(ArgumentShape const& _actual) const
+		{
+			return
+				kind == PatternKind::Any ||
+				(kind == _actual.kind && (kind != PatternKind::Operation || instruction == _actual.instruction));
+		}
+	};
+	using ArgumentShapes = std::array<ArgumentShape, MaxArguments>;
+
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
-};
+	/// Determines the shapes of @a _arguments, resolving variables using @a _ssaValues.
+	/// @returns false if one of the arguments is a function call, which no rule matches.
+	static bool argumentShapes(
+		std::vector<Expression> const& _arguments,
+		Dialect const& _dialect,
+		std::function<AssignedValue const*(YulString)> const& _ssaValues,
+		ArgumentShapes& _shapes
+	);
 
-enum class PatternKind
-{
-	Operation,
-	Constant,
-	Any
+	MatchGroups m_matchGroups{};
+	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	/// Shapes of the arguments of the patterns in m_rules, which are used to skip rules
+	/// without matching their pattern recursively.
+	std::vector<ArgumentShapes> m_argumentShapes[256];
 };
 
 /**
@@ -114,8 +150,9 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
+	PatternKind kind() const { return m_kind; }
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
@@ -131,7 +168,7 @@ public:
 
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
-	Expression toExpression(std::shared_ptr<DebugData const> const& _debugData) const;
+	Expression toExpression(DebugData const* _debugData) const;
 
 private:
 	Expression const& matchGroupValue() const;
@@ -141,7 +178,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 }
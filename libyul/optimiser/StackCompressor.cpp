@@ -240,7 +240,8 @@ bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	optional<map<YulString, vector<StackLayoutGenerator::StackTooDeep>>>* _unchangedStackTooDeepErrors
 )
 {
 	yulAssert(
@@ -259,17 +260,39 @@ bool StackCompressor::run(
 	{
 		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
 		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
-		eliminateVariablesOptimizedCodegen(
-			_dialect,
-			*_object.code,
-			StackLayoutGenerator::reportStackTooDeep(*cfg),
-			allowMSizeOptimzation
-		);
+		auto stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg);
+		if (std::all_of(stackTooDeepErrors.begin(), stackTooDeepErrors.end(), [](auto const& _item) { return _item.second.empty(); }))
+		{
+			if (_unchangedStackTooDeepErrors)
+				*_unchangedStackTooDeepErrors = move(stackTooDeepErrors);
+		}
+		else
+			eliminateVariablesOptimizedCodegen(
+				_dialect,
+				*_object.code,
+				stackTooDeepErrors,
+				allowMSizeOptimzation
+			);
 	}
 	else
+	{
+		map<YulString, int> stackSurplus;
+		// Functions that have to be checked again, all of them if not set.
+		// The first round of the unused pruner can change the code anywhere. After that, the code is
+		// stable with respect to the pruner, and eliminating variables only changes the functions
+		// that the variables belong to.
+		optional<set<YulString>> changedFunctions;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+			if (!changedFunctions)
+				stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
+			else
+			{
+				for (YulString function: *changedFunctions)
+					stackSurplus.erase(function);
+				for (auto&& [function, surplus]: CompilabilityChecker(_dialect, _object, _optimizeStackAllocation, *changedFunctions).stackDeficit)
+					stackSurplus[function] = surplus;
+			}
 			if (stackSurplus.empty())
 				return true;
 			eliminateVariables(
@@ -278,7 +301,14 @@ bool StackCompressor::run(
 				stackSurplus,
 				allowMSizeOptimzation
 			);
+			if (iterations > 0)
+			{
+				changedFunctions = set<YulString>{};
+				for (auto const& item: stackSurplus)
+					changedFunctions->insert(item.first);
+			}
 		}
+	}
 	return false;
 }
 
@@ -23,8 +23,12 @@
 #pragma once
 
 #include <libyul/Object.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
 
+#include <map>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -45,12 +49,16 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// If the optimized code generator is used, the code did not have to be changed and
+	/// @a _unchangedStackTooDeepErrors is given, it is set to the stack too deep errors
+	/// determined for the code, so that later steps do not have to determine them again.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		std::optional<std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>>>* _unchangedStackTooDeepErrors = nullptr
 	);
 };
 
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
@@ -42,6 +43,78 @@ using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Collects the scope of each variable declared in a function body (excluding nested functions)
+ * and estimates how often the variable is accessed at runtime, assuming that loop bodies are
+ * executed ten times.
+ * A scope is given by the path of block numbers from the function body to the declaring block.
+ */
+struct VariableStatistics: ASTWalker
+{
+	static VariableStatistics run(Block const& _body)
+	{
+		VariableStatistics statistics;
+		statistics(_body);
+		return statistics;
+	}
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		accesses[_identifier.name] += m_weight;
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (TypedName const& variable: _varDecl.variables)
+		{
+			accesses[variable.name] += m_weight;
+			scopes[variable.name] = m_path;
+		}
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		// Variables declared in the initialisation part are visible in the whole loop.
+		m_path.push_back(m_nextScope++);
+		for (Statement const& statement: _loop.pre.statements)
+			visit(statement);
+		uint64_t outerWeight = m_weight;
+		m_weight = min(m_weight * 10, maxWeight);
+		visit(*_loop.condition);
+		(*this)(_loop.body);
+		(*this)(_loop.post);
+		m_weight = outerWeight;
+		m_path.pop_back();
+	}
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(Block const& _block) override
+	{
+		m_path.push_back(m_nextScope++);
+		ASTWalker::operator()(_block);
+		m_path.pop_back();
+	}
+
+	/// @returns true if the variables declared in the scopes @a _a and @a _b can be alive at the
+	/// same time. A null pointer stands for an unknown scope.
+	static bool overlapping(vector<size_t> const* _a, vector<size_t> const* _b)
+	{
+		if (!_a || !_b)
+			return true;
+		size_t const commonLength = min(_a->size(), _b->size());
+		return equal(_a->begin(), _a->begin() + static_cast<ptrdiff_t>(commonLength), _b->begin());
+	}
+
+	static uint64_t constexpr maxWeight = 1000000;
+
+	map<YulString, vector<size_t>> scopes;
+	map<YulString, uint64_t> accesses;
+
+private:
+	vector<size_t> m_path;
+	size_t m_nextScope = 0;
+	uint64_t m_weight = 1;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -52,8 +125,9 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
- * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
+ * - If not, assign each variable its slot starting from ``n``. If ``shareSlots`` is set, variables
+ *   declared in disjoint scopes of the function share a slot, since they are never alive at the same time.
+ * - Assign the next unused slot to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
 {
@@ -72,7 +146,10 @@ struct MemoryOffsetAllocator
 
 		if (auto const* unreachables = util::valueOrNullptr(unreachableVariables, _function))
 		{
-			if (FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy))
+			// Scopes of the variables in each slot of this function, starting at ``requiredSlots``.
+			vector<vector<vector<size_t> const*>> slotScopes;
+			FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy);
+			if (functionDefinition)
 				if (
 					size_t totalArgCount = functionDefinition->returnVariables.size() + functionDefinition->parameters.size();
 					totalArgCount > 16
@@ -81,15 +158,37 @@ struct MemoryOffsetAllocator
 						functionDefinition->parameters,
 						functionDefinition->returnVariables
 					) | ranges::views::take(totalArgCount - 16))
-						slotAllocations[var.name] = requiredSlots++;
+					{
+						slotAllocations[var.name] = requiredSlots + slotScopes.size();
+						slotScopes.push_back({nullptr});
+					}
+
+			Block const* body = _function.empty() ? &code : (functionDefinition ? &functionDefinition->body : nullptr);
+			VariableStatistics statistics = body ? VariableStatistics::run(*body) : VariableStatistics{};
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
-			// assign a slot for them already.
+			// assign a slot for them already. Each variable gets the first slot that is not used by a variable
+			// that can be alive at the same time.
 			for (YulString variable: *unreachables)
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
 				if (!variable.empty() && !slotAllocations.count(variable))
-					slotAllocations[variable] = requiredSlots++;
+				{
+					vector<size_t> const* scope = util::valueOrNullptr(statistics.scopes, variable);
+					size_t slot = shareSlots ? 0 : slotScopes.size();
+					while (
+						slot < slotScopes.size() &&
+						any_of(slotScopes[slot].begin(), slotScopes[slot].end(), [&](vector<size_t> const* _other) {
+							return VariableStatistics::overlapping(scope, _other);
+						})
+					)
+						++slot;
+					if (slot == slotScopes.size())
+						slotScopes.emplace_back();
+					slotScopes[slot].push_back(scope);
+					slotAllocations[variable] = requiredSlots + slot;
+				}
+			requiredSlots += slotScopes.size();
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
@@ -102,6 +201,10 @@ struct MemoryOffsetAllocator
 	map<YulString, set<YulString>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	map<YulString, FunctionDefinition const*> const& functionDefinitions;
+	/// The code of the object, whose variables outside of functions are mapped to the empty name.
+	Block const& code;
+	/// If true, variables of the same function that are never alive at the same time share a slot.
+	bool shareSlots;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	map<YulString, uint64_t> slotAllocations{};
@@ -149,11 +252,39 @@ void StackLimitEvader::run(
 	map<YulString, vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
 )
 {
+	yulAssert(_object.code, "");
 	map<YulString, set<YulString>> unreachableVariables;
+	if (!_context.runExperimental(frontend::ExperimentalOptimisation::CheapSpilling))
+	{
+		for (auto&& [function, stackTooDeepErrors]: _stackTooDeepErrors)
+			for (auto const& stackTooDeepError: stackTooDeepErrors)
+				unreachableVariables[function] += stackTooDeepError.variableChoices | ranges::views::take(stackTooDeepError.deficit) | ranges::to<set<YulString>>;
+		run(_context, _object, unreachableVariables);
+		return;
+	}
+
+	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
 	for (auto&& [function, stackTooDeepErrors]: _stackTooDeepErrors)
-		// TODO: choose wisely.
+	{
+		Block const* body = function.empty() ? _object.code.get() : nullptr;
+		if (FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, function, nullptr, util::allow_copy))
+			body = &functionDefinition->body;
+		map<YulString, uint64_t> accesses = body ? VariableStatistics::run(*body).accesses : map<YulString, uint64_t>{};
+
+		set<YulString>& chosen = unreachableVariables[function];
 		for (auto const& stackTooDeepError: stackTooDeepErrors)
-			unreachableVariables[function] += stackTooDeepError.variableChoices | ranges::views::take(stackTooDeepError.deficit) | ranges::to<set<YulString>>;
+		{
+			// Every access to a variable in memory costs an additional memory operation, so prefer
+			// variables that are already moved for another error, then those that are accessed rarely.
+			vector<YulString> choices = stackTooDeepError.variableChoices;
+			stable_sort(choices.begin(), choices.end(), [&](YulString _a, YulString _b) {
+				return
+					make_pair(!chosen.count(_a), util::valueOrDefault(accesses, _a, uint64_t(0))) <
+					make_pair(!chosen.count(_b), util::valueOrDefault(accesses, _b, uint64_t(0)));
+			});
+			chosen += choices | ranges::views::take(stackTooDeepError.deficit) | ranges::to<set<YulString>>;
+		}
+	}
 	run(_context, _object, unreachableVariables);
 }
 
@@ -195,7 +326,13 @@ void StackLimitEvader::run(
 
 	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_unreachableVariables,
+		callGraph.functionCalls,
+		functionDefinitions,
+		*_object.code,
+		_context.runExperimental(frontend::ExperimentalOptimisation::CheapSpilling)
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
@@ -42,6 +42,10 @@ struct Object;
  * Offsets are assigned to the variables, s.t. on every path through the call graph each variable gets a unique offset
  * in memory. However, distinct paths through the call graph can use the same memory offsets for their variables.
  *
+ * With the experimental optimisation ``CheapSpilling``, variables of the same function that are declared in disjoint
+ * scopes share offsets, too, and if the variables are chosen from stack too deep errors, the variables that are
+ * accessed least often at runtime (counting accesses inside loops more) are moved.
+ *
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
  *
@@ -37,7 +37,7 @@ namespace
 {
 vector<Statement> generateMemoryStore(
 	Dialect const& _dialect,
-	shared_ptr<DebugData const> const& _debugData,
+	DebugData const* _debugData,
 	YulString _mpos,
 	Expression _value
 )
@@ -56,7 +56,7 @@ vector<Statement> generateMemoryStore(
 	return result;
 }
 
-FunctionCall generateMemoryLoad(Dialect const& _dialect, std::shared_ptr<DebugData const> const& _debugData, YulString _mpos)
+FunctionCall generateMemoryLoad(Dialect const& _dialect, DebugData const* _debugData, YulString _mpos)
 {
 	BuiltinFunction const* memoryLoadFunction = _dialect.memoryLoadFunction(_dialect.defaultType);
 	yulAssert(memoryLoadFunction, "");
@@ -0,0 +1,177 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Summaries of the storage slots and memory words user-defined functions can write to.
+ */
+
+#include <libyul/optimiser/StoreSummaryGenerator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <functional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Walks the body of a single function and collects the keys it writes to.
+ */
+class FunctionWriteCollector: public ASTWalker
+{
+public:
+	FunctionWriteCollector(
+		Dialect const& _dialect,
+		FunctionDefinition const& _function,
+		function<FunctionStoreSummary const&(YulString)> _calleeSummary
+	):
+		m_dialect(_dialect),
+		m_calleeSummary(std::move(_calleeSummary))
+	{
+		m_summary.storage.emplace();
+		m_summary.memory.emplace();
+
+		set<YulString> assigned = assignedVariableNames(_function.body);
+		for (size_t i = 0; i < _function.parameters.size(); ++i)
+			if (!assigned.count(_function.parameters[i].name))
+				m_parameters[_function.parameters[i].name] = i;
+		m_assignedVariables = std::move(assigned);
+
+		(*this)(_function.body);
+	}
+
+	FunctionStoreSummary const& summary() const { return m_summary; }
+
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		if (_varDecl.variables.size() == 1 && !m_assignedVariables.count(_varDecl.variables.front().name))
+			if (Literal const* literal = get_if<Literal>(_varDecl.value.get()))
+				m_constants[_varDecl.variables.front().name] = valueOfLiteral(*literal);
+	}
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(FunctionCall const& _call) override
+	{
+		ASTWalker::operator()(_call);
+		YulString name = _call.functionName.name;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(name))
+		{
+			BuiltinFunction const* storageStore = m_dialect.storageStoreFunction(YulString{});
+			BuiltinFunction const* memoryStore = m_dialect.memoryStoreFunction(YulString{});
+			if (storageStore && name == storageStore->name)
+				addKey(m_summary.storage, _call.arguments.front());
+			else if (builtin->sideEffects.storage == SideEffects::Write)
+				m_summary.storage.reset();
+			if (memoryStore && name == memoryStore->name)
+				addKey(m_summary.memory, _call.arguments.front());
+			else if (builtin->sideEffects.memory == SideEffects::Write)
+				m_summary.memory.reset();
+		}
+		else
+		{
+			FunctionStoreSummary const& callee = m_calleeSummary(name);
+			addCalleeKeys(m_summary.storage, callee.storage, _call.arguments);
+			addCalleeKeys(m_summary.memory, callee.memory, _call.arguments);
+		}
+	}
+
+private:
+	void addKey(optional<WrittenKeys>& _keys, Expression const& _key)
+	{
+		if (!_keys)
+			return;
+		if (Literal const* literal = get_if<Literal>(&_key))
+			_keys->constants.insert(valueOfLiteral(*literal));
+		else if (Identifier const* identifier = get_if<Identifier>(&_key))
+		{
+			if (u256 const* value = valueOrNullptr(m_constants, identifier->name))
+				_keys->constants.insert(*value);
+			else if (size_t const* index = valueOrNullptr(m_parameters, identifier->name))
+				_keys->parameters.insert(*index);
+			else
+				_keys.reset();
+		}
+		else
+			_keys.reset();
+	}
+
+	void addCalleeKeys(
+		optional<WrittenKeys>& _keys,
+		optional<WrittenKeys> const& _calleeKeys,
+		vector<Expression> const& _arguments
+	)
+	{
+		if (!_calleeKeys)
+			_keys.reset();
+		if (!_keys)
+			return;
+		_keys->constants += _calleeKeys->constants;
+		for (size_t index: _calleeKeys->parameters)
+			addKey(_keys, _arguments.at(index));
+	}
+
+	Dialect const& m_dialect;
+	function<FunctionStoreSummary const&(YulString)> m_calleeSummary;
+	FunctionStoreSummary m_summary;
+	set<YulString> m_assignedVariables;
+	/// Parameters that are not assigned to, with their index.
+	map<YulString, size_t> m_parameters;
+	/// Variables that are declared with a literal value and not assigned to.
+	map<YulString, u256> m_constants;
+};
+
+}
+
+map<YulString, FunctionStoreSummary> StoreSummaryGenerator::run(Dialect const& _dialect, Block const& _ast)
+{
+	StoreSummaryGenerator generator{_dialect, allFunctionDefinitions(_ast)};
+	for (auto const& function: generator.m_functions)
+		generator.summary(function.first);
+	return std::move(generator.m_summaries);
+}
+
+FunctionStoreSummary const& StoreSummaryGenerator::summary(YulString _name)
+{
+	static FunctionStoreSummary const unknown;
+
+	if (FunctionStoreSummary const* summary = valueOrNullptr(m_summaries, _name))
+		return *summary;
+	FunctionDefinition const* function = valueOrDefault(m_functions, _name, nullptr);
+	if (!function || m_inProgress.count(_name))
+		return unknown;
+
+	m_inProgress.insert(_name);
+	FunctionWriteCollector collector{
+		m_dialect,
+		*function,
+		[this](YulString _callee) -> FunctionStoreSummary const& { return summary(_callee); }
+	};
+	m_inProgress.erase(_name);
+	return m_summaries[_name] = collector.summary();
+}
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Summaries of the storage slots and memory words user-defined functions can write to.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/YulString.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Keys of storage slots or memory words that can be written to by a function.
+ */
+struct WrittenKeys
+{
+	/// Constant keys.
+	std::set<u256> constants;
+	/// Indices of the parameters whose values are used as keys.
+	std::set<size_t> parameters;
+};
+
+/**
+ * Writes of a function to storage and memory, including the writes of the functions it calls.
+ * An entry is only present if all writes to the respective location are ``sstore`` resp.
+ * ``mstore`` with a key that is a constant or the unmodified value of a parameter.
+ * For memory, each key stands for the 32 bytes starting at the key.
+ */
+struct FunctionStoreSummary
+{
+	std::optional<WrittenKeys> storage;
+	std::optional<WrittenKeys> memory;
+};
+
+/**
+ * Generates the store summaries of all user-defined functions. Recursive functions and
+ * functions calling them do not have summaries for the locations they write to.
+ *
+ * Prerequisite: Disambiguator
+ */
+class StoreSummaryGenerator
+{
+public:
+	static std::map<YulString, FunctionStoreSummary> run(Dialect const& _dialect, Block const& _ast);
+
+private:
+	StoreSummaryGenerator(Dialect const& _dialect, std::map<YulString, FunctionDefinition const*> _functions):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions))
+	{}
+
+	/// @returns the summary of the function @a _name, computing it if necessary.
+	FunctionStoreSummary const& summary(YulString _name);
+
+	Dialect const& m_dialect;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	std::map<YulString, FunctionStoreSummary> m_summaries;
+	/// Functions whose summaries are currently being computed.
+	std::set<YulString> m_inProgress;
+};
+
+}
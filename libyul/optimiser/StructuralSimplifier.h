@@ -41,6 +41,7 @@ class StructuralSimplifier: public ASTModifier
 {
 public:
 	static constexpr char const* name{"StructuralSimplifier"};
+	static constexpr bool intraProcedural = true;
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -22,6 +22,7 @@
 #include <libyul/optimiser/Suite.h>
 
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
@@ -30,6 +31,7 @@
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
@@ -61,9 +63,11 @@
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmPrinter.h>
@@ -74,6 +78,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Profiler.h>
 
 #include <libyul/CompilabilityChecker.h>
 
@@ -87,6 +92,36 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+thread_local size_t activeParallelism = 1;
+}
+
+OptimiserSuite::ParallelismActivation::ParallelismActivation(size_t _threads):
+	m_previousThreads(activeParallelism)
+{
+	activeParallelism = max<size_t>(_threads, 1);
+}
+
+OptimiserSuite::ParallelismActivation::~ParallelismActivation()
+{
+	activeParallelism = m_previousThreads;
+}
+
+size_t OptimiserSuite::ParallelismActivation::threads()
+{
+	return activeParallelism;
+}
+
+OptimiserSuite::OptimiserSuite(OptimiserStepContext& _context, Debug _debug, OptimiserProfile* _profile):
+	m_context(_context),
+	m_debug(_debug),
+	m_profile(_profile),
+	m_analysisCache(_context.dialect, m_changeTracker)
+{
+	yulAssert((m_debug == Debug::Profile) == (m_profile != nullptr), "A profile is required exactly in profiling mode.");
+}
+
 void OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
@@ -94,7 +129,10 @@ void OptimiserSuite::run(
 	bool _optimizeStackAllocation,
 	string_view _optimisationSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	optional<size_t> _budget,
+	map<YulString, size_t> _functionExecutions,
+	set<frontend::ExperimentalOptimisation> _experimentalOptimisations
 )
 {
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
@@ -116,7 +154,15 @@ void OptimiserSuite::run(
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
 	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
 
-	OptimiserSuite suite(context, Debug::None);
+	OptimiserProfile* profile = OptimiserProfile::active();
+	OptimiserSuite suite(context, profile ? Debug::Profile : Debug::None, profile);
+	context.analysisCache = &suite.m_analysisCache;
+	context.meter = _meter;
+	if (_expectedExecutionsPerDeployment)
+		context.functionExecutions = std::move(_functionExecutions);
+	context.experimentalOptimisations = std::move(_experimentalOptimisations);
+	if (ParallelismActivation::threads() > 1)
+		suite.m_threadPool = make_unique<util::ThreadPool>(ParallelismActivation::threads());
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -124,7 +170,9 @@ void OptimiserSuite::run(
 
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
+	suite.m_remainingBudget = _budget;
 	suite.runSequence(_optimisationSequence, ast);
+	suite.m_remainingBudget.reset();
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -147,14 +195,23 @@ void OptimiserSuite::run(
 		ConstantOptimiser{*evmDialect, *_meter}(ast);
 		if (usesOptimizedCodeGenerator)
 		{
+			// If the stack compressor does not change the code, its analysis is still valid
+			// and is reused by the stack limit evader.
+			optional<map<YulString, vector<StackLayoutGenerator::StackTooDeep>>> stackTooDeepErrors;
 			StackCompressor::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
-				stackCompressorMaxIterations
+				stackCompressorMaxIterations,
+				&stackTooDeepErrors
 			);
 			if (evmDialect->providesObjectAccess())
-				StackLimitEvader::run(suite.m_context, _object);
+			{
+				if (stackTooDeepErrors)
+					StackLimitEvader::run(suite.m_context, _object, *stackTooDeepErrors);
+				else
+					StackLimitEvader::run(suite.m_context, _object);
+			}
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object);
@@ -222,6 +279,7 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 			LiteralRematerialiser,
 			LoadResolver,
 			LoopInvariantCodeMotion,
+			LoopUnroller,
 			UnusedAssignEliminator,
 			UnusedStoreEliminator,
 			ReasoningBasedSimplifier,
@@ -264,6 +322,7 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopUnroller::name,                  'w'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{UnusedStoreEliminator::name,         'S'},
@@ -402,9 +461,13 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 			subsequences.push_back({subsequence, true});
 	}
 
+	size_t const outerRound = m_currentRound;
 	size_t codeSize = 0;
+	bigint gasCosts = 0;
 	for (size_t round = 0; round < MaxRounds; ++round)
 	{
+		if (_repeatUntilStable)
+			m_currentRound = round + 1;
 		for (auto const& [subsequence, repeat]: subsequences)
 		{
 			if (repeat)
@@ -413,26 +476,67 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 				runSequence(abbreviationsToSteps(subsequence), _ast);
 		}
 
-		if (!_repeatUntilStable)
+		if (!_repeatUntilStable || budgetExhausted())
 			break;
 
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
-		if (newSize == codeSize)
+		// Changes that make the code cheaper to run do not necessarily change its size,
+		// so we only stop once both are stable.
+		size_t newSize = m_analysisCache.codeSizeIncludingFunctions(_ast);
+		bigint newGasCosts = 0;
+		if (m_context.meter && m_context.runExperimental(frontend::ExperimentalOptimisation::GasWeightedInlining))
+			newGasCosts = m_context.meter->costs(_ast);
+		if (newSize == codeSize && newGasCosts == gasCosts)
 			break;
 		codeSize = newSize;
+		gasCosts = newGasCosts;
 	}
+	m_currentRound = outerRound;
 }
 
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
+	// The AST might have been modified since the last sequence was run.
+	m_changeTracker.invalidate();
+
+	// Every step is charged with the size of the code at the start of the sequence.
+	size_t stepCost = 0;
+	if (m_remainingBudget)
+		stepCost = max<size_t>(m_analysisCache.codeSizeIncludingFunctions(_ast), 1);
+
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
 	for (string const& step: _steps)
 	{
+		if (budgetExhausted())
+			break;
+		if (m_remainingBudget)
+			*m_remainingBudget -= min(stepCost, *m_remainingBudget);
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		util::ProfilerScope profilerScope(
+			util::Profiler::active() ?
+			"OptimiserSuite step " + string(1, stepNameToAbbreviationMap().at(step)) :
+			string{}
+		);
+		if (m_debug == Debug::Profile)
+		{
+			Block before = std::get<Block>(ASTCopier{}(_ast));
+			size_t codeSizeBefore = CodeSize::codeSizeIncludingFunctions(_ast);
+			auto start = chrono::steady_clock::now();
+			runStep(step, _ast);
+			auto wallTime = chrono::steady_clock::now() - start;
+			m_profile->record(
+				stepNameToAbbreviationMap().at(step),
+				m_currentRound,
+				wallTime,
+				codeSizeBefore,
+				CodeSize::codeSizeIncludingFunctions(_ast),
+				!SyntacticallyEqual{}.statementEqual(_ast, before)
+			);
+		}
+		else
+			runStep(step, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -447,3 +551,13 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		}
 	}
 }
+
+void OptimiserSuite::runStep(string const& _step, Block& _ast)
+{
+	OptimiserStep const& step = *allSteps().at(_step);
+	if (step.isIntraProcedural() && m_changeTracker.run(step, m_context, _ast, m_threadPool.get()))
+		return;
+
+	step.run(m_context, _ast);
+	m_changeTracker.invalidate();
+}
@@ -23,10 +23,15 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Parallel.h>
+
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -39,6 +44,7 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimiserProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -57,11 +63,42 @@ public:
 	{
 		None,
 		PrintStep,
-		PrintChanges
+		PrintChanges,
+		/// Records duration, code size and changes of every step in the profile given to the constructor.
+		Profile
+	};
+	OptimiserSuite(
+		OptimiserStepContext& _context,
+		Debug _debug = Debug::None,
+		OptimiserProfile* _profile = nullptr
+	);
+
+	/// Allows the optimiser suites run on the current thread while it is alive to apply
+	/// intra-procedural steps to multiple functions at the same time, using at most
+	/// @a _threads threads. The result of the optimisation does not depend on the number of threads.
+	class ParallelismActivation
+	{
+	public:
+		explicit ParallelismActivation(size_t _threads);
+		~ParallelismActivation();
+		ParallelismActivation(ParallelismActivation const&) = delete;
+		ParallelismActivation& operator=(ParallelismActivation const&) = delete;
+
+		/// @returns the number of threads the optimiser suite may use on the current thread.
+		static size_t threads();
+
+	private:
+		size_t m_previousThreads;
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _budget is set, the steps of @a _optimisationSequence are only applied as long as
+	/// the sum of the code sizes they were applied to does not exceed it. The mandatory steps
+	/// after the sequence are always run.
+	/// Runs in Debug::Profile mode if an OptimiserProfile is active for the current thread
+	/// and on as many threads as the current ParallelismActivation allows.
+	/// @a _functionExecutions overrides @a _expectedExecutionsPerDeployment for individual functions.
+	/// @a _experimentalOptimisations are made available to the steps via their context.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -69,7 +106,10 @@ public:
 		bool _optimizeStackAllocation,
 		std::string_view _optimisationSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		std::optional<size_t> _budget = std::nullopt,
+		std::map<YulString, size_t> _functionExecutions = {},
+		std::set<frontend::ExperimentalOptimisation> _experimentalOptimisations = {}
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -84,8 +124,24 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// Runs a single step. Intra-procedural steps are only applied to the functions
+	/// they have not converged on yet.
+	void runStep(std::string const& _step, Block& _ast);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
+	OptimiserProfile* m_profile = nullptr;
+	/// @returns true if the budget of the current sequence is used up.
+	bool budgetExhausted() const { return m_remainingBudget && *m_remainingBudget == 0; }
+
+	/// Current round of the innermost repeat-until-stable loop, counted from one. Zero outside of such loops.
+	size_t m_currentRound = 0;
+	/// Remaining budget of the current sequence, unlimited if not set.
+	std::optional<size_t> m_remainingBudget;
+	FunctionChangeTracker m_changeTracker;
+	AnalysisCache m_analysisCache;
+	/// Threads used for intra-procedural steps, only set if more than one thread may be used.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
 };
 
 }
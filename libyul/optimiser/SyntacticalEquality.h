@@ -85,4 +85,13 @@ private:
 	std::map<YulString, std::size_t> m_identifiersRHS;
 };
 
+/**
+ * Does the same as SyntacticallyEqual just that it can be used as the equality
+ * predicate of unordered containers of expressions.
+ */
+struct SyntacticallyEqualExpression
+{
+	bool operator()(Expression const& _lhs, Expression const& _rhs) const;
+};
+
 }
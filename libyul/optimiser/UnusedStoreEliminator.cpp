@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/UnusedStoreEliminator.h>
 
+#include <libyul/optimiser/AnalysisCache.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
@@ -47,13 +48,42 @@ static string const zero{"@ 0"};
 static string const one{"@ 1"};
 static string const thirtyTwo{"@ 32"};
 
+namespace
+{
+
+/**
+ * Finds the functions that contain function definitions.
+ */
+class NestingFunctionFinder: public ASTWalker
+{
+public:
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const& _functionDefinition) override
+	{
+		if (!m_enclosingFunctions.empty())
+			m_nestingFunctions += m_enclosingFunctions;
+		m_enclosingFunctions.emplace_back(_functionDefinition.name);
+		ASTWalker::operator()(_functionDefinition);
+		m_enclosingFunctions.pop_back();
+	}
+
+	static set<YulString> run(Block const& _ast)
+	{
+		NestingFunctionFinder finder;
+		finder(_ast);
+		return std::move(finder.m_nestingFunctions);
+	}
+
+private:
+	vector<YulString> m_enclosingFunctions;
+	set<YulString> m_nestingFunctions;
+};
+
+}
 
 void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	map<YulString, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(
-		_context.dialect,
-		CallGraphGenerator::callGraph(_ast)
-	);
+	map<YulString, SideEffects> functionSideEffects = AnalysisCache::functionSideEffects(_context, _ast);
 
 	SSAValueTracker ssaValues;
 	ssaValues(_ast);
@@ -67,7 +97,7 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	values[YulString{one}] = AssignedValue{&oneLiteral, {}};
 	values[YulString{thirtyTwo}] = AssignedValue{&thirtyTwoLiteral, {}};
 
-	bool const ignoreMemory = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool const ignoreMemory = AnalysisCache::containsMSize(_context, _ast);
 	UnusedStoreEliminator rse{
 		_context.dialect,
 		functionSideEffects,
@@ -75,6 +105,16 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 		values,
 		ignoreMemory
 	};
+	// Functions that do not write to storage or memory do not contain any stores
+	// that could be removed, unless they contain other functions.
+	set<YulString> nestingFunctions = NestingFunctionFinder::run(_ast);
+	for (auto const& [function, sideEffects]: functionSideEffects)
+		if (
+			sideEffects.storage != SideEffects::Write &&
+			(ignoreMemory || sideEffects.memory != SideEffects::Write) &&
+			!nestingFunctions.count(function)
+		)
+			rse.m_functionsWithoutStores.insert(function);
 	rse(_ast);
 	rse.changeUndecidedTo(State::Unused, Location::Memory);
 	rse.changeUndecidedTo(State::Used, Location::Storage);
@@ -106,6 +146,8 @@ void UnusedStoreEliminator::operator()(FunctionCall const& _functionCall)
 
 void UnusedStoreEliminator::operator()(FunctionDefinition const& _functionDefinition)
 {
+	if (m_functionsWithoutStores.count(_functionDefinition.name))
+		return;
 	ScopedSaveAndRestore storeOperations(m_storeOperations, {});
 	UnusedStoreBase::operator()(_functionDefinition);
 }
@@ -222,15 +264,23 @@ vector<UnusedStoreEliminator::Operation> UnusedStoreEliminator::operationsFromFu
 
 void UnusedStoreEliminator::applyOperation(UnusedStoreEliminator::Operation const& _operation)
 {
-	for (auto& [statement, state]: m_stores[YulString{}])
+	auto& stores = m_stores[YulString{}];
+	for (auto it = stores.begin(); it != stores.end();)
+	{
+		auto& [statement, state] = *it;
 		if (state == State::Undecided)
 		{
 			Operation const& storeOperation = m_storeOperations.at(statement);
 			if (_operation.effect == Effect::Read && !knownUnrelated(storeOperation, _operation))
-				state = State::Used;
+			{
+				it = markUsed(stores, it);
+				continue;
+			}
 			else if (_operation.effect == Effect::Write && knownCovered(storeOperation, _operation))
 				state = State::Unused;
 		}
+		++it;
+	}
 }
 
 bool UnusedStoreEliminator::knownUnrelated(
@@ -355,12 +405,33 @@ void UnusedStoreEliminator::changeUndecidedTo(
 	State _newState,
 	optional<UnusedStoreEliminator::Location> _onlyLocation)
 {
-	for (auto& [statement, state]: m_stores[YulString{}])
+	auto& stores = m_stores[YulString{}];
+	for (auto it = stores.begin(); it != stores.end();)
+	{
+		auto& [statement, state] = *it;
 		if (
 			state == State::Undecided &&
 			(_onlyLocation == nullopt || *_onlyLocation == m_storeOperations.at(statement).location)
 		)
+		{
+			if (_newState == State::Used)
+			{
+				it = markUsed(stores, it);
+				continue;
+			}
 			state = _newState;
+		}
+		++it;
+	}
+}
+
+map<Statement const*, UnusedStoreEliminator::State>::iterator UnusedStoreEliminator::markUsed(
+	map<Statement const*, State>& _stores,
+	map<Statement const*, State>::iterator _store
+)
+{
+	m_usedStores.insert(_store->first);
+	return _stores.erase(_store);
 }
 
 optional<YulString> UnusedStoreEliminator::identifierNameIfSSA(Expression const& _expression) const
@@ -374,6 +445,6 @@ optional<YulString> UnusedStoreEliminator::identifierNameIfSSA(Expression const&
 void UnusedStoreEliminator::scheduleUnusedForDeletion()
 {
 	for (auto const& [statement, state]: m_stores[YulString{}])
-		if (state == State::Unused)
+		if (state == State::Unused && !m_usedStores.count(statement))
 			m_pendingRemovals.insert(statement);
 }
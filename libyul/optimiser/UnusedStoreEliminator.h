@@ -45,6 +45,11 @@ struct AssignedValue;
  * The m_store member of UnusedStoreBase is only used with the empty yul string
  * as key in the first dimension.
  *
+ * Since a store that is used on one control-flow path cannot be removed, stores are
+ * no longer tracked once they are used, which keeps the tracked stores that are copied
+ * and joined at control-flow splits small. Functions that cannot write to storage or memory
+ * are skipped entirely.
+ *
  * Best run in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -104,6 +109,12 @@ private:
 	bool knownCovered(Operation const& _covered, Operation const& _covering) const;
 
 	void changeUndecidedTo(State _newState, std::optional<Location> _onlyLocation = std::nullopt);
+	/// Records that @a _store is used on at least one control-flow path and stops tracking it.
+	/// @returns the iterator following @a _store.
+	std::map<Statement const*, State>::iterator markUsed(
+		std::map<Statement const*, State>& _stores,
+		std::map<Statement const*, State>::iterator _store
+	);
 	void scheduleUnusedForDeletion();
 
 	std::optional<YulString> identifierNameIfSSA(Expression const& _expression) const;
@@ -114,6 +125,10 @@ private:
 	std::map<YulString, AssignedValue> const& m_ssaValues;
 
 	std::map<Statement const*, Operation> m_storeOperations;
+	/// Stores that are used on at least one control-flow path and are thus not tracked anymore.
+	std::set<Statement const*> m_usedStores;
+	/// Functions that do not contain any stores that could be removed.
+	std::set<YulString> m_functionsWithoutStores;
 };
 
 }
@@ -0,0 +1,335 @@
+#!/usr/bin/env python3
+
+"""
+Measures how long solc takes to compile a fixed corpus of projects and compares the results
+between two compiler builds.
+
+Every project is compiled via Standard JSON in four presets: legacy and IR pipeline, each with
+the optimiser enabled and disabled. For each of them the report contains the median wall time,
+the peak resident set size of the compiler process, the total size of the generated bytecode
+and the median time of each compilation phase as reported by ``settings.profiling``.
+
+The report is a JSON object of the form ``{project: {preset: {attribute: value}}}``, i.e. it has
+the same shape as the reports produced by the external tests, so
+``scripts/externalTests/benchmark_diff.py`` can be used to render full difference tables.
+
+Usage:
+
+  scripts/solbench.py run --solc build/solc/solc --output before.json
+  scripts/solbench.py run --solc /tmp/new/solc --output after.json \\
+      --project openzeppelin=/tmp/openzeppelin/contracts
+  scripts/solbench.py compare before.json after.json --threshold 0.05
+
+``compare`` exits with a non-zero status if the compilation time or memory usage of any
+preset grew by more than the given fraction.
+"""
+
+from argparse import ArgumentParser
+from pathlib import Path
+from statistics import median
+from typing import Dict, List, Mapping, Optional, Sequence, Tuple
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+PROJECT_ROOT = Path(__file__).parent.parent
+DEFAULT_PROJECT_DIRS = [
+    PROJECT_ROOT / 'test/compilationTests/MultiSigWallet',
+    PROJECT_ROOT / 'test/compilationTests/corion',
+    PROJECT_ROOT / 'test/compilationTests/gnosis',
+    PROJECT_ROOT / 'test/compilationTests/milestonetracker',
+]
+DEFAULT_GENERATED_FUNCTION_COUNTS = [200, 1000]
+
+PRESETS = {
+    'legacy': {'viaIR': False, 'optimize': False},
+    'legacy-optimize': {'viaIR': False, 'optimize': True},
+    'ir': {'viaIR': True, 'optimize': False},
+    'ir-optimize': {'viaIR': True, 'optimize': True},
+}
+
+# Attributes compared by the ``compare`` command. Lower is better for all of them.
+TIME_ATTRIBUTES = ['compilation_time_ms', 'peak_rss_kib']
+# Differences in phases shorter than this are considered noise.
+DEFAULT_MIN_TIME_MS = 20
+
+
+class BenchmarkError(Exception):
+    pass
+
+
+def generate_large_contract(function_count: int) -> str:
+    """Generates a contract with many similar but not identical functions, with storage
+    accesses, arithmetic, loops and internal calls, to stress all compilation phases."""
+    lines = [
+        '// SPDX-License-Identifier: GPL-3.0',
+        'pragma solidity >=0.0;',
+        f'contract Generated{function_count} {{',
+        '    mapping(uint => uint) public values;',
+        '    uint[] public items;',
+        '    function helper(uint a, uint b) internal pure returns (uint) { return a * 3 + b / 7; }',
+    ]
+    for i in range(function_count):
+        lines += [
+            f'    function f{i}(uint x, uint y) public returns (uint result) {{',
+            f'        result = helper(x, {i + 1});',
+            f'        for (uint i = 0; i < y % {i % 7 + 2}; ++i)',
+            f'            result += values[x + i] ^ {i * 31 + 5};',
+            f'        if (result > {i * 1000 + 17})',
+            '            items.push(result);',
+            '        else',
+            f'            values[y] = result - {i};',
+            '    }',
+        ]
+    lines.append('}')
+    return '\n'.join(lines) + '\n'
+
+
+def find_sources(project_dir: Path) -> List[str]:
+    sources = []
+    for path in sorted(project_dir.rglob('*.sol')):
+        relative = path.relative_to(project_dir)
+        if 'node_modules' not in relative.parts and not relative.parts[0].startswith('.'):
+            sources.append(relative.as_posix())
+    if len(sources) == 0:
+        raise BenchmarkError(f"No Solidity sources found in {project_dir}.")
+    return sources
+
+
+def standard_json_input(sources: Sequence[str], via_ir: bool, optimize: bool) -> dict:
+    return {
+        'language': 'Solidity',
+        'sources': {source: {'urls': [source]} for source in sources},
+        'settings': {
+            'viaIR': via_ir,
+            'optimizer': {'enabled': optimize},
+            'profiling': True,
+            'outputSelection': {'*': {'*': ['evm.bytecode.object', 'evm.deployedBytecode.object']}},
+        },
+    }
+
+
+def run_solc(solc: Path, project_dir: Path, input_json: dict) -> Tuple[dict, float, int]:
+    """Runs solc once and returns its output, the wall time in milliseconds and the peak
+    resident set size in KiB."""
+    command = [str(solc), '--standard-json', '--base-path', str(project_dir)]
+    if (project_dir / 'node_modules').is_dir():
+        command += ['--include-path', str(project_dir / 'node_modules')]
+
+    with tempfile.TemporaryFile() as output_file:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdin=subprocess.PIPE, stdout=output_file)
+        process.stdin.write(json.dumps(input_json).encode('utf-8'))
+        process.stdin.close()
+        # wait4() gives us the resource usage of this child alone.
+        _, status, usage = os.wait4(process.pid, 0)
+        wall_time_ms = (time.perf_counter() - start) * 1000
+        process.returncode = os.waitstatus_to_exitcode(status)
+
+        if process.returncode != 0:
+            raise BenchmarkError(f"{' '.join(command)} exited with code {process.returncode}.")
+
+        output_file.seek(0)
+        output = json.loads(output_file.read())
+
+    errors = [error for error in output.get('errors', []) if error['severity'] == 'error']
+    if len(errors) > 0:
+        raise BenchmarkError(f"Compilation of {project_dir} failed:\n{errors[0]['formattedMessage']}")
+
+    # ru_maxrss is in bytes on macOS and in KiB elsewhere.
+    peak_rss_kib = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+    return output, wall_time_ms, peak_rss_kib
+
+
+def bytecode_sizes(output: dict) -> Tuple[int, int]:
+    bytecode_size = 0
+    deployed_bytecode_size = 0
+    for contracts in output.get('contracts', {}).values():
+        for contract in contracts.values():
+            bytecode_size += len(contract['evm']['bytecode']['object']) // 2
+            deployed_bytecode_size += len(contract['evm']['deployedBytecode']['object']) // 2
+    return bytecode_size, deployed_bytecode_size
+
+
+def phase_times(output: dict) -> Dict[str, float]:
+    """Sums up the wall time of each phase over all contracts."""
+    times: Dict[str, float] = {}
+    for entry in output.get('profiling', []):
+        times[entry['phase']] = times.get(entry['phase'], 0) + entry['wallTimeMs']
+    return times
+
+
+def benchmark_preset(solc: Path, project_dir: Path, sources: Sequence[str], preset: str, repetitions: int) -> dict:
+    input_json = standard_json_input(sources, PRESETS[preset]['viaIR'], PRESETS[preset]['optimize'])
+
+    wall_times = []
+    peak_rss_values = []
+    phases: Dict[str, List[float]] = {}
+    for _ in range(repetitions):
+        output, wall_time_ms, peak_rss_kib = run_solc(solc, project_dir, input_json)
+        wall_times.append(wall_time_ms)
+        peak_rss_values.append(peak_rss_kib)
+        for phase, phase_time in phase_times(output).items():
+            phases.setdefault(phase, []).append(phase_time)
+
+    bytecode_size, deployed_bytecode_size = bytecode_sizes(output)
+    result = {
+        'compilation_time_ms': round(median(wall_times), 1),
+        'peak_rss_kib': max(peak_rss_values),
+        'bytecode_size': bytecode_size,
+        'deployed_bytecode_size': deployed_bytecode_size,
+    }
+    for phase, times in sorted(phases.items()):
+        result[f'phase_{phase}_ms'] = round(median(times), 1)
+    return result
+
+
+def benchmark(
+    solc: Path,
+    projects: Mapping[str, Path],
+    generated_function_counts: Sequence[int],
+    presets: Sequence[str],
+    repetitions: int,
+) -> dict:
+    report = {}
+    with tempfile.TemporaryDirectory(prefix='solbench-') as generated_dir:
+        all_projects = dict(projects)
+        for function_count in generated_function_counts:
+            project_dir = Path(generated_dir) / f'generated-{function_count}'
+            project_dir.mkdir()
+            (project_dir / 'Generated.sol').write_text(generate_large_contract(function_count), encoding='utf-8')
+            all_projects[project_dir.name] = project_dir
+
+        for project, project_dir in all_projects.items():
+            sources = find_sources(project_dir)
+            report[project] = {}
+            for preset in presets:
+                print(f"Benchmarking {project} ({preset})...", file=sys.stderr)
+                report[project][preset] = benchmark_preset(solc, project_dir, sources, preset, repetitions)
+
+    return report
+
+
+def find_regressions(
+    before: dict,
+    after: dict,
+    threshold: float,
+    min_time_ms: float,
+) -> List[Tuple[str, str, str, float, float]]:
+    """@returns (project, preset, attribute, before, after) for every time or memory attribute
+    present in both reports that grew by more than @a threshold. Phase times are included,
+    bytecode sizes are not."""
+    regressions = []
+    for project in sorted(set(before) & set(after)):
+        for preset in sorted(set(before[project]) & set(after[project])):
+            attributes_before = before[project][preset]
+            attributes_after = after[project][preset]
+            for attribute in sorted(set(attributes_before) & set(attributes_after)):
+                if attribute not in TIME_ATTRIBUTES and not attribute.startswith('phase_'):
+                    continue
+
+                value_before = attributes_before[attribute]
+                value_after = attributes_after[attribute]
+                if attribute.endswith('_ms') and max(value_before, value_after) < min_time_ms:
+                    continue
+                if value_after > value_before * (1 + threshold):
+                    regressions.append((project, preset, attribute, value_before, value_after))
+
+    return regressions
+
+
+def parse_project(value: str) -> Tuple[str, Path]:
+    name, separator, path = value.partition('=')
+    if separator == '' or name == '' or path == '':
+        raise BenchmarkError(f"Invalid project specification: '{value}'. Expected <name>=<directory>.")
+    return name, Path(path)
+
+
+def parse_command_line(args: Optional[Sequence[str]]):
+    parser = ArgumentParser(description="Benchmarks the compilation time of solc and compares the results.")
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help="Compile the corpus and write a report.")
+    run_parser.add_argument('--solc', type=Path, required=True, help="Path to the solc binary to benchmark.")
+    run_parser.add_argument('--output', type=Path, help="Where to write the JSON report. Standard output by default.")
+    run_parser.add_argument(
+        '--project',
+        dest='projects',
+        action='append',
+        default=[],
+        metavar='NAME=DIR',
+        help=(
+            "Additional project to compile, e.g. a checkout of OpenZeppelin, Uniswap or ENS. "
+            "All .sol files outside of node_modules/ are compiled together, imports are resolved "
+            "relative to DIR and DIR/node_modules/. Can be given multiple times."
+        ),
+    )
+    run_parser.add_argument('--no-default-projects', action='store_true', help="Do not compile the built-in corpus.")
+    run_parser.add_argument(
+        '--generated',
+        type=int,
+        nargs='*',
+        default=DEFAULT_GENERATED_FUNCTION_COUNTS,
+        metavar='FUNCTIONS',
+        help="Function counts of the generated contracts to compile.",
+    )
+    run_parser.add_argument('--preset', dest='presets', action='append', choices=PRESETS.keys(), help="Presets to run. All by default.")
+    run_parser.add_argument('--repetitions', type=int, default=3, help="Number of times to compile each project in each preset.")
+
+    compare_parser = subparsers.add_parser('compare', help="Compare two reports and report regressions.")
+    compare_parser.add_argument('before', type=Path)
+    compare_parser.add_argument('after', type=Path)
+    compare_parser.add_argument('--threshold', type=float, default=0.05, help="Largest allowed relative increase.")
+    compare_parser.add_argument(
+        '--min-time-ms',
+        type=float,
+        default=DEFAULT_MIN_TIME_MS,
+        help="Ignore timings that are shorter than this in both reports.",
+    )
+
+    return parser.parse_args(args)
+
+
+def main(args: Optional[Sequence[str]] = None) -> int:
+    try:
+        options = parse_command_line(args)
+
+        if options.command == 'run':
+            projects = {} if options.no_default_projects else {path.name: path for path in DEFAULT_PROJECT_DIRS}
+            projects.update(parse_project(project) for project in options.projects)
+            report = benchmark(
+                options.solc,
+                projects,
+                options.generated,
+                options.presets or list(PRESETS),
+                options.repetitions,
+            )
+            report_json = json.dumps(report, indent=4, sort_keys=True)
+            if options.output is None:
+                print(report_json)
+            else:
+                options.output.write_text(report_json + '\n', encoding='utf-8')
+            return 0
+
+        assert options.command == 'compare'
+        before = json.loads(options.before.read_text(encoding='utf-8'))
+        after = json.loads(options.after.read_text(encoding='utf-8'))
+        regressions = find_regressions(before, after, options.threshold, options.min_time_ms)
+        for project, preset, attribute, value_before, value_after in regressions:
+            increase = f"+{(value_after / value_before - 1) * 100:.1f}%" if value_before != 0 else "new"
+            print(f"{project} ({preset}): {attribute} {value_before} -> {value_after} ({increase})")
+        if len(regressions) > 0:
+            print(f"{len(regressions)} regression(s) above {options.threshold * 100:g}%.", file=sys.stderr)
+            return 1
+        print("No regressions.", file=sys.stderr)
+        return 0
+    except BenchmarkError as exception:
+        print(f"[ERROR] {exception}", file=sys.stderr)
+        return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -42,6 +42,7 @@
 #include <libsolidity/lsp/Transport.h>
 
 #include <libyul/YulStack.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Disassemble.h>
@@ -57,10 +58,12 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <sstream>
 
 #include <range/v3/view/map.hpp>
 
@@ -471,6 +474,7 @@ void CommandLineInterface::readInputFiles()
 		solThrow(CommandLineValidationError, message);
 	}
 
+	vector<boost::filesystem::path> filesToRead;
 	for (boost::filesystem::path const& infile: m_options.input.paths)
 	{
 		if (!boost::filesystem::exists(infile))
@@ -493,17 +497,28 @@ void CommandLineInterface::readInputFiles()
 			continue;
 		}
 
+		filesToRead.push_back(infile);
+	}
+
+	// Reading is dominated by I/O latency on slow (e.g. network) filesystems, so the files are
+	// read concurrently. They are added in the original order afterwards.
+	vector<string> fileContents(filesToRead.size());
+	util::parallelFor(filesToRead.size(), m_options.compiler.jobs, [&](size_t _index) {
 		// NOTE: we ignore the FileNotFound exception as we manually check above
-		string fileContent = readFileAsString(infile);
+		fileContents[_index] = readFileAsString(filesToRead[_index]);
+	});
+
+	for (size_t i = 0; i < filesToRead.size(); ++i)
+	{
 		if (m_options.input.mode == InputMode::StandardJson)
 		{
 			solAssert(!m_standardJsonInput.has_value(), "");
-			m_standardJsonInput = move(fileContent);
+			m_standardJsonInput = move(fileContents[i]);
 		}
 		else
 		{
-			m_fileReader.addOrUpdateFile(infile, move(fileContent));
-			m_fileReader.allowDirectory(boost::filesystem::canonical(infile).remove_filename());
+			m_fileReader.addOrUpdateFile(filesToRead[i], move(fileContents[i]));
+			m_fileReader.allowDirectory(boost::filesystem::canonical(filesToRead[i]).remove_filename());
 		}
 	}
 
@@ -520,6 +535,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::StandardJsonServer &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -557,24 +573,45 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	solAssert(!m_options.output.dir.empty(), "");
+
+	string pathName = (m_options.output.dir / _fileName).string();
+	auto [it, inserted] = m_pendingFileIndices.emplace(pathName, m_pendingFiles.size());
+	if (inserted)
+		m_pendingFiles.emplace_back(pathName, _data);
+	else if (m_options.output.overwriteFiles)
+		m_pendingFiles[it->second].second = _data;
+	else
+		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
+}
+
+void CommandLineInterface::writePendingFiles()
 {
 	namespace fs = boost::filesystem;
 
-	solAssert(!m_options.output.dir.empty(), "");
+	if (m_pendingFiles.empty())
+		return;
 
 	// NOTE: create_directories() raises an exception if the path consists solely of '.' or '..'
 	// (or equivalent such as './././.'). Paths like 'a/b/.' and 'a/b/..' are fine though.
 	// The simplest workaround is to use an absolute path.
 	fs::create_directories(fs::absolute(m_options.output.dir));
 
-	string pathName = (m_options.output.dir / _fileName).string();
-	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
-		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
+	vector<pair<string, string>> files = std::move(m_pendingFiles);
+	m_pendingFiles.clear();
+	m_pendingFileIndices.clear();
 
-	ofstream outFile(pathName);
-	outFile << _data;
-	if (!outFile)
-		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+	util::parallelFor(files.size(), m_options.compiler.jobs, [&](size_t _index) {
+		auto const& [pathName, data] = files[_index];
+		if (!m_options.output.overwriteFiles && fs::exists(pathName))
+			solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
+
+		ofstream outFile(pathName);
+		outFile << data;
+		if (!outFile)
+			solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
+	});
 }
 
 void CommandLineInterface::createJson(string const& _fileName, string const& _json)
@@ -642,11 +679,16 @@ void CommandLineInterface::processInput()
 	{
 		solAssert(m_standardJsonInput.has_value(), "");
 
-		StandardCompiler compiler(m_fileReader.reader(), m_options.formatting.json);
+		StandardCompiler compiler(readCallback(), m_options.formatting.json);
+		if (!m_options.compiler.cacheDir.empty())
+			compiler.setCacheDirectory(m_options.compiler.cacheDir);
 		sout() << compiler.compile(move(m_standardJsonInput.value())) << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
+	case InputMode::StandardJsonServer:
+		serveStandardJson();
+		break;
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
@@ -677,11 +719,21 @@ void CommandLineInterface::printLicense()
 	sout() << licenseText << endl;
 }
 
+ReadCallback::Callback CommandLineInterface::readCallback()
+{
+	if (!m_options.modelChecker.solverCommand.has_value())
+		return m_fileReader.reader();
+
+	if (!m_smtSolverPool)
+		m_smtSolverPool = make_unique<SMTSolverProcessPool>(*m_options.modelChecker.solverCommand);
+	return m_smtSolverPool->callback(m_fileReader.reader());
+}
+
 void CommandLineInterface::compile()
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
 
-	m_compiler = make_unique<CompilerStack>(m_fileReader.reader());
+	m_compiler = make_unique<CompilerStack>(readCallback());
 
 	SourceReferenceFormatter formatter(serr(false), *m_compiler, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
@@ -695,13 +747,20 @@ void CommandLineInterface::compile()
 		m_compiler->setRemappings(m_options.input.remappings);
 		m_compiler->setLibraries(m_options.linker.libraries);
 		m_compiler->setViaIR(m_options.output.viaIR);
+		m_compiler->setParallelism(m_options.compiler.jobs);
+		m_compiler->enableProfiling(m_options.compiler.timePasses || m_options.compiler.memoryProfile);
+		m_compiler->enableOptimiserProfiling(m_options.optimizer.profile);
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
+		m_compiler->setABIDecoderMode(m_options.output.abiDecoderMode);
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
 
-		m_compiler->enableIRGeneration(m_options.compiler.outputs.ir || m_options.compiler.outputs.irOptimized);
+		m_compiler->enableIRGeneration(
+			m_options.compiler.outputs.ir || m_options.compiler.outputs.irOptimized,
+			m_options.compiler.outputs.irOptimized
+		);
 		m_compiler->enableEwasmGeneration(m_options.compiler.outputs.ewasm);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
@@ -753,12 +812,19 @@ void CommandLineInterface::compile()
 
 		bool successful = m_compiler->compile(m_options.output.stopAfter);
 
-		for (auto const& error: m_compiler->errors())
+		if (!m_compiler->errors().empty())
 		{
 			m_hasOutput = true;
-			formatter.printErrorInformation(*error);
+			formatter.printErrorInformation(m_compiler->errors(), m_options.formatting.maxWarningsPerSource);
 		}
 
+		if (m_options.compiler.timePasses)
+			serr() << m_compiler->profiler()->toString();
+		if (m_options.compiler.memoryProfile)
+			serr() << m_compiler->profiler()->memoryString();
+		if (m_compiler->optimiserProfile())
+			serr() << m_compiler->optimiserProfile()->toString();
+
 		if (!successful && !m_options.input.errorRecovery)
 			solThrow(CommandLineExecutionError, "");
 	}
@@ -784,6 +850,54 @@ void CommandLineInterface::compile()
 	}
 }
 
+Json::Value CommandLineInterface::combinedJsonContract(string const& _contractName)
+{
+	Json::Value contractData(Json::objectValue);
+	if (m_options.compiler.combinedJsonRequests->abi)
+		contractData[g_strAbi] = m_compiler->contractABI(_contractName);
+	if (m_options.compiler.combinedJsonRequests->metadata)
+		contractData["metadata"] = m_compiler->metadata(_contractName);
+	if (m_options.compiler.combinedJsonRequests->binary && m_compiler->compilationSuccessful())
+		contractData[g_strBinary] = m_compiler->object(_contractName).toHex();
+	if (m_options.compiler.combinedJsonRequests->binaryRuntime && m_compiler->compilationSuccessful())
+		contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(_contractName).toHex();
+	if (m_options.compiler.combinedJsonRequests->opcodes && m_compiler->compilationSuccessful())
+		contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(_contractName).bytecode);
+	if (m_options.compiler.combinedJsonRequests->asm_ && m_compiler->compilationSuccessful())
+		contractData[g_strAsm] = m_compiler->assemblyJSON(_contractName);
+	if (m_options.compiler.combinedJsonRequests->storageLayout && m_compiler->compilationSuccessful())
+		contractData[g_strStorageLayout] = m_compiler->storageLayout(_contractName);
+	if (m_options.compiler.combinedJsonRequests->generatedSources && m_compiler->compilationSuccessful())
+		contractData[g_strGeneratedSources] = m_compiler->generatedSources(_contractName, false);
+	if (m_options.compiler.combinedJsonRequests->generatedSourcesRuntime && m_compiler->compilationSuccessful())
+		contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(_contractName, true);
+	if (m_options.compiler.combinedJsonRequests->srcMap && m_compiler->compilationSuccessful())
+	{
+		auto map = m_compiler->sourceMapping(_contractName);
+		contractData[g_strSrcMap] = map ? *map : "";
+	}
+	if (m_options.compiler.combinedJsonRequests->srcMapRuntime && m_compiler->compilationSuccessful())
+	{
+		auto map = m_compiler->runtimeSourceMapping(_contractName);
+		contractData[g_strSrcMapRuntime] = map ? *map : "";
+	}
+	if (m_options.compiler.combinedJsonRequests->funDebug && m_compiler->compilationSuccessful())
+		contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
+			m_compiler->object(_contractName).functionDebugData
+		);
+	if (m_options.compiler.combinedJsonRequests->funDebugRuntime && m_compiler->compilationSuccessful())
+		contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
+			m_compiler->runtimeObject(_contractName).functionDebugData
+		);
+	if (m_options.compiler.combinedJsonRequests->signatureHashes)
+		contractData[g_strSignatureHashes] = m_compiler->interfaceSymbols(_contractName)["methods"];
+	if (m_options.compiler.combinedJsonRequests->natspecDev)
+		contractData[g_strNatspecDev] = m_compiler->natspecDev(_contractName);
+	if (m_options.compiler.combinedJsonRequests->natspecUser)
+		contractData[g_strNatspecUser] = m_compiler->natspecUser(_contractName);
+	return contractData;
+}
+
 void CommandLineInterface::handleCombinedJSON()
 {
 	solAssert(m_options.input.mode == InputMode::Compiler || m_options.input.mode == InputMode::CompilerWithASTImport, "");
@@ -791,89 +905,100 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_options.compiler.combinedJsonRequests.has_value())
 		return;
 
-	Json::Value output(Json::objectValue);
-
-	output[g_strVersion] = frontend::VersionString;
 	vector<string> contracts = m_compiler->contractNames();
+	bool needsSourceList =
+		m_options.compiler.combinedJsonRequests->ast ||
+		m_options.compiler.combinedJsonRequests->srcMap ||
+		m_options.compiler.combinedJsonRequests->srcMapRuntime;
 
-	if (!contracts.empty())
-		output[g_strContracts] = Json::Value(Json::objectValue);
-	for (string const& contractName: contracts)
+	auto sourceList = [&]() {
+		// Indices into this array are used to abbreviate source names in source locations.
+		Json::Value sourceList(Json::arrayValue);
+		for (auto const& source: m_compiler->sourceNames())
+			sourceList.append(source);
+		return sourceList;
+	};
+	auto sourceAST = [&](string const& _sourceName) {
+		ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
+		Json::Value source(Json::objectValue);
+		source["AST"] = converter.toJson(m_compiler->ast(_sourceName));
+		return source;
+	};
+
+	if (m_options.formatting.json.format != JsonFormat::Compact)
 	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
-		if (m_options.compiler.combinedJsonRequests->abi)
-			contractData[g_strAbi] = m_compiler->contractABI(contractName);
-		if (m_options.compiler.combinedJsonRequests->metadata)
-			contractData["metadata"] = m_compiler->metadata(contractName);
-		if (m_options.compiler.combinedJsonRequests->binary && m_compiler->compilationSuccessful())
-			contractData[g_strBinary] = m_compiler->object(contractName).toHex();
-		if (m_options.compiler.combinedJsonRequests->binaryRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
-		if (m_options.compiler.combinedJsonRequests->opcodes && m_compiler->compilationSuccessful())
-			contractData[g_strOpcodes] = evmasm::disassemble(m_compiler->object(contractName).bytecode);
-		if (m_options.compiler.combinedJsonRequests->asm_ && m_compiler->compilationSuccessful())
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName);
-		if (m_options.compiler.combinedJsonRequests->storageLayout && m_compiler->compilationSuccessful())
-			contractData[g_strStorageLayout] = m_compiler->storageLayout(contractName);
-		if (m_options.compiler.combinedJsonRequests->generatedSources && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSources] = m_compiler->generatedSources(contractName, false);
-		if (m_options.compiler.combinedJsonRequests->generatedSourcesRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strGeneratedSourcesRuntime] = m_compiler->generatedSources(contractName, true);
-		if (m_options.compiler.combinedJsonRequests->srcMap && m_compiler->compilationSuccessful())
+		Json::Value output(Json::objectValue);
+
+		output[g_strVersion] = frontend::VersionString;
+		if (!contracts.empty())
+			output[g_strContracts] = Json::Value(Json::objectValue);
+		for (string const& contractName: contracts)
+			output[g_strContracts][contractName] = combinedJsonContract(contractName);
+		if (needsSourceList)
+			output[g_strSourceList] = sourceList();
+		if (m_options.compiler.combinedJsonRequests->ast)
 		{
-			auto map = m_compiler->sourceMapping(contractName);
-			contractData[g_strSrcMap] = map ? *map : "";
+			output[g_strSources] = Json::Value(Json::objectValue);
+			for (auto const& sourceCode: m_fileReader.sourceUnits())
+				output[g_strSources][sourceCode.first] = sourceAST(sourceCode.first);
 		}
-		if (m_options.compiler.combinedJsonRequests->srcMapRuntime && m_compiler->compilationSuccessful())
+
+		string json = jsonPrint(removeNullMembers(std::move(output)), m_options.formatting.json);
+		if (!m_options.output.dir.empty())
+			createJson("combined", json);
+		else
+			sout() << json << endl;
+		return;
+	}
+
+	// Compact output is printed member by member, so that the data of all contracts and sources
+	// is never held in a single JSON value. Members are printed in the order jsoncpp would use,
+	// i.e. sorted by key, which keeps the output identical to printing the whole object at once.
+	ostringstream fileContent;
+	ostream& out = m_options.output.dir.empty() ? sout() : fileContent;
+	auto printKey = [&](string const& _key) { out << jsonCompactPrint(_key) << ':'; };
+
+	out << '{';
+	if (!contracts.empty())
+	{
+		printKey(g_strContracts);
+		out << '{';
+		for (size_t i = 0; i < contracts.size(); ++i)
 		{
-			auto map = m_compiler->runtimeSourceMapping(contractName);
-			contractData[g_strSrcMapRuntime] = map ? *map : "";
+			if (i > 0)
+				out << ',';
+			printKey(contracts[i]);
+			out << jsonCompactPrint(removeNullMembers(combinedJsonContract(contracts[i])));
 		}
-		if (m_options.compiler.combinedJsonRequests->funDebug && m_compiler->compilationSuccessful())
-			contractData[g_strFunDebug] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->object(contractName).functionDebugData
-			);
-		if (m_options.compiler.combinedJsonRequests->funDebugRuntime && m_compiler->compilationSuccessful())
-			contractData[g_strFunDebugRuntime] = StandardCompiler::formatFunctionDebugData(
-				m_compiler->runtimeObject(contractName).functionDebugData
-			);
-		if (m_options.compiler.combinedJsonRequests->signatureHashes)
-			contractData[g_strSignatureHashes] = m_compiler->interfaceSymbols(contractName)["methods"];
-		if (m_options.compiler.combinedJsonRequests->natspecDev)
-			contractData[g_strNatspecDev] = m_compiler->natspecDev(contractName);
-		if (m_options.compiler.combinedJsonRequests->natspecUser)
-			contractData[g_strNatspecUser] = m_compiler->natspecUser(contractName);
+		out << "},";
 	}
-
-	bool needsSourceList =
-		m_options.compiler.combinedJsonRequests->ast ||
-		m_options.compiler.combinedJsonRequests->srcMap ||
-		m_options.compiler.combinedJsonRequests->srcMapRuntime;
 	if (needsSourceList)
 	{
-		// Indices into this array are used to abbreviate source names in source locations.
-		output[g_strSourceList] = Json::Value(Json::arrayValue);
-
-		for (auto const& source: m_compiler->sourceNames())
-			output[g_strSourceList].append(source);
+		printKey(g_strSourceList);
+		out << jsonCompactPrint(sourceList()) << ',';
 	}
-
 	if (m_options.compiler.combinedJsonRequests->ast)
 	{
-		output[g_strSources] = Json::Value(Json::objectValue);
+		printKey(g_strSources);
+		out << '{';
+		bool first = true;
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
 		{
-			ASTJsonConverter converter(m_compiler->state(), m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			if (!first)
+				out << ',';
+			first = false;
+			printKey(sourceCode.first);
+			out << jsonCompactPrint(removeNullMembers(sourceAST(sourceCode.first)));
 		}
+		out << "},";
 	}
+	printKey(g_strVersion);
+	out << jsonCompactPrint(frontend::VersionString) << '}';
 
-	string json = jsonPrint(removeNullMembers(std::move(output)), m_options.formatting.json);
 	if (!m_options.output.dir.empty())
-		createJson("combined", json);
+		createJson("combined", fileContent.str());
 	else
-		sout() << json << endl;
+		out << endl;
 }
 
 void CommandLineInterface::handleAst()
@@ -917,65 +1042,127 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveStandardJson()
+{
+	// Outputs are always compact so that every response fits on a single line.
+	StandardCompiler compiler(readCallback());
+	compiler.keepCompilerStack();
+	if (!m_options.compiler.cacheDir.empty())
+		compiler.setCacheDirectory(m_options.compiler.cacheDir);
+
+	string request;
+	while (getline(m_sin, request))
+	{
+		if (request.find_first_not_of(" \t\r") == string::npos)
+			continue;
+		sout() << compiler.compile(request) << endl;
+	}
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker, "");
 
-	// Map from how the libraries will be named inside the bytecode to their addresses.
-	map<string, h160> librariesReplacements;
-	int const placeholderSize = 40; // 20 bytes or 40 hex characters
+	// Map from how the libraries will be named inside the bytecode to the hex representation
+	// of their addresses. The comparator allows looking up placeholders without copying them.
+	map<string, string, less<>> librariesReplacements;
+	// Map from the placeholders of the libraries to the hints that name them in the object files.
+	map<string, string, less<>> libraryHints;
+	size_t const placeholderSize = 40; // 20 bytes or 40 hex characters
 	for (auto const& library: m_options.linker.libraries)
 	{
 		string const& name = library.first;
+		string const addressHex = util::toHex(library.second.asBytes());
 		// Library placeholders are 40 hex digits (20 bytes) that start and end with '__'.
 		// This leaves 36 characters for the library identifier. The identifier used to
 		// be just the cropped or '_'-padded library name, but this changed to
 		// the cropped hex representation of the hash of the library name.
 		// We support both ways of linking here.
-		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = library.second;
+		librariesReplacements["__" + evmasm::LinkerObject::libraryPlaceholder(name) + "__"] = addressHex;
+		libraryHints[evmasm::LinkerObject::libraryPlaceholder(name)] = libraryPlaceholderHint(name);
 
 		string replacement = "__";
 		for (size_t i = 0; i < placeholderSize - 4; ++i)
 			replacement.push_back(i < name.size() ? name[i] : '_');
 		replacement += "__";
-		librariesReplacements[replacement] = library.second;
+		librariesReplacements[replacement] = addressHex;
 	}
 
 	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
+	vector<pair<string const, string>*> files;
 	for (auto& src: sourceCodes)
-	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		files.push_back(&src);
+
+	// The files are independent, so they are linked concurrently. Diagnostics are collected
+	// per file and reported in the original order afterwards.
+	vector<string> unresolvedReferences(files.size());
+	vector<exception_ptr> errors(files.size());
+	util::parallelFor(files.size(), m_options.compiler.jobs, [&](size_t _index) {
+		try
 		{
-			while (it != end && *it != '_') ++it;
-			if (it == end) break;
-			if (
-				end - it < placeholderSize ||
-				*(it + 1) != '_' ||
-				*(it + placeholderSize - 2) != '_' ||
-				*(it + placeholderSize - 1) != '_'
-			)
-				solThrow(
-					CommandLineExecutionError,
-					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
-					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
-				);
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
+			auto& [fileName, code] = *files[_index];
+			for (size_t pos = code.find('_'); pos != string::npos; pos = code.find('_', pos))
 			{
-				string hexStr(util::toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
+				if (
+					code.size() - pos < placeholderSize ||
+					code[pos + 1] != '_' ||
+					code[pos + placeholderSize - 2] != '_' ||
+					code[pos + placeholderSize - 1] != '_'
+				)
+					solThrow(
+						CommandLineExecutionError,
+						"Error in binary object file " + fileName + " at position " + to_string(pos) + "\n" +
+						'"' + code.substr(pos, placeholderSize) + "\" is not a valid link reference."
+					);
+
+				string_view foundPlaceholder(code.data() + pos, placeholderSize);
+				if (auto replacement = librariesReplacements.find(foundPlaceholder); replacement != librariesReplacements.end())
+					code.replace(pos, placeholderSize, replacement->second);
+				else
+					unresolvedReferences[_index] +=
+						"Reference \"" + string(foundPlaceholder) + "\" in file \"" + fileName + "\" still unresolved.\n";
+				pos += placeholderSize;
 			}
-			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
-			it += placeholderSize;
+
+			// Remove hints for resolved libraries. They have the form "// <placeholder> -> <name>"
+			// and are looked up by their placeholder, so that the file is only scanned once.
+			if (!libraryHints.empty())
+			{
+				string const hintPrefix = "\n// ";
+				size_t const placeholderLength = placeholderSize - 4;
+				string result;
+				size_t copiedUntil = 0;
+				for (size_t pos = code.find(hintPrefix); pos != string::npos; pos = code.find(hintPrefix, pos + 1))
+				{
+					if (pos < copiedUntil)
+						continue;
+					auto hint = libraryHints.find(string_view(code).substr(pos + hintPrefix.size(), placeholderLength));
+					if (hint == libraryHints.end() || code.compare(pos + 1, hint->second.size(), hint->second) != 0)
+						continue;
+					result.append(code, copiedUntil, pos - copiedUntil);
+					copiedUntil = pos + 1 + hint->second.size();
+				}
+				if (copiedUntil > 0)
+				{
+					result.append(code, copiedUntil, string::npos);
+					code = move(result);
+				}
+			}
+			while (!code.empty() && code.back() == '\n')
+				code.pop_back();
 		}
-		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+		catch (...)
+		{
+			errors[_index] = current_exception();
+		}
+	});
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (!unresolvedReferences[i].empty())
+			serr() << unresolvedReferences[i];
+		if (errors[i])
+			rethrow_exception(errors[i]);
 	}
 	m_fileReader.setSourceUnits(move(sourceCodes));
 }
@@ -1018,6 +1205,9 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 {
 	solAssert(m_options.input.mode == InputMode::Assembler, "");
 
+	yul::OptimiserProfile optimiserProfile;
+	yul::OptimiserProfile::Activation optimiserProfileActivation(m_options.optimizer.profile ? &optimiserProfile : nullptr);
+
 	bool successful = true;
 	map<string, yul::YulStack> yulStacks;
 	for (auto const& src: m_fileReader.sourceUnits())
@@ -1045,10 +1235,10 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 		auto const& stack = sourceAndStack.second;
 		SourceReferenceFormatter formatter(serr(false), stack, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
-		for (auto const& error: stack.errors())
+		if (!stack.errors().empty())
 		{
 			m_hasOutput = true;
-			formatter.printErrorInformation(*error);
+			formatter.printErrorInformation(stack.errors(), m_options.formatting.maxWarningsPerSource);
 		}
 		if (Error::containsErrors(stack.errors()))
 			successful = false;
@@ -1116,6 +1306,9 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 				serr() << "No text representation found." << endl;
 		}
 	}
+
+	if (m_options.optimizer.profile)
+		serr() << optimiserProfile.toString();
 }
 
 void CommandLineInterface::outputCompilationResults()
@@ -1132,6 +1325,7 @@ void CommandLineInterface::outputCompilationResults()
 		m_options.output.stopAfter == CompilerStack::State::CompilationSuccessful
 	)
 	{
+		writePendingFiles();
 		serr() << endl << "Compilation halted after AST generation due to errors." << endl;
 		return;
 	}
@@ -1170,8 +1364,13 @@ void CommandLineInterface::outputCompilationResults()
 		handleStorageLayout(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
+
+		if (m_compiler->compilationSuccessful())
+			m_compiler->releaseCompiledOutputs(contract);
 	} // end of contracts iteration
 
+	writePendingFiles();
+
 	if (!m_hasOutput)
 	{
 		if (!m_options.output.dir.empty())
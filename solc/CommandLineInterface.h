@@ -23,6 +23,7 @@
 #pragma once
 
 #include <solc/CommandLineParser.h>
+#include <solc/SMTSolverProcessPool.h>
 
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/DebugSettings.h>
@@ -30,8 +31,11 @@
 #include <libyul/YulStack.h>
 
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -82,6 +86,8 @@ private:
 	void printVersion();
 	void printLicense();
 	void compile();
+	/// Answers newline-delimited Standard JSON requests from the input stream until it ends.
+	void serveStandardJson();
 	void serveLSP();
 	void link();
 	void writeLinkedFiles();
@@ -92,9 +98,14 @@ private:
 
 	void assemble(yul::YulStack::Language _language, yul::YulStack::Machine _targetMachine);
 
+	/// @returns the callback through which the compiler reads files and, if a solver command
+	/// was given, answers SMT queries.
+	frontend::ReadCallback::Callback readCallback();
+
 	void outputCompilationResults();
 
 	void handleCombinedJSON();
+	Json::Value combinedJsonContract(std::string const& _contractName);
 	void handleAst();
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
@@ -115,11 +126,15 @@ private:
 	/// or standard-json output
 	std::map<std::string, Json::Value> parseAstFromInput();
 
-	/// Create a file in the given directory
+	/// Queue a file to be created in the given directory by @a writePendingFiles
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
 
+	/// Writes the files queued by @a createFile, using up to `--jobs` threads.
+	/// If several files cannot be written, the error about the one queued first is reported.
+	void writePendingFiles();
+
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
 	/// @arg _json json string to be written
@@ -137,7 +152,12 @@ private:
 	std::ostream& m_sout;
 	std::ostream& m_serr;
 	bool m_hasOutput = false;
+	/// Files queued by @a createFile as pairs of path and content, in the order they were queued.
+	std::vector<std::pair<std::string, std::string>> m_pendingFiles;
+	/// Index of each queued path in @a m_pendingFiles.
+	std::map<std::string, size_t> m_pendingFileIndices;
 	FileReader m_fileReader;
+	std::unique_ptr<SMTSolverProcessPool> m_smtSolverPool;
 	std::optional<std::string> m_standardJsonInput;
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
 	CommandLineOptions m_options;
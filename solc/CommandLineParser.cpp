@@ -24,6 +24,8 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <boost/algorithm/string.hpp>
 
 #include <range/v3/view/transform.hpp>
@@ -38,10 +40,12 @@ namespace po = boost::program_options;
 namespace solidity::frontend
 {
 
+static string const g_strABIDecoderMode = "abi-decoder-mode";
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strErrorRecovery = "error-recovery";
 static string const g_strEVM = "evm";
@@ -53,6 +57,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strDebugInfo = "debug-info";
@@ -64,11 +69,15 @@ static string const g_strLSP = "lsp";
 static string const g_strMachine = "machine";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
+static string const g_strModelCheckerSliceQueries = "model-checker-slice-queries";
+static string const g_strModelCheckerSolverCommand = "model-checker-solver-command";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
@@ -78,10 +87,17 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerBudget = "yul-optimizer-budget";
+static string const g_strDispatcher = "dispatcher";
+static string const g_strExperimentalOptimizations = "experimental-optimizations";
+static string const g_strOptimizeInlineAssemblyStack = "optimize-inline-assembly-stack";
 static string const g_strOutputDir = "output-dir";
+static string const g_strProfileOptimizer = "profile-optimizer";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStopAfter = "stop-after";
+static string const g_strTimePasses = "time-passes";
+static string const g_strMemoryProfile = "memory-profile";
 static string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -95,6 +111,7 @@ static set<string> const g_revertStringsArgs
 
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
+static string const g_strServer = "server";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
@@ -105,6 +122,7 @@ static string const g_strIgnoreMissingFiles = "ignore-missing";
 static string const g_strColor = "color";
 static string const g_strNoColor = "no-color";
 static string const g_strErrorIds = "error-codes";
+static string const g_strMaxWarningsPerSource = "max-warnings-per-source";
 
 /// Possible arguments to for --machine
 static set<string> const g_machineArgs
@@ -136,6 +154,7 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::CompilerWithASTImport, "compiler (AST import)"},
 	{InputMode::Assembler, "assembler"},
 	{InputMode::StandardJson, "standard JSON"},
+	{InputMode::StandardJsonServer, "standard JSON server"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 };
@@ -228,6 +247,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.evmVersion == _other.output.evmVersion &&
 		output.viaIR == _other.output.viaIR &&
 		output.revertStrings == _other.output.revertStrings &&
+		output.abiDecoderMode == _other.output.abiDecoderMode &&
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
 		input.mode == _other.input.mode &&
@@ -237,8 +257,13 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		formatting.json == _other.formatting.json &&
 		formatting.coloredOutput == _other.formatting.coloredOutput &&
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
+		formatting.maxWarningsPerSource == _other.formatting.maxWarningsPerSource &&
 		compiler.outputs == _other.compiler.outputs &&
 		compiler.estimateGas == _other.compiler.estimateGas &&
+		compiler.jobs == _other.compiler.jobs &&
+		compiler.timePasses == _other.compiler.timePasses &&
+		compiler.memoryProfile == _other.compiler.memoryProfile &&
+		compiler.cacheDir == _other.compiler.cacheDir &&
 		compiler.combinedJsonRequests == _other.compiler.combinedJsonRequests &&
 		metadata.hash == _other.metadata.hash &&
 		metadata.literalSources == _other.metadata.literalSources &&
@@ -246,8 +271,14 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.yulBudget == _other.optimizer.yulBudget &&
+		optimizer.dispatcher == _other.optimizer.dispatcher &&
+		optimizer.experimental == _other.optimizer.experimental &&
+		optimizer.inlineAssemblyStack == _other.optimizer.inlineAssemblyStack &&
+		optimizer.profile == _other.optimizer.profile &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		modelChecker.solverCommand == _other.modelChecker.solverCommand;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -268,6 +299,13 @@ OptimiserSettings CommandLineOptions::optimiserSettings() const
 	if (optimizer.yulSteps.has_value())
 		settings.yulOptimiserSteps = optimizer.yulSteps.value();
 
+	if (optimizer.yulBudget.has_value())
+		settings.yulOptimiserBudget = optimizer.yulBudget.value();
+
+	settings.functionDispatch = optimizer.dispatcher;
+	settings.experimentalOptimisations = optimizer.experimental;
+	settings.optimizeInlineAssemblyStack = optimizer.inlineAssemblyStack;
+
 	return settings;
 }
 
@@ -290,7 +328,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::StandardJsonServer)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -330,6 +368,14 @@ void CommandLineParser::parseInputPathsAndRemappings()
 			// Keep it working that way for backwards-compatibility.
 			m_options.input.addStdin = true;
 	}
+	else if (m_options.input.mode == InputMode::StandardJsonServer)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strServer + " reads its requests from standard input and does not accept input files."
+			);
+	}
 	else if (m_options.input.paths.size() == 0 && !m_options.input.addStdin)
 		solThrow(
 			CommandLineValidationError,
@@ -466,6 +512,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::StandardJsonServer:
 		case InputMode::Linker:
 			return false;
 		}
@@ -585,11 +632,32 @@ General Information)").c_str(),
 			g_strViaIR.c_str(),
 			"Turn on compilation mode via the IR."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used to optimize the IR and to generate bytecode from the IR of independent contracts "
+			"(only together with --via-ir), to read input files and write output files and to link files in linker mode. "
+			"A value of 0 uses as many threads as the hardware supports."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory of a persistent cache of compilation results. "
+			"Only supported in Standard JSON mode."
+		)
 		(
 			g_strRevertStrings.c_str(),
 			po::value<string>()->value_name(util::joinHumanReadable(g_revertStringsArgs, ",")),
 			"Strip revert (and require) reason strings or add additional debugging information."
 		)
+		(
+			g_strABIDecoderMode.c_str(),
+			po::value<string>()->value_name(
+				abiDecoderModeToString(ABIDecoderMode::Default) + "," + abiDecoderModeToString(ABIDecoderMode::Compact)
+			),
+			"Generate specialised ABI decoders for every combination of parameter types (default) or "
+			"share the decoders between types that are decoded in the same way (compact), which results in smaller code."
+		)
 		(
 			g_strDebugInfo.c_str(),
 			po::value<string>()->default_value(util::toString(DebugInfoSelection::Default())),
@@ -600,7 +668,7 @@ General Information)").c_str(),
 		(
 			g_strStopAfter.c_str(),
 			po::value<string>()->value_name("stage"),
-			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
+			"Stop execution after the given compiler stage. Valid options: \"parsing\", \"nameResolution\", \"typeChecking\"."
 		)
 	;
 	desc.add(outputOptions);
@@ -612,6 +680,13 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to Standard JSON server mode, ignoring all options except "
+			"--" + g_strCacheDir + ", --" + g_strBasePath + ", --" + g_strIncludePath + " and --" + g_strAllowPaths + ". "
+			"Reads one Standard JSON input per line from standard input and writes each output as a single line "
+			"to standard output. Parsed sources are kept between requests.").c_str()
+		)
 		(
 			g_strLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_strLibraries + " "
@@ -699,6 +774,12 @@ General Information)").c_str(),
 			g_strErrorIds.c_str(),
 			"Output error codes."
 		)
+		(
+			g_strMaxWarningsPerSource.c_str(),
+			po::value<size_t>()->value_name("N"),
+			"Only output the first N warnings of each source file and the number of the others, "
+			"per error code if --error-codes is given."
+		)
 	;
 	desc.add(outputFormatting);
 
@@ -734,6 +815,15 @@ General Information)").c_str(),
 			po::value<string>()->value_name(util::joinHumanReadable(CombinedJsonRequests::componentMap() | ranges::views::keys, ",")),
 			"Output a single json document containing the specified information."
 		)
+		(
+			g_strTimePasses.c_str(),
+			"Print the wall time and peak memory usage of each compilation phase to stderr."
+		)
+		(
+			g_strMemoryProfile.c_str(),
+			"Print the heap memory allocated and retained by each compilation phase and the number of "
+			"AST nodes, types and generated code items kept until the end of the compilation to stderr."
+		)
 	;
 	desc.add(extraOutput);
 
@@ -778,6 +868,45 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strYulOptimizerBudget.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Limit the work of the yul optimizer sequence on each object. Every step is charged with the size of the code "
+			"it is applied to. Once the total reaches n, only the steps required for code generation are run."
+		)
+		(
+			g_strDispatcher.c_str(),
+			po::value<string>()->value_name(
+				functionDispatchToString(FunctionDispatch::Default) + "," +
+				functionDispatchToString(FunctionDispatch::Linear) + "," +
+				functionDispatchToString(FunctionDispatch::BinarySearch)
+			),
+			"Shape of the code that selects the external function to call. linear compares the selector with "
+			"every function in turn, binarySearch splits the functions around a pivot as long as this pays off "
+			"for the given number of runs. The default is a binary search in the legacy code generator and "
+			"linear via IR. Via IR, binarySearch also applies to calls of internal function pointers."
+		)
+		(
+			g_strExperimentalOptimizations.c_str(),
+			po::value<string>()->value_name(util::joinHumanReadable(
+				allExperimentalOptimisations() | ranges::views::transform(experimentalOptimisationToString),
+				","
+			)),
+			(
+				"Comma-separated list of optimizations that change the generated code in ways that are still being "
+				"evaluated and are therefore not enabled by --" + g_strOptimize + ". They are recorded in the metadata."
+			).c_str()
+		)
+		(
+			g_strOptimizeInlineAssemblyStack.c_str(),
+			"Generate code for inline assembly blocks in the legacy code generator that are memory-safe and do not "
+			"access Solidity variables with the stack layout optimization of the IR pipeline."
+		)
+		(
+			g_strProfileOptimizer.c_str(),
+			"Print the duration, the code size change and the number of changes caused by each yul optimizer step "
+			"and each repetition round of bracketed parts of the sequence to stderr. Slows down the optimizer considerably."
+		)
 	;
 	desc.add(optimizerOptions);
 
@@ -830,6 +959,30 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of queries of the CHC engine that are solved concurrently by independent solver instances. "
+			"Only has an effect with z3. 0 uses as many as the hardware supports."
+		)
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory in which the results of CHC queries are cached across compiler runs. "
+			"Only has an effect with z3. The directory is created if it does not exist."
+		)
+		(
+			g_strModelCheckerSliceQueries.c_str(),
+			"Solve every query of the CHC engine on the part of the Horn system it depends on "
+			"and report the number of Horn clauses per query. Only has an effect with z3."
+		)
+		(
+			g_strModelCheckerSolverCommand.c_str(),
+			po::value<string>()->value_name("cmd"),
+			"Answer the SMT-LIB2 queries of the model checker with persistent instances of the given solver command, "
+			"which has to read SMT-LIB2 commands from its standard input, e.g. \"z3 -in\" or \"cvc4 --lang smt2 --incremental\". "
+			"Only has an effect with the solver smtlib2."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -873,6 +1026,7 @@ void CommandLineParser::processArgs()
 		g_strLicense,
 		g_strVersion,
 		g_strStandardJSON,
+		g_strServer,
 		g_strLink,
 		g_strAssemble,
 		g_strStrictAssembly,
@@ -889,6 +1043,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::Version;
 	else if (m_args.count(g_strStandardJSON) > 0)
 		m_options.input.mode = InputMode::StandardJson;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::StandardJsonServer;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
@@ -911,7 +1067,14 @@ void CommandLineParser::processArgs()
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
-		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
+		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Linker}},
+		{g_strABIDecoderMode, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::StandardJson, InputMode::StandardJsonServer}},
+		{g_strTimePasses, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strMemoryProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerSolverCommand, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::StandardJsonServer}},
+		{g_strProfileOptimizer, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Assembler}}
 	};
 	vector<string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -959,7 +1122,7 @@ void CommandLineParser::processArgs()
 				"Option --" + g_strOptimizeRuns + " is only valid in compiler and assembler modes."
 			);
 
-		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations})
+		for (string const& option: {g_strOptimize, g_strNoOptimizeYul, g_strOptimizeYul, g_strYulOptimizations, g_strYulOptimizerBudget, g_strDispatcher, g_strExperimentalOptimizations, g_strOptimizeInlineAssemblyStack})
 			if (m_args.count(option) > 0)
 				solThrow(
 					CommandLineValidationError,
@@ -979,6 +1142,8 @@ void CommandLineParser::processArgs()
 		m_options.formatting.coloredOutput = false;
 
 	m_options.formatting.withErrorIds = m_args.count(g_strErrorIds);
+	if (m_args.count(g_strMaxWarningsPerSource))
+		m_options.formatting.maxWarningsPerSource = m_args[g_strMaxWarningsPerSource].as<size_t>();
 
 	if (m_args.count(g_strRevertStrings))
 	{
@@ -997,6 +1162,18 @@ void CommandLineParser::processArgs()
 		m_options.output.revertStrings = *revertStrings;
 	}
 
+	if (m_args.count(g_strABIDecoderMode))
+	{
+		string abiDecoderModeString = m_args[g_strABIDecoderMode].as<string>();
+		std::optional<ABIDecoderMode> abiDecoderMode = abiDecoderModeFromString(abiDecoderModeString);
+		if (!abiDecoderMode)
+			solThrow(
+				CommandLineValidationError,
+				"Invalid option for --" + g_strABIDecoderMode + ": " + abiDecoderModeString
+			);
+		m_options.output.abiDecoderMode = *abiDecoderMode;
+	}
+
 	if (!m_args[g_strDebugInfo].defaulted())
 	{
 		string optionValue = m_args[g_strDebugInfo].as<string>();
@@ -1028,6 +1205,21 @@ void CommandLineParser::processArgs()
 	parseOutputSelection();
 
 	m_options.compiler.estimateGas = (m_args.count(g_strGas) > 0);
+	m_options.compiler.timePasses = (m_args.count(g_strTimePasses) > 0);
+	m_options.compiler.memoryProfile = (m_args.count(g_strMemoryProfile) > 0);
+
+	if (!m_args[g_strJobs].defaulted())
+	{
+		unsigned jobs = m_args[g_strJobs].as<unsigned>();
+		m_options.compiler.jobs = (jobs == 0 ? util::hardwareConcurrency() : jobs);
+	}
+
+	if (m_args.count(g_strCacheDir) > 0)
+	{
+		m_options.compiler.cacheDir = m_args[g_strCacheDir].as<string>();
+		if (m_options.compiler.cacheDir.empty())
+			solThrow(CommandLineValidationError, "--" + g_strCacheDir + " requires a non-empty path.");
+	}
 
 	if (m_args.count(g_strBasePath))
 		m_options.input.basePath = m_args[g_strBasePath].as<string>();
@@ -1056,15 +1248,22 @@ void CommandLineParser::processArgs()
 
 	if (m_args.count(g_strStopAfter))
 	{
-		if (m_args[g_strStopAfter].as<string>() != "parsing")
-			solThrow(CommandLineValidationError, "Valid options for --" + g_strStopAfter + " are: \"parsing\".\n");
-		else
-			m_options.output.stopAfter = CompilerStack::State::Parsed;
+		optional<CompilerStack::State> stopAfter;
+		vector<string> validStages;
+		for (auto const& [name, state]: CompilerStack::stopAfterStages())
+		{
+			if (name == m_args[g_strStopAfter].as<string>())
+				stopAfter = state;
+			validStages.push_back("\"" + name + "\"");
+		}
+		if (!stopAfter)
+			solThrow(CommandLineValidationError, "Valid options for --" + g_strStopAfter + " are: " + util::joinHumanReadable(validStages) + ".\n");
+		m_options.output.stopAfter = *stopAfter;
 	}
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::StandardJsonServer)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1109,6 +1308,50 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<string>();
 	}
 
+	if (m_args.count(g_strYulOptimizerBudget))
+	{
+		if (!m_options.optimiserSettings().runYulOptimiser)
+			solThrow(CommandLineValidationError, "--" + g_strYulOptimizerBudget + " is invalid if Yul optimizer is disabled");
+		m_options.optimizer.yulBudget = m_args[g_strYulOptimizerBudget].as<unsigned>();
+	}
+
+	if (m_args.count(g_strDispatcher))
+	{
+		string dispatcherString = m_args[g_strDispatcher].as<string>();
+		std::optional<FunctionDispatch> dispatcher = functionDispatchFromString(dispatcherString);
+		if (!dispatcher)
+			solThrow(
+				CommandLineValidationError,
+				"Invalid option for --" + g_strDispatcher + ": " + dispatcherString
+			);
+		m_options.optimizer.dispatcher = *dispatcher;
+	}
+
+	if (m_args.count(g_strExperimentalOptimizations))
+	{
+		vector<string> names;
+		boost::split(names, m_args[g_strExperimentalOptimizations].as<string>(), boost::is_any_of(","));
+		for (string const& name: names)
+		{
+			std::optional<ExperimentalOptimisation> optimisation = experimentalOptimisationFromString(name);
+			if (!optimisation)
+				solThrow(
+					CommandLineValidationError,
+					"Invalid option for --" + g_strExperimentalOptimizations + ": " + name
+				);
+			m_options.optimizer.experimental.insert(*optimisation);
+		}
+	}
+
+	if (m_args.count(g_strOptimizeInlineAssemblyStack))
+	{
+		if (!m_options.optimiserSettings().optimizeStackAllocation)
+			solThrow(CommandLineValidationError, "--" + g_strOptimizeInlineAssemblyStack + " requires --" + g_strOptimize + ".");
+		m_options.optimizer.inlineAssemblyStack = true;
+	}
+
+	m_options.optimizer.profile = (m_args.count(g_strProfileOptimizer) > 0);
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1231,6 +1474,9 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
+	if (m_args.count(g_strModelCheckerSliceQueries))
+		m_options.modelChecker.settings.sliceQueries = true;
+
 	if (m_args.count(g_strModelCheckerSolvers))
 	{
 		string solversStr = m_args[g_strModelCheckerSolvers].as<string>();
@@ -1252,16 +1498,41 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (!m_args[g_strModelCheckerJobs].defaulted())
+	{
+		unsigned jobs = m_args[g_strModelCheckerJobs].as<unsigned>();
+		m_options.modelChecker.settings.jobs = (jobs == 0 ? static_cast<unsigned>(util::hardwareConcurrency()) : jobs);
+	}
+
+	if (m_args.count(g_strModelCheckerCacheDir))
+	{
+		string cacheDir = m_args[g_strModelCheckerCacheDir].as<string>();
+		if (cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty path given to --" + g_strModelCheckerCacheDir + ".");
+		m_options.modelChecker.settings.cacheDirectory = cacheDir;
+	}
+
+	if (m_args.count(g_strModelCheckerSolverCommand))
+	{
+		string solverCommand = m_args[g_strModelCheckerSolverCommand].as<string>();
+		if (solverCommand.empty())
+			solThrow(CommandLineValidationError, "Empty command given to --" + g_strModelCheckerSolverCommand + ".");
+		m_options.modelChecker.solverCommand = solverCommand;
+	}
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerCacheDir) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerInvariants) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
+		m_args.count(g_strModelCheckerSliceQueries) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		!m_args[g_strModelCheckerJobs].defaulted();
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ABIDecoderMode.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/FileReader.h>
 #include <libsolidity/interface/ImportRemapper.h>
@@ -54,6 +55,7 @@ enum class InputMode
 	Compiler,
 	CompilerWithASTImport,
 	StandardJson,
+	StandardJsonServer,
 	Linker,
 	Assembler,
 	LanguageServer
@@ -184,6 +186,7 @@ struct CommandLineOptions
 		langutil::EVMVersion evmVersion;
 		bool viaIR = false;
 		RevertStrings revertStrings = RevertStrings::Default;
+		ABIDecoderMode abiDecoderMode = ABIDecoderMode::Default;
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 	} output;
@@ -204,12 +207,17 @@ struct CommandLineOptions
 		util::JsonFormat json;
 		std::optional<bool> coloredOutput;
 		bool withErrorIds = false;
+		std::optional<size_t> maxWarningsPerSource;
 	} formatting;
 
 	struct
 	{
 		CompilerOutputs outputs;
 		bool estimateGas = false;
+		size_t jobs = 1;
+		bool timePasses = false;
+		bool memoryProfile = false;
+		boost::filesystem::path cacheDir;
 		std::optional<CombinedJsonRequests> combinedJsonRequests;
 	} compiler;
 
@@ -225,12 +233,19 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		std::optional<unsigned> yulBudget;
+		FunctionDispatch dispatcher = FunctionDispatch::Default;
+		std::set<ExperimentalOptimisation> experimental;
+		bool inlineAssemblyStack = false;
+		bool profile = false;
 	} optimizer;
 
 	struct
 	{
 		bool initialize = false;
 		ModelCheckerSettings settings;
+		/// Command of an external solver that answers SMT-LIB2 queries, if any.
+		std::optional<std::string> solverCommand;
 	} modelChecker;
 };
 
@@ -0,0 +1,103 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <solc/SMTSolverProcessPool.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// Printed by the solver after the response to a query, via the `echo` command.
+string const responseEnd = "solc-response-end";
+
+}
+
+SMTSolverProcessPool::~SMTSolverProcessPool()
+{
+	for (auto const& process: m_idle)
+	{
+		process->input << "(exit)" << endl;
+		process->input.pipe().close();
+		process->child.wait();
+	}
+}
+
+ReadCallback::Result SMTSolverProcessPool::solve(string const& _query)
+{
+	unique_ptr<Process> process;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		if (!m_idle.empty())
+		{
+			process = move(m_idle.back());
+			m_idle.pop_back();
+		}
+	}
+
+	try
+	{
+		if (!process)
+			process = start();
+
+		process->input << _query << "\n(echo \"" << responseEnd << "\")" << endl;
+		string response;
+		string line;
+		// Solvers differ in whether they quote the echoed string.
+		while (getline(process->output, line) && line != responseEnd && line != "\"" + responseEnd + "\"")
+			response += line + "\n";
+		if (!process->output)
+			return ReadCallback::Result{false, "The SMT solver \"" + m_command + "\" terminated unexpectedly."};
+
+		// Clears all assertions and declarations for the next query.
+		process->input << "(reset)" << endl;
+
+		lock_guard<mutex> lock(m_mutex);
+		m_idle.emplace_back(move(process));
+		return ReadCallback::Result{true, response};
+	}
+	catch (exception const& _exception)
+	{
+		return ReadCallback::Result{false, "Exception running the SMT solver: " + boost::diagnostic_information(_exception)};
+	}
+}
+
+ReadCallback::Callback SMTSolverProcessPool::callback(ReadCallback::Callback _fallback)
+{
+	return [this, fallback = move(_fallback)](string const& _kind, string const& _data) {
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
+			return solve(_data);
+		return fallback(_kind, _data);
+	};
+}
+
+unique_ptr<SMTSolverProcessPool::Process> SMTSolverProcessPool::start() const
+{
+	auto process = make_unique<Process>();
+	process->child = boost::process::child(
+		m_command,
+		boost::process::std_in < process->input,
+		boost::process::std_out > process->output,
+		boost::process::std_err > boost::process::null
+	);
+	return process;
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Answers SMT queries of the model checker with external solver processes.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <boost/process.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Pool of solver processes that read SMT-LIB2 commands from their standard input,
+ * for example `z3 -in`. A process is kept alive after a query and reset for the next one,
+ * so that only the first query of every concurrent caller pays for starting the solver.
+ * The end of the response to a query is detected by asking the solver to echo a marker.
+ */
+class SMTSolverProcessPool
+{
+public:
+	explicit SMTSolverProcessPool(std::string _command): m_command(std::move(_command)) {}
+	~SMTSolverProcessPool();
+
+	SMTSolverProcessPool(SMTSolverProcessPool const&) = delete;
+	SMTSolverProcessPool& operator=(SMTSolverProcessPool const&) = delete;
+
+	/// Sends the SMT-LIB2 script @a _query to an idle process, starting one if there is none.
+	/// @returns the output of the solver or an error message if it could not be run.
+	ReadCallback::Result solve(std::string const& _query);
+
+	/// @returns a callback that answers SMT queries with this pool and forwards everything else
+	/// to @a _fallback.
+	ReadCallback::Callback callback(ReadCallback::Callback _fallback);
+
+private:
+	struct Process
+	{
+		boost::process::opstream input;
+		boost::process::ipstream output;
+		boost::process::child child;
+	};
+
+	std::unique_ptr<Process> start() const;
+
+	std::string m_command;
+	std::mutex m_mutex;
+	/// Processes that are not answering a query at the moment.
+	std::vector<std::unique_ptr<Process>> m_idle;
+};
+
+}
@@ -69,6 +69,8 @@ struct CommonOptions
 	bool useABIEncoderV1 = false;
 	bool showMessages = false;
 	bool showMetadata = false;
+	/// File to write the gas used in the executed transactions to, per source line. Empty if not profiling.
+	boost::filesystem::path gasProfile;
 	size_t batches = 1;
 	size_t selectedBatch = 0;
 
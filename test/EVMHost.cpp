@@ -22,6 +22,8 @@
 
 #include <test/EVMHost.h>
 
+#include <test/GasProfiler.h>
+
 #include <test/evmc/loader.h>
 
 #include <libevmasm/GasMeter.h>
@@ -147,13 +149,16 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 void EVMHost::reset()
 {
 	accounts.clear();
+	m_snapshots.clear();
 	m_currentAddress = {};
 	// Clear self destruct records
 	recorded_selfdestructs.clear();
 	// Clear call records
 	recorded_calls.clear();
-	// Clear EIP-2929 account access indicator
+	// Clear EIP-2929 account and storage access indicators
 	recorded_account_accesses.clear();
+	m_warmStorageSlots.clear();
+	m_warmStorageSlotSet.clear();
 
 	// Mark all precompiled contracts as existing. Existing here means to have a balance (as per EIP-161).
 	// NOTE: keep this in sync with `EVMHost::call` below.
@@ -172,14 +177,76 @@ void EVMHost::reset()
 	}
 }
 
+size_t EVMHost::snapshot()
+{
+	m_snapshots.push_back({{}, tx_context, m_warmStorageSlots.size()});
+	return m_snapshots.size() - 1;
+}
+
+void EVMHost::revertToSnapshot(size_t _id)
+{
+	assertThrow(_id < m_snapshots.size(), Exception, "Snapshot does not exist.");
+	while (m_snapshots.size() > _id)
+	{
+		for (auto& [address, account]: m_snapshots.back().accounts)
+			if (account)
+				accounts[address] = move(*account);
+			else
+				accounts.erase(address);
+		tx_context = m_snapshots.back().txContext;
+		// Storage slots first accessed in the reverted part are cold again.
+		while (m_warmStorageSlots.size() > m_snapshots.back().warmStorageSlots)
+		{
+			m_warmStorageSlotSet.erase(m_warmStorageSlots.back());
+			m_warmStorageSlots.pop_back();
+		}
+		m_snapshots.pop_back();
+	}
+}
+
+void EVMHost::commitSnapshot(size_t _id)
+{
+	assertThrow(_id < m_snapshots.size(), Exception, "Snapshot does not exist.");
+	while (m_snapshots.size() > _id)
+	{
+		if (m_snapshots.size() > 1)
+		{
+			// The older snapshot keeps its own copy if it has one already.
+			auto& previous = m_snapshots[m_snapshots.size() - 2].accounts;
+			for (auto& [address, account]: m_snapshots.back().accounts)
+				previous.emplace(address, move(account));
+		}
+		m_snapshots.pop_back();
+	}
+}
+
+void EVMHost::recordAccount(evmc::address const& _addr)
+{
+	if (m_snapshots.empty())
+		return;
+	auto& saved = m_snapshots.back().accounts;
+	if (saved.count(_addr))
+		return;
+	auto it = accounts.find(_addr);
+	saved.emplace(_addr, it == accounts.end() ? nullopt : optional<evmc::MockedAccount>{it->second});
+}
+
 void EVMHost::resetWarmAccess()
 {
 	// Clear EIP-2929 account access indicator
 	recorded_account_accesses.clear();
 	// Clear EIP-2929 storage access indicator
-	for (auto& [address, account]: accounts)
-		for (auto& [slot, value]: account.storage)
-			value.access_status = EVMC_ACCESS_COLD;
+	m_warmStorageSlots.clear();
+	m_warmStorageSlotSet.clear();
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
+{
+	StorageSlot slot{_addr, _key};
+	if (!m_warmStorageSlotSet.insert(slot).second)
+		return EVMC_ACCESS_WARM;
+	m_warmStorageSlots.push_back(slot);
+	return EVMC_ACCESS_COLD;
 }
 
 void EVMHost::transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept
@@ -193,12 +260,24 @@ void EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _ben
 {
 	// TODO actual selfdestruct is even more complicated.
 
-	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
+	transfer(mutableAccount(_addr), mutableAccount(_beneficiary), convertFromEVMC(accounts[_addr].balance));
 	accounts.erase(_addr);
 	// Record self destructs
 	recorded_selfdestructs.push_back({_addr, _beneficiary});
 }
 
+void EVMHost::setGasProfiler(GasProfiler* _profiler)
+{
+	// The VMs are shared by all hosts and every request for a trace adds another one.
+	static set<evmc_vm*> tracedVMs;
+	if (_profiler && !tracedVMs.count(m_vm.get_raw_pointer()))
+	{
+		assertThrow(GasProfiler::enableTracing(m_vm), Exception, "The VM does not support instruction tracing.");
+		tracedVMs.insert(m_vm.get_raw_pointer());
+	}
+	m_gasProfiler = _profiler;
+}
+
 void EVMHost::recordCalls(evmc_message const& _message) noexcept
 {
 	if (recorded_calls.size() < max_recorded_calls)
@@ -225,10 +304,10 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	else if (_message.destination == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
 		return precompileALTBN128PairingProduct(_message);
 
-	auto const stateBackup = accounts;
+	size_t const snapshotId = snapshot();
 
 	u256 value{convertFromEVMC(_message.value)};
-	auto& sender = accounts[_message.sender];
+	auto& sender = mutableAccount(_message.sender);
 
 	evmc::bytes code;
 
@@ -242,7 +321,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertToSnapshot(snapshotId);
 			return result;
 		}
 	}
@@ -274,7 +353,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertToSnapshot(snapshotId);
 			return result;
 		}
 
@@ -282,13 +361,13 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	else if (message.kind == EVMC_DELEGATECALL || message.kind == EVMC_CALLCODE)
 	{
-		code = accounts[message.destination].code;
+		code = mutableAccount(message.destination).code;
 		message.destination = m_currentAddress;
 	}
 	else
-		code = accounts[message.destination].code;
+		code = mutableAccount(message.destination).code;
 
-	auto& destination = accounts[message.destination];
+	auto& destination = mutableAccount(message.destination);
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
 	{
@@ -296,7 +375,7 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::result result({});
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertToSnapshot(snapshotId);
 			return result;
 		}
 		transfer(sender, destination, value);
@@ -312,7 +391,21 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 	evmc::address currentAddress = m_currentAddress;
 	m_currentAddress = message.destination;
+	optional<GasProfiler::TraceScope> traceScope;
+	if (m_gasProfiler)
+	{
+		if (message.depth == 0)
+			traceScope.emplace(*m_gasProfiler);
+		m_gasProfiler->enterFrame(bytesConstRef(code.data(), code.size()));
+	}
 	evmc::result result = m_vm.execute(*this, m_evmRevision, message, code.data(), code.size());
+	if (m_gasProfiler)
+		m_gasProfiler->leaveFrame(
+			result.gas_left,
+			(message.kind == EVMC_CREATE || message.kind == EVMC_CREATE2) && result.status_code == EVMC_SUCCESS ?
+				bytesConstRef(result.output_data, result.output_size) :
+				bytesConstRef{}
+		);
 	m_currentAddress = currentAddress;
 
 	if (message.kind == EVMC_CREATE || message.kind == EVMC_CREATE2)
@@ -333,7 +426,9 @@ evmc::result EVMHost::call(evmc_message const& _message) noexcept
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertToSnapshot(snapshotId);
+	else
+		commitSnapshot(snapshotId);
 
 	return result;
 }
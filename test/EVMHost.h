@@ -32,10 +32,16 @@
 
 #include <boost/filesystem.hpp>
 
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace solidity::test
 {
 using Address = util::h160;
 
+class GasProfiler;
+
 class EVMHost: public evmc::MockedHost
 {
 public:
@@ -58,6 +64,10 @@ public:
 	void reset();
 	/// Clears EIP-2929 account and storage access indicator
 	void resetWarmAccess();
+	/// Reports every call frame and the instruction trace to @a _profiler, if not null.
+	/// Enables the instruction trace of the VM.
+	void setGasProfiler(GasProfiler* _profiler);
+
 	void newBlock()
 	{
 		tx_context.block_number++;
@@ -66,6 +76,14 @@ public:
 		resetWarmAccess();
 	}
 
+	/// Starts recording the accounts modified from now on, so that their current state can be
+	/// restored by revertToSnapshot. Only the accounts that are actually modified are copied.
+	/// @returns the identifier of the snapshot.
+	size_t snapshot();
+	/// Restores the accounts and the transaction context to the state they had when the snapshot
+	/// @a _id was taken. Discards the snapshot and all snapshots taken after it.
+	void revertToSnapshot(size_t _id);
+
 	/// @returns contents of storage at @param _addr.
 	std::map<evmc::bytes32, evmc::storage_value> const& get_address_storage(evmc::address const& _addr);
 
@@ -76,6 +94,20 @@ public:
 
 	void selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final
+	{
+		recordAccount(_addr);
+		return evmc::MockedHost::set_storage(_addr, _key, _value);
+	}
+
+	/// Tracks EIP-2929 storage access in a set of warm slots that is cleared by resetWarmAccess,
+	/// instead of in the access status of every storage value of every account.
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
+
 	evmc::result call(evmc_message const& _message) noexcept final;
 
 	evmc::bytes32 get_block_hash(int64_t number) const noexcept final;
@@ -92,7 +124,45 @@ public:
 	}
 
 private:
+	struct Snapshot
+	{
+		/// State of the accounts modified since the snapshot was taken, before their first
+		/// modification. Accounts that did not exist are mapped to nullopt.
+		std::unordered_map<evmc::address, std::optional<evmc::MockedAccount>> accounts;
+		evmc_tx_context txContext;
+		/// Number of warm storage slots when the snapshot was taken.
+		size_t warmStorageSlots;
+	};
+
+	using StorageSlot = std::pair<evmc::address, evmc::bytes32>;
+	struct StorageSlotHash
+	{
+		size_t operator()(StorageSlot const& _slot) const noexcept
+		{
+			return std::hash<evmc::address>{}(_slot.first) ^ std::hash<evmc::bytes32>{}(_slot.second);
+		}
+	};
+
+	/// Saves the state of the account at @a _addr in the latest snapshot,
+	/// unless it is already saved there. Has to be called before the account is modified.
+	void recordAccount(evmc::address const& _addr);
+	/// @returns the account at @a _addr, creating it if needed, after recording it for the latest snapshot.
+	evmc::MockedAccount& mutableAccount(evmc::address const& _addr)
+	{
+		recordAccount(_addr);
+		return accounts[_addr];
+	}
+	/// Keeps the changes made since the snapshot @a _id was taken and discards the snapshot
+	/// and all snapshots taken after it.
+	void commitSnapshot(size_t _id);
+
 	evmc::address m_currentAddress = {};
+	/// Snapshots taken by snapshot(), the latest one last. Every call that is not a
+	/// precompile also takes one to be able to revert on failure.
+	std::vector<Snapshot> m_snapshots;
+	/// Storage slots accessed since the last call to resetWarmAccess, in the order of their first access.
+	std::vector<StorageSlot> m_warmStorageSlots;
+	std::unordered_set<StorageSlot, StorageSlotHash> m_warmStorageSlotSet;
 
 	void transfer(evmc::MockedAccount& _sender, evmc::MockedAccount& _recipient, u256 const& _value) noexcept;
 
@@ -113,6 +183,7 @@ private:
 	static evmc::result resultWithGas(evmc_message const& _message, bytes const& _data) noexcept;
 
 	evmc::VM& m_vm;
+	GasProfiler* m_gasProfiler = nullptr;
 	// EVM version requested by the testing tool
 	langutil::EVMVersion m_evmVersion;
 	// EVM version requested from EVMC (matches the above)
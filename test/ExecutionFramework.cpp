@@ -24,6 +24,7 @@
 #include <test/ExecutionFramework.h>
 
 #include <test/EVMHost.h>
+#include <test/GasProfiler.h>
 
 #include <test/evmc/evmc.hpp>
 
@@ -78,6 +79,8 @@ void ExecutionFramework::selectVM(evmc_capabilities _cap)
 		if (vm.has_capability(_cap))
 		{
 			m_evmcHost = make_unique<EVMHost>(m_evmVersion, vm);
+			if (!solidity::test::CommonOptions::get().gasProfile.empty())
+				m_evmcHost->setGasProfiler(&gasProfiler());
 			break;
 		}
 	}
@@ -184,7 +187,9 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 	}
 	message.gas = InitialGas.convert_to<int64_t>();
 
+	auto const executionStart = chrono::steady_clock::now();
 	evmc::result result = m_evmcHost->call(message);
+	timeSpent().execution += chrono::steady_clock::now() - executionStart;
 
 	m_output = bytes(result.output_data, result.output_data + result.output_size);
 	if (_isCreation)
@@ -201,6 +206,18 @@ void ExecutionFramework::sendMessage(bytes const& _data, bool _isCreation, u256
 	}
 }
 
+ExecutionFramework::TimeSpent& ExecutionFramework::timeSpent()
+{
+	static TimeSpent timeSpent;
+	return timeSpent;
+}
+
+GasProfiler& ExecutionFramework::gasProfiler()
+{
+	static GasProfiler gasProfiler;
+	return gasProfiler;
+}
+
 void ExecutionFramework::sendEther(h160 const& _addr, u256 const& _amount)
 {
 	m_evmcHost->newBlock();
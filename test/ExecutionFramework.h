@@ -35,6 +35,7 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/ErrorCodes.h>
 
+#include <chrono>
 #include <functional>
 
 #include <boost/rational.hpp>
@@ -47,6 +48,8 @@ struct LogRecord;
 
 namespace solidity::test
 {
+class GasProfiler;
+
 using rational = boost::rational<bigint>;
 
 // The ether and gwei denominations; here for ease of use where needed within code.
@@ -165,6 +168,18 @@ public:
 
 	static std::pair<bool, std::string> compareAndCreateMessage(bytes const& _result, bytes const& _expectation);
 
+	/// Time spent by all test cases of the process in compiling contracts and in executing transactions.
+	struct TimeSpent
+	{
+		std::chrono::steady_clock::duration compilation{};
+		std::chrono::steady_clock::duration execution{};
+		/// Number of compilations answered from the bytecode cache.
+		size_t reusedCompilations = 0;
+	};
+	static TimeSpent& timeSpent();
+	/// Gas profile of all transactions of the process if profiling is enabled via CommonOptions::gasProfile.
+	static GasProfiler& gasProfiler();
+
 	static bytes encode(bool _value) { return encode(uint8_t(_value)); }
 	static bytes encode(int _value) { return encode(u256(_value)); }
 	static bytes encode(size_t _value) { return encode(u256(_value)); }
@@ -0,0 +1,257 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/GasProfiler.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include <iostream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::test;
+
+namespace
+{
+
+/// @returns the value of @a _value, which is either a number or a hex string.
+optional<int64_t> gasValue(Json::Value const& _value)
+{
+	if (_value.isIntegral())
+		return _value.asInt64();
+	if (_value.isString())
+		return static_cast<int64_t>(u256(_value.asString()));
+	return nullopt;
+}
+
+/// Stream buffer that reports the instructions of the EIP-3155 trace written to it to the profiler.
+class TraceForwarder: public std::streambuf
+{
+public:
+	explicit TraceForwarder(GasProfiler& _profiler): m_profiler(_profiler) {}
+
+protected:
+	int overflow(int _character) override
+	{
+		if (_character == traits_type::eof())
+			return traits_type::not_eof(_character);
+		if (_character == '\n')
+		{
+			forwardLine();
+			m_line.clear();
+		}
+		else
+			m_line.push_back(static_cast<char>(_character));
+		return _character;
+	}
+
+private:
+	void forwardLine()
+	{
+		Json::Value step;
+		// Lines without a position are the start and end of an execution or output of others.
+		if (!jsonParseStrict(m_line, step) || !step.isObject() || !step.isMember("pc"))
+			return;
+		if (optional<int64_t> gas = gasValue(step["gas"]))
+			m_profiler.instruction(static_cast<size_t>(step["pc"].asUInt64()), *gas);
+	}
+
+	GasProfiler& m_profiler;
+	string m_line;
+};
+
+}
+
+GasProfiler::TraceScope::TraceScope(GasProfiler& _profiler):
+	m_buffer(make_unique<TraceForwarder>(_profiler)),
+	m_previousBuffer(clog.rdbuf(m_buffer.get()))
+{
+}
+
+GasProfiler::TraceScope::~TraceScope()
+{
+	clog.rdbuf(m_previousBuffer);
+}
+
+bool GasProfiler::enableTracing(evmc::VM& _vm)
+{
+	return
+		_vm.set_option("O", "0") == EVMC_SET_OPTION_SUCCESS &&
+		_vm.set_option("trace", "") == EVMC_SET_OPTION_SUCCESS;
+}
+
+void GasProfiler::addContract(
+	string const& _name,
+	evmasm::LinkerObject const& _creationObject,
+	string const* _creationSourceMapping,
+	evmasm::LinkerObject const& _runtimeObject,
+	string const* _runtimeSourceMapping,
+	shared_ptr<Sources const> _sources
+)
+{
+	shared_ptr<CodeInfo> runtimeCode = codeInfo(_name, _runtimeObject, _runtimeSourceMapping, _sources);
+	shared_ptr<CodeInfo> creationCode = codeInfo(_name + " (creation)", _creationObject, _creationSourceMapping, _sources);
+	creationCode->runtimeCode = runtimeCode;
+	m_codes[keccak256(_creationObject.bytecode)] = creationCode;
+	m_codes[keccak256(_runtimeObject.bytecode)] = runtimeCode;
+}
+
+void GasProfiler::enterFrame(bytesConstRef _code)
+{
+	Frame& frame = m_frames.emplace_back();
+	if (auto const* code = util::valueOrNullptr(m_codes, keccak256(_code)))
+		frame.code = *code;
+}
+
+void GasProfiler::instruction(size_t _pc, int64_t _gasLeft)
+{
+	if (m_frames.empty())
+		return;
+
+	Frame& frame = m_frames.back();
+	if (frame.lastPc)
+	{
+		attributeLastInstruction(frame, _gasLeft);
+		// Follow the jumps into and out of functions.
+		if (frame.code)
+			if (SourceMapEntry const* entry = sourceMapEntry(*frame.code, *frame.lastPc))
+			{
+				if (entry->jumpType == 'i')
+				{
+					string const* function = util::valueOrNullptr(frame.code->functions, _pc);
+					frame.functions.emplace_back(function ? *function : location(*frame.code, _pc));
+				}
+				else if (entry->jumpType == 'o' && !frame.functions.empty())
+					frame.functions.pop_back();
+			}
+	}
+	else
+		frame.initialGas = _gasLeft;
+	frame.lastPc = _pc;
+	frame.lastGas = _gasLeft;
+}
+
+void GasProfiler::leaveFrame(int64_t _gasLeft, bytesConstRef _createdCode)
+{
+	if (m_frames.empty())
+		return;
+	Frame frame = move(m_frames.back());
+	m_frames.pop_back();
+
+	if (frame.lastPc)
+		attributeLastInstruction(frame, _gasLeft);
+	if (frame.initialGas && !m_frames.empty())
+		m_frames.back().childGas += *frame.initialGas - _gasLeft;
+	if (!_createdCode.empty() && frame.code && frame.code->runtimeCode)
+		m_codes[keccak256(_createdCode)] = frame.code->runtimeCode;
+}
+
+void GasProfiler::writeFoldedStacks(ostream& _out) const
+{
+	for (auto const& [stack, gas]: m_gasPerStack)
+		_out << stack << " " << gas << endl;
+}
+
+shared_ptr<GasProfiler::CodeInfo> GasProfiler::codeInfo(
+	string _name,
+	evmasm::LinkerObject const& _object,
+	string const* _sourceMapping,
+	shared_ptr<Sources const> _sources
+)
+{
+	auto code = make_shared<CodeInfo>();
+	code->name = move(_name);
+	code->sources = move(_sources);
+
+	// Data after the code is decoded as well, but never executed.
+	for (size_t pc = 0, index = 0; pc < _object.bytecode.size(); ++index)
+	{
+		code->instructionIndices[pc] = index;
+		auto opcode = static_cast<evmasm::Instruction>(_object.bytecode[pc]);
+		pc += 1 + (evmasm::isPushInstruction(opcode) ? evmasm::getPushNumber(opcode) : 0);
+	}
+
+	for (auto const& [name, function]: _object.functionDebugData)
+		if (function.bytecodeOffset)
+			code->functions[*function.bytecodeOffset] = name;
+
+	if (_sourceMapping)
+	{
+		// Empty fields repeat the value of the previous entry.
+		SourceMapEntry current;
+		vector<string> entries;
+		boost::split(entries, *_sourceMapping, boost::is_any_of(";"));
+		for (string const& entry: entries)
+		{
+			vector<string> fields;
+			boost::split(fields, entry, boost::is_any_of(":"));
+			if (fields.size() > 0 && !fields[0].empty())
+				current.start = stoi(fields[0]);
+			if (fields.size() > 2 && !fields[2].empty())
+				current.sourceIndex = stoi(fields[2]);
+			if (fields.size() > 3 && !fields[3].empty())
+				current.jumpType = fields[3].front();
+			code->sourceMap.push_back(current);
+		}
+	}
+	return code;
+}
+
+string GasProfiler::location(CodeInfo const& _code, size_t _pc)
+{
+	SourceMapEntry const* entry = sourceMapEntry(_code, _pc);
+	if (!entry || entry->start < 0)
+		return "(unknown source)";
+	auto const* source = _code.sources ? util::valueOrNullptr(*_code.sources, entry->sourceIndex) : nullptr;
+	if (!source)
+		return "(generated)";
+	return source->name() + ":" + to_string(source->translatePositionToLineColumn(entry->start).line + 1);
+}
+
+GasProfiler::SourceMapEntry const* GasProfiler::sourceMapEntry(CodeInfo const& _code, size_t _pc)
+{
+	size_t const* index = util::valueOrNullptr(_code.instructionIndices, _pc);
+	if (!index || *index >= _code.sourceMap.size())
+		return nullptr;
+	return &_code.sourceMap[*index];
+}
+
+void GasProfiler::attributeLastInstruction(Frame& _frame, int64_t _gasAfter)
+{
+	int64_t gasUsed = _frame.lastGas - _gasAfter - _frame.childGas;
+	_frame.childGas = 0;
+	if (gasUsed <= 0)
+		return;
+
+	string stack = _frame.code ? _frame.code->name : "(unknown code)";
+	for (string const& function: _frame.functions)
+		stack += ";" + function;
+	if (_frame.code)
+		stack += ";" + location(*_frame.code, *_frame.lastPc);
+	m_gasPerStack[stack] += gasUsed;
+}
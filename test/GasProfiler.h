@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Attributes the gas used by executed instructions to the source lines and functions
+ * they were generated from.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/FixedHash.h>
+
+#include <test/evmc/evmc.hpp>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace solidity::test
+{
+
+/**
+ * Gas profiler for the test framework.
+ *
+ * The profiler is driven by callbacks: the host reports the start and end of every call frame
+ * and each executed instruction is reported via instruction() with the gas left before it, so
+ * that the gas used by an instruction is the difference to the next report in the same frame.
+ *
+ * evmone only makes its tracer available through EVMC as the ``trace`` option of the VM, which
+ * writes an EIP-3155 trace to ``std::clog``. TraceScope translates that trace into calls to
+ * instruction(), so the rest of the profiler does not depend on the format.
+ *
+ * The gas of an instruction is attributed to the source line in the source mapping of that code
+ * and to the stack of functions entered via jumps into functions. The result is written in the
+ * folded stack format understood by flamegraph tools.
+ *
+ * Only code registered via addContract() is mapped to sources. Code created by registered
+ * creation code is registered as the runtime code of the same contract.
+ */
+class GasProfiler
+{
+public:
+	/// Redirects ``std::clog`` while alive and reports the instructions of the EIP-3155 trace
+	/// written to it to the profiler.
+	class TraceScope
+	{
+	public:
+		explicit TraceScope(GasProfiler& _profiler);
+		~TraceScope();
+		TraceScope(TraceScope const&) = delete;
+		TraceScope& operator=(TraceScope const&) = delete;
+	private:
+		std::unique_ptr<std::streambuf> m_buffer;
+		std::streambuf* m_previousBuffer = nullptr;
+	};
+
+	/// Enables the instruction trace of @a _vm. Tracing is only supported by the baseline
+	/// interpreter of evmone, which is selected as well.
+	/// @returns false if the VM does not support tracing.
+	static bool enableTracing(evmc::VM& _vm);
+
+	/// Sources of a compilation by their index in the source mappings.
+	using Sources = std::map<int, langutil::CharStream>;
+
+	/// Registers the creation and runtime code of the contract @a _name.
+	/// The source mappings can be null and refer to @a _sources.
+	void addContract(
+		std::string const& _name,
+		evmasm::LinkerObject const& _creationObject,
+		std::string const* _creationSourceMapping,
+		evmasm::LinkerObject const& _runtimeObject,
+		std::string const* _runtimeSourceMapping,
+		std::shared_ptr<Sources const> _sources
+	);
+
+	/// Called by the host before @a _code starts executing in a new call frame.
+	void enterFrame(bytesConstRef _code);
+	/// Called before the instruction at @a _pc of the innermost frame executes with @a _gasLeft gas left.
+	void instruction(size_t _pc, int64_t _gasLeft);
+	/// Called by the host after the innermost frame finished with @a _gasLeft gas left.
+	/// @a _createdCode is the deployed code if the frame successfully executed creation code.
+	void leaveFrame(int64_t _gasLeft, bytesConstRef _createdCode);
+
+	/// Writes the gas used per stack of frames, one stack per line as ``frame;frame;frame gas``.
+	void writeFoldedStacks(std::ostream& _out) const;
+
+private:
+	struct SourceMapEntry
+	{
+		int sourceIndex = -1;
+		int start = -1;
+		char jumpType = '-';
+	};
+	struct CodeInfo
+	{
+		/// Name of the frame at the bottom of all stacks in this code.
+		std::string name;
+		/// Source mapping entries, one per instruction.
+		std::vector<SourceMapEntry> sourceMap;
+		/// Index of the instruction starting at each offset in the code.
+		std::map<size_t, size_t> instructionIndices;
+		/// Function names by the offset of their entry point.
+		std::map<size_t, std::string> functions;
+		/// Sources by their index in the source mapping.
+		std::shared_ptr<Sources const> sources;
+		/// The code that creation code returns, if known.
+		std::shared_ptr<CodeInfo const> runtimeCode;
+	};
+	struct Frame
+	{
+		std::shared_ptr<CodeInfo const> code;
+		/// Names of the functions entered via jumps into functions.
+		std::vector<std::string> functions;
+		/// Position and gas before the last traced instruction of the frame.
+		std::optional<size_t> lastPc;
+		int64_t lastGas = 0;
+		/// Gas before the first traced instruction of the frame.
+		std::optional<int64_t> initialGas;
+		/// Gas used by the frames called from the last traced instruction.
+		int64_t childGas = 0;
+	};
+
+	static std::shared_ptr<CodeInfo> codeInfo(
+		std::string _name,
+		evmasm::LinkerObject const& _object,
+		std::string const* _sourceMapping,
+		std::shared_ptr<Sources const> _sources
+	);
+	/// @returns the name of the source line the instruction at @a _pc of @a _code belongs to.
+	static std::string location(CodeInfo const& _code, size_t _pc);
+	/// @returns the source map entry of the instruction at @a _pc of @a _code, if any.
+	static SourceMapEntry const* sourceMapEntry(CodeInfo const& _code, size_t _pc);
+	/// Attributes the gas used by the last traced instruction of @a _frame, which left @a _gasAfter gas.
+	void attributeLastInstruction(Frame& _frame, int64_t _gasAfter);
+
+	std::map<util::h256, std::shared_ptr<CodeInfo const>> m_codes;
+	std::vector<Frame> m_frames;
+	std::map<std::string, u256> m_gasPerStack;
+};
+
+}
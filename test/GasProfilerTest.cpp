@@ -0,0 +1,158 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <test/GasProfiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity::evmasm;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::test
+{
+
+namespace
+{
+
+/// Runtime code that jumps into ``f`` at offset 4, which does an SLOAD and jumps back to the STOP.
+LinkerObject runtimeObject()
+{
+	LinkerObject object;
+	object.bytecode = fromHex(
+		"6004" // PUSH1 4
+		"56" // JUMP
+		"00" // STOP
+		"5b" // JUMPDEST
+		"6000" // PUSH1 0
+		"54" // SLOAD
+		"50" // POP
+		"6003" // PUSH1 3
+		"56" // JUMP
+	);
+	object.functionDebugData["f"].bytecodeOffset = 4;
+	return object;
+}
+
+/// Source mapping of runtimeObject(): the SLOAD is on line 2 and the rest of ``f`` on line 3.
+string const runtimeSourceMapping = "0:1:0:-;:::i;;4:1:0;;2:1:0;4;;:::o";
+
+shared_ptr<GasProfiler::Sources const> sources()
+{
+	auto sources = make_shared<GasProfiler::Sources>();
+	sources->emplace(0, CharStream("a\nb\nc\n", "s.sol"));
+	return sources;
+}
+
+GasProfiler profilerWithContract()
+{
+	GasProfiler profiler;
+	LinkerObject creationObject;
+	creationObject.bytecode = fromHex("00");
+	profiler.addContract("C", creationObject, nullptr, runtimeObject(), &runtimeSourceMapping, sources());
+	return profiler;
+}
+
+string foldedStacks(GasProfiler const& _profiler)
+{
+	ostringstream output;
+	_profiler.writeFoldedStacks(output);
+	return output.str();
+}
+
+/// Gas used by the execution of runtimeObject(): the jump into ``f`` is attributed to the caller,
+/// the SLOAD and the rest of ``f`` to their lines in ``f``.
+string const expectedStacks =
+	"C;f;s.sol:2 2100\n"
+	"C;f;s.sol:3 17\n"
+	"C;s.sol:1 11\n";
+
+}
+
+BOOST_AUTO_TEST_SUITE(GasProfilerTest)
+
+BOOST_AUTO_TEST_CASE(known_gas_breakdown)
+{
+	GasProfiler profiler = profilerWithContract();
+	bytes const code = runtimeObject().bytecode;
+
+	profiler.enterFrame(bytesConstRef(&code));
+	profiler.instruction(0, 10000);
+	profiler.instruction(2, 9997);
+	profiler.instruction(4, 9989);
+	profiler.instruction(5, 9988);
+	profiler.instruction(7, 9985);
+	profiler.instruction(8, 7885);
+	profiler.instruction(9, 7883);
+	profiler.instruction(11, 7880);
+	profiler.instruction(3, 7872);
+	profiler.leaveFrame(7872, {});
+
+	BOOST_CHECK_EQUAL(foldedStacks(profiler), expectedStacks);
+}
+
+BOOST_AUTO_TEST_CASE(called_frames_are_not_attributed_to_caller)
+{
+	GasProfiler profiler = profilerWithContract();
+	bytes const code = runtimeObject().bytecode;
+	bytes const unknownCode = fromHex("600000");
+
+	profiler.enterFrame(bytesConstRef(&code));
+	profiler.instruction(0, 10000);
+	profiler.enterFrame(bytesConstRef(&unknownCode));
+	profiler.instruction(0, 9000);
+	profiler.instruction(2, 8997);
+	profiler.leaveFrame(8997, {});
+	profiler.instruction(2, 8997);
+	profiler.leaveFrame(8989, {});
+
+	BOOST_CHECK_EQUAL(
+		foldedStacks(profiler),
+		"(unknown code) 3\n"
+		"C;s.sol:1 1008\n"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(trace_scope_forwards_trace)
+{
+	GasProfiler profiler = profilerWithContract();
+	bytes const code = runtimeObject().bytecode;
+
+	profiler.enterFrame(bytesConstRef(&code));
+	{
+		GasProfiler::TraceScope scope(profiler);
+		clog << R"({"depth":1,"rev":"Istanbul","static":false})" << endl;
+		for (auto [pc, gas]: vector<pair<size_t, int64_t>>{
+			{0, 10000}, {2, 9997}, {4, 9989}, {5, 9988}, {7, 9985},
+			{8, 7885}, {9, 7883}, {11, 7880}, {3, 7872}
+		})
+			clog << R"({"pc":)" << pc << R"(,"op":0,"gas":"0x)" << hex << gas << dec << R"("})" << endl;
+		clog << R"({"error":null,"gas":"0x1ec0","gasUsed":"0x850","output":""})" << endl;
+	}
+	profiler.leaveFrame(7872, {});
+
+	BOOST_CHECK_EQUAL(foldedStacks(profiler), expectedStacks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
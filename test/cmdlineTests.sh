@@ -561,6 +561,15 @@ SOLTMPDIR=$(mktemp -d)
     msg_on_error "$SOLC" --link --libraries x.sol:L=0x90f20564390eAe531E810af625A22f51385Cd222 C.bin
     # Now the placeholder and explanation should be gone.
     grep -q -v '[/_]' C.bin
+
+    # Several files are linked in one invocation, also on multiple threads.
+    msg_on_error --no-stderr "$SOLC" --bin -o multi x.sol
+    cp multi/C.bin D.bin
+    cp multi/C.bin E.bin
+    msg_on_error "$SOLC" --link --jobs 2 --libraries x.sol:L=0x90f20564390eAe531E810af625A22f51385Cd222 D.bin E.bin
+    grep -q -v '[/_]' D.bin
+    diff -q D.bin C.bin
+    diff -q E.bin C.bin
 )
 rm -r "$SOLTMPDIR"
 
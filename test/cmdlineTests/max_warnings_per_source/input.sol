@@ -0,0 +1,8 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract C {
+    function f(uint a, uint b) public pure {
+        uint x;
+    }
+}
@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract test {
+    function f(uint x) public pure {
+		assert(x > 0);
+    }
+    function g(uint y) public pure {
+		require(y < 10);
+		assert(y < 20);
+    }
+}
@@ -60,15 +60,15 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "verbatim.asm", 2 }
 	};
 	Assembly _assembly{false, {}};
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm{false, {}};
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 
 	Assembly _verbatimAsm(true, "");
-	auto verbatim_asm = make_shared<string>("verbatim.asm");
+	auto verbatim_asm = internSourceName("verbatim.asm");
 	_verbatimAsm.setSourceLocation({8, 18, verbatim_asm});
 
 	// PushImmutable
@@ -235,8 +235,8 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				NumSubs +                  // PUSH <addr> for every sub assembly
 				1;                         // INVALID
 
-			auto assemblyName = make_shared<string>("root.asm");
-			auto subName = make_shared<string>("sub.asm");
+			auto assemblyName = internSourceName("root.asm");
+			auto subName = internSourceName("sub.asm");
 
 			map<string, unsigned> indices = {
 				{ *assemblyName, 0 },
@@ -303,11 +303,11 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	Assembly _assembly{true, {}};
-	auto root_asm = make_shared<string>("root.asm");
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
 	Assembly _subAsm{false, {}};
-	auto sub_asm = make_shared<string>("sub.asm");
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
 	_subAsm.appendImmutable("someOtherImmutable");
@@ -132,13 +132,13 @@ namespace
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 
-	AssemblyItems CFG(AssemblyItems const& _input)
+	AssemblyItems CFG(AssemblyItems const& _input, set<size_t> const& _tagsReferencedFromOutside = {})
 	{
 		AssemblyItems output = _input;
 		// Running it four times should be enough for these tests.
 		for (unsigned i = 0; i < 4; ++i)
 		{
-			ControlFlowGraph cfg(output);
+			ControlFlowGraph cfg(output, _tagsReferencedFromOutside);
 			AssemblyItems optItems;
 			for (BasicBlock const& block: cfg.optimisedBlocks())
 				copy(output.begin() + block.begin, output.begin() + block.end,
@@ -148,9 +148,13 @@ namespace
 		return output;
 	}
 
-	void checkCFG(AssemblyItems const& _input, AssemblyItems const& _expectation)
+	void checkCFG(
+		AssemblyItems const& _input,
+		AssemblyItems const& _expectation,
+		set<size_t> const& _tagsReferencedFromOutside = {}
+	)
 	{
-		AssemblyItems output = CFG(_input);
+		AssemblyItems output = CFG(_input, _tagsReferencedFromOutside);
 		BOOST_CHECK_EQUAL_COLLECTIONS(_expectation.begin(), _expectation.end(), output.begin(), output.end());
 	}
 }
@@ -852,6 +856,22 @@ BOOST_AUTO_TEST_CASE(control_flow_graph_do_not_remove_returned_to)
 	checkCFG(input, {u256(2)});
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_graph_keep_tags_referenced_from_outside)
+{
+	// tag 1 is never pushed, but can be the target of the jump to a function pointer
+	// stored in storage by the creation code
+	AssemblyItems input{
+		u256(0),
+		Instruction::SLOAD,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(7),
+		Instruction::STOP
+	};
+	checkCFG(input, input, {1});
+	checkCFG(input, {u256(0), Instruction::SLOAD, Instruction::JUMP});
+}
+
 BOOST_AUTO_TEST_CASE(block_deduplicator)
 {
 	AssemblyItems input{
@@ -1044,9 +1064,70 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_pop_addmod)
+{
+	// Replacing ADDMOD POP by three pops is only an improvement together with the pushes before it.
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		u256(3),
+		Instruction::ADDMOD,
+		Instruction::POP,
+		Instruction::CALLVALUE
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_keep_mulmod_of_stack_values)
+{
+	// The arguments were already on the stack, so three pops instead of MULMOD POP would
+	// not reduce the number of items.
+	AssemblyItems items{
+		Instruction::MULMOD,
+		Instruction::POP
+	};
+	AssemblyItems expectation = items;
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(!peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_revisit_after_replacement)
+{
+	AssemblyItems items{
+		u256(1),
+		Instruction::DUP1,
+		Instruction::SWAP1,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::CALLVALUE
+	};
+	AssemblyItems expectation{
+		u256(1),
+		Instruction::CALLVALUE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1309,6 +1390,110 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(control_flow_graph_only_if_requested)
+{
+	// tag 1 is only referenced by the super-assembly, tag 2 only by the loop it forms itself
+	auto buildAssemblies = [](Assembly& _main)
+	{
+		AssemblyPointer sub = make_shared<Assembly>(true, string{});
+		sub->append(u256(7));
+		sub->append(u256(0));
+		sub->append(Instruction::SSTORE);
+		sub->append(Instruction::STOP);
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(8));
+		sub->append(u256(0));
+		sub->append(Instruction::SSTORE);
+		sub->append(Instruction::STOP);
+		auto t2 = sub->newTag();
+		sub->append(t2);
+		sub->append(u256(9));
+		sub->append(u256(0));
+		sub->append(Instruction::SSTORE);
+		sub->append(t2.pushTag());
+		sub->append(Instruction::JUMP);
+
+		size_t subId = static_cast<size_t>(_main.appendSubroutine(sub).data());
+		_main.append(t1.toSubAssemblyTag(subId));
+		return make_tuple(sub, t1, t2);
+	};
+	auto contains = [](Assembly const& _assembly, AssemblyItem const& _item)
+	{
+		return ranges::any_of(_assembly.items(), [&](AssemblyItem const& _i) { return _i == _item; });
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.runCSE = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	{
+		Assembly main{false, {}};
+		auto [sub, t1, t2] = buildAssemblies(main);
+		main.optimise(settings);
+		BOOST_CHECK(contains(*sub, t1.tag()));
+		BOOST_CHECK(contains(*sub, t2.tag()));
+	}
+
+	settings.experimentalOptimisations = {ExperimentalOptimisation::ControlFlowGraph};
+	{
+		Assembly main{false, {}};
+		auto [sub, t1, t2] = buildAssemblies(main);
+		main.optimise(settings);
+		BOOST_CHECK(contains(*sub, t1.tag()));
+		BOOST_CHECK(!contains(*sub, t2.tag()));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(cse_propagation_only_if_requested)
+{
+	// the value stored before the conditional jump is only known after it if the knowledge is kept
+	auto buildAssembly = [](Assembly& _assembly)
+	{
+		_assembly.append(u256(5));
+		_assembly.append(u256(0));
+		_assembly.append(Instruction::SSTORE);
+		_assembly.append(u256(1));
+		_assembly.append(Instruction::CALLDATALOAD);
+		auto tag = _assembly.newTag();
+		_assembly.append(tag.pushTag());
+		_assembly.append(Instruction::JUMPI);
+		_assembly.append(u256(0));
+		_assembly.append(Instruction::SLOAD);
+		_assembly.append(u256(1));
+		_assembly.append(Instruction::SSTORE);
+		_assembly.append(Instruction::STOP);
+		_assembly.append(tag);
+		_assembly.append(Instruction::STOP);
+	};
+	auto containsSLoad = [](Assembly const& _assembly)
+	{
+		return ranges::any_of(_assembly.items(), [](AssemblyItem const& _i) { return _i == AssemblyItem{Instruction::SLOAD}; });
+	};
+
+	Assembly::OptimiserSettings settings;
+	settings.runCSE = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+
+	{
+		Assembly assembly{false, {}};
+		buildAssembly(assembly);
+		assembly.optimise(settings);
+		BOOST_CHECK(containsSLoad(assembly));
+	}
+
+	settings.experimentalOptimisations = {ExperimentalOptimisation::CSEPropagation};
+	{
+		Assembly assembly{false, {}};
+		buildAssembly(assembly);
+		assembly.optimise(settings);
+		BOOST_CHECK(!containsSLoad(assembly));
+	}
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
@@ -1686,6 +1871,44 @@ BOOST_AUTO_TEST_CASE(inliner)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(inliner_repeated)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems items{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		jumpInto,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::SWAP1,
+		jumpOutOf,
+	};
+	AssemblyItems expectation{
+		AssemblyItem(PushTag, 1),
+		Instruction::CALLVALUE,
+		Instruction::SWAP1,
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		Instruction::STOP,
+		AssemblyItem(Tag, 2),
+		Instruction::CALLVALUE,
+		Instruction::SWAP1,
+		jumpOutOf,
+	};
+	// The same inliner is used again after the items changed.
+	Inliner inliner{items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(inliner.optimise());
+	BOOST_CHECK(!inliner.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
 
 BOOST_AUTO_TEST_CASE(inliner_no_inline_type)
 {
@@ -146,6 +146,18 @@ BOOST_AUTO_TEST_CASE(string_escapes_all)
 	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "aa\n\r\t");
 }
 
+BOOST_AUTO_TEST_CASE(string_long_with_escapes)
+{
+	string const chunk(10000, 'a');
+	CharStream stream("  { \"" + chunk + "\\x62" + chunk + "\\n\" 'c" + chunk + "\x01'", "");
+	Scanner scanner(stream);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::LBrace);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+	BOOST_CHECK(scanner.currentLiteral() == chunk + "b" + chunk + "\n");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalCharacterInString);
+}
+
 struct TestScanner
 {
 	unique_ptr<CharStream> stream;
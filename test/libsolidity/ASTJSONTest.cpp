@@ -59,6 +59,8 @@ string compilerStateToString(CompilerStack::State _state)
 		case CompilerStack::State::SourcesSet: return "SourcesSet";
 		case CompilerStack::State::Parsed: return "Parsed";
 		case CompilerStack::State::ParsedAndImported: return "ParsedAndImported";
+		case CompilerStack::State::NamesResolved: return "NamesResolved";
+		case CompilerStack::State::TypesChecked: return "TypesChecked";
 		case CompilerStack::State::AnalysisPerformed: return "AnalysisPerformed";
 		case CompilerStack::State::CompilationSuccessful: return "CompilationSuccessful";
 	}
@@ -113,6 +113,100 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(remapping_precedence)
+{
+	ImportRemapper remapper;
+	remapper.setRemappings({{"", "a", "x"}, {"", "a/b", "y"}, {"", "a/b", "z"}, {"c", "a", "w"}});
+	// Longer contexts win over longer prefixes, the last of otherwise equal remappings wins.
+	BOOST_CHECK_EQUAL(remapper.apply("a/b/c.sol", ""), "z/c.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("a/c.sol", ""), "x/c.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("a/b/c.sol", "c/d.sol"), "w/b/c.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("b/c.sol", "c/d.sol"), "b/c.sol");
+}
+
+BOOST_AUTO_TEST_CASE(sources_unchanged)
+{
+	map<string, string> files = {
+		{"b.sol", "contract B {} pragma solidity >=0.0;"}
+	};
+	auto readFile = [&](string const&, string const& _path) -> ReadCallback::Result {
+		if (files.count(_path))
+			return {true, files.at(_path)};
+		return {false, "not found"};
+	};
+	StringMap sources = {
+		{"a.sol", "import \"b.sol\"; import \"c.sol\"; contract A is B {} pragma solidity >=0.0;"}
+	};
+
+	CompilerStack c(readFile);
+	BOOST_CHECK(!c.sourcesUnchanged(sources));
+	c.setSources(sources);
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(!c.parseAndAnalyze());
+	BOOST_CHECK(c.sourcesUnchanged(sources));
+
+	BOOST_CHECK(!c.sourcesUnchanged({{"a.sol", "contract A {} pragma solidity >=0.0;"}}));
+	BOOST_CHECK(!c.sourcesUnchanged({{"other.sol", "contract A {} pragma solidity >=0.0;"}}));
+
+	// Changes to imported files are detected, including files that could not be found before.
+	files["b.sol"] = "contract B { uint x; } pragma solidity >=0.0;";
+	BOOST_CHECK(!c.sourcesUnchanged(sources));
+	files["b.sol"] = "contract B {} pragma solidity >=0.0;";
+	BOOST_CHECK(c.sourcesUnchanged(sources));
+	files["c.sol"] = "contract C {} pragma solidity >=0.0;";
+	BOOST_CHECK(!c.sourcesUnchanged(sources));
+}
+
+BOOST_AUTO_TEST_CASE(reuse_parsed_sources)
+{
+	StringMap sources = {
+		{"a.sol", "contract A {} pragma solidity >=0.0;"},
+		{"b.sol", "import \"a.sol\"; contract B is A { function f() public {} } pragma solidity >=0.0;"}
+	};
+	auto compile = [&](CompilerStack& _compiler) {
+		_compiler.reset(true);
+		_compiler.setSources(sources);
+		_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		BOOST_REQUIRE(_compiler.compile(CompilerStack::State::AnalysisPerformed));
+	};
+
+	CompilerStack c;
+	c.setReuseParsedSources(true);
+	compile(c);
+	SourceUnit const* unchanged = &c.ast("b.sol");
+
+	// The unchanged source follows the changed one, so its nodes get new IDs.
+	sources["a.sol"] = "contract A { uint x; } pragma solidity >=0.0;";
+	compile(c);
+	BOOST_CHECK(&c.ast("b.sol") == unchanged);
+	int64_t reusedID = c.ast("b.sol").id();
+	int64_t reusedContractID = c.contractDefinition("B").id();
+
+	c.setReuseParsedSources(false);
+	compile(c);
+	BOOST_CHECK_EQUAL(c.ast("b.sol").id(), reusedID);
+	BOOST_CHECK_EQUAL(c.contractDefinition("B").id(), reusedContractID);
+}
+
+BOOST_AUTO_TEST_CASE(missing_import_read_once)
+{
+	size_t reads = 0;
+	auto readFile = [&](string const&, string const&) -> ReadCallback::Result {
+		++reads;
+		return {false, "not found"};
+	};
+
+	CompilerStack c(readFile);
+	c.setSources({
+		{"a.sol", "import \"m.sol\"; contract A {} pragma solidity >=0.0;"},
+		{"b.sol", "import \"m.sol\"; contract B {} pragma solidity >=0.0;"}
+	});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(!c.parseAndAnalyze());
+	BOOST_CHECK_EQUAL(reads, 1);
+	BOOST_CHECK_EQUAL(c.errors().size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
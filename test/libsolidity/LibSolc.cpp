@@ -179,6 +179,48 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(context_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "import \"found.sol\"; contract A { }"
+			}
+		}
+	}
+	)";
+
+	CStyleReadFileCallback callback{
+		[](void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			++*static_cast<size_t*>(_context);
+			*o_contents = string(_path) == "found.sol" ? stringToSolidity("contract B {}") : nullptr;
+			*o_error = nullptr;
+		}
+	};
+
+	size_t callbackInvocations = 0;
+	SolidityContext* context = solidity_context_create(callback, &callbackInvocations);
+	BOOST_REQUIRE(context);
+	for (size_t i = 0; i < 2; ++i)
+	{
+		char* outputPtr = solidity_context_compile(context, input);
+		string output(outputPtr);
+		solidity_free(outputPtr);
+
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(output, result));
+		BOOST_REQUIRE(result.isObject());
+		BOOST_CHECK(result["sources"].isMember("found.sol"));
+	}
+	solidity_context_destroy(context);
+	solidity_reset();
+
+	BOOST_CHECK_EQUAL(callbackInvocations, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -569,6 +569,29 @@ BOOST_AUTO_TEST_CASE(metadata_license_no_whitespace)
 	BOOST_CHECK(compileAndCheckLicenseMetadata("C", sourceCode) == "GPL-3.0");
 }
 
+BOOST_AUTO_TEST_CASE(metadata_after_releasing_compiled_outputs)
+{
+	char const* sourceCode = R"(
+		pragma solidity >=0.0;
+		contract A {}
+		contract B { function f() public { new A(); } }
+	)";
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"", std::string(sourceCode)}});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+	bytes const bytecodeB = compilerStack.object("B").bytecode;
+	std::string const metadataA = compilerStack.metadata("A");
+
+	compilerStack.releaseCompiledOutputs("A");
+	BOOST_CHECK_THROW(compilerStack.object("A"), langutil::CompilerError);
+	BOOST_CHECK_THROW(compilerStack.assemblyItems("A"), langutil::CompilerError);
+	// The metadata is not derived from the compiled code and the contracts creating A are not affected.
+	BOOST_CHECK_EQUAL(compilerStack.metadata("A"), metadataA);
+	BOOST_CHECK(compilerStack.object("B").bytecode == bytecodeB);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
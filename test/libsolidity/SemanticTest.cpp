@@ -115,6 +115,23 @@ SemanticTest::SemanticTest(
 
 	m_allowNonExistingFunctions = m_reader.boolSetting("allowNonExistingFunctions", false);
 
+	string experimental = m_reader.stringSetting("experimental", "");
+	if (!experimental.empty())
+	{
+		vector<string> names;
+		boost::split(names, experimental, boost::is_any_of(","));
+		for (string const& name: names)
+		{
+			optional<ExperimentalOptimisation> optimisation = experimentalOptimisationFromString(boost::trim_copy(name));
+			if (!optimisation)
+				BOOST_THROW_EXCEPTION(runtime_error("Invalid experimental optimization: \"" + name + "\"."));
+			m_optimiserSettings.experimentalOptimisations.insert(*optimisation);
+		}
+	}
+
+	// Only analysis results are queried from the compiler after deployment.
+	m_cacheBytecode = true;
+
 	parseExpectations(m_reader.stream());
 	soltestAssert(!m_tests.empty(), "No tests specified in " + _filename);
 
@@ -568,8 +585,10 @@ bool SemanticTest::checkGasCostExpectation(TestFunctionCall& io_test, bool _comp
 	// or the test has used up all available gas (test will fail anyway)
 	// or setting is "ir" and it's not included in expectations
 	// or if the called function is an isoltest builtin e.g. `smokeTest` or `storageEmpty`
+	// or the test enables experimental optimizations, whose costs are not recorded
 	if (
 		!m_enforceGasCost ||
+		!m_optimiserSettings.experimentalOptimisations.empty() ||
 		m_gasUsed < m_enforceGasCostMinValue ||
 		m_gasUsed >= InitialGas ||
 		(setting == "ir" && io_test.call().expectations.gasUsed.count(setting) == 0) ||
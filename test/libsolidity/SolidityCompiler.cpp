@@ -51,6 +51,52 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(shared_reverts_only_if_requested)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint x) public pure {
+				if (x == 1) revert("reason");
+				if (x == 2) revert("reason");
+				if (x == 3) revert("reason");
+				if (x == 4) revert("reason");
+			}
+		}
+	)";
+	auto runtimeSize = [&](bool _viaIR, bool _sharedReverts) {
+		BOOST_REQUIRE(success(sourceCode));
+		OptimiserSettings settings = OptimiserSettings::minimal();
+		if (_sharedReverts)
+			settings.experimentalOptimisations.insert(ExperimentalOptimisation::SharedReverts);
+		compiler().setOptimiserSettings(settings);
+		compiler().setViaIR(_viaIR);
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+		return solidity::test::bytecodeSansMetadata(compiler().runtimeObject("C").bytecode).size();
+	};
+	for (bool viaIR: {false, true})
+		BOOST_CHECK_LT(runtimeSize(viaIR, true), runtimeSize(viaIR, false));
+}
+
+BOOST_AUTO_TEST_CASE(optimized_ir_only_if_requested)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f() public pure returns (uint) { return 1; }
+		}
+	)";
+	for (bool requested: {false, true})
+	{
+		BOOST_REQUIRE(success(sourceCode));
+		compiler().setViaIR(true);
+		compiler().enableIRGeneration(requested);
+		BOOST_REQUIRE_MESSAGE(compiler().compile(), "Compiling contract failed");
+		if (requested)
+			BOOST_CHECK(!compiler().yulIROptimized("C").empty());
+		else
+			BOOST_CHECK_THROW(compiler().yulIROptimized("C"), CompilerError);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -4120,6 +4120,31 @@ BOOST_AUTO_TEST_CASE(strip_reason_strings)
 	)
 }
 
+BOOST_AUTO_TEST_CASE(revert_to_evm_host_snapshot)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint public x;
+			function set(uint _x) public payable { x = _x; }
+			function fail(uint _x) public { x = _x; revert(); }
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("set(uint256)", 1), encodeArgs());
+	u256 const block = blockNumber();
+
+	size_t snapshot = m_evmcHost->snapshot();
+	ABI_CHECK(callContractFunctionWithValue("set(uint256)", 7, 2), encodeArgs());
+	ABI_CHECK(callContractFunction("fail(uint256)", 3), encodeArgs());
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(2));
+	BOOST_CHECK_EQUAL(balanceAt(m_contractAddress), 7);
+
+	m_evmcHost->revertToSnapshot(snapshot);
+	ABI_CHECK(callContractFunction("x()"), encodeArgs(1));
+	BOOST_CHECK_EQUAL(balanceAt(m_contractAddress), 0);
+	BOOST_CHECK_EQUAL(blockNumber(), block + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -23,12 +23,21 @@
 
 #include <test/libsolidity/SolidityExecutionFramework.h>
 
+#include <test/GasProfiler.h>
+
+#include <libsolidity/codegen/ir/Common.h>
+
+#include <libevmasm/Assembly.h>
+
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
+#include <libsolutil/Keccak256.h>
+
 #include <boost/test/framework.hpp>
 
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 
@@ -39,6 +48,97 @@ using namespace solidity::langutil;
 using namespace solidity::test;
 using namespace std;
 
+namespace
+{
+
+/// Bytecode shared by all test cases of the process, keyed by the hash of the contract
+/// metadata and of the code generation settings that are not part of it.
+map<util::h256, bytes>& bytecodeCache()
+{
+	static map<util::h256, bytes> cache;
+	return cache;
+}
+
+/// @returns the sources of @a _compiler by their index in the source mappings.
+shared_ptr<GasProfiler::Sources const> gasProfileSources(frontend::CompilerStack const& _compiler)
+{
+	auto sources = make_shared<GasProfiler::Sources>();
+	for (string const& sourceName: _compiler.sourceNames())
+		sources->emplace(
+			static_cast<int>(_compiler.sourceIndices().at(sourceName)),
+			langutil::CharStream(_compiler.charStream(sourceName).source(), sourceName)
+		);
+	return sources;
+}
+
+/// Registers all contracts compiled by @a _compiler with the gas profiler.
+void addToGasProfile(frontend::CompilerStack const& _compiler)
+{
+	auto sources = gasProfileSources(_compiler);
+	for (string const& contractName: _compiler.contractNames())
+		if (!_compiler.object(contractName).bytecode.empty())
+			ExecutionFramework::gasProfiler().addContract(
+				contractName,
+				_compiler.object(contractName),
+				_compiler.sourceMapping(contractName),
+				_compiler.runtimeObject(contractName),
+				_compiler.runtimeSourceMapping(contractName),
+				sources
+			);
+}
+
+/// Registers all contracts compiled by @a _compiler via IR with the gas profiler.
+/// The optimized IR is assembled again with @a _optimiserSettings, like the bytecode of the
+/// test, and the source mappings are taken from the locations of the IR in the Solidity sources.
+void addViaIRToGasProfile(
+	frontend::CompilerStack const& _compiler,
+	EVMVersion _evmVersion,
+	OptimiserSettings const& _optimiserSettings,
+	map<string, Address> const& _libraryAddresses
+)
+{
+	auto sources = gasProfileSources(_compiler);
+	for (string const& contractName: _compiler.contractNames())
+	{
+		string const& ir = _compiler.yulIROptimized(contractName);
+		if (ir.empty())
+			continue;
+		yul::YulStack stack(
+			_evmVersion,
+			yul::YulStack::Language::StrictAssembly,
+			_optimiserSettings,
+			DebugInfoSelection::All()
+		);
+		if (!stack.parseAndAnalyze("", ir))
+			continue;
+		stack.optimize();
+		auto [creationAssembly, runtimeAssembly] = stack.assembleEVMWithDeployed(
+			IRNames::deployedObject(_compiler.contractDefinition(contractName))
+		);
+		if (!creationAssembly || !runtimeAssembly)
+			continue;
+
+		evmasm::LinkerObject creationObject = creationAssembly->assemble();
+		creationObject.link(_libraryAddresses);
+		evmasm::LinkerObject runtimeObject = runtimeAssembly->assemble();
+		runtimeObject.link(_libraryAddresses);
+		string const creationSourceMapping =
+			evmasm::AssemblyItem::computeSourceMapping(creationAssembly->items(), _compiler.sourceIndices());
+		string const runtimeSourceMapping =
+			evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly->items(), _compiler.sourceIndices());
+		ExecutionFramework::gasProfiler().addContract(
+			contractName,
+			creationObject,
+			&creationSourceMapping,
+			runtimeObject,
+			&runtimeSourceMapping,
+			sources
+		);
+	}
+}
+
+}
+
 bytes SolidityExecutionFramework::multiSourceCompileContract(
 	map<string, string> const& _sourceCode,
 	optional<string> const& _mainSourceName,
@@ -63,7 +163,31 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	m_compiler.enableIRGeneration(m_compileViaYul);
 	m_compiler.setRevertStringBehaviour(m_revertStrings);
 	m_compiler.setMetadataHash(m_metadataHash);
-	if (!m_compiler.compile())
+
+	auto const compilationStart = chrono::steady_clock::now();
+	bool const analysisSuccessful = m_compiler.parseAndAnalyze();
+	optional<util::h256> cacheKey;
+	if (m_cacheBytecode && analysisSuccessful)
+	{
+		string contractName(_contractName.empty() ? m_compiler.lastContractName(_mainSourceName) : _contractName);
+		// The metadata covers the sources, the compiler settings and the libraries,
+		// the CBOR data the metadata format.
+		cacheKey = util::keccak256(
+			m_compiler.metadata(contractName) +
+			util::toHex(m_compiler.cborMetadata(contractName)) +
+			(m_compileViaYul ? "viaYul" : "") +
+			(m_compileToEwasm ? "ewasm" : "")
+		);
+		if (auto const* bytecode = util::valueOrNullptr(bytecodeCache(), *cacheKey))
+		{
+			if (m_showMetadata)
+				cout << "metadata: " << m_compiler.metadata(contractName) << endl;
+			++timeSpent().reusedCompilations;
+			timeSpent().compilation += chrono::steady_clock::now() - compilationStart;
+			return *bytecode;
+		}
+	}
+	if (!analysisSuccessful || !m_compiler.compile())
 	{
 		// The testing framework expects an exception for
 		// "unimplemented" yul IR generation.
@@ -111,6 +235,8 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 					asmStack.optimize();
 					obj = move(*asmStack.assemble(yul::YulStack::Machine::EVM).bytecode);
 					obj.link(_libraryAddresses);
+					if (!solidity::test::CommonOptions::get().gasProfile.empty())
+						addViaIRToGasProfile(m_compiler, m_evmVersion, optimiserSettings, _libraryAddresses);
 					break;
 				}
 				catch (...)
@@ -122,10 +248,17 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 		}
 	}
 	else
+	{
 		obj = m_compiler.object(contractName);
+		if (!solidity::test::CommonOptions::get().gasProfile.empty())
+			addToGasProfile(m_compiler);
+	}
 	BOOST_REQUIRE(obj.linkReferences.empty());
 	if (m_showMetadata)
 		cout << "metadata: " << m_compiler.metadata(contractName) << endl;
+	if (cacheKey)
+		bytecodeCache()[*cacheKey] = obj.bytecode;
+	timeSpent().compilation += chrono::steady_clock::now() - compilationStart;
 	return obj.bytecode;
 }
 
@@ -80,6 +80,10 @@ protected:
 	bool m_compileViaYul = false;
 	bool m_compileToEwasm = false;
 	bool m_showMetadata = false;
+	/// Reuse the bytecode compiled earlier in the process for the same sources and settings.
+	/// On a cache hit @a m_compiler is only analysed, so this must stay disabled for tests
+	/// that query it for compiled artefacts.
+	bool m_cacheBytecode = false;
 	CompilerStack::MetadataHash m_metadataHash = CompilerStack::MetadataHash::IPFS;
 	RevertStrings m_revertStrings = RevertStrings::Default;
 };
@@ -242,6 +242,25 @@ BOOST_AUTO_TEST_CASE(encoded_sizes)
 	BOOST_CHECK_EQUAL(twoDimArray.calldataEncodedSize(false), 9 * 3 * 32);
 }
 
+BOOST_AUTO_TEST_CASE(shared_instances)
+{
+	Type const* uint24Array = TypeProvider::array(DataLocation::Memory, TypeProvider::uint(24), 9);
+	BOOST_CHECK(uint24Array == TypeProvider::array(DataLocation::Memory, TypeProvider::uint(24), 9));
+	BOOST_CHECK(uint24Array != TypeProvider::array(DataLocation::Memory, TypeProvider::uint(24), 8));
+	BOOST_CHECK(uint24Array != TypeProvider::array(DataLocation::Storage, TypeProvider::uint(24), 9));
+
+	Type const* mapping = TypeProvider::mapping(TypeProvider::address(), uint24Array);
+	BOOST_CHECK(mapping == TypeProvider::mapping(TypeProvider::address(), uint24Array));
+	BOOST_CHECK(
+		TypeProvider::tuple({mapping, TypeProvider::boolean()}) ==
+		TypeProvider::tuple({mapping, TypeProvider::boolean()})
+	);
+	BOOST_CHECK(
+		TypeProvider::withLocation(TypeProvider::bytesMemory(), DataLocation::CallData, false) ==
+		TypeProvider::withLocation(TypeProvider::bytesMemory(), DataLocation::CallData, false)
+	);
+}
+
 BOOST_AUTO_TEST_CASE(helper_bool_result)
 {
 	BoolResult r1{true};
@@ -28,6 +28,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
 #include <test/Metadata.h>
+#include <test/TemporaryDirectory.h>
 
 #include <algorithm>
 #include <set>
@@ -1090,6 +1091,204 @@ BOOST_AUTO_TEST_CASE(evm_version)
 	BOOST_CHECK(result["errors"][0]["message"].asString() == "Invalid EVM version requested.");
 }
 
+BOOST_AUTO_TEST_CASE(abi_decoder_mode)
+{
+	auto inputForSettings = [](string const& _settings)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": "contract A { function f(address a, bytes32 b) external {} }" } },
+				"settings": {
+					)" + _settings + R"(
+					"outputSelection": {
+						"fileA": {
+							"A": [ "metadata", "evm.bytecode.object" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForSettings("\"abiCoder\": { \"decoderMode\": \"compact\" },"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("\"abiCoder\":{\"decoderMode\":\"compact\"}") != string::npos);
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	// The default is not recorded in the metadata.
+	result = compile(inputForSettings("\"abiCoder\": { \"decoderMode\": \"default\" },"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("abiCoder") == string::npos);
+	result = compile(inputForSettings("\"abiCoder\": { \"decoderMode\": \"invalid\" },"));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for settings.abiCoder.decoderMode."));
+	result = compile(inputForSettings("\"abiCoder\": { \"decoderMode\": 1 },"));
+	BOOST_CHECK(containsError(result, "JSONError", "settings.abiCoder.decoderMode must be a string."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_dispatcher)
+{
+	auto inputForDispatcher = [](string const& _dispatcher)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": "contract A { function f1() external {} function f2() external {} function f3() external {} function f4() external {} function f5() external {} function f6() external {} function f7() external {} function f8() external {} }" } },
+				"settings": {
+					"viaIR": true,
+					"optimizer": { "details": { "dispatcher": )" + _dispatcher + R"( } },
+					"outputSelection": {
+						"fileA": {
+							"A": [ "metadata", "evm.bytecode.object" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForDispatcher("\"binarySearch\""));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("\"dispatcher\":\"binarySearch\"") != string::npos);
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	result = compile(inputForDispatcher("\"linear\""));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("\"dispatcher\":\"linear\"") != string::npos);
+	result = compile(inputForDispatcher("\"invalid\""));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"dispatcher\". Options are \"default\", \"linear\" and \"binarySearch\"."));
+	result = compile(inputForDispatcher("1"));
+	BOOST_CHECK(containsError(result, "JSONError", "The \"dispatcher\" setting must be a string."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_experimental)
+{
+	auto inputForExperimental = [](string const& _experimental)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": "contract A { function f(uint x) external pure returns (uint) { return x + 1; } }" } },
+				"settings": {
+					"optimizer": { "enabled": true, "details": { "experimental": )" + _experimental + R"( } },
+					"outputSelection": {
+						"fileA": {
+							"A": [ "metadata", "evm.bytecode.object" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForExperimental("[]"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("experimental") == string::npos);
+	result = compile(inputForExperimental("[\"controlFlowGraph\"]"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("\"experimental\":[\"controlFlowGraph\"]") != string::npos);
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	result = compile(inputForExperimental("[\"invalid\"]"));
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown experimental optimization \"invalid\"."));
+	result = compile(inputForExperimental("\"controlFlowGraph\""));
+	BOOST_CHECK(containsError(result, "JSONError", "The \"experimental\" setting must be an array of strings."));
+	result = compile(inputForExperimental("[1]"));
+	BOOST_CHECK(containsError(result, "JSONError", "The \"experimental\" setting must be an array of strings."));
+}
+
+BOOST_AUTO_TEST_CASE(ir_gas_estimates)
+{
+	auto inputForViaIR = [](string const& _viaIR)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": "contract A { uint x; function set(uint v) external { x = v; } function sum(uint n) external pure returns (uint s) { for (uint i = 0; i < n; ++i) s += i; } }" } },
+				"settings": {
+					"viaIR": )" + _viaIR + R"(,
+					"optimizer": { "enabled": true },
+					"outputSelection": {
+						"fileA": {
+							"A": [ "evm.irGasEstimates" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForViaIR("true"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& estimates = result["contracts"]["fileA"]["A"]["evm"]["irGasEstimates"];
+	BOOST_REQUIRE(estimates.isObject());
+	BOOST_CHECK(estimates["creation"]["min"].isString());
+	BOOST_CHECK(!estimates["creation"]["loops"].asBool());
+	BOOST_REQUIRE_EQUAL(estimates["external"].size(), 2);
+
+	Json::Value const& setEstimate = estimates["external"]["set(uint256)"];
+	BOOST_CHECK(!setEstimate["loops"].asBool());
+	BOOST_CHECK(u256(setEstimate["min"].asString()) > 2000);
+	BOOST_CHECK(u256(setEstimate["min"].asString()) <= u256(setEstimate["typical"].asString()));
+	BOOST_CHECK(u256(setEstimate["typical"].asString()) <= u256(setEstimate["max"].asString()));
+
+	Json::Value const& sumEstimate = estimates["external"]["sum(uint256)"];
+	BOOST_CHECK(sumEstimate["loops"].asBool());
+	BOOST_CHECK_EQUAL(sumEstimate["max"].asString(), "infinite");
+	BOOST_CHECK(u256(sumEstimate["min"].asString()) <= u256(sumEstimate["typical"].asString()));
+
+	// Without viaIR, there is no estimate on the Yul code.
+	result = compile(inputForViaIR("false"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["evm"]["irGasEstimates"].isNull());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_dispatcher_internal)
+{
+	char const* input = R"(
+		{
+			"language": "Solidity",
+			"sources": { "fileA": { "content": "contract A { function f1() internal {} function f2() internal {} function f3() internal {} function f4() internal {} function f5() internal {} function f6() internal {} function f(uint i) external { function() internal[6] memory fs = [f1, f2, f3, f4, f5, f6]; fs[i](); } }" } },
+			"settings": {
+				"viaIR": true,
+				"optimizer": { "enabled": true, "runs": 10000, "details": { "dispatcher": "binarySearch" } },
+				"outputSelection": {
+					"fileA": {
+						"A": [ "ir", "evm.bytecode.object" ]
+					}
+				}
+			}
+		}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["ir"].asString().find("switch lt(fun, ") != string::npos);
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_inline_assembly_stack)
+{
+	auto inputForSetting = [](string const& _setting)
+	{
+		return R"(
+			{
+				"language": "Solidity",
+				"sources": { "fileA": { "content": "contract A { function f(uint n) external pure returns (uint r) { assembly (\"memory-safe\") { let x := 0 for { let i := 0 } lt(i, 10) { i := add(i, 1) } { x := add(x, mul(i, i)) } mstore(0, x) return(0, 32) } } }" } },
+				"settings": {
+					"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": { "inlineAssemblyStack": )" + _setting + R"( } } },
+					"outputSelection": {
+						"fileA": {
+							"A": [ "metadata", "evm.bytecode.object" ]
+						}
+					}
+				}
+			}
+		)";
+	};
+	Json::Value result = compile(inputForSetting("true"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("\"inlineAssemblyStack\":true") != string::npos);
+	BOOST_CHECK(!result["contracts"]["fileA"]["A"]["evm"]["bytecode"]["object"].asString().empty());
+	result = compile(inputForSetting("false"));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["contracts"]["fileA"]["A"]["metadata"].asString().find("inlineAssemblyStack") == string::npos);
+	result = compile(inputForSetting("1"));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.inlineAssemblyStack\" must be Boolean"));
+}
+
 BOOST_AUTO_TEST_CASE(optimizer_settings_default_disabled)
 {
 	char const* input = R"(
@@ -1252,6 +1451,117 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "profile": { "0xB3DE648B": 1000, "fun_g_20": 1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return g(x) + 1; } function g(uint x) internal pure returns (uint) { return x * 2; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& profile = metadata["settings"]["optimizer"]["profile"];
+	BOOST_CHECK(profile["0xb3de648b"].asUInt() == 1000);
+	BOOST_CHECK(profile["fun_g_20"].asUInt() == 1);
+
+	char const* invalidSelector = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "profile": { "0x1234": 10 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidSelector);
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid function selector \"0x1234\" in the \"profile\" setting."));
+
+	char const* invalidValue = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "profile": { "0x12345678": "often" } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidValue);
+	BOOST_CHECK(containsError(result, "JSONError", "The values of the \"profile\" setting must be unsigned numbers."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.bytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"yul": true,
+				"yulDetails": { "budget": 1000 }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x * 2 + 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["evm"]["bytecode"]["object"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& yulDetails = metadata["settings"]["optimizer"]["details"]["yulDetails"];
+	BOOST_CHECK(yulDetails["budget"].asUInt() == 1000);
+
+	char const* invalidInput = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "details": {
+				"yul": true,
+				"yulDetails": { "budget": "fast" }
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	result = compile(invalidInput);
+	BOOST_CHECK(containsError(result, "JSONError", "The \"budget\" setting must be an unsigned number."));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1616,7 +1926,11 @@ BOOST_AUTO_TEST_CASE(stopAfter_invalid_value)
 	}
 	)";
 	Json::Value result = compile(input);
-	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for \"settings.stopAfter\". Only valid value is \"parsing\"."));
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid value for \"settings.stopAfter\". Valid values are \"parsing\", \"nameResolution\" and \"typeChecking\"."
+	));
 }
 
 BOOST_AUTO_TEST_CASE(stopAfter_invalid_type)
@@ -1683,6 +1997,33 @@ BOOST_AUTO_TEST_CASE(stopAfter_ast_output)
 	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(stopAfter_analysis_stages)
+{
+	// f violates the type checker, g only the state mutability check that runs after it.
+	auto compileUntil = [](string const& _stage, string const& _function) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["a.sol"]["content"] =
+			"pragma solidity >=0.0; contract C { uint x; " + _function + " }";
+		if (!_stage.empty())
+			input["settings"]["stopAfter"] = _stage;
+		input["settings"]["outputSelection"]["*"][""] = Json::arrayValue;
+		input["settings"]["outputSelection"]["*"][""].append("ast");
+		return compile(util::jsonCompactPrint(input));
+	};
+	string const typeError = "function f() public { uint a = true; }";
+	string const mutabilityError = "function g() public pure returns (uint) { return x; }";
+
+	BOOST_CHECK(containsAtMostWarnings(compileUntil("nameResolution", typeError)));
+	BOOST_CHECK(!containsAtMostWarnings(compileUntil("typeChecking", typeError)));
+	BOOST_CHECK(containsAtMostWarnings(compileUntil("typeChecking", mutabilityError)));
+	BOOST_CHECK(!containsAtMostWarnings(compileUntil("", mutabilityError)));
+
+	Json::Value result = compileUntil("nameResolution", mutabilityError);
+	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
+	BOOST_CHECK(!result.isMember("contracts"));
+}
+
 BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract)
 {
 	char const* input = R"(
@@ -1810,6 +2151,259 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	solidity::test::TemporaryDirectory cacheDirectory("solc-cache-test");
+	string input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "import \"B.sol\"; contract A is B {}"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"A.sol": {
+					"A": ["evm.bytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	string importedSource = "contract B { uint public x = 1; }";
+	auto readFile = [&](string const&, string const& _path) -> ReadCallback::Result {
+		if (_path == "B.sol")
+			return {true, importedSource};
+		return {false, "not found"};
+	};
+
+	solidity::frontend::StandardCompiler compiler(readFile);
+	compiler.setCacheDirectory(cacheDirectory.path());
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["cache"]["hits"].asUInt(), 0);
+	BOOST_CHECK_EQUAL(result["cache"]["misses"].asUInt(), 1);
+	string bytecode = result["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].asString();
+	BOOST_CHECK(!bytecode.empty());
+
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK_EQUAL(result["cache"]["hits"].asUInt(), 1);
+	BOOST_CHECK_EQUAL(result["cache"]["misses"].asUInt(), 1);
+	BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].asString(), bytecode);
+
+	// A change in an imported file is a cache miss even though the input is the same.
+	importedSource = "contract B { uint public x = 2; }";
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK_EQUAL(result["cache"]["hits"].asUInt(), 1);
+	BOOST_CHECK_EQUAL(result["cache"]["misses"].asUInt(), 2);
+	BOOST_CHECK(result["contracts"]["A.sol"]["A"]["evm"]["bytecode"]["object"].asString() != bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_directory_not_in_input)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A {}"
+			}
+		},
+		"settings": {
+			"cacheDirectory": "/tmp/solc-cache"
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"cacheDirectory\""));
+}
+
+BOOST_AUTO_TEST_CASE(batched_imports)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "import \"B.sol\"; import \"C.sol\"; import \"D.sol\"; contract A is B, C {}"
+			}
+		},
+		"settings": {
+			"batchedImports": true
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	vector<pair<string, string>> requests;
+	auto readFile = [&](string const& _kind, string const& _path) -> ReadCallback::Result {
+		requests.emplace_back(_kind, _path);
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFiles))
+			return {true, R"({"B.sol": "contract B {}", "C.sol": "contract C {}"})"};
+		return {false, "not found"};
+	};
+
+	solidity::frontend::StandardCompiler compiler(readFile);
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "ParserError", "Source \"D.sol\" not found: not found"));
+
+	vector<pair<string, string>> expectedRequests{
+		{"sources", R"(["B.sol","C.sol","D.sol"])"},
+		{"source", "D.sol"}
+	};
+	BOOST_CHECK(requests == expectedRequests);
+}
+
+BOOST_AUTO_TEST_CASE(lazy_bodies_bin_conflict)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"lazyBodies": true,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Requested output selection conflicts with \"settings.lazyBodies\"."));
+}
+
+BOOST_AUTO_TEST_CASE(lazy_bodies)
+{
+	// The body of L.f contains a type error, which is only reported if L.sol is requested.
+	auto compileRequesting = [](string const& _source) {
+		Json::Value input;
+		input["language"] = "Solidity";
+		input["sources"]["L.sol"]["content"] =
+			"pragma solidity >=0.0; library L { function f(uint a) internal pure returns (uint) { uint b = true; return a; } }";
+		input["sources"]["a.sol"]["content"] =
+			"pragma solidity >=0.0; import \"L.sol\"; contract C { function g() public pure returns (uint) { return L.f(1); } }";
+		input["settings"]["lazyBodies"] = true;
+		input["settings"]["outputSelection"][_source][""] = Json::arrayValue;
+		input["settings"]["outputSelection"][_source][""].append("ast");
+		return compile(util::jsonCompactPrint(input));
+	};
+
+	Json::Value result = compileRequesting("a.sol");
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
+
+	result = compileRequesting("L.sol");
+	BOOST_CHECK(containsError(result, "TypeError", "Type bool is not implicitly convertible to expected type uint256."));
+}
+
+BOOST_AUTO_TEST_CASE(profiles)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "pragma solidity >=0.0; contract C { function f(uint a) public pure returns (uint) { return a + 2 * 3; } }"
+			}
+		},
+		"settings": {
+			"profiles": {
+				"plain": {},
+				"optimized": { "optimizer": { "enabled": true } },
+				"ir": { "viaIR": true },
+				"london": { "evmVersion": "london" }
+			},
+			"outputSelection": { "*": { "": ["ast"], "*": ["evm.bytecode.object", "metadata"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(result["profiles"].isObject());
+	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
+
+	map<string, string> bytecodes;
+	for (string const& profile: {"plain", "optimized", "ir", "london"})
+	{
+		Json::Value const& profileOutput = result["profiles"][profile];
+		BOOST_CHECK(containsAtMostWarnings(profileOutput));
+		BOOST_CHECK(!profileOutput.isMember("sources"));
+		Json::Value const& contract = profileOutput["contracts"]["a.sol"]["C"];
+		BOOST_REQUIRE(contract["evm"]["bytecode"]["object"].isString());
+		bytecodes[profile] = contract["evm"]["bytecode"]["object"].asString();
+		BOOST_CHECK(!bytecodes[profile].empty());
+
+		Json::Value metadata;
+		BOOST_REQUIRE(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+		BOOST_CHECK_EQUAL(metadata["settings"]["optimizer"]["enabled"].asBool(), profile == "optimized");
+		BOOST_CHECK_EQUAL(metadata["settings"].isMember("viaIR"), profile == "ir");
+	}
+	BOOST_CHECK(bytecodes["plain"] != bytecodes["optimized"]);
+	BOOST_CHECK(bytecodes["plain"] != bytecodes["ir"]);
+}
+
+BOOST_AUTO_TEST_CASE(profiles_reuse_unoptimised_ir)
+{
+	// Both profiles are analysed together and only differ in the optimiser steps, so the second
+	// one reuses the unoptimised IR of the first one, but has to embed its own metadata.
+	Json::Value input;
+	input["language"] = "Solidity";
+	input["sources"]["a.sol"]["content"] =
+		"pragma solidity >=0.0; contract D {} contract C { function f() public returns (D) { return new D(); } }";
+	string optimiserSteps = OptimiserSettings::DefaultYulOptimiserSteps;
+	optimiserSteps.erase(remove(optimiserSteps.begin(), optimiserSteps.end(), 'p'), optimiserSteps.end());
+	input["settings"]["viaIR"] = true;
+	input["settings"]["optimizer"]["enabled"] = true;
+	input["settings"]["profiles"]["default"] = Json::objectValue;
+	input["settings"]["profiles"]["steps"]["optimizer"]["enabled"] = true;
+	input["settings"]["profiles"]["steps"]["optimizer"]["details"]["yulDetails"]["optimizerSteps"] = optimiserSteps;
+	input["settings"]["outputSelection"]["*"]["*"].append("ir");
+	input["settings"]["outputSelection"]["*"]["*"].append("evm.deployedBytecode.object");
+	Json::Value result = compile(util::jsonCompactPrint(input));
+
+	// The CBOR metadata is at the end of the deployed bytecode, followed by its length.
+	auto cborMetadata = [](Json::Value const& _contract) {
+		string bytecode = _contract["evm"]["deployedBytecode"]["object"].asString();
+		BOOST_REQUIRE(bytecode.size() > 4);
+		size_t length = (stoul(bytecode.substr(bytecode.size() - 4), nullptr, 16) + 2) * 2;
+		BOOST_REQUIRE(bytecode.size() >= length);
+		return bytecode.substr(bytecode.size() - length);
+	};
+	map<string, string> metadataOfC;
+	for (string const& profile: {"default", "steps"})
+	{
+		Json::Value const& contracts = result["profiles"][profile]["contracts"]["a.sol"];
+		BOOST_CHECK(containsAtMostWarnings(result["profiles"][profile]));
+		string ir = contracts["C"]["ir"].asString();
+		metadataOfC[profile] = cborMetadata(contracts["C"]);
+		BOOST_CHECK(ir.find(metadataOfC[profile]) != string::npos);
+		BOOST_CHECK(ir.find(cborMetadata(contracts["D"])) != string::npos);
+	}
+	BOOST_CHECK(metadataOfC["default"] != metadataOfC["steps"]);
+}
+
+BOOST_AUTO_TEST_CASE(profiles_invalid_key)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "a.sol": { "content": "contract C {}" } },
+		"settings": {
+			"profiles": { "p": { "libraries": {} } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"libraries\""));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: UNLICENSED
+pragma solidity >=0.8.0;
+
+contract C
+{
+    uint counter;
+    //   ^^^^^^^ @counterDeclaration
+
+    function inc() public
+    {
+        counter += 1;
+    //  ^^^^^^^ @counterInc
+    }
+
+    function get() public view returns (uint)
+    {
+        return this.value() + counter;
+    //              ^^^^^ @valueCall
+    //                        ^^^^^^^ @counterGet
+    }
+
+    function value() public view returns (uint)
+    //       ^^^^^ @valueDeclaration
+    {
+        return counter;
+    //         ^^^^^^^ @counterValue
+    }
+}
+// ----
+// -> textDocument/references {
+//     "position": @counterInc,
+//     "context": {
+//         "includeDeclaration": true
+//     }
+// }
+// <- [
+//     {
+//         "range": @counterDeclaration,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @counterInc,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @counterGet,
+//         "uri": "references.sol"
+//     },
+//     {
+//         "range": @counterValue,
+//         "uri": "references.sol"
+//     }
+// ]
+// -> textDocument/references {
+//     "position": @valueDeclaration,
+//     "context": {
+//         "includeDeclaration": false
+//     }
+// }
+// <- [
+//     {
+//         "range": @valueCall,
+//         "uri": "references.sol"
+//     }
+// ]
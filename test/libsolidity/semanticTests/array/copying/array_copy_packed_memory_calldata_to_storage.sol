@@ -0,0 +1,33 @@
+contract C {
+    uint8[] a;
+    uint16[5] b;
+    bytes4[] c;
+
+    function fromMemory(uint n) public returns (uint, uint8, uint8, uint) {
+        uint8[] memory m = new uint8[](n);
+        for (uint i = 0; i < n; i++)
+            m[i] = uint8(i + 1);
+        a = m;
+        uint slot0;
+        assembly { mstore(0, a.slot) slot0 := sload(keccak256(0, 0x20)) }
+        return (a.length, n > 0 ? a[0] : 0, n > 0 ? a[n - 1] : 0, slot0);
+    }
+
+    function fromCalldata(uint16[] calldata _b, bytes4[] calldata _c) public returns (uint16, uint16, uint, bytes4) {
+        uint16[5] memory m;
+        for (uint i = 0; i < _b.length && i < 5; i++)
+            m[i] = _b[i];
+        b = m;
+        c = _c;
+        return (b[0], b[4], c.length, c.length > 0 ? c[c.length - 1] : bytes4(0));
+    }
+}
+// ====
+// compileViaYul: also
+// experimental: packedArrayCopy
+// ----
+// fromMemory(uint256): 40 -> 40, 1, 40, 0x201f1e1d1c1b1a191817161514131211100f0e0d0c0b0a090807060504030201
+// fromMemory(uint256): 3 -> 3, 1, 3, 0x030201
+// fromMemory(uint256): 0 -> 0, 0, 0, 0
+// fromCalldata(uint16[],bytes4[]): 0x40, 0x100, 5, 1, 2, 3, 4, 5, 9, "abcd", "efgh", "ijkl", "mnop", "qrst", "uvwx", "yzAB", "CDEF", "GHIJ" -> 1, 5, 9, "GHIJ"
+// fromCalldata(uint16[],bytes4[]): 0x40, 0x60, 0, 0 -> 0, 0, 0, 0
@@ -0,0 +1,54 @@
+contract C {
+    uint24[] a;
+    uint64[3] b;
+    uint sentinel = 7;
+
+    function fill(uint n) public returns (uint lastSlot) {
+        uint24[] memory m = new uint24[](n);
+        for (uint i = 0; i < n; i++)
+            m[i] = uint24(0xffffff - i);
+        a = m;
+        uint last = (n - 1) / 10;
+        assembly {
+            mstore(0, a.slot)
+            lastSlot := sload(add(keccak256(0, 0x20), last))
+        }
+    }
+
+    function shrink(uint24[] calldata x) public returns (uint, uint lastSlot, uint nextSlot) {
+        a = x;
+        uint last = (x.length - 1) / 10;
+        assembly {
+            mstore(0, a.slot)
+            let data := keccak256(0, 0x20)
+            lastSlot := sload(add(data, last))
+            nextSlot := sload(add(data, add(last, 1)))
+        }
+        return (a.length, lastSlot, nextSlot);
+    }
+
+    function grow() public returns (uint, uint24) {
+        a.push();
+        return (a.length, a[a.length - 1]);
+    }
+
+    function setB(uint64[3] calldata x) public returns (uint bSlot, uint s) {
+        b = x;
+        assembly {
+            bSlot := sload(b.slot)
+            s := sload(sentinel.slot)
+        }
+    }
+}
+// ====
+// compileViaYul: also
+// experimental: packedArrayCopy
+// ----
+// fill(uint256): 25 -> 0xffffe7ffffe8ffffe9ffffeaffffeb
+// shrink(uint24[]): 0x20, 12, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 -> 12, 0x0c00000b, 0
+// grow() -> 13, 0
+// fill(uint256): 25 -> 0xffffe7ffffe8ffffe9ffffeaffffeb
+// fill(uint256): 3 -> 0xfffffdfffffeffffff
+// grow() -> 4, 0
+// setB(uint64[3]): 1, 2, 3 -> 0x300000000000000020000000000000001, 7
+// setB(uint64[3]): 0xffffffffffffffff, 0, 0 -> 0xffffffffffffffff, 7
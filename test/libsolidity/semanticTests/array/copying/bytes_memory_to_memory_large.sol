@@ -0,0 +1,30 @@
+contract C {
+    function f(uint n) public pure returns (bool) {
+        bytes memory a = new bytes(n);
+        for (uint i = 0; i < n; i++)
+            a[i] = bytes1(uint8(i + 1));
+        bytes memory b = abi.encodePacked(a, uint8(0xff));
+        if (b.length != n + 1 || b[n] != 0xff)
+            return false;
+        bytes memory c = abi.encode(a);
+        if (c.length != 64 + ((n + 31) / 32) * 32)
+            return false;
+        for (uint i = 0; i < n; i++)
+            if (b[i] != a[i] || c[64 + i] != a[i])
+                return false;
+        for (uint i = 64 + n; i < c.length; i++)
+            if (c[i] != 0)
+                return false;
+        return true;
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// f(uint256): 0 -> true
+// f(uint256): 31 -> true
+// f(uint256): 95 -> true
+// f(uint256): 96 -> true
+// f(uint256): 97 -> true
+// f(uint256): 449 -> true
+// f(uint256): 2000 -> true
@@ -0,0 +1,63 @@
+contract C {
+    struct S { uint[] a; }
+
+    uint storedPointer;
+    uint[] stored;
+
+    function remember(bytes memory b) internal {
+        uint p;
+        assembly { p := b }
+        storedPointer = p;
+    }
+
+    // Does not take or return memory, but reaches inline assembly that stores a pointer in storage.
+    function allocateAndRemember() internal {
+        bytes memory b = new bytes(32);
+        b[0] = 0x42;
+        remember(b);
+    }
+
+    function throughStorage() public returns (bytes1 r) {
+        allocateAndRemember();
+        bytes memory c = new bytes(32);
+        c[0] = 0x11;
+        uint p = storedPointer;
+        assembly { r := mload(add(p, 32)) }
+    }
+
+    function copyToStorage(uint[] calldata x) internal {
+        uint[] memory m = x;
+        m[0] += 1;
+        stored = m;
+    }
+
+    function tail(uint[] calldata x) internal pure returns (uint[] calldata) {
+        return x[1:];
+    }
+
+    function throughCalldataCopy(uint[] calldata x) public returns (uint, uint, uint, uint, uint) {
+        copyToStorage(x);
+        uint[] memory y = x;
+        uint[] memory t = tail(x);
+        return (stored[0], stored.length, y[0] + y[1], t.length, t[0]);
+    }
+
+    function make() internal pure returns (S memory s) {
+        s.a = new uint[](2);
+        s.a[1] = 7;
+    }
+
+    function returnedStruct() public pure returns (uint) {
+        S memory s = make();
+        uint[] memory z = new uint[](2);
+        z[1] = 9;
+        return s.a[1];
+    }
+}
+// ====
+// compileViaYul: also
+// experimental: releaseTemporaryMemory
+// ----
+// throughStorage() -> left(0x42)
+// throughCalldataCopy(uint256[]): 0x20, 3, 5, 6, 7 -> 6, 3, 11, 2, 6
+// returnedStruct() -> 7
@@ -0,0 +1,40 @@
+contract C {
+    function sum(uint n) internal pure returns (uint s) {
+        uint[] memory a = new uint[](n);
+        for (uint i = 0; i < n; i++)
+            a[i] = i;
+        for (uint i = 0; i < n; i++)
+            s += a[i];
+    }
+
+    function range(uint n) internal pure returns (uint[] memory a) {
+        a = new uint[](n);
+        for (uint i = 0; i < n; i++)
+            a[i] = i;
+    }
+
+    function freeMemoryPointer() internal pure returns (uint p) {
+        assembly { p := mload(0x40) }
+    }
+
+    function temporary() public pure returns (uint r, uint growth) {
+        uint before = freeMemoryPointer();
+        for (uint i = 0; i < 10; i++)
+            r += sum(10);
+        growth = freeMemoryPointer() - before;
+    }
+
+    function returned() public pure returns (uint r, uint growth) {
+        uint before = freeMemoryPointer();
+        uint[] memory a = range(3);
+        uint[] memory b = range(4);
+        r = a[2] + b[3] + a.length + b.length;
+        growth = freeMemoryPointer() - before;
+    }
+}
+// ====
+// compileViaYul: true
+// experimental: releaseTemporaryMemory
+// ----
+// temporary() -> 450, 0
+// returned() -> 12, 0x0120
@@ -0,0 +1,26 @@
+contract C {
+    error E(uint a, string b);
+
+    function f(uint x) public pure returns (uint) {
+        require(x != 1, "abc");
+        require(x != 2, "abc");
+        if (x == 3)
+            revert("abc");
+        if (x == 4)
+            revert E(x, "abc");
+        if (x == 5)
+            revert E(x + 1, "abc");
+        return x;
+    }
+}
+// ====
+// compileViaYul: also
+// experimental: sharedReverts
+// ----
+// f(uint256): 0 -> 0
+// f(uint256): 1 -> FAILURE, hex"08c379a0", 0x20, 3, "abc"
+// f(uint256): 2 -> FAILURE, hex"08c379a0", 0x20, 3, "abc"
+// f(uint256): 3 -> FAILURE, hex"08c379a0", 0x20, 3, "abc"
+// f(uint256): 4 -> FAILURE, hex"ad4e8673", 4, 0x40, 3, "abc"
+// f(uint256): 5 -> FAILURE, hex"ad4e8673", 6, 0x40, 3, "abc"
+// f(uint256): 6 -> 6
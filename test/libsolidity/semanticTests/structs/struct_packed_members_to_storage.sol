@@ -0,0 +1,32 @@
+pragma abicoder v2;
+
+contract C {
+    struct S {
+        uint8 a;
+        bool b;
+        address c;
+        uint16 d;
+        uint256 e;
+        bytes4 f;
+        int8 g;
+    }
+
+    S s;
+
+    function fromMemory(uint8 a, int8 g) external returns (uint8, bool, address, uint16, uint256, bytes4, int8) {
+        S memory m = S(a, true, address(0x1234), 0xabcd, 7, 0x11223344, g);
+        s = m;
+        return (s.a, s.b, s.c, s.d, s.e, s.f, s.g);
+    }
+
+    function fromCalldata(S calldata c) external returns (uint8, bool, address, uint16, uint256, bytes4, int8) {
+        s = c;
+        return (s.a, s.b, s.c, s.d, s.e, s.f, s.g);
+    }
+}
+// ====
+// compileViaYul: also
+// ----
+// fromMemory(uint8,int8): 3, -2 -> 3, true, 0x1234, 0xabcd, 7, 0x1122334400000000000000000000000000000000000000000000000000000000, -2
+// fromCalldata((uint8,bool,address,uint16,uint256,bytes4,int8)): 5, false, 0x42, 1, 2, 0x5566778800000000000000000000000000000000000000000000000000000000, -1 -> 5, false, 0x42, 1, 2, 0x5566778800000000000000000000000000000000000000000000000000000000, -1
+// fromMemory(uint8,int8): 255, 127 -> 255, true, 0x1234, 0xabcd, 7, 0x1122334400000000000000000000000000000000000000000000000000000000, 127
@@ -0,0 +1,10 @@
+contract C {
+    /// @solidity optimize-size
+    function f() public {}
+    /// @solidity optimize-speed
+    function g() public {}
+    /// @dev not inlined into
+    /// @solidity no-inlining
+    function h() public {}
+}
+// ----
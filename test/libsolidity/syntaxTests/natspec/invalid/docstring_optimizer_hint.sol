@@ -0,0 +1,9 @@
+contract C {
+    /// @solidity optimize-fast
+    function f() public {}
+    /// @solidity optimize-size optimize-speed
+    function g() public {}
+}
+// ----
+// Warning 3271: (17-44): Unexpected value for @solidity tag in function: optimize-fast
+// DocstringParsingError 5912: (76-118): Conflicting optimizer hints for function: optimize-speed
@@ -0,0 +1,14 @@
+contract C {
+    uint256 constant a = 2**255 * 2 - 1;
+    int256 constant b = -2**255;
+    uint8 constant c = 6 / 3 * 85;
+    uint8 constant d = 7 / 2 * 2;
+    int8 constant e = -128;
+    int8 constant f = -129;
+    uint8 constant g = 256;
+    int8 constant h = 128;
+}
+// ----
+// TypeError 7407: (206-210): Type int_const -129 is not implicitly convertible to expected type int8. Literal is too large to fit in int8.
+// TypeError 7407: (235-238): Type int_const 256 is not implicitly convertible to expected type uint8. Literal is too large to fit in uint8.
+// TypeError 7407: (262-265): Type int_const 128 is not implicitly convertible to expected type int8. Literal is too large to fit in int8.
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the graph algorithms in libsolutil/Algorithms.h.
+ */
+
+#include <libsolutil/Algorithms.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+vector<set<int>> components(vector<int> const& _vertices, map<int, vector<int>> const& _edges)
+{
+	vector<set<int>> result;
+	for (auto const& component: stronglyConnectedComponents(_vertices, [&](int _vertex, auto&& _addSuccessor) {
+		if (_edges.count(_vertex))
+			for (int successor: _edges.at(_vertex))
+				_addSuccessor(successor);
+	}))
+		result.emplace_back(component.begin(), component.end());
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Algorithms, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(scc_empty)
+{
+	BOOST_CHECK(components({}, {}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(scc_chain)
+{
+	// Callees come before their callers.
+	vector<set<int>> expectation{{3}, {2}, {1}};
+	BOOST_CHECK(components({1}, {{1, {2}}, {2, {3}}}) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(scc_cycles)
+{
+	vector<set<int>> expectation{{4}, {2, 3}, {1}, {5}};
+	BOOST_CHECK(components({1, 5}, {{1, {2}}, {2, {3}}, {3, {2, 4}}, {5, {5}}}) == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(scc_disconnected)
+{
+	vector<set<int>> expectation{{1, 2}, {3}};
+	BOOST_CHECK(components({1, 2, 3}, {{1, {2}}, {2, {1}}}) == expectation);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
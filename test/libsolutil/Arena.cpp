@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Arena.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment_and_blocks)
+{
+	Arena arena(1024);
+	void* a = arena.allocate(1, 1);
+	void* b = arena.allocate(8, 8);
+	BOOST_CHECK(a != b);
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(b) % 8, 0);
+	BOOST_CHECK_EQUAL(arena.blocks(), 1);
+
+	// Large allocations get their own block.
+	void* large = arena.allocate(4096, 16);
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(large) % 16, 0);
+	BOOST_CHECK_EQUAL(arena.blocks(), 2);
+
+	// The current block is still used afterwards.
+	arena.allocate(8, 8);
+	BOOST_CHECK_EQUAL(arena.blocks(), 2);
+
+	for (size_t i = 0; i < 200; ++i)
+		arena.allocate(8, 8);
+	BOOST_CHECK_EQUAL(arena.blocks(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_keep_arena_alive)
+{
+	auto arena = std::make_shared<Arena>();
+	std::weak_ptr<Arena> weakArena = arena;
+	auto first = std::allocate_shared<std::string>(ArenaAllocator<std::string>(arena), 100, 'a');
+	auto second = std::allocate_shared<std::string>(ArenaAllocator<std::string>(arena), "b");
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	first.reset();
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*second, "b");
+	second.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
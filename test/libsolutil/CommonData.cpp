@@ -138,6 +138,17 @@ BOOST_AUTO_TEST_CASE(test_format_number)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(test_to_compact_hex_with_prefix)
+{
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(u256(0)), "0x00");
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(u256(0xf)), "0x0f");
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(u256(0x100)), "0x0100");
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(u256(1) << 64), "0x010000000000000000");
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(u256(0x1234) << 240), "0x1234" + string(60, '0'));
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(~u256(0)), "0x" + string(64, 'f'));
+	BOOST_CHECK_EQUAL(toCompactHexWithPrefix(bigint(0x100)), "0x0100");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
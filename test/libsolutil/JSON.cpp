@@ -118,6 +118,25 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_compact_print_matches_jsoncpp)
+{
+	Json::Value json;
+	json["escapes"] = "\"quote\" \\ / \b\f\n\r\t \x01 \x1f \x7f";
+	json["a\nkey"] = Json::Value(Json::arrayValue);
+	json["empty"] = Json::Value(Json::objectValue);
+	json["list"].append(Json::Value());
+	json["list"].append(-1);
+	json["list"].append(Json::UInt64(18446744073709551615u));
+	json["list"].append(true);
+	json["list"].append(0.5);
+	json["list"].append(string("\0x", 2));
+	json["nested"]["\xc3\xa9"]["x"] = "";
+
+	Json::StreamWriterBuilder builder;
+	builder["indentation"] = "";
+	BOOST_CHECK_EQUAL(jsonCompactPrint(json), Json::writeString(builder, json));
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the helpers in libsolutil/Parallel.h.
+ */
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest)
+
+BOOST_AUTO_TEST_CASE(parallel_for_visits_every_index_once)
+{
+	for (size_t threads: {0u, 1u, 2u, 8u})
+	{
+		vector<atomic<int>> visits(100);
+		parallelFor(visits.size(), threads, [&](size_t _index) { ++visits[_index]; });
+		for (atomic<int> const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_empty)
+{
+	parallelFor(0, 4, [](size_t) { BOOST_FAIL("Task must not be called."); });
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for_rethrows_lowest_index)
+{
+	for (size_t threads: {1u, 4u})
+	{
+		atomic<size_t> executed{0};
+		try
+		{
+			parallelFor(20, threads, [&](size_t _index) {
+				++executed;
+				if (_index == 7 || _index == 13)
+					throw runtime_error(to_string(_index));
+			});
+			BOOST_FAIL("Expected an exception.");
+		}
+		catch (runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(string(_error.what()), "7");
+		}
+		// In sequential mode execution stops at the first exception.
+		BOOST_CHECK_EQUAL(executed.load(), threads == 1 ? 8u : 20u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_reuses_threads)
+{
+	ThreadPool pool(4);
+	set<thread::id> threadIDs;
+	mutex threadIDsMutex;
+	for (size_t round = 0; round < 10; ++round)
+	{
+		vector<atomic<int>> visits(50);
+		pool.parallelFor(visits.size(), [&](size_t _index) {
+			++visits[_index];
+			lock_guard lock(threadIDsMutex);
+			threadIDs.insert(this_thread::get_id());
+		});
+		for (atomic<int> const& count: visits)
+			BOOST_CHECK_EQUAL(count.load(), 1);
+	}
+	BOOST_CHECK_LE(threadIDs.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_rethrows_lowest_index)
+{
+	ThreadPool pool(3);
+	for (size_t round = 0; round < 2; ++round)
+		try
+		{
+			pool.parallelFor(20, [&](size_t _index) {
+				if (_index == 5 || _index == 11)
+					throw runtime_error(to_string(_index));
+			});
+			BOOST_FAIL("Expected an exception.");
+		}
+		catch (runtime_error const& _error)
+		{
+			BOOST_CHECK_EQUAL(string(_error.what()), "5");
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
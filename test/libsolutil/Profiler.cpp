@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for libsolutil/Profiler.h.
+ */
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(records_only_while_active)
+{
+	Profiler profiler;
+	{
+		ProfilerScope scope("inactive");
+	}
+	BOOST_CHECK(profiler.entries().empty());
+
+	{
+		ProfilerActivation activation(&profiler, "");
+		BOOST_CHECK_EQUAL(Profiler::active(), &profiler);
+		ProfilerScope scope("active");
+	}
+	BOOST_CHECK(!Profiler::active());
+	BOOST_REQUIRE_EQUAL(profiler.entries().size(), 1);
+	BOOST_CHECK_EQUAL(profiler.entries()[0].phase, "active");
+	BOOST_CHECK_EQUAL(profiler.entries()[0].invocations, 1);
+}
+
+BOOST_AUTO_TEST_CASE(aggregates_by_context_and_phase)
+{
+	Profiler profiler;
+	{
+		ProfilerActivation activation(&profiler, "");
+		{ ProfilerScope scope("parse"); }
+		{
+			ProfilerActivation contextA("A");
+			BOOST_CHECK_EQUAL(Profiler::activeContext(), "A");
+			{ ProfilerScope scope("codegen"); }
+			{ ProfilerScope scope("codegen"); }
+		}
+		BOOST_CHECK_EQUAL(Profiler::activeContext(), "");
+		{
+			ProfilerActivation contextB("B");
+			ProfilerScope scope("codegen");
+		}
+	}
+
+	vector<Profiler::Entry> entries = profiler.entries();
+	BOOST_REQUIRE_EQUAL(entries.size(), 3);
+	BOOST_CHECK_EQUAL(entries[0].context, "");
+	BOOST_CHECK_EQUAL(entries[0].phase, "parse");
+	BOOST_CHECK_EQUAL(entries[1].context, "A");
+	BOOST_CHECK_EQUAL(entries[1].phase, "codegen");
+	BOOST_CHECK_EQUAL(entries[1].invocations, 2);
+	BOOST_CHECK_EQUAL(entries[2].context, "B");
+	BOOST_CHECK_EQUAL(entries[2].invocations, 1);
+
+	Json::Value json = profiler.toJson();
+	BOOST_REQUIRE_EQUAL(json.size(), 3);
+	BOOST_CHECK_EQUAL(json[1]["context"].asString(), "A");
+	BOOST_CHECK_EQUAL(json[1]["invocations"].asUInt(), 2);
+	BOOST_CHECK(json[1]["wallTimeMs"].isDouble());
+
+	profiler.clear();
+	BOOST_CHECK(profiler.entries().empty());
+}
+
+BOOST_AUTO_TEST_CASE(memory_usage)
+{
+	Profiler profiler;
+	vector<char> retained;
+	{
+		ProfilerActivation activation(&profiler, "");
+		ProfilerScope scope("allocate");
+		retained.resize(16 * 1024 * 1024, 1);
+	}
+	vector<Profiler::Entry> entries = profiler.entries();
+	BOOST_REQUIRE_EQUAL(entries.size(), 1);
+	// The heap usage is unknown on some platforms.
+	if (heapInUse() > 0)
+	{
+		BOOST_CHECK_GE(entries[0].heapGrowth, static_cast<int64_t>(retained.size()));
+		BOOST_CHECK_GE(entries[0].heapInUse, retained.size());
+	}
+	BOOST_CHECK(profiler.toJson()[0]["heapGrowth"].isInt64());
+
+	profiler.recordRetainedObjects("", "AST nodes", 10);
+	profiler.recordRetainedObjects("A", "EVM assembly items", 5);
+	profiler.recordRetainedObjects("", "AST nodes", 20);
+	vector<Profiler::RetainedObjects> retainedObjects = profiler.retainedObjects();
+	BOOST_REQUIRE_EQUAL(retainedObjects.size(), 2);
+	BOOST_CHECK_EQUAL(retainedObjects[0].objects, "AST nodes");
+	BOOST_CHECK_EQUAL(retainedObjects[0].count, 20);
+	BOOST_CHECK_EQUAL(retainedObjects[1].context, "A");
+	BOOST_CHECK(profiler.memoryString().find("EVM assembly items") != string::npos);
+
+	profiler.clear();
+	BOOST_CHECK(profiler.retainedObjects().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
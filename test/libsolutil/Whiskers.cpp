@@ -208,6 +208,23 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unclosed_tags_rendered)
+{
+	string templ = "<?a>x<#b>y</a><!c>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true).render(), "x<#b>y<!c>");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<?c><x><!c><#l><x><y></l></c>";
+	vector<map<string, string>> list(2);
+	list[0]["y"] = "1";
+	list[1]["y"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("x", "A")("l", list).render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("x", "B")("l", list).render(), "B1B2");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("x", "C")("l", vector<map<string, string>>{}).render(), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
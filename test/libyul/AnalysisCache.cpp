@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of analyses shared between optimiser steps.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/AnalysisCache.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+BOOST_AUTO_TEST_SUITE(YulAnalysisCache)
+
+BOOST_AUTO_TEST_CASE(updates_modified_units)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block ast = disambiguate(R"({
+		{ let x := f() sstore(0, x) }
+		function f() -> r { r := g() }
+		function g() -> s { for {} 1 {} { s := mload(0) } }
+		function h() { pop(msize()) }
+	})", false);
+
+	FunctionChangeTracker tracker;
+	AnalysisCache cache(dialect, tracker);
+	auto checkConsistent = [&]()
+	{
+		CallGraph expectedCallGraph = CallGraphGenerator::callGraph(ast);
+		CallGraph const& callGraph = cache.callGraph(ast);
+		BOOST_CHECK(callGraph.functionCalls == expectedCallGraph.functionCalls);
+		BOOST_CHECK(callGraph.functionsWithLoops == expectedCallGraph.functionsWithLoops);
+		BOOST_CHECK(
+			cache.functionSideEffects(ast) ==
+			SideEffectsPropagator::sideEffects(dialect, expectedCallGraph)
+		);
+		BOOST_CHECK_EQUAL(cache.containsMSize(ast), MSizeFinder::containsMSize(dialect, ast));
+		BOOST_CHECK(cache.ssaVariables(ast) == SSAValueTracker::ssaVariables(ast));
+	};
+
+	checkConsistent();
+	BOOST_CHECK(cache.containsMSize(ast));
+
+	// Remove the loop from ``g`` and the function containing msize.
+	get<FunctionDefinition>(ast.statements.at(2)).body.statements.clear();
+	ast.statements.pop_back();
+	tracker.invalidate();
+	checkConsistent();
+	BOOST_CHECK(!cache.containsMSize(ast));
+	BOOST_CHECK(cache.callGraph(ast).functionsWithLoops.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
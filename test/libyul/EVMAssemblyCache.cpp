@@ -0,0 +1,96 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of optimised EVM assemblies of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/backends/evm/EVMAssemblyCache.h>
+#include <libyul/YulStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+string compile(string const& _source)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		YulStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	stack.optimize();
+	MachineAssemblyObject object = stack.assemble(YulStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return object.bytecode->toHex();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulEVMAssemblyCache)
+
+BOOST_AUTO_TEST_CASE(reuses_sub_assemblies)
+{
+	string const inner = R"(
+		object "B" {
+			code {
+				datacopy(0, dataoffset("C"), datasize("C"))
+				return(0, datasize("C"))
+			}
+			object "C" {
+				code {
+					sstore(0, calldataload(0))
+				}
+			}
+		}
+	)";
+	string const outer = R"(
+		object "A" {
+			code {
+				sstore(datasize("B"), datasize("B.C"))
+				sstore(dataoffset("B.C"), dataoffset("B"))
+			}
+		)" + inner + R"(
+		}
+	)";
+	string const expectation = compile(outer);
+
+	EVMAssemblyCache cache;
+	EVMAssemblyCache::Activation activation(&cache);
+	compile(inner);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(compile(outer), expectation);
+	BOOST_CHECK_EQUAL(cache.size(), 3);
+	BOOST_CHECK_EQUAL(compile(outer), expectation);
+	BOOST_CHECK_EQUAL(cache.size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the detection of equivalent functions across Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/EquivalentFunctionDetector.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+string duplicatesAcrossObjects(string const& _source)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		YulStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+
+	string result;
+	for (auto const& group: EquivalentFunctionDetector::duplicatesAcrossObjects(*stack.parserResult()))
+	{
+		for (auto const& function: group)
+			result += function.objectPath + ":" + function.name.str() + " ";
+		result += "| ";
+	}
+	return result;
+}
+
+}
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulEquivalentFunctionDetector)
+
+BOOST_AUTO_TEST_CASE(creation_and_deployed)
+{
+	string source = R"(
+		object "A" {
+			code {
+				function f(a, b) -> r { r := add(a, mload(b)) }
+				function g(x) { sstore(x, 1) }
+				sstore(f(1, 2), 0)
+				g(3)
+			}
+			object "A_deployed" {
+				code {
+					function h(c, d) -> s { s := add(c, mload(d)) }
+					function k(y) { sstore(y, 2) }
+					sstore(h(1, 2), 0)
+					k(3)
+				}
+			}
+		}
+	)";
+	BOOST_CHECK_EQUAL(duplicatesAcrossObjects(source), "A:f A.A_deployed:h | ");
+}
+
+BOOST_AUTO_TEST_CASE(parameter_order_matters)
+{
+	string source = R"(
+		object "A" {
+			code {
+				function f(a, b) -> r { r := sub(a, b) }
+				sstore(f(1, 2), 0)
+			}
+			object "B" {
+				code {
+					function g(a, b) -> r { r := sub(b, a) }
+					sstore(g(1, 2), 0)
+				}
+			}
+		}
+	)";
+	BOOST_CHECK_EQUAL(duplicatesAcrossObjects(source), "");
+}
+
+BOOST_AUTO_TEST_CASE(same_object_not_reported)
+{
+	string source = R"(
+		object "A" {
+			code {
+				function f(a) -> r { r := not(a) }
+				function g(b) -> s { s := not(b) }
+				sstore(f(1), g(2))
+			}
+		}
+	)";
+	BOOST_CHECK_EQUAL(duplicatesAcrossObjects(source), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
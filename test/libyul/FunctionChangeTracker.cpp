@@ -0,0 +1,149 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the tracking of functions intra-procedural optimiser steps have converged on.
+ */
+
+#include <test/libyul/Common.h>
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/FunctionChangeTracker.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/UnusedAssignEliminator.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+string const sourceWithRedundantAssignments = R"({
+	{ sstore(0, f()) }
+	function f() -> r { r := 1 r := 2 }
+	function g(a) { sstore(a, 1) }
+})";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulFunctionChangeTracker)
+
+BOOST_AUTO_TEST_CASE(stable_units_are_skipped)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block ast = disambiguate(sourceWithRedundantAssignments, false);
+	Block expectation = disambiguate(sourceWithRedundantAssignments, false);
+
+	NameDispenser dispenser{dialect, ast};
+	set<YulString> reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, nullopt};
+	OptimiserStep const& step = *OptimiserSuite::allSteps().at(UnusedAssignEliminator::name);
+	BOOST_REQUIRE(step.isIntraProcedural());
+
+	FunctionChangeTracker tracker;
+	auto const initialCodes = tracker.unitCodes(ast);
+	BOOST_REQUIRE(tracker.run(step, context, ast));
+	BOOST_CHECK_EQUAL(tracker.lastUnitsRun(), 3u);
+	// Only ``f`` was changed by the first run, so only its code was replaced.
+	BOOST_CHECK(tracker.unitCodes(ast).at(0) == initialCodes.at(0));
+	BOOST_CHECK(tracker.unitCodes(ast).at(1) != initialCodes.at(1));
+	BOOST_CHECK(tracker.unitCodes(ast).at(2) == initialCodes.at(2));
+	BOOST_REQUIRE(tracker.run(step, context, ast));
+	BOOST_CHECK_EQUAL(tracker.lastUnitsRun(), 1u);
+	BOOST_REQUIRE(tracker.run(step, context, ast));
+	BOOST_CHECK_EQUAL(tracker.lastUnitsRun(), 0u);
+
+	step.run(context, expectation);
+	BOOST_CHECK_EQUAL(AsmPrinter{}(ast), AsmPrinter{}(expectation));
+
+	// Units changed outside of the tracker are detected after invalidation.
+	get<FunctionDefinition>(ast.statements.at(2)).body.statements.clear();
+	tracker.invalidate();
+	BOOST_REQUIRE(tracker.run(step, context, ast));
+	BOOST_CHECK_EQUAL(tracker.lastUnitsRun(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(multiple_threads)
+{
+	string source = "{ { sstore(0, f0()) }";
+	for (size_t i = 0; i < 40; ++i)
+		source += " function f" + to_string(i) + "() -> r { r := " + to_string(i) + " r := add(r, 1) }";
+	source += " }";
+
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block ast = disambiguate(source, false);
+	Block expectation = disambiguate(source, false);
+
+	NameDispenser dispenser{dialect, ast};
+	set<YulString> reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, nullopt};
+	util::ThreadPool threadPool(4);
+	FunctionChangeTracker tracker;
+	for (char const* stepName: {ExpressionSimplifier::name, UnusedAssignEliminator::name, ExpressionSimplifier::name})
+	{
+		OptimiserStep const& step = *OptimiserSuite::allSteps().at(stepName);
+		BOOST_REQUIRE(tracker.run(step, context, ast, &threadPool));
+		step.run(context, expectation);
+	}
+	BOOST_CHECK_EQUAL(AsmPrinter{}(ast), AsmPrinter{}(expectation));
+}
+
+BOOST_AUTO_TEST_CASE(requires_grouped_ast)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block ast = disambiguate("{ function f() {} sstore(0, 1) }", false);
+
+	NameDispenser dispenser{dialect, ast};
+	set<YulString> reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, nullopt};
+	FunctionChangeTracker tracker;
+	BOOST_CHECK(!tracker.run(*OptimiserSuite::allSteps().at(UnusedAssignEliminator::name), context, ast));
+}
+
+BOOST_AUTO_TEST_CASE(hash_includes_names)
+{
+	Block a = disambiguate("{ function f(x) -> y { y := x } }", false);
+	Block b = disambiguate("{ function f(x) -> z { z := x } }", false);
+	Block c = disambiguate("{ function f(x) -> y { y := x } }", false);
+	BOOST_CHECK(FunctionChangeTracker::hash(a.statements.front()) != FunctionChangeTracker::hash(b.statements.front()));
+	BOOST_CHECK_EQUAL(FunctionChangeTracker::hash(a.statements.front()), FunctionChangeTracker::hash(c.statements.front()));
+	BOOST_CHECK(FunctionChangeTracker::code(a.statements.front()) != FunctionChangeTracker::code(b.statements.front()));
+	BOOST_CHECK(FunctionChangeTracker::code(a.statements.front()) == FunctionChangeTracker::code(c.statements.front()));
+}
+
+BOOST_AUTO_TEST_CASE(code_distinguishes_structure)
+{
+	// Same identifiers and literals in a different structure.
+	Block a = disambiguate("{ function f(x) { if x { sstore(x, 1) } } }", false);
+	Block b = disambiguate("{ function f(x) { if x {} sstore(x, 1) } }", false);
+	BOOST_CHECK(FunctionChangeTracker::code(a.statements.front()) != FunctionChangeTracker::code(b.statements.front()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
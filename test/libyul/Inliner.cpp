@@ -21,17 +21,24 @@
  */
 
 #include <test/libyul/Common.h>
+#include <test/Common.h>
 
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/InlinableExpressionFunctionFinder.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AST.h>
 
 #include <boost/test/unit_test.hpp>
 
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/replace.hpp>
 
 using namespace std;
 using namespace solidity;
@@ -54,6 +61,28 @@ string inlinableFunctions(string const& _source)
 	return boost::algorithm::join(functionNames, ",");
 }
 
+/// @returns the number of remaining calls to @a _function after running the full inliner on @a _source.
+size_t callsAfterFullInlining(
+	string const& _source,
+	string const& _function,
+	size_t _runs = 200,
+	set<frontend::ExperimentalOptimisation> _experimentalOptimisations = {}
+)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	Block ast = disambiguate(_source, false);
+	NameDispenser dispenser(dialect, ast);
+	set<YulString> reservedIdentifiers;
+	GasMeter meter(dialect, false, _runs);
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers, _runs};
+	context.meter = &meter;
+	context.experimentalOptimisations = move(_experimentalOptimisations);
+	FunctionHoister::run(context, ast);
+	FunctionGrouper::run(context, ast);
+	FullInliner::run(context, ast);
+	return util::valueOrDefault(ReferencesCounter::countReferences(ast), YulString{_function}, size_t(0));
+}
+
 }
 
 
@@ -107,4 +136,61 @@ BOOST_AUTO_TEST_CASE(negative)
 }
 
 
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(YulFullInliner)
+
+BOOST_AUTO_TEST_CASE(size_limit_grows_with_runs_only_if_requested)
+{
+	string const source = R"({
+		function f(a) {
+			sstore(add(a, 1), mul(a, a))
+			sstore(add(a, 2), mul(a, 3))
+		}
+		let x := calldataload(0)
+		f(x)
+		f(calldataload(32))
+	})";
+	set<frontend::ExperimentalOptimisation> const gasWeighted{frontend::ExperimentalOptimisation::GasWeightedInlining};
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", 200), 2);
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", 10000), 2);
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", 200, gasWeighted), 2);
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "f", 10000, gasWeighted), 0);
+}
+
+BOOST_AUTO_TEST_CASE(constant_switch_selector)
+{
+	// Too large to be inlined as a whole, but only a single case is executed for a constant selector.
+	string const source = R"({
+		function dispatch(fun, x) -> r {
+			switch fun
+			case 1 { r := sload(x) }
+			case 2 { r := mload(x) }
+			case 3 { r := balance(x) }
+			case 4 { r := calldataload(x) }
+			default { revert(0, 0) }
+		}
+		let x := calldataload(0)
+		let f := 2
+		let c := calldataload(32)
+		let a := dispatch(f, x)
+		let b := dispatch(c, x)
+		sstore(a, b)
+	})";
+	set<frontend::ExperimentalOptimisation> const dispatchInlining{frontend::ExperimentalOptimisation::DispatchInlining};
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "dispatch", 200, dispatchInlining), 1);
+	// Without the option, the whole function counts and neither call is inlined.
+	BOOST_CHECK_EQUAL(callsAfterFullInlining(source, "dispatch"), 2);
+	// Without a constant selector, neither call is inlined.
+	BOOST_CHECK_EQUAL(
+		callsAfterFullInlining(
+			boost::replace_all_copy(string(source), "let f := 2", "let f := calldataload(64)"),
+			"dispatch",
+			200,
+			dispatchInlining
+		),
+		2
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
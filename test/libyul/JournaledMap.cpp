@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the map that records its modifications since checkpoints.
+ */
+
+#include <libyul/optimiser/JournaledMap.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulJournaledMap)
+
+BOOST_AUTO_TEST_CASE(join_keeps_unchanged_entries)
+{
+	JournaledMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+	map.set("c"_yulstring, "z"_yulstring);
+
+	JournaledMap::Checkpoint checkpoint = map.checkpoint();
+	map.set("a"_yulstring, "w"_yulstring);
+	map.erase("b"_yulstring);
+	map.set("d"_yulstring, "v"_yulstring);
+	map.set("c"_yulstring, "u"_yulstring);
+	map.set("c"_yulstring, "z"_yulstring);
+	map.joinWith(checkpoint);
+
+	BOOST_CHECK_EQUAL(map.size(), 1u);
+	BOOST_REQUIRE(map.find("c"_yulstring));
+	BOOST_CHECK(*map.find("c"_yulstring) == "z"_yulstring);
+}
+
+BOOST_AUTO_TEST_CASE(nested_checkpoints)
+{
+	JournaledMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+
+	JournaledMap::Checkpoint outer = map.checkpoint();
+	map.set("c"_yulstring, "z"_yulstring);
+	JournaledMap::Checkpoint inner = map.checkpoint();
+	map.set("a"_yulstring, "w"_yulstring);
+	map.joinWith(inner);
+	BOOST_CHECK(!map.find("a"_yulstring));
+	BOOST_CHECK(map.find("b"_yulstring));
+	BOOST_CHECK(map.find("c"_yulstring));
+
+	// Entries removed by the inner join and entries added before it
+	// are changes relative to the outer checkpoint.
+	map.set("a"_yulstring, "x"_yulstring);
+	map.joinWith(outer);
+	BOOST_CHECK_EQUAL(map.size(), 2u);
+	BOOST_CHECK(map.find("a"_yulstring));
+	BOOST_CHECK(map.find("b"_yulstring));
+	BOOST_CHECK(!map.find("c"_yulstring));
+}
+
+BOOST_AUTO_TEST_CASE(clear_is_recorded)
+{
+	JournaledMap map;
+	map.set("a"_yulstring, "x"_yulstring);
+	JournaledMap::Checkpoint checkpoint = map.checkpoint();
+	map.clear();
+	map.set("a"_yulstring, "x"_yulstring);
+	map.set("b"_yulstring, "y"_yulstring);
+	map.joinWith(checkpoint);
+	BOOST_CHECK_EQUAL(map.size(), 1u);
+	BOOST_CHECK(map.find("a"_yulstring));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -125,6 +125,27 @@ BOOST_AUTO_TEST_CASE(difference)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(value_range)
+{
+	yul::KnowledgeBase kb = constructKnowledgeBase(R"({
+		let a := calldataload(0)
+		let b := and(a, 0xff)
+		let c := add(b, 0x100)
+		let d := shr(248, a)
+		let e := lt(d, c)
+		let f := sub(a, 1)
+	})");
+	auto range = [&](string const& _name) { return kb.valueRange(Identifier{{}, YulString{_name}}); };
+
+	BOOST_CHECK(range("a").min == 0 && range("a").max == numeric_limits<u256>::max());
+	BOOST_CHECK(range("b").min == 0 && range("b").max == 0xff);
+	BOOST_CHECK(range("c").min == 0x100 && range("c").max == 0x1ff);
+	BOOST_CHECK(range("d").min == 0 && range("d").max == 0xff);
+	BOOST_CHECK(range("e").isConstant() && range("e").min == 1);
+	// The subtraction can wrap around.
+	BOOST_CHECK(range("f").min == 0 && range("f").max == numeric_limits<u256>::max());
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -23,6 +23,8 @@
 #include <test/libyul/Common.h>
 
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/AST.h>
 
 #include <boost/test/unit_test.hpp>
@@ -378,6 +380,27 @@ BOOST_FIXTURE_TEST_CASE(switch_statement_large_custom_weights, CustomWeightFixtu
 	);
 }
 
+BOOST_AUTO_TEST_CASE(gas_costs_of_block)
+{
+	shared_ptr<Block> ast = parse("{ function f(a) { sstore(a, 1) } f(2) }", false).first;
+	BOOST_REQUIRE(ast);
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+
+	auto const& functionDefinition = get<FunctionDefinition>(ast->statements.at(0));
+	auto const& call = get<FunctionCall>(get<ExpressionStatement>(ast->statements.at(1)).expression);
+	for (size_t runs: {1, 200, 10000})
+	{
+		GasMeter meter(dialect, false, runs);
+		BOOST_CHECK_EQUAL(
+			meter.costs(*ast),
+			meter.costs(get<ExpressionStatement>(functionDefinition.body.statements.at(0)).expression) +
+			meter.costs(call.arguments.at(0)) +
+			meter.functionCallCosts()
+		);
+	}
+	BOOST_CHECK(GasMeter(dialect, false, 10000).functionCallCosts() > GasMeter(dialect, false, 200).functionCallCosts());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary encoding of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/ObjectSerialiser.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+shared_ptr<Object> parse(string const& _source)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		YulStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	return stack.parserResult();
+}
+
+string print(Object const& _object)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	return _object.toString(&dialect, DebugInfoSelection::All());
+}
+
+string const source = R"(
+	/// @use-src 0:"a.sol", 1:"b.sol"
+	object "A" {
+		code {
+			/// @src 0:10:20
+			function f(a, b) -> r {
+				/// @src 1:5:8
+				switch a
+				case 0 { r := b }
+				default { leave }
+			}
+			/// @src 0:30:40 "for { let i"
+			for { let i := 0 } lt(i, 10) { i := add(i, 1) } {
+				if eq(i, 5) { continue }
+				sstore(i, f(i, "abc"))
+				/// @ast-id 7
+				if gt(i, 8) { break }
+			}
+			let x, y
+			x, y := foo()
+			function foo() -> p, q { p := datasize("B") q := dataoffset("D") }
+		}
+		object "B" {
+			code { sstore(0, true) }
+			data "C" hex"0102ff"
+		}
+		data "D" "data"
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectSerialiser)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	shared_ptr<Object> object = parse(source);
+	bytes encoded = ObjectSerialiser::serialise(*object);
+	shared_ptr<Object> decoded = ObjectSerialiser::deserialise(bytesConstRef(&encoded));
+	BOOST_REQUIRE(decoded);
+	BOOST_CHECK_EQUAL(print(*decoded), print(*object));
+	BOOST_CHECK(ObjectSerialiser::serialise(*decoded) == encoded);
+}
+
+BOOST_AUTO_TEST_CASE(malformed)
+{
+	bytes encoded = ObjectSerialiser::serialise(*parse(source));
+	for (size_t length = 0; length < encoded.size(); ++length)
+		BOOST_CHECK(!ObjectSerialiser::deserialise(bytesConstRef(encoded.data(), length)));
+
+	bytes trailing = encoded + bytes{0};
+	BOOST_CHECK(!ObjectSerialiser::deserialise(bytesConstRef(&trailing)));
+
+	bytes wrongVersion = encoded;
+	wrongVersion[4] = 0x7f;
+	BOOST_CHECK(!ObjectSerialiser::deserialise(bytesConstRef(&wrongVersion)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the cache of optimised Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/optimiser/OptimisedObjectCache.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace
+{
+
+string optimise(string const& _source)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		YulStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full(),
+		DebugInfoSelection::All()
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", _source));
+	stack.optimize();
+	return stack.print();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimisedObjectCache)
+
+BOOST_AUTO_TEST_CASE(reuses_sub_objects)
+{
+	string const inner = R"(
+		object "B" {
+			code {
+				function f(a) -> r { r := add(a, 1) }
+				sstore(0, f(calldataload(0)))
+				sstore(1, f(calldataload(32)))
+			}
+		}
+	)";
+	string const outer = R"(
+		object "A" {
+			code {
+				let x := datasize("B")
+				sstore(x, mload(0))
+			}
+		)" + inner + R"(
+		}
+	)";
+	string const expectation = optimise(outer);
+
+	OptimisedObjectCache cache;
+	OptimisedObjectCache::Activation activation(&cache);
+	optimise(inner);
+	BOOST_CHECK_EQUAL(cache.size(), 1);
+	BOOST_CHECK_EQUAL(cache.hits(), 0);
+	// The sub-object is found, the outer object is optimised and stored.
+	BOOST_CHECK_EQUAL(optimise(outer), expectation);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(cache.hits(), 1);
+	// Both objects are found.
+	BOOST_CHECK_EQUAL(optimise(outer), expectation);
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK_EQUAL(cache.hits(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(optimised_objects_are_not_found)
+{
+	string const source = R"(
+		object "A" {
+			code {
+				function f(a) -> r { r := add(a, 1) }
+				sstore(0, f(calldataload(0)))
+				sstore(1, f(calldataload(32)))
+			}
+		}
+	)";
+
+	OptimisedObjectCache cache;
+	OptimisedObjectCache::Activation activation(&cache);
+	string const optimised = optimise(source);
+	BOOST_CHECK_EQUAL(cache.hits(), 0);
+	// Optimising the optimised code again, like the EVM backend does, uses a different key.
+	optimise(optimised);
+	BOOST_CHECK_EQUAL(cache.hits(), 0);
+	optimise(optimised);
+	BOOST_CHECK_EQUAL(cache.hits(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,7 @@
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/Dialect.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <liblangutil/ErrorReporter.h>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -58,9 +59,9 @@ shared_ptr<Block> parse(string const& _source, Dialect const& _dialect, ErrorRep
 	try
 	{
 		auto stream = CharStream(_source, "");
-		map<unsigned, shared_ptr<string const>> indicesToSourceNames;
-		indicesToSourceNames[0] = make_shared<string const>("source0");
-		indicesToSourceNames[1] = make_shared<string const>("source1");
+		map<unsigned, string const*> indicesToSourceNames;
+		indicesToSourceNames[0] = internSourceName("source0");
+		indicesToSourceNames[1] = internSourceName("source1");
 
 		auto parserResult = yul::Parser(
 			errorReporter,
@@ -951,6 +952,46 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(debug_data_is_interned)
+{
+	auto sourceName = internSourceName("source0");
+	auto otherSourceName = internSourceName("source0");
+	SourceLocation location{10, 20, sourceName};
+
+	DebugData const* debugData = DebugData::create(location, location, 7);
+	BOOST_CHECK(debugData == DebugData::create(location, location, 7));
+	BOOST_CHECK(debugData == DebugData::create(location, SourceLocation{10, 20, otherSourceName}, 7));
+	BOOST_CHECK(debugData != DebugData::create(location, location, 8));
+	BOOST_CHECK(debugData != DebugData::create(location, SourceLocation{10, 21, sourceName}, 7));
+	BOOST_CHECK(debugData->originLocation == location);
+}
+
+BOOST_AUTO_TEST_CASE(evm_dialect_builtin_lookup)
+{
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(dialect.builtin("mstore"_yulstring));
+	BOOST_CHECK(dialect.builtin("mstore"_yulstring)->name == "mstore"_yulstring);
+	BOOST_CHECK(dialect.memoryStoreFunction(dialect.defaultType) == dialect.builtin("mstore"_yulstring));
+	BOOST_CHECK(dialect.discardFunction(dialect.defaultType) == dialect.builtin("pop"_yulstring));
+	BOOST_CHECK(dialect.hashFunction(dialect.defaultType) == "keccak256"_yulstring);
+	BOOST_CHECK(!dialect.builtin(YulString{}));
+	// Names interned after the dialect was created are not builtins.
+	BOOST_CHECK(!dialect.builtin("not_a_builtin_evm_dialect_builtin_lookup"_yulstring));
+	BOOST_CHECK(!dialect.reservedIdentifier("not_a_builtin_evm_dialect_builtin_lookup"_yulstring));
+	BOOST_CHECK(dialect.reservedIdentifier("mstore"_yulstring));
+	BOOST_CHECK(dialect.reservedIdentifier("dup1"_yulstring));
+	BOOST_CHECK(!dialect.builtin("dup1"_yulstring));
+	BOOST_REQUIRE(dialect.builtin("verbatim_1i_2o"_yulstring));
+	BOOST_CHECK(dialect.builtin("verbatim_1i_2o"_yulstring)->returns.size() == 2);
+
+	EVMDialectTyped const& typedDialect = EVMDialectTyped::instance(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_CHECK(!typedDialect.builtin("iszero"_yulstring));
+	BOOST_CHECK(typedDialect.booleanNegationFunction() == typedDialect.builtin("not"_yulstring));
+	BOOST_CHECK(typedDialect.discardFunction(typedDialect.boolType) == typedDialect.builtin("popbool"_yulstring));
+	BOOST_CHECK(typedDialect.discardFunction(typedDialect.defaultType) == typedDialect.builtin("pop"_yulstring));
+	BOOST_CHECK(!typedDialect.equalityFunction(typedDialect.boolType));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -33,6 +33,8 @@
 
 #include <libsolutil/AnsiColorized.h>
 
+#include <boost/algorithm/string.hpp>
+
 #include <fstream>
 
 using namespace solidity;
@@ -64,6 +66,20 @@ YulOptimizerTest::YulOptimizerTest(string const& _filename):
 	auto dialectName = m_reader.stringSetting("dialect", "evm");
 	m_dialect = &dialect(dialectName, solidity::test::CommonOptions::get().evmVersion());
 
+	string experimental = m_reader.stringSetting("experimental", "");
+	if (!experimental.empty())
+	{
+		vector<string> names;
+		boost::split(names, experimental, boost::is_any_of(","));
+		for (string const& name: names)
+		{
+			optional<ExperimentalOptimisation> optimisation = experimentalOptimisationFromString(boost::trim_copy(name));
+			if (!optimisation)
+				BOOST_THROW_EXCEPTION(runtime_error("Invalid experimental optimization: \"" + name + "\"."));
+			m_experimentalOptimisations.insert(*optimisation);
+		}
+	}
+
 	m_expectation = m_reader.simpleExpectations();
 }
 
@@ -78,6 +94,7 @@ TestCase::TestResult YulOptimizerTest::run(ostream& _stream, string const& _line
 	m_object->analysisInfo = m_analysisInfo;
 	YulOptimizerTestCommon tester(m_object, *m_dialect);
 	tester.setStep(m_optimizerStep);
+	tester.setExperimentalOptimisations(m_experimentalOptimisations);
 
 	if (!tester.runStep())
 	{
@@ -20,6 +20,10 @@
 
 #include <test/TestCase.h>
 
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <set>
+
 namespace solidity::langutil
 {
 class Error;
@@ -53,6 +57,7 @@ private:
 	);
 
 	std::string m_optimizerStep;
+	std::set<frontend::ExperimentalOptimisation> m_experimentalOptimisations;
 
 	Dialect const* m_dialect = nullptr;
 
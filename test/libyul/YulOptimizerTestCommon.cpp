@@ -40,6 +40,7 @@
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/NameDisplacer.h>
@@ -279,6 +280,12 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			ForLoopInitRewriter::run(*m_context, *m_ast);
+			FunctionHoister::run(*m_context, *m_ast);
+			LoopUnroller::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -339,7 +346,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 				*m_object,
 				true,
 				frontend::OptimiserSettings::DefaultYulOptimiserSteps,
-				frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+				frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment,
+				{},
+				nullopt,
+				{},
+				m_experimentalOptimisations
 			);
 		}},
 		{"stackLimitEvader", [&]() {
@@ -398,6 +409,11 @@ void YulOptimizerTestCommon::setStep(string const& _optimizerStep)
 	m_optimizerStep = _optimizerStep;
 }
 
+void YulOptimizerTestCommon::setExperimentalOptimisations(set<frontend::ExperimentalOptimisation> _optimisations)
+{
+	m_experimentalOptimisations = move(_optimisations);
+}
+
 bool YulOptimizerTestCommon::runStep()
 {
 	yulAssert(m_dialect, "Dialect not set.");
@@ -464,4 +480,5 @@ void YulOptimizerTestCommon::updateContext()
 		m_reservedIdentifiers,
 		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
 	});
+	m_context->experimentalOptimisations = m_experimentalOptimisations;
 }
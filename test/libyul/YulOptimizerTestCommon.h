@@ -45,6 +45,8 @@ public:
 	/// Sets optimiser step to be run to @param
 	/// _optimiserStep.
 	void setStep(std::string const& _optimizerStep);
+	/// Enables the experimental optimisations @param _optimisations for the steps.
+	void setExperimentalOptimisations(std::set<frontend::ExperimentalOptimisation> _optimisations);
 	/// Runs chosen optimiser step returning pointer
 	/// to yul AST Block post optimisation.
 	std::shared_ptr<Block> run();
@@ -61,6 +63,7 @@ private:
 	void updateContext();
 
 	std::string m_optimizerStep;
+	std::set<frontend::ExperimentalOptimisation> m_experimentalOptimisations;
 
 	Dialect const* m_dialect = nullptr;
 	std::set<YulString> m_reservedIdentifiers;
@@ -811,7 +811,7 @@ class SolidityLSPTestSuite: # {{{
         """
         reports = []
 
-        num_files = solc.receive_message()["params"]["openFileCount"]
+        num_files = solc.receive_message()["params"]["changedFileCount"]
 
         for _ in range(0, num_files):
             message = solc.receive_message()
@@ -1343,14 +1343,12 @@ class SolidityLSPTestSuite: # {{{
                 ]
             }
         )
+        # The diagnostics of didOpen_with_import.sol did not change, so they are not sent again.
         published_diagnostics = self.wait_for_diagnostics(solc)
-        self.expect_equal(len(published_diagnostics), 2, "published diagnostics count")
-        report1 = published_diagnostics[0]
-        self.expect_equal(report1['uri'], self.get_test_file_uri('didOpen_with_import'), "Correct file URI")
-        self.expect_equal(len(report1['diagnostics']), 0, "no diagnostics in didOpen_with_import.sol")
-        report2 = published_diagnostics[1]
-        self.expect_equal(report2['uri'], self.get_test_file_uri('lib'), "Correct file URI")
-        self.expect_equal(len(report2['diagnostics']), 0, "no diagnostics in lib.sol")
+        self.expect_equal(len(published_diagnostics), 1, "published diagnostics count")
+        report = published_diagnostics[0]
+        self.expect_equal(report['uri'], self.get_test_file_uri('lib'), "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 0, "no diagnostics in lib.sol")
 
         # Now close the file and expect the warning to re-appear
         solc.send_message(
@@ -1359,7 +1357,11 @@ class SolidityLSPTestSuite: # {{{
         )
 
         published_diagnostics = self.wait_for_diagnostics(solc)
-        self.verify_didOpen_with_import_diagnostics(published_diagnostics)
+        self.expect_equal(len(published_diagnostics), 1, "published diagnostics count")
+        report = published_diagnostics[0]
+        self.expect_equal(report['uri'], self.get_test_file_uri('lib'), "Correct file URI")
+        self.expect_equal(len(report['diagnostics']), 1, "one diagnostic")
+        self.expect_diagnostic(report['diagnostics'][0], code=2072, marker=marker)
 
     def test_textDocument_opening_two_new_files_edit_and_close(self, solc: JsonRpcProcess) -> None:
         """
@@ -1396,10 +1398,11 @@ class SolidityLSPTestSuite: # {{{
                 ])
             }
         })
+        # Only the new file is reported, the diagnostics of a.sol did not change.
         reports = self.wait_for_diagnostics(solc)
-        self.expect_equal(len(reports), 2, "one publish diagnostics notification")
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal(reports[0]['uri'], FILE_B_URI, "Correct uri")
         self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
-        self.expect_equal(len(reports[1]['diagnostics']), 0, "should not contain diagnostics")
 
         solc.send_message('textDocument/didChange', {
             'textDocument': {
@@ -1415,10 +1418,9 @@ class SolidityLSPTestSuite: # {{{
                 }
             ]
         })
+        # Importing b.sol does not change any diagnostics, so nothing is sent.
         reports = self.wait_for_diagnostics(solc)
-        self.expect_equal(len(reports), 2, "one publish diagnostics notification")
-        self.expect_equal(len(reports[0]['diagnostics']), 0, "should not contain diagnostics")
-        self.expect_equal(len(reports[1]['diagnostics']), 0, "should not contain diagnostics")
+        self.expect_equal(len(reports), 0, "no publish diagnostics notification")
 
         solc.send_message(
             'textDocument/didClose',
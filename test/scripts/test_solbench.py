@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+
+from pathlib import Path
+import unittest
+
+# NOTE: This test file file only works with scripts/ added to PYTHONPATH so pylint can't find the imports
+# pragma pylint: disable=import-error
+from solbench import find_regressions, generate_large_contract, parse_project, BenchmarkError
+# pragma pylint: enable=import-error
+
+
+class TestFindRegressions(unittest.TestCase):
+    def test_should_report_time_and_memory_increases_above_threshold(self):
+        before = {'p': {'ir': {'compilation_time_ms': 1000, 'peak_rss_kib': 1000, 'phase_parsing_ms': 100}}}
+        after = {'p': {'ir': {'compilation_time_ms': 1200, 'peak_rss_kib': 1040, 'phase_parsing_ms': 120}}}
+
+        self.assertEqual(find_regressions(before, after, 0.05, 20), [
+            ('p', 'ir', 'compilation_time_ms', 1000, 1200),
+            ('p', 'ir', 'phase_parsing_ms', 100, 120),
+        ])
+
+    def test_should_ignore_improvements_sizes_and_short_timings(self):
+        before = {'p': {'legacy': {'compilation_time_ms': 1000, 'bytecode_size': 100, 'phase_parsing_ms': 5}}}
+        after = {'p': {'legacy': {'compilation_time_ms': 500, 'bytecode_size': 200, 'phase_parsing_ms': 15}}}
+
+        self.assertEqual(find_regressions(before, after, 0.05, 20), [])
+
+    def test_should_ignore_projects_and_presets_missing_from_one_report(self):
+        before = {'p': {'ir': {'compilation_time_ms': 100}}, 'q': {'ir': {'compilation_time_ms': 100}}}
+        after = {'p': {'legacy': {'compilation_time_ms': 900}}}
+
+        self.assertEqual(find_regressions(before, after, 0.05, 20), [])
+
+
+class TestGenerateLargeContract(unittest.TestCase):
+    def test_should_be_deterministic_and_contain_requested_number_of_functions(self):
+        source = generate_large_contract(10)
+
+        self.assertEqual(source, generate_large_contract(10))
+        self.assertEqual(source.count('    function f'), 10)
+        self.assertIn('contract Generated10 {', source)
+
+
+class TestParseProject(unittest.TestCase):
+    def test_should_split_name_and_directory(self):
+        self.assertEqual(parse_project('ens=/tmp/ens'), ('ens', Path('/tmp/ens')))
+
+    def test_should_reject_missing_directory(self):
+        with self.assertRaises(BenchmarkError):
+            parse_project('ens')
@@ -122,18 +122,22 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--evm-version=spuriousDragon",
 			"--via-ir",
 			"--experimental-via-ir",
+			"--jobs=4",
 			"--revert-strings=strip",
 			"--debug-info=location",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
 			"--error-codes",
+			"--max-warnings-per-source=20",
 			"--libraries="
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-optimized", "--ewasm", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
+			"--time-passes",
+			"--memory-profile",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
 				"srcmap,srcmap-runtime,function-debug,function-debug-runtime,hashes,devdoc,userdoc,ast",
@@ -142,6 +146,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--yul-optimizer-budget=1000",
+			"--dispatcher=binarySearch",
+			"--experimental-optimizations=controlFlowGraph",
+			"--optimize-inline-assembly-stack",
+			"--profile-optimizer",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
@@ -150,6 +159,10 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5",
+			"--model-checker-jobs=2",
+			"--model-checker-cache-dir=/tmp/smt-cache",
+			"--model-checker-slice-queries",
+			"--model-checker-solver-command=z3 -in",
 		};
 
 		if (inputMode == InputMode::CompilerWithASTImport)
@@ -186,6 +199,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		};
 		expectedOptions.formatting.coloredOutput = false;
 		expectedOptions.formatting.withErrorIds = true;
+		expectedOptions.formatting.maxWarningsPerSource = 20;
 		expectedOptions.compiler.outputs = {
 			true, true, true, true, true,
 			true, true, true, true, true,
@@ -194,6 +208,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		};
 		expectedOptions.compiler.outputs.ewasmIR = false;
 		expectedOptions.compiler.estimateGas = true;
+		expectedOptions.compiler.jobs = 4;
+		expectedOptions.compiler.timePasses = true;
+		expectedOptions.compiler.memoryProfile = true;
 		expectedOptions.compiler.combinedJsonRequests = {
 			true, true, true, true, true,
 			true, true, true, true, true,
@@ -205,6 +222,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.enabled = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.yulBudget = 1000;
+		expectedOptions.optimizer.dispatcher = FunctionDispatch::BinarySearch;
+		expectedOptions.optimizer.experimental = {ExperimentalOptimisation::ControlFlowGraph};
+		expectedOptions.optimizer.inlineAssemblyStack = true;
+		expectedOptions.optimizer.profile = true;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
@@ -216,7 +238,11 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			{false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			2,
+			"/tmp/smt-cache",
+			true,
 		};
+		expectedOptions.modelChecker.solverCommand = "z3 -in";
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
@@ -307,6 +333,8 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 				"--optimize",
 				"--optimize-runs=1000",
 				"--yul-optimizations=agf",
+				"--yul-optimizer-budget=1000",
+				"--profile-optimizer",
 			};
 
 		CommandLineOptions expectedOptions;
@@ -345,6 +373,8 @@ BOOST_AUTO_TEST_CASE(assembly_mode_options)
 		{
 			expectedOptions.optimizer.enabled = true;
 			expectedOptions.optimizer.yulSteps = "agf";
+			expectedOptions.optimizer.yulBudget = 1000;
+			expectedOptions.optimizer.profile = true;
 			expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		}
 
@@ -392,6 +422,7 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 			"underflow,"
 			"divByZero",
 		"--model-checker-timeout=5",       // Ignored in Standard JSON mode
+		"--cache-dir=/tmp/cache",
 	};
 
 	CommandLineOptions expectedOptions;
@@ -412,12 +443,37 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.compiler.combinedJsonRequests = CombinedJsonRequests{};
 	expectedOptions.compiler.combinedJsonRequests->abi = true;
 	expectedOptions.compiler.combinedJsonRequests->binary = true;
+	expectedOptions.compiler.cacheDir = "/tmp/cache";
 
 	CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(standard_json_server_mode_options)
+{
+	vector<string> commandLine = {
+		"solc",
+		"--server",
+		"--base-path=/home/user/",
+		"--allow-paths=/tmp",
+		"--cache-dir=/tmp/cache",
+	};
+
+	CommandLineOptions expectedOptions;
+
+	expectedOptions.input.mode = InputMode::StandardJsonServer;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.input.allowedDirectories = {"/tmp"};
+	expectedOptions.compiler.cacheDir = "/tmp/cache";
+
+	BOOST_TEST(parseCommandLine(commandLine) == expectedOptions);
+
+	string expectedMessage = "--server reads its requests from standard input and does not accept input files.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--server", "input.json"}), CommandLineValidationError, hasCorrectMessage);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
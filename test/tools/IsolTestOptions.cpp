@@ -70,7 +70,10 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(jobs), "Number of worker processes running test cases in parallel. Failures are reported without the interactive prompt when above one.")
+		("shard", po::value<std::string>(&shard), "Run only the given shard of the tests, as <zero-based index>/<number of shards>. Shorthand for --selected-batch and --batches.")
+		("gas-profile", po::value<fs::path>(&gasProfile), "Attribute the gas used by the semantic tests to source lines and functions and write it to the given file as folded stacks, e.g. for flamegraph.pl. Requires evmone.");
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -85,6 +88,19 @@ bool IsolTestOptions::parse(int _argc, char const* const* _argv)
 
 	enforceGasTest = enforceGasTest || (evmVersion() == langutil::EVMVersion{} && !useABIEncoderV1);
 
+	if (!shard.empty())
+	{
+		static std::regex const shardExpression{"([0-9]+)/([0-9]+)"};
+		std::smatch match;
+		assertThrow(
+			regex_match(shard, match, shardExpression),
+			ConfigException,
+			"Invalid shard - expected <index>/<count>: " + shard
+		);
+		selectedBatch = stoul(match[1]);
+		batches = stoul(match[2]);
+	}
+
 	return shouldContinue;
 }
 
@@ -98,6 +114,11 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "Number of jobs needs to be at least 1.");
+	assertThrow(gasProfile.empty() || jobs == 1, ConfigException, "Gas profiles can only be created without parallel jobs.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running tests in parallel is not supported on this platform.");
+#endif
 }
 
 }
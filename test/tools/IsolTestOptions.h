@@ -34,6 +34,10 @@ struct IsolTestOptions: CommonOptions
 	bool acceptUpdates = false;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
+	std::string shard = std::string{};
+	/// Number of worker processes running test cases concurrently. Values above one disable
+	/// the interactive prompts.
+	size_t jobs = 1;
 
 	explicit IsolTestOptions();
 	void addOptions() override;
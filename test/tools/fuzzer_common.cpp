@@ -139,13 +139,15 @@ void FuzzerUtil::runCompiler(string const& _input, bool _quiet)
 {
 	if (!_quiet)
 		cout << "Input JSON: " << _input << endl;
-	string outputString(solidity_compile(_input.c_str(), nullptr, nullptr));
+	// The context is kept for the whole fuzzing session, so that the compiler state that
+	// does not depend on the input is not rebuilt for every run.
+	static SolidityContext* context = solidity_context_create(nullptr, nullptr);
+	char* rawOutput = solidity_context_compile(context, _input.c_str());
+	string outputString(rawOutput);
+	solidity_free(rawOutput);
 	if (!_quiet)
 		cout << "Output JSON: " << outputString << endl;
 
-	// This should be safe given the above copies the output.
-	solidity_reset();
-
 	Json::Value output;
 	if (!jsonParseStrict(outputString, output))
 	{
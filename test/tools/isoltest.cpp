@@ -24,18 +24,28 @@
 #include <test/tools/IsolTestOptions.h>
 #include <test/InteractiveTests.h>
 #include <test/EVMHost.h>
+#include <test/ExecutionFramework.h>
+#include <test/GasProfiler.h>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/filesystem.hpp>
 
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <optional>
 #include <queue>
 #include <regex>
+#include <sstream>
 #include <utility>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -127,11 +137,39 @@ private:
 	{
 		Skip,
 		Rerun,
-		Quit
+		Quit,
+		Fail
 	};
 
+	/// @returns the test files below @a _path in the order they are run, skipping the ones
+	/// that do not belong to the selected batch.
+	static vector<fs::path> collectTests(
+		fs::path const& _basepath,
+		fs::path const& _path,
+		solidity::test::Batcher& _batcher,
+		int& _skippedCount
+	);
+	/// Runs a single test case, including the reruns requested after editing or updating it.
+	static TestStats processTest(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		fs::path const& _path,
+		bool _interactive
+	);
+#if !defined(_WIN32)
+	/// Distributes @a _tests over forked worker processes and prints their output in the
+	/// order of @a _tests once all workers are done.
+	static TestStats processTestsInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _tests
+	);
+#endif
+
 	void updateTestCase();
-	Request handleResponse(bool _exception);
+	Request handleResponse(bool _exception, bool _interactive);
 
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
@@ -222,13 +260,15 @@ void TestTool::updateTestCase()
 	m_test->printUpdatedExpectations(file, "// ");
 }
 
-TestTool::Request TestTool::handleResponse(bool _exception)
+TestTool::Request TestTool::handleResponse(bool _exception, bool _interactive)
 {
 	if (!_exception && m_options.acceptUpdates)
 	{
 		updateTestCase();
 		return Request::Rerun;
 	}
+	if (!_interactive)
+		return Request::Fail;
 
 	if (_exception)
 		cout << "(e)dit/(s)kip/(q)uit? ";
@@ -266,28 +306,25 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
+vector<fs::path> TestTool::collectTests(
 	fs::path const& _basepath,
 	fs::path const& _path,
-	solidity::test::Batcher& _batcher
+	solidity::test::Batcher& _batcher,
+	int& _skippedCount
 )
 {
+	vector<fs::path> tests;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -295,61 +332,186 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
-		{
-			++testCount;
-			paths.pop();
-		}
 		else if (!_batcher.checkAndAdvance())
+			++_skippedCount;
+		else
+			tests.push_back(currentPath);
+	}
+
+	return tests;
+}
+
+TestStats TestTool::processTest(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	bool _interactive
+)
+{
+	TestTool testTool(
+		_testCaseCreator,
+		_options,
+		_basepath / _path,
+		_path.generic_path().string()
+	);
+
+	while (true)
+	{
+		switch (auto result = testTool.process())
 		{
-			paths.pop();
-			++skippedCount;
+		case Result::Failure:
+		case Result::Exception:
+			switch (testTool.handleResponse(result == Result::Exception, _interactive))
+			{
+			case Request::Quit:
+				m_exitRequested = true;
+				return {0, 1, 0};
+			case Request::Rerun:
+				cout << "Re-running test case..." << endl;
+				break;
+			case Request::Skip:
+				return {0, 1, 1};
+			case Request::Fail:
+				return {0, 1, 0};
+			}
+			break;
+		case Result::Success:
+			return {1, 1, 0};
+		case Result::Skipped:
+			return {0, 1, 1};
 		}
-		else
+	}
+}
+
+#if !defined(_WIN32)
+TestStats TestTool::processTestsInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _tests
+)
+{
+	// Every worker writes one record per test case into its own temporary file:
+	// the index of the test, its statistics, the output it produced and the time it took.
+	struct Worker
+	{
+		pid_t pid = -1;
+		FILE* results = nullptr;
+	};
+	vector<Worker> workers(min(_options.jobs, _tests.size()));
+
+	cout.flush();
+	for (size_t workerIndex = 0; workerIndex < workers.size(); ++workerIndex)
+	{
+		Worker& worker = workers[workerIndex];
+		worker.results = tmpfile();
+		if (worker.results)
+			worker.pid = fork();
+		if (worker.pid == 0)
 		{
-			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			bool ok = true;
+			for (size_t i = workerIndex; i < _tests.size() && ok; i += workers.size())
+			{
+				ostringstream output;
+				auto* coutBuffer = cout.rdbuf(output.rdbuf());
+				auto const timeSpentBefore = solidity::test::ExecutionFramework::timeSpent();
+				TestStats stats = processTest(_testCaseCreator, _options, _basepath, _tests[i], false);
+				auto const& timeSpent = solidity::test::ExecutionFramework::timeSpent();
+				cout.rdbuf(coutBuffer);
+
+				string const text = output.str();
+				uint64_t const record[] = {
+					i,
+					static_cast<uint64_t>(stats.successCount),
+					static_cast<uint64_t>(stats.skippedCount),
+					text.size(),
+					static_cast<uint64_t>((timeSpent.compilation - timeSpentBefore.compilation).count()),
+					static_cast<uint64_t>((timeSpent.execution - timeSpentBefore.execution).count()),
+					timeSpent.reusedCompilations - timeSpentBefore.reusedCompilations
+				};
+				ok =
+					fwrite(record, sizeof(record), 1, worker.results) == 1 &&
+					fwrite(text.data(), 1, text.size(), worker.results) == text.size();
+			}
+			ok = fflush(worker.results) == 0 && ok;
+			_exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+	}
 
-			switch(result)
+	vector<optional<pair<TestStats, string>>> results(_tests.size());
+	for (Worker& worker: workers)
+	{
+		if (worker.pid > 0)
+		{
+			int status = 0;
+			waitpid(worker.pid, &status, 0);
+			rewind(worker.results);
+			uint64_t record[7];
+			while (fread(record, sizeof(record), 1, worker.results) == 1 && record[0] < results.size())
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
+				string text(record[3], '\0');
+				if (fread(text.data(), 1, text.size(), worker.results) != text.size())
 					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
-				}
-				break;
-			case Result::Success:
-				paths.pop();
-				++successCount;
-				break;
-			case Result::Skipped:
-				paths.pop();
-				++skippedCount;
-				break;
+				auto& timeSpent = solidity::test::ExecutionFramework::timeSpent();
+				timeSpent.compilation += chrono::steady_clock::duration(record[4]);
+				timeSpent.execution += chrono::steady_clock::duration(record[5]);
+				timeSpent.reusedCompilations += record[6];
+				results[record[0]] = {
+					TestStats{static_cast<int>(record[1]), 1, static_cast<int>(record[2])},
+					move(text)
+				};
 			}
 		}
+		if (worker.results)
+			fclose(worker.results);
+	}
+
+	TestStats stats;
+	bool formatted{!_options.noColor};
+	for (size_t i = 0; i < _tests.size(); ++i)
+		if (results[i])
+		{
+			cout << results[i]->second;
+			stats += results[i]->first;
+		}
+		else
+		{
+			// The worker died or could not be started, so the test case counts as failed.
+			AnsiColorized(cout, formatted, {BOLD}) << _tests[i].generic_path().string() << ": ";
+			AnsiColorized(cout, formatted, {BOLD, RED}) << "worker process failed" << endl;
+			++stats.testCount;
+		}
+	return stats;
+}
+#endif
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path,
+	solidity::test::Batcher& _batcher
+)
+{
+	TestStats stats;
+	vector<fs::path> tests = collectTests(_basepath, _path, _batcher, stats.skippedCount);
+
+#if !defined(_WIN32)
+	if (_options.jobs > 1 && !m_exitRequested)
+	{
+		stats += processTestsInParallel(_testCaseCreator, _options, _basepath, tests);
+		return stats;
 	}
+#endif
 
-	return { successCount, testCount, skippedCount };
+	for (fs::path const& test: tests)
+		if (m_exitRequested)
+			++stats.testCount;
+		else
+			stats += processTest(_testCaseCreator, _options, _basepath, test, true);
 
+	return stats;
 }
 
 namespace
@@ -495,6 +657,20 @@ int main(int argc, char const *argv[])
 		}
 		cout << "." << endl;
 
+		auto const& timeSpent = solidity::test::ExecutionFramework::timeSpent();
+		if (timeSpent.compilation.count() > 0 || timeSpent.execution.count() > 0)
+			cout <<
+				"Time spent compiling: " << chrono::duration<double>(timeSpent.compilation).count() << "s" <<
+				" (" << timeSpent.reusedCompilations << " compilations reused)" <<
+				", executing: " << chrono::duration<double>(timeSpent.execution).count() << "s." << endl;
+
+		if (!options.gasProfile.empty())
+		{
+			ofstream gasProfile(options.gasProfile.string());
+			solidity::test::ExecutionFramework::gasProfiler().writeFoldedStacks(gasProfile);
+			cout << "Gas profile written to " << options.gasProfile.string() << "." << endl;
+		}
+
 		if (options.disableSemanticTests)
 			cout << "\nNOTE: Skipped semantics tests.\n" << endl;
 
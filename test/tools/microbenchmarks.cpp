@@ -0,0 +1,415 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmarks of individual compiler components on fixed inputs.
+ */
+
+#include <libsolidity/interface/OptimiserSettings.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <libyul/YulStack.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libevmasm/Assembly.h>
+#include <libevmasm/PeepholeOptimiser.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Whiskers.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/**
+ * A benchmark calls @a prepare (untimed) and then @a run (timed) repeatedly.
+ * @a run performs @a batch operations, so that very short operations are not dominated
+ * by the overhead of reading the clock. Reported times are per operation.
+ */
+struct Benchmark
+{
+	string name;
+	function<void()> prepare;
+	function<void()> run;
+	size_t batch = 1;
+};
+
+struct BenchmarkResult
+{
+	size_t iterations = 0;
+	double medianNs = 0;
+	double minNs = 0;
+};
+
+string readYulInput(fs::path const& _path)
+{
+	string source = readFileAsString(_path);
+	size_t expectationsStart = source.find("// ----");
+	if (expectationsStart != string::npos)
+		source.resize(expectationsStart);
+	return source;
+}
+
+shared_ptr<Object> parseYul(string const& _name, string const& _source)
+{
+	YulStack stack(
+		EVMVersion{},
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::Default()
+	);
+	if (!stack.parseAndAnalyze(_name, _source))
+		BOOST_THROW_EXCEPTION(runtime_error("Could not parse " + _name + "."));
+	return stack.parserResult();
+}
+
+shared_ptr<evmasm::Assembly> assembleYul(string const& _name, string const& _source)
+{
+	YulStack stack(
+		EVMVersion{},
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::standard(),
+		DebugInfoSelection::Default()
+	);
+	if (!stack.parseAndAnalyze(_name, _source))
+		BOOST_THROW_EXCEPTION(runtime_error("Could not parse " + _name + "."));
+	stack.optimize();
+	return stack.assembleEVMWithDeployed().first;
+}
+
+void addOptimiserBenchmarks(vector<Benchmark>& _benchmarks, string const& _inputName, string const& _source)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+	size_t const expectedExecutions = OptimiserSettings::standard().expectedExecutionsPerDeployment;
+	shared_ptr<Object> object = parseYul(_inputName, _source);
+
+	// Bring the code into the shape every step can rely on, like the optimiser suite does.
+	auto prepared = make_shared<yul::Block>(get<yul::Block>(Disambiguator(dialect, *object->analysisInfo)(*object->code)));
+	{
+		NameDispenser dispenser{dialect, *prepared, {}};
+		set<YulString> reserved;
+		OptimiserStepContext context{dialect, dispenser, reserved, expectedExecutions};
+		OptimiserSuite{context}.runSequence("hgfo", *prepared);
+	}
+
+	for (auto const& [stepName, step]: OptimiserSuite::allSteps())
+	{
+		struct State
+		{
+			shared_ptr<yul::Block> ast;
+			unique_ptr<NameDispenser> dispenser;
+			set<YulString> reserved;
+		};
+		auto state = make_shared<State>();
+		_benchmarks.push_back({
+			"optimiser/" + stepName + "/" + _inputName,
+			[=, &dialect]() {
+				state->ast = make_shared<yul::Block>(get<yul::Block>(ASTCopier{}(*prepared)));
+				state->dispenser = make_unique<NameDispenser>(dialect, *state->ast, state->reserved);
+			},
+			[=, &dialect, stepName = stepName]() {
+				OptimiserStepContext context{dialect, *state->dispenser, state->reserved, expectedExecutions};
+				OptimiserSuite{context}.runSequence(vector<string>{stepName}, *state->ast);
+			}
+		});
+	}
+}
+
+vector<Benchmark> createBenchmarks(fs::path const& _testPath)
+{
+	vector<Benchmark> benchmarks;
+
+	for (string name: {"abi2", "abi_example1", "aztec"})
+	{
+		fs::path path = _testPath / "libyul/yulOptimizerTests/fullSuite" / (name + ".yul");
+		string source = readYulInput(path);
+		addOptimiserBenchmarks(benchmarks, name, source);
+
+		Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+		shared_ptr<Object> object = parseYul(name, source);
+		shared_ptr<CFG> cfg = ControlFlowGraphBuilder::build(*object->analysisInfo, dialect, *object->code);
+		benchmarks.push_back({"StackLayoutGenerator::run/" + name, {}, [=]() { StackLayoutGenerator::run(*cfg); }});
+
+		shared_ptr<evmasm::Assembly> assembly = assembleYul(name, source);
+		auto assemblyCopy = make_shared<shared_ptr<evmasm::Assembly>>();
+		benchmarks.push_back({
+			"Assembly::assemble/" + name,
+			[=]() { *assemblyCopy = make_shared<evmasm::Assembly>(*assembly); },
+			[=]() { (*assemblyCopy)->assemble(); }
+		});
+
+		auto items = make_shared<evmasm::AssemblyItems>();
+		benchmarks.push_back({
+			"PeepholeOptimiser/" + name,
+			[=]() { *items = assembly->items(); },
+			[=]() { evmasm::PeepholeOptimiser{*items}.optimise(); }
+		});
+	}
+
+	for (string name: {"provider", "schelling", "token"})
+	{
+		string source = readFileAsString(_testPath / "compilationTests/corion" / (name + ".sol"));
+
+		auto charStream = make_shared<CharStream>();
+		benchmarks.push_back({
+			"Scanner/" + name,
+			[=]() { *charStream = CharStream(source, name); },
+			[=]() {
+				Scanner scanner(*charStream);
+				while (scanner.next() != Token::EOS)
+				{}
+			}
+		});
+
+		auto ast = make_shared<ASTPointer<SourceUnit>>();
+		benchmarks.push_back({
+			"Parser::parse/" + name,
+			[=]() {
+				ast->reset();
+				*charStream = CharStream(source, name);
+			},
+			[=]() {
+				ErrorList errors;
+				ErrorReporter errorReporter(errors);
+				*ast = frontend::Parser(errorReporter, EVMVersion{}).parse(*charStream);
+			}
+		});
+	}
+
+	for (size_t size: {32, 1024, 65536})
+	{
+		bytes input(size, 0xab);
+		size_t batch = max<size_t>(1, 65536 / size);
+		benchmarks.push_back({
+			"keccak256/" + to_string(size),
+			{},
+			[=]() {
+				for (size_t i = 0; i < batch; ++i)
+					keccak256(input);
+			},
+			batch
+		});
+	}
+
+	Whiskers::StringListMap::mapped_type members;
+	for (size_t i = 0; i < 50; ++i)
+		members.push_back({{"index", to_string(i)}, {"offset", to_string(i * 32)}, {"type", "uint256"}});
+	auto whiskers = make_shared<Whiskers>(R"(
+		function <functionName>(headStart, value) -> tail {
+			tail := add(headStart, <size>)
+			<#members>
+			// <type> member <index>
+			mstore(add(headStart, <offset>), cleanup_<type>(mload(add(value, <offset>))))
+			</members>
+			<?dynamic>tail := abi_encode_dynamic(tail, value)</dynamic>
+		}
+	)");
+	(*whiskers)("functionName", "abi_encode_struct")("size", "1600")("members", members)("dynamic", true);
+	benchmarks.push_back({"Whiskers::render", {}, [=]() { whiskers->render(); }, 10});
+
+	return benchmarks;
+}
+
+BenchmarkResult runBenchmark(Benchmark const& _benchmark, chrono::duration<double> _minTime)
+{
+	using clock = chrono::steady_clock;
+	size_t const minIterations = 3;
+	size_t const maxIterations = 1000000;
+
+	// Warm-up run, not recorded.
+	if (_benchmark.prepare)
+		_benchmark.prepare();
+	_benchmark.run();
+
+	vector<double> times;
+	clock::duration total{};
+	while (times.size() < maxIterations && (times.size() < minIterations || total < _minTime))
+	{
+		if (_benchmark.prepare)
+			_benchmark.prepare();
+		auto start = clock::now();
+		_benchmark.run();
+		clock::duration elapsed = clock::now() - start;
+		total += elapsed;
+		times.push_back(double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / double(_benchmark.batch));
+	}
+
+	sort(times.begin(), times.end());
+	return {times.size(), times[times.size() / 2], times.front()};
+}
+
+string formatTime(double _ns)
+{
+	ostringstream output;
+	output << fixed << setprecision(2);
+	if (_ns >= 1e9)
+		output << _ns / 1e9 << " s";
+	else if (_ns >= 1e6)
+		output << _ns / 1e6 << " ms";
+	else if (_ns >= 1e3)
+		output << _ns / 1e3 << " us";
+	else
+		output << _ns << " ns";
+	return output.str();
+}
+
+}
+
+int main(int argc, char const* argv[])
+{
+	po::options_description options(
+		R"(Microbenchmarks of individual compiler components.
+Usage: solmicrobench [Options]
+Runs every benchmark whose name matches the filter and prints the median time per operation.
+Save the results of one build with --json and pass them to --compare when running another
+build to see the relative difference.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("help", "Show this help screen.")
+		("list", "Only list the names of the benchmarks.")
+		("filter", po::value<string>()->default_value(".*"), "Regular expression selecting the benchmarks to run.")
+		("min-time", po::value<double>()->default_value(0.2), "Minimum time in seconds to spend in each benchmark.")
+		("testpath", po::value<string>()->default_value("test"), "Path to the test directory containing the inputs.")
+		("json", po::value<string>(), "Write the results as JSON to the given file.")
+		("compare", po::value<string>(), "JSON file with results of a previous run to compare against.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	vector<Benchmark> benchmarks;
+	try
+	{
+		benchmarks = createBenchmarks(fs::path(arguments["testpath"].as<string>()));
+	}
+	catch (...)
+	{
+		cerr << "Could not load the benchmark inputs:" << endl;
+		cerr << boost::current_exception_diagnostic_information() << endl;
+		return 1;
+	}
+
+	Json::Value baseline{Json::objectValue};
+	if (arguments.count("compare"))
+		if (!jsonParseStrict(readFileAsString(arguments["compare"].as<string>()), baseline) || !baseline.isObject())
+		{
+			cerr << "Invalid JSON in " << arguments["compare"].as<string>() << "." << endl;
+			return 1;
+		}
+
+	regex filter(arguments["filter"].as<string>());
+	chrono::duration<double> minTime(arguments["min-time"].as<double>());
+	Json::Value results{Json::objectValue};
+	bool failed = false;
+	for (Benchmark const& benchmark: benchmarks)
+	{
+		if (!regex_search(benchmark.name, filter))
+			continue;
+		if (arguments.count("list"))
+		{
+			cout << benchmark.name << endl;
+			continue;
+		}
+
+		cout << setw(60) << left << benchmark.name << flush;
+		try
+		{
+			BenchmarkResult result = runBenchmark(benchmark, minTime);
+			cout << setw(12) << right << formatTime(result.medianNs);
+			cout << setw(12) << right << formatTime(result.minNs);
+			cout << setw(10) << right << result.iterations;
+			if (baseline.isMember(benchmark.name))
+			{
+				double previous = baseline[benchmark.name]["medianNs"].asDouble();
+				cout << "  " << showpos << fixed << setprecision(1) << (result.medianNs / previous - 1) * 100 << "%" << noshowpos;
+			}
+			cout << endl;
+
+			Json::Value entry{Json::objectValue};
+			entry["medianNs"] = result.medianNs;
+			entry["minNs"] = result.minNs;
+			entry["iterations"] = Json::UInt64(result.iterations);
+			results[benchmark.name] = move(entry);
+		}
+		catch (...)
+		{
+			cout << "  failed" << endl;
+			cerr << boost::current_exception_diagnostic_information() << endl;
+			failed = true;
+		}
+	}
+
+	if (arguments.count("json"))
+		ofstream(arguments["json"].as<string>()) << jsonPrettyPrint(results) << endl;
+
+	return failed ? 1 : 0;
+}
@@ -34,7 +34,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	if (_size > 600)
 		return 0;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(YulStringRepository::MaxRetainedStrings);
 
 	string input(reinterpret_cast<char const*>(_data), _size);
 	YulStack stack(
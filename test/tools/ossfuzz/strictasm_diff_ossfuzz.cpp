@@ -58,7 +58,7 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
 	}))
 		return 0;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(YulStringRepository::MaxRetainedStrings);
 
 	YulStack stack(
 		langutil::EVMVersion(),
@@ -59,7 +59,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	if (yul_source.size() > 1200)
 		return;
 
-	YulStringRepository::reset();
+	YulStringRepository::resetIfLargerThan(YulStringRepository::MaxRetainedStrings);
 
 	// YulStack entry point
 	YulStack stack(
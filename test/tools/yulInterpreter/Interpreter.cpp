@@ -48,6 +48,12 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t& PagedMemory::operator[](u256 const& _offset)
+{
+	auto it = m_pages.try_emplace(_offset - _offset % pageSize).first;
+	return it->second[static_cast<size_t>(_offset % pageSize)];
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
 	for (auto const& slot: storage)
@@ -63,12 +69,14 @@ void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+		static_assert(PagedMemory::pageSize % 0x20 == 0);
+		for (auto const& [pageOffset, page]: memory.pages())
+			for (size_t wordOffset = 0; wordOffset < PagedMemory::pageSize; wordOffset += 0x20)
+			{
+				h256 word(bytes(page.begin() + wordOffset, page.begin() + wordOffset + 0x20));
+				if (word != h256{})
+					_out << "  " << std::uppercase << std::hex << std::setw(4) << u256(pageOffset + wordOffset) << ": " << word.hex() << endl;
+			}
 	}
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
@@ -278,27 +286,31 @@ void ExpressionEvaluator::operator()(Identifier const& _identifier)
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
 	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
+	BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name);
+	if (builtin && !builtin->literalArguments.empty())
+		literalArguments = &builtin->literalArguments;
 	evaluateArgs(_funCall.arguments, literalArguments);
 
-	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+	if (builtin)
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
+		if (dynamic_cast<EVMDialect const*>(&m_dialect))
 		{
+			// EVMDialect::builtin only returns builtins for EVM.
 			EVMInstructionInterpreter interpreter(m_state, m_disableMemoryTrace);
-			setValue(interpreter.evalBuiltin(*fun, _funCall.arguments, values()));
+			setValue(interpreter.evalBuiltin(
+				static_cast<BuiltinFunctionForEVM const&>(*builtin),
+				_funCall.arguments,
+				values()
+			));
 			return;
 		}
-	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
+		else if (dynamic_cast<WasmDialect const*>(&m_dialect))
 		{
 			EwasmBuiltinInterpreter interpreter(m_state);
 			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
 			return;
 		}
+	}
 
 	Scope* scope = &m_scope;
 	for (; scope; scope = scope->parent)
@@ -309,7 +321,7 @@ void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
 	yulAssert(fun, "Function not found.");
 	yulAssert(m_values.size() == fun->parameters.size(), "");
-	map<YulString, u256> variables;
+	unordered_map<YulString, u256> variables;
 	for (size_t i = 0; i < fun->parameters.size(); ++i)
 		variables[fun->parameters.at(i).name] = m_values.at(i);
 	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
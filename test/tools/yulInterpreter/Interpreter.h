@@ -29,7 +29,9 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,11 +69,30 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Byte-addressable memory that allocates zero-initialised pages on first access,
+ * instead of a tree node per byte.
+ */
+class PagedMemory
+{
+public:
+	static constexpr size_t pageSize = 1024;
+	using Page = std::array<uint8_t, pageSize>;
+
+	uint8_t& operator[](u256 const& _offset);
+
+	/// @returns the allocated pages, keyed by the offset of their first byte.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	std::map<u256, Page> m_pages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	PagedMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
@@ -143,7 +164,7 @@ public:
 		Dialect const& _dialect,
 		Scope& _scope,
 		bool _disableMemoryTracing,
-		std::map<YulString, u256> _variables = {}
+		std::unordered_map<YulString, u256> _variables = {}
 	):
 		m_dialect(_dialect),
 		m_state(_state),
@@ -185,7 +206,7 @@ private:
 	Dialect const& m_dialect;
 	InterpreterState& m_state;
 	/// Values of variables.
-	std::map<YulString, u256> m_variables;
+	std::unordered_map<YulString, u256> m_variables;
 	Scope* m_scope;
 	bool m_disableMemoryTrace;
 };
@@ -200,7 +221,7 @@ public:
 		InterpreterState& _state,
 		Dialect const& _dialect,
 		Scope& _scope,
-		std::map<YulString, u256> const& _variables,
+		std::unordered_map<YulString, u256> const& _variables,
 		bool _disableMemoryTrace
 	):
 		m_state(_state),
@@ -237,7 +258,7 @@ private:
 	InterpreterState& m_state;
 	Dialect const& m_dialect;
 	/// Values of variables.
-	std::map<YulString, u256> const& m_variables;
+	std::unordered_map<YulString, u256> const& m_variables;
 	Scope& m_scope;
 	/// Current value of the expression
 	std::vector<u256> m_values;
@@ -19,8 +19,11 @@
  * Interactive yul optimizer
  */
 
+#include <test/tools/yulInterpreter/Interpreter.h>
+
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/Parallel.h>
 #include <libsolutil/StringUtils.h>
 #include <liblangutil/ErrorReporter.h>
 #include <libyul/AsmAnalysis.h>
@@ -33,12 +36,16 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 
+#include <libyul/backends/evm/ControlFlowGasEstimator.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolutil/JSON.h>
@@ -48,6 +55,8 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
 #include <range/v3/action/sort.hpp>
@@ -60,6 +69,8 @@
 #include <range/v3/view/transform.hpp>
 
 #include <cctype>
+#include <chrono>
+#include <fstream>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -73,14 +84,17 @@ using namespace solidity::frontend;
 using namespace solidity::yul;
 
 namespace po = boost::program_options;
+namespace fs = boost::filesystem;
 
 class YulOpti
 {
 public:
-	static void printErrors(CharStream const& _charStream, ErrorList const& _errors)
+	explicit YulOpti(ostream& _errorOutput = cerr): m_errorOutput(_errorOutput) {}
+
+	void printErrors(CharStream const& _charStream, ErrorList const& _errors) const
 	{
 		SourceReferenceFormatter{
-			cerr,
+			m_errorOutput,
 			SingletonCharStreamProvider(_charStream),
 			true,
 			false
@@ -97,7 +111,7 @@ public:
 			m_ast = yul::Parser(errorReporter, m_dialect).parse(_charStream);
 			if (!m_ast || !errorReporter.errors().empty())
 			{
-				cerr << "Error parsing source." << endl;
+				m_errorOutput << "Error parsing source." << endl;
 				printErrors(_charStream, errors);
 				throw std::runtime_error("Could not parse source.");
 			}
@@ -109,14 +123,14 @@ public:
 			);
 			if (!analyzer.analyze(*m_ast) || !errorReporter.errors().empty())
 			{
-				cerr << "Error analyzing source." << endl;
+				m_errorOutput << "Error analyzing source." << endl;
 				printErrors(_charStream, errors);
 				throw std::runtime_error("Could not analyze source.");
 			}
 		}
 		catch(...)
 		{
-			cerr << "Fatal error during parsing: " << endl;
+			m_errorOutput << "Fatal error during parsing: " << endl;
 			printErrors(_charStream, errors);
 			throw;
 		}
@@ -178,12 +192,23 @@ public:
 		m_nameDispenser.reset(*m_ast);
 	}
 
-	void runSteps(string _source, string _steps)
+	void optimise(string_view _steps)
+	{
+		OptimiserSuite{m_context}.runSequence(_steps, *m_ast);
+	}
+
+	void runSteps(string _source, string _steps, bool _profile)
 	{
 		parse(_source);
 		disambiguate();
-		OptimiserSuite{m_context}.runSequence(_steps, *m_ast);
+		OptimiserProfile profile;
+		if (_profile)
+			OptimiserSuite{m_context, OptimiserSuite::Debug::Profile, &profile}.runSequence(_steps, *m_ast);
+		else
+			optimise(_steps);
 		cout << AsmPrinter{m_dialect}(*m_ast) << endl;
+		if (_profile)
+			cerr << profile.toString();
 	}
 
 	void runInteractive(string _source, bool _disambiguated = false)
@@ -243,9 +268,13 @@ public:
 		}
 	}
 
+	shared_ptr<yul::Block> const& ast() const { return m_ast; }
+	EVMDialect const& dialect() const { return m_dialect; }
+
 private:
+	ostream& m_errorOutput;
 	shared_ptr<yul::Block> m_ast;
-	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
+	EVMDialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	unique_ptr<AsmAnalysisInfo> m_analysisInfo;
 	set<YulString> const m_reservedIdentifiers = {};
 	NameDispenser m_nameDispenser{m_dialect, m_reservedIdentifiers};
@@ -257,11 +286,253 @@ private:
 	};
 };
 
+namespace
+{
+
+/// Settings of the batch mode, which optimises every source of a corpus and compares
+/// the code before and after optimisation.
+struct BatchSettings
+{
+	string steps;
+	size_t maxSteps = 0;
+	size_t jobs = 1;
+};
+
+/// Result of interpreting a piece of code on one input.
+struct Execution
+{
+	/// Trace of the side-effects and final storage.
+	string output;
+	size_t steps = 0;
+	/// True if the execution was stopped because it exceeded a limit of the interpreter.
+	bool limitReached = false;
+};
+
+/// @returns the sources of the corpus @a _corpus, which is either a directory that is searched
+/// recursively for ``.yul`` files or a manifest that lists one file per line relative to itself.
+vector<fs::path> batchSources(fs::path const& _corpus)
+{
+	vector<fs::path> sources;
+	if (fs::is_directory(_corpus))
+	{
+		for (fs::directory_entry const& entry: fs::recursive_directory_iterator(_corpus))
+			if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".yul")
+				sources.push_back(entry.path());
+		sort(sources.begin(), sources.end());
+	}
+	else
+	{
+		istringstream manifest(readFileAsString(_corpus));
+		string line;
+		while (getline(manifest, line))
+		{
+			boost::trim(line);
+			if (!line.empty() && line.front() != '#')
+				sources.push_back(_corpus.parent_path() / line);
+		}
+	}
+	return sources;
+}
+
+/// @returns the call data to run the source @a _source with, which is read from the file
+/// with the extension ``.inputs`` next to it, one hex string per line. If there is no
+/// such file, the source is run once without call data.
+vector<bytes> batchInputs(fs::path const& _source)
+{
+	fs::path inputsFile = fs::path(_source).replace_extension(".inputs");
+	if (!fs::exists(inputsFile))
+		return {bytes{}};
+
+	vector<bytes> inputs;
+	istringstream inputsStream(readFileAsString(inputsFile));
+	string line;
+	while (getline(inputsStream, line))
+	{
+		boost::trim(line);
+		if (line.empty() || line.front() == '#')
+			continue;
+		inputs.emplace_back(fromHex(line, WhenError::Throw));
+	}
+	return inputs;
+}
+
+Execution interpret(Dialect const& _dialect, yul::Block const& _ast, bytes const& _calldata, size_t _maxSteps)
+{
+	yul::test::InterpreterState state;
+	state.calldata = _calldata;
+	state.maxSteps = _maxSteps;
+	state.maxTraceSize = 10000;
+
+	Execution execution;
+	try
+	{
+		yul::test::Interpreter::run(state, _dialect, _ast, /*disableMemoryTracing=*/true);
+	}
+	catch (yul::test::ExplicitlyTerminated const&)
+	{
+	}
+	catch (yul::test::InterpreterTerminatedGeneric const&)
+	{
+		execution.limitReached = true;
+	}
+
+	// Memory is not compared, since the optimiser is free to remove writes that are never read.
+	ostringstream output;
+	state.dumpTraceAndState(output, /*disableMemoryTrace=*/true);
+	execution.output = output.str();
+	execution.steps = state.numSteps;
+	return execution;
+}
+
+/// @returns the typical gas costs of @a _ast according to the static estimate of its control flow graph.
+bigint gasEstimate(EVMDialect const& _dialect, shared_ptr<yul::Block> const& _ast)
+{
+	Object object;
+	object.code = _ast;
+	AsmAnalysisInfo analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, object);
+	unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_ast);
+	return ControlFlowGasEstimator(*cfg, _dialect).run().typical;
+}
+
+Json::Value beforeAfter(Json::Value _before, Json::Value _after)
+{
+	Json::Value result(Json::objectValue);
+	result["before"] = move(_before);
+	result["after"] = move(_after);
+	return result;
+}
+
+/// Optimises the source @a _source and compares the code before and after optimisation.
+Json::Value runBatchItem(fs::path const& _source, BatchSettings const& _settings)
+{
+	Json::Value result(Json::objectValue);
+	result["file"] = _source.string();
+
+	ostringstream errors;
+	try
+	{
+		vector<bytes> inputs = batchInputs(_source);
+		YulOpti yulOpti(errors);
+		yulOpti.parse(readFileAsString(_source));
+		yulOpti.disambiguate();
+
+		size_t sizeBefore = CodeSize::codeSizeIncludingFunctions(*yulOpti.ast());
+		bigint gasBefore = gasEstimate(yulOpti.dialect(), yulOpti.ast());
+		vector<Execution> executionsBefore;
+		for (bytes const& input: inputs)
+			executionsBefore.emplace_back(interpret(yulOpti.dialect(), *yulOpti.ast(), input, _settings.maxSteps));
+
+		auto start = chrono::steady_clock::now();
+		yulOpti.optimise(_settings.steps);
+		chrono::duration<double, milli> duration = chrono::steady_clock::now() - start;
+
+		size_t sizeAfter = CodeSize::codeSizeIncludingFunctions(*yulOpti.ast());
+		bigint gasAfter = gasEstimate(yulOpti.dialect(), yulOpti.ast());
+		size_t stepsBefore = 0;
+		size_t stepsAfter = 0;
+		bool inconclusive = false;
+		Json::Value mismatches(Json::arrayValue);
+		for (size_t index = 0; index < inputs.size(); ++index)
+		{
+			Execution executionAfter = interpret(yulOpti.dialect(), *yulOpti.ast(), inputs[index], _settings.maxSteps);
+			stepsBefore += executionsBefore[index].steps;
+			stepsAfter += executionAfter.steps;
+			// The optimiser changes the number of steps, so the traces are incomparable if a limit was hit.
+			if (executionsBefore[index].limitReached || executionAfter.limitReached)
+				inconclusive = true;
+			else if (executionsBefore[index].output != executionAfter.output)
+				mismatches.append(Json::UInt64(index));
+		}
+
+		result["codeSize"] = beforeAfter(Json::UInt64(sizeBefore), Json::UInt64(sizeAfter));
+		result["gas"] = beforeAfter(toString(gasBefore), toString(gasAfter));
+		result["interpreterSteps"] = beforeAfter(Json::UInt64(stepsBefore), Json::UInt64(stepsAfter));
+		result["optimisationTimeMs"] = duration.count();
+		result["inputs"] = Json::UInt64(inputs.size());
+		if (!mismatches.empty())
+		{
+			result["equivalent"] = false;
+			result["mismatchingInputs"] = mismatches;
+		}
+		else if (!inconclusive)
+			result["equivalent"] = true;
+	}
+	catch (...)
+	{
+		result["error"] = errors.str() + boost::current_exception_diagnostic_information();
+	}
+	return result;
+}
+
+/// Runs the batch mode on all sources of @a _corpus and prints the results as JSON.
+/// @returns false if a source could not be optimised or behaves differently after optimisation.
+bool runBatch(fs::path const& _corpus, BatchSettings const& _settings)
+{
+	OptimiserSuite::validateSequence(_settings.steps);
+	vector<fs::path> sources = batchSources(_corpus);
+
+	auto start = chrono::steady_clock::now();
+	vector<Json::Value> results(sources.size());
+	parallelFor(sources.size(), _settings.jobs, [&](size_t _index) {
+		results[_index] = runBatchItem(sources[_index], _settings);
+	});
+	chrono::duration<double, milli> wallTime = chrono::steady_clock::now() - start;
+
+	size_t errors = 0;
+	size_t mismatches = 0;
+	size_t inconclusive = 0;
+	size_t sizeBefore = 0;
+	size_t sizeAfter = 0;
+	bigint gasBefore = 0;
+	bigint gasAfter = 0;
+	double optimisationTime = 0;
+	Json::Value files(Json::arrayValue);
+	for (Json::Value& result: results)
+	{
+		if (result.isMember("error"))
+			++errors;
+		else
+		{
+			if (!result.isMember("equivalent"))
+				++inconclusive;
+			else if (!result["equivalent"].asBool())
+				++mismatches;
+			sizeBefore += result["codeSize"]["before"].asUInt64();
+			sizeAfter += result["codeSize"]["after"].asUInt64();
+			gasBefore += bigint(result["gas"]["before"].asString());
+			gasAfter += bigint(result["gas"]["after"].asString());
+			optimisationTime += result["optimisationTimeMs"].asDouble();
+		}
+		files.append(move(result));
+	}
+
+	Json::Value summary(Json::objectValue);
+	summary["files"] = Json::UInt64(sources.size());
+	summary["errors"] = Json::UInt64(errors);
+	summary["mismatches"] = Json::UInt64(mismatches);
+	summary["inconclusive"] = Json::UInt64(inconclusive);
+	summary["codeSize"] = beforeAfter(Json::UInt64(sizeBefore), Json::UInt64(sizeAfter));
+	summary["gas"] = beforeAfter(toString(gasBefore), toString(gasAfter));
+	summary["optimisationTimeMs"] = optimisationTime;
+	summary["wallTimeMs"] = wallTime.count();
+
+	Json::Value output(Json::objectValue);
+	output["summary"] = move(summary);
+	output["files"] = move(files);
+	cout << jsonPrettyPrint(output) << endl;
+	return errors == 0 && mismatches == 0;
+}
+
+}
+
 int main(int argc, char** argv)
 {
 	try
 	{
 		bool nonInteractive = false;
+		bool profile = false;
+		size_t jobs = 0;
+		size_t maxSteps = 0;
 		po::options_description options(
 			R"(yulopti, yul optimizer exploration tool.
 	Usage: yulopti [Options] <file>
@@ -269,6 +540,11 @@ int main(int argc, char** argv)
 	interactively read from stdin.
 	In non-interactive mode a list of steps has to be provided.
 	If <file> is -, yul code is read from stdin and run non-interactively.
+	In batch mode, the steps are applied to every source of a corpus in parallel.
+	Each source is run by the interpreter before and after optimisation on the call data
+	in the file with the extension .inputs next to it (one hex string per line), if present.
+	The code size, gas estimate, interpreter steps, optimisation time and whether the
+	traces are equal are printed as JSON.
 
 	Allowed options)",
 			po::options_description::m_default_line_length,
@@ -289,6 +565,26 @@ int main(int argc, char** argv)
 				po::bool_switch(&nonInteractive)->default_value(false),
 				"stop after executing the provided steps"
 			)
+			(
+				"profile",
+				po::bool_switch(&profile)->default_value(false),
+				"print statistics about the provided steps to stderr"
+			)
+			(
+				"batch",
+				po::value<string>()->value_name("path"),
+				"run the provided steps on all .yul files in the given directory or listed in the given manifest"
+			)
+			(
+				"jobs,j",
+				po::value<size_t>(&jobs)->default_value(0),
+				"number of sources to optimise in parallel in batch mode (0 means one per hardware thread)"
+			)
+			(
+				"max-steps",
+				po::value<size_t>(&maxSteps)->default_value(100000),
+				"maximum number of interpreter steps per input in batch mode"
+			)
 			("help,h", "Show this help screen.");
 
 		// All positional options should be interpreted as input files
@@ -307,6 +603,20 @@ int main(int argc, char** argv)
 			return 0;
 		}
 
+		if (arguments.count("batch"))
+		{
+			if (!arguments.count("steps"))
+			{
+				cout << options;
+				return 1;
+			}
+			BatchSettings settings;
+			settings.steps = arguments["steps"].as<string>();
+			settings.maxSteps = maxSteps;
+			settings.jobs = (jobs == 0 ? hardwareConcurrency() : jobs);
+			return runBatch(arguments["batch"].as<string>(), settings) ? 0 : 1;
+		}
+
 		string input;
 		if (arguments.count("input-file"))
 		{
@@ -340,7 +650,7 @@ int main(int argc, char** argv)
 			string sequence = arguments["steps"].as<string>();
 			if (!nonInteractive)
 				cout << "----------------------" << endl;
-			yulOpti.runSteps(input, sequence);
+			yulOpti.runSteps(input, sequence, profile);
 			disambiguated = true;
 		}
 		if (!nonInteractive)
@@ -238,6 +238,48 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_multiply_the_result_by_scaling_factor, P
 	BOOST_TEST(RelativeProgramSize(m_program, nullptr, 4, m_weights).evaluate(m_chromosome) == round(10000.0 * sizeRatio));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ProgramGasCostTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_gas_cost_of_the_optimised_program, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGasCost(m_program, nullptr, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == ProgramGasCost::gasCost(m_optimisedProgram, 200));
+	BOOST_TEST(fitness < ProgramGasCost::gasCost(m_program, 200));
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGasCost(nullopt, m_programCache, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == ProgramGasCost::gasCost(m_optimisedProgram, 200));
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
+BOOST_FIXTURE_TEST_CASE(gasCost_should_grow_with_expected_executions, ProgramBasedMetricFixture)
+{
+	BOOST_TEST(ProgramGasCost::gasCost(m_program, 1) < ProgramGasCost::gasCost(m_program, 1000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(RelativeProgramGasCostTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_the_gas_cost_ratio_between_optimised_program_and_original_program, ProgramBasedMetricFixture)
+{
+	BOOST_TEST(
+		RelativeProgramGasCost(m_program, nullptr, 3, 200, m_weights).evaluate(m_chromosome) ==
+		round(1000.0 * double(ProgramGasCost::gasCost(m_optimisedProgram, 200)) / double(ProgramGasCost::gasCost(m_program, 200)))
+	);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_return_one_if_number_of_repetitions_is_zero, ProgramBasedMetricFixture)
+{
+	RelativeProgramGasCost metric(m_program, nullptr, 3, 200, m_weights, 0);
+
+	BOOST_TEST(metric.evaluate(m_chromosome) == 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(FitnessMetricCombinationTest)
 
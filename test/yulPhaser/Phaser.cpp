@@ -89,6 +89,8 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* expectedExecutions = */ 200,
+		/* jobs = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -237,6 +239,25 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_create_gas_metric_with_expected_executions, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::RelativeGasCost;
+	m_options.metricAggregator = MetricAggregatorChoice::Average;
+	m_options.expectedExecutions = 1000;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+	BOOST_REQUIRE(averageMetric->metrics()[0] != nullptr);
+
+	auto relativeGasCostMetric = dynamic_cast<RelativeProgramGasCost*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(relativeGasCostMetric != nullptr);
+	BOOST_TEST(relativeGasCostMetric->expectedExecutions() == m_options.expectedExecutions);
+	BOOST_TEST(relativeGasCostMetric->fixedPointPrecision() == m_options.relativeMetricScale);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -387,7 +408,10 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{
+		/* programCacheEnabled = */ true,
+		/* maxProgramCacheSize = */ nullopt,
+	};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -401,7 +425,10 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{
+		/* programCacheEnabled = */ false,
+		/* maxProgramCacheSize = */ nullopt,
+	};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
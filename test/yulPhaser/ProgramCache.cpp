@@ -252,6 +252,27 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_when_over_size_limit, ProgramCacheFixture)
+{
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t maxSize = sizeL + sizeI + sizeIu;
+	ProgramCache programCache(m_program, maxSize);
+
+	programCache.optimiseProgram("L");
+	programCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(programCache) == set<string>{"L", "I", "Iu"}));
+	BOOST_TEST(programCache.gatherStats().totalCodeSize == maxSize);
+
+	Program cachedProgram = programCache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(programCache.find("L") == nullptr);
+	BOOST_TEST(programCache.find("IuO") != nullptr);
+	BOOST_TEST(programCache.gatherStats().totalCodeSize <= maxSize / 4 * 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -18,15 +18,29 @@
 
 #include <tools/yulPhaser/FitnessMetrics.h>
 
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Parallel.h>
 
 #include <cmath>
+#include <limits>
 
 using namespace std;
 using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+	parallelFor(_chromosomes.size(), m_threads, [&](size_t _index) {
+		values[_index] = evaluate(_chromosomes[_index]);
+	});
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -75,6 +89,39 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t ProgramGasCost::evaluate(Chromosome const& _chromosome)
+{
+	return gasCost(optimisedProgram(_chromosome), m_expectedExecutions);
+}
+
+size_t ProgramGasCost::gasCost(Program const& _program, size_t _expectedExecutions)
+{
+	bigint costs = GasMeter(
+		dynamic_cast<EVMDialect const&>(_program.dialect()),
+		false,
+		_expectedExecutions
+	).costs(_program.ast());
+
+	if (costs > numeric_limits<size_t>::max())
+		return numeric_limits<size_t>::max();
+	return static_cast<size_t>(costs);
+}
+
+size_t RelativeProgramGasCost::evaluate(Chromosome const& _chromosome)
+{
+	double const scalingFactor = pow(10, m_fixedPointPrecision);
+
+	size_t unoptimisedCost = ProgramGasCost::gasCost(optimisedProgram(Chromosome("")), m_expectedExecutions);
+	if (unoptimisedCost == 0)
+		return static_cast<size_t>(scalingFactor);
+
+	size_t optimisedCost = ProgramGasCost::gasCost(optimisedProgram(_chromosome), m_expectedExecutions);
+
+	return static_cast<size_t>(round(
+		double(optimisedCost) / double(unoptimisedCost) * scalingFactor
+	));
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
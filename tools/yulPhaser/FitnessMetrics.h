@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -49,6 +50,18 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// Evaluates all of @a _chromosomes, using up to @a threads() threads.
+	/// @returns the values in the same order as the chromosomes.
+	/// Concurrent evaluation requires @a evaluate() to be thread-safe, which it is for all
+	/// metrics defined here.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	size_t threads() const { return m_threads; }
+	void setThreads(size_t _threads) { m_threads = _threads; }
+
+private:
+	size_t m_threads = 1;
 };
 
 /**
@@ -132,6 +145,71 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the static gas cost estimate of a specific program after applying
+ * the optimisations from the chromosome to it.
+ *
+ * The estimate comes from @a yul::GasMeter and combines the deployment costs with the runtime
+ * costs multiplied by @a _expectedExecutions. Control flow is not taken into account, i.e. each
+ * statement is counted as executed once per run.
+ */
+class ProgramGasCost: public ProgramBasedMetric
+{
+public:
+	explicit ProgramGasCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _expectedExecutions,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_expectedExecutions(_expectedExecutions) {}
+
+	size_t expectedExecutions() const { return m_expectedExecutions; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+	/// @returns the gas cost estimate of @a _program, saturated at the maximum value of size_t.
+	static size_t gasCost(Program const& _program, size_t _expectedExecutions);
+
+private:
+	size_t m_expectedExecutions;
+};
+
+/**
+ * Fitness metric based on the static gas cost estimate of a specific program after applying
+ * the optimisations from the chromosome to it in relation to the estimate for the original,
+ * unoptimised program. See @a ProgramGasCost for how the estimate is computed.
+ *
+ * Since metric values are integers, the class multiplies the ratio by 10^@a _fixedPointPrecision
+ * before rounding it.
+ */
+class RelativeProgramGasCost: public ProgramBasedMetric
+{
+public:
+	explicit RelativeProgramGasCost(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _fixedPointPrecision,
+		size_t _expectedExecutions,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_fixedPointPrecision(_fixedPointPrecision),
+		m_expectedExecutions(_expectedExecutions) {}
+
+	size_t fixedPointPrecision() const { return m_fixedPointPrecision; }
+	size_t expectedExecutions() const { return m_expectedExecutions; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	size_t m_fixedPointPrecision;
+	size_t m_expectedExecutions;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
@@ -69,6 +69,8 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::GasCost, "gas-cost"},
+	{MetricChoice::RelativeGasCost, "relative-gas-cost"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -219,6 +221,8 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["expected-executions"].as<size_t>(),
+		_arguments["jobs"].as<size_t>(),
 	};
 }
 
@@ -259,23 +263,56 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::GasCost:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<ProgramGasCost>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.expectedExecutions,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
+		case MetricChoice::RelativeGasCost:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<RelativeProgramGasCost>(
+					_programCaches[i] != nullptr ? optional<Program>{} : move(_programs[i]),
+					move(_programCaches[i]),
+					_options.relativeMetricScale,
+					_options.expectedExecutions,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> aggregatedMetric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			aggregatedMetric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	aggregatedMetric->setThreads(_options.jobs);
+	return aggregatedMetric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -358,6 +395,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("max-program-cache-size") > 0 ?
+			_arguments["max-program-cache-size"].as<size_t>() :
+			optional<size_t>{},
 	};
 }
 
@@ -368,7 +408,7 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program), _options.maxProgramCacheSize) : nullptr);
 
 	return programCaches;
 }
@@ -645,7 +685,12 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::GasCost) + "\n" +
+				"* " + toString(MetricChoice::RelativeGasCost) + "\n" +
+				"\n"
+				"Gas metrics use a static estimate that does not take control flow into account. "
+				"They ignore metric weights."
 			).c_str()
 		)
 		(
@@ -679,6 +724,19 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"expected-executions",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(200),
+			"Number of times the code is expected to be executed after deployment. "
+			"Used by gas metrics to weigh runtime costs against deployment costs, "
+			"like --optimize-runs in the compiler."
+		)
+		(
+			"jobs",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
+			"Number of threads used to evaluate the fitness of the chromosomes in a population. "
+			"The results do not depend on this value."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -711,8 +769,15 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended if your computer has enough RAM. "
+			"Use --max-program-cache-size to put an upper limit on memory usage."
+		)
+		(
+			"max-program-cache-size",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Upper limit on the total size of the programs stored in the cache of each input program, "
+			"measured in AST nodes. When it is exceeded, the least recently used programs are removed. "
+			"Unlimited by default."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -76,6 +76,8 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	GasCost,
+	RelativeGasCost,
 };
 
 enum class MetricAggregatorChoice
@@ -158,6 +160,10 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t expectedExecutions;
+		/// Number of threads used to evaluate the chromosomes of a population. 0 and 1 both mean
+		/// that the evaluation is sequential.
+		size_t jobs;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -216,6 +222,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxProgramCacheSize;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
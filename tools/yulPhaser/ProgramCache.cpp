@@ -22,6 +22,9 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace std;
 using namespace solidity::yul;
 using namespace solidity::phaser;
@@ -60,32 +63,44 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
-	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+	Program intermediateProgram = [&]() {
+		lock_guard<mutex> lock(m_mutex);
+		++m_useCounter;
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				pair->second.lastUse = m_useCounter;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
-	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+		return (
+			prefixSize == 0 ?
+			m_program :
+			m_entries.at(targetOptimisations.substr(0, prefixSize)).program
+		);
+	}();
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		size_t codeSize = m_maxTotalCodeSize ? intermediateProgram.codeSize(CacheStats::StorageWeights) : 0;
+		CacheEntry entry{intermediateProgram, m_currentRound, codeSize};
+
+		lock_guard<mutex> lock(m_mutex);
+		entry.lastUse = ++m_useCounter;
+		if (m_entries.insert({targetOptimisations.substr(0, i), move(entry)}).second)
+			m_totalCodeSize += codeSize;
 		++m_misses;
+		evictLeastRecentlyUsed();
 	}
 
 	return intermediateProgram;
@@ -101,7 +116,10 @@ void ProgramCache::startRound(size_t _roundNumber)
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
+		{
+			m_totalCodeSize -= pair->second.codeSize;
 			m_entries.erase(pair++);
+		}
 		else
 			++pair;
 	}
@@ -110,11 +128,13 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
 Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
 {
+	lock_guard<mutex> lock(m_mutex);
 	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
 	if (pair == m_entries.end())
 		return nullptr;
@@ -152,3 +172,26 @@ map<size_t, size_t> ProgramCache::countRoundEntries() const
 
 	return counts;
 }
+
+void ProgramCache::evictLeastRecentlyUsed()
+{
+	if (!m_maxTotalCodeSize || m_totalCodeSize <= *m_maxTotalCodeSize)
+		return;
+
+	vector<map<string, CacheEntry>::iterator> entriesByUse;
+	for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+		entriesByUse.push_back(it);
+	sort(entriesByUse.begin(), entriesByUse.end(), [](auto const& _a, auto const& _b) {
+		return _a->second.lastUse < _b->second.lastUse;
+	});
+
+	// Evict more than necessary so that the next insertions do not have to sort again.
+	size_t const targetSize = *m_maxTotalCodeSize / 4 * 3;
+	for (auto const& it: entriesByUse)
+	{
+		if (m_totalCodeSize <= targetSize)
+			break;
+		m_totalCodeSize -= it->second.codeSize;
+		m_entries.erase(it);
+	}
+}
@@ -24,6 +24,8 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 
 namespace solidity::phaser
@@ -37,10 +39,17 @@ struct CacheEntry
 {
 	Program program;
 	size_t roundNumber;
+	/// Size of the program according to @a CacheStats::StorageWeights. Only computed if the
+	/// cache has a size limit.
+	size_t codeSize;
+	/// Value of the cache's use counter when the entry was last created or used.
+	size_t lastUse;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(Program _program, size_t _roundNumber, size_t _codeSize = 0, size_t _lastUse = 0):
 		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
+		roundNumber(_roundNumber),
+		codeSize(_codeSize),
+		lastUse(_lastUse) {}
 };
 
 /**
@@ -99,15 +108,20 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * Since the programs take a lot of memory, the total size of the cached programs can be limited.
+ * When it is exceeded, the least recently used entries are removed until the total drops to
+ * three quarters of the limit.
+ *
+ * @a optimiseProgram() can be called concurrently from multiple threads. The optimisation steps
+ * themselves run without holding the lock. The other methods must not be called concurrently
+ * with it.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -129,6 +143,9 @@ public:
 private:
 	size_t calculateTotalCachedCodeSize() const;
 	std::map<size_t, size_t> countRoundEntries() const;
+	/// Removes the least recently used entries if the cache is larger than allowed.
+	/// Must be called with @a m_mutex locked.
+	void evictLeastRecentlyUsed();
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
 	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
@@ -139,6 +156,12 @@ private:
 	size_t m_currentRound = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+
+	std::optional<size_t> m_maxTotalCodeSize;
+	/// Sum of the code sizes of all entries. Only maintained if there is a size limit.
+	size_t m_totalCodeSize = 0;
+	size_t m_useCounter = 0;
+	mutable std::mutex m_mutex;
 };
 
 }